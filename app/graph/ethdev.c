@@ -437,6 +437,9 @@ ethdev_process(const char *name, struct ethdev_config *params)
 	if (params->mtu)
 		port_conf.rxmode.mtu = params->mtu;
 
+	/* The fragments of the packets larger than the MTU are chained buffers */
+	port_conf.txmode.offloads |= port_info.tx_offload_capa & RTE_ETH_TX_OFFLOAD_MULTI_SEGS;
+
 	rc = rte_eth_dev_configure(port_id, params->rx.n_queues, params->tx.n_queues,
 				       &port_conf);
 	if (rc < 0) {
@@ -10,10 +10,16 @@
 #include <cmdline_parse_num.h>
 #include <cmdline_parse_string.h>
 #include <cmdline_socket.h>
+#include <rte_eal.h>
 #include <rte_ethdev.h>
 #include <rte_graph_worker.h>
 #include <rte_graph_feature_arc_worker.h>
 #include <rte_log.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_memzone.h>
+#include <rte_pause.h>
+#include <rte_rcu_qsbr.h>
 
 #include "graph_priv.h"
 #include "module_api.h"
@@ -29,6 +35,27 @@ static const char * const supported_usecases[] = {"l3fwd", "l2fwd"};
 struct graph_config graph_config;
 bool graph_started;
 
+/* Node patterns of the use case, kept to rebuild the worker graphs on reload */
+static const char * const *graph_node_patterns;
+static uint16_t graph_nb_node_patterns;
+static uint32_t graph_generation;
+
+/* Worker graphs of the primary process, shared with the secondary ones */
+#define GRAPH_WORKERS_MZ_NAME "app_graph_workers"
+
+struct graph_workers_shared {
+	/* Graph walked on each lcore, NULL if the lcore has none */
+	RTE_ATOMIC(struct rte_graph *) graph[RTE_MAX_LCORE];
+	/* Lcores whose graph is walked by a secondary process */
+	RTE_ATOMIC(bool) secondary[RTE_MAX_LCORE];
+	/* Lcores on which the primary process does not walk any more */
+	RTE_ATOMIC(bool) released[RTE_MAX_LCORE];
+	/* Quiescent state variable of the walkers of all the processes */
+	struct rte_rcu_qsbr *qsv;
+};
+
+static struct graph_workers_shared *graph_shared;
+
 /* Check the link rc of all ports in up to 9s, and print them finally */
 static void
 check_all_ports_link_status(uint32_t port_mask)
@@ -333,29 +360,372 @@ graph_pcap_config_get(uint8_t *pcap_ena, uint64_t *num_pkts, char **file)
 	*file = graph_config.pcap_file;
 }
 
-int
-graph_walk_start(void *conf)
+static void
+graph_workers_destroy(const rte_graph_t *graph_ids)
 {
+	uint32_t lcore_id;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		if (graph_ids[lcore_id] != RTE_GRAPH_ID_INVALID)
+			rte_graph_destroy(graph_ids[lcore_id]);
+	}
+}
+
+static int
+graph_workers_build(rte_graph_t *graph_ids, uint32_t generation)
+{
+	struct rte_graph_param graph_conf;
+	char name[RTE_GRAPH_NAMESIZE];
+	const char **node_patterns;
 	struct lcore_conf *qconf;
+	uint16_t nb_patterns;
+	uint32_t lcore_id;
+	int rc = 0;
+
+	nb_patterns = graph_nb_node_patterns;
+	node_patterns = malloc((ETHDEV_RX_QUEUE_PER_LCORE_MAX + nb_patterns) *
+			sizeof(*node_patterns));
+	if (!node_patterns)
+		return -ENOMEM;
+	if (nb_patterns)
+		memcpy(node_patterns, graph_node_patterns, nb_patterns * sizeof(*node_patterns));
+
+	memset(&graph_conf, 0, sizeof(graph_conf));
+	graph_conf.node_patterns = node_patterns;
+
+	/* Pcap config */
+	graph_conf.pcap_enable = graph_config.pcap_ena;
+	graph_conf.num_pkt_to_capture = graph_config.num_pcap_pkts;
+	graph_conf.pcap_filename = graph_config.pcap_file;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
+		graph_ids[lcore_id] = RTE_GRAPH_ID_INVALID;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		rte_edge_t i;
+
+		if (rte_lcore_is_enabled(lcore_id) == 0)
+			continue;
+
+		qconf = &lcore_conf[lcore_id];
+
+		/* Skip graph creation if no source exists */
+		if (!qconf->n_rx_queue)
+			continue;
+
+		/* Add rx node patterns of this lcore */
+		for (i = 0; i < qconf->n_rx_queue; i++)
+			node_patterns[nb_patterns + i] = qconf->rx_queue_list[i].node_name;
+
+		graph_conf.nb_node_patterns = nb_patterns + i;
+		graph_conf.socket_id = rte_lcore_to_socket_id(lcore_id);
+
+		/* The graphs of a reload live next to the ones they replace */
+		if (generation == 0)
+			snprintf(name, sizeof(name), "worker_%u", lcore_id);
+		else
+			snprintf(name, sizeof(name), "worker_%u-%u", lcore_id, generation);
+
+		graph_ids[lcore_id] = rte_graph_create(name, &graph_conf);
+		if (graph_ids[lcore_id] == RTE_GRAPH_ID_INVALID) {
+			RTE_LOG(ERR, APP_GRAPH, "rte_graph_create(): graph_id invalid for lcore %u\n",
+				lcore_id);
+			rc = -EINVAL;
+			break;
+		}
+	}
+
+	free(node_patterns);
+	if (rc)
+		graph_workers_destroy(graph_ids);
+
+	return rc;
+}
+
+static void
+graph_workers_publish(const rte_graph_t *graph_ids)
+{
+	struct lcore_conf *qconf;
+	struct rte_graph *graph;
+	uint32_t lcore_id;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		if (graph_ids[lcore_id] == RTE_GRAPH_ID_INVALID)
+			continue;
+
+		qconf = &lcore_conf[lcore_id];
+		rte_strscpy(qconf->name, rte_graph_id_to_name(graph_ids[lcore_id]),
+			    sizeof(qconf->name));
+		graph = rte_graph_lookup(qconf->name);
+		qconf->graph_id = graph_ids[lcore_id];
+		qconf->graph = graph;
+		rte_atomic_store_explicit(&graph_shared->graph[lcore_id], graph,
+					  rte_memory_order_release);
+	}
+}
+
+int
+graph_workers_create(const char * const *node_patterns, uint16_t nb_node_patterns)
+{
+	rte_graph_t graph_ids[RTE_MAX_LCORE];
+	const struct rte_memzone *mz;
+	size_t sz;
+	int rc;
+
+	mz = rte_memzone_reserve(GRAPH_WORKERS_MZ_NAME, sizeof(*graph_shared), SOCKET_ID_ANY, 0);
+	if (mz == NULL)
+		return -rte_errno;
+
+	graph_shared = mz->addr;
+	memset(graph_shared, 0, sizeof(*graph_shared));
+
+	/* The main lcore runs the command line, a secondary process may walk its graph */
+	graph_shared->released[rte_get_main_lcore()] = true;
+
+	sz = rte_rcu_qsbr_get_memsize(RTE_MAX_LCORE);
+	graph_shared->qsv = rte_zmalloc("graph_qsv", sz, RTE_CACHE_LINE_SIZE);
+	if (graph_shared->qsv == NULL) {
+		rc = -ENOMEM;
+		goto free;
+	}
+
+	rc = rte_rcu_qsbr_init(graph_shared->qsv, RTE_MAX_LCORE);
+	if (rc)
+		goto free;
+
+	graph_node_patterns = node_patterns;
+	graph_nb_node_patterns = nb_node_patterns;
+
+	rc = graph_workers_build(graph_ids, graph_generation);
+	if (rc)
+		goto free;
+
+	graph_workers_publish(graph_ids);
+	return 0;
+
+free:
+	rte_free(graph_shared->qsv);
+	graph_shared = NULL;
+	rte_memzone_free(mz);
+	return rc;
+}
+
+/*
+ * The ethdev_tx nodes send on the Tx queue of the graph id, the new graphs are
+ * created while the old ones still exist and thus get other ids.
+ */
+static int
+graph_workers_txq_check(const rte_graph_t *graph_ids)
+{
+	struct rte_eth_dev_info info;
+	uint32_t lcore_id;
+	uint16_t portid;
+	int rc;
+
+	RTE_ETH_FOREACH_DEV(portid) {
+		if ((enabled_port_mask & (1 << portid)) == 0)
+			continue;
+
+		rc = rte_eth_dev_info_get(portid, &info);
+		if (rc < 0)
+			return rc;
+
+		for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+			if (graph_ids[lcore_id] == RTE_GRAPH_ID_INVALID)
+				continue;
+
+			if (graph_ids[lcore_id] >= info.nb_tx_queues) {
+				RTE_LOG(ERR, APP_GRAPH, "Port %u has no txq %u for graph reload\n",
+					portid, graph_ids[lcore_id]);
+				return -ENOSPC;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Streams left in a node across walks, e.g. held by the coalescing of the
+ * graph, are not freed by the graph destroy.
+ */
+static void
+graph_workers_drain(const rte_graph_t *graph_ids)
+{
 	struct rte_graph *graph;
+	struct rte_node *node;
+	rte_graph_off_t off;
 	uint32_t lcore_id;
+	rte_node_t count;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		if (graph_ids[lcore_id] == RTE_GRAPH_ID_INVALID)
+			continue;
+
+		graph = rte_graph_lookup(rte_graph_id_to_name(graph_ids[lcore_id]));
+		if (graph == NULL)
+			continue;
+
+		rte_graph_foreach_node(count, off, graph, node) {
+			if (node->idx == 0)
+				continue;
+
+			rte_pktmbuf_free_bulk((struct rte_mbuf **)node->objs, node->idx);
+			node->idx = 0;
+		}
+	}
+}
+
+static int
+graph_reload(void)
+{
+	rte_graph_t old_ids[RTE_MAX_LCORE], new_ids[RTE_MAX_LCORE];
+	struct lcore_conf *qconf;
+	uint32_t lcore_id;
+	int rc;
+
+	if (!graph_started || graph_shared == NULL)
+		return -EINVAL;
+
+	/* Streams of the dispatch model wait in the queues of other lcores */
+	if (graph_config.model == GRAPH_MODEL_MCD)
+		return -ENOTSUP;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		qconf = &lcore_conf[lcore_id];
+		old_ids[lcore_id] = RTE_GRAPH_ID_INVALID;
+		if (qconf->graph != NULL)
+			old_ids[lcore_id] = qconf->graph_id;
+	}
+
+	rc = graph_workers_build(new_ids, graph_generation + 1);
+	if (rc)
+		return rc;
+
+	rc = graph_workers_txq_check(new_ids);
+	if (rc) {
+		graph_workers_destroy(new_ids);
+		return rc;
+	}
+
+	graph_generation++;
+	graph_workers_publish(new_ids);
+
+	/*
+	 * Once every walker, of this process or of a secondary one, reported a
+	 * quiescent state, it completed its walk of the old graph and walks the
+	 * new one. The streams still held in the nodes of the old graphs are
+	 * dropped, the node fini frees the rest (GRO flows, crypto operations).
+	 */
+	rte_rcu_qsbr_synchronize(graph_shared->qsv, RTE_QSBR_THRID_INVALID);
+	graph_workers_drain(old_ids);
+	graph_workers_destroy(old_ids);
+
+	return 0;
+}
+
+void
+cmd_graph_reload_parsed(__rte_unused void *parsed_result, __rte_unused struct cmdline *cl,
+			__rte_unused void *data)
+{
+	int rc;
+
+	rc = graph_reload();
+	if (rc < 0)
+		printf(MSG_CMD_FAIL, "graph reload");
+}
+
+/* Take over the walk of the graph of an lcore from the primary process */
+static bool
+graph_walk_claim(uint32_t lcore_id)
+{
+	rte_atomic_store_explicit(&graph_shared->secondary[lcore_id], true,
+				  rte_memory_order_relaxed);
+
+	while (!rte_atomic_load_explicit(&graph_shared->released[lcore_id],
+					 rte_memory_order_acquire)) {
+		if (force_quit)
+			return false;
+		rte_pause();
+	}
+
+	return true;
+}
+
+int
+graph_walk_start(void *conf)
+{
+	struct rte_graph *graph = NULL, *published;
+	struct rte_rcu_qsbr *qsv;
+	uint32_t lcore_id;
+	bool primary;
 
 	RTE_SET_USED(conf);
 
 	lcore_id = rte_lcore_id();
-	qconf = &lcore_conf[lcore_id];
-	graph = qconf->graph;
+	primary = rte_eal_process_type() == RTE_PROC_PRIMARY;
+	published = rte_atomic_load_explicit(&graph_shared->graph[lcore_id],
+					     rte_memory_order_acquire);
 
-	if (!graph) {
+	if (!published) {
 		RTE_LOG(INFO, APP_GRAPH, "Lcore %u has nothing to do\n", lcore_id);
 		return 0;
 	}
 
-	RTE_LOG(INFO, APP_GRAPH, "Entering main loop on lcore %u, graph %s(%p)\n", lcore_id,
-		qconf->name, graph);
+	if (!primary && !graph_walk_claim(lcore_id))
+		return 0;
+
+	qsv = graph_shared->qsv;
+	rte_rcu_qsbr_thread_register(qsv, lcore_id);
+	rte_rcu_qsbr_thread_online(qsv, lcore_id);
+
+	while (likely(!force_quit)) {
+		/* A secondary process walks the graph of this lcore from now on */
+		if (primary && rte_atomic_load_explicit(&graph_shared->secondary[lcore_id],
+							rte_memory_order_relaxed))
+			break;
+
+		/* Switch to the graph published by a reload at a walk boundary */
+		published = rte_atomic_load_explicit(&graph_shared->graph[lcore_id],
+						     rte_memory_order_acquire);
+		if (unlikely(published != graph)) {
+			/* Fix up the process pointers of the nodes in a secondary */
+			graph = rte_graph_lookup(published->name);
+			if (graph == NULL)
+				break;
+			RTE_LOG(INFO, APP_GRAPH, "Walking on lcore %u graph %s(%p)\n", lcore_id,
+				graph->name, graph);
+		}
 
-	while (likely(!force_quit))
 		rte_graph_walk(graph);
+		rte_rcu_qsbr_quiescent(qsv, lcore_id);
+	}
+
+	rte_rcu_qsbr_thread_offline(qsv, lcore_id);
+	rte_rcu_qsbr_thread_unregister(qsv, lcore_id);
+
+	if (primary)
+		rte_atomic_store_explicit(&graph_shared->released[lcore_id], true,
+					  rte_memory_order_release);
+
+	return 0;
+}
+
+int
+graph_secondary_walk(void)
+{
+	const struct rte_memzone *mz;
+
+	/* Published by the primary process at graph start */
+	mz = rte_memzone_lookup(GRAPH_WORKERS_MZ_NAME);
+	if (mz == NULL) {
+		printf("Error: graphs of the primary process are not started\n");
+		return -ENOENT;
+	}
+	graph_shared = mz->addr;
+
+	rte_eal_mp_remote_launch(graph_walk_start, NULL, SKIP_MAIN);
+	rte_eal_mp_wait_lcore();
 
 	return 0;
 }
@@ -442,9 +812,9 @@ cmd_help_graph_parsed(__rte_unused void *parsed_result, __rte_unused struct cmdl
 
 	len = strlen(conn->msg_out);
 	conn->msg_out += len;
-	snprintf(conn->msg_out, conn->msg_out_len_max, "\n%s\n%s\n%s\n%s\n",
+	snprintf(conn->msg_out, conn->msg_out_len_max, "\n%s\n%s\n%s\n%s\n%s\n",
 		 "----------------------------- graph command help -----------------------------",
-		 cmd_graph_help, "graph start", "graph stats show");
+		 cmd_graph_help, "graph start", "graph stats show", "graph reload");
 
 	len = strlen(conn->msg_out);
 	conn->msg_out_len_max -= len;
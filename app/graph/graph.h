@@ -7,7 +7,9 @@
 
 #include <cmdline_parse.h>
 
+int graph_workers_create(const char * const *node_patterns, uint16_t nb_node_patterns);
 int graph_walk_start(void *conf);
+int graph_secondary_walk(void);
 void graph_stats_print(void);
 void graph_pcap_config_get(uint8_t *pcap_ena, uint64_t *num_pkts, char **file);
 uint64_t graph_coremask_get(void);
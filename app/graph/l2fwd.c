@@ -21,69 +21,11 @@
 static int
 l2fwd_pattern_configure(void)
 {
-	struct rte_graph_param graph_conf;
-	const char **node_patterns;
-	uint64_t pcap_pkts_count;
-	struct lcore_conf *qconf;
-	uint16_t nb_patterns;
-	uint8_t pcap_ena;
-	char *pcap_file;
-	int lcore_id;
-
-	nb_patterns = 0;
-	node_patterns = malloc((ETHDEV_RX_QUEUE_PER_LCORE_MAX + nb_patterns) *
-			sizeof(*node_patterns));
-	if (!node_patterns)
-		return -ENOMEM;
-
-	memset(&graph_conf, 0, sizeof(graph_conf));
-	graph_conf.node_patterns = node_patterns;
-
-	/* Pcap config */
-	graph_pcap_config_get(&pcap_ena, &pcap_pkts_count, &pcap_file);
-	graph_conf.pcap_enable = pcap_ena;
-	graph_conf.num_pkt_to_capture = pcap_pkts_count;
-	graph_conf.pcap_filename = strdup(pcap_file);
-
-	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
-		rte_graph_t graph_id;
-		rte_edge_t i;
-
-		if (rte_lcore_is_enabled(lcore_id) == 0)
-			continue;
-
-		qconf = &lcore_conf[lcore_id];
-
-		/* Skip graph creation if no source exists */
-		if (!qconf->n_rx_queue)
-			continue;
-
-		/* Add rx node patterns of this lcore */
-		for (i = 0; i < qconf->n_rx_queue; i++) {
-			graph_conf.node_patterns[nb_patterns + i] =
-				qconf->rx_queue_list[i].node_name;
-		}
+	int rc;
 
-		graph_conf.nb_node_patterns = nb_patterns + i;
-		graph_conf.socket_id = rte_lcore_to_socket_id(lcore_id);
-
-		snprintf(qconf->name, sizeof(qconf->name), "worker_%u",
-				lcore_id);
-
-		graph_id = rte_graph_create(qconf->name, &graph_conf);
-		if (graph_id == RTE_GRAPH_ID_INVALID)
-			rte_exit(EXIT_FAILURE,
-					"rte_graph_create(): graph_id invalid"
-					" for lcore %u\n", lcore_id);
-
-		qconf->graph_id = graph_id;
-		qconf->graph = rte_graph_lookup(qconf->name);
-		/* >8 End of graph initialization. */
-		if (!qconf->graph)
-			rte_exit(EXIT_FAILURE,
-					"rte_graph_lookup(): graph %s not found\n",
-					qconf->name);
-	}
+	rc = graph_workers_create(NULL, 0);
+	if (rc)
+		rte_exit(EXIT_FAILURE, "Unable to create worker graphs: err=%d\n", rc);
 
 	/* Launch per-lcore init on every worker lcore */
 	rte_eal_mp_remote_launch(graph_walk_start, NULL, SKIP_MAIN);
@@ -14,6 +14,7 @@
 #include <rte_graph.h>
 #include <rte_graph_worker.h>
 #include <rte_lcore.h>
+#include <rte_mbuf.h>
 #include <rte_node_eth_api.h>
 #include <rte_node_ip4_api.h>
 #include <rte_node_ip6_api.h>
@@ -21,6 +22,9 @@
 
 #include "module_api.h"
 
+#define FRAG_NB_MBUF    8192
+#define FRAG_CACHE_SIZE 256
+
 static int
 setup_fib(int socket)
 {
@@ -54,6 +58,40 @@ setup_fib6(int socket)
 	return rte_node_ip6_fib_create(socket, &conf);
 }
 
+/* Pools of the fragments of the packets larger than the MTU of their Tx port */
+static int
+fragment_configure(void)
+{
+	struct rte_node_ip4_fragment_cfg ip4_cfg;
+	struct rte_node_ip6_fragment_cfg ip6_cfg;
+	struct rte_mempool *direct, *indirect;
+	int rc;
+
+	/* A fragment is a direct buffer with the headers and an indirect one with data */
+	direct = rte_pktmbuf_pool_create("frag_direct_pool", FRAG_NB_MBUF, FRAG_CACHE_SIZE, 0,
+					 RTE_MBUF_DEFAULT_BUF_SIZE, rte_socket_id());
+	indirect = rte_pktmbuf_pool_create("frag_indirect_pool", FRAG_NB_MBUF, FRAG_CACHE_SIZE,
+					   0, 0, rte_socket_id());
+	if (direct == NULL || indirect == NULL)
+		return -ENOMEM;
+
+	/* No ICMP source address is configured, such packets are dropped */
+	memset(&ip4_cfg, 0, sizeof(ip4_cfg));
+	ip4_cfg.pool_direct = direct;
+	ip4_cfg.pool_indirect = indirect;
+	ip4_cfg.node_id = rte_node_from_name("ip4_fragment");
+	rc = rte_node_ip4_fragment_configure(&ip4_cfg, 1);
+	if (rc < 0)
+		return rc;
+
+	memset(&ip6_cfg, 0, sizeof(ip6_cfg));
+	ip6_cfg.pool_direct = direct;
+	ip6_cfg.pool_indirect = indirect;
+	ip6_cfg.node_id = rte_node_from_name("ip6_fragment");
+
+	return rte_node_ip6_fragment_configure(&ip6_cfg, 1);
+}
+
 static int
 l3fwd_pattern_configure(void)
 {
@@ -63,31 +101,8 @@ l3fwd_pattern_configure(void)
 		"ethdev_tx-*",
 		"pkt_drop",
 	};
-	struct rte_graph_param graph_conf;
-	const char **node_patterns;
-	uint64_t pcap_pkts_count;
 	struct lcore_conf *qconf;
-	uint16_t nb_patterns;
-	uint8_t pcap_ena;
-	int rc, lcore_id;
-	char *pcap_file;
-
-	nb_patterns = RTE_DIM(default_patterns);
-	node_patterns = malloc((ETHDEV_RX_QUEUE_PER_LCORE_MAX + nb_patterns) *
-			sizeof(*node_patterns));
-	if (!node_patterns)
-		return -ENOMEM;
-	memcpy(node_patterns, default_patterns,
-			nb_patterns * sizeof(*node_patterns));
-
-	memset(&graph_conf, 0, sizeof(graph_conf));
-	graph_conf.node_patterns = node_patterns;
-
-	/* Pcap config */
-	graph_pcap_config_get(&pcap_ena, &pcap_pkts_count, &pcap_file);
-	graph_conf.pcap_enable = pcap_ena;
-	graph_conf.num_pkt_to_capture = pcap_pkts_count;
-	graph_conf.pcap_filename = strdup(pcap_file);
+	int rc, lcore_id, socket;
 
 	if (ip4_lookup_m == IP4_LOOKUP_FIB) {
 		const char *fib_n = "ip4_lookup_fib";
@@ -110,59 +125,42 @@ l3fwd_pattern_configure(void)
 	}
 
 	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
-		rte_graph_t graph_id;
-		rte_edge_t i;
-
 		if (rte_lcore_is_enabled(lcore_id) == 0)
 			continue;
 
 		qconf = &lcore_conf[lcore_id];
 
-		/* Skip graph creation if no source exists */
+		/* Skip the lcores without a graph */
 		if (!qconf->n_rx_queue)
 			continue;
 
-		/* Add rx node patterns of this lcore */
-		for (i = 0; i < qconf->n_rx_queue; i++) {
-			graph_conf.node_patterns[nb_patterns + i] =
-				qconf->rx_queue_list[i].node_name;
-		}
-
-		graph_conf.nb_node_patterns = nb_patterns + i;
-		graph_conf.socket_id = rte_lcore_to_socket_id(lcore_id);
-
-		snprintf(qconf->name, sizeof(qconf->name), "worker_%u",
-				lcore_id);
+		socket = rte_lcore_to_socket_id(lcore_id);
 
 		if (ip4_lookup_m == IP4_LOOKUP_FIB) {
-			rc = setup_fib(graph_conf.socket_id);
+			rc = setup_fib(socket);
 			if (rc < 0)
 				rte_exit(EXIT_FAILURE, "Unable to setup fib for socket %u\n",
-						graph_conf.socket_id);
+						socket);
 		}
 
 		if (ip6_lookup_m == IP6_LOOKUP_FIB) {
-			rc = setup_fib6(graph_conf.socket_id);
+			rc = setup_fib6(socket);
 			if (rc < 0)
 				rte_exit(EXIT_FAILURE, "Unable to setup fib6 for socket %u\n",
-						graph_conf.socket_id);
+						socket);
 		}
-
-		graph_id = rte_graph_create(qconf->name, &graph_conf);
-		if (graph_id == RTE_GRAPH_ID_INVALID)
-			rte_exit(EXIT_FAILURE,
-					"rte_graph_create(): graph_id invalid"
-					" for lcore %u\n", lcore_id);
-
-		qconf->graph_id = graph_id;
-		qconf->graph = rte_graph_lookup(qconf->name);
-		/* >8 End of graph initialization. */
-		if (!qconf->graph)
-			rte_exit(EXIT_FAILURE,
-					"rte_graph_lookup(): graph %s not found\n",
-					qconf->name);
 	}
 
+	/* Before the graph creation, for ip4_rewrite and ip6_rewrite to use them */
+	rc = fragment_configure();
+	if (rc < 0)
+		rte_exit(EXIT_FAILURE, "Unable to configure fragment nodes: err=%d\n", rc);
+
+	rc = graph_workers_create(default_patterns, RTE_DIM(default_patterns));
+	if (rc)
+		rte_exit(EXIT_FAILURE, "Unable to create worker graphs: err=%d\n", rc);
+	/* >8 End of graph initialization. */
+
 	rc = route_ip4_add_to_lookup();
 	if (rc < 0)
 		rte_exit(EXIT_FAILURE, "Unable to add v4 route to lookup table\n");
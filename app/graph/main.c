@@ -213,6 +213,13 @@ main(int argc, char **argv)
 	signal(SIGINT, signal_handler);
 	signal(SIGTERM, signal_handler);
 
+	/* Secondary process walks graphs of the primary one until signaled */
+	if (rte_eal_process_type() == RTE_PROC_SECONDARY) {
+		rc = graph_secondary_walk();
+		rte_eal_cleanup();
+		return rc;
+	}
+
 	cli_init();
 
 	/* Script */
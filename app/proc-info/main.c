@@ -107,6 +107,9 @@ static char *mempool_name;
 /* Enable iter mempool. */
 static uint32_t enable_iter_mempool;
 static char *mempool_iter_name;
+/* Enable show mbuf history. */
+static uint32_t enable_shw_mbuf_history;
+static char *mbuf_history_pool_name;
 /* Enable dump regs. */
 static uint32_t enable_dump_regs;
 static char *dump_regs_file_prefix;
@@ -195,6 +198,7 @@ proc_info_usage(const char *prgname)
 			"offset: The offset of the descriptor starting from tail. "
 			"num: The number of the descriptors to dump.\n"
 		"  --iter-mempool=name: iterate mempool elements to display content\n"
+		"  --show-mbuf-history[=name]: to display mbuf lifecycle summary of mbuf pools\n"
 		"  --dump-regs=file-prefix: dump registers to file with the file-prefix\n"
 		"  --show-edev-queue-xstats=queue_num:evdev_id or *:evdev_id to get queue xstats for specified queue or all queues;\n"
 		"  --show-edev-port-xstats=port_num:evdev_id or *:evdev_id to get queue xstats for specified port or all ports;\n"
@@ -442,6 +446,7 @@ proc_info_parse_args(int argc, char **argv)
 		{"show-ring", optional_argument, NULL, 0},
 		{"show-mempool", optional_argument, NULL, 0},
 		{"iter-mempool", required_argument, NULL, 0},
+		{"show-mbuf-history", optional_argument, NULL, 0},
 		{"dump-regs", required_argument, NULL, 0},
 		{"version", 0, NULL, 0},
 		{"firmware-version", 0, NULL, 0},
@@ -526,6 +531,10 @@ proc_info_parse_args(int argc, char **argv)
 					"iter-mempool", MAX_LONG_OPT_SZ)) {
 				enable_iter_mempool = 1;
 				mempool_iter_name = optarg;
+			} else if (!strncmp(long_option[option_index].name,
+					"show-mbuf-history", MAX_LONG_OPT_SZ)) {
+				enable_shw_mbuf_history = 1;
+				mbuf_history_pool_name = optarg;
 			} else if (!strncmp(long_option[option_index].name,
 					"dump-regs", MAX_LONG_OPT_SZ)) {
 				enable_dump_regs = 1;
@@ -1694,6 +1703,57 @@ iter_mempool(char *name)
 	}
 }
 
+static void
+show_mbuf_history_pool(struct rte_mempool *mp, void *arg __rte_unused)
+{
+	struct rte_mbuf_history_stats stats;
+	unsigned int i;
+	int ret;
+
+	if (mp->elt_size < sizeof(struct rte_mbuf))
+		return;
+
+	ret = rte_mbuf_history_stats_get(mp, &stats);
+	if (ret != 0) {
+		printf("  - %s: cannot get mbuf history (%s)\n",
+			mp->name, rte_strerror(-ret));
+		return;
+	}
+
+	printf("  - Name: %s, walked %"PRIu64" mbufs\n", mp->name, stats.total);
+	for (i = 0; i < RTE_MBUF_HISTORY_STAGE_MAX; i++) {
+		printf("\t  -- %-8s %"PRIu64"", rte_mbuf_history_stage_name(i),
+			stats.stage[i]);
+		if (stats.stage_aged[i] != 0)
+			printf(" (age avg %"PRIu64" max %"PRIu64" cycles)",
+				stats.stage_age_sum[i] / stats.stage_aged[i],
+				stats.stage_age_max[i]);
+		printf("\n");
+	}
+}
+
+static void
+show_mbuf_history(char *name)
+{
+	snprintf(bdr_str, MAX_STRING_LEN, " show - MBUF HISTORY ");
+	STATS_BDR_STR(10, bdr_str);
+
+	/* find the history dynamic field registered by the primary */
+	rte_mbuf_history_init();
+
+	if (name != NULL) {
+		struct rte_mempool *ptr = rte_mempool_lookup(name);
+		if (ptr == NULL) {
+			printf("  - mempool %s not found\n", name);
+			return;
+		}
+		show_mbuf_history_pool(ptr, NULL);
+		return;
+	}
+
+	rte_mempool_walk(show_mbuf_history_pool, NULL);
+}
+
 static void
 dump_regs(char *file_prefix)
 {
@@ -2234,6 +2294,8 @@ main(int argc, char **argv)
 		show_mempool(mempool_name);
 	if (enable_iter_mempool)
 		iter_mempool(mempool_iter_name);
+	if (enable_shw_mbuf_history)
+		show_mbuf_history(mbuf_history_pool_name);
 	if (enable_dump_regs)
 		dump_regs(dump_regs_file_prefix);
 	if (enable_shw_version)
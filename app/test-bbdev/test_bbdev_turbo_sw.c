@@ -0,0 +1,303 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_lcore.h>
+#include <rte_mbuf.h>
+#include <rte_mempool.h>
+
+#include <rte_bus_vdev.h>
+
+#include <rte_bbdev.h>
+#include <rte_bbdev_op.h>
+#include <rte_bbdev_pmd.h>
+
+#include "main.h"
+
+#define TURBO_SW_INLINE_NAME  "baseband_turbo_sw_inline"
+#define TURBO_SW_WORKER_NAME  "baseband_turbo_sw_worker"
+
+#define TEST_NB_OPS   64
+#define TEST_NB_CBS   3
+#define TEST_K        40
+/* Circular buffer size of a code block of TEST_K bits */
+#define TEST_KW       (RTE_ALIGN_CEIL(TEST_K + 4, RTE_BBDEV_TURBO_C_SUBBLOCK) * 3)
+#define TEST_TIMEOUT_MS 5000
+
+struct turbo_sw_testsuite_params {
+	struct rte_mempool *op_pool;
+	struct rte_mempool *mbuf_pool;
+	struct rte_bbdev_dec_op *ops[2][TEST_NB_OPS];
+	unsigned int worker;
+};
+
+static struct turbo_sw_testsuite_params testsuite_params;
+
+static int
+testsuite_setup(void)
+{
+	struct turbo_sw_testsuite_params *ts = &testsuite_params;
+	char args[32];
+
+	ts->worker = rte_get_next_lcore(-1, 1, 0);
+	if (ts->worker >= RTE_MAX_LCORE) {
+		printf("Test needs a lcore for the worker, skipping\n");
+		return TEST_SKIPPED;
+	}
+
+	if (rte_vdev_init(TURBO_SW_INLINE_NAME, NULL) != 0) {
+		printf("Cannot create %s, skipping\n", TURBO_SW_INLINE_NAME);
+		return TEST_SKIPPED;
+	}
+	snprintf(args, sizeof(args), "worker=%u", ts->worker);
+	TEST_ASSERT_SUCCESS(rte_vdev_init(TURBO_SW_WORKER_NAME, args),
+			"Cannot create %s", TURBO_SW_WORKER_NAME);
+
+	ts->op_pool = rte_bbdev_op_pool_create("turbo_sw_test_op_pool",
+			RTE_BBDEV_OP_TURBO_DEC, 4 * TEST_NB_OPS, 0,
+			SOCKET_ID_ANY);
+	TEST_ASSERT_NOT_NULL(ts->op_pool, "Cannot create op pool");
+
+	ts->mbuf_pool = rte_pktmbuf_pool_create("turbo_sw_test_mbuf_pool",
+			8 * TEST_NB_OPS, 0, 0, RTE_MBUF_DEFAULT_BUF_SIZE,
+			SOCKET_ID_ANY);
+	TEST_ASSERT_NOT_NULL(ts->mbuf_pool, "Cannot create mbuf pool");
+
+	return TEST_SUCCESS;
+}
+
+static void
+testsuite_teardown(void)
+{
+	struct turbo_sw_testsuite_params *ts = &testsuite_params;
+
+	rte_mempool_free(ts->mbuf_pool);
+	rte_mempool_free(ts->op_pool);
+	ts->mbuf_pool = NULL;
+	ts->op_pool = NULL;
+	rte_vdev_uninit(TURBO_SW_WORKER_NAME);
+	rte_vdev_uninit(TURBO_SW_INLINE_NAME);
+}
+
+static int
+dev_has_turbo_dec(uint16_t dev_id)
+{
+	const struct rte_bbdev_op_cap *cap;
+	struct rte_bbdev_info info;
+
+	if (rte_bbdev_info_get(dev_id, &info) != 0)
+		return 0;
+
+	for (cap = info.drv.capabilities; cap->type != RTE_BBDEV_OP_NONE;
+			cap++)
+		if (cap->type == RTE_BBDEV_OP_TURBO_DEC)
+			return 1;
+
+	return 0;
+}
+
+static int
+dev_start(const char *name, uint16_t *dev_id)
+{
+	struct rte_bbdev_queue_conf qconf = {
+		.socket = SOCKET_ID_ANY,
+		.queue_size = TEST_NB_OPS,
+		.op_type = RTE_BBDEV_OP_TURBO_DEC,
+	};
+	struct rte_bbdev *dev;
+
+	dev = rte_bbdev_get_named_dev(name);
+	TEST_ASSERT_NOT_NULL(dev, "Cannot find %s", name);
+	*dev_id = dev->data->dev_id;
+
+	TEST_ASSERT_SUCCESS(rte_bbdev_setup_queues(*dev_id, 1, SOCKET_ID_ANY),
+			"Cannot setup queues of %s", name);
+	TEST_ASSERT_SUCCESS(rte_bbdev_queue_configure(*dev_id, 0, &qconf),
+			"Cannot configure queue of %s", name);
+	TEST_ASSERT_SUCCESS(rte_bbdev_start(*dev_id), "Cannot start %s", name);
+
+	return TEST_SUCCESS;
+}
+
+/* Transport blocks of TEST_NB_CBS code blocks, with the same input for both
+ * devices.
+ */
+static int
+ops_init(struct rte_bbdev_dec_op **ops)
+{
+	struct turbo_sw_testsuite_params *ts = &testsuite_params;
+	struct rte_bbdev_op_turbo_dec *dec;
+	int8_t *llr;
+	unsigned int i, j;
+
+	TEST_ASSERT_SUCCESS(rte_bbdev_dec_op_alloc_bulk(ts->op_pool, ops,
+			TEST_NB_OPS), "Cannot allocate ops");
+
+	for (i = 0; i < TEST_NB_OPS; i++) {
+		dec = &ops[i]->turbo_dec;
+		memset(dec, 0, sizeof(*dec));
+		dec->input.data = rte_pktmbuf_alloc(ts->mbuf_pool);
+		dec->hard_output.data = rte_pktmbuf_alloc(ts->mbuf_pool);
+		TEST_ASSERT(dec->input.data != NULL &&
+				dec->hard_output.data != NULL,
+				"Cannot allocate mbufs");
+
+		llr = (int8_t *)rte_pktmbuf_append(dec->input.data,
+				TEST_NB_CBS * TEST_KW);
+		TEST_ASSERT_NOT_NULL(llr, "Too little space in input mbuf");
+		for (j = 0; j < TEST_NB_CBS * TEST_KW; j++)
+			llr[j] = (int8_t)(((i + 1) * (j + 7) * 13) % 31) - 15;
+
+		dec->input.length = TEST_NB_CBS * TEST_KW;
+		dec->op_flags = RTE_BBDEV_TURBO_SUBBLOCK_DEINTERLEAVE |
+				RTE_BBDEV_TURBO_POS_LLR_1_BIT_IN |
+				RTE_BBDEV_TURBO_CRC_TYPE_24B |
+				RTE_BBDEV_TURBO_EARLY_TERMINATION;
+		dec->iter_max = 4;
+		dec->iter_min = 1;
+		dec->code_block_mode = RTE_BBDEV_TRANSPORT_BLOCK;
+		dec->tb_params.c = TEST_NB_CBS;
+		dec->tb_params.c_neg = 0;
+		dec->tb_params.k_neg = TEST_K;
+		dec->tb_params.k_pos = TEST_K;
+		dec->tb_params.cab = TEST_NB_CBS;
+	}
+
+	return TEST_SUCCESS;
+}
+
+static void
+ops_free(struct rte_bbdev_dec_op **ops)
+{
+	unsigned int i;
+
+	for (i = 0; i < TEST_NB_OPS; i++) {
+		if (ops[i] == NULL)
+			continue;
+		rte_pktmbuf_free(ops[i]->turbo_dec.input.data);
+		rte_pktmbuf_free(ops[i]->turbo_dec.hard_output.data);
+	}
+	if (ops[0] != NULL)
+		rte_bbdev_dec_op_free_bulk(ops, TEST_NB_OPS);
+	memset(ops, 0, TEST_NB_OPS * sizeof(ops[0]));
+}
+
+/* Run the operations on a device, checking they are dequeued in enqueue
+ * order.
+ */
+static int
+ops_run(uint16_t dev_id, struct rte_bbdev_dec_op **ops,
+		struct rte_bbdev_stats *stats)
+{
+	struct rte_bbdev_dec_op *deq[TEST_NB_OPS];
+	uint64_t deadline;
+	uint16_t nb_enq = 0, nb_deq = 0;
+	unsigned int i;
+
+	deadline = rte_get_timer_cycles() +
+			rte_get_timer_hz() * TEST_TIMEOUT_MS / 1000;
+	while (nb_deq < TEST_NB_OPS) {
+		nb_enq += rte_bbdev_enqueue_dec_ops(dev_id, 0, &ops[nb_enq],
+				TEST_NB_OPS - nb_enq);
+		nb_deq += rte_bbdev_dequeue_dec_ops(dev_id, 0, &deq[nb_deq],
+				nb_enq - nb_deq);
+		TEST_ASSERT(rte_get_timer_cycles() < deadline,
+				"Only %u of %u ops dequeued", nb_deq,
+				TEST_NB_OPS);
+	}
+
+	for (i = 0; i < TEST_NB_OPS; i++)
+		TEST_ASSERT(deq[i] == ops[i],
+				"Op %u dequeued out of enqueue order", i);
+
+	TEST_ASSERT_SUCCESS(rte_bbdev_stats_get(dev_id, stats),
+			"Cannot get stats");
+	TEST_ASSERT(stats->dequeued_count == TEST_NB_OPS,
+			"Dequeued count %" PRIu64 ", expected %u",
+			stats->dequeued_count, TEST_NB_OPS);
+
+	return TEST_SUCCESS;
+}
+
+/* The code blocks decoded by the worker give the same results as the
+ * ones decoded in the enqueue call.
+ */
+static int
+test_turbo_sw_worker_dec(void)
+{
+	struct turbo_sw_testsuite_params *ts = &testsuite_params;
+	struct rte_bbdev_op_turbo_dec *exp, *dec;
+	struct rte_bbdev_stats stats;
+	uint16_t inline_id, worker_id;
+	unsigned int i;
+	int ret;
+
+	if (!dev_has_turbo_dec(rte_bbdev_get_named_dev(
+			TURBO_SW_INLINE_NAME)->data->dev_id)) {
+		printf("Turbo decoding is not supported, skipping\n");
+		return TEST_SKIPPED;
+	}
+
+	TEST_ASSERT_SUCCESS(dev_start(TURBO_SW_INLINE_NAME, &inline_id),
+			"Cannot start inline device");
+	TEST_ASSERT_SUCCESS(dev_start(TURBO_SW_WORKER_NAME, &worker_id),
+			"Cannot start worker device");
+
+	ret = ops_init(ts->ops[0]);
+	if (ret == TEST_SUCCESS)
+		ret = ops_init(ts->ops[1]);
+	if (ret == TEST_SUCCESS)
+		ret = ops_run(inline_id, ts->ops[0], &stats);
+	if (ret == TEST_SUCCESS)
+		ret = ops_run(worker_id, ts->ops[1], &stats);
+	/* Decoding cycles of the workers are merged at dequeue */
+	if (ret == TEST_SUCCESS && stats.acc_offload_cycles == 0) {
+		printf("No offload cycles reported by worker device\n");
+		ret = TEST_FAILED;
+	}
+
+	for (i = 0; ret == TEST_SUCCESS && i < TEST_NB_OPS; i++) {
+		exp = &ts->ops[0][i]->turbo_dec;
+		dec = &ts->ops[1][i]->turbo_dec;
+		if (ts->ops[0][i]->status != ts->ops[1][i]->status ||
+				exp->iter_count != dec->iter_count ||
+				exp->hard_output.length !=
+				dec->hard_output.length ||
+				rte_pktmbuf_data_len(exp->hard_output.data) !=
+				rte_pktmbuf_data_len(dec->hard_output.data) ||
+				memcmp(rte_pktmbuf_mtod(exp->hard_output.data,
+					void *),
+				rte_pktmbuf_mtod(dec->hard_output.data,
+					void *),
+				rte_pktmbuf_data_len(
+					exp->hard_output.data)) != 0) {
+			printf("Op %u decoded by worker differs\n", i);
+			ret = TEST_FAILED;
+		}
+	}
+
+	ops_free(ts->ops[0]);
+	ops_free(ts->ops[1]);
+	rte_bbdev_close(worker_id);
+	rte_bbdev_close(inline_id);
+
+	return ret;
+}
+
+static struct unit_test_suite bbdev_turbo_sw_testsuite = {
+	.suite_name = "BBDEV turbo_sw Workers Unit Test Suite",
+	.setup = testsuite_setup,
+	.teardown = testsuite_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_turbo_sw_worker_dec),
+
+		TEST_CASES_END() /**< NULL terminate unit test array */
+	}
+};
+
+REGISTER_TEST_COMMAND(turbo_sw, bbdev_turbo_sw_testsuite);
@@ -59,8 +59,8 @@ usage(char *progname)
 		"		compressed/decompressed (default: 10000)\n"
 		" --operation [comp/decomp/comp_and_decomp]: perform test on\n"
 		"		compression, decompression or both operations\n"
-		" --algo [null/deflate/lzs/lz4]: perform test on algorithm\n"
-		"		null(DMA), deflate, lzs or lz4 (default: deflate)\n"
+		" --algo [null/deflate/lzs/lz4/zstd]: perform test on algorithm\n"
+		"		null(DMA), deflate, lzs, lz4 or zstd (default: deflate)\n"
 		" --huffman-enc [fixed/dynamic/default]: Huffman encoding\n"
 		"		(default: dynamic)\n"
 		" --lz4-flags N: flags to configure LZ4 algorithm (default: 0)\n"
@@ -513,6 +513,10 @@ parse_algo(struct comp_test_data *test_data, const char *arg)
 		{
 			"lz4",
 			RTE_COMP_ALGO_LZ4
+		},
+		{
+			"zstd",
+			RTE_COMP_ALGO_ZSTD
 		}
 	};
 
@@ -115,8 +115,13 @@ main_loop(struct cperf_verify_ctx *ctx, enum rte_comp_xform_type type)
 			xform.compress.deflate.huffman = test_data->huffman_enc;
 			xform.compress.deflate.dictionary = dict;
 			xform.compress.deflate.dictionary_len = window_size;
-		} else if (test_data->test_algo == RTE_COMP_ALGO_LZ4)
+		} else if (test_data->test_algo == RTE_COMP_ALGO_LZ4) {
 			xform.compress.lz4.flags = test_data->lz4_flags;
+		} else if (test_data->test_algo == RTE_COMP_ALGO_ZSTD) {
+			xform.compress.zstd.dictionary = test_data->dictionary_data;
+			xform.compress.zstd.dictionary_len =
+				test_data->dictionary_data_sz;
+		}
 		output_data_ptr = ctx->mem.compressed_data;
 		output_data_sz = &ctx->comp_data_sz;
 		input_bufs = mem->decomp_bufs;
@@ -135,8 +140,13 @@ main_loop(struct cperf_verify_ctx *ctx, enum rte_comp_xform_type type)
 		if (test_data->test_algo == RTE_COMP_ALGO_DEFLATE) {
 			xform.decompress.inflate.dictionary = dict;
 			xform.decompress.inflate.dictionary_len = window_size;
-		} else if (test_data->test_algo == RTE_COMP_ALGO_LZ4)
+		} else if (test_data->test_algo == RTE_COMP_ALGO_LZ4) {
 			xform.decompress.lz4.flags = test_data->lz4_flags;
+		} else if (test_data->test_algo == RTE_COMP_ALGO_ZSTD) {
+			xform.decompress.zstd.dictionary = test_data->dictionary_data;
+			xform.decompress.zstd.dictionary_len =
+				test_data->dictionary_data_sz;
+		}
 		output_data_ptr = ctx->mem.decompressed_data;
 		output_data_sz = &ctx->decomp_data_sz;
 		input_bufs = mem->comp_bufs;
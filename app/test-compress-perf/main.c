@@ -102,6 +102,21 @@ comp_perf_check_capabilities(struct comp_test_data *test_data, uint8_t cdev_id)
 				"Compress device does not support LZ4 independent blocks\n");
 			return -1;
 		}
+
+		if ((test_data->lz4_flags & RTE_COMP_LZ4_FLAG_RAW_BLOCK) &&
+		    (comp_flags & RTE_COMP_FF_LZ4_RAW_BLOCK) == 0) {
+			RTE_LOG(ERR, USER1,
+				"Compress device does not support LZ4 raw blocks\n");
+			return -1;
+		}
+		break;
+	case RTE_COMP_ALGO_ZSTD:
+		if (test_data->dictionary_data != NULL &&
+		    (comp_flags & RTE_COMP_FF_ZSTD_DICTIONARY) == 0) {
+			RTE_LOG(ERR, USER1,
+				"Compress device does not support zstd dictionary\n");
+			return -1;
+		}
 		break;
 	case RTE_COMP_ALGO_LZS:
 	case RTE_COMP_ALGO_NULL:
@@ -196,7 +196,10 @@ def parse_parameters(config_parameters):
     """Convert the JSON config to list of strings."""
     params = []
     for (key, val) in config_parameters:
-        if isinstance(val, bool):
+        if isinstance(val, list):
+            # repeated option, e.g. several vdev
+            params += parse_parameters((key, v) for v in val)
+        elif isinstance(val, bool):
             params.append("--" + key if val is True else "")
         elif len(key) == 1:
             params.append("-" + key)
@@ -25,6 +25,11 @@
 #define MAX_DEQD_RETRIES 10
 #define DEQUEUE_WAIT_TIME 10000
 
+/* Input and output sizes of the operations of the stream tests */
+#define STATEFUL_IN_CHUNK_SIZE 100
+#define STATEFUL_OUT_BLOCK_SIZE 256
+#define STATEFUL_STEPS_MAX 1024
+
 /*
  * 30% extra size for compressed data compared to original data,
  * in case data size cannot be reduced and it is actually bigger
@@ -1217,7 +1222,8 @@ test_deflate_comp_run(const struct interim_data_params *int_data,
 	void **priv_xforms = test_priv_data->priv_xforms;
 
 	const struct rte_compressdev_capabilities *capa =
-		rte_compressdev_capability_get(0, RTE_COMP_ALGO_DEFLATE);
+		rte_compressdev_capability_get(0,
+			compress_xforms[0]->compress.algo);
 
 	/* Build the compression operations */
 	ret = rte_comp_op_bulk_alloc(ts_params->op_pool, ops, num_bufs);
@@ -1547,7 +1553,8 @@ test_deflate_decomp_run(const struct interim_data_params *int_data,
 	void **stream = test_priv_data->stream;
 
 	const struct rte_compressdev_capabilities *capa =
-		rte_compressdev_capability_get(0, RTE_COMP_ALGO_DEFLATE);
+		rte_compressdev_capability_get(0,
+			decompress_xforms[0]->decompress.algo);
 
 	ret = rte_comp_op_bulk_alloc(ts_params->op_pool, ops, num_bufs);
 	if (ret < 0) {
@@ -2033,10 +2040,11 @@ test_deflate_comp_decomp(const struct interim_data_params *int_data,
 
 	test_priv_data.num_priv_xforms = 0; /* it's used for decompression only */
 
-	capa = rte_compressdev_capability_get(0, RTE_COMP_ALGO_DEFLATE);
+	capa = rte_compressdev_capability_get(0,
+			int_data->compress_xforms[0]->compress.algo);
 	if (capa == NULL) {
 		RTE_LOG(ERR, USER1,
-			"Compress device does not support DEFLATE\n");
+			"Compress device does not support the algorithm\n");
 		return -1;
 	}
 
@@ -4164,6 +4172,687 @@ test_compressdev_deflate_im_buffers_SGL_over_2ops_second(void)
 	return ret;
 }
 
+/*
+ * Compress and decompress a linear buffer with compressdev only,
+ * and check the decompressed data matches the input.
+ * Used for the algorithms which cannot be checked with zlib.
+ */
+static int
+test_comp_decomp_roundtrip(const struct rte_comp_xform *compress_xform,
+		const struct rte_comp_xform *decompress_xform,
+		const char *test_buf, uint32_t len)
+{
+	struct comp_testsuite_params *ts_params = &testsuite_params;
+	struct rte_mbuf *uncomp_buf, *comp_buf, *decomp_buf;
+	struct rte_comp_op *op = NULL, *op_processed = NULL;
+	void *priv_xform = NULL;
+	uint32_t comp_len;
+	char *data;
+	int ret = -1;
+
+	uncomp_buf = rte_pktmbuf_alloc(ts_params->large_mbuf_pool);
+	comp_buf = rte_pktmbuf_alloc(ts_params->large_mbuf_pool);
+	decomp_buf = rte_pktmbuf_alloc(ts_params->large_mbuf_pool);
+	op = rte_comp_op_alloc(ts_params->op_pool);
+	if (uncomp_buf == NULL || comp_buf == NULL || decomp_buf == NULL ||
+			op == NULL) {
+		RTE_LOG(ERR, USER1, "Buffers or operation could not be allocated\n");
+		goto exit;
+	}
+
+	data = rte_pktmbuf_append(uncomp_buf, len);
+	if (data == NULL ||
+			rte_pktmbuf_append(comp_buf,
+				rte_pktmbuf_tailroom(comp_buf)) == NULL ||
+			rte_pktmbuf_append(decomp_buf,
+				rte_pktmbuf_tailroom(decomp_buf)) == NULL) {
+		RTE_LOG(ERR, USER1, "Buffers too small\n");
+		goto exit;
+	}
+	memcpy(data, test_buf, len);
+
+	/* Compression */
+	if (rte_compressdev_private_xform_create(0, compress_xform,
+			&priv_xform) < 0) {
+		RTE_LOG(ERR, USER1, "Compression private xform could not be created\n");
+		goto exit;
+	}
+	op->m_src = uncomp_buf;
+	op->m_dst = comp_buf;
+	op->src.offset = 0;
+	op->src.length = len;
+	op->dst.offset = 0;
+	op->flush_flag = RTE_COMP_FLUSH_FINAL;
+	op->op_type = RTE_COMP_OP_STATELESS;
+	op->private_xform = priv_xform;
+	if (test_run_enqueue_dequeue(&op, &op_processed, 1) < 0)
+		goto exit;
+	if (op->status != RTE_COMP_OP_STATUS_SUCCESS) {
+		RTE_LOG(ERR, USER1, "Compression failed, status %u\n", op->status);
+		goto exit;
+	}
+	comp_len = op->produced;
+	rte_compressdev_private_xform_free(0, priv_xform);
+	priv_xform = NULL;
+
+	/* Decompression */
+	if (rte_compressdev_private_xform_create(0, decompress_xform,
+			&priv_xform) < 0) {
+		RTE_LOG(ERR, USER1, "Decompression private xform could not be created\n");
+		goto exit;
+	}
+	op->m_src = comp_buf;
+	op->m_dst = decomp_buf;
+	op->src.length = comp_len;
+	op->status = RTE_COMP_OP_STATUS_NOT_PROCESSED;
+	op->private_xform = priv_xform;
+	if (test_run_enqueue_dequeue(&op, &op_processed, 1) < 0)
+		goto exit;
+	if (op->status != RTE_COMP_OP_STATUS_SUCCESS) {
+		RTE_LOG(ERR, USER1, "Decompression failed, status %u\n", op->status);
+		goto exit;
+	}
+	if (op->produced != len ||
+			memcmp(rte_pktmbuf_mtod(decomp_buf, char *), test_buf, len) != 0) {
+		RTE_LOG(ERR, USER1, "Decompressed data does not match the input\n");
+		goto exit;
+	}
+	ret = 0;
+
+exit:
+	if (priv_xform != NULL)
+		rte_compressdev_private_xform_free(0, priv_xform);
+	rte_comp_op_free(op);
+	rte_pktmbuf_free(uncomp_buf);
+	rte_pktmbuf_free(comp_buf);
+	rte_pktmbuf_free(decomp_buf);
+	return ret;
+}
+
+/*
+ * Run the stateful operations of a stream on a linear source, giving each
+ * operation at most in_chunk bytes of input and out_block bytes of output
+ * room, so that the stream state is carried across several operations.
+ * The output is appended to dst, its length is returned in dst_len.
+ */
+static int
+test_run_stateful_stream(void *stream, struct rte_comp_op *op,
+		struct rte_mbuf *src, uint32_t src_len, struct rte_mbuf *dst,
+		uint32_t in_chunk, uint32_t out_block, uint32_t *dst_len)
+{
+	struct rte_comp_op *op_processed = NULL;
+	uint32_t consumed = 0, produced = 0;
+	unsigned int step;
+	uint32_t room;
+
+	for (step = 0; step < STATEFUL_STEPS_MAX; step++) {
+		/* Output room of this operation only */
+		room = RTE_MIN(out_block, rte_pktmbuf_tailroom(dst));
+		if (room == 0 || rte_pktmbuf_append(dst, room) == NULL) {
+			RTE_LOG(ERR, USER1, "Stream output buffer too small\n");
+			return -1;
+		}
+
+		op->m_src = src;
+		op->m_dst = dst;
+		op->src.offset = consumed;
+		op->src.length = RTE_MIN(in_chunk, src_len - consumed);
+		op->dst.offset = produced;
+		op->op_type = RTE_COMP_OP_STATEFUL;
+		op->stream = stream;
+		op->flush_flag = consumed + op->src.length == src_len ?
+				RTE_COMP_FLUSH_FINAL : RTE_COMP_FLUSH_NONE;
+		op->status = RTE_COMP_OP_STATUS_NOT_PROCESSED;
+		if (test_run_enqueue_dequeue(&op, &op_processed, 1) < 0)
+			return -1;
+
+		if (op->status != RTE_COMP_OP_STATUS_SUCCESS &&
+				op->status !=
+				RTE_COMP_OP_STATUS_OUT_OF_SPACE_RECOVERABLE) {
+			RTE_LOG(ERR, USER1, "Stream operation failed, status %u\n",
+				op->status);
+			return -1;
+		}
+		consumed += op->consumed;
+		produced += op->produced;
+		rte_pktmbuf_trim(dst, rte_pktmbuf_pkt_len(dst) - produced);
+
+		if (op->status == RTE_COMP_OP_STATUS_SUCCESS &&
+				consumed == src_len) {
+			*dst_len = produced;
+			return 0;
+		}
+	}
+
+	RTE_LOG(ERR, USER1, "Stream exceeded %u operations\n",
+		STATEFUL_STEPS_MAX);
+	return -1;
+}
+
+/*
+ * Compress and decompress a buffer with compressdev streams, in several
+ * stateful operations each way, and check the decompressed data matches
+ * the input.
+ */
+static int
+test_comp_decomp_stateful_roundtrip(const struct rte_comp_xform *compress_xform,
+		const struct rte_comp_xform *decompress_xform,
+		const char *test_buf, uint32_t len)
+{
+	struct comp_testsuite_params *ts_params = &testsuite_params;
+	struct rte_mbuf *uncomp_buf, *comp_buf, *decomp_buf;
+	struct rte_comp_op *op = NULL;
+	uint32_t comp_len, decomp_len;
+	void *stream = NULL;
+	char *data;
+	int ret = -1;
+
+	uncomp_buf = rte_pktmbuf_alloc(ts_params->large_mbuf_pool);
+	comp_buf = rte_pktmbuf_alloc(ts_params->large_mbuf_pool);
+	decomp_buf = rte_pktmbuf_alloc(ts_params->large_mbuf_pool);
+	op = rte_comp_op_alloc(ts_params->op_pool);
+	if (uncomp_buf == NULL || comp_buf == NULL || decomp_buf == NULL ||
+			op == NULL) {
+		RTE_LOG(ERR, USER1, "Buffers or operation could not be allocated\n");
+		goto exit;
+	}
+
+	data = rte_pktmbuf_append(uncomp_buf, len);
+	if (data == NULL) {
+		RTE_LOG(ERR, USER1, "Buffers too small\n");
+		goto exit;
+	}
+	memcpy(data, test_buf, len);
+
+	/* Compression */
+	if (rte_compressdev_stream_create(0, compress_xform, &stream) < 0) {
+		RTE_LOG(ERR, USER1, "Compression stream could not be created\n");
+		goto exit;
+	}
+	if (test_run_stateful_stream(stream, op, uncomp_buf, len, comp_buf,
+			STATEFUL_IN_CHUNK_SIZE, STATEFUL_OUT_BLOCK_SIZE,
+			&comp_len) < 0)
+		goto exit;
+	rte_compressdev_stream_free(0, stream);
+	stream = NULL;
+
+	/* Decompression */
+	if (rte_compressdev_stream_create(0, decompress_xform, &stream) < 0) {
+		RTE_LOG(ERR, USER1, "Decompression stream could not be created\n");
+		goto exit;
+	}
+	if (test_run_stateful_stream(stream, op, comp_buf, comp_len, decomp_buf,
+			STATEFUL_IN_CHUNK_SIZE, STATEFUL_OUT_BLOCK_SIZE,
+			&decomp_len) < 0)
+		goto exit;
+
+	if (decomp_len != len ||
+			memcmp(rte_pktmbuf_mtod(decomp_buf, char *), test_buf, len) != 0) {
+		RTE_LOG(ERR, USER1, "Decompressed data does not match the input\n");
+		goto exit;
+	}
+	ret = 0;
+
+exit:
+	if (stream != NULL)
+		rte_compressdev_stream_free(0, stream);
+	rte_comp_op_free(op);
+	rte_pktmbuf_free(uncomp_buf);
+	rte_pktmbuf_free(comp_buf);
+	rte_pktmbuf_free(decomp_buf);
+	return ret;
+}
+
+/*
+ * Compress and decompress the test buffers with compressdev only,
+ * with chained source and/or destination mbufs as supported by the device.
+ */
+static int
+test_comp_decomp_sgl(struct rte_comp_xform *compress_xform,
+		struct rte_comp_xform *decompress_xform,
+		const struct rte_compressdev_capabilities *capab)
+{
+	static const struct {
+		enum varied_buff buff_type;
+		uint64_t feature;
+	} sgl_types[] = {
+		{ SGL_BOTH, RTE_COMP_FF_OOP_SGL_IN_SGL_OUT },
+		{ SGL_TO_LB, RTE_COMP_FF_OOP_SGL_IN_LB_OUT },
+		{ LB_TO_SGL, RTE_COMP_FF_OOP_LB_IN_SGL_OUT },
+	};
+	struct interim_data_params int_data = {
+		NULL,
+		1,
+		NULL,
+		&compress_xform,
+		&decompress_xform,
+		1
+	};
+	struct test_data_params test_data = {
+		.compress_state = RTE_COMP_OP_STATELESS,
+		.decompress_state = RTE_COMP_OP_STATELESS,
+		.zlib_dir = ZLIB_NONE,
+		.out_of_space = 0,
+		.big_data = 0,
+		.overflow = OVERFLOW_DISABLED,
+		.ratio = RATIO_ENABLED
+	};
+	unsigned int t;
+	uint16_t i;
+
+	for (t = 0; t < RTE_DIM(sgl_types); t++) {
+		if ((capab->comp_feature_flags & sgl_types[t].feature) == 0)
+			continue;
+
+		test_data.buff_type = sgl_types[t].buff_type;
+		for (i = 0; i < RTE_DIM(compress_test_bufs); i++) {
+			int_data.test_bufs = &compress_test_bufs[i];
+			int_data.buf_idx = &i;
+			if (test_deflate_comp_decomp(&int_data, &test_data) < 0) {
+				RTE_LOG(ERR, USER1, "Buffer %u failed with chained mbufs\n",
+					i);
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int
+test_compressdev_zstd_stateless(void)
+{
+	static const int levels[] = {
+		RTE_COMP_LEVEL_PMD_DEFAULT, 1, 2, 3, 4, 5, 6, 7, 8,
+		RTE_COMP_LEVEL_MAX, 19,
+	};
+	const struct rte_compressdev_capabilities *capab;
+	struct rte_comp_xform compress_xform = {
+		.type = RTE_COMP_COMPRESS,
+		.compress = {
+			.algo = RTE_COMP_ALGO_ZSTD,
+			.chksum = RTE_COMP_CHECKSUM_NONE,
+		},
+	};
+	struct rte_comp_xform decompress_xform = {
+		.type = RTE_COMP_DECOMPRESS,
+		.decompress = {
+			.algo = RTE_COMP_ALGO_ZSTD,
+			.chksum = RTE_COMP_CHECKSUM_NONE,
+		},
+	};
+	unsigned int i, l;
+
+	capab = rte_compressdev_capability_get(0, RTE_COMP_ALGO_ZSTD);
+	if (capab == NULL)
+		return TEST_SKIPPED;
+
+	/*
+	 * Compress with the largest window, decompress with the smallest:
+	 * the decompression window size is only a hint.
+	 */
+	compress_xform.compress.window_size = capab->window_size.max;
+	decompress_xform.decompress.window_size = capab->window_size.min;
+
+	for (i = 0; i < RTE_DIM(compress_test_bufs); i++) {
+		for (l = 0; l < RTE_DIM(levels); l++) {
+			compress_xform.compress.level = levels[l];
+			if (test_comp_decomp_roundtrip(&compress_xform,
+					&decompress_xform, compress_test_bufs[i],
+					strlen(compress_test_bufs[i]) + 1) < 0) {
+				RTE_LOG(ERR, USER1, "Level %d failed on buffer %u\n",
+					levels[l], i);
+				return TEST_FAILED;
+			}
+		}
+	}
+
+	/* Invalid level */
+	compress_xform.compress.level = 100;
+	if (test_comp_decomp_roundtrip(&compress_xform, &decompress_xform,
+			compress_test_bufs[0],
+			strlen(compress_test_bufs[0]) + 1) == 0) {
+		RTE_LOG(ERR, USER1, "Invalid level accepted\n");
+		return TEST_FAILED;
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_compressdev_zstd_dictionary(void)
+{
+	const struct rte_compressdev_capabilities *capab;
+	struct rte_comp_xform compress_xform = {
+		.type = RTE_COMP_COMPRESS,
+		.compress = {
+			.algo = RTE_COMP_ALGO_ZSTD,
+			.level = RTE_COMP_LEVEL_PMD_DEFAULT,
+			.chksum = RTE_COMP_CHECKSUM_NONE,
+		},
+	};
+	struct rte_comp_xform decompress_xform = {
+		.type = RTE_COMP_DECOMPRESS,
+		.decompress = {
+			.algo = RTE_COMP_ALGO_ZSTD,
+			.chksum = RTE_COMP_CHECKSUM_NONE,
+		},
+	};
+	struct rte_comp_xform *compress_xforms[] = { &compress_xform };
+	struct rte_comp_xform *decompress_xforms[] = { &decompress_xform };
+	struct interim_data_params int_data = {
+		NULL,
+		1,
+		NULL,
+		compress_xforms,
+		decompress_xforms,
+		1
+	};
+	struct test_data_params test_data = {
+		.compress_state = RTE_COMP_OP_STATELESS,
+		.decompress_state = RTE_COMP_OP_STATELESS,
+		.buff_type = LB_BOTH,
+		.zlib_dir = ZLIB_NONE,
+		.out_of_space = 0,
+		.big_data = 0,
+		.overflow = OVERFLOW_DISABLED,
+		.ratio = RATIO_ENABLED
+	};
+	uint16_t i;
+
+	capab = rte_compressdev_capability_get(0, RTE_COMP_ALGO_ZSTD);
+	if (capab == NULL ||
+			(capab->comp_feature_flags & RTE_COMP_FF_ZSTD_DICTIONARY) == 0)
+		return TEST_SKIPPED;
+
+	compress_xform.compress.window_size = capab->window_size.max;
+	decompress_xform.decompress.window_size = capab->window_size.max;
+
+	for (i = 0; i < RTE_DIM(compress_test_bufs); i++) {
+		/*
+		 * A raw content dictionary holding the buffer itself,
+		 * so that the frame refers to the dictionary.
+		 */
+		compress_xform.compress.zstd.dictionary =
+			(const uint8_t *)compress_test_bufs[i];
+		compress_xform.compress.zstd.dictionary_len =
+			strlen(compress_test_bufs[i]);
+		decompress_xform.decompress.zstd = compress_xform.compress.zstd;
+
+		int_data.test_bufs = &compress_test_bufs[i];
+		int_data.buf_idx = &i;
+		if (test_deflate_comp_decomp(&int_data, &test_data) < 0) {
+			RTE_LOG(ERR, USER1, "Dictionary failed on buffer %u\n", i);
+			return TEST_FAILED;
+		}
+
+		/* The frame cannot be decompressed without the dictionary */
+		decompress_xform.decompress.zstd.dictionary = NULL;
+		decompress_xform.decompress.zstd.dictionary_len = 0;
+		if (test_comp_decomp_roundtrip(&compress_xform, &decompress_xform,
+				compress_test_bufs[i],
+				strlen(compress_test_bufs[i]) + 1) == 0) {
+			RTE_LOG(ERR, USER1,
+				"Buffer %u decompressed without its dictionary\n",
+				i);
+			return TEST_FAILED;
+		}
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_compressdev_zstd_stateful(void)
+{
+	const struct rte_compressdev_capabilities *capab;
+	struct rte_comp_xform compress_xform = {
+		.type = RTE_COMP_COMPRESS,
+		.compress = {
+			.algo = RTE_COMP_ALGO_ZSTD,
+			.level = RTE_COMP_LEVEL_PMD_DEFAULT,
+			.zstd.flags = RTE_COMP_ZSTD_FLAG_CONTENT_CHECKSUM,
+			.chksum = RTE_COMP_CHECKSUM_NONE,
+		},
+	};
+	struct rte_comp_xform decompress_xform = {
+		.type = RTE_COMP_DECOMPRESS,
+		.decompress = {
+			.algo = RTE_COMP_ALGO_ZSTD,
+			.chksum = RTE_COMP_CHECKSUM_NONE,
+		},
+	};
+	unsigned int i;
+
+	capab = rte_compressdev_capability_get(0, RTE_COMP_ALGO_ZSTD);
+	if (capab == NULL ||
+			(capab->comp_feature_flags &
+			 RTE_COMP_FF_STATEFUL_COMPRESSION) == 0 ||
+			(capab->comp_feature_flags &
+			 RTE_COMP_FF_STATEFUL_DECOMPRESSION) == 0)
+		return TEST_SKIPPED;
+
+	compress_xform.compress.window_size = capab->window_size.max;
+	decompress_xform.decompress.window_size = capab->window_size.max;
+
+	for (i = 0; i < RTE_DIM(compress_test_bufs); i++) {
+		if (test_comp_decomp_stateful_roundtrip(&compress_xform,
+				&decompress_xform, compress_test_bufs[i],
+				strlen(compress_test_bufs[i]) + 1) < 0) {
+			RTE_LOG(ERR, USER1, "Stream failed on buffer %u\n", i);
+			return TEST_FAILED;
+		}
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_compressdev_zstd_stateless_sgl(void)
+{
+	const struct rte_compressdev_capabilities *capab;
+	struct rte_comp_xform compress_xform = {
+		.type = RTE_COMP_COMPRESS,
+		.compress = {
+			.algo = RTE_COMP_ALGO_ZSTD,
+			.level = RTE_COMP_LEVEL_PMD_DEFAULT,
+			.chksum = RTE_COMP_CHECKSUM_NONE,
+		},
+	};
+	struct rte_comp_xform decompress_xform = {
+		.type = RTE_COMP_DECOMPRESS,
+		.decompress = {
+			.algo = RTE_COMP_ALGO_ZSTD,
+			.chksum = RTE_COMP_CHECKSUM_NONE,
+		},
+	};
+
+	capab = rte_compressdev_capability_get(0, RTE_COMP_ALGO_ZSTD);
+	if (capab == NULL ||
+			(capab->comp_feature_flags & RTE_COMP_FF_OOP_SGL_IN_SGL_OUT) == 0)
+		return TEST_SKIPPED;
+
+	compress_xform.compress.window_size = capab->window_size.max;
+	decompress_xform.decompress.window_size = capab->window_size.max;
+
+	if (test_comp_decomp_sgl(&compress_xform, &decompress_xform, capab) < 0)
+		return TEST_FAILED;
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_compressdev_lz4_stateless_raw_block(void)
+{
+	static const int levels[] = {
+		RTE_COMP_LEVEL_PMD_DEFAULT, 1, 2, 3, 4, 5, 6, 7, 8,
+		RTE_COMP_LEVEL_MAX, 12,
+	};
+	const struct rte_compressdev_capabilities *capab;
+	struct rte_comp_xform compress_xform = {
+		.type = RTE_COMP_COMPRESS,
+		.compress = {
+			.algo = RTE_COMP_ALGO_LZ4,
+			.lz4.flags = RTE_COMP_LZ4_FLAG_RAW_BLOCK,
+			.chksum = RTE_COMP_CHECKSUM_NONE,
+		},
+	};
+	struct rte_comp_xform decompress_xform = {
+		.type = RTE_COMP_DECOMPRESS,
+		.decompress = {
+			.algo = RTE_COMP_ALGO_LZ4,
+			.lz4.flags = RTE_COMP_LZ4_FLAG_RAW_BLOCK,
+			.chksum = RTE_COMP_CHECKSUM_NONE,
+		},
+	};
+	unsigned int i, l;
+
+	capab = rte_compressdev_capability_get(0, RTE_COMP_ALGO_LZ4);
+	if (capab == NULL ||
+			(capab->comp_feature_flags & RTE_COMP_FF_LZ4_RAW_BLOCK) == 0)
+		return TEST_SKIPPED;
+
+	compress_xform.compress.window_size = capab->window_size.max;
+	decompress_xform.decompress.window_size = capab->window_size.max;
+
+	for (i = 0; i < RTE_DIM(compress_test_bufs); i++) {
+		for (l = 0; l < RTE_DIM(levels); l++) {
+			compress_xform.compress.level = levels[l];
+			if (test_comp_decomp_roundtrip(&compress_xform,
+					&decompress_xform, compress_test_bufs[i],
+					strlen(compress_test_bufs[i]) + 1) < 0) {
+				RTE_LOG(ERR, USER1, "Level %d failed on buffer %u\n",
+					levels[l], i);
+				return TEST_FAILED;
+			}
+		}
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_compressdev_lz4_stateless_frame(void)
+{
+	static const int levels[] = {
+		RTE_COMP_LEVEL_PMD_DEFAULT, 1, 4, RTE_COMP_LEVEL_MAX,
+	};
+	static const struct {
+		uint8_t flags;
+		uint64_t feature;
+	} frame_types[] = {
+		{ 0, 0 },
+		{ RTE_COMP_LZ4_FLAG_CONTENT_CHECKSUM,
+			RTE_COMP_FF_LZ4_CONTENT_WITH_CHECKSUM },
+		{ RTE_COMP_LZ4_FLAG_CONTENT_SIZE,
+			RTE_COMP_FF_LZ4_CONTENT_SIZE },
+		{ RTE_COMP_LZ4_FLAG_BLOCK_CHECKSUM,
+			RTE_COMP_FF_LZ4_BLOCK_WITH_CHECKSUM },
+		{ RTE_COMP_LZ4_FLAG_BLOCK_INDEPENDENCE,
+			RTE_COMP_FF_LZ4_BLOCK_INDEPENDENCE },
+		{ RTE_COMP_LZ4_FLAG_CONTENT_CHECKSUM |
+			RTE_COMP_LZ4_FLAG_CONTENT_SIZE |
+			RTE_COMP_LZ4_FLAG_BLOCK_CHECKSUM |
+			RTE_COMP_LZ4_FLAG_BLOCK_INDEPENDENCE,
+			RTE_COMP_FF_LZ4_CONTENT_WITH_CHECKSUM |
+			RTE_COMP_FF_LZ4_CONTENT_SIZE |
+			RTE_COMP_FF_LZ4_BLOCK_WITH_CHECKSUM |
+			RTE_COMP_FF_LZ4_BLOCK_INDEPENDENCE },
+	};
+	const struct rte_compressdev_capabilities *capab;
+	struct rte_comp_xform compress_xform = {
+		.type = RTE_COMP_COMPRESS,
+		.compress = {
+			.algo = RTE_COMP_ALGO_LZ4,
+			.chksum = RTE_COMP_CHECKSUM_NONE,
+		},
+	};
+	/* Any frame parameters are read from the frame descriptor */
+	struct rte_comp_xform decompress_xform = {
+		.type = RTE_COMP_DECOMPRESS,
+		.decompress = {
+			.algo = RTE_COMP_ALGO_LZ4,
+			.chksum = RTE_COMP_CHECKSUM_NONE,
+		},
+	};
+	unsigned int i, l, t;
+
+	capab = rte_compressdev_capability_get(0, RTE_COMP_ALGO_LZ4);
+	if (capab == NULL)
+		return TEST_SKIPPED;
+
+	compress_xform.compress.window_size = capab->window_size.max;
+	decompress_xform.decompress.window_size = capab->window_size.max;
+
+	for (t = 0; t < RTE_DIM(frame_types); t++) {
+		if ((capab->comp_feature_flags & frame_types[t].feature) !=
+				frame_types[t].feature)
+			continue;
+
+		compress_xform.compress.lz4.flags = frame_types[t].flags;
+		for (i = 0; i < RTE_DIM(compress_test_bufs); i++) {
+			for (l = 0; l < RTE_DIM(levels); l++) {
+				compress_xform.compress.level = levels[l];
+				if (test_comp_decomp_roundtrip(&compress_xform,
+						&decompress_xform,
+						compress_test_bufs[i],
+						strlen(compress_test_bufs[i]) + 1) < 0) {
+					RTE_LOG(ERR, USER1,
+						"Flags 0x%x level %d failed on buffer %u\n",
+						frame_types[t].flags, levels[l], i);
+					return TEST_FAILED;
+				}
+			}
+		}
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_compressdev_lz4_stateless_sgl(void)
+{
+	const struct rte_compressdev_capabilities *capab;
+	struct rte_comp_xform compress_xform = {
+		.type = RTE_COMP_COMPRESS,
+		.compress = {
+			.algo = RTE_COMP_ALGO_LZ4,
+			.level = RTE_COMP_LEVEL_PMD_DEFAULT,
+			.chksum = RTE_COMP_CHECKSUM_NONE,
+		},
+	};
+	struct rte_comp_xform decompress_xform = {
+		.type = RTE_COMP_DECOMPRESS,
+		.decompress = {
+			.algo = RTE_COMP_ALGO_LZ4,
+			.chksum = RTE_COMP_CHECKSUM_NONE,
+		},
+	};
+
+	capab = rte_compressdev_capability_get(0, RTE_COMP_ALGO_LZ4);
+	if (capab == NULL ||
+			(capab->comp_feature_flags & RTE_COMP_FF_OOP_SGL_IN_SGL_OUT) == 0)
+		return TEST_SKIPPED;
+
+	compress_xform.compress.window_size = capab->window_size.max;
+	decompress_xform.decompress.window_size = capab->window_size.max;
+
+	/* Frame format */
+	if (test_comp_decomp_sgl(&compress_xform, &decompress_xform, capab) < 0)
+		return TEST_FAILED;
+
+	/* Raw block format, chained buffers are linearized by the PMD */
+	if (capab->comp_feature_flags & RTE_COMP_FF_LZ4_RAW_BLOCK) {
+		compress_xform.compress.lz4.flags = RTE_COMP_LZ4_FLAG_RAW_BLOCK;
+		decompress_xform.decompress.lz4.flags = RTE_COMP_LZ4_FLAG_RAW_BLOCK;
+		if (test_comp_decomp_sgl(&compress_xform, &decompress_xform,
+				capab) < 0)
+			return TEST_FAILED;
+	}
+
+	return TEST_SUCCESS;
+}
+
 static struct unit_test_suite compressdev_testsuite  = {
 	.suite_name = "compressdev unit test suite",
 	.setup = testsuite_setup,
@@ -4245,6 +4934,21 @@ static struct unit_test_suite compressdev_testsuite  = {
 		TEST_CASE_ST(generic_ut_setup, generic_ut_teardown,
 		      test_compressdev_deflate_im_buffers_SGL_over_2ops_second),
 
+		TEST_CASE_ST(generic_ut_setup, generic_ut_teardown,
+			test_compressdev_zstd_stateless),
+		TEST_CASE_ST(generic_ut_setup, generic_ut_teardown,
+			test_compressdev_zstd_dictionary),
+		TEST_CASE_ST(generic_ut_setup, generic_ut_teardown,
+			test_compressdev_zstd_stateful),
+		TEST_CASE_ST(generic_ut_setup, generic_ut_teardown,
+			test_compressdev_zstd_stateless_sgl),
+		TEST_CASE_ST(generic_ut_setup, generic_ut_teardown,
+			test_compressdev_lz4_stateless_raw_block),
+		TEST_CASE_ST(generic_ut_setup, generic_ut_teardown,
+			test_compressdev_lz4_stateless_frame),
+		TEST_CASE_ST(generic_ut_setup, generic_ut_teardown,
+			test_compressdev_lz4_stateless_sgl),
+
 		TEST_CASES_END() /**< NULL terminate unit test array */
 	}
 };
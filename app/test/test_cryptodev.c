@@ -30,6 +30,10 @@
 #include <rte_cryptodev_scheduler_operations.h>
 #endif
 
+#ifdef RTE_HAS_OPENSSL
+#include <openssl/evp.h>
+#endif
+
 #include <rte_lcore.h>
 
 #include "test.h"
@@ -13217,6 +13221,182 @@ test_AES_GCM_authenticated_encryption_test_case_8(void)
 	return test_authenticated_encryption(&gcm_test_case_8);
 }
 
+#define AES_GCM_BURST_LENGTH (8)
+
+/* Check if OpenSSL can pipeline the AES-128-GCM encryptions */
+static bool
+openssl_aes_gcm_can_pipeline(void)
+{
+#if defined(RTE_HAS_OPENSSL) && (OPENSSL_VERSION_NUMBER >= 0x30500000L)
+	EVP_CIPHER *algo = EVP_CIPHER_fetch(NULL, "AES-128-GCM", NULL);
+	bool ret = algo != NULL && EVP_CIPHER_can_pipeline(algo, 1) == 1;
+
+	EVP_CIPHER_free(algo);
+	return ret;
+#else
+	return false;
+#endif
+}
+
+/*
+ * Create an AES-GCM encryption of the test data, in place, with the AAD,
+ * the IV and the first byte of plaintext changed by the seed.
+ */
+static struct rte_crypto_op *
+create_aead_burst_operation(const struct aead_test_data *tdata, uint8_t seed)
+{
+	struct crypto_testsuite_params *ts_params = &testsuite_params;
+	struct crypto_unittest_params *ut_params = &unittest_params;
+	unsigned int aad_pad_len = RTE_ALIGN_CEIL(tdata->aad.len, 16);
+	struct rte_crypto_op *op;
+	struct rte_mbuf *m;
+	uint8_t *data, *iv;
+
+	op = rte_crypto_op_alloc(ts_params->op_mpool, RTE_CRYPTO_OP_TYPE_SYMMETRIC);
+	m = rte_pktmbuf_alloc(ts_params->mbuf_pool);
+	if (op == NULL || m == NULL)
+		goto fail;
+
+	data = (uint8_t *)rte_pktmbuf_append(m, aad_pad_len + tdata->plaintext.len +
+			tdata->auth_tag.len);
+	if (data == NULL)
+		goto fail;
+	memset(data, 0, aad_pad_len);
+	memcpy(data, tdata->aad.data, tdata->aad.len);
+	data[0] ^= seed;
+	memcpy(data + aad_pad_len, tdata->plaintext.data, tdata->plaintext.len);
+	data[aad_pad_len] ^= seed;
+
+	iv = rte_crypto_op_ctod_offset(op, uint8_t *, IV_OFFSET);
+	memcpy(iv, tdata->iv.data, tdata->iv.len);
+	iv[tdata->iv.len - 1] ^= seed;
+
+	rte_crypto_op_attach_sym_session(op, ut_params->sess);
+	op->sym->m_src = m;
+	op->sym->aead.aad.data = data;
+	op->sym->aead.aad.phys_addr = rte_pktmbuf_iova(m);
+	op->sym->aead.data.offset = aad_pad_len;
+	op->sym->aead.data.length = tdata->plaintext.len;
+	op->sym->aead.digest.data = data + aad_pad_len + tdata->plaintext.len;
+	op->sym->aead.digest.phys_addr = rte_pktmbuf_iova_offset(m,
+			aad_pad_len + tdata->plaintext.len);
+
+	return op;
+
+fail:
+	rte_pktmbuf_free(m);
+	rte_crypto_op_free(op);
+	return NULL;
+}
+
+/*
+ * Encrypt a burst of operations of the same session, which the openssl PMD
+ * processes in one pipelined call, and compare the ciphertexts and tags with
+ * the ones of the same operations enqueued one by one.
+ */
+static int
+test_AES_GCM_auth_encryption_burst(void)
+{
+	struct crypto_testsuite_params *ts_params = &testsuite_params;
+	const struct aead_test_data *tdata = &gcm_test_case_4;
+	unsigned int aad_pad_len = RTE_ALIGN_CEIL(tdata->aad.len, 16);
+	struct rte_crypto_op *single[AES_GCM_BURST_LENGTH] = { NULL };
+	struct rte_crypto_op *burst[AES_GCM_BURST_LENGTH] = { NULL };
+	struct rte_crypto_op *deq[AES_GCM_BURST_LENGTH];
+	uint8_t dev_id = ts_params->valid_devs[0];
+	unsigned int i, nb_deq;
+	uint8_t *ref, *out;
+	int ret;
+
+	/* This test is for openssl PMD only */
+	if (gbl_driver_id != rte_cryptodev_driver_id_get(
+			RTE_STR(CRYPTODEV_NAME_OPENSSL_PMD)))
+		return TEST_SKIPPED;
+
+	if (global_api_test_type == CRYPTODEV_RAW_API_TEST)
+		return TEST_SKIPPED;
+
+	if (!openssl_aes_gcm_can_pipeline()) {
+		printf("OpenSSL cannot pipeline AES-GCM\n");
+		return TEST_SKIPPED;
+	}
+
+	ret = create_aead_session(dev_id, tdata->algo, RTE_CRYPTO_AEAD_OP_ENCRYPT,
+			tdata->key.data, tdata->key.len, tdata->aad.len,
+			tdata->auth_tag.len, tdata->iv.len);
+	if (ret != 0)
+		return ret;
+
+	ret = TEST_FAILED;
+	for (i = 0; i < AES_GCM_BURST_LENGTH; i++) {
+		single[i] = create_aead_burst_operation(tdata, i);
+		burst[i] = create_aead_burst_operation(tdata, i);
+		if (single[i] == NULL || burst[i] == NULL) {
+			printf("Failed to create operation %u\n", i);
+			goto free;
+		}
+	}
+
+	/* Reference results, one operation per enqueue */
+	for (i = 0; i < AES_GCM_BURST_LENGTH; i++) {
+		if (process_crypto_request(dev_id, single[i]) == NULL) {
+			printf("Operation %u failed\n", i);
+			goto free;
+		}
+	}
+
+	/* The operation without change gives the test vector */
+	ref = rte_pktmbuf_mtod_offset(single[0]->sym->m_src, uint8_t *, aad_pad_len);
+	if (memcmp(ref, tdata->ciphertext.data, tdata->ciphertext.len) != 0 ||
+			memcmp(ref + tdata->plaintext.len, tdata->auth_tag.data,
+				tdata->auth_tag.len) != 0) {
+		printf("Ciphertext or tag not as expected\n");
+		goto free;
+	}
+
+	if (rte_cryptodev_enqueue_burst(dev_id, 0, burst,
+			AES_GCM_BURST_LENGTH) != AES_GCM_BURST_LENGTH) {
+		printf("Error enqueuing burst\n");
+		goto free;
+	}
+
+	for (nb_deq = 0; nb_deq < AES_GCM_BURST_LENGTH; ) {
+		nb_deq += rte_cryptodev_dequeue_burst(dev_id, 0, &deq[nb_deq],
+				AES_GCM_BURST_LENGTH - nb_deq);
+		rte_pause();
+	}
+
+	for (i = 0; i < AES_GCM_BURST_LENGTH; i++) {
+		if (deq[i] != burst[i] ||
+				burst[i]->status != RTE_CRYPTO_OP_STATUS_SUCCESS) {
+			printf("Burst operation %u failed\n", i);
+			goto free;
+		}
+
+		ref = rte_pktmbuf_mtod_offset(single[i]->sym->m_src, uint8_t *,
+				aad_pad_len);
+		out = rte_pktmbuf_mtod_offset(burst[i]->sym->m_src, uint8_t *,
+				aad_pad_len);
+		if (memcmp(out, ref, tdata->plaintext.len + tdata->auth_tag.len) != 0) {
+			printf("Burst operation %u differs from single operation\n", i);
+			goto free;
+		}
+	}
+	ret = TEST_SUCCESS;
+
+free:
+	for (i = 0; i < AES_GCM_BURST_LENGTH; i++) {
+		if (single[i] != NULL)
+			rte_pktmbuf_free(single[i]->sym->m_src);
+		rte_crypto_op_free(single[i]);
+		if (burst[i] != NULL)
+			rte_pktmbuf_free(burst[i]->sym->m_src);
+		rte_crypto_op_free(burst[i]);
+	}
+
+	return ret;
+}
+
 static int
 test_AES_GCM_J0_authenticated_encryption_test_case_1(void)
 {
@@ -17886,6 +18066,15 @@ test_scheduler_mode_pkt_size_distr_op(void)
 	return 0;
 }
 
+static int
+test_scheduler_mode_least_loaded_op(void)
+{
+	TEST_ASSERT(test_scheduler_mode_op(CDEV_SCHED_MODE_LEAST_LOADED) ==
+			0, "Failed to set least-loaded mode");
+
+	return 0;
+}
+
 static int
 scheduler_multicore_testsuite_setup(void)
 {
@@ -17926,6 +18115,25 @@ scheduler_pkt_size_distr_testsuite_setup(void)
 	return 0;
 }
 
+static int
+scheduler_least_loaded_testsuite_setup(void)
+{
+	struct crypto_testsuite_params *ts_params = &testsuite_params;
+	struct rte_cryptodev_scheduler_session_affinity_option option = {
+		.enable = 1
+	};
+
+	if (test_scheduler_attach_worker_op() < 0)
+		return TEST_SKIPPED;
+	if (test_scheduler_mode_op(CDEV_SCHED_MODE_LEAST_LOADED) < 0)
+		return TEST_SKIPPED;
+	/* Cover the session affinity path, which also steers by load */
+	if (rte_cryptodev_scheduler_option_set(ts_params->valid_devs[0],
+			CDEV_SCHED_OPTION_SESSION_AFFINITY, &option) < 0)
+		return TEST_SKIPPED;
+	return 0;
+}
+
 static void
 scheduler_mode_testsuite_teardown(void)
 {
@@ -19048,6 +19256,8 @@ static struct unit_test_suite cryptodev_aes_gcm_auth_testsuite  = {
 			test_AES_GCM_authenticated_encryption_test_case_7),
 		TEST_CASE_ST(ut_setup, ut_teardown,
 			test_AES_GCM_authenticated_encryption_test_case_8),
+		TEST_CASE_ST(ut_setup, ut_teardown,
+			test_AES_GCM_auth_encryption_burst),
 		TEST_CASE_ST(ut_setup, ut_teardown,
 			test_AES_GCM_J0_authenticated_encryption_test_case_1),
 
@@ -20108,11 +20318,18 @@ test_cryptodev_scheduler(void)
 		.teardown = scheduler_mode_testsuite_teardown,
 		.unit_test_cases = {TEST_CASES_END()}
 	};
+	static struct unit_test_suite scheduler_least_loaded = {
+		.suite_name = "Scheduler Least Loaded Unit Test Suite",
+		.setup = scheduler_least_loaded_testsuite_setup,
+		.teardown = scheduler_mode_testsuite_teardown,
+		.unit_test_cases = {TEST_CASES_END()}
+	};
 	struct unit_test_suite *sched_mode_suites[] = {
 		&scheduler_multicore,
 		&scheduler_round_robin,
 		&scheduler_failover,
-		&scheduler_pkt_size_distr
+		&scheduler_pkt_size_distr,
+		&scheduler_least_loaded
 	};
 	static struct unit_test_suite scheduler_config = {
 		.suite_name = "Crypto Device Scheduler Config Unit Test Suite",
@@ -20122,6 +20339,7 @@ test_cryptodev_scheduler(void)
 			TEST_CASE(test_scheduler_mode_roundrobin_op),
 			TEST_CASE(test_scheduler_mode_failover_op),
 			TEST_CASE(test_scheduler_mode_pkt_size_distr_op),
+			TEST_CASE(test_scheduler_mode_least_loaded_op),
 			TEST_CASE(test_scheduler_detach_worker_op),
 
 			TEST_CASES_END() /**< NULL terminate array */
@@ -162,12 +162,101 @@ ethdev_api_queue_status(void)
 	return TEST_SUCCESS;
 }
 
+static int32_t
+ethdev_api_queue_poll_stats(void)
+{
+	struct rte_eth_queue_poll_stats qs;
+	struct rte_mbuf *pkts[NUM_RXD];
+	struct rte_mempool *mbuf_pool;
+	struct rte_eth_conf eth_conf;
+	uint16_t port_id, nb_rx;
+	unsigned int i;
+	int ret;
+
+	if (rte_eth_dev_count_avail() == 0)
+		return TEST_SKIPPED;
+
+	mbuf_pool = rte_mempool_lookup("MBUF_POOL");
+	if (mbuf_pool == NULL)
+		mbuf_pool = rte_pktmbuf_pool_create("MBUF_POOL", NUM_MBUF,
+				MBUF_CACHE_SIZE, 0, RTE_MBUF_DEFAULT_BUF_SIZE,
+				rte_socket_id());
+	TEST_ASSERT_NOT_NULL(mbuf_pool, "Failed to create mbuf pool.\n");
+
+	RTE_ETH_FOREACH_DEV(port_id) {
+		memset(&eth_conf, 0, sizeof(eth_conf));
+		ret = rte_eth_dev_configure(port_id, NUM_RXQ, NUM_TXQ, &eth_conf);
+		TEST_ASSERT(ret == 0,
+			"Port(%u) failed to configure.\n", port_id);
+
+		for (uint16_t queue_id = 0; queue_id < NUM_RXQ; queue_id++) {
+			ret = rte_eth_rx_queue_setup(port_id, queue_id, NUM_RXD,
+				rte_socket_id(), NULL,  mbuf_pool);
+			TEST_ASSERT(ret == 0,
+				"Port(%u), queue(%u) failed to setup RxQ.\n",
+				port_id, queue_id);
+		}
+
+		ret = rte_eth_queue_poll_stats_enable(port_id);
+		if (ret == -ENOTSUP)
+			return TEST_SKIPPED;
+		TEST_ASSERT(ret == 0,
+			"Port(%u) failed to enable poll stats.\n", port_id);
+
+		ret = rte_eth_dev_start(port_id);
+		TEST_ASSERT(ret == 0,
+			"Port(%u) failed to start.\n", port_id);
+
+		TEST_ASSERT(rte_eth_queue_poll_stats_disable(port_id) == -EBUSY,
+			"Port(%u) poll stats disabled while started.\n", port_id);
+
+		nb_rx = 0;
+		for (i = 0; i < 8; i++) {
+			ret = rte_eth_rx_burst(port_id, 0, pkts, RTE_DIM(pkts));
+			rte_pktmbuf_free_bulk(pkts, ret);
+			nb_rx += ret;
+		}
+
+		ret = rte_eth_queue_poll_stats_get(port_id, 0, true, &qs);
+		TEST_ASSERT(ret == 0,
+			"Port(%u) failed to get Rx queue poll stats.\n", port_id);
+		TEST_ASSERT(qs.polls == 8 && qs.pkts == nb_rx,
+			"Port(%u) wrong poll stats: polls %"PRIu64" pkts %"PRIu64"\n",
+			port_id, qs.polls, qs.pkts);
+
+		ret = rte_eth_queue_poll_stats_get(port_id, NUM_RXQ, true, &qs);
+		TEST_ASSERT(ret == -EINVAL,
+			"Port(%u) got poll stats of invalid queue.\n", port_id);
+
+		ret = rte_eth_queue_poll_stats_reset(port_id);
+		TEST_ASSERT(ret == 0,
+			"Port(%u) failed to reset poll stats.\n", port_id);
+		ret = rte_eth_queue_poll_stats_get(port_id, 0, true, &qs);
+		TEST_ASSERT(ret == 0 && qs.polls == 0,
+			"Port(%u) poll stats not reset.\n", port_id);
+
+		ret = rte_eth_dev_stop(port_id);
+		TEST_ASSERT(ret == 0,
+			"Port(%u) failed to stop.\n", port_id);
+
+		ret = rte_eth_queue_poll_stats_disable(port_id);
+		TEST_ASSERT(ret == 0,
+			"Port(%u) failed to disable poll stats.\n", port_id);
+		ret = rte_eth_queue_poll_stats_get(port_id, 0, true, &qs);
+		TEST_ASSERT(ret == -ENOENT,
+			"Port(%u) poll stats still enabled.\n", port_id);
+	}
+
+	return TEST_SUCCESS;
+}
+
 static struct unit_test_suite ethdev_api_testsuite = {
 	.suite_name = "ethdev API tests",
 	.setup = NULL,
 	.teardown = NULL,
 	.unit_test_cases = {
 		TEST_CASE(ethdev_api_queue_status),
+		TEST_CASE(ethdev_api_queue_poll_stats),
 		/* TODO: Add deferred_start queue status test */
 		TEST_CASES_END() /**< NULL terminate unit test array */
 	}
@@ -24,6 +24,7 @@ test_node_list_dump(void)
 
 #else
 
+#include <rte_cycles.h>
 #include <rte_graph.h>
 #include <rte_graph_worker.h>
 #include <rte_mbuf.h>
@@ -1062,6 +1063,685 @@ test_print_stats(void)
 	return 0;
 }
 
+#define WS_TEST_NB_OBJS   (64 * 1024)
+#define WS_TEST_BURST     256U
+#define WS_TEST_TIMEOUT_S 10
+
+static RTE_ATOMIC(uint16_t) ws_delivered[2 * WS_TEST_NB_OBJS];
+static RTE_ATOMIC(uint32_t) ws_nb_delivered;
+static RTE_ATOMIC(uint32_t) ws_nb_stolen;
+static RTE_ATOMIC(uint32_t) ws_stop;
+static uint32_t ws_produced;
+static uint32_t ws_ordered_next;
+static uint32_t ws_ordered_errors;
+
+/* Only the producer clone receives the objects */
+static int
+ws_test_source_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	node->ctx[0] = strcmp(graph->name, "ws_test-producer") == 0;
+
+	return 0;
+}
+
+static uint16_t
+ws_test_source(struct rte_graph *graph, struct rte_node *node, void **objs,
+	       uint16_t nb_objs)
+{
+	void **unordered, **ordered;
+	uint32_t i;
+
+	RTE_SET_USED(objs);
+
+	if (!node->ctx[0] || ws_produced == WS_TEST_NB_OBJS)
+		return 0;
+
+	nb_objs = RTE_MIN(WS_TEST_BURST, WS_TEST_NB_OBJS - ws_produced);
+	unordered = rte_node_next_stream_get(graph, node, 0, nb_objs);
+	ordered = rte_node_next_stream_get(graph, node, 1, nb_objs);
+	for (i = 0; i < nb_objs; i++) {
+		unordered[i] = (void *)(uintptr_t)(ws_produced + i + 1);
+		ordered[i] = (void *)(uintptr_t)(WS_TEST_NB_OBJS + ws_produced + i + 1);
+	}
+	rte_node_next_stream_put(graph, node, 0, nb_objs);
+	rte_node_next_stream_put(graph, node, 1, nb_objs);
+	ws_produced += nb_objs;
+
+	return nb_objs;
+}
+
+static uint16_t
+ws_test_forward(struct rte_graph *graph, struct rte_node *node, void **objs,
+		uint16_t nb_objs)
+{
+	if (strcmp(graph->name, "ws_test-producer") != 0)
+		rte_atomic_fetch_add_explicit(&ws_nb_stolen, nb_objs,
+					      rte_memory_order_relaxed);
+	rte_node_enqueue(graph, node, 0, objs, nb_objs);
+
+	return nb_objs;
+}
+
+static void
+ws_test_deliver(void **objs, uint16_t nb_objs)
+{
+	uint16_t i;
+
+	for (i = 0; i < nb_objs; i++)
+		rte_atomic_fetch_add_explicit(&ws_delivered[(uintptr_t)objs[i] - 1], 1,
+					      rte_memory_order_relaxed);
+	rte_atomic_fetch_add_explicit(&ws_nb_delivered, nb_objs, rte_memory_order_release);
+}
+
+static uint16_t
+ws_test_sink(struct rte_graph *graph, struct rte_node *node, void **objs,
+	     uint16_t nb_objs)
+{
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+
+	ws_test_deliver(objs, nb_objs);
+
+	return nb_objs;
+}
+
+/* Only walked by the producer clone, as its streams are never shared */
+static uint16_t
+ws_test_ordered_sink(struct rte_graph *graph, struct rte_node *node, void **objs,
+		     uint16_t nb_objs)
+{
+	uint16_t i;
+
+	RTE_SET_USED(node);
+
+	for (i = 0; i < nb_objs; i++) {
+		if (strcmp(graph->name, "ws_test-producer") != 0 ||
+		    (uintptr_t)objs[i] != WS_TEST_NB_OBJS + ws_ordered_next + 1)
+			ws_ordered_errors++;
+		ws_ordered_next++;
+	}
+	ws_test_deliver(objs, nb_objs);
+
+	return nb_objs;
+}
+
+static struct rte_node_register ws_test_source_node = {
+	.name = "ws_test_source",
+	.process = ws_test_source,
+	.flags = RTE_NODE_SOURCE_F,
+	.init = ws_test_source_init,
+	.nb_edges = 2,
+	.next_nodes = {"ws_test_forward", "ws_test_ordered_forward"},
+};
+RTE_NODE_REGISTER(ws_test_source_node);
+
+static struct rte_node_register ws_test_forward_node = {
+	.name = "ws_test_forward",
+	.process = ws_test_forward,
+	.nb_edges = 1,
+	.next_nodes = {"ws_test_sink"},
+};
+RTE_NODE_REGISTER(ws_test_forward_node);
+
+static struct rte_node_register ws_test_sink_node = {
+	.name = "ws_test_sink",
+	.process = ws_test_sink,
+};
+RTE_NODE_REGISTER(ws_test_sink_node);
+
+static struct rte_node_register ws_test_ordered_forward_node = {
+	.name = "ws_test_ordered_forward",
+	.process = ws_test_forward,
+	.nb_edges = 1,
+	.next_nodes = {"ws_test_ordered_sink"},
+};
+RTE_NODE_REGISTER(ws_test_ordered_forward_node);
+
+static struct rte_node_register ws_test_ordered_sink_node = {
+	.name = "ws_test_ordered_sink",
+	.process = ws_test_ordered_sink,
+	.flags = RTE_NODE_ORDERED_F,
+};
+RTE_NODE_REGISTER(ws_test_ordered_sink_node);
+
+static int
+ws_test_thief(void *arg)
+{
+	struct rte_graph *graph = arg;
+
+	while (rte_atomic_load_explicit(&ws_stop, rte_memory_order_relaxed) == 0)
+		rte_graph_walk(graph);
+
+	return 0;
+}
+
+/* Every object is delivered once, and the objects of an ordered node keep
+ * their order, while a clone steals the streams of the producer clone.
+ */
+static int
+test_graph_model_work_stealing(void)
+{
+	static const char *patterns[] = {"ws_test_source", "ws_test_forward", "ws_test_sink",
+					 "ws_test_ordered_forward", "ws_test_ordered_sink"};
+	struct rte_graph_param gconf = {
+		.socket_id = SOCKET_ID_ANY,
+		.nb_node_patterns = RTE_DIM(patterns),
+		.node_patterns = patterns,
+	};
+	rte_graph_t parent, producer_id, thief_id;
+	struct rte_graph *producer, *thief;
+	uint8_t model = RTE_GRAPH_MODEL_DEFAULT;
+	unsigned int lcore;
+	uint64_t deadline;
+	uint32_t i, count;
+	int ret = -1;
+
+	lcore = rte_get_next_lcore(-1, 1, 0);
+	if (lcore >= RTE_MAX_LCORE) {
+		printf("Work-stealing test needs a worker lcore, skipping\n");
+		return TEST_SKIPPED;
+	}
+
+	parent = rte_graph_create("ws_test", &gconf);
+	if (parent == RTE_GRAPH_ID_INVALID) {
+		printf("Graph creation failed with error = %d\n", rte_errno);
+		return -1;
+	}
+	if (graph_id != RTE_GRAPH_ID_INVALID)
+		model = rte_graph_worker_model_get(rte_graph_lookup("worker0"));
+	rte_graph_worker_model_set(RTE_GRAPH_MODEL_WORK_STEALING);
+
+	producer_id = rte_graph_clone(parent, "producer", &gconf);
+	thief_id = rte_graph_clone(parent, "thief", &gconf);
+	if (producer_id == RTE_GRAPH_ID_INVALID || thief_id == RTE_GRAPH_ID_INVALID) {
+		printf("Graph clone failed with error = %d\n", rte_errno);
+		goto destroy;
+	}
+	producer = rte_graph_lookup("ws_test-producer");
+	thief = rte_graph_lookup("ws_test-thief");
+
+	if (rte_graph_destroy(parent) != -EBUSY) {
+		printf("Parent graph destroyed before its clones\n");
+		goto destroy;
+	}
+
+	rte_atomic_store_explicit(&ws_stop, 0, rte_memory_order_relaxed);
+	if (rte_eal_remote_launch(ws_test_thief, thief, lcore) != 0) {
+		printf("Cannot launch thief graph on lcore %u\n", lcore);
+		goto destroy;
+	}
+
+	deadline = rte_get_timer_cycles() + WS_TEST_TIMEOUT_S * rte_get_timer_hz();
+	while (rte_atomic_load_explicit(&ws_nb_delivered, rte_memory_order_acquire) <
+	       2 * WS_TEST_NB_OBJS && rte_get_timer_cycles() < deadline)
+		rte_graph_walk(producer);
+
+	/* The clones must not be walked when they are destroyed */
+	rte_atomic_store_explicit(&ws_stop, 1, rte_memory_order_relaxed);
+	rte_eal_wait_lcore(lcore);
+
+	count = rte_atomic_load_explicit(&ws_nb_delivered, rte_memory_order_acquire);
+	if (count != 2 * WS_TEST_NB_OBJS) {
+		printf("Delivered %u objects, expected %u\n", count, 2 * WS_TEST_NB_OBJS);
+		goto destroy;
+	}
+	for (i = 0; i < 2 * WS_TEST_NB_OBJS; i++) {
+		if (rte_atomic_load_explicit(&ws_delivered[i], rte_memory_order_relaxed) != 1) {
+			printf("Object %u delivered %u times\n", i,
+			       rte_atomic_load_explicit(&ws_delivered[i],
+							rte_memory_order_relaxed));
+			goto destroy;
+		}
+	}
+	if (ws_ordered_errors != 0) {
+		printf("%u objects of ordered node out of order\n", ws_ordered_errors);
+		goto destroy;
+	}
+	printf("Work-stealing: %u of %u objects stolen\n",
+	       rte_atomic_load_explicit(&ws_nb_stolen, rte_memory_order_relaxed),
+	       2 * WS_TEST_NB_OBJS);
+	ret = 0;
+
+destroy:
+	rte_graph_destroy(thief_id);
+	rte_graph_destroy(producer_id);
+	rte_graph_destroy(parent);
+	rte_graph_worker_model_set(model);
+
+	return ret;
+}
+
+#define PROF_TEST_NB_OBJS  32U
+#define PROF_TEST_NB_WALKS 16
+
+static void *prof_test_objs[PROF_TEST_NB_OBJS];
+
+static uint16_t
+prof_test_source(struct rte_graph *graph, struct rte_node *node, void **objs,
+		 uint16_t nb_objs)
+{
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	rte_node_enqueue(graph, node, 0, prof_test_objs, PROF_TEST_NB_OBJS);
+
+	return PROF_TEST_NB_OBJS;
+}
+
+static uint16_t
+prof_test_sink(struct rte_graph *graph, struct rte_node *node, void **objs,
+	       uint16_t nb_objs)
+{
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+	RTE_SET_USED(objs);
+
+	return nb_objs;
+}
+
+static struct rte_node_register prof_test_source_node = {
+	.name = "prof_test_source",
+	.process = prof_test_source,
+	.flags = RTE_NODE_SOURCE_F,
+	.nb_edges = 1,
+	.next_nodes = {"prof_test_sink"},
+};
+RTE_NODE_REGISTER(prof_test_source_node);
+
+static struct rte_node_register prof_test_sink_node = {
+	.name = "prof_test_sink",
+	.process = prof_test_sink,
+};
+RTE_NODE_REGISTER(prof_test_sink_node);
+
+struct prof_test_result {
+	unsigned int nb_nodes;
+	unsigned int nb_errors;
+};
+
+static int
+prof_test_stats_cb(bool is_first, bool is_last, void *cookie,
+		   const struct rte_graph_cluster_node_stats *st)
+{
+	struct prof_test_result *res = cookie;
+	uint64_t cycles_calls = 0, objs_calls = 0;
+	int i;
+
+	RTE_SET_USED(is_first);
+	RTE_SET_USED(is_last);
+
+	res->nb_nodes++;
+	if (st->prof == NULL) {
+		printf("No profile for node %s\n", st->name);
+		res->nb_errors++;
+		return 0;
+	}
+
+	for (i = 0; i < RTE_GRAPH_HIST_BUCKETS; i++) {
+		cycles_calls += st->prof->cycles_hist[i];
+		objs_calls += st->prof->objs_hist[i];
+	}
+
+	/* Each call is counted once per histogram, in the bucket of 32 objects */
+	if (st->calls != PROF_TEST_NB_WALKS || cycles_calls != st->calls ||
+	    objs_calls != st->calls ||
+	    st->prof->objs_hist[rte_log2_u32(PROF_TEST_NB_OBJS) + 1] != st->calls) {
+		printf("Node %s: %" PRIu64 " calls, %" PRIu64 " in cycles histogram, %"
+		       PRIu64 " in objs histogram\n", st->name, st->calls, cycles_calls,
+		       objs_calls);
+		res->nb_errors++;
+	}
+
+	return 0;
+}
+
+static int
+test_graph_profile(void)
+{
+	static const char *patterns[] = {"prof_test_source", "prof_test_sink"};
+	const char *graph_pattern = "prof_test";
+	struct rte_graph_param gconf = {
+		.socket_id = SOCKET_ID_ANY,
+		.nb_node_patterns = RTE_DIM(patterns),
+		.node_patterns = patterns,
+		.prof_enable = true,
+	};
+	struct rte_graph_cluster_stats_param s_param = {
+		.socket_id = SOCKET_ID_ANY,
+		.fn = prof_test_stats_cb,
+		.nb_graph_patterns = 1,
+		.graph_patterns = &graph_pattern,
+	};
+	struct rte_graph_cluster_stats *stats;
+	struct prof_test_result res = {0};
+	struct rte_graph *graph;
+	rte_graph_t id;
+	int i, ret = -1;
+
+	if (!rte_graph_has_stats_feature())
+		return TEST_SKIPPED;
+
+	id = rte_graph_create("prof_test", &gconf);
+	if (id == RTE_GRAPH_ID_INVALID) {
+		printf("Failed to create graph with profiling, error = %d\n", rte_errno);
+		return -1;
+	}
+	graph = rte_graph_lookup("prof_test");
+
+	for (i = 0; i < PROF_TEST_NB_WALKS; i++)
+		rte_graph_walk(graph);
+
+	s_param.cookie = &res;
+	stats = rte_graph_cluster_stats_create(&s_param);
+	if (stats == NULL) {
+		printf("Unable to create stats\n");
+		goto destroy;
+	}
+	rte_graph_cluster_stats_get(stats, 0);
+	rte_graph_cluster_stats_destroy(stats);
+
+	if (res.nb_nodes != RTE_DIM(patterns) || res.nb_errors != 0) {
+		printf("Profile of %u nodes checked, %u errors\n", res.nb_nodes,
+		       res.nb_errors);
+		goto destroy;
+	}
+	ret = 0;
+
+destroy:
+	rte_graph_destroy(id);
+
+	return ret;
+}
+
+/* The PMU counters of the graphs of a cluster are summed by event slot */
+static int
+test_graph_profile_pmu_mismatch(void)
+{
+#ifdef RTE_LIB_PMU
+	static const char *patterns[] = {"prof_test_source", "prof_test_sink"};
+	static const char *events_a[] = {"cpu-cycles"};
+	static const char *events_b[] = {"instructions"};
+	const char *graph_pattern = "prof_pmu_*";
+	struct rte_graph_param gconf = {
+		.socket_id = SOCKET_ID_ANY,
+		.nb_node_patterns = RTE_DIM(patterns),
+		.node_patterns = patterns,
+		.prof_enable = true,
+		.nb_pmu_events = 1,
+	};
+	struct rte_graph_cluster_stats_param s_param = {
+		.socket_id = SOCKET_ID_ANY,
+		.fn = prof_test_stats_cb,
+		.nb_graph_patterns = 1,
+		.graph_patterns = &graph_pattern,
+	};
+	struct rte_graph_cluster_stats *stats;
+	rte_graph_t id_a, id_b;
+	int ret = TEST_SKIPPED;
+
+	gconf.pmu_events = events_a;
+	id_a = rte_graph_create("prof_pmu_a", &gconf);
+	gconf.pmu_events = events_b;
+	id_b = rte_graph_create("prof_pmu_b", &gconf);
+	if (id_a == RTE_GRAPH_ID_INVALID || id_b == RTE_GRAPH_ID_INVALID) {
+		printf("PMU events not available, skipping test\n");
+		goto destroy;
+	}
+
+	stats = rte_graph_cluster_stats_create(&s_param);
+	if (stats != NULL) {
+		printf("Stats created for graphs counting different PMU events\n");
+		rte_graph_cluster_stats_destroy(stats);
+		ret = -1;
+		goto destroy;
+	}
+	ret = 0;
+
+destroy:
+	if (id_a != RTE_GRAPH_ID_INVALID)
+		rte_graph_destroy(id_a);
+	if (id_b != RTE_GRAPH_ID_INVALID)
+		rte_graph_destroy(id_b);
+
+	return ret;
+#else
+	printf("PMU library not available, skipping test\n");
+	return TEST_SKIPPED;
+#endif
+}
+
+#define COAL_TEST_MIN_OBJS 4
+
+static void *coal_test_objs[COAL_TEST_MIN_OBJS];
+static uint64_t coal_test_calls;
+static uint64_t coal_test_objs_processed;
+
+static uint16_t
+coal_test_source(struct rte_graph *graph, struct rte_node *node, void **objs,
+		 uint16_t nb_objs)
+{
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	/* A single object per walk, under-filling the coalescing sink */
+	rte_node_enqueue(graph, node, 0, coal_test_objs, 1);
+
+	return 1;
+}
+
+static uint16_t
+coal_test_sink(struct rte_graph *graph, struct rte_node *node, void **objs,
+	       uint16_t nb_objs)
+{
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+	RTE_SET_USED(objs);
+
+	coal_test_calls++;
+	coal_test_objs_processed += nb_objs;
+
+	return nb_objs;
+}
+
+static struct rte_node_register coal_test_source_node = {
+	.name = "coal_test_source",
+	.process = coal_test_source,
+	.flags = RTE_NODE_SOURCE_F,
+	.nb_edges = 1,
+	.next_nodes = {"coal_test_sink"},
+};
+RTE_NODE_REGISTER(coal_test_source_node);
+
+static struct rte_node_register coal_test_sink_node = {
+	.name = "coal_test_sink",
+	.process = coal_test_sink,
+};
+RTE_NODE_REGISTER(coal_test_sink_node);
+
+struct coal_test_expect {
+	uint64_t calls;
+	uint64_t objs;
+	uint64_t held_walks;
+	uint64_t flushes;
+	uint64_t timeouts;
+};
+
+static struct rte_graph *
+coal_test_graph_create(const struct rte_node_coalesce_param *prm, rte_graph_t *id)
+{
+	static const char *patterns[] = {"coal_test_source", "coal_test_sink"};
+	struct rte_graph_param gconf = {
+		.socket_id = SOCKET_ID_ANY,
+		.nb_node_patterns = RTE_DIM(patterns),
+		.node_patterns = patterns,
+	};
+
+	if (rte_node_coalesce_set(coal_test_sink_node.id, prm)) {
+		printf("Failed to set coalescing of %s\n", coal_test_sink_node.name);
+		return NULL;
+	}
+
+	coal_test_calls = 0;
+	coal_test_objs_processed = 0;
+	*id = rte_graph_create("coal_test", &gconf);
+	if (*id == RTE_GRAPH_ID_INVALID) {
+		printf("Failed to create graph with coalescing, error = %d\n", rte_errno);
+		return NULL;
+	}
+
+	return rte_graph_lookup("coal_test");
+}
+
+static int
+coal_test_graph_destroy(rte_graph_t id)
+{
+	const struct rte_node_coalesce_param prm = {0};
+
+	if (id != RTE_GRAPH_ID_INVALID)
+		rte_graph_destroy(id);
+
+	return rte_node_coalesce_set(coal_test_sink_node.id, &prm);
+}
+
+static int
+coal_test_check(struct rte_graph *graph, const struct coal_test_expect *exp)
+{
+	struct rte_node *node;
+
+	node = rte_graph_node_get_by_name("coal_test", "coal_test_sink");
+	if (node == NULL) {
+		printf("Node %s not found in graph %s\n", "coal_test_sink", graph->name);
+		return -1;
+	}
+
+	if (coal_test_calls != exp->calls || coal_test_objs_processed != exp->objs ||
+	    node->coalesce.total_held_walks != exp->held_walks ||
+	    node->coalesce.total_flushes != exp->flushes ||
+	    node->coalesce.total_timeouts != exp->timeouts) {
+		printf("Coalescing: %" PRIu64 "/%" PRIu64 " calls, %" PRIu64 "/%" PRIu64
+		       " objs, %" PRIu64 "/%" PRIu64 " held walks, %" PRIu64 "/%" PRIu64
+		       " flushes, %" PRIu64 "/%" PRIu64 " timeouts\n",
+		       coal_test_calls, exp->calls, coal_test_objs_processed, exp->objs,
+		       node->coalesce.total_held_walks, exp->held_walks,
+		       node->coalesce.total_flushes, exp->flushes,
+		       node->coalesce.total_timeouts, exp->timeouts);
+		return -1;
+	}
+
+	return 0;
+}
+
+/* A stream reaching min_objs while held is processed without timeout */
+static int
+test_graph_coalesce_min_objs(void)
+{
+	const struct rte_node_coalesce_param prm = {
+		.min_objs = COAL_TEST_MIN_OBJS,
+		.max_walks = 4 * COAL_TEST_MIN_OBJS,
+	};
+	/* Held for min_objs - 1 walks, then processed with min_objs objects */
+	const struct coal_test_expect exp = {
+		.calls = 2,
+		.objs = 2 * COAL_TEST_MIN_OBJS,
+		.held_walks = 2 * (COAL_TEST_MIN_OBJS - 1),
+		.flushes = 2,
+		.timeouts = 0,
+	};
+	struct rte_graph *graph;
+	rte_graph_t id = RTE_GRAPH_ID_INVALID;
+	int i, ret = -1;
+
+	graph = coal_test_graph_create(&prm, &id);
+	if (graph == NULL)
+		goto destroy;
+
+	for (i = 0; i < 2 * COAL_TEST_MIN_OBJS; i++)
+		rte_graph_walk(graph);
+
+	ret = coal_test_check(graph, &exp);
+
+destroy:
+	if (coal_test_graph_destroy(id))
+		ret = -1;
+
+	return ret;
+}
+
+/* An under-filled stream is processed once held for max_walks walks */
+static int
+test_graph_coalesce_max_walks(void)
+{
+	const uint16_t max_walks = 2;
+	const struct rte_node_coalesce_param prm = {
+		.min_objs = 4 * COAL_TEST_MIN_OBJS,
+		.max_walks = max_walks,
+	};
+	/* Held for max_walks walks, then processed with max_walks + 1 objects */
+	const struct coal_test_expect exp = {
+		.calls = 2,
+		.objs = 2 * (max_walks + 1),
+		.held_walks = 2 * max_walks,
+		.flushes = 2,
+		.timeouts = 2,
+	};
+	struct rte_graph *graph;
+	rte_graph_t id = RTE_GRAPH_ID_INVALID;
+	int i, ret = -1;
+
+	graph = coal_test_graph_create(&prm, &id);
+	if (graph == NULL)
+		goto destroy;
+
+	for (i = 0; i < 2 * (max_walks + 1); i++)
+		rte_graph_walk(graph);
+
+	ret = coal_test_check(graph, &exp);
+
+destroy:
+	if (coal_test_graph_destroy(id))
+		ret = -1;
+
+	return ret;
+}
+
+/* An under-filled stream is processed once held for max_ns nanoseconds */
+static int
+test_graph_coalesce_max_ns(void)
+{
+	const struct rte_node_coalesce_param prm = {
+		.min_objs = 4 * COAL_TEST_MIN_OBJS,
+		.max_ns = NS_PER_S / 20,
+	};
+	/* Held for 2 walks within max_ns, then processed after the delay */
+	const struct coal_test_expect exp = {
+		.calls = 1,
+		.objs = 3,
+		.held_walks = 2,
+		.flushes = 1,
+		.timeouts = 1,
+	};
+	struct rte_graph *graph;
+	rte_graph_t id = RTE_GRAPH_ID_INVALID;
+	int ret = -1;
+
+	graph = coal_test_graph_create(&prm, &id);
+	if (graph == NULL)
+		goto destroy;
+
+	rte_graph_walk(graph);
+	rte_graph_walk(graph);
+	rte_delay_us_block(2 * prm.max_ns / 1000);
+	rte_graph_walk(graph);
+
+	ret = coal_test_check(graph, &exp);
+
+destroy:
+	if (coal_test_graph_destroy(id))
+		ret = -1;
+
+	return ret;
+}
+
 static int
 graph_setup(void)
 {
@@ -1140,6 +1820,12 @@ static struct unit_test_suite graph_testsuite = {
 		TEST_CASE(test_graph_lookup_functions),
 		TEST_CASE(test_graph_walk),
 		TEST_CASE(test_print_stats),
+		TEST_CASE(test_graph_model_work_stealing),
+		TEST_CASE(test_graph_profile),
+		TEST_CASE(test_graph_profile_pmu_mismatch),
+		TEST_CASE(test_graph_coalesce_min_objs),
+		TEST_CASE(test_graph_coalesce_max_walks),
+		TEST_CASE(test_graph_coalesce_max_ns),
 		TEST_CASES_END(), /**< NULL terminate unit test array */
 	},
 };
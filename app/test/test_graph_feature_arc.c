@@ -19,7 +19,9 @@
 #include <rte_graph_worker.h>
 #include <rte_mbuf.h>
 #include <rte_mbuf_dyn.h>
+#include <rte_malloc.h>
 #include <rte_random.h>
+#include <rte_rcu_qsbr.h>
 #include <rte_graph_feature_arc.h>
 #include <rte_graph_feature_arc_worker.h>
 
@@ -117,6 +119,9 @@ static uint64_t fp_end_feature_counters;
 static uint64_t sp_enable_counters, sp_enable_cb_counters;
 static uint64_t sp_disable_counters, sp_disable_cb_counters;
 
+/* RCU of arc2 feature enable/disable, for its specialized feature chains */
+static struct rte_rcu_qsbr *arc2_qsbr;
+
 /* Function declarations */
 static uint16_t
 source1_fn(struct rte_graph *graph, struct rte_node *node,
@@ -1242,6 +1247,13 @@ test_graph_feature_arc_feature_enable(void)
 			return TEST_FAILED;
 		}
 	}
+	arc2_qsbr = rte_zmalloc(NULL, rte_rcu_qsbr_get_memsize(1), RTE_CACHE_LINE_SIZE);
+	if (arc2_qsbr == NULL || rte_rcu_qsbr_init(arc2_qsbr, 1)) {
+		printf("%s: RCU QSBR init failed\n", TEST_ARC2_NAME);
+		return TEST_FAILED;
+	}
+
+	/* Enabled with RCU, the indexes of arc2 use specialized chains */
 	arc = rte_graph_feature_arc_get(arcs[1]);
 	for (n_indexes = 0; n_indexes < arc->max_indexes; n_indexes++) {
 		n_features = n_indexes % RTE_DIM(arc2_feature_seq);
@@ -1256,12 +1268,19 @@ test_graph_feature_arc_feature_enable(void)
 		user_data = compute_unique_user_data(arc->start_node->name, feature_name,
 						     n_indexes);
 		if (rte_graph_feature_enable(arcs[1], n_indexes, feature_name,
-					 user_data, NULL) < 0) {
+					 user_data, arc2_qsbr) < 0) {
 			printf("%s: Feature enable failed for %s on index %u\n",
 			       TEST_ARC2_NAME, feature_name, n_indexes);
 			return TEST_FAILED;
 		}
 		sp_enable_counters++;
+
+		if (!rte_graph_feature_data_first_feature_get(arc, n_indexes, &fdata, &edge2) ||
+		    rte_graph_feature_data_app_cookie_get(arc, fdata) != user_data) {
+			printf("%s: Specialized chain mismatch for %s on index %u\n",
+			       TEST_ARC2_NAME, feature_name, n_indexes);
+			return TEST_FAILED;
+		}
 	}
 
 	return test_perf((2 * MBUF_NUM));
@@ -1290,7 +1309,7 @@ test_graph_feature_arc_feature_disable(void)
 	for (n_indexes = 0; n_indexes < arc->max_indexes; n_indexes++) {
 		n_features = n_indexes % RTE_DIM(arc2_feature_seq);
 		feature_name = rte_graph_feature_arc_feature_to_name(arcs[1], n_features);
-		if (rte_graph_feature_disable(arcs[1], n_indexes, feature_name, NULL)) {
+		if (rte_graph_feature_disable(arcs[1], n_indexes, feature_name, arc2_qsbr)) {
 			printf("%s: feature disable failed for %s on index %u\n",
 			       arc->feature_arc_name, feature_name, n_indexes);
 			return TEST_FAILED;
@@ -1346,6 +1365,7 @@ graph_feature_arc_teardown(void)
 		rte_graph_destroy(graph_id);
 
 	rte_graph_feature_arc_cleanup();
+	rte_free(arc2_qsbr);
 }
 
 static struct unit_test_suite graph_feature_arc_testsuite = {
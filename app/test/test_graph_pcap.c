@@ -0,0 +1,375 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#include "test.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#ifdef RTE_EXEC_ENV_WINDOWS
+static int
+test_graph_pcap(void)
+{
+	printf("graph pcap not supported on Windows, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+#else
+
+#ifdef RTE_LIB_BPF
+#include <rte_bpf.h>
+#endif
+#include <rte_bus_vdev.h>
+#include <rte_ethdev.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_mbuf.h>
+
+#define PCAP_TEST_NB_PKTS   32U
+#define PCAP_TEST_SHORT_LEN 64
+#define PCAP_TEST_LONG_LEN  128
+#define PCAP_TEST_NB_WALKS  2
+
+static const char null_dev[] = "net_null0";
+static char pcap_test_dir[] = "/tmp/graph_pcap_test_XXXXXX";
+static char pcap_test_file[RTE_GRAPH_PCAP_FILE_SZ];
+static struct rte_mbuf *pcap_test_pkts[PCAP_TEST_NB_PKTS];
+static struct rte_mempool *mp;
+
+static uint16_t
+pcap_test_source(struct rte_graph *graph, struct rte_node *node, void **objs,
+		 uint16_t nb_objs)
+{
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	rte_node_enqueue(graph, node, 0, (void **)pcap_test_pkts, PCAP_TEST_NB_PKTS);
+
+	return PCAP_TEST_NB_PKTS;
+}
+
+static uint16_t
+pcap_test_sink(struct rte_graph *graph, struct rte_node *node, void **objs,
+	       uint16_t nb_objs)
+{
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+	RTE_SET_USED(objs);
+
+	/* The packets are reused by the next walks */
+	return nb_objs;
+}
+
+static struct rte_node_register pcap_test_source_node = {
+	.name = "pcap_test_source",
+	.process = pcap_test_source,
+	.flags = RTE_NODE_SOURCE_F,
+	.nb_edges = 1,
+	.next_nodes = {"pcap_test_sink"},
+};
+RTE_NODE_REGISTER(pcap_test_source_node);
+
+static struct rte_node_register pcap_test_sink_node = {
+	.name = "pcap_test_sink",
+	.process = pcap_test_sink,
+};
+RTE_NODE_REGISTER(pcap_test_sink_node);
+
+static struct rte_graph *
+pcap_test_graph_create(uint32_t ring_size, rte_graph_t *id)
+{
+	static const char *patterns[] = {"pcap_test_source", "pcap_test_sink"};
+	struct rte_graph_param gconf = {
+		.socket_id = SOCKET_ID_ANY,
+		.nb_node_patterns = RTE_DIM(patterns),
+		.node_patterns = patterns,
+		.pcap_enable = true,
+		.num_pkt_to_capture = PCAP_TEST_NB_WALKS * PCAP_TEST_NB_PKTS,
+		.pcap_filename = pcap_test_file,
+		.pcap_ring_size = ring_size,
+	};
+
+	*id = rte_graph_create("pcap_test", &gconf);
+	if (*id == RTE_GRAPH_ID_INVALID) {
+		printf("Failed to create graph with pcap, error = %d\n", rte_errno);
+		return NULL;
+	}
+
+	return rte_graph_lookup("pcap_test");
+}
+
+static int
+pcap_test_graph_destroy(rte_graph_t id)
+{
+	const struct rte_node_pcap_param prm = {0};
+
+	if (id != RTE_GRAPH_ID_INVALID)
+		rte_graph_destroy(id);
+
+	return rte_node_pcap_set(pcap_test_sink_node.id, &prm);
+}
+
+/* Number of packets captured by the sink in PCAP_TEST_NB_WALKS walks */
+static int
+pcap_test_captured(const struct rte_node_pcap_param *prm, uint64_t expected)
+{
+	struct rte_graph *graph;
+	rte_graph_t id = RTE_GRAPH_ID_INVALID;
+	int i, rc, ret = -1;
+
+	rc = rte_node_pcap_set(pcap_test_sink_node.id, prm);
+	if (rc) {
+		printf("Failed to set capture of %s, error = %d\n", pcap_test_sink_node.name,
+		       rc);
+		goto destroy;
+	}
+
+	graph = pcap_test_graph_create(0, &id);
+	if (graph == NULL)
+		goto destroy;
+
+	for (i = 0; i < PCAP_TEST_NB_WALKS; i++)
+		rte_graph_walk(graph);
+
+	if (graph->nb_pkt_captured != expected) {
+		printf("Captured %" PRIu64 " packets, expected %" PRIu64 "\n",
+		       graph->nb_pkt_captured, expected);
+		goto destroy;
+	}
+	ret = 0;
+
+destroy:
+	if (pcap_test_graph_destroy(id))
+		ret = -1;
+
+	return ret;
+}
+
+static int
+test_graph_pcap_sample(void)
+{
+	const struct rte_node_pcap_param prm = {
+		.sample_rate = 4,
+	};
+
+	return pcap_test_captured(&prm, PCAP_TEST_NB_WALKS * PCAP_TEST_NB_PKTS / 4);
+}
+
+static int
+test_graph_pcap_filter(void)
+{
+#ifdef RTE_LIB_BPF
+	/* Select the packets longer than PCAP_TEST_SHORT_LEN */
+	static const struct ebpf_insn ins[] = {
+		{
+			.code = (BPF_LDX | BPF_MEM | BPF_W),
+			.dst_reg = EBPF_REG_0,
+			.src_reg = EBPF_REG_1,
+			.off = offsetof(struct rte_mbuf, pkt_len),
+		},
+		{
+			.code = (BPF_JMP | BPF_JGT | BPF_K),
+			.dst_reg = EBPF_REG_0,
+			.off = 2,
+			.imm = PCAP_TEST_SHORT_LEN,
+		},
+		{
+			.code = (BPF_ALU | EBPF_MOV | BPF_K),
+			.dst_reg = EBPF_REG_0,
+			.imm = 0,
+		},
+		{
+			.code = (BPF_JMP | EBPF_EXIT),
+		},
+		{
+			.code = (BPF_ALU | EBPF_MOV | BPF_K),
+			.dst_reg = EBPF_REG_0,
+			.imm = 1,
+		},
+		{
+			.code = (BPF_JMP | EBPF_EXIT),
+		},
+	};
+	const struct rte_bpf_prm bpf = {
+		.ins = ins,
+		.nb_ins = RTE_DIM(ins),
+		.prog_arg = {
+			.type = RTE_BPF_ARG_PTR_MBUF,
+			.size = sizeof(struct rte_mbuf),
+			.buf_size = RTE_MBUF_DEFAULT_BUF_SIZE,
+		},
+	};
+	struct rte_node_pcap_param prm = {
+		.filter = &bpf,
+	};
+
+	/* mbuf as input argument is not supported on 32 bit platform */
+	if (sizeof(uint64_t) != sizeof(uintptr_t))
+		return TEST_SKIPPED;
+
+	/* Half of the packets are long */
+	if (pcap_test_captured(&prm, PCAP_TEST_NB_WALKS * PCAP_TEST_NB_PKTS / 2))
+		return -1;
+
+	/* One long packet out of 2 */
+	prm.sample_rate = 2;
+	return pcap_test_captured(&prm, PCAP_TEST_NB_WALKS * PCAP_TEST_NB_PKTS / 4);
+#else
+	printf("BPF library not available, skipping test\n");
+	return TEST_SKIPPED;
+#endif
+}
+
+static int
+test_graph_pcap_write(void)
+{
+	const uint64_t expected = PCAP_TEST_NB_WALKS * PCAP_TEST_NB_PKTS;
+	struct rte_graph *graph;
+	rte_graph_t id = RTE_GRAPH_ID_INVALID;
+	int i, rc, ret = -1;
+
+	rc = rte_graph_pcap_write(RTE_GRAPH_BURST_SIZE);
+	if (rc != -ENOENT) {
+		printf("Write without capturing graph returned %d\n", rc);
+		return -1;
+	}
+
+	graph = pcap_test_graph_create(2 * expected, &id);
+	if (graph == NULL)
+		goto destroy;
+
+	for (i = 0; i < PCAP_TEST_NB_WALKS; i++)
+		rte_graph_walk(graph);
+
+	rc = rte_graph_pcap_write(RTE_GRAPH_BURST_SIZE);
+	if (graph->nb_pkt_captured != expected || rc != (int)expected) {
+		printf("Captured %" PRIu64 " packets, wrote %d, expected %" PRIu64 "\n",
+		       graph->nb_pkt_captured, rc, expected);
+		goto destroy;
+	}
+
+	/* Nothing left to write */
+	rc = rte_graph_pcap_write(RTE_GRAPH_BURST_SIZE);
+	if (rc != 0) {
+		printf("Second write returned %d\n", rc);
+		goto destroy;
+	}
+	ret = 0;
+
+destroy:
+	if (pcap_test_graph_destroy(id))
+		ret = -1;
+
+	/* The writer is stopped with the last capturing graph */
+	rc = rte_graph_pcap_write(RTE_GRAPH_BURST_SIZE);
+	if (rc != -ENOENT) {
+		printf("Write after graph destroy returned %d\n", rc);
+		ret = -1;
+	}
+
+	return ret;
+}
+
+static void
+pcap_test_dir_remove(void)
+{
+	struct dirent *dent;
+	DIR *dir;
+
+	dir = opendir(pcap_test_dir);
+	if (dir == NULL)
+		return;
+
+	while ((dent = readdir(dir)) != NULL) {
+		if (dent->d_name[0] != '.')
+			unlinkat(dirfd(dir), dent->d_name, 0);
+	}
+	closedir(dir);
+	rmdir(pcap_test_dir);
+}
+
+static int
+graph_pcap_setup(void)
+{
+	unsigned int i;
+	uint16_t port_id;
+
+	port_id = rte_eth_dev_count_avail();
+
+	/* Make a dummy null device, the captured packets are received on it */
+	if (rte_vdev_init(null_dev, NULL) != 0) {
+		printf("Failed to create vdev '%s'\n", null_dev);
+		return TEST_SKIPPED;
+	}
+
+	mp = rte_pktmbuf_pool_create("graph_pcap_test_pool", PCAP_TEST_NB_PKTS, 0, 0,
+				     RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	if (mp == NULL) {
+		printf("Cannot create mempool\n");
+		goto fail;
+	}
+
+	if (rte_pktmbuf_alloc_bulk(mp, pcap_test_pkts, PCAP_TEST_NB_PKTS)) {
+		printf("Cannot allocate packets\n");
+		goto fail;
+	}
+
+	for (i = 0; i < PCAP_TEST_NB_PKTS; i++) {
+		pcap_test_pkts[i]->port = port_id;
+		if (rte_pktmbuf_append(pcap_test_pkts[i], i % 2 ? PCAP_TEST_LONG_LEN :
+				       PCAP_TEST_SHORT_LEN) == NULL) {
+			printf("Cannot build packet\n");
+			goto fail;
+		}
+	}
+
+	if (mkdtemp(pcap_test_dir) == NULL) {
+		printf("Cannot create capture directory\n");
+		goto fail;
+	}
+	snprintf(pcap_test_file, sizeof(pcap_test_file), "%s/capture", pcap_test_dir);
+
+	return 0;
+
+fail:
+	rte_mempool_free(mp);
+	mp = NULL;
+	rte_vdev_uninit(null_dev);
+	return -1;
+}
+
+static void
+graph_pcap_teardown(void)
+{
+	pcap_test_dir_remove();
+	rte_pktmbuf_free_bulk(pcap_test_pkts, PCAP_TEST_NB_PKTS);
+	rte_mempool_free(mp);
+	mp = NULL;
+	rte_vdev_uninit(null_dev);
+}
+
+static struct unit_test_suite graph_pcap_testsuite = {
+	.suite_name = "Graph pcap library test suite",
+	.setup = graph_pcap_setup,
+	.teardown = graph_pcap_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_graph_pcap_sample),
+		TEST_CASE(test_graph_pcap_filter),
+		TEST_CASE(test_graph_pcap_write),
+		TEST_CASES_END(), /**< NULL terminate unit test array */
+	},
+};
+
+static int
+test_graph_pcap(void)
+{
+	return unit_test_suite_runner(&graph_pcap_testsuite);
+}
+
+#endif /* !RTE_EXEC_ENV_WINDOWS */
+
+REGISTER_FAST_TEST(graph_pcap_autotest, true, true, test_graph_pcap);
@@ -27,11 +27,14 @@ test_graph_perf_func(void)
 #include <rte_lcore.h>
 #include <rte_malloc.h>
 #include <rte_mbuf.h>
+#include <rte_pause.h>
 
 #define TEST_GRAPH_PERF_MZ	     "graph_perf_data"
 #define TEST_GRAPH_SRC_NAME	     "test_graph_perf_source"
 #define TEST_GRAPH_SRC_BRST_ONE_NAME "test_graph_perf_source_one"
+#define TEST_GRAPH_SRC_SKEW_NAME     "test_graph_perf_source_skew"
 #define TEST_GRAPH_WRK_NAME	     "test_graph_perf_worker"
+#define TEST_GRAPH_WRK_HEAVY_NAME    "test_graph_perf_worker_heavy"
 #define TEST_GRAPH_SNK_NAME	     "test_graph_perf_sink"
 
 #define SOURCES(map)	     RTE_DIM(map)
@@ -41,6 +44,9 @@ test_graph_perf_func(void)
 
 #define MAX_EDGES_PER_NODE 7
 
+#define SKEW_MAX_GRAPHS	 4
+#define HEAVY_OBJ_CYCLES 32
+
 struct test_node_data {
 	uint8_t node_id;
 	uint8_t is_sink;
@@ -59,6 +65,11 @@ struct graph_lcore_data {
 	rte_graph_t graph_id;
 };
 
+/* Graph receiving all the objects of the skewed source */
+static rte_graph_t graph_skew_id = RTE_GRAPH_ID_INVALID;
+/* Number of objects created by the skewed source */
+static uint64_t graph_skew_objs;
+
 static struct test_node_data *
 graph_get_node_data(struct test_graph_perf *graph_data, rte_node_t id)
 {
@@ -160,6 +171,29 @@ static struct rte_node_register test_graph_perf_source_burst_one = {
 
 RTE_NODE_REGISTER(test_graph_perf_source_burst_one);
 
+/* Source node function creating objects on a single graph */
+static uint16_t
+test_perf_node_worker_source_skew(struct rte_graph *graph,
+				  struct rte_node *node, void **objs,
+				  uint16_t nb_objs)
+{
+	if (graph->id != graph_skew_id)
+		return 0;
+
+	graph_skew_objs += RTE_GRAPH_BURST_SIZE;
+
+	return test_perf_node_worker_source(graph, node, objs, nb_objs);
+}
+
+static struct rte_node_register test_graph_perf_source_skew = {
+	.name = TEST_GRAPH_SRC_SKEW_NAME,
+	.process = test_perf_node_worker_source_skew,
+	.flags = RTE_NODE_SOURCE_F,
+	.init = test_node_ctx_init,
+};
+
+RTE_NODE_REGISTER(test_graph_perf_source_skew);
+
 /* Worker node function */
 static uint16_t
 test_perf_node_worker(struct rte_graph *graph, struct rte_node *node,
@@ -225,6 +259,27 @@ static struct rte_node_register test_graph_perf_worker = {
 
 RTE_NODE_REGISTER(test_graph_perf_worker);
 
+/* Worker node function spending cycles on every object */
+static uint16_t
+test_perf_node_worker_heavy(struct rte_graph *graph, struct rte_node *node,
+			    void **objs, uint16_t nb_objs)
+{
+	uint64_t end = rte_rdtsc() + (uint64_t)nb_objs * HEAVY_OBJ_CYCLES;
+
+	while (rte_rdtsc() < end)
+		rte_pause();
+
+	return test_perf_node_worker(graph, node, objs, nb_objs);
+}
+
+static struct rte_node_register test_graph_perf_worker_heavy = {
+	.name = TEST_GRAPH_WRK_HEAVY_NAME,
+	.process = test_perf_node_worker_heavy,
+	.init = test_node_ctx_init,
+};
+
+RTE_NODE_REGISTER(test_graph_perf_worker_heavy);
+
 /* Last node in graph a.k.a sink node */
 static uint16_t
 test_perf_node_sink(struct rte_graph *graph, struct rte_node *node, void **objs,
@@ -318,7 +373,7 @@ graph_init(const char *gname, uint8_t nb_srcs, uint8_t nb_sinks,
 	   uint32_t stages, uint16_t nodes_per_stage,
 	   uint8_t src_map[][nodes_per_stage], uint8_t snk_map[][nb_sinks],
 	   uint8_t edge_map[][nodes_per_stage][nodes_per_stage],
-	   uint8_t burst_one)
+	   const char *src_name, const char *wrk_name)
 {
 	struct test_graph_perf *graph_data;
 	char nname[RTE_NODE_NAMESIZE / 2];
@@ -398,8 +453,7 @@ graph_init(const char *gname, uint8_t nb_srcs, uint8_t nb_sinks,
 
 			/* Clone a worker node */
 			snprintf(nname, sizeof(nname), "%d-%d", i, j);
-			node_map[i][j] =
-				graph_node_get(TEST_GRAPH_WRK_NAME, nname);
+			node_map[i][j] = graph_node_get(wrk_name, nname);
 			if (node_map[i][j] == RTE_NODE_ID_INVALID) {
 				printf("Failed to create node[%s]\n", nname);
 				graph_data->nb_nodes++;
@@ -458,10 +512,7 @@ graph_init(const char *gname, uint8_t nb_srcs, uint8_t nb_sinks,
 		}
 		/* Clone a source node */
 		snprintf(nname, sizeof(nname), "%d", i);
-		src_nodes[i] =
-			graph_node_get(burst_one ? TEST_GRAPH_SRC_BRST_ONE_NAME
-						 : TEST_GRAPH_SRC_NAME,
-				       nname);
+		src_nodes[i] = graph_node_get(src_name, nname);
 		if (src_nodes[i] == RTE_NODE_ID_INVALID) {
 			printf("Failed to create node[%s]\n", nname);
 			graph_data->nb_nodes++;
@@ -699,6 +750,83 @@ measure_perf(void)
 	return measure_perf_get(graph_data->graph_id);
 }
 
+/* Walk a clone of the graph on each worker lcore, with a single busy graph */
+static int
+measure_perf_skew(uint8_t model, const char *model_name)
+{
+	struct graph_lcore_data *data[SKEW_MAX_GRAPHS];
+	unsigned int lcores[SKEW_MAX_GRAPHS];
+	struct rte_graph_param prm = {0};
+	struct test_graph_perf *graph_data;
+	const struct rte_memzone *mz;
+	char name[RTE_GRAPH_NAMESIZE];
+	unsigned int nb_graphs = 0;
+	uint64_t start, cycles;
+	unsigned int lcore_id;
+	unsigned int i;
+	int ret = 0;
+
+	mz = rte_memzone_lookup(TEST_GRAPH_PERF_MZ);
+	if (mz == NULL)
+		return -ENOMEM;
+	graph_data = mz->addr;
+
+	ret = rte_graph_worker_model_set(model);
+	if (ret != 0) {
+		printf("Failed to set graph model %s\n", model_name);
+		return ret;
+	}
+
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (nb_graphs == SKEW_MAX_GRAPHS)
+			break;
+
+		data[nb_graphs] = rte_zmalloc("Graph_perf", sizeof(struct graph_lcore_data),
+					      RTE_CACHE_LINE_SIZE);
+		if (data[nb_graphs] == NULL) {
+			ret = -ENOMEM;
+			goto destroy;
+		}
+
+		snprintf(name, sizeof(name), "%u", lcore_id);
+		data[nb_graphs]->graph_id = rte_graph_clone(graph_data->graph_id, name, &prm);
+		if (data[nb_graphs]->graph_id == RTE_GRAPH_ID_INVALID) {
+			printf("Graph clone failed with error = %d\n", rte_errno);
+			rte_free(data[nb_graphs]);
+			ret = -rte_errno;
+			goto destroy;
+		}
+		lcores[nb_graphs++] = lcore_id;
+	}
+
+	graph_skew_id = data[0]->graph_id;
+	graph_skew_objs = 0;
+
+	start = rte_rdtsc();
+	for (i = 0; i < nb_graphs; i++)
+		rte_eal_remote_launch(_graph_perf_wrapper, data[i], lcores[i]);
+
+	rte_delay_ms(1E3);
+
+	for (i = 0; i < nb_graphs; i++)
+		data[i]->done = 1;
+	for (i = 0; i < nb_graphs; i++)
+		rte_eal_wait_lcore(lcores[i]);
+	cycles = rte_rdtsc() - start;
+
+	printf("%-16s %u graphs, 1 busy: %10.3f Mobjs/sec\n", model_name, nb_graphs,
+	       (double)graph_skew_objs * rte_get_tsc_hz() / cycles / 1E6);
+
+destroy:
+	graph_skew_id = RTE_GRAPH_ID_INVALID;
+	while (nb_graphs-- > 0) {
+		rte_graph_destroy(data[nb_graphs]->graph_id);
+		rte_free(data[nb_graphs]);
+	}
+
+	return ret;
+}
+
 static inline int
 graph_hr_4s_1n_1src_1snk(void)
 {
@@ -741,6 +869,25 @@ graph_parallel_tree_5s_4n_4src_4snk(void)
 	return measure_perf();
 }
 
+static inline int
+graph_skew_4s_1n_1src_1snk(void)
+{
+	int ret;
+
+	if (rte_lcore_count() < 3) {
+		printf("Skewed input test requires at least 3 lcores\n");
+		return TEST_SKIPPED;
+	}
+
+	ret = measure_perf_skew(RTE_GRAPH_MODEL_RTC, "rtc");
+	if (ret == 0)
+		ret = measure_perf_skew(RTE_GRAPH_MODEL_WORK_STEALING, "work-stealing");
+
+	rte_graph_worker_model_set(RTE_GRAPH_MODEL_DEFAULT);
+
+	return ret;
+}
+
 /* Graph Topology
  * nodes per stage:	1
  * stages:		4
@@ -761,7 +908,8 @@ graph_init_hr(void)
 
 	return graph_init("graph_hr", SOURCES(src_map), SINKS(snk_map),
 			  STAGES(edge_map), NODES_PER_STAGE(edge_map), src_map,
-			  snk_map, edge_map, 0);
+			  snk_map, edge_map, TEST_GRAPH_SRC_NAME,
+			  TEST_GRAPH_WRK_NAME);
 }
 
 /* Graph Topology
@@ -784,7 +932,8 @@ graph_init_hr_brst_one(void)
 
 	return graph_init("graph_hr", SOURCES(src_map), SINKS(snk_map),
 			  STAGES(edge_map), NODES_PER_STAGE(edge_map), src_map,
-			  snk_map, edge_map, 1);
+			  snk_map, edge_map, TEST_GRAPH_SRC_BRST_ONE_NAME,
+			  TEST_GRAPH_WRK_NAME);
 }
 
 /* Graph Topology
@@ -809,7 +958,8 @@ graph_init_hr_multi_src(void)
 
 	return graph_init("graph_hr", SOURCES(src_map), SINKS(snk_map),
 			  STAGES(edge_map), NODES_PER_STAGE(edge_map), src_map,
-			  snk_map, edge_map, 0);
+			  snk_map, edge_map, TEST_GRAPH_SRC_NAME,
+			  TEST_GRAPH_WRK_NAME);
 }
 
 /* Graph Topology
@@ -832,7 +982,8 @@ graph_init_hr_multi_snk(void)
 
 	return graph_init("graph_hr", SOURCES(src_map), SINKS(snk_map),
 			  STAGES(edge_map), NODES_PER_STAGE(edge_map), src_map,
-			  snk_map, edge_map, 0);
+			  snk_map, edge_map, TEST_GRAPH_SRC_NAME,
+			  TEST_GRAPH_WRK_NAME);
 }
 
 /* Graph Topology
@@ -880,7 +1031,8 @@ graph_init_tree(void)
 
 	return graph_init("graph_full_split", SOURCES(src_map), SINKS(snk_map),
 			  STAGES(edge_map), NODES_PER_STAGE(edge_map), src_map,
-			  snk_map, edge_map, 0);
+			  snk_map, edge_map, TEST_GRAPH_SRC_NAME,
+			  TEST_GRAPH_WRK_NAME);
 }
 
 /* Graph Topology
@@ -917,7 +1069,8 @@ graph_init_reverse_tree(void)
 
 	return graph_init("graph_full_split", SOURCES(src_map), SINKS(snk_map),
 			  STAGES(edge_map), NODES_PER_STAGE(edge_map), src_map,
-			  snk_map, edge_map, 0);
+			  snk_map, edge_map, TEST_GRAPH_SRC_NAME,
+			  TEST_GRAPH_WRK_NAME);
 }
 
 /* Graph Topology
@@ -976,7 +1129,32 @@ graph_init_parallel_tree(void)
 
 	return graph_init("graph_parallel", SOURCES(src_map), SINKS(snk_map),
 			  STAGES(edge_map), NODES_PER_STAGE(edge_map), src_map,
-			  snk_map, edge_map, 0);
+			  snk_map, edge_map, TEST_GRAPH_SRC_NAME,
+			  TEST_GRAPH_WRK_NAME);
+}
+
+/* Graph Topology
+ * nodes per stage:	1, spending cycles on every object
+ * stages:		4
+ * src:			1, creating objects on one clone of the graph only
+ * sink:		1
+ */
+static inline int
+graph_init_skew(void)
+{
+	uint8_t edge_map[][1][1] = {
+		{ {100} },
+		{ {100} },
+		{ {100} },
+		{ {100} },
+	};
+	uint8_t src_map[][1] = { {100} };
+	uint8_t snk_map[][1] = { {100} };
+
+	return graph_init("graph_skew", SOURCES(src_map), SINKS(snk_map),
+			  STAGES(edge_map), NODES_PER_STAGE(edge_map), src_map,
+			  snk_map, edge_map, TEST_GRAPH_SRC_SKEW_NAME,
+			  TEST_GRAPH_WRK_HEAVY_NAME);
 }
 
 /** Graph Creation cheat sheet
@@ -1061,6 +1239,8 @@ static struct unit_test_suite graph_perf_testsuite = {
 			     graph_reverse_tree_3s_4n_1src_1snk),
 		TEST_CASE_ST(graph_init_parallel_tree, graph_fini,
 			     graph_parallel_tree_5s_4n_4src_4snk),
+		TEST_CASE_ST(graph_init_skew, graph_fini,
+			     graph_skew_4s_1n_1src_1snk),
 		TEST_CASES_END(), /**< NULL terminate unit test array */
 	},
 };
@@ -94,6 +94,7 @@ struct ipsec_unitest_params {
 
 	uint16_t pkt_index;
 	bool is_stateless;
+	uint32_t sqn_blk_sz;
 };
 
 struct ipsec_test_cfg {
@@ -117,6 +118,10 @@ static const struct ipsec_test_cfg test_cfg[] = {
 	{REPLAY_WIN_128, ESN_ENABLED, RTE_IPSEC_SAFLAG_SQN_ATOM,
 		DATA_80_BYTES, 1, 0},
 	{REPLAY_WIN_256, ESN_DISABLED, 0, DATA_100_BYTES, 1, 0},
+	{REPLAY_WIN_128, ESN_ENABLED, RTE_IPSEC_SAFLAG_SQN_SHARD,
+		DATA_80_BYTES, BURST_SIZE, REORDER_PKTS},
+	{REPLAY_WIN_256, ESN_DISABLED, RTE_IPSEC_SAFLAG_SQN_SHARD,
+		DATA_100_BYTES, 1, 0},
 };
 
 static const int num_cfg = RTE_DIM(test_cfg);
@@ -685,6 +690,7 @@ fill_ipsec_param(uint32_t replay_win_sz, uint64_t flags)
 	prm->ipsec_xform = ut_params->ipsec_xform;
 	prm->ipsec_xform.salt = (uint32_t)rte_rand();
 	prm->ipsec_xform.replay_win_sz = replay_win_sz;
+	prm->sqn_blk_sz = ut_params->sqn_blk_sz;
 
 	/* setup tunnel related fields */
 	prm->tun.hdr_len = sizeof(ipv4_outer);
@@ -2570,6 +2576,270 @@ test_ipsec_crypto_inb_burst_2sa_4grp_null_null_wrapper(void)
 	return rc;
 }
 
+#define SHARD_MAX_WORKERS	4
+#define SHARD_OUTB_BLK_SZ	64
+#define SHARD_OUTB_BURST	24
+#define SHARD_OUTB_ITER		64
+/* each block holds two bursts, the rest of the block is skipped */
+#define SHARD_OUTB_MAX_SQN	\
+	((SHARD_MAX_WORKERS * SHARD_OUTB_ITER / 2 + SHARD_MAX_WORKERS) * \
+	SHARD_OUTB_BLK_SZ)
+/* all sequence numbers stay in the replay window */
+#define SHARD_INB_NB_SQN	(REPLAY_WIN_256 / 2)
+
+struct sqn_shard_worker {
+	struct rte_ipsec_session *ss;
+	struct rte_crypto_op *cop[BURST_SIZE];
+	struct rte_mbuf *mb[SHARD_INB_NB_SQN];
+	uint32_t sqn[SHARD_OUTB_ITER * SHARD_OUTB_BURST];
+	uint32_t nb_sqn;
+	int rc;
+};
+
+static struct sqn_shard_worker sqn_shard_workers[SHARD_MAX_WORKERS];
+static RTE_ATOMIC(uint32_t) sqn_shard_accepted[SHARD_INB_NB_SQN + 1];
+
+static int
+sqn_shard_alloc_cop(struct sqn_shard_worker *w)
+{
+	struct ipsec_testsuite_params *ts_params = &testsuite_params;
+	uint32_t j;
+
+	for (j = 0; j < BURST_SIZE; j++) {
+		w->cop[j] = rte_crypto_op_alloc(ts_params->cop_mpool,
+				RTE_CRYPTO_OP_TYPE_SYMMETRIC);
+		if (w->cop[j] == NULL)
+			return TEST_FAILED;
+	}
+	return 0;
+}
+
+static void
+sqn_shard_free_workers(void)
+{
+	struct sqn_shard_worker *w;
+	uint32_t i, j;
+
+	for (i = 0; i < SHARD_MAX_WORKERS; i++) {
+		w = &sqn_shard_workers[i];
+		for (j = 0; j < BURST_SIZE; j++)
+			rte_crypto_op_free(w->cop[j]);
+		for (j = 0; j < SHARD_INB_NB_SQN; j++)
+			rte_pktmbuf_free(w->mb[j]);
+	}
+	memset(sqn_shard_workers, 0, sizeof(sqn_shard_workers));
+}
+
+/* Launch fn on up to SHARD_MAX_WORKERS worker lcores, return their number */
+static uint32_t
+sqn_shard_run(lcore_function_t *fn)
+{
+	uint32_t lcore_id, i, n = 0;
+
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (n == SHARD_MAX_WORKERS)
+			break;
+		rte_eal_remote_launch(fn, &sqn_shard_workers[n], lcore_id);
+		n++;
+	}
+	rte_eal_mp_wait_lcore();
+
+	for (i = 0; i < n; i++)
+		if (sqn_shard_workers[i].rc != 0)
+			return 0;
+	return n;
+}
+
+static int
+sqn_shard_outb_worker(void *arg)
+{
+	struct ipsec_testsuite_params *ts_params = &testsuite_params;
+	struct sqn_shard_worker *w = arg;
+	struct rte_mbuf *mb[SHARD_OUTB_BURST];
+	struct rte_esp_hdr esph;
+	uint32_t i, j, k;
+
+	for (i = 0; i < SHARD_OUTB_ITER && w->rc == 0; i++) {
+		for (j = 0; j < SHARD_OUTB_BURST; j++) {
+			mb[j] = setup_test_string(ts_params->mbuf_pool,
+				null_plain_data, sizeof(null_plain_data),
+				DATA_64_BYTES, 0);
+			if (mb[j] == NULL)
+				break;
+		}
+
+		k = 0;
+		if (j == SHARD_OUTB_BURST)
+			k = rte_ipsec_pkt_crypto_prepare(w->ss, mb, w->cop, j);
+		if (k != SHARD_OUTB_BURST)
+			w->rc = TEST_FAILED;
+
+		for (k = 0; k < j; k++) {
+			if (w->rc == 0) {
+				memcpy(&esph, rte_pktmbuf_mtod_offset(mb[k],
+					void *, sizeof(ipv4_outer)), sizeof(esph));
+				w->sqn[w->nb_sqn++] = rte_be_to_cpu_32(esph.seq);
+			}
+			rte_pktmbuf_free(mb[k]);
+		}
+	}
+
+	return 0;
+}
+
+static int
+test_ipsec_sqn_shard_outb_null_null(void)
+{
+	struct ipsec_unitest_params *ut_params = &unittest_params;
+	static uint8_t seen[SHARD_OUTB_MAX_SQN + 1];
+	struct sqn_shard_worker *w;
+	uint32_t i, j, n, sqn;
+	int rc;
+
+	if (rte_lcore_count() < 2)
+		return TEST_SKIPPED;
+
+	ut_params->ipsec_xform.spi = OUTBOUND_SPI;
+	ut_params->ipsec_xform.direction = RTE_SECURITY_IPSEC_SA_DIR_EGRESS;
+	ut_params->ipsec_xform.proto = RTE_SECURITY_IPSEC_SA_PROTO_ESP;
+	ut_params->ipsec_xform.mode = RTE_SECURITY_IPSEC_SA_MODE_TUNNEL;
+	ut_params->ipsec_xform.tunnel.type = RTE_SECURITY_IPSEC_TUNNEL_IPV4;
+	ut_params->ipsec_xform.options.esn = ESN_DISABLED;
+	ut_params->sqn_blk_sz = SHARD_OUTB_BLK_SZ;
+
+	rc = create_sa(RTE_SECURITY_ACTION_TYPE_NONE, REPLAY_WIN_0,
+			RTE_IPSEC_SAFLAG_SQN_SHARD, 0);
+	if (rc != 0) {
+		RTE_LOG(ERR, USER1, "create_sa failed\n");
+		return rc;
+	}
+
+	for (i = 0; i < SHARD_MAX_WORKERS && rc == 0; i++) {
+		sqn_shard_workers[i].ss = &ut_params->ss[0];
+		rc = sqn_shard_alloc_cop(&sqn_shard_workers[i]);
+	}
+
+	n = 0;
+	if (rc == 0)
+		n = sqn_shard_run(sqn_shard_outb_worker);
+	if (n == 0)
+		rc = TEST_FAILED;
+
+	/*
+	 * Each lcore assigns increasing sequence numbers,
+	 * and no sequence number is assigned twice.
+	 */
+	memset(seen, 0, sizeof(seen));
+	for (i = 0; i < n && rc == 0; i++) {
+		w = &sqn_shard_workers[i];
+		for (j = 0; j < w->nb_sqn && rc == 0; j++) {
+			sqn = w->sqn[j];
+			if (sqn == 0 || sqn > SHARD_OUTB_MAX_SQN || seen[sqn] != 0 ||
+					(j != 0 && sqn <= w->sqn[j - 1])) {
+				RTE_LOG(ERR, USER1,
+					"Invalid sequence number %u on worker %u\n",
+					sqn, i);
+				rc = TEST_FAILED;
+			} else
+				seen[sqn] = 1;
+		}
+	}
+
+	sqn_shard_free_workers();
+	destroy_sa(0);
+	return rc;
+}
+
+static int
+sqn_shard_inb_worker(void *arg)
+{
+	struct sqn_shard_worker *w = arg;
+	struct rte_mbuf *mb[BURST_SIZE];
+	uint32_t i, j, k, n, x;
+
+	for (i = 0; i < SHARD_INB_NB_SQN; i += n) {
+		n = RTE_MIN((uint32_t)BURST_SIZE, SHARD_INB_NB_SQN - i);
+		memcpy(mb, &w->mb[i], n * sizeof(mb[0]));
+
+		k = rte_ipsec_pkt_crypto_prepare(w->ss, mb, w->cop, n);
+		k = rte_ipsec_pkt_process(w->ss, mb, k);
+
+		/* accepted packets are moved first, find their index */
+		for (j = 0; j < k; j++) {
+			for (x = i; x != i + n && w->mb[x] != mb[j]; x++)
+				;
+			if (x == i + n) {
+				w->rc = TEST_FAILED;
+				return 0;
+			}
+			rte_atomic_fetch_add_explicit(&sqn_shard_accepted[x + 1],
+				1, rte_memory_order_relaxed);
+		}
+	}
+
+	return 0;
+}
+
+static int
+test_ipsec_sqn_shard_inb_null_null(void)
+{
+	struct ipsec_testsuite_params *ts_params = &testsuite_params;
+	struct ipsec_unitest_params *ut_params = &unittest_params;
+	uint32_t i, j, n;
+	int rc;
+
+	if (rte_lcore_count() < 2)
+		return TEST_SKIPPED;
+
+	ut_params->ipsec_xform.spi = INBOUND_SPI;
+	ut_params->ipsec_xform.direction = RTE_SECURITY_IPSEC_SA_DIR_INGRESS;
+	ut_params->ipsec_xform.proto = RTE_SECURITY_IPSEC_SA_PROTO_ESP;
+	ut_params->ipsec_xform.mode = RTE_SECURITY_IPSEC_SA_MODE_TUNNEL;
+	ut_params->ipsec_xform.tunnel.type = RTE_SECURITY_IPSEC_TUNNEL_IPV4;
+	ut_params->ipsec_xform.options.esn = ESN_DISABLED;
+
+	rc = create_sa(RTE_SECURITY_ACTION_TYPE_NONE, REPLAY_WIN_256,
+			RTE_IPSEC_SAFLAG_SQN_SHARD, 0);
+	if (rc != 0) {
+		RTE_LOG(ERR, USER1, "create_sa failed\n");
+		return rc;
+	}
+
+	/* every lcore receives all the sequence numbers */
+	for (i = 0; i < SHARD_MAX_WORKERS && rc == 0; i++) {
+		sqn_shard_workers[i].ss = &ut_params->ss[0];
+		rc = sqn_shard_alloc_cop(&sqn_shard_workers[i]);
+		for (j = 0; j < SHARD_INB_NB_SQN && rc == 0; j++) {
+			sqn_shard_workers[i].mb[j] = setup_test_string_tunneled(
+				ts_params->mbuf_pool, null_encrypted_data,
+				DATA_64_BYTES, INBOUND_SPI, j + 1);
+			if (sqn_shard_workers[i].mb[j] == NULL)
+				rc = TEST_FAILED;
+		}
+	}
+	memset(sqn_shard_accepted, 0, sizeof(sqn_shard_accepted));
+
+	n = 0;
+	if (rc == 0)
+		n = sqn_shard_run(sqn_shard_inb_worker);
+	if (n == 0)
+		rc = TEST_FAILED;
+
+	/* each sequence number is accepted by exactly one lcore */
+	for (i = 1; i <= SHARD_INB_NB_SQN && rc == 0; i++) {
+		if (sqn_shard_accepted[i] != 1) {
+			RTE_LOG(ERR, USER1,
+				"Sequence number %u accepted %u times\n",
+				i, sqn_shard_accepted[i]);
+			rc = TEST_FAILED;
+		}
+	}
+
+	sqn_shard_free_workers();
+	destroy_sa(0);
+	return rc;
+}
+
 static struct unit_test_suite ipsec_testsuite  = {
 	.suite_name = "IPsec NULL Unit Test Suite",
 	.setup = testsuite_setup,
@@ -2605,6 +2875,10 @@ static struct unit_test_suite ipsec_testsuite  = {
 			test_ipsec_crypto_inb_burst_2sa_null_null_wrapper),
 		TEST_CASE_ST(ut_setup_ipsec, ut_teardown_ipsec,
 			test_ipsec_crypto_inb_burst_2sa_4grp_null_null_wrapper),
+		TEST_CASE_ST(ut_setup_ipsec, ut_teardown_ipsec,
+			test_ipsec_sqn_shard_outb_null_null),
+		TEST_CASE_ST(ut_setup_ipsec, ut_teardown_ipsec,
+			test_ipsec_sqn_shard_inb_null_null),
 		TEST_CASES_END() /**< NULL terminate unit test array */
 	}
 };
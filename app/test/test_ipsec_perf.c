@@ -72,6 +72,9 @@ static const struct ipsec_test_cfg test_cfg[] = {
 
 };
 
+/* packet sizes the test configurations are measured with */
+static const uint16_t test_pkt_sz[] = {64, 256, 1024};
+
 static struct rte_ipv4_hdr ipv4_outer  = {
 	.version_ihl = IPVERSION << 4 |
 		sizeof(ipv4_outer) / RTE_IPV4_IHL_MULTIPLIER,
@@ -143,13 +146,14 @@ const struct supported_aead_algo aead_algo[] = {
 	}
 };
 
-static struct rte_mbuf *generate_mbuf_data(struct rte_mempool *mpool)
+static struct rte_mbuf *generate_mbuf_data(struct rte_mempool *mpool,
+		uint16_t pkt_sz)
 {
 	struct rte_mbuf *mbuf = rte_pktmbuf_alloc(mpool);
 
 	if (mbuf) {
-		mbuf->data_len = 64;
-		mbuf->pkt_len  = 64;
+		mbuf->data_len = pkt_sz;
+		mbuf->pkt_len  = pkt_sz;
 	}
 
 	return mbuf;
@@ -445,7 +449,7 @@ init_sa_session(const struct ipsec_test_cfg *test_cfg,
 }
 
 static int
-testsuite_setup(void)
+testsuite_setup(uint16_t pkt_sz)
 {
 	struct rte_mbuf *mbuf;
 	int i;
@@ -492,7 +496,7 @@ testsuite_setup(void)
 		return TEST_FAILED;
 
 	for (i = 0; i < NUM_MBUF; i++) {
-		mbuf = generate_mbuf_data(mbuf_pool);
+		mbuf = generate_mbuf_data(mbuf_pool, pkt_sz);
 
 		if (mbuf && rte_ring_sp_enqueue_bulk(ring_inb_prepare,
 			   (void **)&mbuf, 1, NULL))
@@ -530,11 +534,12 @@ measure_performance(struct ipsec_sa *sa_out, struct ipsec_sa *sa_in)
 }
 
 static void
-print_metrics(const struct ipsec_test_cfg *test_cfg,
+print_metrics(const struct ipsec_test_cfg *test_cfg, uint16_t pkt_sz,
 	      struct ipsec_sa *sa_out, struct ipsec_sa *sa_in)
 {
 	printf("\nMetrics of libipsec prepare/process api:\n");
 
+	printf("packet size = %u\n", pkt_sz);
 	printf("replay window size = %u\n", test_cfg->replay_win_sz);
 	if (test_cfg->esn)
 		printf("replay esn is enabled\n");
@@ -594,7 +599,7 @@ test_libipsec_perf(void)
 {
 	struct ipsec_sa sa_out = { .sa_prm = { 0 } };
 	struct ipsec_sa sa_in = { .sa_prm = { 0 } };
-	uint32_t i;
+	uint32_t i, j;
 	int ret;
 
 	ret = rte_cryptodev_count();
@@ -603,29 +608,36 @@ test_libipsec_perf(void)
 		return TEST_SKIPPED;
 	}
 
-	if (testsuite_setup() < 0) {
-		testsuite_teardown();
-		return TEST_FAILED;
-	}
+	for (j = 0; j < RTE_DIM(test_pkt_sz); j++) {
 
-	for (i = 0; i < RTE_DIM(test_cfg) ; i++) {
-
-		ret = init_sa_session(&test_cfg[i], &sa_out, &sa_in);
-		if (ret != 0) {
+		if (testsuite_setup(test_pkt_sz[j]) < 0) {
 			testsuite_teardown();
 			return TEST_FAILED;
 		}
 
-		if (measure_performance(&sa_out, &sa_in) < 0) {
-			testsuite_teardown();
-			return TEST_FAILED;
+		for (i = 0; i < RTE_DIM(test_cfg) ; i++) {
+
+			ret = init_sa_session(&test_cfg[i], &sa_out, &sa_in);
+			if (ret != 0) {
+				testsuite_teardown();
+				return TEST_FAILED;
+			}
+
+			memset(&sa_out.cnt, 0, sizeof(sa_out.cnt));
+			memset(&sa_in.cnt, 0, sizeof(sa_in.cnt));
+
+			if (measure_performance(&sa_out, &sa_in) < 0) {
+				testsuite_teardown();
+				return TEST_FAILED;
+			}
+
+			print_metrics(&test_cfg[i], test_pkt_sz[j],
+				&sa_out, &sa_in);
 		}
 
-		print_metrics(&test_cfg[i], &sa_out, &sa_in);
+		testsuite_teardown();
 	}
 
-	testsuite_teardown();
-
 	return TEST_SUCCESS;
 }
 
@@ -2749,6 +2749,83 @@ test_nb_segs_and_next_reset(void)
 	return -1;
 }
 
+/* check lifecycle stage mapping and per-stage statistics of mbuf history */
+static int
+test_mbuf_history_stats(struct rte_mempool *pktmbuf_pool)
+{
+	struct rte_mbuf_history_stats stats;
+	struct rte_mbuf *m = NULL;
+	int ret;
+
+	if (rte_mbuf_history_op_stage(RTE_MBUF_HISTORY_OP_NEVER) !=
+				RTE_MBUF_HISTORY_STAGE_FREE ||
+			rte_mbuf_history_op_stage(RTE_MBUF_HISTORY_OP_APP_FREE) !=
+				RTE_MBUF_HISTORY_STAGE_FREE ||
+			rte_mbuf_history_op_stage(RTE_MBUF_HISTORY_OP_PMD_ALLOC) !=
+				RTE_MBUF_HISTORY_STAGE_DRIVER ||
+			rte_mbuf_history_op_stage(RTE_MBUF_HISTORY_OP_TX) !=
+				RTE_MBUF_HISTORY_STAGE_DRIVER ||
+			rte_mbuf_history_op_stage(RTE_MBUF_HISTORY_OP_ENQUEUE) !=
+				RTE_MBUF_HISTORY_STAGE_QUEUE ||
+			rte_mbuf_history_op_stage(RTE_MBUF_HISTORY_OP_RX) !=
+				RTE_MBUF_HISTORY_STAGE_APP ||
+			rte_mbuf_history_op_stage(RTE_MBUF_HISTORY_OP_LIB_ALLOC) !=
+				RTE_MBUF_HISTORY_STAGE_APP)
+		GOTO_FAIL("%s: unexpected stage of history operation", __func__);
+
+	if (rte_mbuf_history_stage_name(RTE_MBUF_HISTORY_STAGE_FREE) == NULL ||
+			rte_mbuf_history_stage_name(RTE_MBUF_HISTORY_STAGE_QUEUE) == NULL ||
+			rte_mbuf_history_stage_name(RTE_MBUF_HISTORY_STAGE_MAX) != NULL)
+		GOTO_FAIL("%s: unexpected stage name", __func__);
+
+	ret = rte_mbuf_history_timestamp_register();
+#ifndef RTE_MBUF_HISTORY_DEBUG
+	if (ret != -ENOTSUP)
+		GOTO_FAIL("%s: timestamp registration should not be supported",
+				__func__);
+	if (rte_mbuf_history_stats_get(pktmbuf_pool, &stats) != -ENOTSUP)
+		GOTO_FAIL("%s: stats should not be supported", __func__);
+#else
+	if (ret < 0)
+		GOTO_FAIL("%s: cannot register timestamp field", __func__);
+	if (rte_mbuf_dynfield_lookup(RTE_MBUF_DYNFIELD_HISTORY_TIMESTAMP_NAME,
+			NULL) != ret)
+		GOTO_FAIL("%s: timestamp field lookup mismatch", __func__);
+	if (rte_mbuf_history_stats_get(NULL, &stats) != -EINVAL ||
+			rte_mbuf_history_stats_get(pktmbuf_pool, NULL) != -EINVAL)
+		GOTO_FAIL("%s: invalid parameters not rejected", __func__);
+
+	m = rte_pktmbuf_alloc(pktmbuf_pool);
+	if (m == NULL)
+		GOTO_FAIL("%s: mbuf allocation failed", __func__);
+	rte_mbuf_history_mark(m, RTE_MBUF_HISTORY_OP_ENQUEUE);
+	*RTE_MBUF_DYNFIELD(m, ret, uint64_t *) = rte_get_tsc_cycles() - 1;
+
+	if (rte_mbuf_history_stats_get(pktmbuf_pool, &stats) != 0)
+		GOTO_FAIL("%s: cannot get history stats", __func__);
+	if (stats.total != pktmbuf_pool->size)
+		GOTO_FAIL("%s: walked %"PRIu64" mbufs, expected %u", __func__,
+				stats.total, pktmbuf_pool->size);
+	if (stats.op[RTE_MBUF_HISTORY_OP_ENQUEUE] < 1 ||
+			stats.stage[RTE_MBUF_HISTORY_STAGE_QUEUE] < 1)
+		GOTO_FAIL("%s: enqueued mbuf not counted", __func__);
+	if (stats.stage_aged[RTE_MBUF_HISTORY_STAGE_QUEUE] < 1 ||
+			stats.stage_age_max[RTE_MBUF_HISTORY_STAGE_QUEUE] == 0)
+		GOTO_FAIL("%s: enqueued mbuf age not counted", __func__);
+	if (stats.stage_aged[RTE_MBUF_HISTORY_STAGE_FREE] != 0)
+		GOTO_FAIL("%s: free mbufs should not be aged", __func__);
+
+	*RTE_MBUF_DYNFIELD(m, ret, uint64_t *) = 0;
+#endif
+
+	rte_pktmbuf_free(m);
+	return 0;
+
+fail:
+	rte_pktmbuf_free(m);
+	return -1;
+}
+
 static int
 test_mbuf(void)
 {
@@ -2897,6 +2974,11 @@ test_mbuf(void)
 		goto err;
 	}
 
+	if (test_mbuf_history_stats(pktmbuf_pool) < 0) {
+		printf("test_mbuf_history_stats() failed\n");
+		goto err;
+	}
+
 	/* test for allocating a bulk of mbufs with various sizes */
 	if (test_pktmbuf_alloc_bulk(pktmbuf_pool) < 0) {
 		printf("test_rte_pktmbuf_alloc_bulk() failed\n");
@@ -0,0 +1,355 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_bus_vdev.h>
+#include <rte_cycles.h>
+#include <rte_lcore.h>
+#include <rte_mldev.h>
+#include <rte_random.h>
+
+#include "test.h"
+
+#define ML_CPU_TEST_IN		4
+#define ML_CPU_TEST_MAX_BATCHES	4
+#define ML_CPU_TEST_NB_OPS	256
+#define ML_CPU_TEST_NB_DESC	64
+#define ML_CPU_TEST_BURST	16
+#define ML_CPU_TEST_TIMEOUT_S	10
+
+/*
+ * INT8 model of the format described in the driver guide,
+ * made of one fully connected layer computing out[o] = in[3 - o] + o,
+ * with unit scales and null zero points.
+ */
+struct __rte_packed_begin ml_cpu_test_model {
+	char magic[8];
+	uint32_t version;
+	uint32_t dtype;
+	char name[32];
+	uint16_t nb_layers;
+	uint16_t max_batches;
+	uint32_t in_dims[3];
+	float in_scale;
+	int32_t in_zero_point;
+	/* fully connected layer */
+	uint16_t type;
+	uint16_t act;
+	uint32_t out_c;
+	uint16_t kernel;
+	uint16_t stride;
+	uint16_t pad;
+	uint16_t reserved;
+	float w_scale;
+	float out_scale;
+	int32_t out_zero_point;
+	int8_t weights[ML_CPU_TEST_IN][ML_CPU_TEST_IN];
+	int32_t bias[ML_CPU_TEST_IN];
+} __rte_packed_end;
+
+static struct {
+	int16_t dev_id;
+	uint16_t model_id;
+	struct rte_mempool *op_pool;
+	struct rte_ml_op *ops[ML_CPU_TEST_NB_OPS];
+	int8_t in[ML_CPU_TEST_NB_OPS][ML_CPU_TEST_MAX_BATCHES][ML_CPU_TEST_IN];
+	int8_t out[ML_CPU_TEST_NB_OPS][ML_CPU_TEST_MAX_BATCHES][ML_CPU_TEST_IN];
+	struct rte_ml_buff_seg in_seg[ML_CPU_TEST_NB_OPS];
+	struct rte_ml_buff_seg out_seg[ML_CPU_TEST_NB_OPS];
+	struct rte_ml_buff_seg *in_ptr[ML_CPU_TEST_NB_OPS];
+	struct rte_ml_buff_seg *out_ptr[ML_CPU_TEST_NB_OPS];
+} ml_cpu_test;
+
+static void
+ml_cpu_test_model_init(struct ml_cpu_test_model *m)
+{
+	uint32_t o;
+
+	memset(m, 0, sizeof(*m));
+	memcpy(m->magic, "DPDKMLC", sizeof(m->magic));
+	m->version = 1;
+	m->dtype = 1;
+	strlcpy(m->name, "ml_cpu_test", sizeof(m->name));
+	m->nb_layers = 1;
+	m->max_batches = ML_CPU_TEST_MAX_BATCHES;
+	m->in_dims[0] = 1;
+	m->in_dims[1] = 1;
+	m->in_dims[2] = ML_CPU_TEST_IN;
+	m->in_scale = 1;
+	m->type = 1;
+	m->out_c = ML_CPU_TEST_IN;
+	m->w_scale = 1;
+	m->out_scale = 1;
+	for (o = 0; o != ML_CPU_TEST_IN; o++) {
+		m->weights[o][ML_CPU_TEST_IN - 1 - o] = 1;
+		m->bias[o] = o;
+	}
+}
+
+/* create a device and return its identifier */
+static int16_t
+ml_cpu_test_dev_create(const char *name, const char *args)
+{
+	bool old[RTE_MLDEV_DEFAULT_MAX] = { false };
+	int16_t id;
+
+	if (rte_ml_dev_count() != 0)
+		for (id = 0; id != RTE_MLDEV_DEFAULT_MAX; id++)
+			old[id] = rte_ml_dev_is_valid_dev(id);
+	if (rte_vdev_init(name, args) != 0)
+		return -1;
+	for (id = 0; id != RTE_MLDEV_DEFAULT_MAX; id++)
+		if (!old[id] && rte_ml_dev_is_valid_dev(id))
+			return id;
+	return -1;
+}
+
+static int
+ml_cpu_test_setup(const char *name, const char *args)
+{
+	struct rte_ml_dev_config conf = {
+		.socket_id = SOCKET_ID_ANY,
+		.nb_models = 1,
+		.nb_queue_pairs = 1,
+	};
+	struct rte_ml_dev_qp_conf qp_conf = {
+		.nb_desc = ML_CPU_TEST_NB_DESC,
+	};
+	struct ml_cpu_test_model model;
+	struct rte_mempool *pool;
+	struct rte_ml_model_params params = {
+		.addr = &model,
+		.size = sizeof(model),
+	};
+	uint32_t i;
+
+	ml_cpu_test.dev_id = ml_cpu_test_dev_create(name, args);
+	if (ml_cpu_test.dev_id < 0) {
+		printf("Cannot create %s\n", name);
+		return TEST_SKIPPED;
+	}
+	TEST_ASSERT_SUCCESS(rte_ml_dev_configure(ml_cpu_test.dev_id, &conf),
+		"Cannot configure %s", name);
+	TEST_ASSERT_SUCCESS(rte_ml_dev_queue_pair_setup(ml_cpu_test.dev_id, 0,
+		&qp_conf, SOCKET_ID_ANY), "Cannot set up queue pair of %s", name);
+
+	ml_cpu_test_model_init(&model);
+	TEST_ASSERT_SUCCESS(rte_ml_model_load(ml_cpu_test.dev_id, &params,
+		&ml_cpu_test.model_id), "Cannot load model");
+	TEST_ASSERT_SUCCESS(rte_ml_model_start(ml_cpu_test.dev_id,
+		ml_cpu_test.model_id), "Cannot start model");
+	TEST_ASSERT_SUCCESS(rte_ml_dev_start(ml_cpu_test.dev_id),
+		"Cannot start %s", name);
+
+	pool = rte_ml_op_pool_create("ml_cpu_test_ops", ML_CPU_TEST_NB_OPS, 0, 0,
+		SOCKET_ID_ANY);
+	TEST_ASSERT_NOT_NULL(pool, "Cannot create op pool");
+	if (rte_mempool_get_bulk(pool, (void **)ml_cpu_test.ops,
+			ML_CPU_TEST_NB_OPS) != 0) {
+		rte_ml_op_pool_free(pool);
+		TEST_ASSERT(false, "Cannot allocate ops");
+	}
+	ml_cpu_test.op_pool = pool;
+
+	for (i = 0; i != ML_CPU_TEST_NB_OPS; i++) {
+		ml_cpu_test.in_seg[i].addr = ml_cpu_test.in[i];
+		ml_cpu_test.out_seg[i].addr = ml_cpu_test.out[i];
+		ml_cpu_test.in_ptr[i] = &ml_cpu_test.in_seg[i];
+		ml_cpu_test.out_ptr[i] = &ml_cpu_test.out_seg[i];
+	}
+	return TEST_SUCCESS;
+}
+
+static void
+ml_cpu_test_teardown(const char *name)
+{
+	if (ml_cpu_test.op_pool != NULL) {
+		rte_mempool_put_bulk(ml_cpu_test.op_pool,
+			(void **)ml_cpu_test.ops, ML_CPU_TEST_NB_OPS);
+		rte_ml_op_pool_free(ml_cpu_test.op_pool);
+		ml_cpu_test.op_pool = NULL;
+	}
+	if (ml_cpu_test.dev_id >= 0) {
+		rte_ml_dev_stop(ml_cpu_test.dev_id);
+		rte_ml_model_stop(ml_cpu_test.dev_id, ml_cpu_test.model_id);
+		rte_ml_model_unload(ml_cpu_test.dev_id, ml_cpu_test.model_id);
+		rte_ml_dev_close(ml_cpu_test.dev_id);
+		rte_vdev_uninit(name);
+		ml_cpu_test.dev_id = -1;
+	}
+}
+
+/* prepare an op with random input, of nb_batches batches */
+static void
+ml_cpu_test_op_init(uint32_t i, uint16_t nb_batches)
+{
+	struct rte_ml_op *op = ml_cpu_test.ops[i];
+	uint32_t b, e;
+
+	for (b = 0; b != ML_CPU_TEST_MAX_BATCHES; b++)
+		for (e = 0; e != ML_CPU_TEST_IN; e++)
+			ml_cpu_test.in[i][b][e] = (int8_t)(rte_rand_max(201) - 100);
+	memset(ml_cpu_test.out[i], 0, sizeof(ml_cpu_test.out[i]));
+	ml_cpu_test.in_seg[i].length = sizeof(ml_cpu_test.in[i]);
+	ml_cpu_test.out_seg[i].length = sizeof(ml_cpu_test.out[i]);
+
+	op->model_id = ml_cpu_test.model_id;
+	op->nb_batches = nb_batches;
+	op->mempool = ml_cpu_test.op_pool;
+	op->input = &ml_cpu_test.in_ptr[i];
+	op->output = &ml_cpu_test.out_ptr[i];
+	op->user_u64 = i;
+	op->status = RTE_ML_OP_STATUS_NOT_PROCESSED;
+	op->impl_opaque = 0;
+}
+
+static int
+ml_cpu_test_op_check(const struct rte_ml_op *op)
+{
+	uint32_t i = op->user_u64;
+	uint32_t b, o;
+
+	TEST_ASSERT_EQUAL(op->status, RTE_ML_OP_STATUS_SUCCESS,
+		"Op %u failed", i);
+	for (b = 0; b != op->nb_batches; b++)
+		for (o = 0; o != ML_CPU_TEST_IN; o++)
+			TEST_ASSERT_EQUAL(ml_cpu_test.out[i][b][o],
+				ml_cpu_test.in[i][b][ML_CPU_TEST_IN - 1 - o] + (int)o,
+				"Wrong output %u of batch %u of op %u", o, b, i);
+	return TEST_SUCCESS;
+}
+
+/*
+ * Run all the ops through the queue pair, checking they complete
+ * in order and with the expected output.
+ */
+static int
+ml_cpu_test_run(void)
+{
+	struct rte_ml_op *deq[ML_CPU_TEST_BURST];
+	uint32_t nb_enq, nb_deq, i, n;
+	uint64_t timeout;
+
+	timeout = rte_get_timer_cycles() +
+		ML_CPU_TEST_TIMEOUT_S * rte_get_timer_hz();
+	nb_enq = 0;
+	nb_deq = 0;
+	while (nb_deq != ML_CPU_TEST_NB_OPS) {
+		n = RTE_MIN(ML_CPU_TEST_BURST, ML_CPU_TEST_NB_OPS - (int)nb_enq);
+		nb_enq += rte_ml_enqueue_burst(ml_cpu_test.dev_id, 0,
+			&ml_cpu_test.ops[nb_enq], n);
+		n = rte_ml_dequeue_burst(ml_cpu_test.dev_id, 0, deq,
+			ML_CPU_TEST_BURST);
+		for (i = 0; i != n; i++, nb_deq++) {
+			TEST_ASSERT_EQUAL(deq[i]->user_u64, nb_deq,
+				"Op %"PRIu64" completed in place of op %u",
+				deq[i]->user_u64, nb_deq);
+			TEST_ASSERT_SUCCESS(ml_cpu_test_op_check(deq[i]),
+				"Wrong result");
+		}
+		TEST_ASSERT(rte_get_timer_cycles() < timeout,
+			"Only %u of %u ops completed", nb_deq,
+			ML_CPU_TEST_NB_OPS);
+	}
+	return TEST_SUCCESS;
+}
+
+static int
+test_ml_cpu_inline(void)
+{
+	static const char name[] = "ml_cpu_test_inline";
+	struct rte_ml_op_error error;
+	struct rte_ml_op *op;
+	uint32_t i;
+	int ret;
+
+	ret = ml_cpu_test_setup(name, NULL);
+	if (ret != TEST_SUCCESS)
+		goto out;
+
+	for (i = 0; i != ML_CPU_TEST_NB_OPS; i++)
+		ml_cpu_test_op_init(i, i % ML_CPU_TEST_MAX_BATCHES + 1);
+	ret = ml_cpu_test_run();
+	if (ret != TEST_SUCCESS)
+		goto out;
+
+	/* a failed op reports its error, and does not stop the others */
+	ml_cpu_test_op_init(0, ML_CPU_TEST_MAX_BATCHES + 1);
+	ml_cpu_test_op_init(1, 1);
+	ret = TEST_FAILED;
+	if (rte_ml_enqueue_burst(ml_cpu_test.dev_id, 0, ml_cpu_test.ops, 2) != 2 ||
+			rte_ml_dequeue_burst(ml_cpu_test.dev_id, 0, &op, 1) != 1 ||
+			op != ml_cpu_test.ops[0] ||
+			op->status != RTE_ML_OP_STATUS_ERROR) {
+		printf("Invalid op not reported\n");
+		goto out;
+	}
+	if (rte_ml_op_error_get(ml_cpu_test.dev_id, op, &error) != 0 ||
+			error.errcode == 0 || error.message[0] == '\0') {
+		printf("No error for invalid op\n");
+		goto out;
+	}
+	if (rte_ml_dequeue_burst(ml_cpu_test.dev_id, 0, &op, 1) != 1 ||
+			ml_cpu_test_op_check(op) != TEST_SUCCESS) {
+		printf("Valid op failed after an invalid one\n");
+		goto out;
+	}
+	ret = TEST_SUCCESS;
+out:
+	ml_cpu_test_teardown(name);
+	return ret;
+}
+
+static int
+test_ml_cpu_workers(void)
+{
+	static const char name[] = "ml_cpu_test_workers";
+	char args[64];
+	unsigned int lcore[2];
+	uint32_t i;
+	int ret;
+
+	if (rte_lcore_count() < 3) {
+		printf("Not enough lcores, skipping\n");
+		return TEST_SKIPPED;
+	}
+	lcore[0] = rte_get_next_lcore(-1, 1, 0);
+	lcore[1] = rte_get_next_lcore(lcore[0], 1, 0);
+	snprintf(args, sizeof(args), "worker=%u,worker=%u", lcore[0], lcore[1]);
+
+	ret = ml_cpu_test_setup(name, args);
+	if (ret != TEST_SUCCESS)
+		goto out;
+
+	/*
+	 * Ops of different sizes, run concurrently by the two workers,
+	 * are dequeued in order.
+	 */
+	for (i = 0; i != ML_CPU_TEST_NB_OPS; i++)
+		ml_cpu_test_op_init(i, rte_rand_max(ML_CPU_TEST_MAX_BATCHES) + 1);
+	ret = ml_cpu_test_run();
+out:
+	ml_cpu_test_teardown(name);
+	return ret;
+}
+
+static struct unit_test_suite ml_cpu_testsuite = {
+	.suite_name = "CPU ML Unit Test Suite",
+	.unit_test_cases = {
+		TEST_CASE(test_ml_cpu_inline),
+		TEST_CASE(test_ml_cpu_workers),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_ml_cpu(void)
+{
+	ml_cpu_test.dev_id = -1;
+	return unit_test_suite_runner(&ml_cpu_testsuite);
+}
+
+REGISTER_FAST_TEST(ml_cpu_autotest, true, true, test_ml_cpu);
@@ -0,0 +1,190 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_malloc.h>
+#include <rte_mldev.h>
+#include <rte_random.h>
+#include <rte_vect.h>
+
+#include "test.h"
+
+/*
+ * Measure the cost of the conversions of ML IO tensors for each allowed
+ * SIMD bitwidth, and check that all of them give the scalar results.
+ */
+
+#define NB_ELEMENTS	(1 << 16)
+#define ITERATIONS	64
+#define SCALE		0.0625f
+
+#define QUANT_WRAPPERS(type, zp) \
+static int \
+float32_to_##type(const void *input, void *output, uint64_t nb_elements) \
+{ \
+	return rte_ml_io_float32_to_##type(input, output, nb_elements, SCALE, zp); \
+} \
+static int \
+type##_to_float32(const void *input, void *output, uint64_t nb_elements) \
+{ \
+	return rte_ml_io_##type##_to_float32(input, output, nb_elements, SCALE, zp); \
+}
+
+QUANT_WRAPPERS(int8, -3)
+QUANT_WRAPPERS(uint8, 128)
+QUANT_WRAPPERS(int16, 1000)
+QUANT_WRAPPERS(uint16, 32768)
+QUANT_WRAPPERS(int32, -7)
+QUANT_WRAPPERS(uint32, 7)
+QUANT_WRAPPERS(int64, -7)
+QUANT_WRAPPERS(uint64, 7)
+
+typedef int (*convert_t)(const void *input, void *output, uint64_t nb_elements);
+
+static const struct {
+	const char *name;
+	convert_t fn;
+	size_t in_size;
+	size_t out_size;
+	float range;
+	/**< Range of the float32 inputs */
+} conversions[] = {
+	{ "float32_to_int8", float32_to_int8, sizeof(float), sizeof(int8_t), 8.0f },
+	{ "int8_to_float32", int8_to_float32, sizeof(int8_t), sizeof(float), 0 },
+	{ "float32_to_uint8", float32_to_uint8, sizeof(float), sizeof(uint8_t), 8.0f },
+	{ "uint8_to_float32", uint8_to_float32, sizeof(uint8_t), sizeof(float), 0 },
+	{ "float32_to_int16", float32_to_int16, sizeof(float), sizeof(int16_t), 2048.0f },
+	{ "int16_to_float32", int16_to_float32, sizeof(int16_t), sizeof(float), 0 },
+	{ "float32_to_uint16", float32_to_uint16, sizeof(float), sizeof(uint16_t), 2048.0f },
+	{ "uint16_to_float32", uint16_to_float32, sizeof(uint16_t), sizeof(float), 0 },
+	{ "float32_to_int32", float32_to_int32, sizeof(float), sizeof(int32_t), 65536.0f },
+	{ "int32_to_float32", int32_to_float32, sizeof(int32_t), sizeof(float), 0 },
+	{ "float32_to_uint32", float32_to_uint32, sizeof(float), sizeof(uint32_t), 65536.0f },
+	{ "uint32_to_float32", uint32_to_float32, sizeof(uint32_t), sizeof(float), 0 },
+	{ "float32_to_int64", float32_to_int64, sizeof(float), sizeof(int64_t), 65536.0f },
+	{ "int64_to_float32", int64_to_float32, sizeof(int64_t), sizeof(float), 0 },
+	{ "float32_to_uint64", float32_to_uint64, sizeof(float), sizeof(uint64_t), 65536.0f },
+	{ "uint64_to_float32", uint64_to_float32, sizeof(uint64_t), sizeof(float), 0 },
+	{ "float32_to_float16", rte_ml_io_float32_to_float16, sizeof(float), sizeof(uint16_t),
+	  65536.0f },
+	{ "float16_to_float32", rte_ml_io_float16_to_float32, sizeof(uint16_t), sizeof(float), 0 },
+	{ "float32_to_bfloat16", rte_ml_io_float32_to_bfloat16, sizeof(float), sizeof(uint16_t),
+	  65536.0f },
+	{ "bfloat16_to_float32", rte_ml_io_bfloat16_to_float32, sizeof(uint16_t), sizeof(float),
+	  0 },
+};
+
+static const uint16_t bitwidths[] = {
+	RTE_VECT_SIMD_DISABLED,
+	RTE_VECT_SIMD_128,
+	RTE_VECT_SIMD_256,
+	RTE_VECT_SIMD_512,
+};
+
+static void
+input_fill(void *input, size_t in_size, float range)
+{
+	float *f = input;
+	uint64_t *u = input;
+	uint32_t i;
+
+	if (range == 0) {
+		for (i = 0; i != NB_ELEMENTS * in_size / sizeof(*u); i++)
+			u[i] = rte_rand();
+		return;
+	}
+
+	/* mostly in the quantization range, some saturated, some halfway */
+	for (i = 0; i != NB_ELEMENTS; i++) {
+		f[i] = (rte_drand() * 2 - 1) * range * SCALE;
+		if ((i & 15) == 0)
+			f[i] = (int32_t)rte_rand_max(64) * 0.5f * SCALE - 16 * SCALE;
+	}
+}
+
+static int
+conversion_perf(unsigned int c, void *input, void *output, void *ref)
+{
+	const size_t out_len = (size_t)NB_ELEMENTS * conversions[c].out_size;
+	uint64_t start, cycles;
+	unsigned int b, j;
+	int ret;
+
+	printf("%-20s", conversions[c].name);
+	input_fill(input, conversions[c].in_size, conversions[c].range);
+
+	for (b = 0; b != RTE_DIM(bitwidths); b++) {
+		if (rte_vect_set_max_simd_bitwidth(bitwidths[b]) != 0) {
+			printf("%10s", "-");
+			continue;
+		}
+
+		memset(output, 0, out_len);
+		ret = conversions[c].fn(input, output, NB_ELEMENTS);
+		if (ret != 0) {
+			printf("\nconversion failed: %d\n", ret);
+			return -1;
+		}
+		if (b == 0)
+			memcpy(ref, output, out_len);
+		else if (memcmp(ref, output, out_len) != 0) {
+			printf("\nresult with %u bits SIMD differs from scalar\n", bitwidths[b]);
+			return -1;
+		}
+
+		start = rte_rdtsc_precise();
+		for (j = 0; j != ITERATIONS; j++)
+			conversions[c].fn(input, output, NB_ELEMENTS);
+		cycles = rte_rdtsc_precise() - start;
+		printf("%10.3f", (double)cycles / ((uint64_t)ITERATIONS * NB_ELEMENTS));
+	}
+	printf("\n");
+
+	return 0;
+}
+
+static int
+test_mldev_utils_perf(void)
+{
+	uint16_t max_simd_bitwidth = rte_vect_get_max_simd_bitwidth();
+	void *input, *output, *ref;
+	unsigned int b, c;
+	int ret = TEST_SUCCESS;
+
+	input = rte_malloc(NULL, NB_ELEMENTS * sizeof(uint64_t), RTE_CACHE_LINE_SIZE);
+	output = rte_malloc(NULL, NB_ELEMENTS * sizeof(uint64_t), RTE_CACHE_LINE_SIZE);
+	ref = rte_malloc(NULL, NB_ELEMENTS * sizeof(uint64_t), RTE_CACHE_LINE_SIZE);
+	if (input == NULL || output == NULL || ref == NULL) {
+		printf("cannot allocate buffers\n");
+		ret = TEST_FAILED;
+		goto exit;
+	}
+
+	printf("Cycles per element of %u elements, by max SIMD bitwidth\n", NB_ELEMENTS);
+	printf("%-20s", "conversion");
+	for (b = 0; b != RTE_DIM(bitwidths); b++)
+		printf("%10u", bitwidths[b]);
+	printf("\n");
+
+	for (c = 0; c != RTE_DIM(conversions); c++) {
+		if (conversion_perf(c, input, output, ref) != 0) {
+			ret = TEST_FAILED;
+			break;
+		}
+	}
+
+	rte_vect_set_max_simd_bitwidth(max_simd_bitwidth);
+exit:
+	rte_free(input);
+	rte_free(output);
+	rte_free(ref);
+	return ret;
+}
+
+REGISTER_PERF_TEST(mldev_utils_perf_autotest, test_mldev_utils_perf);
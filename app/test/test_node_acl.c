@@ -0,0 +1,480 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#include "test.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_errno.h>
+
+#ifdef RTE_EXEC_ENV_WINDOWS
+static int
+test_node_acl(void)
+{
+	printf("node_acl not supported on Windows, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+#else
+
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_ip.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_node_acl_api.h>
+#include <rte_rcu_qsbr.h>
+#include <rte_udp.h>
+
+#define ACL_TEST_SOURCE "acl_test_source"
+#define ACL_TEST_RULE0 "acl_test_rule0"
+#define ACL_TEST_RULE1 "acl_test_rule1"
+#define ACL_TEST_DEFAULT "acl_test_default"
+
+/* Edges of ip4_acl, the edge 0 is pkt_drop */
+#define ACL_TEST_EDGE_RULE0 1
+#define ACL_TEST_EDGE_RULE1 2
+#define ACL_TEST_EDGE_DEFAULT 3
+
+#define ACL_TEST_NB_PKTS 4
+#define ACL_TEST_NB_MBUFS 64
+
+/* xstats of the ACL nodes */
+#define ACL_TEST_XSTAT_NO_MATCH 0
+#define ACL_TEST_XSTAT_RULE(n) ((n) + 1)
+
+struct acl_test_pkt {
+	uint8_t proto;
+	uint32_t src;
+	uint32_t dst;
+	uint16_t dst_port;
+};
+
+static const struct acl_test_pkt acl_test_pkts[ACL_TEST_NB_PKTS] = {
+	/* UDP 1.1.1.1 -> 10.0.0.1:53 */
+	{ IPPROTO_UDP, RTE_IPV4(1, 1, 1, 1), RTE_IPV4(10, 0, 0, 1), 53 },
+	/* TCP 1.1.1.1 -> 10.0.0.1:53 */
+	{ IPPROTO_TCP, RTE_IPV4(1, 1, 1, 1), RTE_IPV4(10, 0, 0, 1), 53 },
+	/* UDP 192.168.0.1 -> 20.0.0.1:80 */
+	{ IPPROTO_UDP, RTE_IPV4(192, 168, 0, 1), RTE_IPV4(20, 0, 0, 1), 80 },
+	/* UDP 192.168.0.1 -> 10.0.0.1:53 */
+	{ IPPROTO_UDP, RTE_IPV4(192, 168, 0, 1), RTE_IPV4(10, 0, 0, 1), 53 },
+};
+
+static struct {
+	struct rte_mempool *mp;
+	struct rte_mbuf *mbufs[ACL_TEST_NB_PKTS];
+	struct rte_rcu_qsbr *qsbr;
+	rte_graph_t graph_id;
+	/* Packets given by the source node at the next walk */
+	uint16_t nb_pending;
+	/* Sink edge reached by each packet */
+	rte_edge_t edge[ACL_TEST_NB_PKTS];
+} acl_test = {
+	.graph_id = RTE_GRAPH_ID_INVALID,
+};
+
+static uint16_t
+acl_test_source(struct rte_graph *graph, struct rte_node *node, void **objs,
+		uint16_t nb_objs)
+{
+	uint16_t n = acl_test.nb_pending;
+
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	if (n == 0)
+		return 0;
+
+	rte_node_enqueue(graph, node, 0, (void **)acl_test.mbufs, n);
+	acl_test.nb_pending = 0;
+
+	return n;
+}
+
+static __rte_always_inline uint16_t
+acl_test_sink(void **objs, uint16_t nb_objs, rte_edge_t edge)
+{
+	uint16_t i, j;
+
+	for (i = 0; i < nb_objs; i++)
+		for (j = 0; j < ACL_TEST_NB_PKTS; j++)
+			if (objs[i] == acl_test.mbufs[j])
+				acl_test.edge[j] = edge;
+
+	return nb_objs;
+}
+
+static uint16_t
+acl_test_rule0(struct rte_graph *graph, struct rte_node *node, void **objs,
+	       uint16_t nb_objs)
+{
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+
+	return acl_test_sink(objs, nb_objs, ACL_TEST_EDGE_RULE0);
+}
+
+static uint16_t
+acl_test_rule1(struct rte_graph *graph, struct rte_node *node, void **objs,
+	       uint16_t nb_objs)
+{
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+
+	return acl_test_sink(objs, nb_objs, ACL_TEST_EDGE_RULE1);
+}
+
+static uint16_t
+acl_test_default(struct rte_graph *graph, struct rte_node *node, void **objs,
+		 uint16_t nb_objs)
+{
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+
+	return acl_test_sink(objs, nb_objs, ACL_TEST_EDGE_DEFAULT);
+}
+
+static struct rte_node_register acl_test_source_node = {
+	.process = acl_test_source,
+	.flags = RTE_NODE_SOURCE_F,
+	.name = ACL_TEST_SOURCE,
+	.nb_edges = 1,
+	.next_nodes = { "ip4_acl" },
+};
+RTE_NODE_REGISTER(acl_test_source_node);
+
+static struct rte_node_register acl_test_rule0_node = {
+	.process = acl_test_rule0,
+	.name = ACL_TEST_RULE0,
+};
+RTE_NODE_REGISTER(acl_test_rule0_node);
+
+static struct rte_node_register acl_test_rule1_node = {
+	.process = acl_test_rule1,
+	.name = ACL_TEST_RULE1,
+};
+RTE_NODE_REGISTER(acl_test_rule1_node);
+
+static struct rte_node_register acl_test_default_node = {
+	.process = acl_test_default,
+	.name = ACL_TEST_DEFAULT,
+};
+RTE_NODE_REGISTER(acl_test_default_node);
+
+static int
+acl_test_pkt_build(struct rte_mbuf *m, const struct acl_test_pkt *pkt)
+{
+	struct rte_ipv4_hdr *ip;
+	struct rte_udp_hdr *l4;
+	uint16_t len;
+
+	/* The ports of TCP and UDP are at the same offset */
+	len = sizeof(struct rte_ether_hdr) + sizeof(*ip) + sizeof(*l4);
+	ip = (struct rte_ipv4_hdr *)rte_pktmbuf_append(m, len);
+	if (ip == NULL)
+		return -1;
+	memset(ip, 0, len);
+
+	ip = RTE_PTR_ADD(ip, sizeof(struct rte_ether_hdr));
+	ip->version_ihl = RTE_IPV4_VHL_DEF;
+	ip->total_length = rte_cpu_to_be_16(sizeof(*ip) + sizeof(*l4));
+	ip->time_to_live = 64;
+	ip->next_proto_id = pkt->proto;
+	ip->src_addr = rte_cpu_to_be_32(pkt->src);
+	ip->dst_addr = rte_cpu_to_be_32(pkt->dst);
+
+	l4 = (struct rte_udp_hdr *)(ip + 1);
+	l4->src_port = rte_cpu_to_be_16(1024);
+	l4->dst_port = rte_cpu_to_be_16(pkt->dst_port);
+
+	return 0;
+}
+
+static void
+acl_test_rule_init(struct rte_node_acl_ip4_rule *rule, rte_edge_t edge, int32_t priority)
+{
+	memset(rule, 0, sizeof(*rule));
+	rule->data.userdata = edge;
+	rule->data.priority = priority;
+	rule->data.category_mask = 1;
+	rule->field[RTE_NODE_ACL_IP4_FIELD_SRC_PORT].mask_range.u16 = UINT16_MAX;
+	rule->field[RTE_NODE_ACL_IP4_FIELD_DST_PORT].mask_range.u16 = UINT16_MAX;
+}
+
+static int
+acl_test_walk(const rte_edge_t *expected)
+{
+	struct rte_graph *graph = rte_graph_lookup("worker_acl_test");
+	uint16_t i;
+
+	for (i = 0; i < ACL_TEST_NB_PKTS; i++)
+		acl_test.edge[i] = RTE_EDGE_ID_INVALID;
+	acl_test.nb_pending = ACL_TEST_NB_PKTS;
+
+	/* Source, then ip4_acl, then the sinks */
+	rte_graph_walk(graph);
+
+	for (i = 0; i < ACL_TEST_NB_PKTS; i++) {
+		if (acl_test.edge[i] != expected[i]) {
+			printf("Packet %u reached edge %u instead of %u\n", i, acl_test.edge[i],
+			       expected[i]);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static void
+acl_test_xstats_get(uint64_t *xstats, uint16_t nb_xstats)
+{
+	struct rte_node *node = rte_graph_node_get_by_name("worker_acl_test", "ip4_acl");
+
+	memcpy(xstats, RTE_PTR_ADD(node, node->xstat_off), nb_xstats * sizeof(xstats[0]));
+}
+
+static int
+test_acl_rules_set(void)
+{
+	struct rte_node_acl_conf conf = {
+		.socket_id = SOCKET_ID_ANY,
+		.default_next = ACL_TEST_EDGE_DEFAULT,
+		.qsbr = acl_test.qsbr,
+	};
+	struct rte_node_acl_ip4_rule rules[2];
+
+	/* Next edge out of range */
+	acl_test_rule_init(&rules[0], ACL_TEST_EDGE_DEFAULT + 1, 1);
+	if (rte_node_ip4_acl_rules_set(&conf, rules, 1) != -EINVAL) {
+		printf("Rule with an invalid next edge accepted\n");
+		return -1;
+	}
+
+	conf.default_next = ACL_TEST_EDGE_DEFAULT + 1;
+	if (rte_node_ip4_acl_rules_set(&conf, NULL, 0) != -EINVAL) {
+		printf("Invalid default next edge accepted\n");
+		return -1;
+	}
+	conf.default_next = ACL_TEST_EDGE_DEFAULT;
+
+	if (rte_node_ip4_acl_rules_set(&conf, NULL, 0) != 0) {
+		printf("Failed to set empty rules\n");
+		return -1;
+	}
+
+	/* The rules in use cannot be freed safely without QSBR */
+	conf.qsbr = NULL;
+	if (rte_node_ip4_acl_rules_set(&conf, NULL, 0) != -EINVAL) {
+		printf("Rules replaced without QSBR\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int
+test_acl_default_edge(void)
+{
+	static const rte_edge_t expected[ACL_TEST_NB_PKTS] = {
+		ACL_TEST_EDGE_DEFAULT, ACL_TEST_EDGE_DEFAULT,
+		ACL_TEST_EDGE_DEFAULT, ACL_TEST_EDGE_DEFAULT,
+	};
+	struct rte_node_acl_conf conf = {
+		.socket_id = SOCKET_ID_ANY,
+		.default_next = ACL_TEST_EDGE_DEFAULT,
+		.qsbr = acl_test.qsbr,
+	};
+
+	/* Without rules, every packet goes to the default edge */
+	if (rte_node_ip4_acl_rules_set(&conf, NULL, 0) != 0) {
+		printf("Failed to set empty rules\n");
+		return -1;
+	}
+
+	return acl_test_walk(expected);
+}
+
+static int
+test_acl_classify(void)
+{
+	static const rte_edge_t expected[ACL_TEST_NB_PKTS] = {
+		ACL_TEST_EDGE_RULE0, ACL_TEST_EDGE_DEFAULT,
+		ACL_TEST_EDGE_RULE1, ACL_TEST_EDGE_RULE0,
+	};
+	struct rte_node_acl_conf conf = {
+		.socket_id = SOCKET_ID_ANY,
+		.default_next = ACL_TEST_EDGE_DEFAULT,
+		.qsbr = acl_test.qsbr,
+	};
+	uint64_t before[ACL_TEST_XSTAT_RULE(2)], after[ACL_TEST_XSTAT_RULE(2)];
+	struct rte_node_acl_ip4_rule rules[2];
+
+	/* UDP to 10.0.0.0/8 port 53, wins over rule 1 */
+	acl_test_rule_init(&rules[0], ACL_TEST_EDGE_RULE0, 2);
+	rules[0].field[RTE_NODE_ACL_IP4_FIELD_PROTO].value.u8 = IPPROTO_UDP;
+	rules[0].field[RTE_NODE_ACL_IP4_FIELD_PROTO].mask_range.u8 = UINT8_MAX;
+	rules[0].field[RTE_NODE_ACL_IP4_FIELD_DST].value.u32 = RTE_IPV4(10, 0, 0, 0);
+	rules[0].field[RTE_NODE_ACL_IP4_FIELD_DST].mask_range.u32 = 8;
+	rules[0].field[RTE_NODE_ACL_IP4_FIELD_DST_PORT].value.u16 = 53;
+	rules[0].field[RTE_NODE_ACL_IP4_FIELD_DST_PORT].mask_range.u16 = 53;
+
+	/* Anything from 192.168.0.0/16 */
+	acl_test_rule_init(&rules[1], ACL_TEST_EDGE_RULE1, 1);
+	rules[1].field[RTE_NODE_ACL_IP4_FIELD_SRC].value.u32 = RTE_IPV4(192, 168, 0, 0);
+	rules[1].field[RTE_NODE_ACL_IP4_FIELD_SRC].mask_range.u32 = 16;
+
+	if (rte_node_ip4_acl_rules_set(&conf, rules, RTE_DIM(rules)) != 0) {
+		printf("Failed to set rules\n");
+		return -1;
+	}
+
+	acl_test_xstats_get(before, RTE_DIM(before));
+	if (acl_test_walk(expected) != 0)
+		return -1;
+	acl_test_xstats_get(after, RTE_DIM(after));
+
+	if (!rte_graph_has_stats_feature())
+		return 0;
+
+	if (after[ACL_TEST_XSTAT_NO_MATCH] - before[ACL_TEST_XSTAT_NO_MATCH] != 1 ||
+	    after[ACL_TEST_XSTAT_RULE(0)] - before[ACL_TEST_XSTAT_RULE(0)] != 2 ||
+	    after[ACL_TEST_XSTAT_RULE(1)] - before[ACL_TEST_XSTAT_RULE(1)] != 1) {
+		printf("Unexpected xstats no_match %" PRIu64 " rule0 %" PRIu64
+		       " rule1 %" PRIu64 "\n",
+		       after[ACL_TEST_XSTAT_NO_MATCH] - before[ACL_TEST_XSTAT_NO_MATCH],
+		       after[ACL_TEST_XSTAT_RULE(0)] - before[ACL_TEST_XSTAT_RULE(0)],
+		       after[ACL_TEST_XSTAT_RULE(1)] - before[ACL_TEST_XSTAT_RULE(1)]);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int
+test_acl_swap(void)
+{
+	static const rte_edge_t expected[ACL_TEST_NB_PKTS] = {
+		ACL_TEST_EDGE_RULE1, ACL_TEST_EDGE_DEFAULT,
+		ACL_TEST_EDGE_DEFAULT, ACL_TEST_EDGE_RULE1,
+	};
+	struct rte_node_acl_conf conf = {
+		.socket_id = SOCKET_ID_ANY,
+		.default_next = ACL_TEST_EDGE_DEFAULT,
+		.qsbr = acl_test.qsbr,
+	};
+	struct rte_node_acl_ip4_rule rule;
+
+	/* UDP to port 53 now goes to the edge of rule 1 */
+	acl_test_rule_init(&rule, ACL_TEST_EDGE_RULE1, 1);
+	rule.field[RTE_NODE_ACL_IP4_FIELD_PROTO].value.u8 = IPPROTO_UDP;
+	rule.field[RTE_NODE_ACL_IP4_FIELD_PROTO].mask_range.u8 = UINT8_MAX;
+	rule.field[RTE_NODE_ACL_IP4_FIELD_DST_PORT].value.u16 = 53;
+	rule.field[RTE_NODE_ACL_IP4_FIELD_DST_PORT].mask_range.u16 = 53;
+
+	if (rte_node_ip4_acl_rules_set(&conf, &rule, 1) != 0) {
+		printf("Failed to replace rules\n");
+		return -1;
+	}
+
+	return acl_test_walk(expected);
+}
+
+static int
+node_acl_setup(void)
+{
+	const char *sinks[] = { ACL_TEST_RULE0, ACL_TEST_RULE1, ACL_TEST_DEFAULT };
+	const char *patterns[] = { ACL_TEST_SOURCE, "ip4_acl", ACL_TEST_RULE0, ACL_TEST_RULE1,
+				   ACL_TEST_DEFAULT };
+	struct rte_graph_param gconf = {
+		.socket_id = SOCKET_ID_ANY,
+		.nb_node_patterns = RTE_DIM(patterns),
+		.node_patterns = patterns,
+	};
+	rte_node_t id;
+	uint16_t i;
+
+	id = rte_node_from_name("ip4_acl");
+	if (id == RTE_NODE_ID_INVALID ||
+	    rte_node_edge_update(id, ACL_TEST_EDGE_RULE0, sinks, RTE_DIM(sinks)) !=
+	    RTE_DIM(sinks)) {
+		printf("Failed to add the edges of ip4_acl\n");
+		return TEST_FAILED;
+	}
+
+	acl_test.qsbr = rte_zmalloc(NULL, rte_rcu_qsbr_get_memsize(1), RTE_CACHE_LINE_SIZE);
+	if (acl_test.qsbr == NULL || rte_rcu_qsbr_init(acl_test.qsbr, 1) != 0) {
+		printf("Failed to create QSBR variable\n");
+		return TEST_FAILED;
+	}
+
+	acl_test.mp = rte_pktmbuf_pool_create("acl_test_pool", ACL_TEST_NB_MBUFS, 0, 0,
+					      RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	if (acl_test.mp == NULL) {
+		printf("Failed to create mbuf pool\n");
+		return TEST_FAILED;
+	}
+
+	for (i = 0; i < ACL_TEST_NB_PKTS; i++) {
+		acl_test.mbufs[i] = rte_pktmbuf_alloc(acl_test.mp);
+		if (acl_test.mbufs[i] == NULL ||
+		    acl_test_pkt_build(acl_test.mbufs[i], &acl_test_pkts[i]) != 0) {
+			printf("Failed to build packet %u\n", i);
+			return TEST_FAILED;
+		}
+	}
+
+	acl_test.graph_id = rte_graph_create("worker_acl_test", &gconf);
+	if (acl_test.graph_id == RTE_GRAPH_ID_INVALID) {
+		printf("Graph creation failed with error = %d\n", rte_errno);
+		return TEST_FAILED;
+	}
+
+	return TEST_SUCCESS;
+}
+
+static void
+node_acl_teardown(void)
+{
+	uint16_t i;
+
+	if (acl_test.graph_id != RTE_GRAPH_ID_INVALID)
+		rte_graph_destroy(acl_test.graph_id);
+	acl_test.graph_id = RTE_GRAPH_ID_INVALID;
+
+	for (i = 0; i < ACL_TEST_NB_PKTS; i++) {
+		rte_pktmbuf_free(acl_test.mbufs[i]);
+		acl_test.mbufs[i] = NULL;
+	}
+	rte_mempool_free(acl_test.mp);
+	acl_test.mp = NULL;
+	rte_free(acl_test.qsbr);
+	acl_test.qsbr = NULL;
+}
+
+static struct unit_test_suite node_acl_testsuite = {
+	.suite_name = "Node ACL test suite",
+	.setup = node_acl_setup,
+	.teardown = node_acl_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_acl_rules_set),
+		TEST_CASE(test_acl_default_edge),
+		TEST_CASE(test_acl_classify),
+		TEST_CASE(test_acl_swap),
+		TEST_CASES_END(), /**< NULL terminate unit test array */
+	},
+};
+
+static int
+test_node_acl(void)
+{
+	return unit_test_suite_runner(&node_acl_testsuite);
+}
+
+#endif /* !RTE_EXEC_ENV_WINDOWS */
+
+REGISTER_FAST_TEST(node_acl_autotest, true, true, test_node_acl);
@@ -0,0 +1,982 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#include "test.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_errno.h>
+
+#ifdef RTE_EXEC_ENV_WINDOWS
+static int
+test_node_esp(void)
+{
+	printf("node_esp not supported on Windows, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+#else
+
+#include <rte_bus_vdev.h>
+#include <rte_cryptodev.h>
+#include <rte_esp.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_ip.h>
+#include <rte_ipsec.h>
+#include <rte_ipsec_sad.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_node_ipsec_api.h>
+#include <rte_node_mbuf_dynfield.h>
+#include <rte_udp.h>
+
+#define ESP_TEST_GRAPH "worker_esp_test"
+#define ESP_TEST_SOURCE "esp_test_source"
+#define ESP_TEST_INBOUND "esp_test_inbound"
+#define ESP_TEST_OUTBOUND "esp_test_outbound"
+
+/* Edges of the source node */
+#define ESP_TEST_EDGE_OUTBOUND 0
+#define ESP_TEST_EDGE_INBOUND 1
+
+/* xstats of the ESP nodes */
+#define ESP_TEST_XSTAT_NO_SA 0
+#define ESP_TEST_XSTAT_ERROR 1
+
+#define ESP_TEST_NULL_DEV "crypto_null_esp_test"
+#define ESP_TEST_GCM_DEV "crypto_aesni_gcm_esp_test"
+/* The lookaside queue pairs are shared by 2 graphs at most */
+#define ESP_TEST_NB_QPS 2
+#define ESP_TEST_NB_DESC 128
+
+#define ESP_TEST_NB_MBUFS 64
+#define ESP_TEST_NB_PKTS 8
+#define ESP_TEST_PAYLOAD_LEN 32
+#define ESP_TEST_PKT_LEN (sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr) + \
+			  sizeof(struct rte_udp_hdr) + ESP_TEST_PAYLOAD_LEN)
+/* Walks completing the lookaside operations */
+#define ESP_TEST_NB_WALKS 16
+
+#define ESP_TEST_SALT 0x5a5a5a5a
+#define ESP_TEST_GCM_KEY_LEN 16
+#define ESP_TEST_GCM_IV_LEN 12
+#define ESP_TEST_GCM_DIGEST_LEN 16
+#define ESP_TEST_GCM_AAD_LEN 8
+#define ESP_TEST_IV_OFFSET (sizeof(struct rte_crypto_op) + sizeof(struct rte_crypto_sym_op))
+
+/* Pair of outbound and inbound sessions of the same SA */
+struct esp_test_sa {
+	uint32_t spi;
+	struct rte_ipsec_session out;
+	struct rte_ipsec_session in;
+};
+
+static const struct rte_ipv4_hdr esp_test_outer = {
+	.version_ihl = RTE_IPV4_VHL_DEF,
+	.time_to_live = 64,
+	.next_proto_id = IPPROTO_ESP,
+	.src_addr = RTE_BE32(RTE_IPV4(192, 168, 1, 100)),
+	.dst_addr = RTE_BE32(RTE_IPV4(192, 168, 2, 100)),
+};
+
+static const uint8_t esp_test_gcm_key[ESP_TEST_GCM_KEY_LEN] = {
+	0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+	0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08,
+};
+
+static struct {
+	struct rte_mempool *mp;
+	struct rte_mempool *cop_pool;
+	struct rte_mempool *sess_pool;
+	struct rte_ipsec_sad *sad;
+	int null_dev;
+	/* AES-GCM device with CPU crypto, -1 if none */
+	int gcm_dev;
+	int dyn;
+	/* Lookaside SAs on the null device */
+	struct esp_test_sa null_sa[2];
+	/* CPU crypto SAs on the AES-GCM device */
+	struct esp_test_sa gcm_sa[2];
+	rte_graph_t graph_id;
+	/* Packets given by the source node at the next walk */
+	struct rte_mbuf **pending;
+	uint16_t nb_pending;
+	rte_edge_t edge;
+	/* Packets reached by the sinks */
+	struct rte_mbuf *in[ESP_TEST_NB_MBUFS];
+	uint16_t nb_in;
+	struct rte_mbuf *out[ESP_TEST_NB_MBUFS];
+	uint16_t nb_out;
+} esp_test = {
+	.null_dev = -1,
+	.gcm_dev = -1,
+	.graph_id = RTE_GRAPH_ID_INVALID,
+};
+
+static uint16_t
+esp_test_source(struct rte_graph *graph, struct rte_node *node, void **objs,
+		uint16_t nb_objs)
+{
+	uint16_t n = esp_test.nb_pending;
+
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	if (n == 0)
+		return 0;
+
+	rte_node_enqueue(graph, node, esp_test.edge, (void **)esp_test.pending, n);
+	esp_test.nb_pending = 0;
+
+	return n;
+}
+
+static __rte_always_inline uint16_t
+esp_test_sink(void **objs, uint16_t nb_objs, struct rte_mbuf **sunk, uint16_t *nb_sunk)
+{
+	uint16_t i;
+
+	for (i = 0; i < nb_objs && *nb_sunk < ESP_TEST_NB_MBUFS; i++)
+		sunk[(*nb_sunk)++] = objs[i];
+
+	return nb_objs;
+}
+
+static uint16_t
+esp_test_inbound(struct rte_graph *graph, struct rte_node *node, void **objs,
+		 uint16_t nb_objs)
+{
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+
+	return esp_test_sink(objs, nb_objs, esp_test.in, &esp_test.nb_in);
+}
+
+static uint16_t
+esp_test_outbound(struct rte_graph *graph, struct rte_node *node, void **objs,
+		  uint16_t nb_objs)
+{
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+
+	return esp_test_sink(objs, nb_objs, esp_test.out, &esp_test.nb_out);
+}
+
+static struct rte_node_register esp_test_source_node = {
+	.process = esp_test_source,
+	.flags = RTE_NODE_SOURCE_F,
+	.name = ESP_TEST_SOURCE,
+	.nb_edges = 2,
+	.next_nodes = {
+		[ESP_TEST_EDGE_OUTBOUND] = "esp_outbound",
+		[ESP_TEST_EDGE_INBOUND] = "esp_inbound",
+	},
+};
+RTE_NODE_REGISTER(esp_test_source_node);
+
+static struct rte_node_register esp_test_inbound_node = {
+	.process = esp_test_inbound,
+	.name = ESP_TEST_INBOUND,
+};
+RTE_NODE_REGISTER(esp_test_inbound_node);
+
+static struct rte_node_register esp_test_outbound_node = {
+	.process = esp_test_outbound,
+	.name = ESP_TEST_OUTBOUND,
+};
+RTE_NODE_REGISTER(esp_test_outbound_node);
+
+static rte_graph_t
+esp_test_graph_create(const char *name)
+{
+	static const char *patterns[] = { ESP_TEST_SOURCE, "esp_inbound", "esp_outbound",
+					  "esp_completion", ESP_TEST_INBOUND,
+					  ESP_TEST_OUTBOUND, "pkt_drop" };
+	struct rte_graph_param gconf = {
+		.socket_id = SOCKET_ID_ANY,
+		.nb_node_patterns = RTE_DIM(patterns),
+		.node_patterns = patterns,
+	};
+
+	return rte_graph_create(name, &gconf);
+}
+
+/* Build an Ethernet packet of ESP_TEST_PKT_LEN bytes carrying UDP in IPv4 */
+static struct rte_mbuf *
+esp_test_pkt_alloc(uint8_t tag, struct rte_ipsec_session *ss)
+{
+	struct rte_ether_hdr *eth;
+	struct rte_ipv4_hdr *ip;
+	struct rte_udp_hdr *udp;
+	struct rte_mbuf *m;
+
+	m = rte_pktmbuf_alloc(esp_test.mp);
+	if (m == NULL)
+		return NULL;
+
+	eth = (struct rte_ether_hdr *)rte_pktmbuf_append(m, ESP_TEST_PKT_LEN);
+	if (eth == NULL) {
+		rte_pktmbuf_free(m);
+		return NULL;
+	}
+	memset(eth, tag, ESP_TEST_PKT_LEN);
+	eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+
+	ip = (struct rte_ipv4_hdr *)(eth + 1);
+	memset(ip, 0, sizeof(*ip) + sizeof(*udp));
+	ip->version_ihl = RTE_IPV4_VHL_DEF;
+	ip->total_length = rte_cpu_to_be_16(ESP_TEST_PKT_LEN - sizeof(*eth));
+	ip->time_to_live = 64;
+	ip->next_proto_id = IPPROTO_UDP;
+	ip->src_addr = rte_cpu_to_be_32(RTE_IPV4(10, 0, 0, 1));
+	ip->dst_addr = rte_cpu_to_be_32(RTE_IPV4(20, 0, 0, tag));
+	ip->hdr_checksum = rte_ipv4_cksum(ip);
+
+	udp = (struct rte_udp_hdr *)(ip + 1);
+	udp->src_port = rte_cpu_to_be_16(1024);
+	udp->dst_port = rte_cpu_to_be_16(4500 + tag);
+	udp->dgram_len = rte_cpu_to_be_16(sizeof(*udp) + ESP_TEST_PAYLOAD_LEN);
+
+	rte_node_mbuf_overload_fields_get(m, esp_test.dyn)->ipsec_ss = ss;
+
+	return m;
+}
+
+static void
+esp_test_pkts_free(struct rte_mbuf **pkts, uint16_t nb_pkts)
+{
+	uint16_t i;
+
+	for (i = 0; i < nb_pkts; i++) {
+		rte_pktmbuf_free(pkts[i]);
+		pkts[i] = NULL;
+	}
+}
+
+/* Send the packets to an ESP node, walk until the expected packets reach a sink */
+static int
+esp_test_run(rte_edge_t edge, struct rte_mbuf **pkts, uint16_t nb_pkts, uint16_t nb_expected)
+{
+	struct rte_graph *graph = rte_graph_lookup(ESP_TEST_GRAPH);
+	uint16_t *nb_sunk;
+	unsigned int i;
+
+	nb_sunk = edge == ESP_TEST_EDGE_INBOUND ? &esp_test.nb_in : &esp_test.nb_out;
+	esp_test.nb_in = 0;
+	esp_test.nb_out = 0;
+	esp_test.edge = edge;
+	esp_test.pending = pkts;
+	esp_test.nb_pending = nb_pkts;
+
+	for (i = 0; i < ESP_TEST_NB_WALKS && *nb_sunk < nb_expected; i++)
+		rte_graph_walk(graph);
+	/* Nothing else is expected */
+	rte_graph_walk(graph);
+
+	if (esp_test.nb_in + esp_test.nb_out != nb_expected || *nb_sunk != nb_expected) {
+		printf("%u inbound and %u outbound packets instead of %u %s\n", esp_test.nb_in,
+		       esp_test.nb_out, nb_expected,
+		       edge == ESP_TEST_EDGE_INBOUND ? "inbound" : "outbound");
+		return -1;
+	}
+
+	return 0;
+}
+
+static uint64_t
+esp_test_xstat_get(const char *name, uint16_t xstat)
+{
+	struct rte_node *node = rte_graph_node_get_by_name(ESP_TEST_GRAPH, name);
+	uint64_t *xstats = RTE_PTR_ADD(node, node->xstat_off);
+
+	return xstats[xstat];
+}
+
+static int
+esp_test_xstat_check(const char *name, uint16_t xstat, uint64_t before, uint64_t expected)
+{
+	uint64_t n;
+
+	if (!rte_graph_has_stats_feature())
+		return 0;
+
+	n = esp_test_xstat_get(name, xstat) - before;
+	if (n != expected) {
+		printf("%s xstat %u increased by %" PRIu64 " instead of %" PRIu64 "\n", name,
+		       xstat, n, expected);
+		return -1;
+	}
+
+	return 0;
+}
+
+/* All the packets and crypto operations are back in their pools */
+static int
+esp_test_pools_check(void)
+{
+	if (rte_mempool_avail_count(esp_test.mp) != ESP_TEST_NB_MBUFS) {
+		printf("%u mbufs leaked\n", rte_mempool_in_use_count(esp_test.mp));
+		return -1;
+	}
+
+	if (rte_mempool_in_use_count(esp_test.cop_pool) != 0) {
+		printf("%u crypto operations leaked\n",
+		       rte_mempool_in_use_count(esp_test.cop_pool));
+		return -1;
+	}
+
+	return 0;
+}
+
+static int
+esp_test_graph_setup(void)
+{
+	esp_test.graph_id = esp_test_graph_create(ESP_TEST_GRAPH);
+	if (esp_test.graph_id == RTE_GRAPH_ID_INVALID) {
+		printf("Graph creation failed with error = %d\n", rte_errno);
+		return -1;
+	}
+
+	return 0;
+}
+
+static void
+esp_test_graph_teardown(void)
+{
+	if (esp_test.graph_id != RTE_GRAPH_ID_INVALID)
+		rte_graph_destroy(esp_test.graph_id);
+	esp_test.graph_id = RTE_GRAPH_ID_INVALID;
+}
+
+/* Check an ESP packet sent by esp_outbound */
+static int
+esp_test_outbound_check(struct rte_mbuf *m, const struct esp_test_sa *sa,
+			const uint8_t *plain)
+{
+	struct rte_ipv4_hdr *ip;
+	struct rte_esp_hdr *esp;
+
+	ip = rte_pktmbuf_mtod_offset(m, struct rte_ipv4_hdr *, sizeof(struct rte_ether_hdr));
+	esp = (struct rte_esp_hdr *)(ip + 1);
+	if (rte_pktmbuf_pkt_len(m) <= ESP_TEST_PKT_LEN + sizeof(*ip) + sizeof(*esp) ||
+	    ip->next_proto_id != IPPROTO_ESP || ip->src_addr != esp_test_outer.src_addr ||
+	    ip->dst_addr != esp_test_outer.dst_addr ||
+	    esp->spi != rte_cpu_to_be_32(sa->spi)) {
+		printf("Bad ESP packet of SPI %u\n", sa->spi);
+		return -1;
+	}
+
+	/* The NULL cipher leaves the inner packet in clear */
+	if (sa == &esp_test.gcm_sa[0] || sa == &esp_test.gcm_sa[1]) {
+		if (memcmp(RTE_PTR_ADD(esp + 1, sizeof(uint64_t)),
+			   plain + sizeof(struct rte_ether_hdr),
+			   ESP_TEST_PKT_LEN - sizeof(struct rte_ether_hdr)) == 0) {
+			printf("Packet of SPI %u not encrypted\n", sa->spi);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Encrypt packets of the 2 SAs interleaved, with packets without SA or not IP,
+ * then decrypt them with ESP packets without SA or not ESP.
+ */
+static int
+esp_test_round_trip(struct esp_test_sa *sa)
+{
+	struct rte_ipsec_session *ss[ESP_TEST_NB_PKTS] = {
+		&sa[0].out, &sa[0].out, &sa[1].out, NULL, &sa[0].out, &sa[1].out, &sa[1].out,
+		&sa[0].out,
+	};
+	/* The packet 3 has no session and the last packet is ARP */
+	static const uint16_t nb_esp = ESP_TEST_NB_PKTS - 2;
+	uint8_t plain[ESP_TEST_NB_PKTS][ESP_TEST_PKT_LEN];
+	struct rte_mbuf *sent[ESP_TEST_NB_PKTS];
+	struct rte_mbuf *pkts[ESP_TEST_NB_PKTS + 2];
+	struct rte_ipv4_hdr *ip;
+	struct rte_esp_hdr *esp;
+	uint64_t no_sa;
+	uint16_t i, j;
+	int rc, ret = -1;
+
+	memset(pkts, 0, sizeof(pkts));
+	for (i = 0; i < ESP_TEST_NB_PKTS; i++) {
+		pkts[i] = esp_test_pkt_alloc(i + 1, ss[i]);
+		if (pkts[i] == NULL) {
+			printf("Failed to build packet %u\n", i);
+			goto free;
+		}
+		rte_memcpy(plain[i], rte_pktmbuf_mtod(pkts[i], void *), ESP_TEST_PKT_LEN);
+	}
+	rte_memcpy(sent, pkts, sizeof(sent));
+	rte_pktmbuf_mtod(pkts[ESP_TEST_NB_PKTS - 1], struct rte_ether_hdr *)->ether_type =
+		rte_cpu_to_be_16(RTE_ETHER_TYPE_ARP);
+	memset(rte_pktmbuf_mtod_offset(pkts[ESP_TEST_NB_PKTS - 1], void *,
+				       sizeof(struct rte_ether_hdr)), 0, sizeof(*ip));
+
+	no_sa = esp_test_xstat_get("esp_outbound", ESP_TEST_XSTAT_NO_SA);
+	rc = esp_test_run(ESP_TEST_EDGE_OUTBOUND, pkts, ESP_TEST_NB_PKTS, nb_esp);
+	/* The dropped packets are freed, the others are kept by the sink */
+	memset(pkts, 0, sizeof(pkts));
+	rte_memcpy(pkts, esp_test.out, RTE_MIN(esp_test.nb_out, nb_esp) * sizeof(pkts[0]));
+	if (rc != 0 || esp_test_xstat_check("esp_outbound", ESP_TEST_XSTAT_NO_SA, no_sa, 2) != 0)
+		goto free;
+
+	/* The packets are encrypted in place, by the SA of their session */
+	for (i = 0; i < nb_esp; i++) {
+		for (j = 0; j < ESP_TEST_NB_PKTS && sent[j] != pkts[i]; j++)
+			;
+		if (j == ESP_TEST_NB_PKTS || ss[j] == NULL) {
+			printf("Unexpected outbound packet %u\n", i);
+			goto free;
+		}
+		if (esp_test_outbound_check(pkts[i], ss[j] == &sa[0].out ? &sa[0] : &sa[1],
+					    plain[j]) != 0)
+			goto free;
+	}
+
+	/* An ESP packet of an unknown SA and a packet which is not ESP */
+	pkts[nb_esp] = esp_test_pkt_alloc(0, NULL);
+	pkts[nb_esp + 1] = esp_test_pkt_alloc(0, NULL);
+	if (pkts[nb_esp] == NULL || pkts[nb_esp + 1] == NULL) {
+		printf("Failed to build inbound packets\n");
+		goto free;
+	}
+	ip = rte_pktmbuf_mtod_offset(pkts[nb_esp], struct rte_ipv4_hdr *,
+				     sizeof(struct rte_ether_hdr));
+	ip->next_proto_id = IPPROTO_ESP;
+	esp = (struct rte_esp_hdr *)(ip + 1);
+	esp->spi = rte_cpu_to_be_32(0xbad);
+
+	no_sa = esp_test_xstat_get("esp_inbound", ESP_TEST_XSTAT_NO_SA);
+	rc = esp_test_run(ESP_TEST_EDGE_INBOUND, pkts, nb_esp + 2, nb_esp);
+	memset(pkts, 0, sizeof(pkts));
+	rte_memcpy(pkts, esp_test.in, RTE_MIN(esp_test.nb_in, nb_esp) * sizeof(pkts[0]));
+	if (rc != 0 || esp_test_xstat_check("esp_inbound", ESP_TEST_XSTAT_NO_SA, no_sa, 2) != 0)
+		goto free;
+
+	/* The inner packets are back, after the room of the Ethernet header */
+	for (i = 0; i < nb_esp; i++) {
+		ip = rte_pktmbuf_mtod_offset(pkts[i], struct rte_ipv4_hdr *,
+					     sizeof(struct rte_ether_hdr));
+		/* The last byte of the destination address is the packet tag */
+		j = (rte_be_to_cpu_32(ip->dst_addr) & 0xff) - 1;
+		if (j >= ESP_TEST_NB_PKTS || ss[j] == NULL ||
+		    rte_pktmbuf_pkt_len(pkts[i]) != ESP_TEST_PKT_LEN ||
+		    memcmp(ip, plain[j] + sizeof(struct rte_ether_hdr),
+			   ESP_TEST_PKT_LEN - sizeof(struct rte_ether_hdr)) != 0) {
+			printf("Decrypted packet %u differs from the original\n", i);
+			goto free;
+		}
+	}
+	ret = 0;
+
+free:
+	esp_test_pkts_free(pkts, RTE_DIM(pkts));
+	if (ret == 0)
+		ret = esp_test_pools_check();
+
+	return ret;
+}
+
+static int
+test_esp_configure(void)
+{
+	struct rte_node_ipsec_cfg cfg = {
+		.dev_id = esp_test.null_dev,
+		.cop_pool = esp_test.cop_pool,
+		.sad_ip4 = esp_test.sad,
+		.inbound_next_node = ESP_TEST_INBOUND,
+		.outbound_next_node = ESP_TEST_OUTBOUND,
+	};
+	int rc;
+
+	if (rte_node_ipsec_configure(NULL) != -EINVAL) {
+		printf("NULL configuration accepted\n");
+		return -1;
+	}
+
+	cfg.outbound_next_node = NULL;
+	if (rte_node_ipsec_configure(&cfg) != -EINVAL) {
+		printf("Configuration without outbound next node accepted\n");
+		return -1;
+	}
+	cfg.outbound_next_node = ESP_TEST_OUTBOUND;
+
+	cfg.dev_id = RTE_CRYPTO_MAX_DEVS - 1;
+	if (rte_cryptodev_is_valid_dev(cfg.dev_id) == 0 &&
+	    rte_node_ipsec_configure(&cfg) != -EINVAL) {
+		printf("Lookaside configuration with an invalid cryptodev accepted\n");
+		return -1;
+	}
+	cfg.dev_id = esp_test.null_dev;
+
+	/* The queue pairs cannot be replaced while a graph uses them */
+	if (esp_test_graph_setup() != 0)
+		return -1;
+	rc = rte_node_ipsec_configure(&cfg);
+	esp_test_graph_teardown();
+	if (rc != -EBUSY) {
+		printf("Configuration with a graph using a queue pair returned %d\n", rc);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int
+test_esp_lookaside(void)
+{
+	int ret;
+
+	if (esp_test_graph_setup() != 0)
+		return -1;
+
+	ret = esp_test_round_trip(esp_test.null_sa);
+	esp_test_graph_teardown();
+
+	return ret;
+}
+
+static int
+test_esp_cpu_crypto(void)
+{
+	int ret;
+
+	if (esp_test.gcm_dev < 0) {
+		printf("No AES-GCM device with CPU crypto, skipping test\n");
+		return TEST_SKIPPED;
+	}
+
+	if (esp_test_graph_setup() != 0)
+		return -1;
+
+	ret = esp_test_round_trip(esp_test.gcm_sa);
+	esp_test_graph_teardown();
+
+	return ret;
+}
+
+static int
+test_esp_qp_share(void)
+{
+	rte_graph_t ids[ESP_TEST_NB_QPS + 1];
+	char name[RTE_GRAPH_NAMESIZE];
+	uint16_t i;
+	int ret = -1;
+
+	for (i = 0; i < RTE_DIM(ids); i++)
+		ids[i] = RTE_GRAPH_ID_INVALID;
+
+	/* The 3 ESP nodes of a graph share its queue pair */
+	for (i = 0; i < ESP_TEST_NB_QPS; i++) {
+		snprintf(name, sizeof(name), "worker_esp_qp%u", i);
+		ids[i] = esp_test_graph_create(name);
+		if (ids[i] == RTE_GRAPH_ID_INVALID) {
+			printf("Graph %u creation failed with error = %d\n", i, rte_errno);
+			goto destroy;
+		}
+	}
+
+	snprintf(name, sizeof(name), "worker_esp_qp%u", i);
+	ids[i] = esp_test_graph_create(name);
+	if (ids[i] != RTE_GRAPH_ID_INVALID) {
+		printf("Graph created without free queue pair\n");
+		goto destroy;
+	}
+
+	/* The queue pair of a destroyed graph is free again */
+	rte_graph_destroy(ids[0]);
+	ids[0] = RTE_GRAPH_ID_INVALID;
+	ids[i] = esp_test_graph_create(name);
+	if (ids[i] == RTE_GRAPH_ID_INVALID) {
+		printf("Graph creation failed after freeing a queue pair\n");
+		goto destroy;
+	}
+	ret = 0;
+
+destroy:
+	for (i = 0; i < RTE_DIM(ids); i++)
+		if (ids[i] != RTE_GRAPH_ID_INVALID)
+			rte_graph_destroy(ids[i]);
+
+	return ret;
+}
+
+static int
+test_esp_mcore_dispatch(void)
+{
+	struct rte_graph_param gconf = {
+		.socket_id = SOCKET_ID_ANY,
+	};
+	rte_graph_t id;
+
+	if (esp_test_graph_setup() != 0)
+		return -1;
+
+	/* The clones of a mcore-dispatch graph cannot use the lookaside sessions */
+	rte_graph_worker_model_set(RTE_GRAPH_MODEL_MCORE_DISPATCH);
+	id = rte_graph_clone(esp_test.graph_id, "mcd", &gconf);
+	rte_graph_worker_model_set(RTE_GRAPH_MODEL_RTC);
+	if (id != RTE_GRAPH_ID_INVALID) {
+		printf("mcore-dispatch graph created with a lookaside queue pair\n");
+		rte_graph_destroy(id);
+		goto fail;
+	}
+
+	id = rte_graph_clone(esp_test.graph_id, "rtc", &gconf);
+	if (id == RTE_GRAPH_ID_INVALID) {
+		printf("Graph clone failed with error = %d\n", rte_errno);
+		goto fail;
+	}
+	rte_graph_destroy(id);
+	esp_test_graph_teardown();
+
+	return 0;
+
+fail:
+	esp_test_graph_teardown();
+	return -1;
+}
+
+static int
+test_esp_drain(void)
+{
+	struct rte_mbuf *pkts[ESP_TEST_NB_PKTS];
+	uint16_t i;
+
+	if (esp_test_graph_setup() != 0)
+		return -1;
+
+	for (i = 0; i < ESP_TEST_NB_PKTS; i++) {
+		pkts[i] = esp_test_pkt_alloc(i + 1, &esp_test.null_sa[i % 2].out);
+		if (pkts[i] == NULL) {
+			printf("Failed to build packet %u\n", i);
+			esp_test_pkts_free(pkts, i);
+			goto fail;
+		}
+	}
+
+	/* A single walk enqueues the packets, completed on the next walk */
+	if (esp_test_run(ESP_TEST_EDGE_OUTBOUND, pkts, ESP_TEST_NB_PKTS, 0) != 0)
+		goto fail;
+	if (rte_mempool_in_use_count(esp_test.cop_pool) != ESP_TEST_NB_PKTS) {
+		printf("%u crypto operations in flight instead of %u\n",
+		       rte_mempool_in_use_count(esp_test.cop_pool), ESP_TEST_NB_PKTS);
+		goto fail;
+	}
+
+	/* The in-flight packets are freed with the graph */
+	esp_test_graph_teardown();
+
+	return esp_test_pools_check();
+
+fail:
+	esp_test_graph_teardown();
+	return -1;
+}
+
+static int
+esp_test_session_create(struct rte_ipsec_session *ss, uint32_t spi,
+			enum rte_security_ipsec_sa_direction dir,
+			enum rte_security_session_action_type type, uint8_t dev_id)
+{
+	struct rte_crypto_sym_xform xf[2], *first;
+	struct rte_ipsec_sa_prm prm;
+	int sz;
+
+	memset(xf, 0, sizeof(xf));
+	if (type == RTE_SECURITY_ACTION_TYPE_CPU_CRYPTO) {
+		xf[0].type = RTE_CRYPTO_SYM_XFORM_AEAD;
+		xf[0].aead.op = dir == RTE_SECURITY_IPSEC_SA_DIR_EGRESS ?
+			RTE_CRYPTO_AEAD_OP_ENCRYPT : RTE_CRYPTO_AEAD_OP_DECRYPT;
+		xf[0].aead.algo = RTE_CRYPTO_AEAD_AES_GCM;
+		xf[0].aead.key.data = esp_test_gcm_key;
+		xf[0].aead.key.length = sizeof(esp_test_gcm_key);
+		xf[0].aead.iv.offset = ESP_TEST_IV_OFFSET;
+		xf[0].aead.iv.length = ESP_TEST_GCM_IV_LEN;
+		xf[0].aead.digest_length = ESP_TEST_GCM_DIGEST_LEN;
+		xf[0].aead.aad_length = ESP_TEST_GCM_AAD_LEN;
+		first = &xf[0];
+	} else {
+		/* NULL cipher and authentication, authenticated before decryption */
+		xf[0].type = RTE_CRYPTO_SYM_XFORM_CIPHER;
+		xf[0].cipher.algo = RTE_CRYPTO_CIPHER_NULL;
+		xf[1].type = RTE_CRYPTO_SYM_XFORM_AUTH;
+		xf[1].auth.algo = RTE_CRYPTO_AUTH_NULL;
+		if (dir == RTE_SECURITY_IPSEC_SA_DIR_EGRESS) {
+			xf[0].cipher.op = RTE_CRYPTO_CIPHER_OP_ENCRYPT;
+			xf[1].auth.op = RTE_CRYPTO_AUTH_OP_GENERATE;
+			xf[0].next = &xf[1];
+			first = &xf[0];
+		} else {
+			xf[0].cipher.op = RTE_CRYPTO_CIPHER_OP_DECRYPT;
+			xf[1].auth.op = RTE_CRYPTO_AUTH_OP_VERIFY;
+			xf[1].next = &xf[0];
+			first = &xf[1];
+		}
+	}
+
+	memset(&prm, 0, sizeof(prm));
+	prm.ipsec_xform.spi = spi;
+	prm.ipsec_xform.salt = ESP_TEST_SALT;
+	prm.ipsec_xform.direction = dir;
+	prm.ipsec_xform.proto = RTE_SECURITY_IPSEC_SA_PROTO_ESP;
+	prm.ipsec_xform.mode = RTE_SECURITY_IPSEC_SA_MODE_TUNNEL;
+	prm.ipsec_xform.tunnel.type = RTE_SECURITY_IPSEC_TUNNEL_IPV4;
+	prm.tun.hdr_len = sizeof(esp_test_outer);
+	prm.tun.next_proto = IPPROTO_IPIP;
+	prm.tun.hdr = &esp_test_outer;
+	prm.crypto_xform = first;
+
+	sz = rte_ipsec_sa_size(&prm);
+	if (sz < 0)
+		return sz;
+
+	ss->sa = rte_zmalloc(NULL, sz, RTE_CACHE_LINE_SIZE);
+	if (ss->sa == NULL)
+		return -ENOMEM;
+
+	sz = rte_ipsec_sa_init(ss->sa, &prm, sz);
+	if (sz < 0)
+		return sz;
+
+	ss->type = type;
+	ss->crypto.dev_id = dev_id;
+	ss->crypto.ses = rte_cryptodev_sym_session_create(dev_id, first, esp_test.sess_pool);
+	if (ss->crypto.ses == NULL)
+		return -rte_errno;
+
+	return rte_ipsec_session_prepare(ss);
+}
+
+static void
+esp_test_session_free(struct rte_ipsec_session *ss)
+{
+	if (ss->crypto.ses != NULL)
+		rte_cryptodev_sym_session_free(ss->crypto.dev_id, ss->crypto.ses);
+	rte_free(ss->sa);
+	memset(ss, 0, sizeof(*ss));
+}
+
+/* Create the sessions of a SA, and add its inbound session to the SAD */
+static int
+esp_test_sa_create(struct esp_test_sa *sa, uint32_t spi,
+		   enum rte_security_session_action_type type, uint8_t dev_id, int sad_type)
+{
+	union rte_ipsec_sad_key key = {
+		.v4 = {
+			.spi = rte_cpu_to_be_32(spi),
+			.dip = esp_test_outer.dst_addr,
+			.sip = esp_test_outer.src_addr,
+		},
+	};
+
+	sa->spi = spi;
+	if (esp_test_session_create(&sa->out, spi, RTE_SECURITY_IPSEC_SA_DIR_EGRESS, type,
+				    dev_id) != 0 ||
+	    esp_test_session_create(&sa->in, spi, RTE_SECURITY_IPSEC_SA_DIR_INGRESS, type,
+				    dev_id) != 0) {
+		printf("Failed to create the sessions of SPI %u\n", spi);
+		return -1;
+	}
+
+	if (rte_ipsec_sad_add(esp_test.sad, &key, sad_type, &sa->in) != 0) {
+		printf("Failed to add SPI %u to the SAD\n", spi);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int
+esp_test_cryptodev_start(uint8_t dev_id)
+{
+	struct rte_cryptodev_config conf = {
+		.socket_id = SOCKET_ID_ANY,
+		.nb_queue_pairs = ESP_TEST_NB_QPS,
+		.ff_disable = RTE_CRYPTODEV_FF_ASYMMETRIC_CRYPTO,
+	};
+	struct rte_cryptodev_qp_conf qp_conf = {
+		.nb_descriptors = ESP_TEST_NB_DESC,
+		.mp_session = esp_test.sess_pool,
+	};
+	uint16_t i;
+
+	if (rte_cryptodev_configure(dev_id, &conf) != 0)
+		return -1;
+
+	for (i = 0; i < ESP_TEST_NB_QPS; i++)
+		if (rte_cryptodev_queue_pair_setup(dev_id, i, &qp_conf, SOCKET_ID_ANY) != 0)
+			return -1;
+
+	return rte_cryptodev_start(dev_id);
+}
+
+static int
+node_esp_setup(void)
+{
+	struct rte_ipsec_sad_conf sad_conf = {
+		.socket_id = SOCKET_ID_ANY,
+		.max_sa = {
+			[RTE_IPSEC_SAD_SPI_ONLY] = RTE_DIM(esp_test.gcm_sa),
+			[RTE_IPSEC_SAD_SPI_DIP_SIP] = RTE_DIM(esp_test.null_sa),
+		},
+	};
+	struct rte_node_ipsec_cfg cfg = {
+		.inbound_next_node = ESP_TEST_INBOUND,
+		.outbound_next_node = ESP_TEST_OUTBOUND,
+	};
+	struct rte_cryptodev_info info;
+	uint32_t sess_sz;
+	uint16_t i;
+
+	esp_test.dyn = rte_node_mbuf_dynfield_register();
+	if (esp_test.dyn < 0) {
+		printf("Failed to register the node mbuf dynfield\n");
+		return TEST_FAILED;
+	}
+
+	if (rte_vdev_init(ESP_TEST_NULL_DEV, NULL) != 0) {
+		printf("Failed to create vdev '%s', skipping tests\n", ESP_TEST_NULL_DEV);
+		return TEST_SKIPPED;
+	}
+	esp_test.null_dev = rte_cryptodev_get_dev_id(ESP_TEST_NULL_DEV);
+	sess_sz = rte_cryptodev_sym_get_private_session_size(esp_test.null_dev);
+
+	/* The CPU crypto test is skipped without AES-GCM device */
+	if (rte_vdev_init(ESP_TEST_GCM_DEV, NULL) == 0) {
+		esp_test.gcm_dev = rte_cryptodev_get_dev_id(ESP_TEST_GCM_DEV);
+		rte_cryptodev_info_get(esp_test.gcm_dev, &info);
+		if (!(info.feature_flags & RTE_CRYPTODEV_FF_SYM_CPU_CRYPTO)) {
+			rte_vdev_uninit(ESP_TEST_GCM_DEV);
+			esp_test.gcm_dev = -1;
+		} else {
+			sess_sz = RTE_MAX(sess_sz, rte_cryptodev_sym_get_private_session_size(
+						   esp_test.gcm_dev));
+		}
+	}
+
+	esp_test.sess_pool = rte_cryptodev_sym_session_pool_create("esp_test_sess_pool",
+			2 * (RTE_DIM(esp_test.null_sa) + RTE_DIM(esp_test.gcm_sa)), sess_sz, 0, 0,
+			SOCKET_ID_ANY);
+	if (esp_test.sess_pool == NULL) {
+		printf("Failed to create session pool\n");
+		return TEST_FAILED;
+	}
+
+	if (esp_test_cryptodev_start(esp_test.null_dev) != 0 ||
+	    (esp_test.gcm_dev >= 0 && esp_test_cryptodev_start(esp_test.gcm_dev) != 0)) {
+		printf("Failed to start the cryptodevs\n");
+		return TEST_FAILED;
+	}
+
+	/* No cache, the pools are checked for leaks */
+	esp_test.mp = rte_pktmbuf_pool_create("esp_test_pool", ESP_TEST_NB_MBUFS, 0, 0,
+					      RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	esp_test.cop_pool = rte_crypto_op_pool_create("esp_test_cop_pool",
+						      RTE_CRYPTO_OP_TYPE_SYMMETRIC,
+						      ESP_TEST_NB_MBUFS, 0, 0, SOCKET_ID_ANY);
+	if (esp_test.mp == NULL || esp_test.cop_pool == NULL) {
+		printf("Failed to create mbuf and crypto operation pools\n");
+		return TEST_FAILED;
+	}
+
+	esp_test.sad = rte_ipsec_sad_create("esp_test_sad", &sad_conf);
+	if (esp_test.sad == NULL) {
+		printf("Failed to create SAD\n");
+		return TEST_FAILED;
+	}
+
+	/* Lookaside SAs looked up with the outer addresses, CPU crypto SAs by SPI only */
+	for (i = 0; i < RTE_DIM(esp_test.null_sa); i++)
+		if (esp_test_sa_create(&esp_test.null_sa[i], 100 + i,
+				       RTE_SECURITY_ACTION_TYPE_NONE, esp_test.null_dev,
+				       RTE_IPSEC_SAD_SPI_DIP_SIP) != 0)
+			return TEST_FAILED;
+
+	for (i = 0; esp_test.gcm_dev >= 0 && i < RTE_DIM(esp_test.gcm_sa); i++)
+		if (esp_test_sa_create(&esp_test.gcm_sa[i], 200 + i,
+				       RTE_SECURITY_ACTION_TYPE_CPU_CRYPTO, esp_test.gcm_dev,
+				       RTE_IPSEC_SAD_SPI_ONLY) != 0)
+			return TEST_FAILED;
+
+	cfg.dev_id = esp_test.null_dev;
+	cfg.cop_pool = esp_test.cop_pool;
+	cfg.sad_ip4 = esp_test.sad;
+	if (rte_node_ipsec_configure(&cfg) != 0) {
+		printf("Failed to configure the ESP nodes\n");
+		return TEST_FAILED;
+	}
+
+	return TEST_SUCCESS;
+}
+
+static void
+node_esp_teardown(void)
+{
+	uint16_t i;
+
+	esp_test_graph_teardown();
+
+	for (i = 0; i < RTE_DIM(esp_test.null_sa); i++) {
+		esp_test_session_free(&esp_test.null_sa[i].out);
+		esp_test_session_free(&esp_test.null_sa[i].in);
+	}
+	for (i = 0; i < RTE_DIM(esp_test.gcm_sa); i++) {
+		esp_test_session_free(&esp_test.gcm_sa[i].out);
+		esp_test_session_free(&esp_test.gcm_sa[i].in);
+	}
+	rte_ipsec_sad_destroy(esp_test.sad);
+	esp_test.sad = NULL;
+
+	if (esp_test.gcm_dev >= 0) {
+		rte_cryptodev_stop(esp_test.gcm_dev);
+		rte_vdev_uninit(ESP_TEST_GCM_DEV);
+	}
+	esp_test.gcm_dev = -1;
+	if (esp_test.null_dev >= 0) {
+		rte_cryptodev_stop(esp_test.null_dev);
+		rte_vdev_uninit(ESP_TEST_NULL_DEV);
+	}
+	esp_test.null_dev = -1;
+
+	rte_mempool_free(esp_test.sess_pool);
+	esp_test.sess_pool = NULL;
+	rte_mempool_free(esp_test.cop_pool);
+	esp_test.cop_pool = NULL;
+	rte_mempool_free(esp_test.mp);
+	esp_test.mp = NULL;
+}
+
+static struct unit_test_suite node_esp_testsuite = {
+	.suite_name = "Node ESP test suite",
+	.setup = node_esp_setup,
+	.teardown = node_esp_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_esp_configure),
+		TEST_CASE(test_esp_lookaside),
+		TEST_CASE(test_esp_cpu_crypto),
+		TEST_CASE(test_esp_qp_share),
+		TEST_CASE(test_esp_mcore_dispatch),
+		TEST_CASE(test_esp_drain),
+		TEST_CASES_END(), /**< NULL terminate unit test array */
+	},
+};
+
+static int
+test_node_esp(void)
+{
+	return unit_test_suite_runner(&node_esp_testsuite);
+}
+
+#endif /* !RTE_EXEC_ENV_WINDOWS */
+
+REGISTER_FAST_TEST(node_esp_autotest, true, true, test_node_esp);
@@ -0,0 +1,764 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#include "test.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_errno.h>
+
+#ifdef RTE_EXEC_ENV_WINDOWS
+static int
+test_node_ip_frag(void)
+{
+	printf("node_ip_frag not supported on Windows, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+#else
+
+#include <rte_bus_vdev.h>
+#include <rte_ethdev.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_icmp.h>
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+#include <rte_node_eth_api.h>
+#include <rte_node_ip4_api.h>
+#include <rte_node_ip6_api.h>
+#include <rte_node_mbuf_dynfield.h>
+
+#define FRAG_TEST_SOURCE "frag_test_source"
+#define FRAG_TEST_TX "frag_test_tx"
+#define FRAG_TEST_LOOKUP "frag_test_lookup"
+
+/* Edges of the source node */
+#define FRAG_TEST_EDGE_IP4 0
+#define FRAG_TEST_EDGE_IP6 1
+
+#define FRAG_TEST_MTU 1280
+#define FRAG_TEST_PAYLOAD 3000
+#define FRAG_TEST_TTL 64
+#define FRAG_TEST_NH 0
+#define FRAG_TEST_PKT_ID 0x1234
+
+/* Payload of the fragments but the last one */
+#define FRAG_TEST_IP4_FRAG_LEN \
+	RTE_ALIGN_FLOOR(FRAG_TEST_MTU - sizeof(struct rte_ipv4_hdr), RTE_IPV4_HDR_OFFSET_UNITS)
+#define FRAG_TEST_IP6_FRAG_LEN                                                            \
+	RTE_ALIGN_FLOOR(FRAG_TEST_MTU - sizeof(struct rte_ipv6_hdr) - RTE_IPV6_FRAG_HDR_SIZE, \
+			RTE_IPV6_EHDR_FO_ALIGN)
+
+#define FRAG_TEST_MAX_OUT 8
+#define FRAG_TEST_NB_WALKS 4
+#define FRAG_TEST_NB_MBUFS 64
+#define FRAG_TEST_BUF_SIZE (RTE_PKTMBUF_HEADROOM + 4096)
+
+/* Version, traffic class and flow label of the IPv6 packets */
+#define FRAG_TEST_IP6_VTC_FLOW 0x60000000
+
+/* ICMPv6 Packet Too Big message type (RFC 4443) */
+#define FRAG_TEST_ICMP6_PKT_TOO_BIG 2
+
+static const char frag_test_dev[] = "net_null_frag_test";
+
+static const struct rte_ether_addr frag_test_dst_mac = {
+	.addr_bytes = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 },
+};
+
+static const uint32_t frag_test_ip4_src = RTE_IPV4(10, 0, 0, 1);
+static const uint32_t frag_test_ip4_dst = RTE_IPV4(10, 0, 1, 1);
+static const uint32_t frag_test_ip4_icmp_src = RTE_IPV4(10, 0, 1, 254);
+static const struct rte_ipv6_addr frag_test_ip6_src = RTE_IPV6(0x2001, 0xdb8, 0, 0, 0, 0, 0, 1);
+static const struct rte_ipv6_addr frag_test_ip6_dst = RTE_IPV6(0x2001, 0xdb8, 0, 1, 0, 0, 0, 1);
+static const struct rte_ipv6_addr frag_test_ip6_icmp_src =
+	RTE_IPV6(0x2001, 0xdb8, 0, 1, 0, 0, 0, 0xfe);
+
+static struct {
+	struct rte_mempool *mp;
+	struct rte_mempool *mp_indirect;
+	rte_graph_t graph_id;
+	uint16_t port_id;
+	int dyn;
+	/* Packet given by the source node at the next walk */
+	struct rte_mbuf *pending;
+	rte_edge_t pending_edge;
+	/* Packets reaching the Tx and lookup sinks */
+	struct rte_mbuf *tx[FRAG_TEST_MAX_OUT];
+	uint16_t nb_tx;
+	struct rte_mbuf *lookup[FRAG_TEST_MAX_OUT];
+	uint16_t nb_lookup;
+} frag_test = {
+	.graph_id = RTE_GRAPH_ID_INVALID,
+};
+
+static uint16_t
+frag_test_source(struct rte_graph *graph, struct rte_node *node, void **objs,
+		 uint16_t nb_objs)
+{
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	if (frag_test.pending == NULL)
+		return 0;
+
+	rte_node_enqueue_x1(graph, node, frag_test.pending_edge, frag_test.pending);
+	frag_test.pending = NULL;
+
+	return 1;
+}
+
+static __rte_always_inline uint16_t
+frag_test_sink(void **objs, uint16_t nb_objs, struct rte_mbuf **out, uint16_t *nb_out)
+{
+	uint16_t i;
+
+	/* The extra packets are freed, the count tells about them */
+	for (i = 0; i < nb_objs; i++) {
+		if (*nb_out < FRAG_TEST_MAX_OUT)
+			out[*nb_out] = objs[i];
+		else
+			rte_pktmbuf_free(objs[i]);
+		(*nb_out)++;
+	}
+
+	return nb_objs;
+}
+
+static uint16_t
+frag_test_tx(struct rte_graph *graph, struct rte_node *node, void **objs, uint16_t nb_objs)
+{
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+
+	return frag_test_sink(objs, nb_objs, frag_test.tx, &frag_test.nb_tx);
+}
+
+static uint16_t
+frag_test_lookup(struct rte_graph *graph, struct rte_node *node, void **objs,
+		 uint16_t nb_objs)
+{
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+
+	return frag_test_sink(objs, nb_objs, frag_test.lookup, &frag_test.nb_lookup);
+}
+
+static struct rte_node_register frag_test_source_node = {
+	.process = frag_test_source,
+	.flags = RTE_NODE_SOURCE_F,
+	.name = FRAG_TEST_SOURCE,
+	.nb_edges = 2,
+	.next_nodes = {
+		[FRAG_TEST_EDGE_IP4] = "ip4_rewrite",
+		[FRAG_TEST_EDGE_IP6] = "ip6_rewrite",
+	},
+};
+RTE_NODE_REGISTER(frag_test_source_node);
+
+static struct rte_node_register frag_test_tx_node = {
+	.process = frag_test_tx,
+	.name = FRAG_TEST_TX,
+};
+RTE_NODE_REGISTER(frag_test_tx_node);
+
+static struct rte_node_register frag_test_lookup_node = {
+	.process = frag_test_lookup,
+	.name = FRAG_TEST_LOOKUP,
+};
+RTE_NODE_REGISTER(frag_test_lookup_node);
+
+static uint8_t
+frag_test_payload_byte(uint32_t off)
+{
+	return (uint8_t)(off * 7);
+}
+
+static int
+frag_test_payload_check(const struct rte_mbuf *m, uint32_t hdr_len, uint32_t off,
+			uint32_t len)
+{
+	uint8_t buf[FRAG_TEST_MTU];
+	const uint8_t *data;
+	uint32_t i;
+
+	if (len > sizeof(buf))
+		return -1;
+
+	data = rte_pktmbuf_read(m, hdr_len, len, buf);
+	if (data == NULL)
+		return -1;
+
+	for (i = 0; i < len; i++)
+		if (data[i] != frag_test_payload_byte(off + i))
+			return -1;
+
+	return 0;
+}
+
+static struct rte_mbuf *
+frag_test_pkt_alloc(uint32_t hdr_len)
+{
+	struct rte_mbuf *m;
+	uint8_t *data;
+	uint32_t i;
+
+	m = rte_pktmbuf_alloc(frag_test.mp);
+	if (m == NULL)
+		return NULL;
+
+	data = (uint8_t *)rte_pktmbuf_append(m, hdr_len + FRAG_TEST_PAYLOAD);
+	if (data == NULL) {
+		rte_pktmbuf_free(m);
+		return NULL;
+	}
+	memset(data, 0, hdr_len);
+	for (i = 0; i < FRAG_TEST_PAYLOAD; i++)
+		data[hdr_len + i] = frag_test_payload_byte(i);
+
+	return m;
+}
+
+/* Oversized IPv4 packet as ip4_lookup gives it to ip4_rewrite */
+static struct rte_mbuf *
+frag_test_ip4_pkt(bool df)
+{
+	const uint32_t hdr_len = sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv4_hdr);
+	rte_node_mbuf_overload_fields_t *priv;
+	struct rte_ipv4_hdr *ip;
+	struct rte_mbuf *m;
+
+	m = frag_test_pkt_alloc(hdr_len);
+	if (m == NULL)
+		return NULL;
+
+	ip = rte_pktmbuf_mtod_offset(m, struct rte_ipv4_hdr *, sizeof(struct rte_ether_hdr));
+	ip->version_ihl = RTE_IPV4_VHL_DEF;
+	ip->total_length = rte_cpu_to_be_16(sizeof(*ip) + FRAG_TEST_PAYLOAD);
+	ip->packet_id = rte_cpu_to_be_16(FRAG_TEST_PKT_ID);
+	ip->fragment_offset = df ? rte_cpu_to_be_16(RTE_IPV4_HDR_DF_FLAG) : 0;
+	ip->time_to_live = FRAG_TEST_TTL;
+	ip->next_proto_id = IPPROTO_UDP;
+	ip->src_addr = rte_cpu_to_be_32(frag_test_ip4_src);
+	ip->dst_addr = rte_cpu_to_be_32(frag_test_ip4_dst);
+	ip->hdr_checksum = rte_ipv4_cksum(ip);
+
+	priv = rte_node_mbuf_overload_fields_get(m, frag_test.dyn);
+	priv->nh = FRAG_TEST_NH;
+	priv->ttl = ip->time_to_live;
+	priv->cksum = ip->hdr_checksum;
+
+	return m;
+}
+
+/* Oversized IPv6 packet as ip6_lookup gives it to ip6_rewrite */
+static struct rte_mbuf *
+frag_test_ip6_pkt(bool forwarded)
+{
+	const uint32_t hdr_len = sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv6_hdr);
+	rte_node_mbuf_overload_fields_t *priv;
+	struct rte_ipv6_hdr *ip;
+	struct rte_mbuf *m;
+
+	m = frag_test_pkt_alloc(hdr_len);
+	if (m == NULL)
+		return NULL;
+
+	/* Only the packets of the local host are fragmented */
+	m->port = forwarded ? frag_test.port_id : RTE_MBUF_PORT_INVALID;
+
+	ip = rte_pktmbuf_mtod_offset(m, struct rte_ipv6_hdr *, sizeof(struct rte_ether_hdr));
+	ip->vtc_flow = rte_cpu_to_be_32(FRAG_TEST_IP6_VTC_FLOW);
+	ip->payload_len = rte_cpu_to_be_16(FRAG_TEST_PAYLOAD);
+	ip->proto = IPPROTO_UDP;
+	ip->hop_limits = FRAG_TEST_TTL;
+	ip->src_addr = frag_test_ip6_src;
+	ip->dst_addr = frag_test_ip6_dst;
+
+	priv = rte_node_mbuf_overload_fields_get(m, frag_test.dyn);
+	priv->nh = FRAG_TEST_NH;
+	priv->ttl = ip->hop_limits;
+
+	return m;
+}
+
+static void
+frag_test_out_free(void)
+{
+	rte_pktmbuf_free_bulk(frag_test.tx, RTE_MIN(frag_test.nb_tx, FRAG_TEST_MAX_OUT));
+	frag_test.nb_tx = 0;
+	rte_pktmbuf_free_bulk(frag_test.lookup, RTE_MIN(frag_test.nb_lookup, FRAG_TEST_MAX_OUT));
+	frag_test.nb_lookup = 0;
+}
+
+/* Send a packet through the graph, the outputs are in the sinks */
+static int
+frag_test_run(struct rte_mbuf *m, rte_edge_t edge, uint16_t nb_tx, uint16_t nb_lookup)
+{
+	struct rte_graph *graph = rte_graph_lookup("worker_frag_test");
+	int i;
+
+	if (m == NULL) {
+		printf("Failed to build packet\n");
+		return -1;
+	}
+
+	frag_test.pending = m;
+	frag_test.pending_edge = edge;
+	for (i = 0; i < FRAG_TEST_NB_WALKS; i++)
+		rte_graph_walk(graph);
+
+	if (frag_test.nb_tx != nb_tx || frag_test.nb_lookup != nb_lookup) {
+		printf("Got %u packets to Tx and %u to lookup, expected %u and %u\n",
+		       frag_test.nb_tx, frag_test.nb_lookup, nb_tx, nb_lookup);
+		return -1;
+	}
+
+	return 0;
+}
+
+/* Every buffer is back once the outputs are freed */
+static int
+frag_test_pools_check(void)
+{
+	frag_test_out_free();
+
+	if (rte_mempool_full(frag_test.mp) == 0 || rte_mempool_full(frag_test.mp_indirect) == 0) {
+		printf("Leaked %u direct and %u indirect buffers\n",
+		       rte_mempool_in_use_count(frag_test.mp),
+		       rte_mempool_in_use_count(frag_test.mp_indirect));
+		return -1;
+	}
+
+	return 0;
+}
+
+static int
+frag_test_ether_check(const struct rte_mbuf *m, uint16_t ether_type)
+{
+	const struct rte_ether_hdr *eth = rte_pktmbuf_mtod(m, const struct rte_ether_hdr *);
+
+	if (!rte_is_same_ether_addr(&eth->dst_addr, &frag_test_dst_mac) ||
+	    eth->ether_type != rte_cpu_to_be_16(ether_type)) {
+		printf("Ethernet header not rewritten\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int
+test_ip4_fragment(void)
+{
+	const uint16_t nb_frags = RTE_ALIGN_CEIL(FRAG_TEST_PAYLOAD, FRAG_TEST_IP4_FRAG_LEN) /
+				  FRAG_TEST_IP4_FRAG_LEN;
+	uint32_t off = 0, len;
+	struct rte_ipv4_hdr *ip;
+	struct rte_mbuf *m;
+	uint16_t i, frag;
+	int ret = -1;
+
+	if (frag_test_run(frag_test_ip4_pkt(false), FRAG_TEST_EDGE_IP4, nb_frags, 0) != 0)
+		goto exit;
+
+	for (i = 0; i < nb_frags; i++) {
+		m = frag_test.tx[i];
+		ip = rte_pktmbuf_mtod_offset(m, struct rte_ipv4_hdr *,
+					     sizeof(struct rte_ether_hdr));
+		len = rte_be_to_cpu_16(ip->total_length) - sizeof(*ip);
+		frag = rte_be_to_cpu_16(ip->fragment_offset);
+
+		if (rte_pktmbuf_pkt_len(m) > FRAG_TEST_MTU + sizeof(struct rte_ether_hdr) ||
+		    rte_pktmbuf_pkt_len(m) != sizeof(struct rte_ether_hdr) + sizeof(*ip) + len) {
+			printf("Fragment %u of %u bytes, IP length %u\n", i,
+			       rte_pktmbuf_pkt_len(m), len);
+			goto exit;
+		}
+		if ((frag & RTE_IPV4_HDR_OFFSET_MASK) * RTE_IPV4_HDR_OFFSET_UNITS != off ||
+		    !(frag & RTE_IPV4_HDR_MF_FLAG) != (i == nb_frags - 1) ||
+		    (i != nb_frags - 1 && len != FRAG_TEST_IP4_FRAG_LEN)) {
+			printf("Fragment %u at offset %u of %u bytes, flags 0x%x\n", i,
+			       (frag & RTE_IPV4_HDR_OFFSET_MASK) * RTE_IPV4_HDR_OFFSET_UNITS,
+			       len, frag & ~RTE_IPV4_HDR_OFFSET_MASK);
+			goto exit;
+		}
+
+		/* Decremented once, with a valid checksum */
+		if (ip->time_to_live != FRAG_TEST_TTL - 1 ||
+		    rte_raw_cksum(ip, rte_ipv4_hdr_len(ip)) != UINT16_MAX) {
+			printf("Fragment %u with TTL %u, checksum 0x%x\n", i, ip->time_to_live,
+			       rte_be_to_cpu_16(ip->hdr_checksum));
+			goto exit;
+		}
+		if (ip->packet_id != rte_cpu_to_be_16(FRAG_TEST_PKT_ID) ||
+		    ip->src_addr != rte_cpu_to_be_32(frag_test_ip4_src) ||
+		    ip->dst_addr != rte_cpu_to_be_32(frag_test_ip4_dst)) {
+			printf("Fragment %u header not copied\n", i);
+			goto exit;
+		}
+		if (frag_test_payload_check(m, sizeof(struct rte_ether_hdr) + sizeof(*ip), off,
+					    len) != 0) {
+			printf("Fragment %u payload mismatch\n", i);
+			goto exit;
+		}
+		if (frag_test_ether_check(m, RTE_ETHER_TYPE_IPV4) != 0)
+			goto exit;
+		off += len;
+	}
+
+	if (off != FRAG_TEST_PAYLOAD) {
+		printf("Fragments carry %u bytes of %u\n", off, FRAG_TEST_PAYLOAD);
+		goto exit;
+	}
+	ret = 0;
+
+exit:
+	if (frag_test_pools_check() != 0)
+		ret = -1;
+
+	return ret;
+}
+
+static int
+test_ip4_frag_needed(void)
+{
+	const uint32_t quote = sizeof(struct rte_ipv4_hdr) + 8;
+	const struct rte_ipv4_hdr *orig;
+	struct rte_icmp_hdr *icmp;
+	struct rte_ipv4_hdr *ip;
+	struct rte_mbuf *m;
+	int ret = -1;
+
+	/* The packet with DF is dropped, the source gets the MTU */
+	if (frag_test_run(frag_test_ip4_pkt(true), FRAG_TEST_EDGE_IP4, 0, 1) != 0)
+		goto exit;
+
+	m = frag_test.lookup[0];
+	ip = rte_pktmbuf_mtod_offset(m, struct rte_ipv4_hdr *, sizeof(struct rte_ether_hdr));
+	icmp = (struct rte_icmp_hdr *)(ip + 1);
+	orig = (const struct rte_ipv4_hdr *)(icmp + 1);
+
+	if (rte_pktmbuf_pkt_len(m) !=
+	    sizeof(struct rte_ether_hdr) + sizeof(*ip) + sizeof(*icmp) + quote ||
+	    rte_be_to_cpu_16(ip->total_length) != sizeof(*ip) + sizeof(*icmp) + quote) {
+		printf("ICMP error of %u bytes\n", rte_pktmbuf_pkt_len(m));
+		goto exit;
+	}
+	if (ip->next_proto_id != IPPROTO_ICMP || ip->time_to_live == 0 ||
+	    ip->src_addr != rte_cpu_to_be_32(frag_test_ip4_icmp_src) ||
+	    ip->dst_addr != rte_cpu_to_be_32(frag_test_ip4_src) ||
+	    rte_raw_cksum(ip, rte_ipv4_hdr_len(ip)) != UINT16_MAX) {
+		printf("Invalid IP header of the ICMP error\n");
+		goto exit;
+	}
+	if (icmp->icmp_type != RTE_ICMP_TYPE_DEST_UNREACHABLE ||
+	    icmp->icmp_code != RTE_ICMP_CODE_UNREACH_FRAG ||
+	    rte_be_to_cpu_16(icmp->icmp_seq_nb) != FRAG_TEST_MTU ||
+	    rte_raw_cksum(icmp, sizeof(*icmp) + quote) != UINT16_MAX) {
+		printf("ICMP type %u code %u MTU %u\n", icmp->icmp_type, icmp->icmp_code,
+		       rte_be_to_cpu_16(icmp->icmp_seq_nb));
+		goto exit;
+	}
+	if (orig->packet_id != rte_cpu_to_be_16(FRAG_TEST_PKT_ID) ||
+	    orig->src_addr != rte_cpu_to_be_32(frag_test_ip4_src) ||
+	    orig->dst_addr != rte_cpu_to_be_32(frag_test_ip4_dst)) {
+		printf("ICMP error does not quote the packet\n");
+		goto exit;
+	}
+	ret = 0;
+
+exit:
+	if (frag_test_pools_check() != 0)
+		ret = -1;
+
+	return ret;
+}
+
+static int
+test_ip6_fragment(void)
+{
+	const uint16_t nb_frags = RTE_ALIGN_CEIL(FRAG_TEST_PAYLOAD, FRAG_TEST_IP6_FRAG_LEN) /
+				  FRAG_TEST_IP6_FRAG_LEN;
+	const uint32_t hdr_len = sizeof(struct rte_ether_hdr) + sizeof(struct rte_ipv6_hdr) +
+				 RTE_IPV6_FRAG_HDR_SIZE;
+	struct rte_ipv6_fragment_ext *fh;
+	uint32_t off = 0, len, id = 0;
+	struct rte_ipv6_hdr *ip;
+	struct rte_mbuf *m;
+	uint16_t i, frag;
+	int ret = -1;
+
+	if (frag_test_run(frag_test_ip6_pkt(false), FRAG_TEST_EDGE_IP6, nb_frags, 0) != 0)
+		goto exit;
+
+	for (i = 0; i < nb_frags; i++) {
+		m = frag_test.tx[i];
+		ip = rte_pktmbuf_mtod_offset(m, struct rte_ipv6_hdr *,
+					     sizeof(struct rte_ether_hdr));
+		fh = (struct rte_ipv6_fragment_ext *)(ip + 1);
+		len = rte_be_to_cpu_16(ip->payload_len) - RTE_IPV6_FRAG_HDR_SIZE;
+		frag = rte_be_to_cpu_16(fh->frag_data);
+
+		if (rte_pktmbuf_pkt_len(m) > FRAG_TEST_MTU + sizeof(struct rte_ether_hdr) ||
+		    rte_pktmbuf_pkt_len(m) != hdr_len + len) {
+			printf("Fragment %u of %u bytes, IP payload %u\n", i,
+			       rte_pktmbuf_pkt_len(m), len);
+			goto exit;
+		}
+		if (ip->proto != IPPROTO_FRAGMENT || fh->next_header != IPPROTO_UDP ||
+		    RTE_IPV6_GET_FO(frag) * RTE_IPV6_EHDR_FO_ALIGN != off ||
+		    !RTE_IPV6_GET_MF(frag) != (i == nb_frags - 1) ||
+		    (i != nb_frags - 1 && len != FRAG_TEST_IP6_FRAG_LEN)) {
+			printf("Fragment %u at offset %u of %u bytes, more %u\n", i,
+			       RTE_IPV6_GET_FO(frag) * RTE_IPV6_EHDR_FO_ALIGN, len,
+			       RTE_IPV6_GET_MF(frag));
+			goto exit;
+		}
+		if (i == 0)
+			id = fh->id;
+		if (fh->id != id || ip->hop_limits != FRAG_TEST_TTL - 1 ||
+		    !rte_ipv6_addr_eq(&ip->src_addr, &frag_test_ip6_src) ||
+		    !rte_ipv6_addr_eq(&ip->dst_addr, &frag_test_ip6_dst)) {
+			printf("Fragment %u with hop limit %u, header not copied\n", i,
+			       ip->hop_limits);
+			goto exit;
+		}
+		if (frag_test_payload_check(m, hdr_len, off, len) != 0) {
+			printf("Fragment %u payload mismatch\n", i);
+			goto exit;
+		}
+		if (frag_test_ether_check(m, RTE_ETHER_TYPE_IPV6) != 0)
+			goto exit;
+		off += len;
+	}
+
+	if (off != FRAG_TEST_PAYLOAD) {
+		printf("Fragments carry %u bytes of %u\n", off, FRAG_TEST_PAYLOAD);
+		goto exit;
+	}
+	ret = 0;
+
+exit:
+	if (frag_test_pools_check() != 0)
+		ret = -1;
+
+	return ret;
+}
+
+static int
+test_ip6_pkt_too_big(void)
+{
+	const uint32_t quote = RTE_IPV6_MIN_MTU - sizeof(struct rte_ipv6_hdr) -
+			       sizeof(struct rte_icmp_hdr);
+	const struct rte_ipv6_hdr *orig;
+	struct rte_icmp_hdr *icmp;
+	struct rte_ipv6_hdr *ip;
+	struct rte_mbuf *m;
+	int ret = -1;
+
+	/* Routers do not fragment, the source gets the MTU */
+	if (frag_test_run(frag_test_ip6_pkt(true), FRAG_TEST_EDGE_IP6, 0, 1) != 0)
+		goto exit;
+
+	m = frag_test.lookup[0];
+	ip = rte_pktmbuf_mtod_offset(m, struct rte_ipv6_hdr *, sizeof(struct rte_ether_hdr));
+	icmp = (struct rte_icmp_hdr *)(ip + 1);
+	orig = (const struct rte_ipv6_hdr *)(icmp + 1);
+
+	if (rte_pktmbuf_pkt_len(m) !=
+	    sizeof(struct rte_ether_hdr) + sizeof(*ip) + sizeof(*icmp) + quote ||
+	    rte_be_to_cpu_16(ip->payload_len) != sizeof(*icmp) + quote) {
+		printf("ICMPv6 error of %u bytes\n", rte_pktmbuf_pkt_len(m));
+		goto exit;
+	}
+	if (ip->proto != IPPROTO_ICMPV6 || ip->hop_limits == 0 ||
+	    !rte_ipv6_addr_eq(&ip->src_addr, &frag_test_ip6_icmp_src) ||
+	    !rte_ipv6_addr_eq(&ip->dst_addr, &frag_test_ip6_src)) {
+		printf("Invalid IP header of the ICMPv6 error\n");
+		goto exit;
+	}
+	if (icmp->icmp_type != FRAG_TEST_ICMP6_PKT_TOO_BIG || icmp->icmp_code != 0 ||
+	    icmp->icmp_ident != 0 || rte_be_to_cpu_16(icmp->icmp_seq_nb) != FRAG_TEST_MTU ||
+	    rte_ipv6_udptcp_cksum_verify(ip, icmp) != 0) {
+		printf("ICMPv6 type %u code %u MTU %u\n", icmp->icmp_type, icmp->icmp_code,
+		       rte_be_to_cpu_16(icmp->icmp_seq_nb));
+		goto exit;
+	}
+	if (!rte_ipv6_addr_eq(&orig->src_addr, &frag_test_ip6_src) ||
+	    !rte_ipv6_addr_eq(&orig->dst_addr, &frag_test_ip6_dst)) {
+		printf("ICMPv6 error does not quote the packet\n");
+		goto exit;
+	}
+	ret = 0;
+
+exit:
+	if (frag_test_pools_check() != 0)
+		ret = -1;
+
+	return ret;
+}
+
+/* Replace an edge of a node of the library by a sink */
+static int
+frag_test_edge_set(const char *name, rte_edge_t edge, const char *sink)
+{
+	rte_node_t id = rte_node_from_name(name);
+
+	if (id == RTE_NODE_ID_INVALID || rte_node_edge_update(id, edge, &sink, 1) != 1) {
+		printf("Failed to set edge %u of %s\n", edge, name);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int
+node_ip_frag_setup(void)
+{
+	const char *patterns[] = { FRAG_TEST_SOURCE, "ip4_rewrite", "ip4_fragment",
+				   "ip6_rewrite", "ip6_fragment", FRAG_TEST_TX,
+				   FRAG_TEST_LOOKUP, "pkt_drop" };
+	struct rte_graph_param gconf = {
+		.socket_id = SOCKET_ID_ANY,
+		.nb_node_patterns = RTE_DIM(patterns),
+		.node_patterns = patterns,
+	};
+	struct rte_eth_conf conf = {
+		.rxmode.mtu = FRAG_TEST_MTU,
+	};
+	struct rte_node_ethdev_config eth = { 0 };
+	struct rte_node_ip4_fragment_cfg ip4 = { 0 };
+	struct rte_node_ip6_fragment_cfg ip6 = { 0 };
+	struct rte_ether_hdr rewrite = {
+		.dst_addr = frag_test_dst_mac,
+	};
+	rte_node_t id;
+
+	if (rte_vdev_init(frag_test_dev, NULL) != 0 ||
+	    rte_eth_dev_get_port_by_name(frag_test_dev, &frag_test.port_id) != 0) {
+		printf("Failed to create vdev '%s'\n", frag_test_dev);
+		return TEST_SKIPPED;
+	}
+
+	/* The next hops take the MTU of their port */
+	if (rte_eth_dev_configure(frag_test.port_id, 1, 1, &conf) != 0) {
+		printf("Failed to configure port %u\n", frag_test.port_id);
+		return TEST_FAILED;
+	}
+
+	frag_test.dyn = rte_node_mbuf_dynfield_register();
+	if (frag_test.dyn < 0) {
+		printf("Failed to register mbuf dynfield\n");
+		return TEST_FAILED;
+	}
+
+	frag_test.mp = rte_pktmbuf_pool_create("frag_test_pool", FRAG_TEST_NB_MBUFS, 0, 0,
+					       FRAG_TEST_BUF_SIZE, SOCKET_ID_ANY);
+	frag_test.mp_indirect = rte_pktmbuf_pool_create("frag_test_indirect",
+							FRAG_TEST_NB_MBUFS, 0, 0, 0,
+							SOCKET_ID_ANY);
+	if (frag_test.mp == NULL || frag_test.mp_indirect == NULL) {
+		printf("Failed to create mbuf pools\n");
+		return TEST_FAILED;
+	}
+
+	/* Create the Tx node of the port, then use a sink in place of it */
+	eth.port_id = frag_test.port_id;
+	eth.num_tx_queues = 1;
+	id = rte_node_from_name("ip4_rewrite");
+	if (id == RTE_NODE_ID_INVALID || rte_node_eth_config(&eth, 1, 1) != 0 ||
+	    frag_test_edge_set("ip4_rewrite", rte_node_edge_count(id) - 1, FRAG_TEST_TX) != 0)
+		return TEST_FAILED;
+	id = rte_node_from_name("ip6_rewrite");
+	if (id == RTE_NODE_ID_INVALID ||
+	    frag_test_edge_set("ip6_rewrite", rte_node_edge_count(id) - 1, FRAG_TEST_TX) != 0)
+		return TEST_FAILED;
+
+	/* The ICMP errors go to the lookup of their destination */
+	if (frag_test_edge_set("ip4_fragment", RTE_NODE_IP4_FRAGMENT_NEXT_LOOKUP,
+			       FRAG_TEST_LOOKUP) != 0 ||
+	    frag_test_edge_set("ip6_fragment", RTE_NODE_IP6_FRAGMENT_NEXT_LOOKUP,
+			       FRAG_TEST_LOOKUP) != 0)
+		return TEST_FAILED;
+
+	rewrite.ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+	if (rte_node_ip4_rewrite_add(FRAG_TEST_NH, (uint8_t *)&rewrite, sizeof(rewrite),
+				     frag_test.port_id) != 0) {
+		printf("Failed to add IPv4 next hop\n");
+		return TEST_FAILED;
+	}
+	rewrite.ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6);
+	if (rte_node_ip6_rewrite_add(FRAG_TEST_NH, (uint8_t *)&rewrite, sizeof(rewrite),
+				     frag_test.port_id) != 0) {
+		printf("Failed to add IPv6 next hop\n");
+		return TEST_FAILED;
+	}
+
+	/* Before the graph creation, for the rewrite nodes to use the fragment nodes */
+	ip4.pool_direct = frag_test.mp;
+	ip4.pool_indirect = frag_test.mp_indirect;
+	ip4.node_id = rte_node_from_name("ip4_fragment");
+	ip4.icmp_src = frag_test_ip4_icmp_src;
+	ip6.pool_direct = frag_test.mp;
+	ip6.pool_indirect = frag_test.mp_indirect;
+	ip6.node_id = rte_node_from_name("ip6_fragment");
+	ip6.icmp_src = frag_test_ip6_icmp_src;
+	if (rte_node_ip4_fragment_configure(&ip4, 1) != 0 ||
+	    rte_node_ip6_fragment_configure(&ip6, 1) != 0) {
+		printf("Failed to configure the fragment nodes\n");
+		return TEST_FAILED;
+	}
+
+	frag_test.graph_id = rte_graph_create("worker_frag_test", &gconf);
+	if (frag_test.graph_id == RTE_GRAPH_ID_INVALID) {
+		printf("Graph creation failed with error = %d\n", rte_errno);
+		return TEST_FAILED;
+	}
+
+	return TEST_SUCCESS;
+}
+
+static void
+node_ip_frag_teardown(void)
+{
+	if (frag_test.graph_id != RTE_GRAPH_ID_INVALID)
+		rte_graph_destroy(frag_test.graph_id);
+	frag_test.graph_id = RTE_GRAPH_ID_INVALID;
+
+	frag_test_out_free();
+	rte_pktmbuf_free(frag_test.pending);
+	frag_test.pending = NULL;
+	rte_mempool_free(frag_test.mp);
+	frag_test.mp = NULL;
+	rte_mempool_free(frag_test.mp_indirect);
+	frag_test.mp_indirect = NULL;
+	rte_vdev_uninit(frag_test_dev);
+}
+
+static struct unit_test_suite node_ip_frag_testsuite = {
+	.suite_name = "Node IP fragmentation test suite",
+	.setup = node_ip_frag_setup,
+	.teardown = node_ip_frag_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_ip4_fragment),
+		TEST_CASE(test_ip4_frag_needed),
+		TEST_CASE(test_ip6_fragment),
+		TEST_CASE(test_ip6_pkt_too_big),
+		TEST_CASES_END(), /**< NULL terminate unit test array */
+	},
+};
+
+static int
+test_node_ip_frag(void)
+{
+	return unit_test_suite_runner(&node_ip_frag_testsuite);
+}
+
+#endif /* !RTE_EXEC_ENV_WINDOWS */
+
+REGISTER_FAST_TEST(node_ip_frag_autotest, true, true, test_node_ip_frag);
@@ -8,6 +8,7 @@
 #include <rte_ring.h>
 #include <rte_cycles.h>
 #include <rte_launch.h>
+#include <rte_mbuf.h>
 #include <rte_ethdev.h>
 #include <rte_eth_ring.h>
 #include <rte_bus_vdev.h>
@@ -133,6 +134,76 @@ test_bulk_enqueue_dequeue(void)
 	}
 }
 
+/* Times Tx + Rx bursts on ring ports created with each statistics mode */
+static int
+test_stats_modes(void)
+{
+	static const char * const modes[] = { "atomic", "lcore", "none" };
+	const unsigned int iter_shift = 23;
+	const unsigned int iterations = 1 << iter_shift;
+	struct rte_mbuf *burst[MAX_BURST] = {0};
+	struct rte_eth_conf conf = {0};
+	char name[RTE_ETH_NAME_MAX_LEN];
+	struct rte_mempool *mp;
+	char args[32];
+	uint16_t port;
+	unsigned int m, i;
+	int ret = 0;
+
+	/* Rx writes the input port in the mbufs, they must be valid */
+	mp = rte_pktmbuf_pool_create("RING_PERF_POOL", 2 * MAX_BURST, 0, 0,
+			RTE_MBUF_DEFAULT_BUF_SIZE, rte_socket_id());
+	if (mp == NULL || rte_pktmbuf_alloc_bulk(mp, burst, MAX_BURST) != 0) {
+		rte_mempool_free(mp);
+		return -1;
+	}
+
+	for (m = 0; m < RTE_DIM(modes); m++) {
+		snprintf(name, sizeof(name), "net_ring_perf_%s", modes[m]);
+		snprintf(args, sizeof(args), "stats=%s", modes[m]);
+		if (rte_vdev_init(name, args) != 0 ||
+				rte_eth_dev_get_port_by_name(name, &port) != 0) {
+			printf("Cannot create %s\n", name);
+			ret = -1;
+			break;
+		}
+
+		/* without start, the bursts would hit the dummy fast path ops */
+		if (rte_eth_dev_configure(port, 1, 1, &conf) < 0 ||
+				rte_eth_rx_queue_setup(port, 0, RING_SIZE,
+					rte_socket_id(), NULL, mp) < 0 ||
+				rte_eth_tx_queue_setup(port, 0, RING_SIZE,
+					rte_socket_id(), NULL) < 0 ||
+				rte_eth_dev_start(port) < 0) {
+			printf("Cannot start %s\n", name);
+			rte_vdev_uninit(name);
+			ret = -1;
+			break;
+		}
+
+		const uint64_t eth_start = rte_rdtsc_precise();
+		rte_compiler_barrier();
+		for (i = 0; i < iterations; i++) {
+			rte_eth_tx_burst(port, 0, burst, MAX_BURST);
+			rte_eth_rx_burst(port, 0, burst, MAX_BURST);
+		}
+		const uint64_t eth_end = rte_rdtsc_precise();
+		rte_compiler_barrier();
+
+		printf("ethdev bulk enq/deq (size: %u, stats: %s): %.1F\n",
+				MAX_BURST, modes[m],
+				(double)(eth_end - eth_start) /
+				(iterations * MAX_BURST));
+
+		rte_eth_dev_stop(port);
+		rte_vdev_uninit(name);
+	}
+
+	rte_pktmbuf_free_bulk(burst, MAX_BURST);
+	rte_mempool_free(mp);
+	return ret;
+}
+
 static int
 test_ring_pmd_perf(void)
 {
@@ -154,6 +225,10 @@ test_ring_pmd_perf(void)
 	printf("\n### Testing using a single lcore ###\n");
 	test_bulk_enqueue_dequeue();
 
+	printf("\n### Testing statistics modes ###\n");
+	if (test_stats_modes() != 0)
+		return -1;
+
 	/* release port and ring resources */
 	if (rte_eth_dev_stop(ring_ethdev_port) != 0)
 		return -1;
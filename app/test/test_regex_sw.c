@@ -0,0 +1,489 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rte_bus_vdev.h>
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_random.h>
+#include <rte_regexdev.h>
+
+#include "test.h"
+
+#define REGEX_SW_NB_DEVS	3
+#define REGEX_SW_NB_GROUPS	4
+#define REGEX_SW_MAX_MATCHES	16
+#define REGEX_SW_NB_MBUFS	64
+#define REGEX_SW_NB_DESC	8
+#define REGEX_SW_MAX_LEN	1500
+#define REGEX_SW_NB_RANDOM	512
+
+/*
+ * Devices scanning with the same rules:
+ * default, scalar literal prefilter, and DFA small enough
+ * for the scan to run mostly in NFA fallback mode.
+ */
+static const char * const regex_sw_vdevs[REGEX_SW_NB_DEVS] = {
+	"regex_sw_test0",
+	"regex_sw_test1,prefilter_simd=0",
+	"regex_sw_test2,dfa_max_states=2",
+};
+
+static const char * const regex_sw_names[REGEX_SW_NB_DEVS] = {
+	"regex_sw_test0",
+	"regex_sw_test1",
+	"regex_sw_test2",
+};
+
+/*
+ * Groups 0 and 2 have a literal in every rule, so they are prefiltered,
+ * group 1 has a rule without literal.
+ */
+static const char regex_sw_rules[] =
+	"1,0,/hello/\n"
+	"2,0,/wor[lk]d/\n"
+	"3,0,/ab+c/\n"
+	"10,1,/^GET/\n"
+	"11,1,/x\\d{3}y/i\n"
+	"12,1,/[0-9]{4}/\n"
+	"20,2,/needle/\n"
+	"21,2,/hay[0-9]+stack/\n"
+	"22,2,/q\\d\\dz/\n";
+
+/* literals injected in random payloads */
+static const char * const regex_sw_literals[] = {
+	"hello", "world", "abbc", "needle", "hay42stack", "q12z",
+};
+
+/* random payload bytes, none of them starting a literal of groups 0 or 2 */
+static const char regex_sw_alphabet[] = "cdefgijklmoprtuvxyz0123456789 .";
+
+static struct {
+	uint8_t dev_id[REGEX_SW_NB_DEVS];
+	struct rte_mempool *pool;
+	struct rte_regex_ops *op[REGEX_SW_NB_DEVS];
+} regex_sw;
+
+static int
+regex_sw_dev_setup(uint8_t dev_id)
+{
+	struct rte_regexdev_config cfg = {
+		.nb_max_matches = REGEX_SW_MAX_MATCHES,
+		.nb_queue_pairs = 1,
+		.nb_rules_per_group = 16,
+		.nb_groups = REGEX_SW_NB_GROUPS,
+		.rule_db = regex_sw_rules,
+		.rule_db_len = sizeof(regex_sw_rules) - 1,
+	};
+	struct rte_regexdev_qp_conf qp_conf = {
+		.nb_desc = REGEX_SW_NB_DESC,
+	};
+
+	rte_regexdev_stop(dev_id);
+	TEST_ASSERT_SUCCESS(rte_regexdev_configure(dev_id, &cfg),
+		"Cannot configure regex device %u", dev_id);
+	TEST_ASSERT_SUCCESS(rte_regexdev_queue_pair_setup(dev_id, 0, &qp_conf),
+		"Cannot set up queue pair of regex device %u", dev_id);
+	TEST_ASSERT_SUCCESS(rte_regexdev_start(dev_id),
+		"Cannot start regex device %u", dev_id);
+	return TEST_SUCCESS;
+}
+
+static int
+ut_setup(void)
+{
+	uint32_t i;
+
+	for (i = 0; i != REGEX_SW_NB_DEVS; i++)
+		if (regex_sw_dev_setup(regex_sw.dev_id[i]) != TEST_SUCCESS)
+			return TEST_FAILED;
+	return TEST_SUCCESS;
+}
+
+static void
+ut_teardown(void)
+{
+	uint32_t i;
+
+	for (i = 0; i != REGEX_SW_NB_DEVS; i++)
+		rte_regexdev_stop(regex_sw.dev_id[i]);
+}
+
+static void
+testsuite_teardown(void)
+{
+	int dev_id;
+	uint32_t i;
+
+	for (i = 0; i != REGEX_SW_NB_DEVS; i++) {
+		rte_free(regex_sw.op[i]);
+		regex_sw.op[i] = NULL;
+		dev_id = rte_regexdev_get_dev_id(regex_sw_names[i]);
+		if (dev_id >= 0)
+			rte_regexdev_close(dev_id);
+		rte_vdev_uninit(regex_sw_names[i]);
+	}
+	rte_mempool_free(regex_sw.pool);
+	regex_sw.pool = NULL;
+}
+
+static int
+testsuite_setup(void)
+{
+	const char *name, *args;
+	char vdev[64];
+	int dev_id;
+	uint32_t i;
+
+	for (i = 0; i != REGEX_SW_NB_DEVS; i++) {
+		strlcpy(vdev, regex_sw_vdevs[i], sizeof(vdev));
+		name = strtok(vdev, ",");
+		args = strtok(NULL, "");
+		if (rte_vdev_init(name, args) != 0) {
+			printf("Cannot create %s, skipping\n", name);
+			testsuite_teardown();
+			return TEST_SKIPPED;
+		}
+		dev_id = rte_regexdev_get_dev_id(name);
+		if (dev_id < 0)
+			goto error;
+		regex_sw.dev_id[i] = dev_id;
+
+		regex_sw.op[i] = rte_zmalloc(NULL, sizeof(*regex_sw.op[i]) +
+			REGEX_SW_MAX_MATCHES * sizeof(regex_sw.op[i]->matches[0]),
+			0);
+		if (regex_sw.op[i] == NULL)
+			goto error;
+	}
+
+	regex_sw.pool = rte_pktmbuf_pool_create("regex_sw_test_pool",
+		REGEX_SW_NB_MBUFS, 0, 0, RTE_MBUF_DEFAULT_BUF_SIZE,
+		SOCKET_ID_ANY);
+	if (regex_sw.pool == NULL)
+		goto error;
+	return TEST_SUCCESS;
+
+error:
+	testsuite_teardown();
+	return TEST_FAILED;
+}
+
+/*
+ * Scan data, split in segments at the cuts offsets,
+ * for the groups of the groups mask.
+ */
+static int
+regex_sw_scan(uint32_t dev, const char *data, uint32_t len,
+		const uint32_t *cuts, uint32_t nb_cuts, uint32_t groups,
+		uint16_t req_flags)
+{
+	struct rte_regex_ops *op = regex_sw.op[dev];
+	struct rte_mbuf *head, *m;
+	uint32_t i, k, ofs, end;
+	uint16_t gid[4] = { 0 };
+	char *p;
+
+	head = NULL;
+	for (i = 0, ofs = 0; i <= nb_cuts; i++, ofs = end) {
+		end = i == nb_cuts ? len : cuts[i];
+		m = rte_pktmbuf_alloc(regex_sw.pool);
+		TEST_ASSERT_NOT_NULL(m, "Cannot allocate mbuf");
+		p = rte_pktmbuf_append(m, end - ofs);
+		TEST_ASSERT_NOT_NULL(p, "Cannot append %u bytes", end - ofs);
+		memcpy(p, data + ofs, end - ofs);
+		if (head == NULL)
+			head = m;
+		else
+			TEST_ASSERT_SUCCESS(rte_pktmbuf_chain(head, m),
+				"Cannot chain mbufs");
+	}
+
+	memset(op, 0, sizeof(*op));
+	op->mbuf = head;
+	op->req_flags = req_flags;
+	for (k = 0, i = 0; i != REGEX_SW_NB_GROUPS && k != RTE_DIM(gid); i++) {
+		if (!(groups & (1 << i)))
+			continue;
+		op->req_flags |= RTE_REGEX_OPS_REQ_GROUP_ID0_VALID_F << k;
+		gid[k++] = i;
+	}
+	op->group_id0 = gid[0];
+	op->group_id1 = gid[1];
+	op->group_id2 = gid[2];
+	op->group_id3 = gid[3];
+
+	k = rte_regexdev_enqueue_burst(regex_sw.dev_id[dev], 0, &op, 1);
+	if (k == 1)
+		k = rte_regexdev_dequeue_burst(regex_sw.dev_id[dev], 0, &op, 1);
+	rte_pktmbuf_free(head);
+	TEST_ASSERT_EQUAL(k, 1, "Operation not processed");
+	return TEST_SUCCESS;
+}
+
+static int
+regex_sw_check_match(const struct rte_regex_ops *op, uint16_t i,
+		uint32_t rule_id, uint16_t group_id, uint16_t start, uint16_t len)
+{
+	const struct rte_regexdev_match *m = &op->matches[i];
+
+	TEST_ASSERT(i < op->nb_matches, "Match %u missing", i);
+	TEST_ASSERT(m->rule_id == rule_id && m->group_id == group_id &&
+		m->start_offset == start && m->len == len,
+		"Match %u is rule %u group %u at %u len %u, "
+		"expected rule %u group %u at %u len %u",
+		i, m->rule_id, m->group_id, m->start_offset, m->len,
+		rule_id, group_id, start, len);
+	return TEST_SUCCESS;
+}
+
+static int
+test_regex_sw_match(void)
+{
+	static const char text[] = "GET hello world, abbbc";
+	static const uint32_t cuts[] = { 6, 12, 13 };
+	const struct rte_regex_ops *op = regex_sw.op[0];
+	uint32_t nb_cuts;
+
+	/* same matches whether or not they span segments */
+	for (nb_cuts = 0; nb_cuts <= RTE_DIM(cuts); nb_cuts += RTE_DIM(cuts)) {
+		TEST_ASSERT_SUCCESS(regex_sw_scan(0, text, strlen(text), cuts,
+			nb_cuts, 0x3, 0), "Scan failed");
+		TEST_ASSERT_EQUAL(op->nb_matches, 4,
+			"Got %u matches in %u segments", op->nb_matches,
+			nb_cuts + 1);
+		TEST_ASSERT_EQUAL(op->nb_actual_matches, 4,
+			"Got %u actual matches", op->nb_actual_matches);
+		TEST_ASSERT_SUCCESS(regex_sw_check_match(op, 0, 1, 0, 4, 5),
+			"Wrong match");
+		TEST_ASSERT_SUCCESS(regex_sw_check_match(op, 1, 2, 0, 10, 5),
+			"Wrong match");
+		TEST_ASSERT_SUCCESS(regex_sw_check_match(op, 2, 3, 0, 17, 5),
+			"Wrong match");
+		TEST_ASSERT_SUCCESS(regex_sw_check_match(op, 3, 10, 1, 0, 3),
+			"Wrong match");
+	}
+
+	/* anchored rule does not match after payload start */
+	TEST_ASSERT_SUCCESS(regex_sw_scan(0, " GET", 4, NULL, 0, 0x2, 0),
+		"Scan failed");
+	TEST_ASSERT_EQUAL(op->nb_matches, 0, "Anchored rule matched");
+
+	/* caseless rule, and a match reported at each end offset */
+	TEST_ASSERT_SUCCESS(regex_sw_scan(0, "zX123Yz x456y 12345", 19,
+		NULL, 0, 0x2, 0), "Scan failed");
+	TEST_ASSERT_EQUAL(op->nb_matches, 4, "Got %u matches",
+		op->nb_matches);
+	TEST_ASSERT_SUCCESS(regex_sw_check_match(op, 0, 11, 1, 1, 5),
+		"Wrong match");
+	TEST_ASSERT_SUCCESS(regex_sw_check_match(op, 1, 11, 1, 8, 5),
+		"Wrong match");
+	TEST_ASSERT_SUCCESS(regex_sw_check_match(op, 2, 12, 1, 14, 4),
+		"Wrong match");
+	TEST_ASSERT_SUCCESS(regex_sw_check_match(op, 3, 12, 1, 15, 4),
+		"Wrong match");
+
+	/* stop on first match */
+	TEST_ASSERT_SUCCESS(regex_sw_scan(0, text, strlen(text), NULL, 0, 0x3,
+		RTE_REGEX_OPS_REQ_STOP_ON_MATCH_F), "Scan failed");
+	TEST_ASSERT_EQUAL(op->nb_matches, 1, "Got %u matches",
+		op->nb_matches);
+	TEST_ASSERT_SUCCESS(regex_sw_check_match(op, 0, 1, 0, 4, 5),
+		"Wrong match");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_regex_sw_max_matches(void)
+{
+	char text[REGEX_SW_MAX_MATCHES * 8];
+	const struct rte_regex_ops *op = regex_sw.op[0];
+	uint32_t i;
+
+	for (i = 0; i != REGEX_SW_MAX_MATCHES + 4; i++)
+		memcpy(text + i * 6, "hello ", 6);
+
+	TEST_ASSERT_SUCCESS(regex_sw_scan(0, text, i * 6, NULL, 0, 0x1, 0),
+		"Scan failed");
+	TEST_ASSERT_EQUAL(op->nb_matches, REGEX_SW_MAX_MATCHES,
+		"Got %u matches", op->nb_matches);
+	TEST_ASSERT_EQUAL(op->nb_actual_matches, REGEX_SW_MAX_MATCHES + 4,
+		"Got %u actual matches", op->nb_actual_matches);
+	TEST_ASSERT(op->rsp_flags & RTE_REGEX_OPS_RSP_MAX_MATCH_F,
+		"Max match flag not set");
+	return TEST_SUCCESS;
+}
+
+static int
+test_regex_sw_rule_update(void)
+{
+	uint8_t dev_id = regex_sw.dev_id[0];
+	struct rte_regexdev_rule rule = {
+		.op = RTE_REGEX_RULE_OP_ADD,
+		.group_id = 0,
+		.rule_id = 1,
+		.pcre_rule = "hel+o",
+		.pcre_rule_len = 5,
+	};
+	static const char dup_db[] = "1,0,/a/\n1,0,/b/\n";
+	int rc;
+
+	rte_regexdev_stop(dev_id);
+
+	/* a rule identifier is unique in its group */
+	rc = rte_regexdev_rule_db_update(dev_id, &rule, 1);
+	TEST_ASSERT(rc == 0 && rte_errno == EEXIST,
+		"Duplicate rule added: %d, %d", rc, rte_errno);
+	rule.group_id = 2;
+	rc = rte_regexdev_rule_db_update(dev_id, &rule, 1);
+	TEST_ASSERT_EQUAL(rc, 1, "Rule of another group not added");
+
+	/* a removed rule can be added again */
+	rule.op = RTE_REGEX_RULE_OP_REMOVE;
+	rc = rte_regexdev_rule_db_update(dev_id, &rule, 1);
+	TEST_ASSERT_EQUAL(rc, 1, "Rule not removed");
+	rc = rte_regexdev_rule_db_update(dev_id, &rule, 1);
+	TEST_ASSERT(rc == 0 && rte_errno == ENOENT,
+		"Missing rule removed: %d, %d", rc, rte_errno);
+	rule.op = RTE_REGEX_RULE_OP_ADD;
+	rc = rte_regexdev_rule_db_update(dev_id, &rule, 1);
+	TEST_ASSERT_EQUAL(rc, 1, "Removed rule not added again");
+
+	/* unsupported construct */
+	rule.rule_id = 30;
+	rule.pcre_rule = "a(?=b)";
+	rule.pcre_rule_len = 6;
+	rc = rte_regexdev_rule_db_update(dev_id, &rule, 1);
+	TEST_ASSERT(rc == 0 && rte_errno == ENOTSUP,
+		"Unsupported rule added: %d, %d", rc, rte_errno);
+
+	/* duplicates are rejected on import too */
+	rc = rte_regexdev_rule_db_import(dev_id, dup_db, sizeof(dup_db) - 1);
+	TEST_ASSERT_EQUAL(rc, -EEXIST, "Duplicate rules imported: %d", rc);
+
+	TEST_ASSERT_SUCCESS(rte_regexdev_rule_db_compile_activate(dev_id),
+		"Cannot activate rules");
+	TEST_ASSERT_SUCCESS(rte_regexdev_start(dev_id), "Cannot start");
+
+	TEST_ASSERT_SUCCESS(regex_sw_scan(0, "hellllo", 7, NULL, 0, 0x4, 0),
+		"Scan failed");
+	TEST_ASSERT_SUCCESS(regex_sw_check_match(regex_sw.op[0], 0, 1, 2, 0, 7),
+		"Wrong match");
+	return TEST_SUCCESS;
+}
+
+static int
+regex_sw_match_cmp(const void *a, const void *b)
+{
+	const struct rte_regexdev_match *ma = a, *mb = b;
+
+	if (ma->u64 == mb->u64)
+		return 0;
+	return ma->u64 < mb->u64 ? -1 : 1;
+}
+
+static uint64_t
+regex_sw_xstat(uint32_t dev, const char *name)
+{
+	uint64_t value = 0;
+	uint16_t id;
+
+	rte_regexdev_xstats_by_name_get(regex_sw.dev_id[dev], name, &id,
+		&value);
+	return value;
+}
+
+/*
+ * Scan random payloads with the devices using the SIMD prefilter,
+ * the scalar prefilter and the NFA fallback:
+ * they must all report the same matches.
+ */
+static int
+test_regex_sw_random(void)
+{
+	char text[REGEX_SW_MAX_LEN];
+	uint32_t cuts[3];
+	struct rte_regex_ops *op;
+	const char *lit;
+	uint32_t d, i, n, len, pos, nb_cuts;
+
+	for (n = 0; n != REGEX_SW_NB_RANDOM; n++) {
+		len = rte_rand_max(REGEX_SW_MAX_LEN) + 1;
+		for (i = 0; i != len; i++)
+			text[i] = regex_sw_alphabet[rte_rand_max(
+				sizeof(regex_sw_alphabet) - 1)];
+
+		/* a literal in half of the payloads, around block ends */
+		if (n & 1) {
+			lit = regex_sw_literals[rte_rand_max(
+				RTE_DIM(regex_sw_literals))];
+			if (strlen(lit) <= len) {
+				pos = RTE_ALIGN_FLOOR(rte_rand_max(len), 16) +
+					rte_rand_max(3) + 14;
+				pos = RTE_MIN(pos, len - (uint32_t)strlen(lit));
+				memcpy(text + pos, lit, strlen(lit));
+			}
+		}
+
+		nb_cuts = RTE_MIN(rte_rand_max(RTE_DIM(cuts) + 1), len - 1);
+		for (i = 0; i != nb_cuts; i++)
+			cuts[i] = (i + 1) * len / (nb_cuts + 1);
+
+		for (d = 0; d != REGEX_SW_NB_DEVS; d++) {
+			TEST_ASSERT_SUCCESS(regex_sw_scan(d, text, len, cuts,
+				nb_cuts, 0x5, 0), "Scan failed");
+			op = regex_sw.op[d];
+			qsort(op->matches, op->nb_matches,
+				sizeof(op->matches[0]), regex_sw_match_cmp);
+		}
+
+		for (d = 1; d != REGEX_SW_NB_DEVS; d++) {
+			TEST_ASSERT(regex_sw.op[d]->nb_matches ==
+				regex_sw.op[0]->nb_matches &&
+				regex_sw.op[d]->nb_actual_matches ==
+				regex_sw.op[0]->nb_actual_matches &&
+				memcmp(regex_sw.op[d]->matches,
+				regex_sw.op[0]->matches,
+				regex_sw.op[0]->nb_matches *
+				sizeof(regex_sw.op[0]->matches[0])) == 0,
+				"%s and %s disagree on payload of %u bytes",
+				regex_sw_names[0], regex_sw_names[d], len);
+		}
+	}
+
+	TEST_ASSERT(regex_sw_xstat(0, "prefiltered_scans") != 0,
+		"No scan was prefiltered");
+	TEST_ASSERT_EQUAL(regex_sw_xstat(0, "prefiltered_scans"),
+		regex_sw_xstat(1, "prefiltered_scans"),
+		"SIMD and scalar prefilters skipped different scans");
+	TEST_ASSERT(regex_sw_xstat(2, "nfa_bytes") != 0,
+		"No NFA fallback with a small DFA");
+	return TEST_SUCCESS;
+}
+
+static struct unit_test_suite regex_sw_testsuite = {
+	.suite_name = "Software RegEx Unit Test Suite",
+	.setup = testsuite_setup,
+	.teardown = testsuite_teardown,
+	.unit_test_cases = {
+		TEST_CASE_ST(ut_setup, ut_teardown, test_regex_sw_match),
+		TEST_CASE_ST(ut_setup, ut_teardown, test_regex_sw_max_matches),
+		TEST_CASE_ST(ut_setup, ut_teardown, test_regex_sw_rule_update),
+		TEST_CASE_ST(ut_setup, ut_teardown, test_regex_sw_random),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_regex_sw(void)
+{
+	return unit_test_suite_runner(&regex_sw_testsuite);
+}
+
+REGISTER_FAST_TEST(regex_sw_autotest, true, true, test_regex_sw);
@@ -69,6 +69,7 @@
 /* ether defines */
 #define RTE_MAX_QUEUES_PER_PORT 1024
 #define RTE_ETHDEV_RXTX_CALLBACKS 1
+/* RTE_ETHDEV_QUEUE_POLL_STATS is not set */
 #define RTE_MAX_MULTI_HOST_CTRLS 4
 
 /* cryptodev defines */
@@ -2,6 +2,7 @@
  * Copyright(c) 2017 Intel Corporation
  */
 
+#include <inttypes.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -12,6 +13,9 @@
 #include <rte_kvargs.h>
 #include <rte_cycles.h>
 #include <rte_errno.h>
+#include <rte_lcore.h>
+#include <rte_pause.h>
+#include <rte_service_component.h>
 
 #include <rte_bbdev.h>
 #include <rte_bbdev_pmd.h>
@@ -51,24 +55,92 @@ RTE_LOG_REGISTER_DEFAULT(bbdev_turbo_sw_logtype, NOTICE);
 #define DEINT_OUTPUT_BUF_SIZE (DEINT_INPUT_BUF_SIZE * 6)
 #define ADAPTER_OUTPUT_BUF_SIZE ((RTE_BBDEV_TURBO_MAX_CB_SIZE + 4) * 48)
 
+/* Code block jobs a worker takes from a queue before polling the next one */
+#define TURBO_SW_WORKER_BUDGET 8
+
+struct turbo_sw_queue;
+
+/* Helper lcore decoding code blocks */
+struct turbo_sw_worker {
+	unsigned int lcore_id;
+	bool added;  /**< The lcore was made a service lcore by the device */
+	/* Scratch buffers of the SDK functions, as in the queues */
+	struct turbo_sw_queue *scratch;
+};
+
 /* private data structure */
 struct bbdev_private {
 	unsigned int max_nb_queues;  /**< Max number of queues */
+	uint16_t nb_workers;  /**< Number of helper lcores, 0 to decode inline */
+	bool pin_workers;  /**< Each queue is served by a single worker */
+	uint32_t service_id;
+	int16_t worker_idx[RTE_MAX_LCORE];  /**< Worker index of each lcore, or -1 */
+	struct turbo_sw_worker workers[RTE_MAX_LCORE];
 };
 
 /*  Initialisation params structure that can be used by Turbo SW driver */
 struct turbo_sw_params {
 	int socket_id;  /*< Turbo SW device socket */
 	uint16_t queues_num;  /*< Turbo SW device queues number */
+	uint16_t nb_workers;  /*< Turbo SW device helper lcores number */
+	uint16_t pin_workers;  /*< Pin each queue to a single helper lcore */
+	unsigned int workers[RTE_MAX_LCORE];  /*< Turbo SW device helper lcores */
 };
 
 /* Acceptable params for Turbo SW devices */
 #define TURBO_SW_MAX_NB_QUEUES_ARG  "max_nb_queues"
 #define TURBO_SW_SOCKET_ID_ARG      "socket_id"
+#define TURBO_SW_WORKER_ARG         "worker"
+#define TURBO_SW_PIN_WORKERS_ARG    "pin_workers"
 
 static const char * const turbo_sw_valid_params[] = {
 	TURBO_SW_MAX_NB_QUEUES_ARG,
-	TURBO_SW_SOCKET_ID_ARG
+	TURBO_SW_SOCKET_ID_ARG,
+	TURBO_SW_WORKER_ARG,
+	TURBO_SW_PIN_WORKERS_ARG,
+	NULL
+};
+
+/* Decoding of one code block, or of a whole operation, by a worker */
+struct __rte_cache_aligned turbo_sw_job {
+	struct rte_bbdev_dec_op *op;
+	bool whole_op;  /**< Decode all code blocks of the operation */
+	uint8_t c;
+	bool check_crc_24b;
+	uint16_t crc24_overlap;
+	uint16_t k;  /**< Turbo code block size */
+	uint16_t kw;  /**< Turbo circular buffer size */
+	uint16_t out_length;  /**< LDPC hard output length */
+	uint32_t e;  /**< LDPC rate matched length */
+	struct rte_mbuf *m_in;
+	uint16_t in_offset;
+	uint16_t in_length;
+	uint8_t *out;
+	uint64_t enqueue_time;
+	/* Results, merged into the operation when it is dequeued */
+	int status;
+	uint8_t iter_count;
+	uint32_t hard_output_length;
+	uint64_t offload_cycles;
+	uint64_t start_time;
+	uint64_t end_time;
+	RTE_ATOMIC(uint32_t) done;
+};
+
+/* Operation decoded by workers, in enqueue order */
+struct turbo_sw_pending_op {
+	struct rte_bbdev_dec_op *op;
+	uint32_t first_job;  /**< Index of the first job */
+	uint32_t nb_jobs;
+};
+
+/* Code block statistics of the queues decoded by workers */
+struct turbo_sw_cb_stats {
+	uint64_t nb_cbs;
+	uint64_t proc_cycles;  /**< Decoding time */
+	uint64_t max_proc_cycles;
+	uint64_t latency_cycles;  /**< Time from enqueue to end of decoding */
+	uint64_t max_latency_cycles;
 };
 
 /* queue */
@@ -95,10 +167,24 @@ struct __rte_cache_aligned turbo_sw_queue {
 	uint8_t *adapter_output;
 	/* Operation type of this queue */
 	enum rte_bbdev_op_type type;
+	/* Code blocks waiting for a worker, NULL when decoding inline */
+	struct rte_ring *cb_jobs;
+	/* Jobs, contiguous for each operation */
+	struct turbo_sw_job *jobs;
+	uint32_t jobs_mask;
+	uint32_t jobs_head;  /* Written by the enqueue thread */
+	RTE_ATOMIC(uint32_t) jobs_tail;  /* Written by the dequeue thread */
+	/* Operations decoded by workers, in enqueue order */
+	struct turbo_sw_pending_op *pending;
+	uint32_t pending_mask;
+	RTE_ATOMIC(uint32_t) pending_head;  /* Written by the enqueue thread */
+	RTE_ATOMIC(uint32_t) pending_tail;  /* Written by the dequeue thread */
+	/* Worker serving this queue when workers are pinned */
+	uint16_t worker;
+	struct turbo_sw_cb_stats cb_stats;
 };
 
 
-#ifdef RTE_BBDEV_SDK_AVX2
 static inline char *
 mbuf_append(struct rte_mbuf *m_head, struct rte_mbuf *m, uint16_t len)
 {
@@ -111,6 +197,7 @@ mbuf_append(struct rte_mbuf *m_head, struct rte_mbuf *m, uint16_t len)
 	return tail;
 }
 
+#ifdef RTE_BBDEV_SDK_AVX2
 /* Calculate index based on Table 5.1.3-3 from TS34.212 */
 static inline int32_t
 compute_idx(uint16_t k)
@@ -287,6 +374,9 @@ q_release(struct rte_bbdev *dev, uint16_t q_id)
 		rte_free(q->deint_input);
 		rte_free(q->deint_output);
 		rte_free(q->adapter_output);
+		rte_ring_free(q->cb_jobs);
+		rte_free(q->jobs);
+		rte_free(q->pending);
 		rte_free(q);
 		dev->data->queues[q_id].queue_private = NULL;
 	}
@@ -296,11 +386,63 @@ q_release(struct rte_bbdev *dev, uint16_t q_id)
 	return 0;
 }
 
+/* Allocate the code block jobs of a queue decoded by workers */
+static int
+q_setup_jobs(struct rte_bbdev *dev, struct turbo_sw_queue *q, uint16_t q_id,
+		const struct rte_bbdev_queue_conf *queue_conf)
+{
+	struct bbdev_private *priv = dev->data->dev_private;
+	unsigned int flags = RING_F_SP_ENQ | RING_F_EXACT_SZ;
+	char name[RTE_RING_NAMESIZE];
+	uint32_t nb_jobs, nb_pending;
+	int ret;
+
+	/* Jobs of an operation are contiguous, so that twice the maximum
+	 * number of code blocks always leaves room for one operation.
+	 */
+	nb_jobs = rte_align32pow2(RTE_MAX(queue_conf->queue_size * 2U,
+			2U * RTE_BBDEV_LDPC_MAX_CODE_BLOCKS));
+	nb_pending = rte_align32pow2(queue_conf->queue_size);
+
+	q->jobs = rte_zmalloc_socket(NULL, nb_jobs * sizeof(*q->jobs),
+			RTE_CACHE_LINE_SIZE, queue_conf->socket);
+	q->pending = rte_zmalloc_socket(NULL, nb_pending * sizeof(*q->pending),
+			RTE_CACHE_LINE_SIZE, queue_conf->socket);
+	if (q->jobs == NULL || q->pending == NULL) {
+		rte_bbdev_log(ERR,
+				"Failed to allocate jobs for device %u queue %u",
+				dev->data->dev_id, q_id);
+		return -ENOMEM;
+	}
+	q->jobs_mask = nb_jobs - 1;
+	q->pending_mask = nb_pending - 1;
+
+	ret = snprintf(name, RTE_RING_NAMESIZE, RTE_STR(DRIVER_NAME)"_j%u:%u",
+			dev->data->dev_id, q_id);
+	if ((ret < 0) || (ret >= (int)RTE_RING_NAMESIZE)) {
+		rte_bbdev_log(ERR,
+				"Creating queue name for device %u queue %u failed",
+				dev->data->dev_id, q_id);
+		return -ENAMETOOLONG;
+	}
+	q->worker = q_id % priv->nb_workers;
+	if (priv->pin_workers)
+		flags |= RING_F_SC_DEQ;
+	q->cb_jobs = rte_ring_create(name, nb_jobs, queue_conf->socket, flags);
+	if (q->cb_jobs == NULL) {
+		rte_bbdev_log(ERR, "Failed to create ring for %s", name);
+		return -rte_errno;
+	}
+
+	return 0;
+}
+
 /* Setup a queue */
 static int
 q_setup(struct rte_bbdev *dev, uint16_t q_id,
 		const struct rte_bbdev_queue_conf *queue_conf)
 {
+	struct bbdev_private *priv = dev->data->dev_private;
 	int ret;
 	struct turbo_sw_queue *q;
 	char name[RTE_RING_NAMESIZE];
@@ -478,6 +620,14 @@ q_setup(struct rte_bbdev *dev, uint16_t q_id,
 
 	q->type = queue_conf->op_type;
 
+	/* Decoding is split in code block jobs when the device has workers. */
+	if (priv->nb_workers != 0 && (q->type == RTE_BBDEV_OP_TURBO_DEC ||
+			q->type == RTE_BBDEV_OP_LDPC_DEC)) {
+		ret = q_setup_jobs(dev, q, q_id, queue_conf);
+		if (ret < 0)
+			goto free_q;
+	}
+
 	dev->data->queues[q_id].queue_private = q;
 	rte_bbdev_log_debug("setup device queue %s", name);
 	return 0;
@@ -491,14 +641,139 @@ q_setup(struct rte_bbdev *dev, uint16_t q_id,
 	rte_free(q->deint_input);
 	rte_free(q->deint_output);
 	rte_free(q->adapter_output);
+	rte_ring_free(q->cb_jobs);
+	rte_free(q->jobs);
+	rte_free(q->pending);
 	rte_free(q);
 	return ret;
 }
 
+/* Stop the workers of the device */
+static void
+dev_stop(struct rte_bbdev *dev)
+{
+	struct bbdev_private *priv = dev->data->dev_private;
+	struct turbo_sw_worker *wk;
+	uint16_t i;
+
+	if (priv->nb_workers == 0)
+		return;
+
+	rte_service_runstate_set(priv->service_id, 0);
+	while (rte_service_may_be_active(priv->service_id) == 1)
+		rte_pause();
+
+	for (i = 0; i < priv->nb_workers; i++) {
+		wk = &priv->workers[i];
+		rte_service_map_lcore_set(priv->service_id, wk->lcore_id, 0);
+		if (wk->added) {
+			rte_service_lcore_stop(wk->lcore_id);
+			rte_service_lcore_del(wk->lcore_id);
+			wk->added = false;
+		}
+	}
+
+	rte_bbdev_log_debug("stopped workers of device %u", dev->data->dev_id);
+}
+
+/* Start the workers of the device */
+static int
+dev_start(struct rte_bbdev *dev)
+{
+	struct bbdev_private *priv = dev->data->dev_private;
+	struct turbo_sw_worker *wk;
+	uint16_t i;
+	int ret;
+
+	if (priv->nb_workers == 0)
+		return 0;
+
+	for (i = 0; i < priv->nb_workers; i++) {
+		wk = &priv->workers[i];
+		ret = rte_service_lcore_add(wk->lcore_id);
+		if (ret == 0)
+			wk->added = true;
+		else if (ret != -EALREADY)
+			goto error;
+		ret = rte_service_map_lcore_set(priv->service_id, wk->lcore_id,
+				1);
+		if (ret < 0)
+			goto error;
+		ret = rte_service_lcore_start(wk->lcore_id);
+		if (ret < 0 && ret != -EALREADY)
+			goto error;
+	}
+	rte_service_runstate_set(priv->service_id, 1);
+
+	rte_bbdev_log_debug("started %u workers of device %u",
+			priv->nb_workers, dev->data->dev_id);
+	return 0;
+
+error:
+	rte_bbdev_log(ERR, "Cannot run worker on lcore %u: %s", wk->lcore_id,
+			rte_strerror(-ret));
+	dev_stop(dev);
+	return ret;
+}
+
+/* Dump the code block statistics of a queue */
+static int
+q_ops_dump(struct rte_bbdev *dev, uint16_t q_id, FILE *f)
+{
+	struct bbdev_private *priv = dev->data->dev_private;
+	struct turbo_sw_queue *q = dev->data->queues[q_id].queue_private;
+	const struct turbo_sw_cb_stats *st;
+	double us = 1E6 / rte_get_tsc_hz();
+	uint32_t head, tail;
+
+	if (f == NULL) {
+		rte_bbdev_log(ERR, "Invalid File input");
+		return -EINVAL;
+	}
+	if (q == NULL)
+		return -EINVAL;
+
+	fprintf(f, "Dump of operations %s on Queue %d by %s\n",
+			rte_bbdev_op_type_str(q->type), q_id,
+			dev->device->driver->name);
+	if (q->cb_jobs == NULL) {
+		fprintf(f, "    Decoded inline, %u operations ready\n",
+				rte_ring_count(q->processed_pkts));
+		return 0;
+	}
+
+	head = rte_atomic_load_explicit(&q->pending_head,
+			rte_memory_order_relaxed);
+	tail = rte_atomic_load_explicit(&q->pending_tail,
+			rte_memory_order_relaxed);
+	st = &q->cb_stats;
+	fprintf(f, "    Workers %u%s, %u operations in flight, %u code blocks waiting\n",
+			priv->nb_workers,
+			priv->pin_workers ? " (pinned)" : "",
+			head - tail, rte_ring_count(q->cb_jobs));
+	if (priv->pin_workers)
+		fprintf(f, "    Worker lcore %u\n",
+				priv->workers[q->worker].lcore_id);
+	fprintf(f, "    Code blocks %" PRIu64 "\n", st->nb_cbs);
+	if (st->nb_cbs == 0)
+		return 0;
+	fprintf(f, "    Decoding avg %.2f us max %.2f us\n",
+			(double)st->proc_cycles / st->nb_cbs * us,
+			(double)st->max_proc_cycles * us);
+	fprintf(f, "    Latency avg %.2f us max %.2f us\n",
+			(double)st->latency_cycles / st->nb_cbs * us,
+			(double)st->max_latency_cycles * us);
+
+	return 0;
+}
+
 static const struct rte_bbdev_ops pmd_ops = {
+	.start = dev_start,
+	.stop = dev_stop,
 	.info_get = info_get,
 	.queue_setup = q_setup,
-	.queue_release = q_release
+	.queue_release = q_release,
+	.queue_ops_dump = q_ops_dump
 };
 
 #ifdef RTE_BBDEV_SDK_AVX2
@@ -1196,13 +1471,30 @@ move_padding_bytes(const uint8_t *in, uint8_t *out, uint16_t k,
 }
 #endif
 
+/* Reserve the hard output of a code block */
+static inline uint8_t *
+dec_cb_output(struct rte_bbdev_dec_op *op, struct rte_mbuf *m_out_head,
+		struct rte_mbuf *m_out, uint16_t out_offset, uint16_t len)
+{
+	if (mbuf_append(m_out_head, m_out, len) == NULL) {
+		op->status |= 1 << RTE_BBDEV_DATA_ERROR;
+		rte_bbdev_log(ERR, "Too little space in output mbuf");
+		return NULL;
+	}
+
+	/* rte_bbdev_op_data.offset can be different than the offset of the
+	 * appended bytes
+	 */
+	return rte_pktmbuf_mtod_offset(m_out, uint8_t *, out_offset);
+}
+
 static inline void
 process_dec_cb(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 		uint8_t c, uint16_t k, uint16_t kw, struct rte_mbuf *m_in,
 		struct rte_mbuf *m_out_head, struct rte_mbuf *m_out,
-		uint16_t in_offset, uint16_t out_offset, bool check_crc_24b,
-		uint16_t crc24_overlap, uint16_t in_length,
-		struct rte_bbdev_stats *q_stats)
+		uint16_t in_offset, uint16_t out_offset, uint8_t *out,
+		bool check_crc_24b, uint16_t crc24_overlap,
+		uint16_t in_length, struct rte_bbdev_stats *q_stats)
 {
 #ifdef RTE_BBDEV_SDK_AVX2
 #ifdef RTE_LIBRTE_BBDEV_DEBUG
@@ -1212,7 +1504,7 @@ process_dec_cb(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 #endif
 	int32_t k_idx;
 	int32_t iter_cnt;
-	uint8_t *in, *out, *adapter_input;
+	uint8_t *in, *adapter_input;
 	int32_t ncb, ncb_without_null;
 	struct bblib_turbo_adapter_ul_response adapter_resp;
 	struct bblib_turbo_adapter_ul_request adapter_req;
@@ -1275,17 +1567,14 @@ process_dec_cb(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 
 	q_stats->acc_offload_cycles += rte_rdtsc_precise() - start_time;
 
-	out = (uint8_t *)mbuf_append(m_out_head, m_out,
-			((k - crc24_overlap) >> 3));
+	/* A code block decoded by a worker has its output already reserved */
 	if (out == NULL) {
-		op->status |= 1 << RTE_BBDEV_DATA_ERROR;
-		rte_bbdev_log(ERR, "Too little space in output mbuf");
-		return;
+		out = dec_cb_output(op, m_out_head, m_out, out_offset,
+				(k - crc24_overlap) >> 3);
+		if (out == NULL)
+			return;
 	}
-	/* rte_bbdev_op_data.offset can be different than the offset of the
-	 * appended bytes
-	 */
-	out = rte_pktmbuf_mtod_offset(m_out, uint8_t *, out_offset);
+
 	if (check_crc_24b)
 		turbo_req.c = c + 1;
 	else
@@ -1328,6 +1617,7 @@ process_dec_cb(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 	RTE_SET_USED(m_out);
 	RTE_SET_USED(in_offset);
 	RTE_SET_USED(out_offset);
+	RTE_SET_USED(out);
 	RTE_SET_USED(check_crc_24b);
 	RTE_SET_USED(crc24_overlap);
 	RTE_SET_USED(in_length);
@@ -1340,6 +1630,7 @@ process_ldpc_dec_cb(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 		uint8_t c, uint16_t out_length, uint32_t e,
 		struct rte_mbuf *m_in,
 		struct rte_mbuf *m_out_head, struct rte_mbuf *m_out,
+		uint8_t *out,
 		struct rte_mbuf *m_harq_in,
 		struct rte_mbuf *m_harq_out_head, struct rte_mbuf *m_harq_out,
 		uint16_t in_offset, uint16_t out_offset,
@@ -1351,7 +1642,7 @@ process_ldpc_dec_cb(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 #ifdef RTE_BBDEV_SDK_AVX512
 	RTE_SET_USED(in_length);
 	RTE_SET_USED(c);
-	uint8_t *in, *out, *harq_in, *harq_out, *adapter_input;
+	uint8_t *in, *harq_in, *harq_out, *adapter_input;
 	struct bblib_rate_dematching_5gnr_request derm_req;
 	struct bblib_rate_dematching_5gnr_response derm_resp;
 	struct bblib_ldpc_decoder_5gnr_request dec_req;
@@ -1424,19 +1715,14 @@ process_ldpc_dec_cb(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 			- sys_cols + 2;
 	numRows = RTE_MAX(4, numRows);
 
-	/* get output data starting address */
-	out = (uint8_t *)mbuf_append(m_out_head, m_out, out_length);
+	/* A code block decoded by a worker has its output already reserved */
 	if (out == NULL) {
-		op->status |= 1 << RTE_BBDEV_DATA_ERROR;
-		rte_bbdev_log(ERR,
-				"Too little space in LDPC decoder output mbuf");
-		return;
+		out = dec_cb_output(op, m_out_head, m_out, out_offset,
+				out_length);
+		if (out == NULL)
+			return;
 	}
 
-	/* rte_bbdev_op_data.offset can be different than the offset
-	 * of the appended bytes
-	 */
-	out = rte_pktmbuf_mtod_offset(m_out, uint8_t *, out_offset);
 	adapter_input = q->enc_out;
 
 	dec_req.Zc = dec->z_c;
@@ -1519,13 +1805,14 @@ process_ldpc_dec_cb(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 	RTE_SET_USED(m_in);
 	RTE_SET_USED(m_out_head);
 	RTE_SET_USED(m_out);
+	RTE_SET_USED(out_offset);
+	RTE_SET_USED(out);
 	RTE_SET_USED(m_harq_in);
 	RTE_SET_USED(m_harq_out_head);
 	RTE_SET_USED(m_harq_out);
 	RTE_SET_USED(harq_in_offset);
 	RTE_SET_USED(harq_out_offset);
 	RTE_SET_USED(in_offset);
-	RTE_SET_USED(out_offset);
 	RTE_SET_USED(check_crc_24b);
 	RTE_SET_USED(crc24_overlap);
 	RTE_SET_USED(in_length);
@@ -1533,12 +1820,14 @@ process_ldpc_dec_cb(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 #endif
 }
 
-
-static inline void
+/* Decode the code blocks of an operation, or only prepare their jobs when
+ * jobs is not NULL. Returns the number of jobs.
+ */
+static inline uint8_t
 enqueue_dec_one_op(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
-		struct rte_bbdev_stats *queue_stats)
+		struct rte_bbdev_stats *queue_stats, struct turbo_sw_job *jobs)
 {
-	uint8_t c, r = 0;
+	uint8_t c, r = 0, nb_jobs = 0;
 	uint16_t kw, k = 0;
 	uint16_t crc24_overlap = 0;
 	struct rte_bbdev_op_turbo_dec *dec = &op->turbo_dec;
@@ -1549,6 +1838,8 @@ enqueue_dec_one_op(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 	uint16_t out_offset = dec->hard_output.offset;
 	uint32_t mbuf_total_left = dec->input.length;
 	uint16_t seg_total_left;
+	struct turbo_sw_job *job;
+	uint8_t *out;
 
 	/* Clear op status */
 	op->status = 0;
@@ -1556,7 +1847,7 @@ enqueue_dec_one_op(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 	if (m_in == NULL || m_out == NULL) {
 		rte_bbdev_log(ERR, "Invalid mbuf pointer");
 		op->status = 1 << RTE_BBDEV_DATA_ERROR;
-		return;
+		return 0;
 	}
 
 	if (dec->code_block_mode == RTE_BBDEV_TRANSPORT_BLOCK) {
@@ -1589,10 +1880,39 @@ enqueue_dec_one_op(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 		 */
 		kw = RTE_ALIGN_CEIL(k + 4, RTE_BBDEV_TURBO_C_SUBBLOCK) * 3;
 
-		process_dec_cb(q, op, c, k, kw, m_in, m_out_head, m_out,
-				in_offset, out_offset, check_bit(dec->op_flags,
-				RTE_BBDEV_TURBO_CRC_TYPE_24B), crc24_overlap,
-				seg_total_left, queue_stats);
+		/* The jobs are reserved for the expected code blocks only */
+		if (jobs != NULL && nb_jobs == c) {
+			op->status |= 1 << RTE_BBDEV_DATA_ERROR;
+			rte_bbdev_log(ERR, "Input has more than %u code blocks",
+					c);
+			break;
+		}
+
+		if (jobs != NULL) {
+			/* Workers cannot append to the mbuf concurrently,
+			 * reserve the output of their code blocks now.
+			 */
+			out = dec_cb_output(op, m_out_head, m_out, out_offset,
+					(k - crc24_overlap) >> 3);
+			if (out != NULL) {
+				job = &jobs[nb_jobs++];
+				job->c = c;
+				job->k = k;
+				job->kw = kw;
+				job->m_in = m_in;
+				job->in_offset = in_offset;
+				job->in_length = seg_total_left;
+				job->out = out;
+				job->check_crc_24b = check_bit(dec->op_flags,
+						RTE_BBDEV_TURBO_CRC_TYPE_24B);
+			}
+		} else
+			process_dec_cb(q, op, c, k, kw, m_in, m_out_head,
+					m_out, in_offset, out_offset, NULL,
+					check_bit(dec->op_flags,
+					RTE_BBDEV_TURBO_CRC_TYPE_24B),
+					crc24_overlap, seg_total_left,
+					queue_stats);
 
 		/* To keep CRC24 attached to end of Code block, use
 		 * RTE_BBDEV_TURBO_DEC_TB_CRC_24B_KEEP flag as it
@@ -1615,13 +1935,18 @@ enqueue_dec_one_op(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 		}
 		r++;
 	}
+
+	return nb_jobs;
 }
 
-static inline void
+/* Decode the code blocks of an operation, or only prepare their jobs when
+ * jobs is not NULL. Returns the number of jobs.
+ */
+static inline uint8_t
 enqueue_ldpc_dec_one_op(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
-		struct rte_bbdev_stats *queue_stats)
+		struct rte_bbdev_stats *queue_stats, struct turbo_sw_job *jobs)
 {
-	uint8_t c, r = 0;
+	uint8_t c, r = 0, nb_jobs = 0;
 	uint32_t e;
 	uint16_t out_length, crc24_overlap = 0;
 	struct rte_bbdev_op_ldpc_dec *dec = &op->ldpc_dec;
@@ -1637,6 +1962,8 @@ enqueue_ldpc_dec_one_op(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 	uint16_t out_offset = dec->hard_output.offset;
 	uint32_t mbuf_total_left = dec->input.length;
 	uint16_t seg_total_left;
+	struct turbo_sw_job *job;
+	uint8_t *out;
 
 	/* Clear op status */
 	op->status = 0;
@@ -1644,7 +1971,7 @@ enqueue_ldpc_dec_one_op(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 	if (m_in == NULL || m_out == NULL) {
 		rte_bbdev_log(ERR, "Invalid mbuf pointer");
 		op->status = 1 << RTE_BBDEV_DATA_ERROR;
-		return;
+		return 0;
 	}
 
 	if (dec->code_block_mode == RTE_BBDEV_TRANSPORT_BLOCK) {
@@ -1671,15 +1998,43 @@ enqueue_ldpc_dec_one_op(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 		else
 			seg_total_left = e;
 
-		process_ldpc_dec_cb(q, op, c, out_length, e,
-				m_in, m_out_head, m_out,
-				m_harq_in, m_harq_out_head, m_harq_out,
-				in_offset, out_offset, harq_in_offset,
-				harq_out_offset,
-				check_bit(dec->op_flags,
-				RTE_BBDEV_LDPC_CRC_TYPE_24B_CHECK),
-				crc24_overlap,
-				seg_total_left, queue_stats);
+		/* The jobs are reserved for the expected code blocks only */
+		if (jobs != NULL && nb_jobs == c) {
+			op->status |= 1 << RTE_BBDEV_DATA_ERROR;
+			rte_bbdev_log(ERR, "Input has more than %u code blocks",
+					c);
+			break;
+		}
+
+		if (jobs != NULL) {
+			/* Workers cannot append to the mbuf concurrently,
+			 * reserve the output of their code blocks now.
+			 */
+			out = dec_cb_output(op, m_out_head, m_out, out_offset,
+					out_length);
+			if (out != NULL) {
+				job = &jobs[nb_jobs++];
+				job->c = c;
+				job->e = e;
+				job->out_length = out_length;
+				job->crc24_overlap = crc24_overlap;
+				job->m_in = m_in;
+				job->in_offset = in_offset;
+				job->in_length = seg_total_left;
+				job->out = out;
+				job->check_crc_24b = check_bit(dec->op_flags,
+					RTE_BBDEV_LDPC_CRC_TYPE_24B_CHECK);
+			}
+		} else
+			process_ldpc_dec_cb(q, op, c, out_length, e,
+					m_in, m_out_head, m_out, NULL,
+					m_harq_in, m_harq_out_head, m_harq_out,
+					in_offset, out_offset, harq_in_offset,
+					harq_out_offset,
+					check_bit(dec->op_flags,
+					RTE_BBDEV_LDPC_CRC_TYPE_24B_CHECK),
+					crc24_overlap,
+					seg_total_left, queue_stats);
 
 		/* To keep CRC24 attached to end of Code block, use
 		 * RTE_BBDEV_LDPC_DEC_TB_CRC_24B_KEEP flag as it
@@ -1708,6 +2063,8 @@ enqueue_ldpc_dec_one_op(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 		}
 		r++;
 	}
+
+	return nb_jobs;
 }
 
 static inline uint16_t
@@ -1718,7 +2075,7 @@ enqueue_dec_all_ops(struct turbo_sw_queue *q, struct rte_bbdev_dec_op **ops,
 	queue_stats->acc_offload_cycles = 0;
 
 	for (i = 0; i < nb_ops; ++i)
-		enqueue_dec_one_op(q, ops[i], queue_stats);
+		enqueue_dec_one_op(q, ops[i], queue_stats, NULL);
 
 	return rte_ring_enqueue_burst(q->processed_pkts, (void **)ops, nb_ops,
 			NULL);
@@ -1733,12 +2090,237 @@ enqueue_ldpc_dec_all_ops(struct turbo_sw_queue *q,
 	queue_stats->acc_offload_cycles = 0;
 
 	for (i = 0; i < nb_ops; ++i)
-		enqueue_ldpc_dec_one_op(q, ops[i], queue_stats);
+		enqueue_ldpc_dec_one_op(q, ops[i], queue_stats, NULL);
 
 	return rte_ring_enqueue_burst(q->processed_pkts, (void **)ops, nb_ops,
 			NULL);
 }
 
+/* An operation combining HARQ is decoded as a whole by a single worker, since
+ * the HARQ output of its code blocks is appended in order.
+ */
+static inline bool
+dec_whole_op(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op)
+{
+	return q->type == RTE_BBDEV_OP_LDPC_DEC &&
+			(op->ldpc_dec.harq_combined_input.data != NULL ||
+			op->ldpc_dec.harq_combined_output.data != NULL);
+}
+
+/* Number of code blocks of an operation */
+static inline uint8_t
+dec_nb_cbs(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op)
+{
+	if (q->type == RTE_BBDEV_OP_LDPC_DEC)
+		return op->ldpc_dec.code_block_mode ==
+				RTE_BBDEV_TRANSPORT_BLOCK ?
+				op->ldpc_dec.tb_params.c : 1;
+	return op->turbo_dec.code_block_mode == RTE_BBDEV_TRANSPORT_BLOCK ?
+			op->turbo_dec.tb_params.c : 1;
+}
+
+/* Split the operations in code block jobs for the workers */
+static inline uint16_t
+enqueue_dec_jobs(struct turbo_sw_queue *q, struct rte_bbdev_dec_op **ops,
+		uint16_t nb_ops, struct rte_bbdev_stats *queue_stats)
+{
+	struct turbo_sw_job *cbs[RTE_BBDEV_LDPC_MAX_CODE_BLOCKS];
+	const uint32_t nb_jobs_max = q->jobs_mask + 1;
+	uint32_t head, pending_head, pending_tail, jobs_tail;
+	struct turbo_sw_pending_op *pending;
+	struct rte_bbdev_dec_op *op;
+	struct turbo_sw_job *jobs;
+	uint64_t now = rte_rdtsc();
+	uint8_t nb_cbs, nb, j;
+	bool whole_op;
+	uint16_t i;
+
+	queue_stats->acc_offload_cycles = 0;
+
+	pending_head = rte_atomic_load_explicit(&q->pending_head,
+			rte_memory_order_relaxed);
+	pending_tail = rte_atomic_load_explicit(&q->pending_tail,
+			rte_memory_order_acquire);
+	jobs_tail = rte_atomic_load_explicit(&q->jobs_tail,
+			rte_memory_order_acquire);
+
+	for (i = 0; i < nb_ops; ++i) {
+		op = ops[i];
+		if (pending_head - pending_tail > q->pending_mask)
+			break;
+
+		whole_op = dec_whole_op(q, op);
+		nb_cbs = whole_op ? 1 : dec_nb_cbs(q, op);
+		/* Keep the jobs of the operation contiguous */
+		head = q->jobs_head;
+		if ((head & q->jobs_mask) + nb_cbs > nb_jobs_max)
+			head += nb_jobs_max - (head & q->jobs_mask);
+		if (head + nb_cbs - jobs_tail > nb_jobs_max)
+			break;
+
+		jobs = &q->jobs[head & q->jobs_mask];
+		if (whole_op)
+			nb = 1;
+		else if (q->type == RTE_BBDEV_OP_LDPC_DEC)
+			nb = enqueue_ldpc_dec_one_op(q, op, queue_stats, jobs);
+		else
+			nb = enqueue_dec_one_op(q, op, queue_stats, jobs);
+
+		for (j = 0; j < nb; j++) {
+			jobs[j].op = op;
+			jobs[j].whole_op = whole_op;
+			jobs[j].enqueue_time = now;
+			rte_atomic_store_explicit(&jobs[j].done, 0,
+					rte_memory_order_relaxed);
+			cbs[j] = &jobs[j];
+		}
+
+		pending = &q->pending[pending_head & q->pending_mask];
+		pending->op = op;
+		pending->first_job = head;
+		pending->nb_jobs = nb;
+		pending_head++;
+		q->jobs_head = head + nb;
+
+		/* The ring has room for all jobs */
+		rte_ring_enqueue_burst(q->cb_jobs, (void **)cbs, nb, NULL);
+	}
+
+	rte_atomic_store_explicit(&q->pending_head, pending_head,
+			rte_memory_order_release);
+
+	return i;
+}
+
+/* Run a job on a worker, with its own scratch buffers */
+static inline void
+run_dec_job(struct turbo_sw_queue *scratch, enum rte_bbdev_op_type type,
+		struct turbo_sw_job *job)
+{
+	struct rte_bbdev_stats stats = { .acc_offload_cycles = 0 };
+	struct rte_bbdev_dec_op op;
+
+	job->start_time = rte_rdtsc();
+
+	if (job->whole_op) {
+		enqueue_ldpc_dec_one_op(scratch, job->op, &stats, NULL);
+	} else if (type == RTE_BBDEV_OP_LDPC_DEC) {
+		/* Code blocks of the operation are decoded concurrently,
+		 * their results are merged when the operation is dequeued.
+		 */
+		op = *job->op;
+		op.status = 0;
+		op.ldpc_dec.iter_count = 0;
+		op.ldpc_dec.hard_output.length = 0;
+		process_ldpc_dec_cb(scratch, &op, job->c, job->out_length,
+				job->e, job->m_in, NULL, NULL, job->out,
+				NULL, NULL, NULL, job->in_offset, 0, 0, 0,
+				job->check_crc_24b,
+				job->crc24_overlap, job->in_length, &stats);
+		job->status = op.status;
+		job->iter_count = op.ldpc_dec.iter_count;
+		job->hard_output_length = op.ldpc_dec.hard_output.length;
+	} else {
+		op = *job->op;
+		op.status = 0;
+		op.turbo_dec.iter_count = 0;
+		op.turbo_dec.hard_output.length = 0;
+		process_dec_cb(scratch, &op, job->c, job->k, job->kw,
+				job->m_in, NULL, NULL, job->in_offset, 0,
+				job->out, job->check_crc_24b, 0,
+				job->in_length, &stats);
+		job->status = op.status;
+		job->iter_count = op.turbo_dec.iter_count;
+		job->hard_output_length = op.turbo_dec.hard_output.length;
+	}
+
+	job->offload_cycles = stats.acc_offload_cycles;
+	job->end_time = rte_rdtsc();
+	rte_atomic_store_explicit(&job->done, 1, rte_memory_order_release);
+}
+
+/* Merge the results of the jobs of a decoded operation */
+static inline bool
+dequeue_dec_job_results(struct turbo_sw_queue *q,
+		struct turbo_sw_pending_op *pending,
+		struct rte_bbdev_stats *queue_stats)
+{
+	struct rte_bbdev_dec_op *op = pending->op;
+	struct turbo_sw_cb_stats *st = &q->cb_stats;
+	struct turbo_sw_job *job;
+	uint64_t cycles;
+	uint32_t j;
+
+	for (j = 0; j < pending->nb_jobs; j++) {
+		job = &q->jobs[(pending->first_job + j) & q->jobs_mask];
+		if (rte_atomic_load_explicit(&job->done,
+				rte_memory_order_acquire) == 0)
+			return false;
+	}
+
+	for (j = 0; j < pending->nb_jobs; j++) {
+		job = &q->jobs[(pending->first_job + j) & q->jobs_mask];
+		queue_stats->acc_offload_cycles += job->offload_cycles;
+		if (job->whole_op)
+			continue;
+
+		op->status |= job->status;
+		if (q->type == RTE_BBDEV_OP_LDPC_DEC) {
+			op->ldpc_dec.iter_count = RTE_MAX(job->iter_count,
+					op->ldpc_dec.iter_count);
+			op->ldpc_dec.hard_output.length +=
+					job->hard_output_length;
+		} else {
+			op->turbo_dec.iter_count = RTE_MAX(job->iter_count,
+					op->turbo_dec.iter_count);
+			op->turbo_dec.hard_output.length +=
+					job->hard_output_length;
+		}
+
+		st->nb_cbs++;
+		cycles = job->end_time - job->start_time;
+		st->proc_cycles += cycles;
+		st->max_proc_cycles = RTE_MAX(st->max_proc_cycles, cycles);
+		cycles = job->end_time - job->enqueue_time;
+		st->latency_cycles += cycles;
+		st->max_latency_cycles = RTE_MAX(st->max_latency_cycles,
+				cycles);
+	}
+
+	return true;
+}
+
+/* Dequeue the operations decoded by the workers, in enqueue order */
+static inline uint16_t
+dequeue_dec_jobs(struct turbo_sw_queue *q, struct rte_bbdev_dec_op **ops,
+		uint16_t nb_ops, struct rte_bbdev_stats *queue_stats)
+{
+	struct turbo_sw_pending_op *pending;
+	uint32_t head, tail;
+	uint16_t i = 0;
+
+	head = rte_atomic_load_explicit(&q->pending_head,
+			rte_memory_order_acquire);
+	tail = rte_atomic_load_explicit(&q->pending_tail,
+			rte_memory_order_relaxed);
+
+	while (i < nb_ops && tail != head) {
+		pending = &q->pending[tail & q->pending_mask];
+		if (!dequeue_dec_job_results(q, pending, queue_stats))
+			break;
+		ops[i++] = pending->op;
+		tail++;
+		rte_atomic_store_explicit(&q->jobs_tail,
+				pending->first_job + pending->nb_jobs,
+				rte_memory_order_release);
+	}
+
+	rte_atomic_store_explicit(&q->pending_tail, tail,
+			rte_memory_order_release);
+
+	return i;
+}
+
 /* Enqueue burst */
 static uint16_t
 enqueue_enc_ops(struct rte_bbdev_queue_data *q_data,
@@ -1783,7 +2365,12 @@ enqueue_dec_ops(struct rte_bbdev_queue_data *q_data,
 	struct turbo_sw_queue *q = queue;
 	uint16_t nb_enqueued = 0;
 
-	nb_enqueued = enqueue_dec_all_ops(q, ops, nb_ops, &q_data->queue_stats);
+	if (q->cb_jobs != NULL)
+		nb_enqueued = enqueue_dec_jobs(q, ops, nb_ops,
+				&q_data->queue_stats);
+	else
+		nb_enqueued = enqueue_dec_all_ops(q, ops, nb_ops,
+				&q_data->queue_stats);
 
 	q_data->queue_stats.enqueue_err_count += nb_ops - nb_enqueued;
 	q_data->queue_stats.enqueued_count += nb_enqueued;
@@ -1800,8 +2387,12 @@ enqueue_ldpc_dec_ops(struct rte_bbdev_queue_data *q_data,
 	struct turbo_sw_queue *q = queue;
 	uint16_t nb_enqueued = 0;
 
-	nb_enqueued = enqueue_ldpc_dec_all_ops(q, ops, nb_ops,
-			&q_data->queue_stats);
+	if (q->cb_jobs != NULL)
+		nb_enqueued = enqueue_dec_jobs(q, ops, nb_ops,
+				&q_data->queue_stats);
+	else
+		nb_enqueued = enqueue_ldpc_dec_all_ops(q, ops, nb_ops,
+				&q_data->queue_stats);
 
 	q_data->queue_stats.enqueue_err_count += nb_ops - nb_enqueued;
 	q_data->queue_stats.enqueued_count += nb_enqueued;
@@ -1815,8 +2406,14 @@ dequeue_dec_ops(struct rte_bbdev_queue_data *q_data,
 		struct rte_bbdev_dec_op **ops, uint16_t nb_ops)
 {
 	struct turbo_sw_queue *q = q_data->queue_private;
-	uint16_t nb_dequeued = rte_ring_dequeue_burst(q->processed_pkts,
-			(void **)ops, nb_ops, NULL);
+	uint16_t nb_dequeued;
+
+	if (q->cb_jobs != NULL)
+		nb_dequeued = dequeue_dec_jobs(q, ops, nb_ops,
+				&q_data->queue_stats);
+	else
+		nb_dequeued = rte_ring_dequeue_burst(q->processed_pkts,
+				(void **)ops, nb_ops, NULL);
 	q_data->queue_stats.dequeued_count += nb_dequeued;
 
 	return nb_dequeued;
@@ -1835,6 +2432,165 @@ dequeue_enc_ops(struct rte_bbdev_queue_data *q_data,
 	return nb_dequeued;
 }
 
+/* Decode the code block jobs of the queues on a worker */
+static int32_t
+turbo_sw_service(void *arg)
+{
+	struct rte_bbdev *dev = arg;
+	struct bbdev_private *priv = dev->data->dev_private;
+	struct turbo_sw_queue *q;
+	struct turbo_sw_job *job;
+	unsigned int i, n = 0;
+	uint16_t q_id;
+	int16_t w;
+
+	w = priv->worker_idx[rte_lcore_id()];
+	if (w < 0)
+		return -ENOENT;
+
+	for (q_id = 0; q_id < dev->data->num_queues; q_id++) {
+		q = dev->data->queues[q_id].queue_private;
+		if (q == NULL || q->cb_jobs == NULL)
+			continue;
+		if (priv->pin_workers && q->worker != w)
+			continue;
+		/* Jobs are taken one by one to share the code blocks of an
+		 * operation between the workers.
+		 */
+		for (i = 0; i < TURBO_SW_WORKER_BUDGET; i++) {
+			if (rte_ring_dequeue(q->cb_jobs, (void **)&job) != 0)
+				break;
+			run_dec_job(priv->workers[w].scratch, q->type, job);
+		}
+		n += i;
+	}
+
+	return n != 0 ? 0 : -EAGAIN;
+}
+
+/* Release the scratch buffers of a worker */
+static void
+scratch_free(struct turbo_sw_queue *s)
+{
+	if (s == NULL)
+		return;
+	rte_free(s->enc_out);
+	rte_free(s->ag);
+	rte_free(s->code_block);
+	rte_free(s->deint_input);
+	rte_free(s->deint_output);
+	rte_free(s->adapter_output);
+	rte_free(s);
+}
+
+/* Allocate the scratch buffers of a worker, as in q_setup() */
+static struct turbo_sw_queue *
+scratch_alloc(int socket)
+{
+	struct turbo_sw_queue *s;
+
+	s = rte_zmalloc_socket(NULL, sizeof(*s), RTE_CACHE_LINE_SIZE, socket);
+	if (s == NULL)
+		return NULL;
+
+	s->enc_out = rte_zmalloc_socket(NULL,
+			((RTE_BBDEV_TURBO_MAX_TB_SIZE >> 3) + 3) *
+			sizeof(*s->enc_out) * 3,
+			RTE_CACHE_LINE_SIZE, socket);
+	s->ag = rte_zmalloc_socket(NULL,
+			RTE_BBDEV_TURBO_MAX_CB_SIZE * 10 * sizeof(*s->ag),
+			RTE_CACHE_LINE_SIZE, socket);
+	s->code_block = rte_zmalloc_socket(NULL,
+			RTE_BBDEV_TURBO_MAX_CB_SIZE * sizeof(*s->code_block),
+			RTE_CACHE_LINE_SIZE, socket);
+	s->deint_input = rte_zmalloc_socket(NULL,
+			DEINT_INPUT_BUF_SIZE * sizeof(*s->deint_input),
+			RTE_CACHE_LINE_SIZE, socket);
+	s->deint_output = rte_zmalloc_socket(NULL,
+			DEINT_OUTPUT_BUF_SIZE * sizeof(*s->deint_output),
+			RTE_CACHE_LINE_SIZE, socket);
+	s->adapter_output = rte_zmalloc_socket(NULL,
+			ADAPTER_OUTPUT_BUF_SIZE * sizeof(*s->adapter_output),
+			RTE_CACHE_LINE_SIZE, socket);
+	if (s->enc_out == NULL || s->ag == NULL || s->code_block == NULL ||
+			s->deint_input == NULL || s->deint_output == NULL ||
+			s->adapter_output == NULL) {
+		scratch_free(s);
+		return NULL;
+	}
+
+	return s;
+}
+
+/* Release the workers of a device */
+static void
+turbo_sw_workers_free(struct rte_bbdev *bbdev)
+{
+	struct bbdev_private *priv = bbdev->data->dev_private;
+	uint16_t i;
+
+	if (priv->nb_workers == 0)
+		return;
+
+	if (bbdev->data->started)
+		dev_stop(bbdev);
+	rte_service_component_runstate_set(priv->service_id, 0);
+	rte_service_component_unregister(priv->service_id);
+	for (i = 0; i < priv->nb_workers; i++)
+		scratch_free(priv->workers[i].scratch);
+}
+
+/* Set up the workers of a device */
+static int
+turbo_sw_workers_init(struct rte_bbdev *bbdev,
+		struct turbo_sw_params *init_params)
+{
+	struct bbdev_private *priv = bbdev->data->dev_private;
+	struct rte_service_spec service;
+	struct turbo_sw_worker *wk;
+	unsigned int i;
+	int ret;
+
+	for (i = 0; i < RTE_DIM(priv->worker_idx); i++)
+		priv->worker_idx[i] = -1;
+	if (init_params->nb_workers == 0)
+		return 0;
+
+	for (i = 0; i < init_params->nb_workers; i++) {
+		wk = &priv->workers[i];
+		wk->lcore_id = init_params->workers[i];
+		wk->scratch = scratch_alloc(
+				rte_lcore_to_socket_id(wk->lcore_id));
+		if (wk->scratch == NULL) {
+			ret = -ENOMEM;
+			goto free_scratch;
+		}
+		priv->worker_idx[wk->lcore_id] = i;
+	}
+
+	memset(&service, 0, sizeof(service));
+	snprintf(service.name, sizeof(service.name), RTE_STR(DRIVER_NAME)"_%u",
+			bbdev->data->dev_id);
+	service.callback = turbo_sw_service;
+	service.callback_userdata = bbdev;
+	service.capabilities = RTE_SERVICE_CAP_MT_SAFE;
+	service.socket_id = init_params->socket_id;
+	ret = rte_service_component_register(&service, &priv->service_id);
+	if (ret < 0)
+		goto free_scratch;
+	rte_service_component_runstate_set(priv->service_id, 1);
+
+	priv->nb_workers = init_params->nb_workers;
+	priv->pin_workers = init_params->pin_workers != 0;
+	return 0;
+
+free_scratch:
+	rte_bbdev_log(ERR, "Failed to set up workers: %s", rte_strerror(-ret));
+	while (i-- > 0)
+		scratch_free(priv->workers[i].scratch);
+	return ret;
+}
+
 /* Parse 16bit integer from string argument */
 static inline int
 parse_u16_arg(const char *key, const char *value, void *extra_args)
@@ -1854,6 +2610,36 @@ parse_u16_arg(const char *key, const char *value, void *extra_args)
 	return 0;
 }
 
+/* Parse helper lcore from string argument */
+static int
+parse_worker_arg(const char *key, const char *value, void *extra_args)
+{
+	struct turbo_sw_params *params = extra_args;
+	unsigned long lcore;
+	char *end;
+	uint16_t i;
+
+	if ((value == NULL) || (extra_args == NULL))
+		return -EINVAL;
+	errno = 0;
+	lcore = strtoul(value, &end, 0);
+	if (*value == '\0' || *end != '\0' || errno != 0 ||
+			lcore >= RTE_MAX_LCORE || !rte_lcore_is_enabled(lcore) ||
+			lcore == rte_get_main_lcore()) {
+		rte_bbdev_log(ERR, "Invalid lcore %s for %s", value, key);
+		return -EINVAL;
+	}
+	for (i = 0; i < params->nb_workers; i++) {
+		if (params->workers[i] == lcore) {
+			rte_bbdev_log(ERR, "Duplicate lcore %s for %s",
+					value, key);
+			return -EINVAL;
+		}
+	}
+	params->workers[params->nb_workers++] = lcore;
+	return 0;
+}
+
 /* Parse parameters used to create device */
 static int
 parse_turbo_sw_params(struct turbo_sw_params *params, const char *input_args)
@@ -1883,6 +2669,16 @@ parse_turbo_sw_params(struct turbo_sw_params *params, const char *input_args)
 					RTE_MAX_NUMA_NODES);
 			goto exit;
 		}
+
+		ret = rte_kvargs_process(kvlist, turbo_sw_valid_params[2],
+					&parse_worker_arg, params);
+		if (ret < 0)
+			goto exit;
+
+		ret = rte_kvargs_process(kvlist, turbo_sw_valid_params[3],
+					&parse_u16_arg, &params->pin_workers);
+		if (ret < 0)
+			goto exit;
 	}
 
 exit:
@@ -1897,6 +2693,7 @@ turbo_sw_bbdev_create(struct rte_vdev_device *vdev,
 {
 	struct rte_bbdev *bbdev;
 	const char *name = rte_vdev_device_name(vdev);
+	int ret;
 
 	bbdev = rte_bbdev_allocate(name);
 	if (bbdev == NULL)
@@ -1915,6 +2712,13 @@ turbo_sw_bbdev_create(struct rte_vdev_device *vdev,
 	bbdev->data->socket_id = init_params->socket_id;
 	bbdev->intr_handle = NULL;
 
+	ret = turbo_sw_workers_init(bbdev, init_params);
+	if (ret < 0) {
+		rte_free(bbdev->data->dev_private);
+		rte_bbdev_release(bbdev);
+		return ret;
+	}
+
 	/* register rx/tx burst functions for data path */
 	bbdev->dequeue_enc_ops = dequeue_enc_ops;
 	bbdev->dequeue_dec_ops = dequeue_dec_ops;
@@ -1951,8 +2755,9 @@ turbo_sw_bbdev_probe(struct rte_vdev_device *vdev)
 	parse_turbo_sw_params(&init_params, input_args);
 
 	rte_bbdev_log_debug(
-			"Initialising %s on NUMA node %d with max queues: %d",
-			name, init_params.socket_id, init_params.queues_num);
+			"Initialising %s on NUMA node %d with max queues: %d, workers: %u",
+			name, init_params.socket_id, init_params.queues_num,
+			init_params.nb_workers);
 
 	return turbo_sw_bbdev_create(vdev, &init_params);
 }
@@ -1975,6 +2780,7 @@ turbo_sw_bbdev_remove(struct rte_vdev_device *vdev)
 	if (bbdev == NULL)
 		return -EINVAL;
 
+	turbo_sw_workers_free(bbdev);
 	rte_free(bbdev->data->dev_private);
 
 	return rte_bbdev_release(bbdev);
@@ -1988,5 +2794,7 @@ static struct rte_vdev_driver bbdev_turbo_sw_pmd_drv = {
 RTE_PMD_REGISTER_VDEV(DRIVER_NAME, bbdev_turbo_sw_pmd_drv);
 RTE_PMD_REGISTER_PARAM_STRING(DRIVER_NAME,
 	TURBO_SW_MAX_NB_QUEUES_ARG"=<int> "
-	TURBO_SW_SOCKET_ID_ARG"=<int>");
+	TURBO_SW_SOCKET_ID_ARG"=<int> "
+	TURBO_SW_WORKER_ARG"=<lcore> "
+	TURBO_SW_PIN_WORKERS_ARG"=<0|1>");
 RTE_PMD_REGISTER_ALIAS(DRIVER_NAME, turbo_sw);
@@ -0,0 +1,627 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include <bus_vdev_driver.h>
+#include <rte_common.h>
+#include <rte_malloc.h>
+
+#include "lz4_pmd_private.h"
+
+/** Position in a chain of mbuf segments */
+struct lz4_seg {
+	struct rte_mbuf *m;
+	uint8_t *data;
+	uint32_t len;
+	uint32_t left;
+	/**< Bytes left in the following segments, UINT32_MAX if unbounded */
+};
+
+/** Point to the segment containing offset, returns -1 if out of the chain */
+static int
+lz4_seg_init(struct lz4_seg *seg, struct rte_mbuf *m, uint32_t offset,
+		uint32_t length)
+{
+	while (m != NULL && offset >= rte_pktmbuf_data_len(m) &&
+			m->next != NULL) {
+		offset -= rte_pktmbuf_data_len(m);
+		m = m->next;
+	}
+	if (m == NULL || offset > rte_pktmbuf_data_len(m))
+		return -1;
+
+	seg->m = m;
+	seg->data = rte_pktmbuf_mtod_offset(m, uint8_t *, offset);
+	seg->len = rte_pktmbuf_data_len(m) - offset;
+	seg->left = UINT32_MAX;
+	if (length != UINT32_MAX) {
+		seg->len = RTE_MIN(seg->len, length);
+		seg->left = length - seg->len;
+	}
+	return 0;
+}
+
+/** Move to the next segment, returns 0 at the end of the chain or length */
+static int
+lz4_seg_next(struct lz4_seg *seg)
+{
+	struct rte_mbuf *m = seg->m->next;
+
+	if (m == NULL || seg->left == 0)
+		return 0;
+
+	seg->m = m;
+	seg->data = rte_pktmbuf_mtod(m, uint8_t *);
+	seg->len = rte_pktmbuf_data_len(m);
+	if (seg->left != UINT32_MAX) {
+		seg->len = RTE_MIN(seg->len, seg->left);
+		seg->left -= seg->len;
+	}
+	return 1;
+}
+
+static inline bool
+lz4_seg_last(const struct lz4_seg *seg)
+{
+	return seg->left == 0 ||
+		(seg->left == UINT32_MAX && seg->m->next == NULL);
+}
+
+static inline void
+lz4_seg_advance(struct lz4_seg *seg, uint32_t n)
+{
+	seg->data += n;
+	seg->len -= n;
+}
+
+/** Copy a linear buffer to the segments, returns -1 if they are too short */
+static int
+lz4_seg_write(struct lz4_seg *seg, const uint8_t *buf, size_t n)
+{
+	uint32_t len;
+
+	while (n != 0) {
+		if (seg->len == 0 && lz4_seg_next(seg) == 0)
+			return -1;
+		len = RTE_MIN(seg->len, n);
+		memcpy(seg->data, buf, len);
+		lz4_seg_advance(seg, len);
+		buf += len;
+		n -= len;
+	}
+	return 0;
+}
+
+/** Make sure a work buffer holds at least size bytes */
+static int
+lz4_buf_reserve(struct lz4_buf *buf, size_t size, int socket_id)
+{
+	if (buf->size >= size)
+		return 0;
+
+	rte_free(buf->data);
+	buf->data = rte_malloc_socket("LZ4 PMD buffer", size, 0, socket_id);
+	buf->size = buf->data == NULL ? 0 : size;
+	return buf->data == NULL ? -1 : 0;
+}
+
+/** Get a contiguous view of the operation source, copying it if chained */
+static const uint8_t *
+lz4_linear_src(struct lz4_qp *qp, struct rte_comp_op *op)
+{
+	struct lz4_seg src;
+
+	if (lz4_seg_init(&src, op->m_src, op->src.offset, op->src.length))
+		return NULL;
+	if (src.len == op->src.length)
+		return src.data;
+
+	if (lz4_buf_reserve(&qp->in_buf, op->src.length, qp->socket_id) < 0)
+		return NULL;
+	return rte_pktmbuf_read(op->m_src, op->src.offset, op->src.length,
+			qp->in_buf.data);
+}
+
+/**
+ * Get a pointer where size bytes of frame output can be written:
+ * the current destination segment if large enough, the queue pair
+ * frame buffer otherwise.
+ */
+static inline uint8_t *
+lz4_frame_out(struct lz4_qp *qp, struct lz4_seg *dst, size_t size)
+{
+	if (dst->len >= size)
+		return dst->data;
+	return qp->frame_buf.data;
+}
+
+/** Account n bytes written at out to the destination */
+static inline int
+lz4_frame_commit(struct lz4_seg *dst, const uint8_t *out, size_t n,
+		struct rte_comp_op *op)
+{
+	if (out == dst->data)
+		lz4_seg_advance(dst, n);
+	else if (lz4_seg_write(dst, out, n) < 0)
+		return -1;
+	op->produced += n;
+	return 0;
+}
+
+static void
+process_lz4_frame_compress(struct lz4_qp *qp, struct rte_comp_op *op,
+		const struct lz4_priv_xform *priv_xform)
+{
+	LZ4F_preferences_t prefs;
+	struct lz4_seg src, dst;
+	uint32_t chunk;
+	uint8_t *out;
+	size_t bound;
+	size_t ret;
+
+	if (lz4_seg_init(&src, op->m_src, op->src.offset, op->src.length) ||
+			lz4_seg_init(&dst, op->m_dst, op->dst.offset,
+				UINT32_MAX)) {
+		op->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
+		LZ4_PMD_ERR("Invalid source or destination buffers");
+		return;
+	}
+
+	memset(&prefs, 0, sizeof(prefs));
+	prefs.frameInfo.blockSizeID = LZ4F_max64KB;
+	prefs.frameInfo.blockMode =
+		(priv_xform->flags & RTE_COMP_LZ4_FLAG_BLOCK_INDEPENDENCE) ?
+		LZ4F_blockIndependent : LZ4F_blockLinked;
+	if (priv_xform->flags & RTE_COMP_LZ4_FLAG_CONTENT_CHECKSUM)
+		prefs.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+	if (priv_xform->flags & RTE_COMP_LZ4_FLAG_BLOCK_CHECKSUM)
+		prefs.frameInfo.blockChecksumFlag = LZ4F_blockChecksumEnabled;
+	if (priv_xform->flags & RTE_COMP_LZ4_FLAG_CONTENT_SIZE)
+		prefs.frameInfo.contentSize = op->src.length;
+	prefs.compressionLevel = priv_xform->level;
+
+	op->status = RTE_COMP_OP_STATUS_SUCCESS;
+
+	out = lz4_frame_out(qp, &dst, LZ4F_HEADER_SIZE_MAX);
+	ret = LZ4F_compressBegin(qp->cctx, out, LZ4F_HEADER_SIZE_MAX, &prefs);
+	if (LZ4F_isError(ret))
+		goto error;
+	if (lz4_frame_commit(&dst, out, ret, op) < 0)
+		goto out_of_space;
+
+	do {
+		while (src.len != 0) {
+			chunk = RTE_MIN(src.len, (uint32_t)LZ4_PMD_CHUNK_SIZE);
+			bound = LZ4F_compressBound(chunk, &prefs);
+			out = lz4_frame_out(qp, &dst, bound);
+			ret = LZ4F_compressUpdate(qp->cctx, out, bound,
+					src.data, chunk, NULL);
+			if (LZ4F_isError(ret))
+				goto error;
+			if (lz4_frame_commit(&dst, out, ret, op) < 0)
+				goto out_of_space;
+			lz4_seg_advance(&src, chunk);
+			op->consumed += chunk;
+		}
+	} while (lz4_seg_next(&src));
+
+	bound = LZ4F_compressBound(0, &prefs);
+	out = lz4_frame_out(qp, &dst, bound);
+	ret = LZ4F_compressEnd(qp->cctx, out, bound, NULL);
+	if (LZ4F_isError(ret))
+		goto error;
+	if (lz4_frame_commit(&dst, out, ret, op) < 0)
+		goto out_of_space;
+	return;
+
+error:
+	LZ4_PMD_ERR("Compression failed: %s", LZ4F_getErrorName(ret));
+	op->status = RTE_COMP_OP_STATUS_ERROR;
+	op->consumed = 0;
+	op->produced = 0;
+	return;
+
+out_of_space:
+	op->status = RTE_COMP_OP_STATUS_OUT_OF_SPACE_TERMINATED;
+	op->consumed = 0;
+	op->produced = 0;
+}
+
+static void
+process_lz4_frame_decompress(struct lz4_qp *qp, struct rte_comp_op *op)
+{
+	struct lz4_seg src, dst;
+	size_t src_len, dst_len;
+	size_t ret;
+
+	if (lz4_seg_init(&src, op->m_src, op->src.offset, op->src.length) ||
+			lz4_seg_init(&dst, op->m_dst, op->dst.offset,
+				UINT32_MAX)) {
+		op->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
+		LZ4_PMD_ERR("Invalid source or destination buffers");
+		return;
+	}
+
+	LZ4F_resetDecompressionContext(qp->dctx);
+	op->status = RTE_COMP_OP_STATUS_SUCCESS;
+
+	for (;;) {
+		src_len = src.len;
+		dst_len = dst.len;
+		ret = LZ4F_decompress(qp->dctx, dst.data, &dst_len,
+				src.data, &src_len, NULL);
+		if (LZ4F_isError(ret)) {
+			LZ4_PMD_ERR("Decompression failed: %s",
+					LZ4F_getErrorName(ret));
+			op->status = RTE_COMP_OP_STATUS_ERROR;
+			break;
+		}
+		lz4_seg_advance(&src, src_len);
+		lz4_seg_advance(&dst, dst_len);
+		op->consumed += src_len;
+		op->produced += dst_len;
+
+		/* Frame complete with the whole input, otherwise another
+		 * frame follows.
+		 */
+		if (ret == 0 && src.len == 0 && lz4_seg_last(&src))
+			break;
+
+		if (dst.len == 0 && lz4_seg_next(&dst) == 0) {
+			op->status = RTE_COMP_OP_STATUS_OUT_OF_SPACE_TERMINATED;
+			break;
+		}
+
+		if (src.len == 0 && lz4_seg_next(&src) == 0) {
+			LZ4_PMD_ERR("Truncated frame");
+			op->status = RTE_COMP_OP_STATUS_ERROR;
+			break;
+		}
+	}
+
+	if (op->status != RTE_COMP_OP_STATUS_SUCCESS) {
+		op->consumed = 0;
+		op->produced = 0;
+	}
+}
+
+static void
+process_lz4_block_compress(struct lz4_qp *qp, struct rte_comp_op *op,
+		const struct lz4_priv_xform *priv_xform)
+{
+	const uint8_t *in;
+	struct lz4_seg dst;
+	uint8_t *out;
+	int cap;
+	int ret;
+
+	if (op->src.length > LZ4_MAX_INPUT_SIZE ||
+			lz4_seg_init(&dst, op->m_dst, op->dst.offset,
+				UINT32_MAX)) {
+		op->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
+		LZ4_PMD_ERR("Invalid source or destination buffers");
+		return;
+	}
+
+	in = lz4_linear_src(qp, op);
+	if (in == NULL) {
+		op->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
+		LZ4_PMD_ERR("Invalid source buffer");
+		return;
+	}
+
+	/* Compress directly into a single destination segment, a chain
+	 * goes through a buffer large enough for any input.
+	 */
+	if (lz4_seg_last(&dst)) {
+		out = dst.data;
+		cap = RTE_MIN(dst.len, (uint32_t)INT_MAX);
+	} else {
+		cap = LZ4_compressBound(op->src.length);
+		if (lz4_buf_reserve(&qp->out_buf, cap, qp->socket_id) < 0) {
+			op->status = RTE_COMP_OP_STATUS_ERROR;
+			return;
+		}
+		out = qp->out_buf.data;
+	}
+
+	if (priv_xform->level < LZ4_PMD_HC_MIN_LEVEL)
+		ret = LZ4_compress_fast_extState(qp->state,
+				(const char *)in, (char *)out,
+				op->src.length, cap, 1);
+	else
+		ret = LZ4_compress_HC_extStateHC(qp->state_hc,
+				(const char *)in, (char *)out,
+				op->src.length, cap, priv_xform->level);
+
+	if ((ret == 0 && op->src.length != 0) ||
+			(out != dst.data && lz4_seg_write(&dst, out, ret) < 0)) {
+		op->status = RTE_COMP_OP_STATUS_OUT_OF_SPACE_TERMINATED;
+		return;
+	}
+
+	op->status = RTE_COMP_OP_STATUS_SUCCESS;
+	op->consumed = op->src.length;
+	op->produced = ret;
+}
+
+static void
+process_lz4_block_decompress(struct lz4_qp *qp, struct rte_comp_op *op)
+{
+	const uint8_t *in;
+	struct lz4_seg dst;
+	uint64_t room;
+	uint8_t *out;
+	int cap;
+	int ret;
+
+	if (op->src.length > INT_MAX ||
+			lz4_seg_init(&dst, op->m_dst, op->dst.offset,
+				UINT32_MAX)) {
+		op->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
+		LZ4_PMD_ERR("Invalid source or destination buffers");
+		return;
+	}
+
+	in = lz4_linear_src(qp, op);
+	if (in == NULL) {
+		op->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
+		LZ4_PMD_ERR("Invalid source buffer");
+		return;
+	}
+
+	if (lz4_seg_last(&dst)) {
+		out = dst.data;
+		cap = RTE_MIN(dst.len, (uint32_t)INT_MAX);
+	} else {
+		struct lz4_seg seg = dst;
+
+		room = seg.len;
+		while (lz4_seg_next(&seg))
+			room += seg.len;
+		cap = RTE_MIN(room, (uint64_t)INT_MAX);
+		if (lz4_buf_reserve(&qp->out_buf, cap, qp->socket_id) < 0) {
+			op->status = RTE_COMP_OP_STATUS_ERROR;
+			return;
+		}
+		out = qp->out_buf.data;
+	}
+
+	ret = LZ4_decompress_safe((const char *)in, (char *)out,
+			op->src.length, cap);
+	if (ret < 0) {
+		/* Tell a destination too small from corrupted data */
+		if (LZ4_decompress_safe_partial((const char *)in, (char *)out,
+				op->src.length, cap, cap) == cap)
+			op->status = RTE_COMP_OP_STATUS_OUT_OF_SPACE_TERMINATED;
+		else
+			op->status = RTE_COMP_OP_STATUS_ERROR;
+		return;
+	}
+	if (out != dst.data)
+		lz4_seg_write(&dst, out, ret);
+
+	op->status = RTE_COMP_OP_STATUS_SUCCESS;
+	op->consumed = op->src.length;
+	op->produced = ret;
+}
+
+/** Process comp operation for mbuf */
+static inline void
+process_lz4_op(struct lz4_qp *qp, struct rte_comp_op *op)
+{
+	const struct lz4_priv_xform *priv_xform = op->private_xform;
+
+	op->consumed = 0;
+	op->produced = 0;
+
+	if (op->op_type != RTE_COMP_OP_STATELESS) {
+		op->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
+		LZ4_PMD_ERR("Stateful operations not supported");
+		return;
+	}
+
+	if (priv_xform->type == RTE_COMP_COMPRESS) {
+		if (priv_xform->flags & RTE_COMP_LZ4_FLAG_RAW_BLOCK)
+			process_lz4_block_compress(qp, op, priv_xform);
+		else
+			process_lz4_frame_compress(qp, op, priv_xform);
+	} else {
+		if (priv_xform->flags & RTE_COMP_LZ4_FLAG_RAW_BLOCK)
+			process_lz4_block_decompress(qp, op);
+		else
+			process_lz4_frame_decompress(qp, op);
+	}
+}
+
+/** Parse comp xform and set private xform parameters */
+int
+lz4_set_priv_xform_parameters(const struct rte_comp_xform *xform,
+		struct lz4_priv_xform *priv_xform)
+{
+	enum rte_comp_checksum_type chksum;
+	enum rte_comp_algorithm algo;
+	uint8_t flags;
+
+	memset(priv_xform, 0, sizeof(*priv_xform));
+	priv_xform->type = xform->type;
+
+	switch (xform->type) {
+	case RTE_COMP_COMPRESS:
+		algo = xform->compress.algo;
+		chksum = xform->compress.chksum;
+		flags = xform->compress.lz4.flags;
+
+		/** Compression Level */
+		switch (xform->compress.level) {
+		case RTE_COMP_LEVEL_PMD_DEFAULT:
+			priv_xform->level = 0;
+			break;
+		default:
+			if (xform->compress.level < RTE_COMP_LEVEL_MIN ||
+					xform->compress.level > LZ4HC_CLEVEL_MAX) {
+				LZ4_PMD_ERR("Compression level %d not supported",
+						xform->compress.level);
+				return -ENOTSUP;
+			}
+			/* Levels below the HC threshold use the fast
+			 * compressor, others map one to one on HC levels.
+			 */
+			priv_xform->level =
+				xform->compress.level < LZ4_PMD_HC_MIN_LEVEL ?
+				0 : xform->compress.level;
+			break;
+		}
+
+		if (flags & RTE_COMP_LZ4_FLAG_DICT_ID) {
+			LZ4_PMD_ERR("Dictionary ID not supported");
+			return -ENOTSUP;
+		}
+		break;
+	case RTE_COMP_DECOMPRESS:
+		algo = xform->decompress.algo;
+		chksum = xform->decompress.chksum;
+		flags = xform->decompress.lz4.flags;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if (algo != RTE_COMP_ALGO_LZ4) {
+		LZ4_PMD_ERR("Compression algorithm not supported");
+		return -ENOTSUP;
+	}
+	if (chksum != RTE_COMP_CHECKSUM_NONE) {
+		LZ4_PMD_ERR("Checksum not supported");
+		return -ENOTSUP;
+	}
+	if ((flags & RTE_COMP_LZ4_FLAG_RAW_BLOCK) &&
+			flags != RTE_COMP_LZ4_FLAG_RAW_BLOCK) {
+		LZ4_PMD_ERR("Frame flags set with raw block format");
+		return -EINVAL;
+	}
+	priv_xform->flags = flags;
+
+	return 0;
+}
+
+/*
+ * Operations are only queued on enqueue, the whole burst is processed
+ * by the dequeue call which returns it, avoiding a second ring.
+ */
+static uint16_t
+lz4_pmd_enqueue_burst(void *queue_pair,
+			struct rte_comp_op **ops, uint16_t nb_ops)
+{
+	struct lz4_qp *qp = queue_pair;
+	unsigned int nb_enqueued;
+
+	nb_enqueued = rte_ring_enqueue_burst(qp->pending_ops,
+			(void **)ops, nb_ops, NULL);
+	qp->qp_stats.enqueued_count += nb_enqueued;
+	qp->qp_stats.enqueue_err_count += nb_ops - nb_enqueued;
+
+	return nb_enqueued;
+}
+
+static uint16_t
+lz4_pmd_dequeue_burst(void *queue_pair,
+			struct rte_comp_op **ops, uint16_t nb_ops)
+{
+	struct lz4_qp *qp = queue_pair;
+	unsigned int nb_dequeued;
+	unsigned int i;
+
+	nb_dequeued = rte_ring_dequeue_burst(qp->pending_ops,
+			(void **)ops, nb_ops, NULL);
+
+	for (i = 0; i < nb_dequeued; i++) {
+		if (i + 1 < nb_dequeued)
+			rte_prefetch0(ops[i + 1]);
+		process_lz4_op(qp, ops[i]);
+	}
+	qp->qp_stats.dequeued_count += nb_dequeued;
+
+	return nb_dequeued;
+}
+
+static int
+lz4_create(const char *name,
+		struct rte_vdev_device *vdev,
+		struct rte_compressdev_pmd_init_params *init_params)
+{
+	struct rte_compressdev *dev;
+
+	dev = rte_compressdev_pmd_create(name, &vdev->device,
+			sizeof(struct lz4_private), init_params);
+	if (dev == NULL) {
+		LZ4_PMD_ERR("driver %s: create failed", init_params->name);
+		return -ENODEV;
+	}
+
+	dev->dev_ops = rte_lz4_pmd_ops;
+
+	/* register rx/tx burst functions for data path */
+	dev->dequeue_burst = lz4_pmd_dequeue_burst;
+	dev->enqueue_burst = lz4_pmd_enqueue_burst;
+
+	LZ4_PMD_INFO("Using lz4 %s", LZ4_versionString());
+
+	return 0;
+}
+
+static int
+lz4_probe(struct rte_vdev_device *vdev)
+{
+	struct rte_compressdev_pmd_init_params init_params = {
+		"",
+		rte_socket_id()
+	};
+	const char *name;
+	const char *input_args;
+	int retval;
+
+	name = rte_vdev_device_name(vdev);
+
+	if (name == NULL)
+		return -EINVAL;
+
+	input_args = rte_vdev_device_args(vdev);
+
+	retval = rte_compressdev_pmd_parse_input_args(&init_params, input_args);
+	if (retval < 0) {
+		LZ4_PMD_LOG(ERR,
+			"Failed to parse initialisation arguments[%s]",
+			input_args);
+		return -EINVAL;
+	}
+
+	return lz4_create(name, vdev, &init_params);
+}
+
+static int
+lz4_remove(struct rte_vdev_device *vdev)
+{
+	struct rte_compressdev *compressdev;
+	const char *name;
+
+	name = rte_vdev_device_name(vdev);
+	if (name == NULL)
+		return -EINVAL;
+
+	compressdev = rte_compressdev_pmd_get_named_dev(name);
+	if (compressdev == NULL)
+		return -ENODEV;
+
+	return rte_compressdev_pmd_destroy(compressdev);
+}
+
+static struct rte_vdev_driver lz4_pmd_drv = {
+	.probe = lz4_probe,
+	.remove = lz4_remove
+};
+
+RTE_PMD_REGISTER_VDEV(COMPRESSDEV_NAME_LZ4_PMD, lz4_pmd_drv);
+RTE_PMD_REGISTER_PARAM_STRING(COMPRESSDEV_NAME_LZ4_PMD,
+	"socket_id=<int>");
+RTE_LOG_REGISTER_DEFAULT(lz4_logtype_driver, INFO);
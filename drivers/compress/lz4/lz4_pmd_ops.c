@@ -0,0 +1,331 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include <string.h>
+
+#include <dev_driver.h>
+#include <rte_common.h>
+#include <rte_malloc.h>
+
+#include "lz4_pmd_private.h"
+
+static const struct rte_compressdev_capabilities lz4_pmd_capabilities[] = {
+	{   /* LZ4 */
+		.algo = RTE_COMP_ALGO_LZ4,
+		.comp_feature_flags = (RTE_COMP_FF_OOP_SGL_IN_SGL_OUT |
+					RTE_COMP_FF_OOP_SGL_IN_LB_OUT |
+					RTE_COMP_FF_OOP_LB_IN_SGL_OUT |
+					RTE_COMP_FF_SHAREABLE_PRIV_XFORM |
+					RTE_COMP_FF_LZ4_CONTENT_WITH_CHECKSUM |
+					RTE_COMP_FF_LZ4_CONTENT_SIZE |
+					RTE_COMP_FF_LZ4_BLOCK_INDEPENDENCE |
+					RTE_COMP_FF_LZ4_BLOCK_WITH_CHECKSUM |
+					RTE_COMP_FF_LZ4_RAW_BLOCK),
+		.window_size = {
+			.min = LZ4_PMD_WINDOW_LOG,
+			.max = LZ4_PMD_WINDOW_LOG,
+			.increment = 0
+		},
+	},
+
+	RTE_COMP_END_OF_CAPABILITIES_LIST()
+
+};
+
+/** Configure device */
+static int
+lz4_pmd_config(struct rte_compressdev *dev,
+		struct rte_compressdev_config *config)
+{
+	struct rte_mempool *mp;
+	char mp_name[RTE_MEMPOOL_NAMESIZE];
+	struct lz4_private *internals = dev->data->dev_private;
+
+	snprintf(mp_name, RTE_MEMPOOL_NAMESIZE,
+			"stream_mp_%u", dev->data->dev_id);
+	mp = internals->mp;
+	if (mp == NULL) {
+		mp = rte_mempool_create(mp_name,
+				config->max_nb_priv_xforms,
+				sizeof(struct lz4_priv_xform),
+				0, 0, NULL, NULL, NULL,
+				NULL, config->socket_id,
+				0);
+		if (mp == NULL) {
+			LZ4_PMD_ERR("Cannot create private xform pool on socket %d",
+				config->socket_id);
+			return -ENOMEM;
+		}
+		internals->mp = mp;
+	}
+	return 0;
+}
+
+/** Start device */
+static int
+lz4_pmd_start(__rte_unused struct rte_compressdev *dev)
+{
+	return 0;
+}
+
+/** Stop device */
+static void
+lz4_pmd_stop(__rte_unused struct rte_compressdev *dev)
+{
+}
+
+/** Close device */
+static int
+lz4_pmd_close(struct rte_compressdev *dev)
+{
+	struct lz4_private *internals = dev->data->dev_private;
+	rte_mempool_free(internals->mp);
+	internals->mp = NULL;
+	return 0;
+}
+
+/** Get device statistics */
+static void
+lz4_pmd_stats_get(struct rte_compressdev *dev,
+		struct rte_compressdev_stats *stats)
+{
+	int qp_id;
+
+	for (qp_id = 0; qp_id < dev->data->nb_queue_pairs; qp_id++) {
+		struct lz4_qp *qp = dev->data->queue_pairs[qp_id];
+
+		stats->enqueued_count += qp->qp_stats.enqueued_count;
+		stats->dequeued_count += qp->qp_stats.dequeued_count;
+
+		stats->enqueue_err_count += qp->qp_stats.enqueue_err_count;
+		stats->dequeue_err_count += qp->qp_stats.dequeue_err_count;
+	}
+}
+
+/** Reset device statistics */
+static void
+lz4_pmd_stats_reset(struct rte_compressdev *dev)
+{
+	int qp_id;
+
+	for (qp_id = 0; qp_id < dev->data->nb_queue_pairs; qp_id++) {
+		struct lz4_qp *qp = dev->data->queue_pairs[qp_id];
+
+		memset(&qp->qp_stats, 0, sizeof(qp->qp_stats));
+	}
+}
+
+/** Get device info */
+static void
+lz4_pmd_info_get(struct rte_compressdev *dev,
+		struct rte_compressdev_info *dev_info)
+{
+	if (dev_info != NULL) {
+		dev_info->driver_name = dev->device->name;
+		dev_info->feature_flags = dev->feature_flags;
+		dev_info->capabilities = lz4_pmd_capabilities;
+	}
+}
+
+/** Release queue pair */
+static int
+lz4_pmd_qp_release(struct rte_compressdev *dev, uint16_t qp_id)
+{
+	struct lz4_qp *qp = dev->data->queue_pairs[qp_id];
+
+	if (qp != NULL) {
+		rte_ring_free(qp->pending_ops);
+		LZ4F_freeCompressionContext(qp->cctx);
+		LZ4F_freeDecompressionContext(qp->dctx);
+		rte_free(qp->state);
+		rte_free(qp->state_hc);
+		rte_free(qp->frame_buf.data);
+		rte_free(qp->in_buf.data);
+		rte_free(qp->out_buf.data);
+		rte_free(qp);
+		dev->data->queue_pairs[qp_id] = NULL;
+	}
+	return 0;
+}
+
+/** set a unique name for the queue pair based on its name, dev_id and qp_id */
+static int
+lz4_pmd_qp_set_unique_name(struct rte_compressdev *dev,
+		struct lz4_qp *qp)
+{
+	unsigned int n = snprintf(qp->name, sizeof(qp->name),
+				"lz4_pmd_%u_qp_%u",
+				dev->data->dev_id, qp->id);
+
+	if (n >= sizeof(qp->name))
+		return -1;
+
+	return 0;
+}
+
+/** Create a ring to hold the operations until they are dequeued */
+static struct rte_ring *
+lz4_pmd_qp_create_pending_ops_ring(struct lz4_qp *qp,
+		unsigned int ring_size, int socket_id)
+{
+	struct rte_ring *r = qp->pending_ops;
+
+	if (r) {
+		if (rte_ring_get_size(r) >= ring_size) {
+			LZ4_PMD_INFO("Reusing existing ring %s for pending"
+					" operations", qp->name);
+			return r;
+		}
+
+		LZ4_PMD_ERR("Unable to reuse existing ring %s for pending"
+				" operations", qp->name);
+		return NULL;
+	}
+
+	return rte_ring_create(qp->name, ring_size, socket_id,
+						RING_F_EXACT_SZ);
+}
+
+/** Setup a queue pair */
+static int
+lz4_pmd_qp_setup(struct rte_compressdev *dev, uint16_t qp_id,
+		uint32_t max_inflight_ops, int socket_id)
+{
+	struct lz4_qp *qp = NULL;
+	LZ4F_preferences_t prefs;
+	size_t frame_buf_size;
+
+	/* Free memory prior to re-allocation if needed. */
+	if (dev->data->queue_pairs[qp_id] != NULL)
+		lz4_pmd_qp_release(dev, qp_id);
+
+	/* Allocate the queue pair data structure. */
+	qp = rte_zmalloc_socket("LZ4 PMD Queue Pair", sizeof(*qp),
+					RTE_CACHE_LINE_SIZE, socket_id);
+	if (qp == NULL)
+		return (-ENOMEM);
+
+	qp->id = qp_id;
+	dev->data->queue_pairs[qp_id] = qp;
+
+	if (lz4_pmd_qp_set_unique_name(dev, qp))
+		goto qp_setup_cleanup;
+
+	qp->pending_ops = lz4_pmd_qp_create_pending_ops_ring(qp,
+			max_inflight_ops, socket_id);
+	if (qp->pending_ops == NULL)
+		goto qp_setup_cleanup;
+
+	qp->socket_id = socket_id;
+	if (LZ4F_isError(LZ4F_createCompressionContext(&qp->cctx,
+			LZ4F_VERSION)) ||
+			LZ4F_isError(LZ4F_createDecompressionContext(&qp->dctx,
+			LZ4F_VERSION)))
+		goto qp_setup_cleanup;
+
+	qp->state = rte_malloc_socket("LZ4 PMD state", LZ4_sizeofState(),
+			RTE_CACHE_LINE_SIZE, socket_id);
+	qp->state_hc = rte_malloc_socket("LZ4 PMD HC state",
+			LZ4_sizeofStateHC(), RTE_CACHE_LINE_SIZE, socket_id);
+	if (qp->state == NULL || qp->state_hc == NULL)
+		goto qp_setup_cleanup;
+
+	/* Frame output of one chunk with all options, which also covers
+	 * the frame header and end mark.
+	 */
+	memset(&prefs, 0, sizeof(prefs));
+	prefs.frameInfo.blockSizeID = LZ4F_max64KB;
+	prefs.frameInfo.contentChecksumFlag = LZ4F_contentChecksumEnabled;
+	prefs.frameInfo.blockChecksumFlag = LZ4F_blockChecksumEnabled;
+	frame_buf_size = RTE_MAX(LZ4F_compressBound(LZ4_PMD_CHUNK_SIZE, &prefs),
+			(size_t)LZ4F_HEADER_SIZE_MAX);
+	qp->frame_buf.data = rte_malloc_socket("LZ4 PMD frame buffer",
+			frame_buf_size, 0, socket_id);
+	if (qp->frame_buf.data == NULL)
+		goto qp_setup_cleanup;
+	qp->frame_buf.size = frame_buf_size;
+
+	memset(&qp->qp_stats, 0, sizeof(qp->qp_stats));
+	return 0;
+
+qp_setup_cleanup:
+	lz4_pmd_qp_release(dev, qp_id);
+	return -1;
+}
+
+/** Configure private xform */
+static int
+lz4_pmd_private_xform_create(struct rte_compressdev *dev,
+		const struct rte_comp_xform *xform,
+		void **private_xform)
+{
+	int ret = 0;
+	struct lz4_priv_xform *priv_xform;
+	struct lz4_private *internals = dev->data->dev_private;
+
+	if (xform == NULL) {
+		LZ4_PMD_ERR("invalid xform struct");
+		return -EINVAL;
+	}
+
+	if (rte_mempool_get(internals->mp, private_xform)) {
+		LZ4_PMD_ERR("Couldn't get object from session mempool");
+		return -ENOMEM;
+	}
+	priv_xform = *((struct lz4_priv_xform **)private_xform);
+
+	ret = lz4_set_priv_xform_parameters(xform, priv_xform);
+
+	if (ret < 0) {
+		LZ4_PMD_ERR("failed configure session parameters");
+
+		memset(priv_xform, 0, sizeof(struct lz4_priv_xform));
+		/* Return private xform to mempool */
+		rte_mempool_put(internals->mp, priv_xform);
+		return ret;
+	}
+
+	return 0;
+}
+
+/** Clear the memory of private xform and return it to its mempool */
+static int
+lz4_pmd_private_xform_free(__rte_unused struct rte_compressdev *dev,
+		void *private_xform)
+{
+	struct lz4_priv_xform *priv_xform = private_xform;
+	struct rte_mempool *mp;
+
+	if (!priv_xform)
+		return -EINVAL;
+
+	memset(priv_xform, 0, sizeof(struct lz4_priv_xform));
+	mp = rte_mempool_from_obj(priv_xform);
+	rte_mempool_put(mp, priv_xform);
+
+	return 0;
+}
+
+struct rte_compressdev_ops lz4_pmd_ops = {
+		.dev_configure		= lz4_pmd_config,
+		.dev_start		= lz4_pmd_start,
+		.dev_stop		= lz4_pmd_stop,
+		.dev_close		= lz4_pmd_close,
+
+		.stats_get		= lz4_pmd_stats_get,
+		.stats_reset		= lz4_pmd_stats_reset,
+
+		.dev_infos_get		= lz4_pmd_info_get,
+
+		.queue_pair_setup	= lz4_pmd_qp_setup,
+		.queue_pair_release	= lz4_pmd_qp_release,
+
+		.private_xform_create	= lz4_pmd_private_xform_create,
+		.private_xform_free	= lz4_pmd_private_xform_free,
+
+		.stream_create	= NULL,
+		.stream_free	= NULL
+};
+
+struct rte_compressdev_ops *rte_lz4_pmd_ops = &lz4_pmd_ops;
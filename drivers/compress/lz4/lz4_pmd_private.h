@@ -0,0 +1,92 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#ifndef _LZ4_PMD_PRIVATE_H_
+#define _LZ4_PMD_PRIVATE_H_
+
+#include <lz4.h>
+#include <lz4hc.h>
+#include <lz4frame.h>
+#include <rte_compressdev.h>
+#include <rte_compressdev_pmd.h>
+
+#define COMPRESSDEV_NAME_LZ4_PMD	compress_lz4
+/**< LZ4 PMD device name */
+
+#define LZ4_PMD_WINDOW_LOG		16
+/**< LZ4 window is always 64K */
+
+#define LZ4_PMD_CHUNK_SIZE		(64 * 1024)
+/**< Largest input given to the frame compressor in one call */
+
+#define LZ4_PMD_HC_MIN_LEVEL		3
+/**< Lowest level using the high compression match finder */
+
+extern int lz4_logtype_driver;
+#define RTE_LOGTYPE_LZ4_DRIVER lz4_logtype_driver
+#define LZ4_PMD_LOG(level, ...) \
+	RTE_LOG_LINE_PREFIX(level, LZ4_DRIVER, "%s(): ", __func__, __VA_ARGS__)
+
+#define LZ4_PMD_INFO(fmt, ...) \
+	LZ4_PMD_LOG(INFO, fmt, ## __VA_ARGS__)
+#define LZ4_PMD_ERR(fmt, ...) \
+	LZ4_PMD_LOG(ERR, fmt, ## __VA_ARGS__)
+#define LZ4_PMD_WARN(fmt, ...) \
+	LZ4_PMD_LOG(WARNING, fmt, ## __VA_ARGS__)
+
+struct lz4_private {
+	struct rte_mempool *mp;
+};
+
+/** Linear work buffer, grown on demand */
+struct lz4_buf {
+	uint8_t *data;
+	size_t size;
+};
+
+struct __rte_cache_aligned lz4_qp {
+	struct rte_ring *pending_ops;
+	/**< Ring of operations enqueued and not processed yet */
+	struct rte_compressdev_stats qp_stats;
+	/**< Queue pair statistics */
+	LZ4F_cctx *cctx;
+	/**< Frame compression context */
+	LZ4F_dctx *dctx;
+	/**< Frame decompression context */
+	void *state;
+	/**< Raw block fast compression state */
+	void *state_hc;
+	/**< Raw block high compression state */
+	struct lz4_buf frame_buf;
+	/**< Output of the frame compressor when a segment is too small */
+	struct lz4_buf in_buf;
+	/**< Linearized source of raw block operations */
+	struct lz4_buf out_buf;
+	/**< Linear destination of raw block operations */
+	int socket_id;
+	/**< Socket of the work buffers */
+	uint16_t id;
+	/**< Queue Pair Identifier */
+	char name[RTE_COMPRESSDEV_NAME_MAX_LEN];
+	/**< Unique Queue Pair Name */
+};
+
+/** LZ4 private xform structure, shareable between queue pairs */
+struct __rte_cache_aligned lz4_priv_xform {
+	enum rte_comp_xform_type type;
+	/**< Compression or decompression */
+	int level;
+	/**< liblz4 compression level, 0 for the fast compressor */
+	uint8_t flags;
+	/**< RTE_COMP_LZ4_FLAG_* flags */
+};
+
+int
+lz4_set_priv_xform_parameters(const struct rte_comp_xform *xform,
+		struct lz4_priv_xform *priv_xform);
+
+/** Device specific operations function pointer structure */
+extern struct rte_compressdev_ops *rte_lz4_pmd_ops;
+
+#endif /* _LZ4_PMD_PRIVATE_H_ */
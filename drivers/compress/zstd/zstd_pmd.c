@@ -0,0 +1,549 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include <bus_vdev_driver.h>
+#include <rte_common.h>
+
+#include "zstd_pmd_private.h"
+
+/** Position in a chain of mbuf segments */
+struct zstd_seg {
+	struct rte_mbuf *m;
+	uint8_t *data;
+	uint32_t len;
+	uint32_t left;
+	/**< Bytes left in the following segments, UINT32_MAX if unbounded */
+};
+
+/** Point to the segment containing offset, returns -1 if out of the chain */
+static int
+zstd_seg_init(struct zstd_seg *seg, struct rte_mbuf *m, uint32_t offset,
+		uint32_t length)
+{
+	while (m != NULL && offset >= rte_pktmbuf_data_len(m) &&
+			m->next != NULL) {
+		offset -= rte_pktmbuf_data_len(m);
+		m = m->next;
+	}
+	if (m == NULL || offset > rte_pktmbuf_data_len(m))
+		return -1;
+
+	seg->m = m;
+	seg->data = rte_pktmbuf_mtod_offset(m, uint8_t *, offset);
+	seg->len = rte_pktmbuf_data_len(m) - offset;
+	seg->left = UINT32_MAX;
+	if (length != UINT32_MAX) {
+		seg->len = RTE_MIN(seg->len, length);
+		seg->left = length - seg->len;
+	}
+	return 0;
+}
+
+/** Move to the next segment, returns 0 at the end of the chain or length */
+static int
+zstd_seg_next(struct zstd_seg *seg)
+{
+	struct rte_mbuf *m = seg->m->next;
+
+	if (m == NULL || seg->left == 0)
+		return 0;
+
+	seg->m = m;
+	seg->data = rte_pktmbuf_mtod(m, uint8_t *);
+	seg->len = rte_pktmbuf_data_len(m);
+	if (seg->left != UINT32_MAX) {
+		seg->len = RTE_MIN(seg->len, seg->left);
+		seg->left -= seg->len;
+	}
+	return 1;
+}
+
+static inline bool
+zstd_seg_last(const struct zstd_seg *seg)
+{
+	return seg->left == 0 ||
+		(seg->left == UINT32_MAX && seg->m->next == NULL);
+}
+
+static void
+process_zstd_compress(struct rte_comp_op *op, ZSTD_CCtx *cctx, bool stateful)
+{
+	ZSTD_EndDirective end_op;
+	struct zstd_seg src, dst;
+	ZSTD_inBuffer in;
+	ZSTD_outBuffer out;
+	size_t ret;
+
+	switch (op->flush_flag) {
+	case RTE_COMP_FLUSH_NONE:
+		end_op = ZSTD_e_continue;
+		break;
+	case RTE_COMP_FLUSH_SYNC:
+	case RTE_COMP_FLUSH_FULL:
+		end_op = ZSTD_e_flush;
+		break;
+	case RTE_COMP_FLUSH_FINAL:
+		end_op = ZSTD_e_end;
+		break;
+	default:
+		op->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
+		ZSTD_PMD_ERR("Invalid flush value");
+		return;
+	}
+	/* A stateless operation always produces a complete frame. */
+	if (!stateful)
+		end_op = ZSTD_e_end;
+
+	if (zstd_seg_init(&src, op->m_src, op->src.offset, op->src.length) ||
+			zstd_seg_init(&dst, op->m_dst, op->dst.offset,
+				UINT32_MAX)) {
+		op->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
+		ZSTD_PMD_ERR("Invalid source or destination buffers");
+		return;
+	}
+
+	in = (ZSTD_inBuffer){ src.data, src.len, 0 };
+	out = (ZSTD_outBuffer){ dst.data, dst.len, 0 };
+	op->status = RTE_COMP_OP_STATUS_SUCCESS;
+
+	for (;;) {
+		bool last = zstd_seg_last(&src);
+
+		ret = ZSTD_compressStream2(cctx, &out, &in,
+				last ? end_op : ZSTD_e_continue);
+		if (ZSTD_isError(ret)) {
+			ZSTD_PMD_ERR("Compression failed: %s",
+					ZSTD_getErrorName(ret));
+			op->status = RTE_COMP_OP_STATUS_ERROR;
+			break;
+		}
+
+		if (in.pos == in.size) {
+			/* Last input consumed and flushed as requested. */
+			if (last && (end_op == ZSTD_e_continue || ret == 0))
+				break;
+			if (!last) {
+				op->consumed += in.pos;
+				zstd_seg_next(&src);
+				in = (ZSTD_inBuffer){ src.data, src.len, 0 };
+				continue;
+			}
+		}
+
+		if (out.pos == out.size) {
+			op->produced += out.pos;
+			if (zstd_seg_next(&dst) == 0) {
+				out.pos = 0;
+				op->status = stateful ?
+					RTE_COMP_OP_STATUS_OUT_OF_SPACE_RECOVERABLE :
+					RTE_COMP_OP_STATUS_OUT_OF_SPACE_TERMINATED;
+				break;
+			}
+			out = (ZSTD_outBuffer){ dst.data, dst.len, 0 };
+		}
+	}
+
+	if (op->status == RTE_COMP_OP_STATUS_OUT_OF_SPACE_TERMINATED ||
+			op->status == RTE_COMP_OP_STATUS_ERROR) {
+		op->consumed = 0;
+		op->produced = 0;
+		ZSTD_CCtx_reset(cctx, ZSTD_reset_session_only);
+		return;
+	}
+
+	op->consumed += in.pos;
+	op->produced += out.pos;
+}
+
+static void
+process_zstd_decompress(struct rte_comp_op *op, ZSTD_DCtx *dctx, bool stateful)
+{
+	struct zstd_seg src, dst;
+	ZSTD_inBuffer in;
+	ZSTD_outBuffer out;
+	size_t ret = 0;
+
+	if (zstd_seg_init(&src, op->m_src, op->src.offset, op->src.length) ||
+			zstd_seg_init(&dst, op->m_dst, op->dst.offset,
+				UINT32_MAX)) {
+		op->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
+		ZSTD_PMD_ERR("Invalid source or destination buffers");
+		return;
+	}
+
+	in = (ZSTD_inBuffer){ src.data, src.len, 0 };
+	out = (ZSTD_outBuffer){ dst.data, dst.len, 0 };
+	op->status = RTE_COMP_OP_STATUS_SUCCESS;
+
+	for (;;) {
+		ret = ZSTD_decompressStream(dctx, &out, &in);
+		if (ZSTD_isError(ret)) {
+			ZSTD_PMD_ERR("Decompression failed: %s",
+					ZSTD_getErrorName(ret));
+			op->status = ZSTD_getErrorCode(ret) ==
+				ZSTD_error_checksum_wrong ?
+				RTE_COMP_OP_STATUS_CHECKSUM_VALIDATION_FAILED :
+				RTE_COMP_OP_STATUS_ERROR;
+			break;
+		}
+
+		/* Output full: either more output is pending or the frame
+		 * may have ended exactly at the end of the buffer.
+		 */
+		if (out.pos == out.size &&
+				(ret != 0 || in.pos != in.size ||
+				 !zstd_seg_last(&src))) {
+			op->produced += out.pos;
+			if (zstd_seg_next(&dst) == 0) {
+				out.pos = 0;
+				op->status = stateful ?
+					RTE_COMP_OP_STATUS_OUT_OF_SPACE_RECOVERABLE :
+					RTE_COMP_OP_STATUS_OUT_OF_SPACE_TERMINATED;
+				break;
+			}
+			out = (ZSTD_outBuffer){ dst.data, dst.len, 0 };
+			continue;
+		}
+
+		if (in.pos == in.size) {
+			if (zstd_seg_last(&src))
+				break;
+			op->consumed += in.pos;
+			zstd_seg_next(&src);
+			in = (ZSTD_inBuffer){ src.data, src.len, 0 };
+		}
+	}
+
+	/* A stateless operation must hold complete frames. */
+	if (!stateful && op->status == RTE_COMP_OP_STATUS_SUCCESS && ret != 0) {
+		ZSTD_PMD_ERR("Truncated frame");
+		op->status = RTE_COMP_OP_STATUS_ERROR;
+	}
+
+	if (op->status != RTE_COMP_OP_STATUS_SUCCESS &&
+			op->status != RTE_COMP_OP_STATUS_OUT_OF_SPACE_RECOVERABLE) {
+		op->consumed = 0;
+		op->produced = 0;
+		ZSTD_DCtx_reset(dctx, ZSTD_reset_session_only);
+		return;
+	}
+
+	op->consumed += in.pos;
+	op->produced += out.pos;
+}
+
+/** Process comp operation for mbuf */
+static inline int
+process_zstd_op(struct zstd_qp *qp, struct rte_comp_op *op)
+{
+	struct zstd_stream *stream;
+
+	op->consumed = 0;
+	op->produced = 0;
+
+	if (op->op_type == RTE_COMP_OP_STATEFUL) {
+		stream = op->stream;
+		if (stream->type == RTE_COMP_COMPRESS) {
+			process_zstd_compress(op, stream->cctx, true);
+			/* Next operation starts a new frame. */
+			if (op->flush_flag == RTE_COMP_FLUSH_FINAL &&
+					op->status == RTE_COMP_OP_STATUS_SUCCESS)
+				ZSTD_CCtx_reset(stream->cctx,
+						ZSTD_reset_session_only);
+		} else {
+			process_zstd_decompress(op, stream->dctx, true);
+		}
+	} else {
+		stream = op->private_xform;
+		if (stream->type == RTE_COMP_COMPRESS) {
+			if (zstd_cctx_init(qp->cctx, stream) < 0)
+				op->status = RTE_COMP_OP_STATUS_ERROR;
+			else
+				process_zstd_compress(op, qp->cctx, false);
+		} else {
+			if (zstd_dctx_init(qp->dctx, stream) < 0)
+				op->status = RTE_COMP_OP_STATUS_ERROR;
+			else
+				process_zstd_decompress(op, qp->dctx, false);
+		}
+	}
+
+	/* whatever is out of op, put it into completion queue with
+	 * its status
+	 */
+	return rte_ring_enqueue(qp->processed_pkts, (void *)op);
+}
+
+/** Apply stream parameters to a compression context */
+int
+zstd_cctx_init(ZSTD_CCtx *cctx, const struct zstd_stream *stream)
+{
+	size_t ret;
+
+	ZSTD_CCtx_reset(cctx, ZSTD_reset_session_and_parameters);
+	ret = ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel,
+			stream->level);
+	if (!ZSTD_isError(ret))
+		ret = ZSTD_CCtx_setParameter(cctx, ZSTD_c_windowLog,
+				stream->window_log);
+	if (!ZSTD_isError(ret))
+		ret = ZSTD_CCtx_setParameter(cctx, ZSTD_c_checksumFlag,
+				stream->checksum);
+	if (!ZSTD_isError(ret) && stream->cdict != NULL)
+		ret = ZSTD_CCtx_refCDict(cctx, stream->cdict);
+	if (ZSTD_isError(ret)) {
+		ZSTD_PMD_ERR("Compression context setup failed: %s",
+				ZSTD_getErrorName(ret));
+		return -1;
+	}
+	return 0;
+}
+
+/** Apply stream parameters to a decompression context */
+int
+zstd_dctx_init(ZSTD_DCtx *dctx, const struct zstd_stream *stream)
+{
+	size_t ret;
+
+	/*
+	 * The window size of the xform is only a hint: frames are accepted
+	 * up to the largest window the PMD supports.
+	 */
+	ZSTD_DCtx_reset(dctx, ZSTD_reset_session_and_parameters);
+	ret = ZSTD_DCtx_setParameter(dctx, ZSTD_d_windowLogMax,
+			ZSTD_PMD_MAX_WINDOW_LOG);
+	if (!ZSTD_isError(ret) && stream->ddict != NULL)
+		ret = ZSTD_DCtx_refDDict(dctx, stream->ddict);
+	if (ZSTD_isError(ret)) {
+		ZSTD_PMD_ERR("Decompression context setup failed: %s",
+				ZSTD_getErrorName(ret));
+		return -1;
+	}
+	return 0;
+}
+
+void
+zstd_free_stream(struct zstd_stream *stream)
+{
+	ZSTD_freeCCtx(stream->cctx);
+	ZSTD_freeDCtx(stream->dctx);
+	ZSTD_freeCDict(stream->cdict);
+	ZSTD_freeDDict(stream->ddict);
+}
+
+/** Parse comp xform and set private xform/Stream parameters */
+int
+zstd_set_stream_parameters(const struct rte_comp_xform *xform,
+		struct zstd_stream *stream, bool stateful)
+{
+	const struct rte_comp_zstd_params *params;
+	enum rte_comp_checksum_type chksum;
+	int ret;
+
+	memset(stream, 0, sizeof(*stream));
+	stream->type = xform->type;
+	stream->stateful = stateful;
+
+	switch (xform->type) {
+	case RTE_COMP_COMPRESS:
+		if (xform->compress.algo != RTE_COMP_ALGO_ZSTD) {
+			ZSTD_PMD_ERR("Compression algorithm not supported");
+			return -ENOTSUP;
+		}
+		params = &xform->compress.zstd;
+		chksum = xform->compress.chksum;
+		stream->window_log = xform->compress.window_size;
+
+		/** Compression Level, passed through to keep the zstd scale */
+		switch (xform->compress.level) {
+		case RTE_COMP_LEVEL_PMD_DEFAULT:
+			stream->level = ZSTD_CLEVEL_DEFAULT;
+			break;
+		default:
+			stream->level = xform->compress.level;
+			if (stream->level < RTE_COMP_LEVEL_MIN ||
+					stream->level > ZSTD_maxCLevel()) {
+				ZSTD_PMD_ERR("Compression level %d not supported",
+						stream->level);
+				return -ENOTSUP;
+			}
+			break;
+		}
+		break;
+	case RTE_COMP_DECOMPRESS:
+		if (xform->decompress.algo != RTE_COMP_ALGO_ZSTD) {
+			ZSTD_PMD_ERR("Compression algorithm not supported");
+			return -ENOTSUP;
+		}
+		params = &xform->decompress.zstd;
+		chksum = xform->decompress.chksum;
+		stream->window_log = xform->decompress.window_size;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if (chksum != RTE_COMP_CHECKSUM_NONE) {
+		ZSTD_PMD_ERR("Checksum not supported");
+		return -ENOTSUP;
+	}
+	if (stream->window_log < ZSTD_PMD_MIN_WINDOW_LOG ||
+			stream->window_log > ZSTD_PMD_MAX_WINDOW_LOG) {
+		ZSTD_PMD_ERR("Window size %d not supported", stream->window_log);
+		return -ENOTSUP;
+	}
+	stream->checksum = !!(params->flags & RTE_COMP_ZSTD_FLAG_CONTENT_CHECKSUM);
+
+	if (params->dictionary != NULL && params->dictionary_len != 0) {
+		if (stream->type == RTE_COMP_COMPRESS)
+			stream->cdict = ZSTD_createCDict(params->dictionary,
+					params->dictionary_len, stream->level);
+		else
+			stream->ddict = ZSTD_createDDict(params->dictionary,
+					params->dictionary_len);
+		if (stream->cdict == NULL && stream->ddict == NULL) {
+			ZSTD_PMD_ERR("Dictionary load failed");
+			return -EINVAL;
+		}
+	}
+
+	if (!stateful)
+		return 0;
+
+	/* Streams own their context, set up once for all their frames. */
+	if (stream->type == RTE_COMP_COMPRESS) {
+		stream->cctx = ZSTD_createCCtx();
+		ret = stream->cctx == NULL ? -1 :
+			zstd_cctx_init(stream->cctx, stream);
+	} else {
+		stream->dctx = ZSTD_createDCtx();
+		ret = stream->dctx == NULL ? -1 :
+			zstd_dctx_init(stream->dctx, stream);
+	}
+	if (ret < 0) {
+		zstd_free_stream(stream);
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+static uint16_t
+zstd_pmd_enqueue_burst(void *queue_pair,
+			struct rte_comp_op **ops, uint16_t nb_ops)
+{
+	struct zstd_qp *qp = queue_pair;
+	int ret;
+	uint16_t i;
+	uint16_t enqd = 0;
+
+	for (i = 0; i < nb_ops; i++) {
+		ret = process_zstd_op(qp, ops[i]);
+		if (unlikely(ret < 0)) {
+			/* increment count if failed to push to completion
+			 * queue
+			 */
+			qp->qp_stats.enqueue_err_count++;
+		} else {
+			qp->qp_stats.enqueued_count++;
+			enqd++;
+		}
+	}
+	return enqd;
+}
+
+static uint16_t
+zstd_pmd_dequeue_burst(void *queue_pair,
+			struct rte_comp_op **ops, uint16_t nb_ops)
+{
+	struct zstd_qp *qp = queue_pair;
+	unsigned int nb_dequeued;
+
+	nb_dequeued = rte_ring_dequeue_burst(qp->processed_pkts,
+			(void **)ops, nb_ops, NULL);
+	qp->qp_stats.dequeued_count += nb_dequeued;
+
+	return nb_dequeued;
+}
+
+static int
+zstd_create(const char *name,
+		struct rte_vdev_device *vdev,
+		struct rte_compressdev_pmd_init_params *init_params)
+{
+	struct rte_compressdev *dev;
+
+	dev = rte_compressdev_pmd_create(name, &vdev->device,
+			sizeof(struct zstd_private), init_params);
+	if (dev == NULL) {
+		ZSTD_PMD_ERR("driver %s: create failed", init_params->name);
+		return -ENODEV;
+	}
+
+	dev->dev_ops = rte_zstd_pmd_ops;
+
+	/* register rx/tx burst functions for data path */
+	dev->dequeue_burst = zstd_pmd_dequeue_burst;
+	dev->enqueue_burst = zstd_pmd_enqueue_burst;
+
+	ZSTD_PMD_INFO("Using zstd %s", ZSTD_versionString());
+
+	return 0;
+}
+
+static int
+zstd_probe(struct rte_vdev_device *vdev)
+{
+	struct rte_compressdev_pmd_init_params init_params = {
+		"",
+		rte_socket_id()
+	};
+	const char *name;
+	const char *input_args;
+	int retval;
+
+	name = rte_vdev_device_name(vdev);
+
+	if (name == NULL)
+		return -EINVAL;
+
+	input_args = rte_vdev_device_args(vdev);
+
+	retval = rte_compressdev_pmd_parse_input_args(&init_params, input_args);
+	if (retval < 0) {
+		ZSTD_PMD_LOG(ERR,
+			"Failed to parse initialisation arguments[%s]",
+			input_args);
+		return -EINVAL;
+	}
+
+	return zstd_create(name, vdev, &init_params);
+}
+
+static int
+zstd_remove(struct rte_vdev_device *vdev)
+{
+	struct rte_compressdev *compressdev;
+	const char *name;
+
+	name = rte_vdev_device_name(vdev);
+	if (name == NULL)
+		return -EINVAL;
+
+	compressdev = rte_compressdev_pmd_get_named_dev(name);
+	if (compressdev == NULL)
+		return -ENODEV;
+
+	return rte_compressdev_pmd_destroy(compressdev);
+}
+
+static struct rte_vdev_driver zstd_pmd_drv = {
+	.probe = zstd_probe,
+	.remove = zstd_remove
+};
+
+RTE_PMD_REGISTER_VDEV(COMPRESSDEV_NAME_ZSTD_PMD, zstd_pmd_drv);
+RTE_PMD_REGISTER_PARAM_STRING(COMPRESSDEV_NAME_ZSTD_PMD,
+	"socket_id=<int>");
+RTE_LOG_REGISTER_DEFAULT(zstd_logtype_driver, INFO);
@@ -0,0 +1,97 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#ifndef _ZSTD_PMD_PRIVATE_H_
+#define _ZSTD_PMD_PRIVATE_H_
+
+#include <stdbool.h>
+
+#include <zstd.h>
+#include <zstd_errors.h>
+#include <rte_compressdev.h>
+#include <rte_compressdev_pmd.h>
+
+#define COMPRESSDEV_NAME_ZSTD_PMD	compress_zstd
+/**< ZSTD PMD device name */
+
+#define ZSTD_PMD_MIN_WINDOW_LOG		10
+/**< Smallest window supported by the zstd format */
+#define ZSTD_PMD_MAX_WINDOW_LOG		27
+/**< Largest window accepted by default by zstd decoders */
+
+extern int zstd_logtype_driver;
+#define RTE_LOGTYPE_ZSTD_DRIVER zstd_logtype_driver
+#define ZSTD_PMD_LOG(level, ...) \
+	RTE_LOG_LINE_PREFIX(level, ZSTD_DRIVER, "%s(): ", __func__, __VA_ARGS__)
+
+#define ZSTD_PMD_INFO(fmt, ...) \
+	ZSTD_PMD_LOG(INFO, fmt, ## __VA_ARGS__)
+#define ZSTD_PMD_ERR(fmt, ...) \
+	ZSTD_PMD_LOG(ERR, fmt, ## __VA_ARGS__)
+#define ZSTD_PMD_WARN(fmt, ...) \
+	ZSTD_PMD_LOG(WARNING, fmt, ## __VA_ARGS__)
+
+struct zstd_private {
+	struct rte_mempool *mp;
+};
+
+struct __rte_cache_aligned zstd_qp {
+	struct rte_ring *processed_pkts;
+	/**< Ring for placing process packets */
+	struct rte_compressdev_stats qp_stats;
+	/**< Queue pair statistics */
+	ZSTD_CCtx *cctx;
+	/**< Compression context reused by stateless operations */
+	ZSTD_DCtx *dctx;
+	/**< Decompression context reused by stateless operations */
+	uint16_t id;
+	/**< Queue Pair Identifier */
+	char name[RTE_COMPRESSDEV_NAME_MAX_LEN];
+	/**< Unique Queue Pair Name */
+};
+
+/**
+ * ZSTD private xform and stream structure.
+ * Private xforms only hold parameters and can be shared, the operations
+ * run on the queue pair contexts. Streams own their contexts, which
+ * carry the frame state from one operation to the next.
+ */
+struct __rte_cache_aligned zstd_stream {
+	enum rte_comp_xform_type type;
+	/**< Compression or decompression */
+	int level;
+	/**< zstd compression level */
+	int window_log;
+	/**< Base two log of the window size */
+	int checksum;
+	/**< Frame content checksum enabled */
+	ZSTD_CDict *cdict;
+	/**< Digested compression dictionary */
+	ZSTD_DDict *ddict;
+	/**< Digested decompression dictionary */
+	bool stateful;
+	/**< Stream created by rte_compressdev_stream_create() */
+	ZSTD_CCtx *cctx;
+	/**< Compression context of a stateful stream */
+	ZSTD_DCtx *dctx;
+	/**< Decompression context of a stateful stream */
+};
+
+int
+zstd_set_stream_parameters(const struct rte_comp_xform *xform,
+		struct zstd_stream *stream, bool stateful);
+
+void
+zstd_free_stream(struct zstd_stream *stream);
+
+int
+zstd_cctx_init(ZSTD_CCtx *cctx, const struct zstd_stream *stream);
+
+int
+zstd_dctx_init(ZSTD_DCtx *dctx, const struct zstd_stream *stream);
+
+/** Device specific operations function pointer structure */
+extern struct rte_compressdev_ops *rte_zstd_pmd_ops;
+
+#endif /* _ZSTD_PMD_PRIVATE_H_ */
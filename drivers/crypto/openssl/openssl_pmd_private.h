@@ -78,6 +78,12 @@ struct __rte_cache_aligned openssl_qp {
 	 * by the driver when verifying a digest provided
 	 * by the user (using authentication verify operation)
 	 */
+#if (OPENSSL_VERSION_NUMBER >= 0x30500000L)
+	EVP_CIPHER_CTX *pipeline_ctx;
+	/**< Context of the pipelined operations, initialized
+	 * once per batch of operations sharing a session
+	 */
+#endif
 };
 
 struct evp_ctx_pair {
@@ -129,6 +135,12 @@ struct __rte_cache_aligned openssl_session {
 		EVP_CIPHER_CTX *ctx;
 		/**< pointer to EVP context structure */
 		EVP_CIPHER_CTX *bpi_ctx;
+#if (OPENSSL_VERSION_NUMBER >= 0x30500000L)
+		EVP_CIPHER *pipeline_algo;
+		/**< fetched algorithm if the provider supports pipelining
+		 * it, NULL otherwise
+		 */
+#endif
 	} cipher;
 
 	/** Authentication Parameters */
@@ -764,6 +764,33 @@ openssl_set_session_auth_parameters(struct openssl_session *sess,
 	return 0;
 }
 
+/*
+ * Fetch the provider implementation of the session cipher, kept only if it
+ * can process several buffers in one call. Decryption is not pipelined, as
+ * a tag mismatch is reported for the whole batch, not for each buffer.
+ */
+static void
+openssl_set_sess_pipeline(struct openssl_session *sess)
+{
+#if (OPENSSL_VERSION_NUMBER >= 0x30500000L)
+	EVP_CIPHER *algo;
+
+	algo = EVP_CIPHER_fetch(NULL,
+			EVP_CIPHER_get0_name(sess->cipher.evp_algo), NULL);
+	if (algo == NULL)
+		return;
+
+	if (EVP_CIPHER_can_pipeline(algo, 1) != 1) {
+		EVP_CIPHER_free(algo);
+		return;
+	}
+
+	sess->cipher.pipeline_algo = algo;
+#else
+	RTE_SET_USED(sess);
+#endif
+}
+
 /* Set session AEAD parameters */
 static int
 openssl_set_session_aead_parameters(struct openssl_session *sess,
@@ -790,11 +817,15 @@ openssl_set_session_aead_parameters(struct openssl_session *sess,
 
 	sess->aead_algo = xform->aead.algo;
 	/* Select cipher direction */
-	if (xform->aead.op == RTE_CRYPTO_AEAD_OP_ENCRYPT)
-		return openssl_set_sess_aead_enc_param(sess, xform->aead.algo,
-				xform->aead.digest_length, xform->aead.key.data,
-				&sess->cipher.ctx);
-	else
+	if (xform->aead.op == RTE_CRYPTO_AEAD_OP_ENCRYPT) {
+		int ret = openssl_set_sess_aead_enc_param(sess,
+				xform->aead.algo, xform->aead.digest_length,
+				xform->aead.key.data, &sess->cipher.ctx);
+
+		if (ret == 0 && xform->aead.algo == RTE_CRYPTO_AEAD_AES_GCM)
+			openssl_set_sess_pipeline(sess);
+		return ret;
+	} else
 		return openssl_set_sess_aead_dec_param(sess, xform->aead.algo,
 				xform->aead.digest_length, xform->aead.key.data,
 				&sess->cipher.ctx);
@@ -918,6 +949,11 @@ openssl_reset_session(struct openssl_session *sess)
 
 	if (sess->chain_order == OPENSSL_CHAIN_CIPHER_BPI)
 		EVP_CIPHER_CTX_free(sess->cipher.bpi_ctx);
+
+#if (OPENSSL_VERSION_NUMBER >= 0x30500000L)
+	EVP_CIPHER_free(sess->cipher.pipeline_algo);
+	sess->cipher.pipeline_algo = NULL;
+#endif
 }
 
 /** Provide session for operation */
@@ -4418,6 +4454,120 @@ process_op(struct openssl_qp *qp, struct rte_crypto_op *op,
 	return retval;
 }
 
+#if (OPENSSL_VERSION_NUMBER >= 0x30500000L)
+/**
+ * Count the operations at the head of the burst which can be pipelined
+ * with the first one: same session, linear buffers.
+ */
+static uint16_t
+openssl_pipeline_burst_len(struct rte_crypto_op **ops, uint16_t nb_ops,
+		struct openssl_session *sess)
+{
+	uint16_t i;
+
+	if (sess->cipher.pipeline_algo == NULL)
+		return 0;
+
+	nb_ops = RTE_MIN(nb_ops, EVP_MAX_PIPES);
+	for (i = 0; i < nb_ops; i++) {
+		struct rte_crypto_op *op = ops[i];
+
+		if (op->type != RTE_CRYPTO_OP_TYPE_SYMMETRIC ||
+				op->sess_type != RTE_CRYPTO_OP_WITH_SESSION ||
+				op->sym->session == NULL ||
+				CRYPTODEV_GET_SYM_SESS_PRIV(op->sym->session) !=
+						(void *)sess)
+			break;
+		if (!rte_pktmbuf_is_contiguous(op->sym->m_src) ||
+				(op->sym->m_dst != NULL &&
+				 !rte_pktmbuf_is_contiguous(op->sym->m_dst)))
+			break;
+		if (op->sym->aead.data.length == 0)
+			break;
+	}
+
+	return i;
+}
+
+/**
+ * Process a batch of AES-GCM encryptions of a session in one pipelined
+ * call, the context being initialized once for the whole batch.
+ * Return -ENOTSUP if the batch was left untouched and must be processed
+ * operation by operation.
+ */
+static int
+process_openssl_pipeline_enc(struct openssl_qp *qp,
+		struct rte_crypto_op **ops, uint16_t nb_ops,
+		struct openssl_session *sess)
+{
+	const unsigned char *iv[EVP_MAX_PIPES], *in[EVP_MAX_PIPES];
+	const unsigned char *aad[EVP_MAX_PIPES];
+	unsigned char *out[EVP_MAX_PIPES], *tag[EVP_MAX_PIPES];
+	size_t inl[EVP_MAX_PIPES], aadl[EVP_MAX_PIPES];
+	size_t outl[EVP_MAX_PIPES], outsize[EVP_MAX_PIPES];
+	EVP_CIPHER_CTX *ctx = qp->pipeline_ctx;
+	OSSL_PARAM params[2];
+	uint16_t i;
+
+	for (i = 0; i < nb_ops; i++) {
+		struct rte_crypto_sym_op *sym = ops[i]->sym;
+		struct rte_mbuf *mdst = sym->m_dst ? sym->m_dst : sym->m_src;
+		uint32_t offset = sym->aead.data.offset;
+
+		iv[i] = rte_crypto_op_ctod_offset(ops[i], uint8_t *,
+				sess->iv.offset);
+		in[i] = rte_pktmbuf_mtod_offset(sym->m_src, uint8_t *, offset);
+		inl[i] = sym->aead.data.length;
+		out[i] = rte_pktmbuf_mtod_offset(mdst, uint8_t *, offset);
+		outsize[i] = sym->aead.data.length;
+		aad[i] = sym->aead.aad.data;
+		aadl[i] = sess->auth.aad_length;
+		tag[i] = sym->aead.digest.data;
+		if (tag[i] == NULL)
+			tag[i] = out[i] + sym->aead.data.length;
+	}
+
+	if (EVP_CipherPipelineEncryptInit(ctx, sess->cipher.pipeline_algo,
+			sess->cipher.key.data, sess->cipher.key.length,
+			nb_ops, iv, sess->iv.length) != 1)
+		return -ENOTSUP;
+
+	if (sess->auth.aad_length > 0 &&
+			EVP_CipherPipelineUpdate(ctx, NULL, outl, NULL,
+				aad, aadl) != 1)
+		goto process_pipeline_err;
+
+	if (EVP_CipherPipelineUpdate(ctx, out, outl, outsize, in, inl) != 1)
+		goto process_pipeline_err;
+
+	for (i = 0; i < nb_ops; i++) {
+		out[i] += outl[i];
+		outsize[i] -= outl[i];
+	}
+
+	if (EVP_CipherPipelineFinal(ctx, out, outl, outsize) != 1)
+		goto process_pipeline_err;
+
+	params[0] = OSSL_PARAM_construct_octet_ptr(
+			OSSL_CIPHER_PARAM_PIPELINE_AEAD_TAG, (void **)tag,
+			sess->auth.digest_length);
+	params[1] = OSSL_PARAM_construct_end();
+	if (EVP_CIPHER_CTX_get_params(ctx, params) != 1)
+		goto process_pipeline_err;
+
+	for (i = 0; i < nb_ops; i++)
+		ops[i]->status = RTE_CRYPTO_OP_STATUS_SUCCESS;
+
+	return 0;
+
+process_pipeline_err:
+	OPENSSL_LOG(ERR, "Process openssl pipelined encryption failed");
+	for (i = 0; i < nb_ops; i++)
+		ops[i]->status = RTE_CRYPTO_OP_STATUS_ERROR;
+	return -EINVAL;
+}
+#endif
+
 /*
  *------------------------------------------------------------------------------
  * PMD Framework
@@ -4438,6 +4588,35 @@ openssl_pmd_enqueue_burst(void *queue_pair, struct rte_crypto_op **ops,
 		if (unlikely(sess == NULL))
 			goto enqueue_err;
 
+#if (OPENSSL_VERSION_NUMBER >= 0x30500000L)
+		if (ops[i]->type == RTE_CRYPTO_OP_TYPE_SYMMETRIC) {
+			uint16_t n = openssl_pipeline_burst_len(&ops[i],
+					nb_ops - i, sess);
+
+			/*
+			 * Encrypt only the operations which fit in the ring,
+			 * the others are retried by the application and would
+			 * be encrypted twice.
+			 */
+			n = RTE_MIN(n, rte_ring_free_count(qp->processed_ops));
+			retval = n > 1 ? process_openssl_pipeline_enc(qp,
+					&ops[i], n, sess) : -ENOTSUP;
+			if (retval == 0) {
+				uint16_t nb_enq = rte_ring_enqueue_burst(
+						qp->processed_ops,
+						(void **)&ops[i], n, NULL);
+
+				i += nb_enq;
+				if (unlikely(nb_enq < n))
+					goto enqueue_err;
+				i--;
+				continue;
+			}
+			if (unlikely(retval != -ENOTSUP))
+				goto enqueue_err;
+		}
+#endif
+
 		if (ops[i]->type == RTE_CRYPTO_OP_TYPE_SYMMETRIC)
 			retval = process_op(qp, ops[i],
 					(struct openssl_session *) sess);
@@ -801,6 +801,9 @@ openssl_pmd_qp_release(struct rte_cryptodev *dev, uint16_t qp_id)
 		struct openssl_qp *qp = dev->data->queue_pairs[qp_id];
 
 		rte_ring_free(qp->processed_ops);
+#if (OPENSSL_VERSION_NUMBER >= 0x30500000L)
+		EVP_CIPHER_CTX_free(qp->pipeline_ctx);
+#endif
 
 		rte_free(dev->data->queue_pairs[qp_id]);
 		dev->data->queue_pairs[qp_id] = NULL;
@@ -882,12 +885,21 @@ openssl_pmd_qp_setup(struct rte_cryptodev *dev, uint16_t qp_id,
 
 	qp->sess_mp = qp_conf->mp_session;
 
+#if (OPENSSL_VERSION_NUMBER >= 0x30500000L)
+	qp->pipeline_ctx = EVP_CIPHER_CTX_new();
+	if (qp->pipeline_ctx == NULL)
+		goto qp_setup_cleanup;
+#endif
+
 	memset(&qp->stats, 0, sizeof(qp->stats));
 
 	return 0;
 
 qp_setup_cleanup:
+	if (qp->processed_ops != NULL)
+		rte_ring_free(qp->processed_ops);
 	rte_free(qp);
+	dev->data->queue_pairs[qp_id] = NULL;
 
 	return -1;
 }
@@ -0,0 +1,581 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include <ctype.h>
+#include <stdlib.h>
+
+#include <cryptodev_pmd.h>
+#include <rte_cycles.h>
+#include <rte_malloc.h>
+#include <rte_telemetry.h>
+#include <rte_time.h>
+
+#include "rte_cryptodev_scheduler_operations.h"
+#include "scheduler_pmd_private.h"
+
+#define LL_BURST_RING_SIZE		512
+/**< In-flight bursts tracked per worker, power of 2 */
+#define LL_LAT_FRAC_SHIFT		8
+/**< Fixed point fraction bits of the per-operation latency */
+#define LL_EWMA_SHIFT			3
+/**< Each latency sample weighs 1/8 of the average */
+#define LL_AFFINITY_BITS		10
+#define LL_AFFINITY_SIZE		(1 << LL_AFFINITY_BITS)
+/**< Session affinity buckets per queue pair */
+
+/** least-loaded scheduler context */
+struct ll_scheduler_ctx {
+	uint32_t session_affinity;
+};
+
+/** Burst in flight on a worker, for latency measurement */
+struct ll_burst {
+	uint64_t tsc;
+	/**< Enqueue time */
+	uint32_t nb_ops;
+	/**< Operations of the burst not dequeued yet */
+	uint32_t depth;
+	/**< Operations in flight on the worker once the burst is enqueued */
+};
+
+struct ll_worker {
+	struct scheduler_worker worker;
+	uint64_t op_latency;
+	/**< EWMA of the completion latency per in-flight operation,
+	 * in TSC cycles shifted by LL_LAT_FRAC_SHIFT
+	 */
+	uint64_t nb_bursts;
+	/**< Bursts steered to the worker */
+	uint32_t head;
+	uint32_t tail;
+	struct ll_burst bursts[LL_BURST_RING_SIZE];
+};
+
+/** least-loaded scheduler queue pair context */
+struct __rte_cache_aligned ll_scheduler_qp_ctx {
+	struct ll_worker workers[RTE_CRYPTODEV_SCHEDULER_MAX_NB_WORKERS];
+	uint32_t nb_workers;
+	uint32_t last_deq_worker_idx;
+	uint32_t session_affinity;
+
+	/* Session hash buckets: worker and number of in-flight operations */
+	uint16_t affinity_inflight[LL_AFFINITY_SIZE];
+	uint8_t affinity_worker[LL_AFFINITY_SIZE];
+};
+
+/** Pick the worker expected to complete nb_ops new operations first */
+static __rte_always_inline uint32_t
+ll_select_worker(const struct ll_scheduler_qp_ctx *ll_qp_ctx, uint16_t nb_ops)
+{
+	uint64_t cost, best_cost = UINT64_MAX;
+	uint32_t inflight, best_inflight = UINT32_MAX;
+	uint32_t i, best = 0;
+
+	for (i = 0; i < ll_qp_ctx->nb_workers; i++) {
+		const struct ll_worker *w = &ll_qp_ctx->workers[i];
+
+		inflight = w->worker.nb_inflight_cops;
+		cost = (uint64_t)(inflight + nb_ops) * w->op_latency;
+		/* Queue depth breaks the tie, including before any sample */
+		if (cost < best_cost ||
+				(cost == best_cost && inflight < best_inflight)) {
+			best = i;
+			best_cost = cost;
+			best_inflight = inflight;
+		}
+	}
+
+	return best;
+}
+
+/** Record a burst enqueued on a worker */
+static __rte_always_inline void
+ll_burst_start(struct ll_worker *w, uint16_t nb_ops, uint64_t tsc)
+{
+	struct ll_burst *b;
+
+	w->worker.nb_inflight_cops += nb_ops;
+	w->nb_bursts++;
+
+	/* Ring full: merge with the latest burst, losing one sample */
+	if (w->tail - w->head == LL_BURST_RING_SIZE) {
+		b = &w->bursts[(w->tail - 1) & (LL_BURST_RING_SIZE - 1)];
+		b->nb_ops += nb_ops;
+		b->depth = w->worker.nb_inflight_cops;
+		return;
+	}
+
+	b = &w->bursts[w->tail & (LL_BURST_RING_SIZE - 1)];
+	b->tsc = tsc;
+	b->nb_ops = nb_ops;
+	b->depth = w->worker.nb_inflight_cops;
+	w->tail++;
+}
+
+/**
+ * Account operations dequeued from a worker. Workers complete their
+ * queue pair in order, so they belong to the oldest bursts.
+ */
+static __rte_always_inline void
+ll_burst_complete(struct ll_worker *w, uint16_t nb_ops, uint64_t tsc)
+{
+	struct ll_burst *b;
+	uint64_t sample;
+	uint32_t n;
+
+	w->worker.nb_inflight_cops -= nb_ops;
+
+	while (nb_ops != 0 && w->head != w->tail) {
+		b = &w->bursts[w->head & (LL_BURST_RING_SIZE - 1)];
+		n = RTE_MIN(b->nb_ops, (uint32_t)nb_ops);
+		b->nb_ops -= n;
+		nb_ops -= n;
+		if (b->nb_ops != 0)
+			break;
+
+		/* The last operation of the burst waited for all those
+		 * in flight ahead of it: divide to get a per op latency.
+		 */
+		sample = ((tsc - b->tsc) << LL_LAT_FRAC_SHIFT) / b->depth;
+		if (w->op_latency == 0)
+			w->op_latency = sample;
+		else
+			w->op_latency += ((int64_t)(sample - w->op_latency)) >>
+					LL_EWMA_SHIFT;
+		w->head++;
+	}
+}
+
+static __rte_always_inline uint32_t
+ll_session_bucket(const struct rte_crypto_op *op)
+{
+	uintptr_t sess = (uintptr_t)op->sym->session;
+
+	return (uint32_t)((sess >> 6) * 0x9E3779B1u) >>
+			(32 - LL_AFFINITY_BITS);
+}
+
+static __rte_always_inline uint16_t
+ll_worker_enqueue(struct ll_scheduler_qp_ctx *ll_qp_ctx, uint32_t worker_idx,
+		struct rte_crypto_op **ops, uint16_t nb_ops, uint64_t tsc)
+{
+	struct ll_worker *w = &ll_qp_ctx->workers[worker_idx];
+	uint16_t processed_ops;
+
+	scheduler_set_worker_sessions(ops, nb_ops, worker_idx);
+	processed_ops = rte_cryptodev_enqueue_burst(w->worker.dev_id,
+			w->worker.qp_id, ops, nb_ops);
+	if (processed_ops < nb_ops)
+		scheduler_retrieve_sessions(ops + processed_ops,
+			nb_ops - processed_ops);
+
+	if (processed_ops != 0)
+		ll_burst_start(w, processed_ops, tsc);
+
+	return processed_ops;
+}
+
+static uint16_t
+schedule_enqueue(void *qp, struct rte_crypto_op **ops, uint16_t nb_ops)
+{
+	struct ll_scheduler_qp_ctx *ll_qp_ctx =
+			((struct scheduler_qp_ctx *)qp)->private_qp_ctx;
+	uint32_t worker_idx;
+
+	if (unlikely(nb_ops == 0))
+		return 0;
+
+	worker_idx = ll_select_worker(ll_qp_ctx, nb_ops);
+
+	return ll_worker_enqueue(ll_qp_ctx, worker_idx, ops, nb_ops,
+			rte_rdtsc());
+}
+
+/*
+ * Operations of a session with operations in flight follow them on the
+ * same worker, the others go to the least loaded worker. The burst is
+ * split in runs of consecutive operations going to the same worker.
+ */
+static uint16_t
+schedule_enqueue_affinity(void *qp, struct rte_crypto_op **ops,
+		uint16_t nb_ops)
+{
+	struct ll_scheduler_qp_ctx *ll_qp_ctx =
+			((struct scheduler_qp_ctx *)qp)->private_qp_ctx;
+	uint8_t op_worker[nb_ops];
+	uint32_t bucket[nb_ops];
+	uint32_t target, worker_idx;
+	uint16_t i, j, end, n, enqd = 0;
+	uint64_t tsc;
+
+	if (unlikely(nb_ops == 0))
+		return 0;
+
+	target = ll_select_worker(ll_qp_ctx, nb_ops);
+	tsc = rte_rdtsc();
+
+	i = 0;
+	while (i < nb_ops) {
+		/* Find the run of operations for the same worker */
+		for (end = i; end < nb_ops; end++) {
+			if (ops[end]->sess_type == RTE_CRYPTO_OP_SESSIONLESS) {
+				bucket[end] = UINT32_MAX;
+				op_worker[end] = target;
+			} else {
+				bucket[end] = ll_session_bucket(ops[end]);
+				op_worker[end] =
+					ll_qp_ctx->affinity_inflight[bucket[end]] ?
+					ll_qp_ctx->affinity_worker[bucket[end]] :
+					target;
+			}
+			if (op_worker[end] != op_worker[i])
+				break;
+		}
+
+		worker_idx = op_worker[i];
+		n = ll_worker_enqueue(ll_qp_ctx, worker_idx, &ops[i], end - i,
+				tsc);
+
+		for (j = i; j < i + n; j++) {
+			if (bucket[j] == UINT32_MAX)
+				continue;
+			ll_qp_ctx->affinity_inflight[bucket[j]]++;
+			ll_qp_ctx->affinity_worker[bucket[j]] = worker_idx;
+		}
+		enqd += n;
+
+		/* Stop at the first worker full, to keep the order */
+		if (n < end - i)
+			break;
+		i = end;
+	}
+
+	return enqd;
+}
+
+static uint16_t
+schedule_enqueue_ordering(void *qp, struct rte_crypto_op **ops,
+		uint16_t nb_ops)
+{
+	struct scheduler_qp_ctx *qp_ctx = qp;
+	struct ll_scheduler_qp_ctx *ll_qp_ctx = qp_ctx->private_qp_ctx;
+	struct rte_ring *order_ring = qp_ctx->order_ring;
+	uint16_t nb_ops_to_enq = get_max_enqueue_order_count(order_ring,
+			nb_ops);
+	uint16_t nb_ops_enqd = ll_qp_ctx->session_affinity ?
+			schedule_enqueue_affinity(qp, ops, nb_ops_to_enq) :
+			schedule_enqueue(qp, ops, nb_ops_to_enq);
+
+	scheduler_order_insert(order_ring, ops, nb_ops_enqd);
+
+	return nb_ops_enqd;
+}
+
+static uint16_t
+schedule_dequeue(void *qp, struct rte_crypto_op **ops, uint16_t nb_ops)
+{
+	struct ll_scheduler_qp_ctx *ll_qp_ctx =
+			((struct scheduler_qp_ctx *)qp)->private_qp_ctx;
+	uint32_t worker_idx = ll_qp_ctx->last_deq_worker_idx;
+	uint16_t nb_deq_ops = 0, n, i;
+	struct ll_worker *w;
+	uint64_t tsc = 0;
+	uint32_t k;
+
+	/* Poll every worker with operations in flight, starting after the
+	 * one polled first last time, until the burst is full.
+	 */
+	for (k = 0; k < ll_qp_ctx->nb_workers && nb_deq_ops < nb_ops; k++) {
+		w = &ll_qp_ctx->workers[worker_idx];
+		if (++worker_idx == ll_qp_ctx->nb_workers)
+			worker_idx = 0;
+		if (w->worker.nb_inflight_cops == 0)
+			continue;
+
+		n = rte_cryptodev_dequeue_burst(w->worker.dev_id,
+				w->worker.qp_id, ops + nb_deq_ops,
+				nb_ops - nb_deq_ops);
+		if (n == 0)
+			continue;
+
+		scheduler_retrieve_sessions(ops + nb_deq_ops, n);
+		if (ll_qp_ctx->session_affinity) {
+			for (i = nb_deq_ops; i < nb_deq_ops + n; i++) {
+				if (ops[i]->sess_type ==
+						RTE_CRYPTO_OP_SESSIONLESS)
+					continue;
+				ll_qp_ctx->affinity_inflight[
+					ll_session_bucket(ops[i])]--;
+			}
+		}
+
+		if (tsc == 0)
+			tsc = rte_rdtsc();
+		ll_burst_complete(w, n, tsc);
+		nb_deq_ops += n;
+	}
+
+	if (++ll_qp_ctx->last_deq_worker_idx >= ll_qp_ctx->nb_workers)
+		ll_qp_ctx->last_deq_worker_idx = 0;
+
+	return nb_deq_ops;
+}
+
+static uint16_t
+schedule_dequeue_ordering(void *qp, struct rte_crypto_op **ops,
+		uint16_t nb_ops)
+{
+	struct rte_ring *order_ring =
+			((struct scheduler_qp_ctx *)qp)->order_ring;
+
+	schedule_dequeue(qp, ops, nb_ops);
+
+	return scheduler_order_drain(order_ring, ops, nb_ops);
+}
+
+static int
+worker_attach(__rte_unused struct rte_cryptodev *dev,
+		__rte_unused uint8_t worker_id)
+{
+	return 0;
+}
+
+static int
+worker_detach(__rte_unused struct rte_cryptodev *dev,
+		__rte_unused uint8_t worker_id)
+{
+	return 0;
+}
+
+static int
+scheduler_start(struct rte_cryptodev *dev)
+{
+	struct scheduler_ctx *sched_ctx = dev->data->dev_private;
+	struct ll_scheduler_ctx *ll_ctx = sched_ctx->private_ctx;
+	uint16_t i;
+
+	if (sched_ctx->reordering_enabled) {
+		dev->enqueue_burst = &schedule_enqueue_ordering;
+		dev->dequeue_burst = &schedule_dequeue_ordering;
+	} else {
+		dev->enqueue_burst = ll_ctx->session_affinity ?
+				&schedule_enqueue_affinity : &schedule_enqueue;
+		dev->dequeue_burst = &schedule_dequeue;
+	}
+
+	for (i = 0; i < dev->data->nb_queue_pairs; i++) {
+		struct scheduler_qp_ctx *qp_ctx = dev->data->queue_pairs[i];
+		struct ll_scheduler_qp_ctx *ll_qp_ctx =
+				qp_ctx->private_qp_ctx;
+		uint32_t j;
+
+		memset(ll_qp_ctx, 0, sizeof(*ll_qp_ctx));
+		for (j = 0; j < sched_ctx->nb_workers; j++) {
+			ll_qp_ctx->workers[j].worker.dev_id =
+					sched_ctx->workers[j].dev_id;
+			ll_qp_ctx->workers[j].worker.qp_id = i;
+		}
+
+		ll_qp_ctx->nb_workers = sched_ctx->nb_workers;
+		ll_qp_ctx->session_affinity = ll_ctx->session_affinity;
+	}
+
+	return 0;
+}
+
+static int
+scheduler_stop(struct rte_cryptodev *dev)
+{
+	uint16_t i;
+	uint32_t j;
+
+	for (i = 0; i < dev->data->nb_queue_pairs; i++) {
+		struct scheduler_qp_ctx *qp_ctx = dev->data->queue_pairs[i];
+		struct ll_scheduler_qp_ctx *ll_qp_ctx = qp_ctx->private_qp_ctx;
+
+		for (j = 0; j < ll_qp_ctx->nb_workers; j++) {
+			if (ll_qp_ctx->workers[j].worker.nb_inflight_cops) {
+				CR_SCHED_LOG(ERR, "Some crypto ops left in worker queue");
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static int
+scheduler_config_qp(struct rte_cryptodev *dev, uint16_t qp_id)
+{
+	struct scheduler_qp_ctx *qp_ctx = dev->data->queue_pairs[qp_id];
+	struct ll_scheduler_qp_ctx *ll_qp_ctx;
+
+	ll_qp_ctx = rte_zmalloc_socket(NULL, sizeof(*ll_qp_ctx),
+			RTE_CACHE_LINE_SIZE, rte_socket_id());
+	if (!ll_qp_ctx) {
+		CR_SCHED_LOG(ERR, "failed allocate memory for private queue pair");
+		return -ENOMEM;
+	}
+
+	qp_ctx->private_qp_ctx = (void *)ll_qp_ctx;
+
+	return 0;
+}
+
+static int
+scheduler_create_private_ctx(struct rte_cryptodev *dev)
+{
+	struct scheduler_ctx *sched_ctx = dev->data->dev_private;
+	struct ll_scheduler_ctx *ll_ctx;
+
+	if (sched_ctx->private_ctx) {
+		rte_free(sched_ctx->private_ctx);
+		sched_ctx->private_ctx = NULL;
+	}
+
+	ll_ctx = rte_zmalloc_socket(NULL, sizeof(struct ll_scheduler_ctx), 0,
+			rte_socket_id());
+	if (!ll_ctx) {
+		CR_SCHED_LOG(ERR, "failed allocate memory");
+		return -ENOMEM;
+	}
+
+	sched_ctx->private_ctx = (void *)ll_ctx;
+
+	return 0;
+}
+
+static int
+scheduler_option_set(struct rte_cryptodev *dev, uint32_t option_type,
+		void *option)
+{
+	struct ll_scheduler_ctx *ll_ctx = ((struct scheduler_ctx *)
+			dev->data->dev_private)->private_ctx;
+
+	if ((enum rte_cryptodev_schedule_option_type)option_type !=
+			CDEV_SCHED_OPTION_SESSION_AFFINITY) {
+		CR_SCHED_LOG(ERR, "Option not supported");
+		return -EINVAL;
+	}
+
+	ll_ctx->session_affinity =
+		!!((struct rte_cryptodev_scheduler_session_affinity_option *)
+			option)->enable;
+
+	return 0;
+}
+
+static int
+scheduler_option_get(struct rte_cryptodev *dev, uint32_t option_type,
+		void *option)
+{
+	struct ll_scheduler_ctx *ll_ctx = ((struct scheduler_ctx *)
+			dev->data->dev_private)->private_ctx;
+	struct rte_cryptodev_scheduler_session_affinity_option *affinity_option;
+
+	if ((enum rte_cryptodev_schedule_option_type)option_type !=
+			CDEV_SCHED_OPTION_SESSION_AFFINITY) {
+		CR_SCHED_LOG(ERR, "Option not supported");
+		return -EINVAL;
+	}
+
+	affinity_option = option;
+	affinity_option->enable = ll_ctx->session_affinity;
+
+	return 0;
+}
+
+static struct rte_cryptodev_scheduler_ops scheduler_ll_ops = {
+	worker_attach,
+	worker_detach,
+	scheduler_start,
+	scheduler_stop,
+	scheduler_config_qp,
+	scheduler_create_private_ctx,
+	scheduler_option_set,
+	scheduler_option_get
+};
+
+static struct rte_cryptodev_scheduler scheduler = {
+		.name = "least-loaded-scheduler",
+		.description = "scheduler which will steer each burst to the "
+				"worker with the least expected completion "
+				"time, from its backlog and latency",
+		.mode = CDEV_SCHED_MODE_LEAST_LOADED,
+		.ops = &scheduler_ll_ops
+};
+
+struct rte_cryptodev_scheduler *crypto_scheduler_least_loaded = &scheduler;
+
+static int
+ll_telemetry_handle_stats(const char *cmd __rte_unused, const char *params,
+		struct rte_tel_data *d)
+{
+	struct rte_cryptodev *dev;
+	struct scheduler_ctx *sched_ctx;
+	struct rte_tel_data *worker_d;
+	char name[32];
+	uint64_t hz = rte_get_tsc_hz();
+	char *end;
+	unsigned long dev_id;
+	uint32_t j;
+	uint16_t i;
+
+	if (params == NULL || strlen(params) == 0 || !isdigit(*params))
+		return -EINVAL;
+
+	dev_id = strtoul(params, &end, 0);
+	if (*end != '\0' || dev_id >= RTE_CRYPTO_MAX_DEVS)
+		return -EINVAL;
+
+	dev = rte_cryptodev_pmd_get_dev(dev_id);
+	if (dev == NULL || dev->driver_id != cryptodev_scheduler_driver_id)
+		return -EINVAL;
+	sched_ctx = dev->data->dev_private;
+	if (sched_ctx->mode != CDEV_SCHED_MODE_LEAST_LOADED)
+		return -ENOTSUP;
+
+	rte_tel_data_start_dict(d);
+	for (j = 0; j < sched_ctx->nb_workers; j++) {
+		uint64_t inflight = 0, bursts = 0, latency = 0;
+
+		for (i = 0; i < dev->data->nb_queue_pairs; i++) {
+			struct scheduler_qp_ctx *qp_ctx =
+					dev->data->queue_pairs[i];
+			struct ll_scheduler_qp_ctx *ll_qp_ctx;
+			struct ll_worker *w;
+
+			if (qp_ctx == NULL || qp_ctx->private_qp_ctx == NULL)
+				continue;
+			ll_qp_ctx = qp_ctx->private_qp_ctx;
+			w = &ll_qp_ctx->workers[j];
+			inflight += w->worker.nb_inflight_cops;
+			bursts += w->nb_bursts;
+			latency = RTE_MAX(latency, w->op_latency);
+		}
+
+		worker_d = rte_tel_data_alloc();
+		if (worker_d == NULL)
+			return -ENOMEM;
+		rte_tel_data_start_dict(worker_d);
+		rte_tel_data_add_dict_uint(worker_d, "dev_id",
+				sched_ctx->workers[j].dev_id);
+		rte_tel_data_add_dict_uint(worker_d, "inflight", inflight);
+		rte_tel_data_add_dict_uint(worker_d, "bursts", bursts);
+		rte_tel_data_add_dict_uint(worker_d, "op_latency_ns",
+				(latency >> LL_LAT_FRAC_SHIFT) * NSEC_PER_SEC / hz);
+
+		snprintf(name, sizeof(name), "worker%u", j);
+		rte_tel_data_add_dict_container(d, name, worker_d, 0);
+	}
+
+	return 0;
+}
+
+RTE_INIT(scheduler_ll_init_telemetry)
+{
+	rte_telemetry_register_cmd("/cryptodev/scheduler/least_loaded",
+			ll_telemetry_handle_stats,
+			"Returns least-loaded scheduler worker load. Parameters: int dev_id");
+}
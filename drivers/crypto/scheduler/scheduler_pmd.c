@@ -68,7 +68,9 @@ const struct scheduler_parse_map scheduler_mode_map[] = {
 	{RTE_STR(SCHEDULER_MODE_NAME_FAIL_OVER),
 			CDEV_SCHED_MODE_FAILOVER},
 	{RTE_STR(SCHEDULER_MODE_NAME_MULTI_CORE),
-			CDEV_SCHED_MODE_MULTICORE}
+			CDEV_SCHED_MODE_MULTICORE},
+	{RTE_STR(SCHEDULER_MODE_NAME_LEAST_LOADED),
+			CDEV_SCHED_MODE_LEAST_LOADED}
 };
 
 const struct scheduler_parse_map scheduler_ordering_map[] = {
@@ -137,6 +139,8 @@ cryptodev_scheduler_create(const char *name,
 		union {
 			struct rte_cryptodev_scheduler_threshold_option
 					threshold_option;
+			struct rte_cryptodev_scheduler_session_affinity_option
+					affinity_option;
 		} option;
 		enum rte_cryptodev_schedule_option_type option_type;
 		char param_name[RTE_CRYPTODEV_SCHEDULER_NAME_MAX_LEN] = {0};
@@ -186,6 +190,18 @@ cryptodev_scheduler_create(const char *name,
 				option.threshold_option.threshold =
 						strtoul(param_val, &end, 0);
 				break;
+			case CDEV_SCHED_MODE_LEAST_LOADED:
+				if (strcmp(param_name,
+					RTE_CRYPTODEV_SCHEDULER_PARAM_SESS_AFFINITY)
+						!= 0) {
+					CR_SCHED_LOG(ERR, "Invalid mode param");
+					return -EINVAL;
+				}
+				option_type = CDEV_SCHED_OPTION_SESSION_AFFINITY;
+
+				option.affinity_option.enable =
+						strtoul(param_val, &end, 0);
+				break;
 			default:
 				CR_SCHED_LOG(ERR, "Invalid mode param");
 				return -EINVAL;
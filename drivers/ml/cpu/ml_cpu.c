@@ -0,0 +1,764 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <bus_vdev_driver.h>
+#include <rte_common.h>
+#include <rte_errno.h>
+#include <rte_kvargs.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_mldev_pmd.h>
+#include <rte_pause.h>
+#include <rte_ring.h>
+#include <rte_service_component.h>
+#include <rte_string_fns.h>
+
+#include "ml_cpu.h"
+
+static const char * const ml_cpu_valid_args[] = {
+	ML_CPU_WORKER_ARG,
+	NULL
+};
+
+static const char * const ml_cpu_op_errors[ML_CPU_OP_ERR_MAX] = {
+	[ML_CPU_OP_ERR_NONE] = "success",
+	[ML_CPU_OP_ERR_MODEL] = "model not started",
+	[ML_CPU_OP_ERR_BATCHES] = "invalid number of batches",
+	[ML_CPU_OP_ERR_INPUT] = "input buffer too small or too many segments",
+	[ML_CPU_OP_ERR_OUTPUT] = "output buffer too small or too many segments",
+};
+
+/*
+ * Queue pairs.
+ */
+
+static int
+ml_cpu_dev_queue_pair_release(struct rte_ml_dev *dev, uint16_t queue_pair_id)
+{
+	struct ml_cpu_qp *qp = dev->data->queue_pairs[queue_pair_id];
+
+	if (qp == NULL)
+		return 0;
+	rte_free(qp->slots);
+	rte_free(qp);
+	dev->data->queue_pairs[queue_pair_id] = NULL;
+	return 0;
+}
+
+static int
+ml_cpu_dev_queue_pair_setup(struct rte_ml_dev *dev, uint16_t queue_pair_id,
+		const struct rte_ml_dev_qp_conf *qp_conf, int socket_id)
+{
+	struct ml_cpu_qp *qp;
+	uint32_t nb_slots;
+
+	if (qp_conf->nb_desc == 0 || qp_conf->nb_desc > ML_CPU_MAX_DESC) {
+		ML_CPU_LOG(ERR, "invalid number of descriptors %u", qp_conf->nb_desc);
+		return -EINVAL;
+	}
+	ml_cpu_dev_queue_pair_release(dev, queue_pair_id);
+
+	qp = rte_zmalloc_socket("ml_cpu_qp", sizeof(*qp), RTE_CACHE_LINE_SIZE, socket_id);
+	if (qp == NULL)
+		return -ENOMEM;
+
+	/*
+	 * Workers complete operations concurrently and out of order,
+	 * they are put back in order in the slots of their sequence number.
+	 */
+	nb_slots = rte_align32pow2(qp_conf->nb_desc);
+	qp->slots = rte_zmalloc_socket("ml_cpu_qp_slots", nb_slots * sizeof(qp->slots[0]),
+		RTE_CACHE_LINE_SIZE, socket_id);
+	if (qp->slots == NULL) {
+		ML_CPU_LOG(ERR, "cannot create queue pair %u", queue_pair_id);
+		rte_free(qp);
+		return -ENOMEM;
+	}
+	qp->mask = nb_slots - 1;
+	qp->id = queue_pair_id;
+	qp->nb_desc = qp_conf->nb_desc;
+	qp->cb = qp_conf->cb;
+	dev->data->queue_pairs[queue_pair_id] = qp;
+	return 0;
+}
+
+/*
+ * Give back the completed operations of a queue pair not dequeued yet.
+ * Operations never run by the workers are given back when they stop.
+ */
+static void
+ml_cpu_qp_flush(struct rte_ml_dev *dev, struct ml_cpu_qp *qp)
+{
+	struct rte_ml_op *op;
+	uint64_t seq;
+
+	for (seq = rte_atomic_load_explicit(&qp->dequeued, rte_memory_order_relaxed);
+			seq != qp->enqueued; seq++) {
+		op = rte_atomic_exchange_explicit(&qp->slots[seq & qp->mask], NULL,
+			rte_memory_order_acquire);
+		if (op != NULL && qp->cb != NULL)
+			qp->cb(dev->data->dev_id, qp->id, op);
+	}
+	qp->enqueued = 0;
+	rte_atomic_store_explicit(&qp->dequeued, 0, rte_memory_order_relaxed);
+}
+
+/*
+ * Models.
+ */
+
+static int
+ml_cpu_model_stop(struct rte_ml_dev *dev, uint16_t model_id)
+{
+	struct ml_cpu_model *model = dev->data->models[model_id];
+
+	if (model == NULL)
+		return -EINVAL;
+	if (model->state != ML_CPU_MODEL_STARTED)
+		return 0;
+	model->state = ML_CPU_MODEL_LOADED;
+	ml_cpu_model_scratch_free(model);
+	return 0;
+}
+
+static int
+ml_cpu_model_start(struct rte_ml_dev *dev, uint16_t model_id)
+{
+	struct ml_cpu_priv *priv = dev->data->dev_private;
+	struct ml_cpu_model *model = dev->data->models[model_id];
+	int ret;
+
+	if (model == NULL)
+		return -EINVAL;
+	if (model->state == ML_CPU_MODEL_STARTED)
+		return 0;
+	if (priv->nb_ctx == 0)
+		return -EINVAL;
+	ret = ml_cpu_model_scratch_alloc(model, priv->nb_ctx, priv->socket_id);
+	if (ret < 0)
+		return ret;
+	model->state = ML_CPU_MODEL_STARTED;
+	return 0;
+}
+
+static int
+ml_cpu_model_unload(struct rte_ml_dev *dev, uint16_t model_id)
+{
+	struct ml_cpu_model *model = dev->data->models[model_id];
+
+	if (model == NULL)
+		return -EINVAL;
+	if (model->state == ML_CPU_MODEL_STARTED) {
+		ML_CPU_LOG(ERR, "model %u must be stopped before unload", model_id);
+		return -EBUSY;
+	}
+	ml_cpu_model_free(model);
+	dev->data->models[model_id] = NULL;
+	return 0;
+}
+
+static int
+ml_cpu_model_load(struct rte_ml_dev *dev, struct rte_ml_model_params *params,
+		uint16_t *model_id)
+{
+	struct ml_cpu_priv *priv = dev->data->dev_private;
+	struct ml_cpu_model *model;
+	uint16_t id;
+	int ret;
+
+	for (id = 0; id != dev->data->nb_models; id++)
+		if (dev->data->models[id] == NULL)
+			break;
+	if (id == dev->data->nb_models) {
+		ML_CPU_LOG(ERR, "no free model slot");
+		return -ENOMEM;
+	}
+
+	model = rte_zmalloc_socket("ml_cpu_model", sizeof(*model), RTE_CACHE_LINE_SIZE,
+		priv->socket_id);
+	if (model == NULL)
+		return -ENOMEM;
+	ret = ml_cpu_model_parse(model, params->addr, params->size, priv->socket_id);
+	if (ret < 0) {
+		ml_cpu_model_free(model);
+		return ret;
+	}
+	model->model_id = id;
+	model->state = ML_CPU_MODEL_LOADED;
+	model->info.model_id = id;
+	model->info.device_id = dev->data->dev_id;
+	dev->data->models[id] = model;
+	*model_id = id;
+	return 0;
+}
+
+static int
+ml_cpu_model_info_get(struct rte_ml_dev *dev, uint16_t model_id,
+		struct rte_ml_model_info *model_info)
+{
+	struct ml_cpu_model *model = dev->data->models[model_id];
+
+	if (model == NULL)
+		return -EINVAL;
+	*model_info = model->info;
+	return 0;
+}
+
+/* convert one batch of the input, with the mldev utils */
+static int
+ml_cpu_io_quantize(struct rte_ml_dev *dev, uint16_t model_id,
+		struct rte_ml_buff_seg **dbuffer, struct rte_ml_buff_seg **qbuffer)
+{
+	struct ml_cpu_model *model = dev->data->models[model_id];
+
+	if (model == NULL)
+		return -EINVAL;
+	if (model->dtype == ML_CPU_DTYPE_INT8)
+		return rte_ml_io_float32_to_int8(dbuffer[0]->addr, qbuffer[0]->addr,
+			model->in_elements, model->input.scale, model->input.zero_point);
+	return rte_ml_io_float32_to_bfloat16(dbuffer[0]->addr, qbuffer[0]->addr,
+		model->in_elements);
+}
+
+static int
+ml_cpu_io_dequantize(struct rte_ml_dev *dev, uint16_t model_id,
+		struct rte_ml_buff_seg **qbuffer, struct rte_ml_buff_seg **dbuffer)
+{
+	struct ml_cpu_model *model = dev->data->models[model_id];
+
+	if (model == NULL)
+		return -EINVAL;
+	if (model->dtype == ML_CPU_DTYPE_INT8)
+		return rte_ml_io_int8_to_float32(qbuffer[0]->addr, dbuffer[0]->addr,
+			model->out_elements, model->output.scale, model->output.zero_point);
+	return rte_ml_io_bfloat16_to_float32(qbuffer[0]->addr, dbuffer[0]->addr,
+		model->out_elements);
+}
+
+/*
+ * Device.
+ */
+
+static int
+ml_cpu_dev_info_get(struct rte_ml_dev *dev __rte_unused, struct rte_ml_dev_info *dev_info)
+{
+	memset(dev_info, 0, sizeof(*dev_info));
+	dev_info->driver_name = RTE_STR(MLDEV_NAME_ML_CPU_PMD);
+	dev_info->max_models = ML_CPU_MAX_MODELS;
+	dev_info->max_queue_pairs = ML_CPU_MAX_QPS;
+	dev_info->max_desc = ML_CPU_MAX_DESC;
+	dev_info->max_io = 1;
+	dev_info->max_segments = ML_CPU_MAX_SEGMENTS;
+	dev_info->align_size = ML_CPU_ALIGN;
+	return 0;
+}
+
+static void
+ml_cpu_models_release(struct rte_ml_dev *dev)
+{
+	uint16_t id;
+
+	for (id = 0; id != dev->data->nb_models; id++) {
+		if (dev->data->models[id] == NULL)
+			continue;
+		ml_cpu_model_stop(dev, id);
+		ml_cpu_model_unload(dev, id);
+	}
+}
+
+static int
+ml_cpu_dev_configure(struct rte_ml_dev *dev, const struct rte_ml_dev_config *config)
+{
+	struct ml_cpu_priv *priv = dev->data->dev_private;
+	uint16_t qp_id;
+	void **p;
+
+	if (config->nb_models > ML_CPU_MAX_MODELS) {
+		ML_CPU_LOG(ERR, "invalid number of models %u", config->nb_models);
+		return -EINVAL;
+	}
+
+	/* the working memory of the models depends on the queue pairs */
+	ml_cpu_models_release(dev);
+	for (qp_id = 0; qp_id != dev->data->nb_queue_pairs; qp_id++)
+		ml_cpu_dev_queue_pair_release(dev, qp_id);
+
+	p = rte_realloc(dev->data->models, RTE_MAX(config->nb_models, 1) * sizeof(p[0]),
+		RTE_CACHE_LINE_SIZE);
+	if (p == NULL)
+		return -ENOMEM;
+	memset(p, 0, RTE_MAX(config->nb_models, 1) * sizeof(p[0]));
+	dev->data->models = p;
+	dev->data->nb_models = config->nb_models;
+
+	p = rte_realloc(dev->data->queue_pairs,
+		RTE_MAX(config->nb_queue_pairs, 1) * sizeof(p[0]), RTE_CACHE_LINE_SIZE);
+	if (p == NULL)
+		return -ENOMEM;
+	memset(p, 0, RTE_MAX(config->nb_queue_pairs, 1) * sizeof(p[0]));
+	dev->data->queue_pairs = p;
+	dev->data->nb_queue_pairs = config->nb_queue_pairs;
+
+	priv->nb_ctx = priv->nb_workers != 0 ? priv->nb_workers : config->nb_queue_pairs;
+	priv->socket_id = config->socket_id;
+	return 0;
+}
+
+static int
+ml_cpu_dev_close(struct rte_ml_dev *dev)
+{
+	uint16_t qp_id;
+
+	ml_cpu_models_release(dev);
+	rte_free(dev->data->models);
+	dev->data->models = NULL;
+	dev->data->nb_models = 0;
+
+	for (qp_id = 0; qp_id != dev->data->nb_queue_pairs; qp_id++)
+		ml_cpu_dev_queue_pair_release(dev, qp_id);
+	rte_free(dev->data->queue_pairs);
+	dev->data->queue_pairs = NULL;
+	dev->data->nb_queue_pairs = 0;
+	return 0;
+}
+
+static void
+ml_cpu_workers_stop(struct rte_ml_dev *dev)
+{
+	struct ml_cpu_priv *priv = dev->data->dev_private;
+	struct ml_cpu_worker *wk;
+	struct rte_ml_op *op;
+	struct ml_cpu_qp *qp;
+	uint16_t i;
+
+	rte_service_runstate_set(priv->service_id, 0);
+	while (rte_service_may_be_active(priv->service_id) == 1)
+		rte_pause();
+
+	for (i = 0; i != priv->nb_workers; i++) {
+		wk = &priv->workers[i];
+		rte_service_map_lcore_set(priv->service_id, wk->lcore_id, 0);
+		if (wk->added) {
+			rte_service_lcore_stop(wk->lcore_id);
+			rte_service_lcore_del(wk->lcore_id);
+			wk->added = false;
+		}
+	}
+
+	if (priv->jobs == NULL)
+		return;
+	while (rte_ring_dequeue(priv->jobs, (void **)&op) == 0) {
+		qp = dev->data->queue_pairs[ml_cpu_op_opaque(op)->qp_id];
+		if (qp->cb != NULL)
+			qp->cb(dev->data->dev_id, qp->id, op);
+	}
+	rte_ring_free(priv->jobs);
+	priv->jobs = NULL;
+}
+
+static int
+ml_cpu_dev_start(struct rte_ml_dev *dev)
+{
+	struct ml_cpu_priv *priv = dev->data->dev_private;
+	char name[RTE_RING_NAMESIZE];
+	struct ml_cpu_worker *wk;
+	uint32_t nb_desc;
+	uint16_t i;
+	int ret;
+
+	if (priv->nb_workers == 0)
+		return 0;
+
+	nb_desc = 0;
+	for (i = 0; i != dev->data->nb_queue_pairs; i++) {
+		if (dev->data->queue_pairs[i] == NULL) {
+			ML_CPU_LOG(ERR, "queue pair %u is not set up", i);
+			return -EINVAL;
+		}
+		nb_desc += ((struct ml_cpu_qp *)dev->data->queue_pairs[i])->nb_desc;
+	}
+	snprintf(name, sizeof(name), "ml_cpu_%d_jobs", dev->data->dev_id);
+	priv->jobs = rte_ring_create(name, rte_align32pow2(nb_desc + 1), priv->socket_id, 0);
+	if (priv->jobs == NULL)
+		return -ENOMEM;
+
+	for (i = 0; i != priv->nb_workers; i++) {
+		wk = &priv->workers[i];
+		ret = rte_service_lcore_add(wk->lcore_id);
+		if (ret == 0)
+			wk->added = true;
+		else if (ret != -EALREADY)
+			goto error;
+		ret = rte_service_map_lcore_set(priv->service_id, wk->lcore_id, 1);
+		if (ret < 0)
+			goto error;
+		ret = rte_service_lcore_start(wk->lcore_id);
+		if (ret < 0 && ret != -EALREADY)
+			goto error;
+	}
+	rte_service_runstate_set(priv->service_id, 1);
+	return 0;
+
+error:
+	ML_CPU_LOG(ERR, "cannot run the workers on lcore %u: %s", wk->lcore_id,
+		rte_strerror(-ret));
+	ml_cpu_workers_stop(dev);
+	return ret;
+}
+
+static int
+ml_cpu_dev_stop(struct rte_ml_dev *dev)
+{
+	struct ml_cpu_priv *priv = dev->data->dev_private;
+	uint16_t i;
+
+	if (priv->nb_workers != 0)
+		ml_cpu_workers_stop(dev);
+	for (i = 0; i != dev->data->nb_queue_pairs; i++)
+		if (dev->data->queue_pairs[i] != NULL)
+			ml_cpu_qp_flush(dev, dev->data->queue_pairs[i]);
+	return 0;
+}
+
+static int
+ml_cpu_dev_stats_get(struct rte_ml_dev *dev, struct rte_ml_dev_stats *stats)
+{
+	struct ml_cpu_qp *qp;
+	uint16_t i;
+
+	for (i = 0; i != dev->data->nb_queue_pairs; i++) {
+		qp = dev->data->queue_pairs[i];
+		if (qp == NULL)
+			continue;
+		stats->enqueued_count += qp->stats.enqueued_count;
+		stats->dequeued_count += qp->stats.dequeued_count;
+		stats->enqueue_err_count += qp->stats.enqueue_err_count;
+		stats->dequeue_err_count += qp->stats.dequeue_err_count;
+	}
+	return 0;
+}
+
+static void
+ml_cpu_dev_stats_reset(struct rte_ml_dev *dev)
+{
+	struct ml_cpu_qp *qp;
+	uint16_t i;
+
+	for (i = 0; i != dev->data->nb_queue_pairs; i++) {
+		qp = dev->data->queue_pairs[i];
+		if (qp != NULL)
+			memset(&qp->stats, 0, sizeof(qp->stats));
+	}
+}
+
+static const char *
+ml_cpu_layer_name(uint16_t type)
+{
+	switch (type) {
+	case ML_CPU_LAYER_FC:
+		return "fc";
+	case ML_CPU_LAYER_CONV2D:
+		return "conv2d";
+	case ML_CPU_LAYER_MAXPOOL2D:
+		return "maxpool2d";
+	case ML_CPU_LAYER_SOFTMAX:
+		return "softmax";
+	}
+	return "unknown";
+}
+
+static int
+ml_cpu_dev_dump(struct rte_ml_dev *dev, FILE *fd)
+{
+	struct ml_cpu_priv *priv = dev->data->dev_private;
+	const struct ml_cpu_model *model;
+	const struct ml_cpu_layer *l;
+	uint16_t id, i;
+
+	fprintf(fd, "%s: %s kernels, %u workers\n", dev->data->name, priv->kernels->name,
+		priv->nb_workers);
+	for (i = 0; i != priv->nb_workers; i++)
+		fprintf(fd, "  worker lcore %u\n", priv->workers[i].lcore_id);
+	for (id = 0; id != dev->data->nb_models; id++) {
+		model = dev->data->models[id];
+		if (model == NULL)
+			continue;
+		fprintf(fd, "  model %u: %s, %s, %s, %u batches, %"PRIu64" weight bytes\n",
+			id, model->info.name,
+			model->dtype == ML_CPU_DTYPE_INT8 ? "int8" : "bf16",
+			model->state == ML_CPU_MODEL_STARTED ? "started" : "loaded",
+			model->max_batches, model->wb_size);
+		for (i = 0; i != model->nb_layers; i++) {
+			l = &model->layers[i];
+			fprintf(fd, "    %-9s %ux%ux%u -> %ux%ux%u\n", ml_cpu_layer_name(l->type),
+				l->in_h, l->in_w, l->in_c, l->out_h, l->out_w, l->out_c);
+		}
+	}
+	return 0;
+}
+
+static struct rte_ml_dev_ops ml_cpu_ops = {
+	.dev_info_get = ml_cpu_dev_info_get,
+	.dev_configure = ml_cpu_dev_configure,
+	.dev_close = ml_cpu_dev_close,
+	.dev_start = ml_cpu_dev_start,
+	.dev_stop = ml_cpu_dev_stop,
+	.dev_queue_pair_setup = ml_cpu_dev_queue_pair_setup,
+	.dev_queue_pair_release = ml_cpu_dev_queue_pair_release,
+	.dev_stats_get = ml_cpu_dev_stats_get,
+	.dev_stats_reset = ml_cpu_dev_stats_reset,
+	.dev_dump = ml_cpu_dev_dump,
+	.model_load = ml_cpu_model_load,
+	.model_unload = ml_cpu_model_unload,
+	.model_start = ml_cpu_model_start,
+	.model_stop = ml_cpu_model_stop,
+	.model_info_get = ml_cpu_model_info_get,
+	.io_quantize = ml_cpu_io_quantize,
+	.io_dequantize = ml_cpu_io_dequantize,
+};
+
+/*
+ * Data path. Without workers, inference runs in the enqueue call.
+ * With workers, enqueued operations are shared by the worker lcores.
+ * Completed operations are stored in the slot of their sequence number
+ * in the queue pair, and dequeued in order.
+ */
+
+static inline void
+ml_cpu_op_complete(struct ml_cpu_qp *qp, struct rte_ml_op *op)
+{
+	rte_atomic_store_explicit(&qp->slots[ml_cpu_op_opaque(op)->seq & qp->mask], op,
+		rte_memory_order_release);
+}
+
+static uint16_t
+ml_cpu_enqueue_burst(struct rte_ml_dev *dev, uint16_t qp_id, struct rte_ml_op **ops,
+		uint16_t nb_ops)
+{
+	struct ml_cpu_priv *priv = dev->data->dev_private;
+	struct ml_cpu_qp *qp = dev->data->queue_pairs[qp_id];
+	union ml_cpu_op_opaque *opq;
+	uint64_t inflight;
+	uint16_t i, n;
+
+	inflight = qp->enqueued -
+		rte_atomic_load_explicit(&qp->dequeued, rte_memory_order_acquire);
+	n = RTE_MIN(nb_ops, qp->nb_desc - inflight);
+	if (n == 0)
+		return 0;
+
+	for (i = 0; i != n; i++) {
+		opq = ml_cpu_op_opaque(ops[i]);
+		opq->u64 = 0;
+		opq->seq = qp->enqueued + i;
+		opq->qp_id = qp_id;
+	}
+
+	if (priv->nb_workers == 0) {
+		for (i = 0; i < n; i += ML_CPU_BURST)
+			ml_cpu_run_burst(dev, qp_id, &ops[i], RTE_MIN(n - i, ML_CPU_BURST));
+		for (i = 0; i != n; i++)
+			ml_cpu_op_complete(qp, ops[i]);
+	} else {
+		n = rte_ring_enqueue_burst(priv->jobs, (void **)ops, n, NULL);
+	}
+	qp->enqueued += n;
+	qp->stats.enqueued_count += n;
+	return n;
+}
+
+static uint16_t
+ml_cpu_dequeue_burst(struct rte_ml_dev *dev, uint16_t qp_id, struct rte_ml_op **ops,
+		uint16_t nb_ops)
+{
+	struct ml_cpu_qp *qp = dev->data->queue_pairs[qp_id];
+	RTE_ATOMIC(struct rte_ml_op *) *slot;
+	uint64_t seq;
+	uint16_t n;
+
+	seq = rte_atomic_load_explicit(&qp->dequeued, rte_memory_order_relaxed);
+	for (n = 0; n != nb_ops; n++) {
+		slot = &qp->slots[(seq + n) & qp->mask];
+		ops[n] = rte_atomic_load_explicit(slot, rte_memory_order_acquire);
+		if (ops[n] == NULL)
+			break;
+		rte_atomic_store_explicit(slot, NULL, rte_memory_order_relaxed);
+		if (ops[n]->status == RTE_ML_OP_STATUS_ERROR)
+			qp->stats.dequeue_err_count++;
+	}
+	qp->stats.dequeued_count += n;
+	rte_atomic_fetch_add_explicit(&qp->dequeued, n, rte_memory_order_release);
+	return n;
+}
+
+static int
+ml_cpu_op_error_get(struct rte_ml_dev *dev __rte_unused, struct rte_ml_op *op,
+		struct rte_ml_op_error *error)
+{
+	uint16_t err = ml_cpu_op_opaque(op)->error;
+
+	if (err >= ML_CPU_OP_ERR_MAX)
+		return -EINVAL;
+	strlcpy(error->message, ml_cpu_op_errors[err], sizeof(error->message));
+	error->errcode = err;
+	return 0;
+}
+
+static int32_t
+ml_cpu_service(void *arg)
+{
+	struct rte_ml_dev *dev = arg;
+	struct ml_cpu_priv *priv = dev->data->dev_private;
+	struct rte_ml_op *ops[ML_CPU_BURST];
+	struct ml_cpu_qp *qp;
+	uint16_t i, n;
+	int16_t ctx;
+
+	ctx = priv->worker_ctx[rte_lcore_id()];
+	if (ctx < 0)
+		return -ENOENT;
+
+	n = rte_ring_dequeue_burst(priv->jobs, (void **)ops, ML_CPU_BURST, NULL);
+	if (n == 0)
+		return -EAGAIN;
+
+	ml_cpu_run_burst(dev, ctx, ops, n);
+	for (i = 0; i != n; i++) {
+		qp = dev->data->queue_pairs[ml_cpu_op_opaque(ops[i])->qp_id];
+		ml_cpu_op_complete(qp, ops[i]);
+	}
+	return 0;
+}
+
+/*
+ * Virtual device.
+ */
+
+static int
+ml_cpu_parse_worker(const char *key __rte_unused, const char *value, void *extra_args)
+{
+	struct ml_cpu_priv *priv = extra_args;
+	unsigned long lcore;
+	char *end;
+	uint16_t i;
+
+	errno = 0;
+	lcore = strtoul(value, &end, 0);
+	if (*value == '\0' || *end != '\0' || errno != 0 || lcore >= RTE_MAX_LCORE ||
+			!rte_lcore_is_enabled(lcore) || lcore == rte_get_main_lcore()) {
+		ML_CPU_LOG(ERR, "invalid worker lcore %s", value);
+		return -EINVAL;
+	}
+	for (i = 0; i != priv->nb_workers; i++)
+		if (priv->workers[i].lcore_id == lcore)
+			return -EINVAL;
+	priv->worker_ctx[lcore] = priv->nb_workers;
+	priv->workers[priv->nb_workers++].lcore_id = lcore;
+	return 0;
+}
+
+static int
+ml_cpu_probe(struct rte_vdev_device *vdev)
+{
+	struct rte_ml_dev_pmd_init_params init_params;
+	struct rte_service_spec service;
+	struct rte_kvargs *kvlist = NULL;
+	struct ml_cpu_priv *priv;
+	struct rte_ml_dev *dev;
+	const char *name, *args;
+	uint32_t i;
+	int ret;
+
+	name = rte_vdev_device_name(vdev);
+	if (name == NULL)
+		return -EINVAL;
+
+	args = rte_vdev_device_args(vdev);
+	if (args != NULL && args[0] != '\0') {
+		kvlist = rte_kvargs_parse(args, ml_cpu_valid_args);
+		if (kvlist == NULL) {
+			ML_CPU_LOG(ERR, "invalid arguments: %s", args);
+			return -EINVAL;
+		}
+	}
+
+	init_params.socket_id = rte_socket_id();
+	init_params.private_data_size = sizeof(struct ml_cpu_priv);
+	dev = rte_ml_dev_pmd_create(name, &vdev->device, &init_params);
+	if (dev == NULL) {
+		rte_kvargs_free(kvlist);
+		return -ENODEV;
+	}
+	priv = dev->data->dev_private;
+	priv->kernels = ml_cpu_kernels_select();
+	priv->socket_id = rte_socket_id();
+	for (i = 0; i != RTE_DIM(priv->worker_ctx); i++)
+		priv->worker_ctx[i] = -1;
+
+	ret = rte_kvargs_process(kvlist, ML_CPU_WORKER_ARG, ml_cpu_parse_worker, priv);
+	rte_kvargs_free(kvlist);
+	if (ret < 0)
+		goto error;
+
+	if (priv->nb_workers != 0) {
+		memset(&service, 0, sizeof(service));
+		snprintf(service.name, sizeof(service.name), "ml_cpu_%d", dev->data->dev_id);
+		service.callback = ml_cpu_service;
+		service.callback_userdata = dev;
+		service.capabilities = RTE_SERVICE_CAP_MT_SAFE;
+		service.socket_id = priv->socket_id;
+		ret = rte_service_component_register(&service, &priv->service_id);
+		if (ret < 0)
+			goto error;
+		rte_service_component_runstate_set(priv->service_id, 1);
+	}
+
+	dev->dev_ops = &ml_cpu_ops;
+	dev->enqueue_burst = ml_cpu_enqueue_burst;
+	dev->dequeue_burst = ml_cpu_dequeue_burst;
+	dev->op_error_get = ml_cpu_op_error_get;
+	ML_CPU_LOG(INFO, "%s: %s kernels, %u workers", name, priv->kernels->name,
+		priv->nb_workers);
+	return 0;
+
+error:
+	rte_ml_dev_pmd_destroy(dev);
+	return ret;
+}
+
+static int
+ml_cpu_remove(struct rte_vdev_device *vdev)
+{
+	struct ml_cpu_priv *priv;
+	struct rte_ml_dev *dev;
+	const char *name;
+
+	name = rte_vdev_device_name(vdev);
+	if (name == NULL)
+		return -EINVAL;
+	dev = rte_ml_dev_pmd_get_named_dev(name);
+	if (dev == NULL)
+		return -ENODEV;
+
+	priv = dev->data->dev_private;
+	if (priv->nb_workers != 0) {
+		rte_service_component_runstate_set(priv->service_id, 0);
+		rte_service_component_unregister(priv->service_id);
+	}
+	ml_cpu_dev_close(dev);
+	return rte_ml_dev_pmd_destroy(dev);
+}
+
+static struct rte_vdev_driver ml_cpu_pmd_drv = {
+	.probe = ml_cpu_probe,
+	.remove = ml_cpu_remove,
+};
+
+RTE_PMD_REGISTER_VDEV(MLDEV_NAME_ML_CPU_PMD, ml_cpu_pmd_drv);
+RTE_PMD_REGISTER_PARAM_STRING(MLDEV_NAME_ML_CPU_PMD, ML_CPU_WORKER_ARG "=<lcore>");
+RTE_LOG_REGISTER_DEFAULT(ml_cpu_logtype, NOTICE);
@@ -0,0 +1,280 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#ifndef _ML_CPU_H_
+#define _ML_CPU_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <rte_common.h>
+#include <rte_log.h>
+#include <rte_mldev.h>
+#include <rte_mldev_core.h>
+
+#define MLDEV_NAME_ML_CPU_PMD		ml_cpu
+/**< CPU ML PMD device name */
+
+#define ML_CPU_MAX_MODELS		32
+#define ML_CPU_MAX_QPS			64
+#define ML_CPU_MAX_DESC			4096
+#define ML_CPU_MAX_SEGMENTS		16
+#define ML_CPU_MAX_BATCHES		32
+/**< Largest number of batches run at once, by an op or by ops merged */
+#define ML_CPU_MAX_LAYERS		64
+#define ML_CPU_MAX_ELEMENTS		(1 << 22)
+/**< Largest number of elements of a tensor of one batch */
+#define ML_CPU_MAX_DOT			(1 << 16)
+/**< Longest dot product, the int32 accumulator cannot overflow below */
+#define ML_CPU_ALIGN			64
+/**< Alignment of IO buffers, rows of weights and activations */
+#define ML_CPU_BURST			32
+#define ML_CPU_WORKER_ARG		"worker"
+
+extern int ml_cpu_logtype;
+#define RTE_LOGTYPE_ML_CPU ml_cpu_logtype
+#define ML_CPU_LOG(level, ...) \
+	RTE_LOG_LINE_PREFIX(level, ML_CPU, "%s(): ", __func__, __VA_ARGS__)
+
+/*
+ * Model file format. All fields are little endian.
+ *
+ * A model is a header followed by nb_layers layers. A layer is a layer
+ * header, followed for FC and CONV2D layers by the weights, as
+ * [out_c][kernel][kernel][in_c] elements of the model type (FC layers
+ * have a kernel of 1 over their flattened input), then by out_c biases,
+ * int32 for INT8 models and float for BF16 models.
+ * Tensors are stored as height, width, channels.
+ */
+
+#define ML_CPU_MODEL_MAGIC		"DPDKMLC"
+#define ML_CPU_MODEL_VERSION		1
+
+/** Element type of a model */
+enum ml_cpu_dtype {
+	ML_CPU_DTYPE_INT8 = 1,
+	/**< Asymmetric int8 activations, symmetric int8 weights */
+	ML_CPU_DTYPE_BF16 = 2,
+	/**< bfloat16 weights and IO, float activations */
+};
+
+enum ml_cpu_layer_type {
+	ML_CPU_LAYER_FC = 1,		/**< Fully connected */
+	ML_CPU_LAYER_CONV2D = 2,	/**< 2D convolution */
+	ML_CPU_LAYER_MAXPOOL2D = 3,	/**< 2D max pooling */
+	ML_CPU_LAYER_SOFTMAX = 4,	/**< Softmax over channels */
+};
+
+enum ml_cpu_act {
+	ML_CPU_ACT_NONE = 0,
+	ML_CPU_ACT_RELU = 1,
+};
+
+struct __rte_packed_begin ml_cpu_model_hdr {
+	char magic[8];
+	uint32_t version;
+	uint32_t dtype;
+	/**< enum ml_cpu_dtype */
+	char name[32];
+	uint16_t nb_layers;
+	uint16_t max_batches;
+	uint32_t in_dims[3];
+	/**< Input height, width and channels */
+	float in_scale;
+	int32_t in_zero_point;
+	/**< Quantization of the input of INT8 models */
+} __rte_packed_end;
+
+struct __rte_packed_begin ml_cpu_layer_hdr {
+	uint16_t type;
+	/**< enum ml_cpu_layer_type */
+	uint16_t act;
+	/**< enum ml_cpu_act, applied to the output of FC and CONV2D */
+	uint32_t out_c;
+	/**< Outputs of FC, filters of CONV2D, 0 for other layers */
+	uint16_t kernel;
+	/**< Square kernel size of CONV2D and MAXPOOL2D */
+	uint16_t stride;
+	uint16_t pad;
+	/**< Zero padding on each side of the CONV2D input */
+	uint16_t reserved;
+	float w_scale;
+	/**< Scale of the weights of INT8 models */
+	float out_scale;
+	int32_t out_zero_point;
+	/**< Quantization of the output of INT8 models */
+} __rte_packed_end;
+
+/*
+ * Kernels.
+ * Activations of INT8 models are stored biased as uint8 (q + 128),
+ * to fit the unsigned by signed multiplications of x86.
+ * Vectors are padded with zero weights to a multiple of ML_CPU_ALIGN.
+ */
+
+typedef int32_t (*ml_cpu_dot_u8i8_t)(const uint8_t *x, const int8_t *w, uint32_t n);
+typedef float (*ml_cpu_dot_f32bf16_t)(const float *x, const uint16_t *w, uint32_t n);
+
+struct ml_cpu_kernels {
+	const char *name;
+	ml_cpu_dot_u8i8_t dot_u8i8;
+	ml_cpu_dot_f32bf16_t dot_f32bf16;
+};
+
+extern const struct ml_cpu_kernels ml_cpu_kernels_scalar;
+#ifdef RTE_ARCH_X86
+extern const struct ml_cpu_kernels ml_cpu_kernels_avx2;
+#ifdef CC_AVX512_SUPPORT
+extern const struct ml_cpu_kernels ml_cpu_kernels_avx512;
+extern const struct ml_cpu_kernels ml_cpu_kernels_avx512_vnni;
+#endif
+#endif
+
+/** Layer of a loaded model */
+struct ml_cpu_layer {
+	uint16_t type;
+	uint16_t act;
+	uint32_t in_h, in_w, in_c;
+	uint32_t out_h, out_w, out_c;
+	uint16_t kernel;
+	uint16_t stride;
+	uint16_t pad;
+	uint32_t k;
+	/**< Length of the dot products */
+	uint32_t k_pad;
+	/**< Length of the rows of weights */
+	uint32_t in_stride;
+	uint32_t out_stride;
+	/**< Elements between batches of the input and output activations */
+	void *weights;
+	/**< out_c rows of k_pad int8 or bf16 elements */
+	int32_t *bias;
+	/**< INT8: bias less the contribution of the input zero point */
+	float *fbias;
+	/**< BF16: bias */
+	float mult;
+	/**< INT8: requantization of the accumulator to the output */
+	float in_scale;
+	int32_t in_zp;
+	float out_scale;
+	int32_t out_zp;
+};
+
+/** Working memory of a model for a context */
+struct ml_cpu_scratch {
+	void *act[2];
+	/**< Ping-pong activations */
+	void *row;
+	/**< Convolution input patch, softmax and IO conversions */
+};
+
+enum ml_cpu_model_state {
+	ML_CPU_MODEL_LOADED,
+	ML_CPU_MODEL_STARTED,
+};
+
+struct ml_cpu_model {
+	uint16_t model_id;
+	enum ml_cpu_model_state state;
+	uint32_t dtype;
+	uint16_t max_batches;
+	uint16_t nb_layers;
+	struct ml_cpu_layer layers[ML_CPU_MAX_LAYERS];
+	uint32_t in_elements;
+	uint32_t out_elements;
+	uint32_t in_size;
+	uint32_t out_size;
+	/**< Bytes of the input and output of one batch */
+	size_t act_size;
+	/**< Bytes of each activation buffer */
+	size_t row_size;
+	uint64_t wb_size;
+	uint32_t in_shape[4];
+	uint32_t out_shape[4];
+	struct rte_ml_io_info input;
+	struct rte_ml_io_info output;
+	struct rte_ml_model_info info;
+	uint16_t nb_ctx;
+	struct ml_cpu_scratch *scratch;
+	/**< Per context, when started */
+};
+
+struct __rte_cache_aligned ml_cpu_qp {
+	uint16_t id;
+	RTE_ATOMIC(struct rte_ml_op *) *slots;
+	/**< Operations by sequence number, NULL until completed */
+	uint32_t mask;
+	/**< Number of slots less one */
+	rte_ml_dev_stop_flush_t cb;
+	uint32_t nb_desc;
+	uint64_t enqueued;
+	/**< Written by the enqueue thread, sequence number of the next op */
+	RTE_ATOMIC(uint64_t) dequeued;
+	/**< Written by the dequeue thread, sequence number of the next op */
+	struct rte_ml_dev_stats stats;
+};
+
+struct ml_cpu_worker {
+	uint32_t lcore_id;
+	bool added;
+	/**< The lcore was made a service lcore by the device */
+};
+
+struct ml_cpu_priv {
+	const struct ml_cpu_kernels *kernels;
+	uint16_t nb_workers;
+	struct ml_cpu_worker workers[RTE_MAX_LCORE];
+	int16_t worker_ctx[RTE_MAX_LCORE];
+	/**< Context index of each worker lcore, -1 for other lcores */
+	uint32_t service_id;
+	struct rte_ring *jobs;
+	/**< Operations waiting for a worker */
+	uint16_t nb_ctx;
+	/**< Queue pairs, or workers when inference runs on workers */
+	int socket_id;
+};
+
+/** Error codes of failed operations */
+enum ml_cpu_op_error {
+	ML_CPU_OP_ERR_NONE,
+	ML_CPU_OP_ERR_MODEL,
+	ML_CPU_OP_ERR_BATCHES,
+	ML_CPU_OP_ERR_INPUT,
+	ML_CPU_OP_ERR_OUTPUT,
+	ML_CPU_OP_ERR_MAX,
+};
+
+/** Layout of rte_ml_op::impl_opaque */
+union ml_cpu_op_opaque {
+	uint64_t u64;
+	struct {
+		uint32_t seq;
+		/**< Sequence number of the operation in its queue pair */
+		uint16_t qp_id;
+		uint16_t error;
+		/**< enum ml_cpu_op_error */
+	};
+};
+
+static inline union ml_cpu_op_opaque *
+ml_cpu_op_opaque(struct rte_ml_op *op)
+{
+	return (union ml_cpu_op_opaque *)&op->impl_opaque;
+}
+
+/* ml_cpu_model.c */
+int ml_cpu_model_parse(struct ml_cpu_model *model, const void *buf, size_t size,
+		int socket_id);
+void ml_cpu_model_free(struct ml_cpu_model *model);
+int ml_cpu_model_scratch_alloc(struct ml_cpu_model *model, uint16_t nb_ctx, int socket_id);
+void ml_cpu_model_scratch_free(struct ml_cpu_model *model);
+
+/* ml_cpu_kernels.c */
+const struct ml_cpu_kernels *ml_cpu_kernels_select(void);
+
+/* ml_cpu_infer.c */
+void ml_cpu_run_burst(struct rte_ml_dev *dev, uint16_t ctx, struct rte_ml_op **ops,
+		uint16_t nb_ops);
+
+#endif /* _ML_CPU_H_ */
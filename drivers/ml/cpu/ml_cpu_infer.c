@@ -0,0 +1,409 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include <rte_common.h>
+
+#include "ml_cpu.h"
+
+/* position in the segments of an IO buffer */
+struct seg_cursor {
+	struct rte_ml_buff_seg *seg;
+	uint32_t ofs;
+};
+
+static void
+seg_copy(struct seg_cursor *cur, void *data, uint32_t len, bool write)
+{
+	uint32_t n;
+
+	while (len != 0) {
+		n = RTE_MIN(len, cur->seg->length - cur->ofs);
+		if (write)
+			memcpy(RTE_PTR_ADD(cur->seg->addr, cur->ofs), data, n);
+		else
+			memcpy(data, RTE_PTR_ADD(cur->seg->addr, cur->ofs), n);
+		data = RTE_PTR_ADD(data, n);
+		len -= n;
+		cur->ofs += n;
+		if (cur->ofs == cur->seg->length) {
+			cur->seg = cur->seg->next;
+			cur->ofs = 0;
+		}
+	}
+}
+
+static uint64_t
+seg_length(const struct rte_ml_buff_seg *seg)
+{
+	uint64_t len = 0;
+	uint32_t n;
+
+	for (n = 0; seg != NULL; seg = seg->next) {
+		if (++n > ML_CPU_MAX_SEGMENTS)
+			return 0;
+		len += seg->length;
+	}
+	return len;
+}
+
+static enum ml_cpu_op_error
+op_check(struct rte_ml_dev *dev, const struct rte_ml_op *op)
+{
+	const struct ml_cpu_model *model;
+
+	if (op->model_id >= dev->data->nb_models)
+		return ML_CPU_OP_ERR_MODEL;
+	model = dev->data->models[op->model_id];
+	if (model == NULL || model->state != ML_CPU_MODEL_STARTED)
+		return ML_CPU_OP_ERR_MODEL;
+	if (op->nb_batches == 0 || op->nb_batches > model->max_batches)
+		return ML_CPU_OP_ERR_BATCHES;
+	if (op->input == NULL ||
+			seg_length(op->input[0]) < (uint64_t)op->nb_batches * model->in_size)
+		return ML_CPU_OP_ERR_INPUT;
+	if (op->output == NULL ||
+			seg_length(op->output[0]) < (uint64_t)op->nb_batches * model->out_size)
+		return ML_CPU_OP_ERR_OUTPUT;
+	return ML_CPU_OP_ERR_NONE;
+}
+
+/* gather the input window of a convolution output position */
+static void
+conv_patch(const struct ml_cpu_layer *l, const uint8_t *in, uint8_t *row,
+		uint32_t oy, uint32_t ox, size_t esize, int pad)
+{
+	size_t csize = l->in_c * esize;
+	int32_t iy, ix, x0;
+	uint32_t ky, kx;
+
+	x0 = (int32_t)(ox * l->stride) - l->pad;
+	for (ky = 0; ky != l->kernel; ky++) {
+		iy = (int32_t)(oy * l->stride + ky) - l->pad;
+		if (iy >= 0 && iy < (int32_t)l->in_h && x0 >= 0 &&
+				(uint32_t)x0 + l->kernel <= l->in_w) {
+			memcpy(row, in + ((size_t)iy * l->in_w + x0) * csize,
+				l->kernel * csize);
+			row += l->kernel * csize;
+			continue;
+		}
+		for (kx = 0; kx != l->kernel; kx++) {
+			ix = x0 + kx;
+			if (iy < 0 || ix < 0 || iy >= (int32_t)l->in_h ||
+					ix >= (int32_t)l->in_w)
+				memset(row, pad, csize);
+			else
+				memcpy(row, in + ((size_t)iy * l->in_w + ix) * csize, csize);
+			row += csize;
+		}
+	}
+}
+
+/*
+ * INT8 models.
+ */
+
+static inline uint8_t
+requantize(const struct ml_cpu_layer *l, int32_t acc)
+{
+	float f = acc * l->mult;
+	int32_t q, lo;
+
+	f = RTE_MIN(RTE_MAX(f, -256.0f), 256.0f);
+	q = (int32_t)lrintf(f) + l->out_zp;
+	lo = l->act == ML_CPU_ACT_RELU ? l->out_zp : INT8_MIN;
+	q = RTE_MIN(RTE_MAX(q, lo), INT8_MAX);
+	return q + 128;
+}
+
+static void
+layer_run_i8(const struct ml_cpu_kernels *kn, const struct ml_cpu_layer *l,
+		const uint8_t *in, uint8_t *out, uint8_t *row, uint32_t nb)
+{
+	uint32_t b, o, oy, ox, ch, ky, kx, pos, npos;
+	const int8_t *w;
+	const uint8_t *src;
+	uint8_t *dst, m;
+	float *tmp, max, sum, f;
+	int32_t q;
+
+	switch (l->type) {
+	case ML_CPU_LAYER_FC:
+		/* each row of weights is used for all batches */
+		for (o = 0; o != l->out_c; o++) {
+			w = RTE_PTR_ADD(l->weights, (size_t)o * l->k_pad);
+			for (b = 0; b != nb; b++)
+				out[(size_t)b * l->out_stride + o] = requantize(l,
+					kn->dot_u8i8(in + (size_t)b * l->in_stride, w,
+						l->k_pad) + l->bias[o]);
+		}
+		break;
+	case ML_CPU_LAYER_CONV2D:
+		memset(row + l->k, 0, l->k_pad - l->k);
+		for (b = 0; b != nb; b++) {
+			src = in + (size_t)b * l->in_stride;
+			dst = out + (size_t)b * l->out_stride;
+			for (oy = 0; oy != l->out_h; oy++) {
+				for (ox = 0; ox != l->out_w; ox++) {
+					conv_patch(l, src, row, oy, ox, 1, 128 + l->in_zp);
+					for (o = 0; o != l->out_c; o++) {
+						w = RTE_PTR_ADD(l->weights,
+							(size_t)o * l->k_pad);
+						dst[o] = requantize(l, kn->dot_u8i8(row, w,
+							l->k_pad) + l->bias[o]);
+					}
+					dst += l->out_c;
+				}
+			}
+		}
+		break;
+	case ML_CPU_LAYER_MAXPOOL2D:
+		/* the biased values have the order of the quantized ones */
+		for (b = 0; b != nb; b++) {
+			src = in + (size_t)b * l->in_stride;
+			dst = out + (size_t)b * l->out_stride;
+			for (oy = 0; oy != l->out_h; oy++) {
+				for (ox = 0; ox != l->out_w; ox++) {
+					for (ch = 0; ch != l->out_c; ch++) {
+						m = 0;
+						for (ky = 0; ky != l->kernel; ky++)
+							for (kx = 0; kx != l->kernel; kx++)
+								m = RTE_MAX(m, src[(((size_t)oy * l->stride + ky) *
+									l->in_w + ox * l->stride + kx) *
+									l->in_c + ch]);
+						*dst++ = m;
+					}
+				}
+			}
+		}
+		break;
+	case ML_CPU_LAYER_SOFTMAX:
+		tmp = (float *)row;
+		npos = l->out_h * l->out_w;
+		for (b = 0; b != nb; b++) {
+			for (pos = 0; pos != npos; pos++) {
+				src = in + (size_t)b * l->in_stride + (size_t)pos * l->in_c;
+				dst = out + (size_t)b * l->out_stride + (size_t)pos * l->out_c;
+				max = -INFINITY;
+				for (ch = 0; ch != l->in_c; ch++) {
+					tmp[ch] = l->in_scale * (src[ch] - 128 - l->in_zp);
+					max = RTE_MAX(max, tmp[ch]);
+				}
+				sum = 0;
+				for (ch = 0; ch != l->in_c; ch++) {
+					tmp[ch] = expf(tmp[ch] - max);
+					sum += tmp[ch];
+				}
+				for (ch = 0; ch != l->in_c; ch++) {
+					f = tmp[ch] / sum / l->out_scale;
+					q = (int32_t)lrintf(RTE_MIN(f, 256.0f)) + l->out_zp;
+					dst[ch] = RTE_MIN(RTE_MAX(q, INT8_MIN), INT8_MAX) + 128;
+				}
+			}
+		}
+		break;
+	}
+}
+
+/*
+ * BF16 models.
+ */
+
+static inline float
+activate(const struct ml_cpu_layer *l, float f)
+{
+	return l->act == ML_CPU_ACT_RELU ? RTE_MAX(f, 0.0f) : f;
+}
+
+static void
+layer_run_f32(const struct ml_cpu_kernels *kn, const struct ml_cpu_layer *l,
+		const float *in, float *out, float *row, uint32_t nb)
+{
+	uint32_t b, o, oy, ox, ch, ky, kx, pos, npos, n;
+	const uint16_t *w;
+	const float *src;
+	float *dst, m, sum;
+
+	switch (l->type) {
+	case ML_CPU_LAYER_FC:
+		for (o = 0; o != l->out_c; o++) {
+			w = RTE_PTR_ADD(l->weights, (size_t)o * l->k_pad * sizeof(*w));
+			for (b = 0; b != nb; b++)
+				out[(size_t)b * l->out_stride + o] = activate(l,
+					kn->dot_f32bf16(in + (size_t)b * l->in_stride, w,
+						l->k_pad) + l->fbias[o]);
+		}
+		break;
+	case ML_CPU_LAYER_CONV2D:
+		memset(row + l->k, 0, (l->k_pad - l->k) * sizeof(*row));
+		for (b = 0; b != nb; b++) {
+			src = in + (size_t)b * l->in_stride;
+			dst = out + (size_t)b * l->out_stride;
+			for (oy = 0; oy != l->out_h; oy++) {
+				for (ox = 0; ox != l->out_w; ox++) {
+					conv_patch(l, (const uint8_t *)src, (uint8_t *)row,
+						oy, ox, sizeof(float), 0);
+					for (o = 0; o != l->out_c; o++) {
+						w = RTE_PTR_ADD(l->weights,
+							(size_t)o * l->k_pad * sizeof(*w));
+						dst[o] = activate(l, kn->dot_f32bf16(row, w,
+							l->k_pad) + l->fbias[o]);
+					}
+					dst += l->out_c;
+				}
+			}
+		}
+		break;
+	case ML_CPU_LAYER_MAXPOOL2D:
+		for (b = 0; b != nb; b++) {
+			src = in + (size_t)b * l->in_stride;
+			dst = out + (size_t)b * l->out_stride;
+			for (oy = 0; oy != l->out_h; oy++) {
+				for (ox = 0; ox != l->out_w; ox++) {
+					for (ch = 0; ch != l->out_c; ch++) {
+						m = -INFINITY;
+						for (ky = 0; ky != l->kernel; ky++)
+							for (kx = 0; kx != l->kernel; kx++)
+								m = RTE_MAX(m, src[(((size_t)oy * l->stride + ky) *
+									l->in_w + ox * l->stride + kx) *
+									l->in_c + ch]);
+						*dst++ = m;
+					}
+				}
+			}
+		}
+		break;
+	case ML_CPU_LAYER_SOFTMAX:
+		npos = l->out_h * l->out_w;
+		for (b = 0; b != nb; b++) {
+			for (pos = 0; pos != npos; pos++) {
+				src = in + (size_t)b * l->in_stride + (size_t)pos * l->in_c;
+				dst = out + (size_t)b * l->out_stride + (size_t)pos * l->out_c;
+				m = -INFINITY;
+				for (ch = 0; ch != l->in_c; ch++)
+					m = RTE_MAX(m, src[ch]);
+				sum = 0;
+				for (ch = 0; ch != l->in_c; ch++) {
+					dst[ch] = expf(src[ch] - m);
+					sum += dst[ch];
+				}
+				for (ch = 0; ch != l->in_c; ch++)
+					dst[ch] /= sum;
+			}
+		}
+		break;
+	}
+
+	/* the padding is multiplied by the zero weights of the next layer */
+	n = l->out_h * l->out_w * l->out_c;
+	for (b = 0; b != nb; b++)
+		memset(out + (size_t)b * l->out_stride + n, 0,
+			(l->out_stride - n) * sizeof(*out));
+}
+
+/* run the model once on the batches of consecutive operations */
+static void
+run_group(const struct ml_cpu_kernels *kn, const struct ml_cpu_model *model,
+		const struct ml_cpu_scratch *scr, struct rte_ml_op **ops,
+		uint16_t nb_ops, uint32_t nb)
+{
+	const struct ml_cpu_layer *first = &model->layers[0];
+	const struct ml_cpu_layer *last = &model->layers[model->nb_layers - 1];
+	size_t esize = model->dtype == ML_CPU_DTYPE_INT8 ? 1 : sizeof(float);
+	struct seg_cursor cur;
+	uint32_t b, i, j, e;
+	uint8_t *act, *row;
+	uint16_t k;
+
+	row = scr->row;
+	b = 0;
+	for (k = 0; k != nb_ops; k++) {
+		cur.seg = ops[k]->input[0];
+		cur.ofs = 0;
+		for (j = 0; j != ops[k]->nb_batches; j++, b++) {
+			act = RTE_PTR_ADD(scr->act[0], (size_t)b * first->in_stride * esize);
+			if (model->dtype == ML_CPU_DTYPE_INT8) {
+				seg_copy(&cur, act, model->in_size, false);
+				for (e = 0; e != model->in_elements; e++)
+					act[e] ^= 0x80;
+			} else {
+				seg_copy(&cur, row, model->in_size, false);
+				rte_ml_io_bfloat16_to_float32(row, act, model->in_elements);
+				memset(act + model->in_elements * esize, 0,
+					(first->in_stride - model->in_elements) * esize);
+			}
+		}
+	}
+
+	for (i = 0; i != model->nb_layers; i++) {
+		if (model->dtype == ML_CPU_DTYPE_INT8)
+			layer_run_i8(kn, &model->layers[i], scr->act[i & 1],
+				scr->act[(i + 1) & 1], row, nb);
+		else
+			layer_run_f32(kn, &model->layers[i], scr->act[i & 1],
+				scr->act[(i + 1) & 1], (float *)row, nb);
+	}
+
+	b = 0;
+	for (k = 0; k != nb_ops; k++) {
+		cur.seg = ops[k]->output[0];
+		cur.ofs = 0;
+		for (j = 0; j != ops[k]->nb_batches; j++, b++) {
+			act = RTE_PTR_ADD(scr->act[model->nb_layers & 1],
+				(size_t)b * last->out_stride * esize);
+			if (model->dtype == ML_CPU_DTYPE_INT8) {
+				for (e = 0; e != model->out_elements; e++)
+					row[e] = act[e] ^ 0x80;
+			} else {
+				rte_ml_io_float32_to_bfloat16(act, row, model->out_elements);
+			}
+			seg_copy(&cur, row, model->out_size, true);
+		}
+		ops[k]->status = RTE_ML_OP_STATUS_SUCCESS;
+	}
+}
+
+/*
+ * Run a burst of operations. Consecutive operations of a model are merged
+ * in a single run, up to the largest number of batches of the model,
+ * so that the weights are read once for all of them.
+ */
+void
+ml_cpu_run_burst(struct rte_ml_dev *dev, uint16_t ctx, struct rte_ml_op **ops,
+		uint16_t nb_ops)
+{
+	struct ml_cpu_priv *priv = dev->data->dev_private;
+	const struct ml_cpu_model *model;
+	enum ml_cpu_op_error err;
+	uint16_t i, j;
+	uint32_t nb;
+
+	for (i = 0; i != nb_ops; i++) {
+		err = op_check(dev, ops[i]);
+		ml_cpu_op_opaque(ops[i])->error = err;
+		ops[i]->status = err == ML_CPU_OP_ERR_NONE ?
+			RTE_ML_OP_STATUS_NOT_PROCESSED : RTE_ML_OP_STATUS_ERROR;
+	}
+
+	i = 0;
+	while (i != nb_ops) {
+		if (ops[i]->status == RTE_ML_OP_STATUS_ERROR) {
+			i++;
+			continue;
+		}
+		model = dev->data->models[ops[i]->model_id];
+		nb = ops[i]->nb_batches;
+		for (j = i + 1; j != nb_ops; j++) {
+			if (ops[j]->status == RTE_ML_OP_STATUS_ERROR ||
+					ops[j]->model_id != ops[i]->model_id ||
+					nb + ops[j]->nb_batches > model->max_batches)
+				break;
+			nb += ops[j]->nb_batches;
+		}
+		run_group(priv->kernels, model, &model->scratch[ctx], &ops[i], j - i, nb);
+		i = j;
+	}
+}
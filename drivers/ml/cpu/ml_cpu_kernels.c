@@ -0,0 +1,65 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_cpuflags.h>
+#include <rte_vect.h>
+
+#include "ml_cpu.h"
+
+static int32_t
+dot_u8i8_scalar(const uint8_t *x, const int8_t *w, uint32_t n)
+{
+	int32_t acc = 0;
+	uint32_t i;
+
+	for (i = 0; i != n; i++)
+		acc += x[i] * w[i];
+	return acc;
+}
+
+static float
+dot_f32bf16_scalar(const float *x, const uint16_t *w, uint32_t n)
+{
+	uint32_t i, u;
+	float acc, f;
+
+	acc = 0;
+	for (i = 0; i != n; i++) {
+		u = (uint32_t)w[i] << 16;
+		memcpy(&f, &u, sizeof(f));
+		acc += x[i] * f;
+	}
+	return acc;
+}
+
+const struct ml_cpu_kernels ml_cpu_kernels_scalar = {
+	.name = "scalar",
+	.dot_u8i8 = dot_u8i8_scalar,
+	.dot_f32bf16 = dot_f32bf16_scalar,
+};
+
+const struct ml_cpu_kernels *
+ml_cpu_kernels_select(void)
+{
+#ifdef RTE_ARCH_X86
+	uint16_t simd = rte_vect_get_max_simd_bitwidth();
+
+#ifdef CC_AVX512_SUPPORT
+	if (simd >= RTE_VECT_SIMD_512 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) == 1 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512BW) == 1) {
+		if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512VNNI) == 1)
+			return &ml_cpu_kernels_avx512_vnni;
+		return &ml_cpu_kernels_avx512;
+	}
+#endif
+	if (simd >= RTE_VECT_SIMD_256 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2) == 1)
+		return &ml_cpu_kernels_avx2;
+#endif
+	return &ml_cpu_kernels_scalar;
+}
@@ -0,0 +1,85 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include <rte_vect.h>
+
+#include "ml_cpu.h"
+
+static inline int32_t
+hsum_epi32(__m256i v)
+{
+	__m128i s;
+
+	s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+	s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(1, 0, 3, 2)));
+	s = _mm_add_epi32(s, _mm_shuffle_epi32(s, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(s);
+}
+
+static inline float
+hsum_ps(__m256 v)
+{
+	__m128 s;
+
+	s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+	s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+	s = _mm_add_ss(s, _mm_movehdup_ps(s));
+	return _mm_cvtss_f32(s);
+}
+
+/*
+ * The products are widened to 16 bits before madd, maddubs would
+ * saturate on pairs of large products.
+ */
+static int32_t
+dot_u8i8_avx2(const uint8_t *x, const int8_t *w, uint32_t n)
+{
+	__m256i acc0, acc1, xv, wv;
+	uint32_t i;
+
+	acc0 = _mm256_setzero_si256();
+	acc1 = _mm256_setzero_si256();
+	for (i = 0; i != n; i += 32) {
+		xv = _mm256_loadu_si256((const __m256i *)(x + i));
+		wv = _mm256_loadu_si256((const __m256i *)(w + i));
+		acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(
+			_mm256_cvtepu8_epi16(_mm256_castsi256_si128(xv)),
+			_mm256_cvtepi8_epi16(_mm256_castsi256_si128(wv))));
+		acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(
+			_mm256_cvtepu8_epi16(_mm256_extracti128_si256(xv, 1)),
+			_mm256_cvtepi8_epi16(_mm256_extracti128_si256(wv, 1))));
+	}
+	return hsum_epi32(_mm256_add_epi32(acc0, acc1));
+}
+
+static inline __m256
+bf16_load(const uint16_t *w)
+{
+	__m256i v = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)w));
+
+	return _mm256_castsi256_ps(_mm256_slli_epi32(v, 16));
+}
+
+static float
+dot_f32bf16_avx2(const float *x, const uint16_t *w, uint32_t n)
+{
+	__m256 acc0, acc1;
+	uint32_t i;
+
+	acc0 = _mm256_setzero_ps();
+	acc1 = _mm256_setzero_ps();
+	for (i = 0; i != n; i += 16) {
+		acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(x + i),
+			bf16_load(w + i)));
+		acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(x + i + 8),
+			bf16_load(w + i + 8)));
+	}
+	return hsum_ps(_mm256_add_ps(acc0, acc1));
+}
+
+const struct ml_cpu_kernels ml_cpu_kernels_avx2 = {
+	.name = "avx2",
+	.dot_u8i8 = dot_u8i8_avx2,
+	.dot_f32bf16 = dot_f32bf16_avx2,
+};
@@ -0,0 +1,72 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include <rte_vect.h>
+
+#include "ml_cpu.h"
+
+static int32_t
+dot_u8i8_avx512(const uint8_t *x, const int8_t *w, uint32_t n)
+{
+	__m512i acc0, acc1;
+	uint32_t i;
+
+	acc0 = _mm512_setzero_si512();
+	acc1 = _mm512_setzero_si512();
+	for (i = 0; i != n; i += 64) {
+		acc0 = _mm512_add_epi32(acc0, _mm512_madd_epi16(
+			_mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)(x + i))),
+			_mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i *)(w + i)))));
+		acc1 = _mm512_add_epi32(acc1, _mm512_madd_epi16(
+			_mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)(x + i + 32))),
+			_mm512_cvtepi8_epi16(_mm256_loadu_si256((const __m256i *)(w + i + 32)))));
+	}
+	return _mm512_reduce_add_epi32(_mm512_add_epi32(acc0, acc1));
+}
+
+/* one instruction multiplies and accumulates 64 unsigned by signed bytes */
+static __attribute__((target("avx512vnni"))) int32_t
+dot_u8i8_avx512_vnni(const uint8_t *x, const int8_t *w, uint32_t n)
+{
+	__m512i acc;
+	uint32_t i;
+
+	acc = _mm512_setzero_si512();
+	for (i = 0; i != n; i += 64)
+		acc = _mm512_dpbusd_epi32(acc,
+			_mm512_loadu_si512((const void *)(x + i)),
+			_mm512_loadu_si512((const void *)(w + i)));
+	return _mm512_reduce_add_epi32(acc);
+}
+
+static float
+dot_f32bf16_avx512(const float *x, const uint16_t *w, uint32_t n)
+{
+	__m512 acc0, acc1, w0, w1;
+	uint32_t i;
+
+	acc0 = _mm512_setzero_ps();
+	acc1 = _mm512_setzero_ps();
+	for (i = 0; i != n; i += 32) {
+		w0 = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(
+			_mm256_loadu_si256((const __m256i *)(w + i))), 16));
+		w1 = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(
+			_mm256_loadu_si256((const __m256i *)(w + i + 16))), 16));
+		acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i), w0, acc0);
+		acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 16), w1, acc1);
+	}
+	return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+}
+
+const struct ml_cpu_kernels ml_cpu_kernels_avx512 = {
+	.name = "avx512",
+	.dot_u8i8 = dot_u8i8_avx512,
+	.dot_f32bf16 = dot_f32bf16_avx512,
+};
+
+const struct ml_cpu_kernels ml_cpu_kernels_avx512_vnni = {
+	.name = "avx512_vnni",
+	.dot_u8i8 = dot_u8i8_avx512_vnni,
+	.dot_f32bf16 = dot_f32bf16_avx512,
+};
@@ -0,0 +1,361 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_malloc.h>
+#include <rte_string_fns.h>
+
+#include "ml_cpu.h"
+
+static bool
+quant_valid(float scale, int32_t zero_point)
+{
+	return isfinite(scale) && scale > 0 &&
+		zero_point >= INT8_MIN && zero_point <= INT8_MAX;
+}
+
+/* copy rows of weights, padded with zeros, and fold the biases */
+static int
+layer_weights_load(struct ml_cpu_layer *l, uint32_t dtype, const uint8_t *w,
+		const uint8_t *b, int socket_id)
+{
+	size_t esize = dtype == ML_CPU_DTYPE_INT8 ? 1 : 2;
+	const int8_t *row;
+	int64_t sum, bias;
+	int32_t b32;
+	float bf;
+	uint32_t o, i;
+
+	l->weights = rte_zmalloc_socket("ml_cpu_weights",
+		(size_t)l->out_c * l->k_pad * esize, ML_CPU_ALIGN, socket_id);
+	if (l->weights == NULL)
+		return -ENOMEM;
+	for (o = 0; o != l->out_c; o++)
+		memcpy(RTE_PTR_ADD(l->weights, (size_t)o * l->k_pad * esize),
+			w + (size_t)o * l->k * esize, l->k * esize);
+
+	if (dtype == ML_CPU_DTYPE_BF16) {
+		l->fbias = rte_malloc_socket("ml_cpu_bias",
+			l->out_c * sizeof(float), 0, socket_id);
+		if (l->fbias == NULL)
+			return -ENOMEM;
+		for (o = 0; o != l->out_c; o++) {
+			memcpy(&bf, b + o * sizeof(float), sizeof(float));
+			if (!isfinite(bf))
+				return -EINVAL;
+			l->fbias[o] = bf;
+		}
+		return 0;
+	}
+
+	/*
+	 * The accumulator is the dot product of the biased inputs q + 128,
+	 * remove the contribution of the bias and of the input zero point.
+	 */
+	l->bias = rte_malloc_socket("ml_cpu_bias", l->out_c * sizeof(int32_t),
+		0, socket_id);
+	if (l->bias == NULL)
+		return -ENOMEM;
+	for (o = 0; o != l->out_c; o++) {
+		row = RTE_PTR_ADD(l->weights, (size_t)o * l->k_pad);
+		sum = 0;
+		for (i = 0; i != l->k; i++)
+			sum += row[i];
+		memcpy(&b32, b + o * sizeof(int32_t), sizeof(int32_t));
+		bias = b32 - (128 + l->in_zp) * sum;
+		if (bias < INT32_MIN || bias > INT32_MAX)
+			return -EINVAL;
+		l->bias[o] = bias;
+	}
+	return 0;
+}
+
+static void
+io_info_set(struct rte_ml_io_info *io, const char *name, uint32_t *shape,
+		uint32_t h, uint32_t w, uint32_t c, uint32_t dtype, float scale,
+		int32_t zero_point)
+{
+	strlcpy(io->name, name, sizeof(io->name));
+	shape[0] = 1;
+	if (h == 1 && w == 1) {
+		io->nb_dims = 2;
+		shape[1] = c;
+	} else {
+		io->nb_dims = 4;
+		shape[1] = h;
+		shape[2] = w;
+		shape[3] = c;
+	}
+	io->shape = shape;
+	io->nb_elements = (uint64_t)h * w * c;
+	if (dtype == ML_CPU_DTYPE_INT8) {
+		io->type = RTE_ML_IO_TYPE_INT8;
+		io->size = io->nb_elements;
+		io->scale = scale;
+		io->zero_point = zero_point;
+	} else {
+		io->type = RTE_ML_IO_TYPE_BFLOAT16;
+		io->size = io->nb_elements * sizeof(uint16_t);
+		io->scale = 1;
+		io->zero_point = 0;
+	}
+}
+
+int
+ml_cpu_model_parse(struct ml_cpu_model *model, const void *buf, size_t size,
+		int socket_id)
+{
+	const struct ml_cpu_model_hdr *hdr = buf;
+	const uint8_t *p = buf, *end = p + size;
+	struct ml_cpu_layer_hdr lh;
+	struct ml_cpu_layer *l;
+	uint32_t h, w, c, i;
+	size_t act, esize, row;
+	uint64_t n, wsize;
+	float scale;
+	int32_t zp;
+	int ret;
+
+	if (size < sizeof(*hdr) ||
+			memcmp(hdr->magic, ML_CPU_MODEL_MAGIC, sizeof(ML_CPU_MODEL_MAGIC)) != 0) {
+		ML_CPU_LOG(ERR, "invalid model header");
+		return -EINVAL;
+	}
+	if (hdr->version != ML_CPU_MODEL_VERSION) {
+		ML_CPU_LOG(ERR, "unsupported model version %u", hdr->version);
+		return -ENOTSUP;
+	}
+	if (hdr->dtype != ML_CPU_DTYPE_INT8 && hdr->dtype != ML_CPU_DTYPE_BF16) {
+		ML_CPU_LOG(ERR, "unsupported model type %u", hdr->dtype);
+		return -ENOTSUP;
+	}
+	if (hdr->nb_layers == 0 || hdr->nb_layers > ML_CPU_MAX_LAYERS) {
+		ML_CPU_LOG(ERR, "invalid number of layers %u", hdr->nb_layers);
+		return -EINVAL;
+	}
+
+	model->dtype = hdr->dtype;
+	model->nb_layers = hdr->nb_layers;
+	model->max_batches = RTE_MIN(RTE_MAX(hdr->max_batches, 1), ML_CPU_MAX_BATCHES);
+	esize = model->dtype == ML_CPU_DTYPE_INT8 ? 1 : sizeof(float);
+
+	h = hdr->in_dims[0];
+	w = hdr->in_dims[1];
+	c = hdr->in_dims[2];
+	n = (uint64_t)h * w * c;
+	if (n == 0 || n > ML_CPU_MAX_ELEMENTS) {
+		ML_CPU_LOG(ERR, "invalid input dimensions");
+		return -EINVAL;
+	}
+	scale = hdr->in_scale;
+	zp = hdr->in_zero_point;
+	if (model->dtype == ML_CPU_DTYPE_INT8 && !quant_valid(scale, zp)) {
+		ML_CPU_LOG(ERR, "invalid input quantization");
+		return -EINVAL;
+	}
+	model->in_elements = n;
+	io_info_set(&model->input, "input", model->in_shape, h, w, c, model->dtype,
+		scale, zp);
+
+	act = RTE_ALIGN_CEIL(n, ML_CPU_ALIGN) * esize;
+	row = n * sizeof(uint16_t);
+	p += sizeof(*hdr);
+	for (i = 0; i != model->nb_layers; i++) {
+		if ((size_t)(end - p) < sizeof(lh))
+			goto truncated;
+		memcpy(&lh, p, sizeof(lh));
+		p += sizeof(lh);
+
+		l = &model->layers[i];
+		l->type = lh.type;
+		l->act = lh.act;
+		l->in_h = h;
+		l->in_w = w;
+		l->in_c = c;
+		l->kernel = lh.kernel;
+		l->stride = lh.stride;
+		l->pad = lh.pad;
+		l->in_scale = scale;
+		l->in_zp = zp;
+		l->out_scale = lh.out_scale;
+		l->out_zp = lh.out_zero_point;
+		if (lh.act != ML_CPU_ACT_NONE && lh.act != ML_CPU_ACT_RELU)
+			goto invalid;
+
+		switch (lh.type) {
+		case ML_CPU_LAYER_FC:
+			l->kernel = 1;
+			l->stride = 1;
+			l->pad = 0;
+			l->k = h * w * c;
+			l->out_h = 1;
+			l->out_w = 1;
+			l->out_c = lh.out_c;
+			break;
+		case ML_CPU_LAYER_CONV2D:
+			if (lh.kernel == 0 || lh.stride == 0 || lh.pad >= lh.kernel ||
+					h + 2 * lh.pad < lh.kernel ||
+					w + 2 * lh.pad < lh.kernel ||
+					(uint64_t)lh.kernel * lh.kernel * c > ML_CPU_MAX_DOT)
+				goto invalid;
+			l->k = lh.kernel * lh.kernel * c;
+			l->out_h = (h + 2 * lh.pad - lh.kernel) / lh.stride + 1;
+			l->out_w = (w + 2 * lh.pad - lh.kernel) / lh.stride + 1;
+			l->out_c = lh.out_c;
+			break;
+		case ML_CPU_LAYER_MAXPOOL2D:
+			if (lh.kernel == 0 || lh.stride == 0 || lh.pad != 0 ||
+					lh.out_c != 0 || lh.act != ML_CPU_ACT_NONE ||
+					h < lh.kernel || w < lh.kernel)
+				goto invalid;
+			l->out_h = (h - lh.kernel) / lh.stride + 1;
+			l->out_w = (w - lh.kernel) / lh.stride + 1;
+			l->out_c = c;
+			l->out_scale = scale;
+			l->out_zp = zp;
+			break;
+		case ML_CPU_LAYER_SOFTMAX:
+			if (lh.out_c != 0 || lh.act != ML_CPU_ACT_NONE)
+				goto invalid;
+			l->out_h = h;
+			l->out_w = w;
+			l->out_c = c;
+			row = RTE_MAX(row, c * sizeof(float));
+			break;
+		default:
+			goto invalid;
+		}
+		n = (uint64_t)l->out_h * l->out_w * l->out_c;
+		if (n == 0 || n > ML_CPU_MAX_ELEMENTS)
+			goto invalid;
+		if (model->dtype == ML_CPU_DTYPE_INT8 && !quant_valid(l->out_scale, l->out_zp))
+			goto invalid;
+
+		if (lh.type == ML_CPU_LAYER_FC || lh.type == ML_CPU_LAYER_CONV2D) {
+			if (l->k > ML_CPU_MAX_DOT)
+				goto invalid;
+			if (model->dtype == ML_CPU_DTYPE_INT8) {
+				if (!isfinite(lh.w_scale) || lh.w_scale <= 0)
+					goto invalid;
+				l->mult = scale * lh.w_scale / l->out_scale;
+			}
+			l->k_pad = RTE_ALIGN_CEIL(l->k, ML_CPU_ALIGN);
+			wsize = (uint64_t)l->out_c * l->k *
+				(model->dtype == ML_CPU_DTYPE_INT8 ? 1 : sizeof(uint16_t));
+			if ((uint64_t)(end - p) < wsize + l->out_c * sizeof(int32_t))
+				goto truncated;
+			ret = layer_weights_load(l, model->dtype, p, p + wsize, socket_id);
+			if (ret < 0) {
+				ML_CPU_LOG(ERR, "cannot load weights of layer %u", i);
+				return ret;
+			}
+			wsize += l->out_c * sizeof(int32_t);
+			model->wb_size += wsize;
+			p += wsize;
+			row = RTE_MAX(row, l->k_pad * esize);
+		}
+
+		l->in_stride = RTE_ALIGN_CEIL(h * w * c, ML_CPU_ALIGN);
+		l->out_stride = RTE_ALIGN_CEIL(n, ML_CPU_ALIGN);
+		act = RTE_MAX(act, l->out_stride * esize);
+		h = l->out_h;
+		w = l->out_w;
+		c = l->out_c;
+		scale = l->out_scale;
+		zp = l->out_zp;
+	}
+	if (p != end) {
+		ML_CPU_LOG(ERR, "%zu bytes after the last layer", (size_t)(end - p));
+		return -EINVAL;
+	}
+
+	model->out_elements = h * w * c;
+	row = RTE_MAX(row, (size_t)model->out_elements * sizeof(uint16_t));
+	io_info_set(&model->output, "output", model->out_shape, h, w, c, model->dtype,
+		scale, zp);
+	model->in_size = model->input.size;
+	model->out_size = model->output.size;
+	model->act_size = RTE_ALIGN_CEIL(act * model->max_batches, ML_CPU_ALIGN);
+	model->row_size = RTE_ALIGN_CEIL(row, ML_CPU_ALIGN);
+
+	memcpy(model->info.name, hdr->name, strnlen(hdr->name, sizeof(hdr->name)));
+	snprintf(model->info.version, sizeof(model->info.version), "%u", hdr->version);
+	model->info.io_layout = RTE_ML_IO_LAYOUT_PACKED;
+	model->info.min_batches = 1;
+	model->info.max_batches = model->max_batches;
+	model->info.nb_inputs = 1;
+	model->info.input_info = &model->input;
+	model->info.nb_outputs = 1;
+	model->info.output_info = &model->output;
+	model->info.wb_size = model->wb_size;
+	return 0;
+
+truncated:
+	ML_CPU_LOG(ERR, "model truncated in layer %u", i);
+	return -EINVAL;
+invalid:
+	ML_CPU_LOG(ERR, "invalid layer %u", i);
+	return -EINVAL;
+}
+
+void
+ml_cpu_model_free(struct ml_cpu_model *model)
+{
+	uint16_t i;
+
+	ml_cpu_model_scratch_free(model);
+	for (i = 0; i != RTE_DIM(model->layers); i++) {
+		rte_free(model->layers[i].weights);
+		rte_free(model->layers[i].bias);
+		rte_free(model->layers[i].fbias);
+	}
+	rte_free(model);
+}
+
+int
+ml_cpu_model_scratch_alloc(struct ml_cpu_model *model, uint16_t nb_ctx, int socket_id)
+{
+	struct ml_cpu_scratch *scr;
+	uint16_t i;
+	void *mem;
+
+	model->scratch = rte_zmalloc_socket("ml_cpu_scratch",
+		nb_ctx * sizeof(model->scratch[0]), 0, socket_id);
+	if (model->scratch == NULL)
+		return -ENOMEM;
+	model->nb_ctx = nb_ctx;
+
+	for (i = 0; i != nb_ctx; i++) {
+		mem = rte_malloc_socket("ml_cpu_scratch",
+			2 * model->act_size + model->row_size, ML_CPU_ALIGN, socket_id);
+		if (mem == NULL) {
+			ml_cpu_model_scratch_free(model);
+			return -ENOMEM;
+		}
+		scr = &model->scratch[i];
+		scr->act[0] = mem;
+		scr->act[1] = RTE_PTR_ADD(mem, model->act_size);
+		scr->row = RTE_PTR_ADD(mem, 2 * model->act_size);
+	}
+	return 0;
+}
+
+void
+ml_cpu_model_scratch_free(struct ml_cpu_model *model)
+{
+	uint16_t i;
+
+	if (model->scratch == NULL)
+		return;
+	for (i = 0; i != model->nb_ctx; i++)
+		rte_free(model->scratch[i].act[0]);
+	rte_free(model->scratch);
+	model->scratch = NULL;
+	model->nb_ctx = 0;
+}
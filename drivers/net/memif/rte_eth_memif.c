@@ -13,6 +13,7 @@
 #include <linux/if_ether.h>
 #include <errno.h>
 #include <sys/eventfd.h>
+#include <poll.h>
 
 #include <rte_version.h>
 #include <rte_mbuf.h>
@@ -27,6 +28,8 @@
 #include <rte_memory.h>
 #include <rte_memzone.h>
 #include <rte_eal_memconfig.h>
+#include <rte_cycles.h>
+#include <rte_alarm.h>
 
 #include "rte_eth_memif.h"
 #include "memif_socket.h"
@@ -42,6 +45,10 @@
 #define ETH_MEMIF_MAC_ARG		"mac"
 #define ETH_MEMIF_ZC_ARG		"zero-copy"
 #define ETH_MEMIF_SECRET_ARG		"secret"
+#define ETH_MEMIF_INTR_PKTS_ARG		"intr-coalesce-pkts"
+#define ETH_MEMIF_INTR_US_ARG		"intr-coalesce-us"
+#define ETH_MEMIF_RX_SLEEP_IDLE_ARG	"rx-sleep-idle"
+#define ETH_MEMIF_RX_SLEEP_US_ARG	"rx-sleep-us"
 
 static const char * const valid_arguments[] = {
 	ETH_MEMIF_ID_ARG,
@@ -55,6 +62,10 @@ static const char * const valid_arguments[] = {
 	ETH_MEMIF_MAC_ARG,
 	ETH_MEMIF_ZC_ARG,
 	ETH_MEMIF_SECRET_ARG,
+	ETH_MEMIF_INTR_PKTS_ARG,
+	ETH_MEMIF_INTR_US_ARG,
+	ETH_MEMIF_RX_SLEEP_IDLE_ARG,
+	ETH_MEMIF_RX_SLEEP_US_ARG,
 	NULL
 };
 
@@ -292,6 +303,158 @@ memif_pktmbuf_chain(struct rte_mbuf *head, struct rte_mbuf *cur_tail,
 	return 0;
 }
 
+static void
+memif_tx_signal(struct memif_queue *mq)
+{
+	uint64_t a = 1;
+	ssize_t size;
+
+	size = write(rte_intr_fd_get(mq->intr_handle), &a, sizeof(a));
+	if (unlikely(size < 0))
+		MIF_LOG(WARNING, "Failed to send interrupt. %s", strerror(errno));
+}
+
+/*
+ * Signal the peer that new slots are available on a tx ring.
+ * Peers that poll the ring set MEMIF_RING_FLAG_MASK_INT and are never
+ * signalled. Otherwise the eventfd write is coalesced: the peer is kicked
+ * once intr.coalesce_pkts packets are pending or the oldest pending packet
+ * is older than intr.coalesce_us. Kicks pending longer than
+ * intr.coalesce_us are flushed by memif_tx_kick_flush() if no burst
+ * follows.
+ */
+static inline void
+memif_tx_kick(struct pmd_internals *pmd, struct memif_queue *mq,
+	      memif_ring_t *ring, uint16_t n_tx_pkts)
+{
+	uint32_t pending;
+	uint64_t now;
+
+	pending = rte_atomic_load_explicit(&mq->kick_pending,
+			rte_memory_order_relaxed);
+	if (ring->flags & MEMIF_RING_FLAG_MASK_INT) {
+		if (pending != 0)
+			rte_atomic_store_explicit(&mq->kick_pending, 0,
+					rte_memory_order_relaxed);
+		return;
+	}
+
+	if (n_tx_pkts != 0) {
+		if (pending == 0 && pmd->intr_coalesce_cycles != 0)
+			rte_atomic_store_explicit(&mq->kick_tsc,
+					rte_get_timer_cycles(),
+					rte_memory_order_relaxed);
+		pending += n_tx_pkts;
+	}
+	if (pending == 0)
+		return;
+
+	if (pending < pmd->intr.coalesce_pkts) {
+		if (pmd->intr_coalesce_cycles == 0)
+			goto defer;
+		now = rte_get_timer_cycles();
+		if (now - rte_atomic_load_explicit(&mq->kick_tsc,
+				rte_memory_order_relaxed) < pmd->intr_coalesce_cycles)
+			goto defer;
+	}
+
+	if (unlikely(rte_intr_fd_get(mq->intr_handle) < 0))
+		goto defer;
+
+	memif_tx_signal(mq);
+	pending = 0;
+defer:
+	rte_atomic_store_explicit(&mq->kick_pending, pending,
+			rte_memory_order_relaxed);
+}
+
+/*
+ * Periodic alarm enforcing intr.coalesce_us: kick the peer for tx queues
+ * whose oldest pending packet expired, when the application stopped
+ * transmitting on them. It runs in the interrupt thread, like the
+ * control channel which maps and unmaps the rings.
+ * The tx path is not synchronized with it, which may only cause
+ * a spurious signal. Each expired batch is signalled once.
+ */
+static void
+memif_tx_kick_flush(void *arg)
+{
+	struct rte_eth_dev *dev = arg;
+	struct pmd_internals *pmd = dev->data->dev_private;
+	struct memif_queue *mq;
+	memif_ring_t *ring;
+	uint64_t now, tsc;
+	uint16_t i;
+
+	if (pmd->flags & ETH_MEMIF_FLAG_CONNECTED) {
+		now = rte_get_timer_cycles();
+		for (i = 0; i < dev->data->nb_tx_queues; i++) {
+			mq = dev->data->tx_queues[i];
+			if (mq == NULL || rte_atomic_load_explicit(&mq->kick_pending,
+					rte_memory_order_relaxed) == 0)
+				continue;
+			tsc = rte_atomic_load_explicit(&mq->kick_tsc,
+					rte_memory_order_relaxed);
+			if (tsc == mq->kick_flushed_tsc ||
+					now - tsc < pmd->intr_coalesce_cycles)
+				continue;
+			ring = memif_get_ring_from_queue(dev->process_private, mq);
+			if (ring == NULL || (ring->flags & MEMIF_RING_FLAG_MASK_INT) ||
+					rte_intr_fd_get(mq->intr_handle) < 0)
+				continue;
+			memif_tx_signal(mq);
+			mq->kick_flushed_tsc = tsc;
+		}
+	}
+
+	rte_eal_alarm_set(pmd->intr.coalesce_us, memif_tx_kick_flush, dev);
+}
+
+/*
+ * Hybrid rx: after intr.rx_sleep_idle consecutive empty polls, unmask the
+ * rx ring interrupt and sleep on the eventfd until the peer signals new
+ * packets or intr.rx_sleep_us expires. The ring is masked again on wakeup
+ * so that the peer does not signal while the queue is busy polled.
+ */
+static void
+memif_rx_sleep(struct pmd_internals *pmd, struct memif_queue *mq,
+	       memif_ring_t *ring, uint16_t cur_slot)
+{
+	struct timespec ts;
+	struct pollfd pfd;
+	uint16_t last_slot;
+	uint64_t b;
+	ssize_t size __rte_unused;
+
+	if (++mq->idle_polls < pmd->intr.rx_sleep_idle)
+		return;
+
+	pfd.fd = rte_intr_fd_get(mq->intr_handle);
+	if (pfd.fd < 0)
+		return;
+	pfd.events = POLLIN;
+	pfd.revents = 0;
+
+	ring->flags &= ~MEMIF_RING_FLAG_MASK_INT;
+	/* Order the flag update before re-checking the ring,
+	 * pairs with the flag check after the peer's head/tail update.
+	 */
+	rte_atomic_thread_fence(rte_memory_order_seq_cst);
+	if (mq->type == MEMIF_RING_C2S)
+		last_slot = rte_atomic_load_explicit(&ring->head, rte_memory_order_acquire);
+	else
+		last_slot = rte_atomic_load_explicit(&ring->tail, rte_memory_order_acquire);
+
+	if (last_slot == cur_slot) {
+		ts.tv_sec = pmd->intr.rx_sleep_us / US_PER_S;
+		ts.tv_nsec = (pmd->intr.rx_sleep_us % US_PER_S) * 1000;
+		if (ppoll(&pfd, 1, &ts, NULL) > 0)
+			size = read(pfd.fd, &b, sizeof(b));
+	}
+
+	ring->flags |= MEMIF_RING_FLAG_MASK_INT;
+}
+
 static uint16_t
 eth_memif_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 {
@@ -342,8 +505,12 @@ eth_memif_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		last_slot = rte_atomic_load_explicit(&ring->tail, rte_memory_order_acquire);
 	}
 
-	if (cur_slot == last_slot)
+	if (cur_slot == last_slot) {
+		if (pmd->intr.rx_sleep_idle != 0)
+			memif_rx_sleep(pmd, mq, ring, cur_slot);
 		goto refill;
+	}
+	mq->idle_polls = 0;
 	n_slots = last_slot - cur_slot;
 
 	if (likely(mbuf_size >= pmd->cfg.pkt_buffer_size)) {
@@ -547,8 +714,12 @@ eth_memif_rx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	 * to synchronize it between threads.
 	 */
 	last_slot = rte_atomic_load_explicit(&ring->tail, rte_memory_order_acquire);
-	if (cur_slot == last_slot)
+	if (cur_slot == last_slot) {
+		if (pmd->intr.rx_sleep_idle != 0)
+			memif_rx_sleep(pmd, mq, ring, cur_slot);
 		goto refill;
+	}
+	mq->idle_polls = 0;
 	n_slots = last_slot - cur_slot;
 
 	while (n_slots && n_rx_pkts < nb_pkts) {
@@ -650,8 +821,6 @@ eth_memif_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	memif_desc_t *d0;
 	struct rte_mbuf *mbuf;
 	struct rte_mbuf *mbuf_head;
-	uint64_t a;
-	ssize_t size;
 	struct rte_eth_link link;
 
 	if (unlikely((pmd->flags & ETH_MEMIF_FLAG_CONNECTED) == 0))
@@ -805,16 +974,7 @@ eth_memif_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	else
 		rte_atomic_store_explicit(&ring->tail, slot, rte_memory_order_release);
 
-	if (((ring->flags & MEMIF_RING_FLAG_MASK_INT) == 0) &&
-	    (rte_intr_fd_get(mq->intr_handle) >= 0)) {
-		a = 1;
-		size = write(rte_intr_fd_get(mq->intr_handle), &a,
-			     sizeof(a));
-		if (unlikely(size < 0)) {
-			MIF_LOG(WARNING,
-				"Failed to send interrupt. %s", strerror(errno));
-		}
-	}
+	memif_tx_kick(pmd, mq, ring, n_tx_pkts);
 
 	mq->n_pkts += n_tx_pkts;
 	return n_tx_pkts;
@@ -959,18 +1119,7 @@ eth_memif_tx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	rte_atomic_store_explicit(&ring->head, slot, rte_memory_order_release);
 
 	/* Send interrupt, if enabled. */
-	if ((ring->flags & MEMIF_RING_FLAG_MASK_INT) == 0) {
-		uint64_t a = 1;
-		if (rte_intr_fd_get(mq->intr_handle) < 0)
-			return -1;
-
-		ssize_t size = write(rte_intr_fd_get(mq->intr_handle),
-				     &a, sizeof(a));
-		if (unlikely(size < 0)) {
-			MIF_LOG(WARNING,
-				"Failed to send interrupt. %s", strerror(errno));
-		}
-	}
+	memif_tx_kick(pmd, mq, ring, n_tx_pkts);
 
 	/* increment queue counters */
 	mq->n_pkts += n_tx_pkts;
@@ -1386,6 +1535,9 @@ memif_dev_start(struct rte_eth_dev *dev)
 	}
 
 	if (ret == 0) {
+		if (pmd->intr.coalesce_pkts > 1)
+			rte_eal_alarm_set(pmd->intr.coalesce_us,
+					  memif_tx_kick_flush, dev);
 		for (i = 0; i < dev->data->nb_rx_queues; i++)
 			dev->data->rx_queue_state[i] = RTE_ETH_QUEUE_STATE_STARTED;
 		for (i = 0; i < dev->data->nb_tx_queues; i++)
@@ -1400,6 +1552,7 @@ memif_dev_stop(struct rte_eth_dev *dev)
 {
 	uint16_t i;
 
+	rte_eal_alarm_cancel(memif_tx_kick_flush, dev);
 	memif_disconnect(dev);
 
 	for (i = 0; i < dev->data->nb_rx_queues; i++)
@@ -1669,7 +1822,8 @@ memif_create(struct rte_vdev_device *vdev, enum memif_role_t role,
 	     const char *socket_filename, uid_t owner_uid, gid_t owner_gid,
 	     memif_log2_ring_size_t log2_ring_size,
 	     uint16_t pkt_buffer_size, const char *secret,
-	     struct rte_ether_addr *ether_addr)
+	     struct rte_ether_addr *ether_addr,
+	     const struct memif_intr_cfg *intr)
 {
 	int ret = 0;
 	struct rte_eth_dev *eth_dev;
@@ -1724,6 +1878,16 @@ memif_create(struct rte_vdev_device *vdev, enum memif_role_t role,
 	pmd->cfg.pkt_buffer_size = pkt_buffer_size;
 	rte_spinlock_init(&pmd->cc_lock);
 
+	pmd->intr = *intr;
+	if (pmd->intr.coalesce_pkts == 0 && pmd->intr.coalesce_us == 0)
+		pmd->intr.coalesce_pkts = 1;
+	else if (pmd->intr.coalesce_pkts == 0)
+		pmd->intr.coalesce_pkts = UINT32_MAX;
+	else if (pmd->intr.coalesce_pkts > 1 && pmd->intr.coalesce_us == 0)
+		pmd->intr.coalesce_us = ETH_MEMIF_DEFAULT_INTR_COALESCE_US;
+	pmd->intr_coalesce_cycles =
+		(rte_get_timer_hz() * pmd->intr.coalesce_us) / US_PER_S;
+
 	data = eth_dev->data;
 	data->dev_private = pmd;
 	data->numa_node = numa_node;
@@ -1790,6 +1954,23 @@ memif_set_zc(const char *key __rte_unused, const char *value, void *extra_args)
 	return 0;
 }
 
+static int
+memif_set_u32(const char *key, const char *value, void *extra_args)
+{
+	unsigned long tmp;
+	char *end;
+	uint32_t *val = (uint32_t *)extra_args;
+
+	errno = 0;
+	tmp = strtoul(value, &end, 10);
+	if (errno != 0 || *value == '\0' || *end != '\0' || tmp > UINT32_MAX) {
+		MIF_LOG(ERR, "Invalid %s: %s.", key, value);
+		return -EINVAL;
+	}
+	*val = tmp;
+	return 0;
+}
+
 static int
 memif_set_id(const char *key __rte_unused, const char *value, void *extra_args)
 {
@@ -1953,6 +2134,9 @@ rte_pmd_memif_probe(struct rte_vdev_device *vdev)
 	gid_t owner_gid = -1;
 	uint32_t flags = 0;
 	const char *secret = NULL;
+	struct memif_intr_cfg intr = {
+		.rx_sleep_us = ETH_MEMIF_DEFAULT_RX_SLEEP_US,
+	};
 	struct rte_ether_addr *ether_addr = rte_zmalloc("",
 		sizeof(struct rte_ether_addr), 0);
 	struct rte_eth_dev *eth_dev;
@@ -2054,6 +2238,22 @@ rte_pmd_memif_probe(struct rte_vdev_device *vdev)
 					 &memif_set_secret, (void *)(&secret));
 		if (ret < 0)
 			goto exit;
+		ret = rte_kvargs_process(kvlist, ETH_MEMIF_INTR_PKTS_ARG,
+					 &memif_set_u32, &intr.coalesce_pkts);
+		if (ret < 0)
+			goto exit;
+		ret = rte_kvargs_process(kvlist, ETH_MEMIF_INTR_US_ARG,
+					 &memif_set_u32, &intr.coalesce_us);
+		if (ret < 0)
+			goto exit;
+		ret = rte_kvargs_process(kvlist, ETH_MEMIF_RX_SLEEP_IDLE_ARG,
+					 &memif_set_u32, &intr.rx_sleep_idle);
+		if (ret < 0)
+			goto exit;
+		ret = rte_kvargs_process(kvlist, ETH_MEMIF_RX_SLEEP_US_ARG,
+					 &memif_set_u32, &intr.rx_sleep_us);
+		if (ret < 0)
+			goto exit;
 	}
 
 	if (!(flags & ETH_MEMIF_FLAG_SOCKET_ABSTRACT)) {
@@ -2064,7 +2264,8 @@ rte_pmd_memif_probe(struct rte_vdev_device *vdev)
 
 	/* create interface */
 	ret = memif_create(vdev, role, id, flags, socket_filename, owner_uid, owner_gid,
-			   log2_ring_size, pkt_buffer_size, secret, ether_addr);
+			   log2_ring_size, pkt_buffer_size, secret, ether_addr,
+			   &intr);
 
 exit:
 	rte_kvargs_free(kvlist);
@@ -2101,6 +2302,10 @@ RTE_PMD_REGISTER_PARAM_STRING(net_memif,
 			      ETH_MEMIF_OWNER_GID_ARG "=<int>"
 			      ETH_MEMIF_MAC_ARG "=xx:xx:xx:xx:xx:xx"
 			      ETH_MEMIF_ZC_ARG "=yes|no"
-			      ETH_MEMIF_SECRET_ARG "=<string>");
+			      ETH_MEMIF_SECRET_ARG "=<string>"
+			      ETH_MEMIF_INTR_PKTS_ARG "=<int>"
+			      ETH_MEMIF_INTR_US_ARG "=<int>"
+			      ETH_MEMIF_RX_SLEEP_IDLE_ARG "=<int>"
+			      ETH_MEMIF_RX_SLEEP_US_ARG "=<int>");
 
 RTE_LOG_REGISTER_DEFAULT(memif_logtype, NOTICE);
@@ -16,6 +16,8 @@
 #define ETH_MEMIF_DEFAULT_SOCKET_FILENAME	"/run/memif.sock"
 #define ETH_MEMIF_DEFAULT_RING_SIZE		10
 #define ETH_MEMIF_DEFAULT_PKT_BUFFER_SIZE	2048
+#define ETH_MEMIF_DEFAULT_INTR_COALESCE_US	100
+#define ETH_MEMIF_DEFAULT_RX_SLEEP_US		100
 
 #define ETH_MEMIF_MAX_NUM_Q_PAIRS		255
 #define ETH_MEMIF_MAX_LOG2_RING_SIZE		14
@@ -73,6 +75,23 @@ struct memif_queue {
 	struct rte_intr_handle *intr_handle;	/**< interrupt handle */
 
 	memif_log2_ring_size_t log2_ring_size;	/**< log2 of ring size */
+
+	/* interrupt coalescing / hybrid rx state */
+	RTE_ATOMIC(uint32_t) kick_pending;	/**< tx packets not yet signalled */
+	RTE_ATOMIC(uint64_t) kick_tsc;		/**< time of oldest unsignalled packet */
+	uint64_t kick_flushed_tsc;		/**< kick_tsc last flushed by alarm */
+	uint32_t idle_polls;			/**< consecutive empty rx polls */
+};
+
+struct memif_intr_cfg {
+	uint32_t coalesce_pkts;
+	/**< signal the peer once this many packets are pending */
+	uint32_t coalesce_us;
+	/**< signal the peer once the oldest pending packet is this old (us) */
+	uint32_t rx_sleep_idle;
+	/**< empty rx polls before sleeping on the eventfd, 0 to always poll */
+	uint32_t rx_sleep_us;
+	/**< maximum time to sleep on the eventfd (us) */
 };
 
 struct pmd_internals {
@@ -117,6 +136,9 @@ struct pmd_internals {
 	} run;
 	/**< Parameters used in active connection */
 
+	struct memif_intr_cfg intr;		/**< interrupt coalescing config */
+	uint64_t intr_coalesce_cycles;		/**< coalesce_us in timer cycles */
+
 	char local_disc_string[ETH_MEMIF_DISC_STRING_SIZE];
 	/**< local disconnect reason */
 	char remote_disc_string[ETH_MEMIF_DISC_STRING_SIZE];
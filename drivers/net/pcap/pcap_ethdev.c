@@ -4,6 +4,7 @@
  * All rights reserved.
  */
 
+#include <errno.h>
 #include <stdlib.h>
 #include <time.h>
 
@@ -20,6 +21,7 @@
 #include <rte_os_shim.h>
 
 #include "pcap_osdep.h"
+#include "pcap_replay.h"
 
 #define RTE_ETH_PCAP_SNAPSHOT_LEN 65535
 #define RTE_ETH_PCAP_SNAPLEN RTE_ETHER_MAX_JUMBO_FRAME_LEN
@@ -34,6 +36,8 @@
 #define ETH_PCAP_IFACE_ARG    "iface"
 #define ETH_PCAP_PHY_MAC_ARG  "phy_mac"
 #define ETH_PCAP_INFINITE_RX_ARG  "infinite_rx"
+#define ETH_PCAP_REPLAY_ARG   "replay"
+#define ETH_PCAP_REPLAY_SPEED_ARG "replay_speed"
 
 #define ETH_PCAP_ARG_MAXLEN	64
 
@@ -75,6 +79,9 @@ struct pcap_rx_queue {
 
 	/* Contains pre-generated packets to be looped through */
 	struct rte_ring *pkts;
+
+	/* Memory mapped file for replay mode */
+	struct pcap_replay *replay;
 };
 
 struct pcap_tx_queue {
@@ -94,6 +101,8 @@ struct pmd_internals {
 	int single_iface;
 	int phy_mac;
 	unsigned int infinite_rx;
+	unsigned int replay;
+	double replay_speed;
 };
 
 struct pmd_process_private {
@@ -122,6 +131,8 @@ struct pmd_devargs_all {
 	unsigned int is_rx_pcap;
 	unsigned int is_rx_iface;
 	unsigned int infinite_rx;
+	unsigned int replay;
+	double replay_speed;
 };
 
 static const char *valid_arguments[] = {
@@ -133,6 +144,8 @@ static const char *valid_arguments[] = {
 	ETH_PCAP_IFACE_ARG,
 	ETH_PCAP_PHY_MAC_ARG,
 	ETH_PCAP_INFINITE_RX_ARG,
+	ETH_PCAP_REPLAY_ARG,
+	ETH_PCAP_REPLAY_SPEED_ARG,
 	NULL
 };
 
@@ -270,6 +283,27 @@ eth_pcap_rx_infinite(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	return i;
 }
 
+static uint16_t
+eth_pcap_rx_replay(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
+{
+	struct pcap_rx_queue *pcap_q = queue;
+	uint64_t rx_bytes = 0;
+	uint64_t rx_nombuf = 0;
+	uint16_t num_rx;
+
+	if (unlikely(pcap_q->replay == NULL))
+		return 0;
+
+	num_rx = pcap_replay_rx(pcap_q->replay, pcap_q->mb_pool, bufs, nb_pkts,
+			&rx_bytes, &rx_nombuf);
+
+	pcap_q->rx_stat.pkts += num_rx;
+	pcap_q->rx_stat.bytes += rx_bytes;
+	pcap_q->rx_stat.rx_nombuf += rx_nombuf;
+
+	return num_rx;
+}
+
 static uint16_t
 eth_pcap_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 {
@@ -648,6 +682,11 @@ eth_dev_start(struct rte_eth_dev *dev)
 	for (i = 0; i < dev->data->nb_rx_queues; i++) {
 		rx = &internals->rx_queue[i];
 
+		if (rx->replay != NULL) {
+			pcap_replay_reset(rx->replay);
+			continue;
+		}
+
 		if (pp->rx_pcap[i] != NULL)
 			continue;
 
@@ -847,8 +886,15 @@ eth_dev_close(struct rte_eth_dev *dev)
 	if (rte_eal_process_type() != RTE_PROC_PRIMARY)
 		return 0;
 
+	for (i = 0; i < dev->data->nb_rx_queues; i++) {
+		struct pcap_rx_queue *pcap_q = &internals->rx_queue[i];
+
+		pcap_replay_close(pcap_q->replay);
+		pcap_q->replay = NULL;
+	}
+
 	/* Device wide flag, but cleanup must be performed per queue. */
-	if (internals->infinite_rx) {
+	if (internals->infinite_rx && !internals->replay) {
 		for (i = 0; i < dev->data->nb_rx_queues; i++) {
 			struct pcap_rx_queue *pcap_q = &internals->rx_queue[i];
 
@@ -881,7 +927,7 @@ static int
 eth_rx_queue_setup(struct rte_eth_dev *dev,
 		uint16_t rx_queue_id,
 		uint16_t nb_rx_desc __rte_unused,
-		unsigned int socket_id __rte_unused,
+		unsigned int socket_id,
 		const struct rte_eth_rxconf *rx_conf __rte_unused,
 		struct rte_mempool *mb_pool)
 {
@@ -893,6 +939,17 @@ eth_rx_queue_setup(struct rte_eth_dev *dev,
 	pcap_q->queue_id = rx_queue_id;
 	dev->data->rx_queues[rx_queue_id] = pcap_q;
 
+	if (internals->replay) {
+		pcap_replay_close(pcap_q->replay);
+		pcap_q->replay = pcap_replay_open(pcap_q->name,
+				internals->replay_speed, internals->infinite_rx,
+				pcap_q->port_id, timestamp_dynfield_offset,
+				timestamp_rx_dynflag, socket_id);
+		if (pcap_q->replay == NULL)
+			return -EINVAL;
+		return 0;
+	}
+
 	if (internals->infinite_rx) {
 		struct pmd_process_private *pp;
 		char ring_name[RTE_RING_NAMESIZE];
@@ -1199,6 +1256,32 @@ get_infinite_rx_arg(const char *key __rte_unused,
 	return 0;
 }
 
+static int
+get_replay_arg(const char *key __rte_unused,
+		const char *value, void *extra_args)
+{
+	unsigned int *replay = extra_args;
+
+	*replay = atoi(value) > 0;
+	return 0;
+}
+
+static int
+get_replay_speed_arg(const char *key __rte_unused,
+		const char *value, void *extra_args)
+{
+	double *speed = extra_args;
+	char *end;
+
+	errno = 0;
+	*speed = strtod(value, &end);
+	if (errno != 0 || end == value || *end != '\0' || *speed < 0) {
+		PMD_LOG(ERR, "Invalid replay speed: %s", value);
+		return -EINVAL;
+	}
+	return 0;
+}
+
 static int
 pmd_init_internals(struct rte_vdev_device *vdev,
 		const unsigned int nb_rx_queues,
@@ -1358,8 +1441,12 @@ eth_from_pcaps(struct rte_vdev_device *vdev,
 	}
 
 	internals->infinite_rx = infinite_rx;
+	internals->replay = devargs_all->replay;
+	internals->replay_speed = devargs_all->replay_speed;
 	/* Assign rx ops. */
-	if (infinite_rx)
+	if (internals->replay)
+		eth_dev->rx_pkt_burst = eth_pcap_rx_replay;
+	else if (infinite_rx)
 		eth_dev->rx_pkt_burst = eth_pcap_rx_infinite;
 	else if (devargs_all->is_rx_pcap || devargs_all->is_rx_iface ||
 			single_iface)
@@ -1525,6 +1612,19 @@ pmd_pcap_probe(struct rte_vdev_device *dev)
 					"for %s", name);
 		}
 
+		ret = rte_kvargs_process(kvlist, ETH_PCAP_REPLAY_ARG,
+				&get_replay_arg, &devargs_all.replay);
+		if (ret < 0)
+			goto free_kvlist;
+		ret = rte_kvargs_process(kvlist, ETH_PCAP_REPLAY_SPEED_ARG,
+				&get_replay_speed_arg, &devargs_all.replay_speed);
+		if (ret < 0)
+			goto free_kvlist;
+		if (devargs_all.replay_speed > 0 && !devargs_all.replay)
+			PMD_LOG(WARNING, "%s is ignored without %s=1 for %s",
+					ETH_PCAP_REPLAY_SPEED_ARG,
+					ETH_PCAP_REPLAY_ARG, name);
+
 		ret = rte_kvargs_process(kvlist, ETH_PCAP_RX_PCAP_ARG,
 				&open_rx_pcap, &pcaps);
 	} else if (devargs_all.is_rx_iface) {
@@ -1583,6 +1683,16 @@ pmd_pcap_probe(struct rte_vdev_device *dev)
 		unsigned int i;
 
 		internal = eth_dev->data->dev_private;
+		/*
+		 * The file mapping and the external buffer callbacks
+		 * only exist in the primary process.
+		 */
+		if (internal->replay) {
+			PMD_LOG(ERR, "Replay is not supported in secondary process");
+			ret = -ENOTSUP;
+			goto free_kvlist;
+		}
+
 			pp = (struct pmd_process_private *)
 				rte_zmalloc(NULL,
 					sizeof(struct pmd_process_private),
@@ -1665,4 +1775,6 @@ RTE_PMD_REGISTER_PARAM_STRING(net_pcap,
 	ETH_PCAP_TX_IFACE_ARG "=<ifc> "
 	ETH_PCAP_IFACE_ARG "=<ifc> "
 	ETH_PCAP_PHY_MAC_ARG "=<int>"
-	ETH_PCAP_INFINITE_RX_ARG "=<0|1>");
+	ETH_PCAP_INFINITE_RX_ARG "=<0|1> "
+	ETH_PCAP_REPLAY_ARG "=<0|1> "
+	ETH_PCAP_REPLAY_SPEED_ARG "=<float>");
@@ -0,0 +1,568 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <string.h>
+#include <sys/stat.h>
+#ifndef RTE_EXEC_ENV_WINDOWS
+#include <unistd.h>
+#endif
+
+#include <rte_byteorder.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_eal_paging.h>
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_mbuf_dyn.h>
+#include <rte_memory.h>
+#include <rte_os_shim.h>
+#include <rte_pause.h>
+#include <rte_stdatomic.h>
+
+#include "pcap_osdep.h"
+#include "pcap_replay.h"
+
+#define PCAP_MAGIC_US		0xa1b2c3d4
+#define PCAP_MAGIC_NS		0xa1b23c4d
+#define PCAP_FILE_HDR_LEN	24
+#define PCAP_PKT_HDR_LEN	16
+
+#define PCAPNG_BLOCK_SHB	0x0a0d0d0a
+#define PCAPNG_BLOCK_IDB	0x00000001
+#define PCAPNG_BLOCK_SPB	0x00000003
+#define PCAPNG_BLOCK_EPB	0x00000006
+#define PCAPNG_BYTE_ORDER_MAGIC	0x1a2b3c4d
+#define PCAPNG_OPT_END		0
+#define PCAPNG_OPT_IF_TSRESOL	9
+#define PCAPNG_MAX_IFACES	256
+
+#define NSEC_PER_SEC		1000000000ULL
+
+/* Longest gap to the next due packet that is busy-waited in rx. */
+#define PCAP_REPLAY_MAX_WAIT_US	100
+
+/*
+ * Number of shared info structures used to refcount the mapping.
+ * Refcounts are 16 bits wide, bursts are spread across them so that
+ * more packets than that can be in flight.
+ */
+#define PCAP_REPLAY_NB_SHINFO	64
+
+struct pcap_replay_pkt {
+	uint64_t offset;	/* packet data offset in the file */
+	uint64_t ts_ns;		/* capture timestamp */
+	uint32_t caplen;	/* captured length */
+};
+
+struct pcap_replay {
+	void *addr;		/* file mapping */
+	size_t len;		/* file size */
+	size_t map_len;		/* mapping size, page aligned */
+	bool extmem;		/* mapping registered as external memory */
+
+	struct pcap_replay_pkt *pkts;
+	uint64_t nb_pkts;
+	uint64_t next;		/* next packet to receive */
+	int loop;
+
+	uint16_t port_id;
+	int ts_offset;		/* Rx timestamp dynamic field */
+	uint64_t ts_flag;	/* Rx timestamp dynamic flag */
+
+	/* Pacing state, unused if cycles_per_ns is zero. */
+	double cycles_per_ns;
+	uint64_t max_wait;	/* in timer cycles */
+	uint64_t start_tsc;	/* timer value of the first packet, 0 if unset */
+	uint64_t loop_ns;	/* capture time elapsed in previous loops */
+	uint64_t last_ns;	/* relative capture time of the previous packet */
+
+	unsigned int shinfo_idx;
+	RTE_ATOMIC(uint32_t) refs;
+	struct rte_mbuf_ext_shared_info shinfo[PCAP_REPLAY_NB_SHINFO];
+};
+
+static inline uint16_t
+rd16(const uint8_t *p, bool swap)
+{
+	uint16_t v;
+
+	memcpy(&v, p, sizeof(v));
+	return swap ? rte_bswap16(v) : v;
+}
+
+static inline uint32_t
+rd32(const uint8_t *p, bool swap)
+{
+	uint32_t v;
+
+	memcpy(&v, p, sizeof(v));
+	return swap ? rte_bswap32(v) : v;
+}
+
+static int
+replay_add_pkt(struct pcap_replay *r, uint64_t *size, int socket_id,
+		uint64_t offset, uint32_t caplen, uint64_t ts_ns)
+{
+	struct pcap_replay_pkt *pkt;
+
+	/* Packets that can not be described by a single mbuf are skipped. */
+	if (caplen == 0 || caplen > UINT16_MAX) {
+		PMD_LOG(DEBUG, "Skipping packet at offset %" PRIu64 " of length %u",
+			offset, caplen);
+		return 0;
+	}
+
+	if (r->nb_pkts == *size) {
+		uint64_t new_size = *size ? *size * 2 : 1024;
+
+		pkt = rte_realloc_socket(r->pkts, new_size * sizeof(*pkt), 0,
+				socket_id);
+		if (pkt == NULL)
+			return -ENOMEM;
+		r->pkts = pkt;
+		*size = new_size;
+	}
+
+	pkt = &r->pkts[r->nb_pkts++];
+	pkt->offset = offset;
+	pkt->caplen = caplen;
+	pkt->ts_ns = ts_ns;
+	return 0;
+}
+
+static int
+replay_index_pcap(struct pcap_replay *r, int socket_id)
+{
+	const uint8_t *p = r->addr;
+	uint32_t magic, ts_frac_mult;
+	uint64_t off, size = 0;
+	bool swap;
+	int ret;
+
+	magic = rd32(p, false);
+	swap = (magic == rte_bswap32(PCAP_MAGIC_US) ||
+		magic == rte_bswap32(PCAP_MAGIC_NS));
+	if (swap)
+		magic = rte_bswap32(magic);
+	ts_frac_mult = (magic == PCAP_MAGIC_NS) ? 1 : 1000;
+
+	for (off = PCAP_FILE_HDR_LEN; off + PCAP_PKT_HDR_LEN <= r->len;) {
+		uint64_t sec = rd32(p + off, swap);
+		uint64_t frac = rd32(p + off + 4, swap);
+		uint32_t caplen = rd32(p + off + 8, swap);
+
+		off += PCAP_PKT_HDR_LEN;
+		if (caplen > r->len - off) {
+			PMD_LOG(WARNING, "Truncated packet at offset %" PRIu64, off);
+			break;
+		}
+
+		ret = replay_add_pkt(r, &size, socket_id, off, caplen,
+				sec * NSEC_PER_SEC + frac * ts_frac_mult);
+		if (ret < 0)
+			return ret;
+		off += caplen;
+	}
+
+	return 0;
+}
+
+static uint64_t
+pcapng_ts_to_ns(uint64_t ts, uint8_t tsresol)
+{
+	uint64_t div = 1;
+	unsigned int i;
+
+	/* Power of two resolution. */
+	if (tsresol & 0x80) {
+		unsigned int shift = tsresol & 0x7f;
+
+		if (shift >= 64)
+			return 0;
+		return (ts >> shift) * NSEC_PER_SEC +
+			(((ts & ((UINT64_C(1) << shift) - 1)) * NSEC_PER_SEC) >> shift);
+	}
+
+	/* Power of ten resolution. */
+	if (tsresol <= 9) {
+		for (i = tsresol; i < 9; i++)
+			ts *= 10;
+		return ts;
+	}
+	for (i = 9; i < tsresol && i < 28; i++)
+		div *= 10;
+	return ts / div;
+}
+
+static int
+replay_index_pcapng(struct pcap_replay *r, int socket_id)
+{
+	struct {
+		uint32_t snaplen;
+		uint8_t tsresol;
+	} ifaces[PCAPNG_MAX_IFACES];
+	const uint8_t *p = r->addr;
+	unsigned int nb_ifaces = 0;
+	uint64_t off, size = 0;
+	uint64_t ts_ns = 0;
+	bool swap = false;
+	int ret;
+
+	for (off = 0; off + 12 <= r->len;) {
+		const uint8_t *body = p + off + 8;
+		uint32_t type, blen, body_len;
+
+		type = rd32(p + off, swap);
+		if (type == PCAPNG_BLOCK_SHB) {
+			uint32_t bom = rd32(body, false);
+
+			if (bom == PCAPNG_BYTE_ORDER_MAGIC)
+				swap = false;
+			else if (bom == rte_bswap32(PCAPNG_BYTE_ORDER_MAGIC))
+				swap = true;
+			else
+				return -EINVAL;
+			/* Interfaces are scoped to their section. */
+			nb_ifaces = 0;
+		}
+
+		blen = rd32(p + off + 4, swap);
+		if (blen < 12 || (blen & 3) != 0 || blen > r->len - off) {
+			PMD_LOG(WARNING, "Truncated block at offset %" PRIu64, off);
+			break;
+		}
+		body_len = blen - 12;
+
+		switch (type) {
+		case PCAPNG_BLOCK_IDB: {
+			uint32_t opt_off = 8;
+
+			if (body_len < 8 || nb_ifaces == PCAPNG_MAX_IFACES)
+				return -EINVAL;
+			ifaces[nb_ifaces].snaplen = rd32(body + 4, swap);
+			ifaces[nb_ifaces].tsresol = 6;
+			while (opt_off + 4 <= body_len) {
+				uint16_t code = rd16(body + opt_off, swap);
+				uint16_t olen = rd16(body + opt_off + 2, swap);
+
+				if (code == PCAPNG_OPT_END)
+					break;
+				if (code == PCAPNG_OPT_IF_TSRESOL && olen == 1 &&
+						opt_off + 5 <= body_len)
+					ifaces[nb_ifaces].tsresol = body[opt_off + 4];
+				opt_off += 4 + RTE_ALIGN_CEIL(olen, 4);
+			}
+			nb_ifaces++;
+			break;
+		}
+		case PCAPNG_BLOCK_EPB: {
+			uint32_t iface, caplen;
+			uint64_t ts;
+
+			if (body_len < 20)
+				return -EINVAL;
+			iface = rd32(body, swap);
+			if (iface >= nb_ifaces)
+				return -EINVAL;
+			ts = ((uint64_t)rd32(body + 4, swap) << 32) |
+				rd32(body + 8, swap);
+			caplen = rd32(body + 12, swap);
+			if (caplen > body_len - 20)
+				return -EINVAL;
+			ts_ns = pcapng_ts_to_ns(ts, ifaces[iface].tsresol);
+			ret = replay_add_pkt(r, &size, socket_id,
+					off + 8 + 20, caplen, ts_ns);
+			if (ret < 0)
+				return ret;
+			break;
+		}
+		case PCAPNG_BLOCK_SPB: {
+			uint32_t caplen;
+
+			/* Simple packets have no timestamp, reuse the last one. */
+			if (body_len < 4 || nb_ifaces == 0)
+				return -EINVAL;
+			caplen = RTE_MIN(rd32(body, swap), body_len - 4);
+			if (ifaces[0].snaplen != 0)
+				caplen = RTE_MIN(caplen, ifaces[0].snaplen);
+			ret = replay_add_pkt(r, &size, socket_id,
+					off + 8 + 4, caplen, ts_ns);
+			if (ret < 0)
+				return ret;
+			break;
+		}
+		default:
+			break;
+		}
+
+		off += blen;
+	}
+
+	return 0;
+}
+
+static void
+replay_free(struct pcap_replay *r)
+{
+	if (r->extmem)
+		rte_extmem_unregister(r->addr, r->map_len);
+	if (r->addr != NULL)
+		rte_mem_unmap(r->addr, r->map_len);
+	rte_free(r->pkts);
+	rte_free(r);
+}
+
+static void
+replay_shinfo_free_cb(void *addr __rte_unused, void *opaque)
+{
+	struct pcap_replay *r = opaque;
+
+	if (rte_atomic_fetch_sub_explicit(&r->refs, 1,
+			rte_memory_order_acq_rel) == 1)
+		replay_free(r);
+}
+
+struct pcap_replay *
+pcap_replay_open(const char *filename, double speed, int loop,
+		uint16_t port_id, int ts_offset, uint64_t ts_flag, int socket_id)
+{
+	struct pcap_replay *r;
+	size_t page_sz = rte_mem_page_size();
+	struct stat st;
+	uint32_t magic;
+	unsigned int i;
+	int fd, ret;
+
+	r = rte_zmalloc_socket("pcap_replay", sizeof(*r), RTE_CACHE_LINE_SIZE,
+			socket_id);
+	if (r == NULL)
+		return NULL;
+
+	fd = open(filename, O_RDONLY);
+	if (fd < 0) {
+		PMD_LOG(ERR, "Couldn't open %s: %s", filename, strerror(errno));
+		goto error;
+	}
+	if (fstat(fd, &st) < 0 || st.st_size < PCAP_FILE_HDR_LEN) {
+		PMD_LOG(ERR, "Invalid pcap file %s", filename);
+		close(fd);
+		goto error;
+	}
+	r->len = st.st_size;
+	r->map_len = RTE_ALIGN_CEIL(r->len, page_sz);
+
+	/*
+	 * Private writable mapping: applications may modify the packets,
+	 * the changes are never written back to the file but are seen
+	 * again when the file is looped over.
+	 */
+	r->addr = rte_mem_map(NULL, r->map_len, RTE_PROT_READ | RTE_PROT_WRITE,
+			RTE_MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (r->addr == NULL) {
+		PMD_LOG(ERR, "Couldn't map %s: %s", filename,
+			rte_strerror(rte_errno));
+		goto error;
+	}
+
+	magic = rd32(r->addr, false);
+	if (magic == PCAPNG_BLOCK_SHB)
+		ret = replay_index_pcapng(r, socket_id);
+	else if (magic == PCAP_MAGIC_US || magic == PCAP_MAGIC_NS ||
+			magic == rte_bswap32(PCAP_MAGIC_US) ||
+			magic == rte_bswap32(PCAP_MAGIC_NS))
+		ret = replay_index_pcap(r, socket_id);
+	else
+		ret = -EINVAL;
+	if (ret < 0) {
+		PMD_LOG(ERR, "Couldn't parse %s: %s", filename, strerror(-ret));
+		goto error;
+	}
+	if (r->nb_pkts == 0) {
+		PMD_LOG(ERR, "No packets to replay in %s", filename);
+		goto error;
+	}
+
+	/*
+	 * Register the mapping so that drivers looking up the memory of
+	 * transmitted mbufs can find it. Applications must still map it
+	 * for DMA on devices behind an IOMMU.
+	 */
+	if (rte_extmem_register(r->addr, r->map_len, NULL, 0, page_sz) == 0)
+		r->extmem = true;
+	else
+		PMD_LOG(WARNING, "Couldn't register %s as external memory: %s",
+			filename, rte_strerror(rte_errno));
+
+	r->loop = loop;
+	r->port_id = port_id;
+	r->ts_offset = ts_offset;
+	r->ts_flag = ts_flag;
+	if (speed > 0) {
+		r->cycles_per_ns = (double)rte_get_timer_hz() / NSEC_PER_SEC / speed;
+		r->max_wait = rte_get_timer_hz() * PCAP_REPLAY_MAX_WAIT_US / US_PER_S;
+	}
+
+	/* One reference per shinfo is held until pcap_replay_close(). */
+	rte_atomic_store_explicit(&r->refs, PCAP_REPLAY_NB_SHINFO,
+			rte_memory_order_relaxed);
+	for (i = 0; i < PCAP_REPLAY_NB_SHINFO; i++) {
+		r->shinfo[i].free_cb = replay_shinfo_free_cb;
+		r->shinfo[i].fcb_opaque = r;
+		rte_mbuf_ext_refcnt_set(&r->shinfo[i], 1);
+	}
+
+	PMD_LOG(INFO, "Replaying %" PRIu64 " packets from %s", r->nb_pkts,
+		filename);
+	return r;
+
+error:
+	replay_free(r);
+	return NULL;
+}
+
+void
+pcap_replay_close(struct pcap_replay *r)
+{
+	unsigned int i;
+
+	if (r == NULL)
+		return;
+
+	for (i = 0; i < PCAP_REPLAY_NB_SHINFO; i++)
+		if (rte_mbuf_ext_refcnt_update(&r->shinfo[i], -1) == 0)
+			replay_shinfo_free_cb(NULL, r);
+}
+
+void
+pcap_replay_reset(struct pcap_replay *r)
+{
+	r->next = 0;
+	r->start_tsc = 0;
+	r->loop_ns = 0;
+	r->last_ns = 0;
+}
+
+uint64_t
+pcap_replay_count(const struct pcap_replay *r)
+{
+	return r->nb_pkts;
+}
+
+/* Start the next loop where the previous one ended. */
+static inline void
+replay_wrap(struct pcap_replay *r)
+{
+	const struct pcap_replay_pkt *first = &r->pkts[0];
+	const struct pcap_replay_pkt *last = &r->pkts[r->nb_pkts - 1];
+
+	if (last->ts_ns > first->ts_ns)
+		r->loop_ns += last->ts_ns - first->ts_ns;
+	r->next = 0;
+}
+
+/* Capture time of a packet relative to the replay start, never going back. */
+static inline uint64_t
+replay_pkt_rel_ns(const struct pcap_replay *r, const struct pcap_replay_pkt *pkt)
+{
+	uint64_t rel_ns = 0;
+
+	if (pkt->ts_ns > r->pkts[0].ts_ns)
+		rel_ns = pkt->ts_ns - r->pkts[0].ts_ns;
+
+	return RTE_MAX(rel_ns + r->loop_ns, r->last_ns);
+}
+
+uint16_t
+pcap_replay_rx(struct pcap_replay *r, struct rte_mempool *mp,
+		struct rte_mbuf **bufs, uint16_t nb_pkts,
+		uint64_t *bytes, uint64_t *nombuf)
+{
+	struct rte_mbuf_ext_shared_info *shinfo;
+	const struct pcap_replay_pkt *pkt;
+	uint64_t idx, now, due;
+	uint16_t i, n = 0;
+	bool iova_va;
+
+	if (r->next == r->nb_pkts) {
+		if (!r->loop)
+			return 0;
+		replay_wrap(r);
+	}
+	if (unlikely(nb_pkts == 0))
+		return 0;
+
+	if (r->cycles_per_ns != 0) {
+		/*
+		 * Count the packets that are due, busy-waiting for the first
+		 * one if it is close enough. A burst never spans a loop.
+		 */
+		now = rte_get_timer_cycles();
+		if (r->start_tsc == 0)
+			r->start_tsc = now;
+
+		for (idx = r->next; n < nb_pkts && idx < r->nb_pkts; idx++, n++) {
+			due = r->start_tsc + (uint64_t)(replay_pkt_rel_ns(r,
+					&r->pkts[idx]) * r->cycles_per_ns);
+			if (due <= now)
+				continue;
+			if (n != 0 || due - now > r->max_wait)
+				break;
+			while ((now = rte_get_timer_cycles()) < due)
+				rte_pause();
+		}
+		if (n == 0)
+			return 0;
+	} else {
+		n = RTE_MIN((uint64_t)nb_pkts, r->nb_pkts - r->next);
+	}
+
+	/*
+	 * The burst takes n references at once on a 16-bit refcount
+	 * updated with a signed delta: pick a shared info with room for them.
+	 */
+	n = RTE_MIN(n, (uint16_t)INT16_MAX);
+	for (i = 0; i < PCAP_REPLAY_NB_SHINFO; i++) {
+		shinfo = &r->shinfo[r->shinfo_idx];
+		r->shinfo_idx = (r->shinfo_idx + 1) % PCAP_REPLAY_NB_SHINFO;
+		if (rte_mbuf_ext_refcnt_read(shinfo) <= UINT16_MAX - n)
+			break;
+	}
+	if (unlikely(i == PCAP_REPLAY_NB_SHINFO))
+		return 0;
+
+	if (unlikely(rte_pktmbuf_alloc_bulk(mp, bufs, n) != 0)) {
+		(*nombuf)++;
+		return 0;
+	}
+
+	rte_mbuf_ext_refcnt_update(shinfo, (int16_t)n);
+
+	iova_va = (rte_eal_iova_mode() == RTE_IOVA_VA);
+	for (i = 0; i < n; i++) {
+		struct rte_mbuf *m = bufs[i];
+		void *data;
+
+		pkt = &r->pkts[r->next++];
+		data = RTE_PTR_ADD(r->addr, pkt->offset);
+		rte_pktmbuf_attach_extbuf(m, data,
+			iova_va ? (rte_iova_t)(uintptr_t)data : RTE_BAD_IOVA,
+			pkt->caplen, shinfo);
+		m->data_len = pkt->caplen;
+		m->pkt_len = pkt->caplen;
+		m->port = r->port_id;
+		*RTE_MBUF_DYNFIELD(m, r->ts_offset, rte_mbuf_timestamp_t *) =
+			pkt->ts_ns / 1000;
+		m->ol_flags |= r->ts_flag;
+		*bytes += pkt->caplen;
+	}
+	if (r->cycles_per_ns != 0)
+		r->last_ns = replay_pkt_rel_ns(r, &r->pkts[r->next - 1]);
+
+	return n;
+}
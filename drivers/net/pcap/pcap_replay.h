@@ -0,0 +1,84 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation.
+ */
+
+#ifndef _PCAP_REPLAY_H_
+#define _PCAP_REPLAY_H_
+
+#include <stdint.h>
+
+#include <rte_mbuf.h>
+
+struct pcap_replay;
+
+/**
+ * Map a pcap or pcapng file and index its packets for replay.
+ *
+ * @param filename
+ *   Path of the capture file.
+ * @param speed
+ *   Pacing multiplier applied to capture timestamps,
+ *   0 to replay at maximum rate.
+ * @param loop
+ *   Non-zero to restart from the first packet once the file is exhausted.
+ * @param port_id
+ *   Port id set in received mbufs.
+ * @param ts_offset
+ *   Offset of the Rx timestamp dynamic field, set to the capture time
+ *   in microseconds.
+ * @param ts_flag
+ *   Rx timestamp dynamic flag.
+ * @param socket_id
+ *   NUMA socket for the replay state and packet index.
+ * @return
+ *   Replay handle, or NULL on error.
+ */
+struct pcap_replay *
+pcap_replay_open(const char *filename, double speed, int loop,
+		uint16_t port_id, int ts_offset, uint64_t ts_flag, int socket_id);
+
+/**
+ * Release a replay handle. The file stays mapped until all mbufs
+ * referencing it have been freed.
+ */
+void
+pcap_replay_close(struct pcap_replay *r);
+
+/**
+ * Rewind to the first packet and restart pacing on the next burst.
+ */
+void
+pcap_replay_reset(struct pcap_replay *r);
+
+/**
+ * Get the number of packets in the replayed file.
+ */
+uint64_t
+pcap_replay_count(const struct pcap_replay *r);
+
+/**
+ * Receive the next packets that are due according to the pacing.
+ * Packet data is attached to the mbufs as external buffers pointing
+ * into the mapped file, the mbufs are only used for metadata.
+ *
+ * @param r
+ *   Replay handle.
+ * @param mp
+ *   Mempool for the mbufs.
+ * @param bufs
+ *   Array to store the received mbufs.
+ * @param nb_pkts
+ *   Maximum number of packets to receive.
+ * @param bytes
+ *   Incremented by the number of bytes received.
+ * @param nombuf
+ *   Incremented on mbuf allocation failure.
+ * @return
+ *   Number of packets received.
+ */
+uint16_t
+pcap_replay_rx(struct pcap_replay *r, struct rte_mempool *mp,
+		struct rte_mbuf **bufs, uint16_t nb_pkts,
+		uint64_t *bytes, uint64_t *nombuf);
+
+#endif
@@ -8,9 +8,11 @@
 #include "rte_eth_ring.h"
 #include <rte_mbuf.h>
 #include <ethdev_driver.h>
+#include <rte_lcore.h>
 #include <rte_malloc.h>
 #include <rte_memcpy.h>
 #include <rte_os_shim.h>
+#include <rte_prefetch.h>
 #include <rte_string_fns.h>
 #include <bus_vdev_driver.h>
 #include <rte_kvargs.h>
@@ -22,10 +24,17 @@
 #define ETH_RING_ACTION_MAX_LEN		8 /* CREATE | ACTION */
 #define ETH_RING_INTERNAL_ARG		"internal"
 #define ETH_RING_INTERNAL_ARG_MAX_LEN	19 /* "0x..16chars..\0" */
+#define ETH_RING_STATS_ARG		"stats"
+#define ETH_RING_SYNC_ARG		"sync"
+
+/* Number of mbufs prefetched ahead when setting the input port on Rx. */
+#define ETH_RING_PREFETCH_OFFSET	4
 
 static const char *valid_arguments[] = {
 	ETH_RING_NUMA_NODE_ACTION_ARG,
 	ETH_RING_INTERNAL_ARG,
+	ETH_RING_STATS_ARG,
+	ETH_RING_SYNC_ARG,
 	NULL
 };
 
@@ -43,16 +52,34 @@ enum dev_action {
 	DEV_ATTACH
 };
 
+enum stats_mode {
+	STATS_ATOMIC, /* shared counters, atomic if the ring is multi-thread */
+	STATS_LCORE, /* per-lcore counters, summed when read */
+	STATS_NONE, /* no counters */
+};
+
+struct ring_options {
+	enum stats_mode stats_mode;
+	unsigned int ring_flags; /* flags of the rings created by the PMD */
+};
+
+struct __rte_cache_aligned ring_lcore_stats {
+	RTE_ATOMIC(uint64_t) pkts;
+};
+
 struct ring_queue {
 	struct rte_ring *rng;
 	uint16_t in_port;
 	RTE_ATOMIC(uint64_t) rx_pkts;
 	RTE_ATOMIC(uint64_t) tx_pkts;
+	/* per-lcore counters, allocated in STATS_LCORE mode */
+	struct ring_lcore_stats *lcore_stats;
 };
 
 struct pmd_internals {
 	unsigned int max_rx_queues;
 	unsigned int max_tx_queues;
+	enum stats_mode stats_mode;
 
 	struct ring_queue rx_ring_queues[RTE_PMD_RING_MAX_RX_RINGS];
 	struct ring_queue tx_ring_queues[RTE_PMD_RING_MAX_TX_RINGS];
@@ -74,16 +101,53 @@ RTE_LOG_REGISTER_DEFAULT(eth_ring_logtype, NOTICE);
 #define PMD_LOG(level, ...) \
 	RTE_LOG_LINE_PREFIX(level, ETH_RING, "%s(): ", __func__, __VA_ARGS__)
 
-static uint16_t
-eth_ring_rx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
+static __rte_always_inline uint16_t
+ring_rx_burst(struct ring_queue *r, struct rte_mbuf **bufs, uint16_t nb_bufs)
 {
 	unsigned int i;
 	void **ptrs = (void *)&bufs[0];
-	struct ring_queue *r = q;
 	const uint16_t nb_rx = (uint16_t)rte_ring_dequeue_burst(r->rng,
 			ptrs, nb_bufs, NULL);
-	for (i = 0; i < nb_rx; i++)
+
+	/* the first mbuf cache line was likely written by another lcore */
+	for (i = 0; i < nb_rx && i < ETH_RING_PREFETCH_OFFSET; i++)
+		rte_prefetch0(bufs[i]);
+	for (i = 0; i < nb_rx; i++) {
+		if (i + ETH_RING_PREFETCH_OFFSET < nb_rx)
+			rte_prefetch0(bufs[i + ETH_RING_PREFETCH_OFFSET]);
 		bufs[i]->port = r->in_port;
+	}
+	return nb_rx;
+}
+
+/*
+ * The counter slot is selected by lcore id, which is not unique
+ * across processes: a plain update is used only when the ring has
+ * a single producer (or consumer), so a single thread updates the slot.
+ */
+static __rte_always_inline void
+ring_lcore_stats_add(struct ring_queue *r, RTE_ATOMIC(uint64_t) *pkts,
+		uint16_t nb, bool single)
+{
+	unsigned int lcore_id = rte_lcore_id();
+
+	if (likely(lcore_id < RTE_MAX_LCORE))
+		pkts = &r->lcore_stats[lcore_id].pkts;
+	else
+		single = false;
+
+	if (single)
+		*pkts += nb;
+	else
+		rte_atomic_fetch_add_explicit(pkts, nb, rte_memory_order_relaxed);
+}
+
+static uint16_t
+eth_ring_rx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
+{
+	struct ring_queue *r = q;
+	const uint16_t nb_rx = ring_rx_burst(r, bufs, nb_bufs);
+
 	if (r->rng->flags & RING_F_SC_DEQ)
 		r->rx_pkts += nb_rx;
 	else
@@ -91,6 +155,23 @@ eth_ring_rx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
 	return nb_rx;
 }
 
+static uint16_t
+eth_ring_rx_lcore_stats(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
+{
+	struct ring_queue *r = q;
+	const uint16_t nb_rx = ring_rx_burst(r, bufs, nb_bufs);
+
+	ring_lcore_stats_add(r, &r->rx_pkts, nb_rx,
+			(r->rng->flags & RING_F_SC_DEQ) != 0);
+	return nb_rx;
+}
+
+static uint16_t
+eth_ring_rx_no_stats(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
+{
+	return ring_rx_burst(q, bufs, nb_bufs);
+}
+
 static uint16_t
 eth_ring_tx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
 {
@@ -105,6 +186,69 @@ eth_ring_tx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
 	return nb_tx;
 }
 
+static uint16_t
+eth_ring_tx_lcore_stats(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
+{
+	void **ptrs = (void *)&bufs[0];
+	struct ring_queue *r = q;
+	const uint16_t nb_tx = (uint16_t)rte_ring_enqueue_burst(r->rng,
+			ptrs, nb_bufs, NULL);
+
+	ring_lcore_stats_add(r, &r->tx_pkts, nb_tx,
+			(r->rng->flags & RING_F_SP_ENQ) != 0);
+	return nb_tx;
+}
+
+static uint16_t
+eth_ring_tx_no_stats(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
+{
+	struct ring_queue *r = q;
+
+	return (uint16_t)rte_ring_enqueue_burst(r->rng, (void **)bufs,
+			nb_bufs, NULL);
+}
+
+static void
+eth_ring_set_burst_fn(struct rte_eth_dev *eth_dev, enum stats_mode mode)
+{
+	switch (mode) {
+	case STATS_LCORE:
+		eth_dev->rx_pkt_burst = eth_ring_rx_lcore_stats;
+		eth_dev->tx_pkt_burst = eth_ring_tx_lcore_stats;
+		break;
+	case STATS_NONE:
+		eth_dev->rx_pkt_burst = eth_ring_rx_no_stats;
+		eth_dev->tx_pkt_burst = eth_ring_tx_no_stats;
+		break;
+	default:
+		eth_dev->rx_pkt_burst = eth_ring_rx;
+		eth_dev->tx_pkt_burst = eth_ring_tx;
+		break;
+	}
+}
+
+static uint64_t
+ring_queue_lcore_pkts(const struct ring_queue *r)
+{
+	uint64_t pkts = 0;
+	unsigned int i;
+
+	if (r->lcore_stats == NULL)
+		return 0;
+
+	for (i = 0; i < RTE_MAX_LCORE; i++)
+		pkts += r->lcore_stats[i].pkts;
+	return pkts;
+}
+
+static void
+ring_queue_lcore_reset(struct ring_queue *r)
+{
+	if (r->lcore_stats != NULL)
+		memset(r->lcore_stats, 0,
+			sizeof(*r->lcore_stats) * RTE_MAX_LCORE);
+}
+
 static int
 eth_dev_configure(struct rte_eth_dev *dev __rte_unused) { return 0; }
 
@@ -202,19 +346,24 @@ eth_stats_get(struct rte_eth_dev *dev, struct rte_eth_stats *stats,
 	unsigned int i;
 	unsigned long rx_total = 0, tx_total = 0;
 	const struct pmd_internals *internal = dev->data->dev_private;
+	uint64_t pkts;
 
 	for (i = 0; i < RTE_ETHDEV_QUEUE_STAT_CNTRS &&
 			i < dev->data->nb_rx_queues; i++) {
+		pkts = internal->rx_ring_queues[i].rx_pkts +
+			ring_queue_lcore_pkts(&internal->rx_ring_queues[i]);
 		if (qstats != NULL)
-			qstats->q_ipackets[i] = internal->rx_ring_queues[i].rx_pkts;
-		rx_total += internal->rx_ring_queues[i].rx_pkts;
+			qstats->q_ipackets[i] = pkts;
+		rx_total += pkts;
 	}
 
 	for (i = 0; i < RTE_ETHDEV_QUEUE_STAT_CNTRS &&
 			i < dev->data->nb_tx_queues; i++) {
+		pkts = internal->tx_ring_queues[i].tx_pkts +
+			ring_queue_lcore_pkts(&internal->tx_ring_queues[i]);
 		if (qstats != NULL)
-			qstats->q_opackets[i] = internal->tx_ring_queues[i].tx_pkts;
-		tx_total += internal->tx_ring_queues[i].tx_pkts;
+			qstats->q_opackets[i] = pkts;
+		tx_total += pkts;
 	}
 
 	stats->ipackets = rx_total;
@@ -229,10 +378,14 @@ eth_stats_reset(struct rte_eth_dev *dev)
 	unsigned int i;
 	struct pmd_internals *internal = dev->data->dev_private;
 
-	for (i = 0; i < dev->data->nb_rx_queues; i++)
+	for (i = 0; i < dev->data->nb_rx_queues; i++) {
 		internal->rx_ring_queues[i].rx_pkts = 0;
-	for (i = 0; i < dev->data->nb_tx_queues; i++)
+		ring_queue_lcore_reset(&internal->rx_ring_queues[i]);
+	}
+	for (i = 0; i < dev->data->nb_tx_queues; i++) {
 		internal->tx_ring_queues[i].tx_pkts = 0;
+		ring_queue_lcore_reset(&internal->tx_ring_queues[i]);
+	}
 
 	return 0;
 }
@@ -305,6 +458,15 @@ eth_dev_close(struct rte_eth_dev *dev)
 		}
 	}
 
+	for (i = 0; i < internals->max_rx_queues; i++) {
+		rte_free(internals->rx_ring_queues[i].lcore_stats);
+		internals->rx_ring_queues[i].lcore_stats = NULL;
+	}
+	for (i = 0; i < internals->max_tx_queues; i++) {
+		rte_free(internals->tx_ring_queues[i].lcore_stats);
+		internals->tx_ring_queues[i].lcore_stats = NULL;
+	}
+
 	/* mac_addrs must not be freed alone because part of dev_private */
 	dev->data->mac_addrs = NULL;
 
@@ -364,6 +526,7 @@ do_eth_dev_ring_create(const char *name,
 		struct rte_ring *const tx_queues[],
 		const unsigned int nb_tx_queues,
 		const unsigned int numa_node, enum dev_action action,
+		const struct ring_options *opts,
 		struct rte_eth_dev **eth_dev_p)
 {
 	struct rte_eth_dev_data *data = NULL;
@@ -396,6 +559,27 @@ do_eth_dev_ring_create(const char *name,
 		goto error;
 	}
 
+	if (opts->stats_mode == STATS_LCORE) {
+		for (i = 0; i < nb_rx_queues; i++) {
+			internals->rx_ring_queues[i].lcore_stats =
+				rte_zmalloc_socket(name, sizeof(struct ring_lcore_stats) *
+					RTE_MAX_LCORE, RTE_CACHE_LINE_SIZE, numa_node);
+			if (internals->rx_ring_queues[i].lcore_stats == NULL) {
+				rte_errno = ENOMEM;
+				goto error;
+			}
+		}
+		for (i = 0; i < nb_tx_queues; i++) {
+			internals->tx_ring_queues[i].lcore_stats =
+				rte_zmalloc_socket(name, sizeof(struct ring_lcore_stats) *
+					RTE_MAX_LCORE, RTE_CACHE_LINE_SIZE, numa_node);
+			if (internals->tx_ring_queues[i].lcore_stats == NULL) {
+				rte_errno = ENOMEM;
+				goto error;
+			}
+		}
+	}
+
 	/* reserve an ethdev entry */
 	eth_dev = rte_eth_dev_allocate(name);
 	if (eth_dev == NULL) {
@@ -418,6 +602,7 @@ do_eth_dev_ring_create(const char *name,
 	data->tx_queues = tx_queues_local;
 
 	internals->action = action;
+	internals->stats_mode = opts->stats_mode;
 	internals->max_rx_queues = nb_rx_queues;
 	internals->max_tx_queues = nb_tx_queues;
 	for (i = 0; i < nb_rx_queues; i++) {
@@ -444,8 +629,7 @@ do_eth_dev_ring_create(const char *name,
 	data->numa_node = numa_node;
 
 	/* finally assign rx and tx ops */
-	eth_dev->rx_pkt_burst = eth_ring_rx;
-	eth_dev->tx_pkt_burst = eth_ring_tx;
+	eth_ring_set_burst_fn(eth_dev, opts->stats_mode);
 
 	rte_eth_dev_probing_finish(eth_dev);
 	*eth_dev_p = eth_dev;
@@ -455,6 +639,12 @@ do_eth_dev_ring_create(const char *name,
 error:
 	rte_free(rx_queues_local);
 	rte_free(tx_queues_local);
+	if (internals != NULL) {
+		for (i = 0; i < RTE_PMD_RING_MAX_RX_RINGS; i++)
+			rte_free(internals->rx_ring_queues[i].lcore_stats);
+		for (i = 0; i < RTE_PMD_RING_MAX_TX_RINGS; i++)
+			rte_free(internals->tx_ring_queues[i].lcore_stats);
+	}
 	rte_free(internals);
 
 	return -1;
@@ -530,8 +720,8 @@ rte_eth_from_ring(struct rte_ring *r)
 static int
 eth_dev_ring_create(const char *name,
 		struct rte_vdev_device *vdev,
-		const unsigned int numa_node,
-		enum dev_action action, struct rte_eth_dev **eth_dev)
+		const unsigned int numa_node, enum dev_action action,
+		const struct ring_options *opts, struct rte_eth_dev **eth_dev)
 {
 	/* rx and tx are so-called from point of view of first port.
 	 * They are inverted from the point of view of second port
@@ -554,14 +744,14 @@ eth_dev_ring_create(const char *name,
 
 		rxtx[i] = (action == DEV_CREATE) ?
 				rte_ring_create(rng_name, 1024, numa_node,
-						RING_F_SP_ENQ|RING_F_SC_DEQ) :
+						opts->ring_flags) :
 				rte_ring_lookup(rng_name);
 		if (rxtx[i] == NULL)
 			return -1;
 	}
 
 	if (do_eth_dev_ring_create(name, vdev, rxtx, num_rings, rxtx, num_rings,
-		numa_node, action, eth_dev) < 0)
+		numa_node, action, opts, eth_dev) < 0)
 		return -1;
 
 	return 0;
@@ -649,6 +839,46 @@ static int parse_kvlist(const char *key __rte_unused,
 	return ret;
 }
 
+static int
+parse_stats_mode(const char *key __rte_unused, const char *value, void *data)
+{
+	struct ring_options *opts = data;
+
+	if (strcmp(value, "atomic") == 0)
+		opts->stats_mode = STATS_ATOMIC;
+	else if (strcmp(value, "lcore") == 0)
+		opts->stats_mode = STATS_LCORE;
+	else if (strcmp(value, "none") == 0)
+		opts->stats_mode = STATS_NONE;
+	else {
+		PMD_LOG(ERR, "Invalid stats mode %s", value);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int
+parse_sync_mode(const char *key __rte_unused, const char *value, void *data)
+{
+	struct ring_options *opts = data;
+
+	if (strcmp(value, "st") == 0)
+		opts->ring_flags = RING_F_SP_ENQ | RING_F_SC_DEQ;
+	else if (strcmp(value, "mt") == 0)
+		opts->ring_flags = 0;
+	else if (strcmp(value, "hts") == 0)
+		opts->ring_flags = RING_F_MP_HTS_ENQ | RING_F_MC_HTS_DEQ;
+	else if (strcmp(value, "rts") == 0)
+		opts->ring_flags = RING_F_MP_RTS_ENQ | RING_F_MC_RTS_DEQ;
+	else {
+		PMD_LOG(ERR, "Invalid sync mode %s", value);
+		return -1;
+	}
+
+	return 0;
+}
+
 static int
 parse_internal_args(const char *key __rte_unused, const char *value,
 		void *data)
@@ -688,6 +918,10 @@ rte_pmd_ring_probe(struct rte_vdev_device *dev)
 	struct node_action_list *info = NULL;
 	struct rte_eth_dev *eth_dev = NULL;
 	struct ring_internal_args *internal_args;
+	struct ring_options opts = {
+		.stats_mode = STATS_ATOMIC,
+		.ring_flags = RING_F_SP_ENQ | RING_F_SC_DEQ,
+	};
 
 	name = rte_vdev_device_name(dev);
 	params = rte_vdev_device_args(dev);
@@ -695,6 +929,8 @@ rte_pmd_ring_probe(struct rte_vdev_device *dev)
 	PMD_LOG(INFO, "Initializing pmd_ring for %s", name);
 
 	if (rte_eal_process_type() == RTE_PROC_SECONDARY) {
+		struct pmd_internals *internals;
+
 		eth_dev = rte_eth_dev_attach_secondary(name);
 		if (!eth_dev) {
 			PMD_LOG(ERR, "Failed to probe %s", name);
@@ -703,8 +939,9 @@ rte_pmd_ring_probe(struct rte_vdev_device *dev)
 		eth_dev->dev_ops = &ops;
 		eth_dev->device = &dev->device;
 
-		eth_dev->rx_pkt_burst = eth_ring_rx;
-		eth_dev->tx_pkt_burst = eth_ring_tx;
+		/* use the same statistics mode as the primary process */
+		internals = eth_dev->data->dev_private;
+		eth_ring_set_burst_fn(eth_dev, internals->stats_mode);
 
 		rte_eth_dev_probing_finish(eth_dev);
 
@@ -713,12 +950,12 @@ rte_pmd_ring_probe(struct rte_vdev_device *dev)
 
 	if (params == NULL || params[0] == '\0') {
 		ret = eth_dev_ring_create(name, dev, rte_socket_id(), DEV_CREATE,
-				&eth_dev);
+				&opts, &eth_dev);
 		if (ret == -1) {
 			PMD_LOG(INFO,
 				"Attach to pmd_ring for %s", name);
 			ret = eth_dev_ring_create(name, dev, rte_socket_id(),
-						  DEV_ATTACH, &eth_dev);
+						  DEV_ATTACH, &opts, &eth_dev);
 		}
 	} else {
 		kvlist = rte_kvargs_parse(params, valid_arguments);
@@ -727,18 +964,28 @@ rte_pmd_ring_probe(struct rte_vdev_device *dev)
 			PMD_LOG(INFO,
 				"Ignoring unsupported parameters when creating rings-backed ethernet device");
 			ret = eth_dev_ring_create(name, dev, rte_socket_id(),
-						  DEV_CREATE, &eth_dev);
+						  DEV_CREATE, &opts, &eth_dev);
 			if (ret == -1) {
 				PMD_LOG(INFO,
 					"Attach to pmd_ring for %s",
 					name);
 				ret = eth_dev_ring_create(name, dev, rte_socket_id(),
-							  DEV_ATTACH, &eth_dev);
+							  DEV_ATTACH, &opts, &eth_dev);
 			}
 
 			return ret;
 		}
 
+		ret = rte_kvargs_process(kvlist, ETH_RING_STATS_ARG,
+					 parse_stats_mode, &opts);
+		if (ret < 0)
+			goto out_free;
+
+		ret = rte_kvargs_process(kvlist, ETH_RING_SYNC_ARG,
+					 parse_sync_mode, &opts);
+		if (ret < 0)
+			goto out_free;
+
 		if (rte_kvargs_count(kvlist, ETH_RING_INTERNAL_ARG) == 1) {
 			ret = rte_kvargs_process(kvlist, ETH_RING_INTERNAL_ARG,
 						 parse_internal_args,
@@ -752,10 +999,19 @@ rte_pmd_ring_probe(struct rte_vdev_device *dev)
 				internal_args->tx_queues,
 				internal_args->nb_tx_queues,
 				internal_args->numa_node,
-				DEV_ATTACH,
+				DEV_ATTACH, &opts,
 				&eth_dev);
 			if (ret >= 0)
 				ret = 0;
+		} else if (rte_kvargs_count(kvlist, ETH_RING_NUMA_NODE_ACTION_ARG) == 0) {
+			ret = eth_dev_ring_create(name, dev, rte_socket_id(),
+						  DEV_CREATE, &opts, &eth_dev);
+			if (ret == -1) {
+				PMD_LOG(INFO,
+					"Attach to pmd_ring for %s", name);
+				ret = eth_dev_ring_create(name, dev, rte_socket_id(),
+							  DEV_ATTACH, &opts, &eth_dev);
+			}
 		} else {
 			ret = rte_kvargs_count(kvlist, ETH_RING_NUMA_NODE_ACTION_ARG);
 			info = rte_zmalloc("struct node_action_list",
@@ -779,7 +1035,7 @@ rte_pmd_ring_probe(struct rte_vdev_device *dev)
 							  dev,
 							  info->list[info->count].node,
 							  info->list[info->count].action,
-							  &eth_dev);
+							  &opts, &eth_dev);
 				if ((ret == -1) &&
 				    (info->list[info->count].action == DEV_CREATE)) {
 					PMD_LOG(INFO,
@@ -787,7 +1043,7 @@ rte_pmd_ring_probe(struct rte_vdev_device *dev)
 						name);
 					ret = eth_dev_ring_create(name, dev,
 							info->list[info->count].node,
-							DEV_ATTACH,
+							DEV_ATTACH, &opts,
 							&eth_dev);
 				}
 			}
@@ -829,4 +1085,6 @@ static struct rte_vdev_driver pmd_ring_drv = {
 RTE_PMD_REGISTER_VDEV(net_ring, pmd_ring_drv);
 RTE_PMD_REGISTER_ALIAS(net_ring, eth_ring);
 RTE_PMD_REGISTER_PARAM_STRING(net_ring,
-	ETH_RING_NUMA_NODE_ACTION_ARG "=name:node:action(ATTACH|CREATE)");
+	ETH_RING_NUMA_NODE_ACTION_ARG "=name:node:action(ATTACH|CREATE) "
+	ETH_RING_STATS_ARG "=atomic|lcore|none "
+	ETH_RING_SYNC_ARG "=st|mt|hts|rts");
@@ -0,0 +1,803 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <bus_vdev_driver.h>
+#include <rte_common.h>
+#include <rte_errno.h>
+#include <rte_kvargs.h>
+#include <rte_malloc.h>
+#include <rte_ring.h>
+#include <rte_regexdev.h>
+#include <rte_regexdev_core.h>
+#include <rte_regexdev_driver.h>
+
+#include "sw_regex.h"
+
+static const char * const sw_regex_valid_args[] = {
+	SW_REGEX_DFA_MAX_STATES_ARG,
+	SW_REGEX_PREFILTER_SIMD_ARG,
+	NULL
+};
+
+/** Flags of the rule database text format */
+static const struct {
+	char c;
+	uint64_t flag;
+} sw_regex_text_flags[] = {
+	{ 'i', RTE_REGEX_PCRE_RULE_CASELESS_F },
+	{ 's', RTE_REGEX_PCRE_RULE_DOTALL_F },
+	{ 'A', RTE_REGEX_PCRE_RULE_ANCHORED_F },
+	{ 'E', RTE_REGEX_PCRE_RULE_ALLOW_EMPTY_F },
+};
+
+static int
+sw_regex_socket(const struct rte_regexdev *dev)
+{
+	return dev->device->numa_node < 0 ? SOCKET_ID_ANY :
+		dev->device->numa_node;
+}
+
+static void
+sw_regex_rules_free(struct sw_regex_src_rule *rules, uint32_t nb_rules)
+{
+	uint32_t i;
+
+	for (i = 0; i != nb_rules; i++)
+		rte_free(rules[i].pattern);
+	rte_free(rules);
+}
+
+static void
+sw_regex_rules_clear(struct sw_regex_priv *priv)
+{
+	sw_regex_rules_free(priv->rules, priv->nb_rules);
+	priv->rules = NULL;
+	priv->nb_rules = 0;
+	if (priv->group_nb_rules != NULL)
+		memset(priv->group_nb_rules, 0,
+			priv->nb_groups * sizeof(priv->group_nb_rules[0]));
+}
+
+/* index of a rule in an array of rules, nb_rules if not found */
+static uint32_t
+sw_regex_rule_find(const struct sw_regex_src_rule *rules, uint32_t nb_rules,
+		uint32_t rule_id, uint16_t group_id)
+{
+	uint32_t i;
+
+	for (i = 0; i != nb_rules; i++) {
+		if (rules[i].rule_id == rule_id &&
+				rules[i].group_id == group_id)
+			break;
+	}
+	return i;
+}
+
+/* append a copy of a rule to an array of rules */
+static int
+sw_regex_rule_append(struct sw_regex_src_rule **rules, uint32_t *nb_rules,
+		uint32_t rule_id, uint16_t group_id, uint64_t flags,
+		const char *pattern, uint16_t len)
+{
+	struct sw_regex_src_rule *r;
+
+	if (sw_regex_rule_find(*rules, *nb_rules, rule_id, group_id) !=
+			*nb_rules)
+		return -EEXIST;
+
+	r = rte_realloc(*rules, (*nb_rules + 1) * sizeof(r[0]), 0);
+	if (r == NULL)
+		return -ENOMEM;
+	*rules = r;
+	r = &r[*nb_rules];
+	r->pattern = rte_malloc(NULL, RTE_MAX(len, 1), 0);
+	if (r->pattern == NULL)
+		return -ENOMEM;
+	memcpy(r->pattern, pattern, len);
+	r->len = len;
+	r->rule_id = rule_id;
+	r->group_id = group_id;
+	r->flags = flags;
+	(*nb_rules)++;
+	return 0;
+}
+
+/*
+ * Queue pairs.
+ */
+
+static void
+sw_regex_qp_release(struct sw_regex_priv *priv, uint16_t qp_id)
+{
+	struct sw_regex_qp *qp = priv->qps[qp_id];
+
+	if (qp == NULL)
+		return;
+	rte_ring_free(qp->ring);
+	rte_free(qp->scratch);
+	rte_free(qp);
+	priv->qps[qp_id] = NULL;
+}
+
+static int
+sw_regex_qp_setup(struct rte_regexdev *dev, uint16_t qp_id,
+		const struct rte_regexdev_qp_conf *qp_conf)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+	char name[RTE_RING_NAMESIZE];
+	struct sw_regex_qp *qp;
+	int socket;
+
+	if (qp_conf->nb_desc == 0)
+		return -EINVAL;
+	if (qp_conf->qp_conf_flags & RTE_REGEX_QUEUE_PAIR_CFG_OOS_F)
+		SW_REGEX_LOG(DEBUG, "operations are always completed in order");
+
+	sw_regex_qp_release(priv, qp_id);
+
+	socket = sw_regex_socket(dev);
+	qp = rte_zmalloc_socket(NULL, sizeof(*qp), RTE_CACHE_LINE_SIZE,
+		socket);
+	if (qp == NULL)
+		return -ENOMEM;
+	qp->socket_id = socket;
+	qp->prefilter_simd = priv->prefilter_simd;
+
+	snprintf(name, sizeof(name), "%s_qp%u", dev->data->dev_name, qp_id);
+	qp->ring = rte_ring_create(name, rte_align32pow2(qp_conf->nb_desc + 1),
+		socket, RING_F_SP_ENQ | RING_F_SC_DEQ);
+	qp->scratch = sw_regex_scratch_alloc(priv->db != NULL ?
+		priv->db->max_nfa : 0, socket);
+	priv->qps[qp_id] = qp;
+	if (qp->ring == NULL || qp->scratch == NULL) {
+		SW_REGEX_LOG(ERR, "cannot allocate queue pair %u", qp_id);
+		sw_regex_qp_release(priv, qp_id);
+		return -ENOMEM;
+	}
+	return 0;
+}
+
+/*
+ * Rule database.
+ */
+
+static int
+sw_regex_rule_db_compile_activate(struct rte_regexdev *dev)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+	struct sw_regex_scratch *scr[SW_REGEX_MAX_QPS] = { NULL };
+	struct sw_regex_db *db;
+	uint16_t q;
+	int rc;
+
+	if (dev->data->dev_started) {
+		SW_REGEX_LOG(ERR, "device must be stopped to activate rules");
+		return -EBUSY;
+	}
+
+	rc = sw_regex_db_compile(priv->rules, priv->nb_rules, priv->nb_groups,
+		priv->dfa_max_states, &db);
+	if (rc < 0)
+		return rc;
+
+	/* working memory of the queue pairs for the new NFA sizes */
+	for (q = 0; q != priv->nb_qps; q++) {
+		if (priv->qps[q] == NULL ||
+				priv->qps[q]->scratch->nb_nfa >= db->max_nfa)
+			continue;
+		scr[q] = sw_regex_scratch_alloc(db->max_nfa,
+			priv->qps[q]->socket_id);
+		if (scr[q] == NULL) {
+			for (q = 0; q != priv->nb_qps; q++)
+				rte_free(scr[q]);
+			sw_regex_db_free(db);
+			return -ENOMEM;
+		}
+	}
+	for (q = 0; q != priv->nb_qps; q++) {
+		if (scr[q] == NULL)
+			continue;
+		rte_free(priv->qps[q]->scratch);
+		priv->qps[q]->scratch = scr[q];
+	}
+
+	sw_regex_db_free(priv->db);
+	priv->db = db;
+	return 0;
+}
+
+static int
+sw_regex_rule_remove(struct sw_regex_priv *priv,
+		const struct rte_regexdev_rule *rule)
+{
+	uint32_t i;
+
+	i = sw_regex_rule_find(priv->rules, priv->nb_rules, rule->rule_id,
+		rule->group_id);
+	if (i == priv->nb_rules)
+		return -ENOENT;
+
+	rte_free(priv->rules[i].pattern);
+	memmove(&priv->rules[i], &priv->rules[i + 1],
+		(priv->nb_rules - i - 1) * sizeof(priv->rules[0]));
+	priv->nb_rules--;
+	priv->group_nb_rules[rule->group_id]--;
+	return 0;
+}
+
+static int
+sw_regex_rule_db_update(struct rte_regexdev *dev,
+		const struct rte_regexdev_rule *rules, uint16_t nb_rules)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+	const struct rte_regexdev_rule *r;
+	uint16_t i;
+	int rc;
+
+	for (i = 0; i != nb_rules; i++) {
+		r = &rules[i];
+		if (r->group_id >= priv->nb_groups ||
+				r->rule_id > SW_REGEX_MAX_RULE_ID) {
+			rte_errno = EINVAL;
+			break;
+		}
+		if (r->op == RTE_REGEX_RULE_OP_REMOVE) {
+			rc = sw_regex_rule_remove(priv, r);
+			if (rc < 0) {
+				rte_errno = -rc;
+				break;
+			}
+			continue;
+		}
+
+		if (priv->group_nb_rules[r->group_id] ==
+				priv->nb_rules_per_group) {
+			rte_errno = ENOSPC;
+			break;
+		}
+		rc = sw_regex_rule_check(r->pcre_rule, r->pcre_rule_len,
+			r->rule_flags);
+		if (rc == 0)
+			rc = sw_regex_rule_append(&priv->rules, &priv->nb_rules,
+				r->rule_id, r->group_id, r->rule_flags,
+				r->pcre_rule, r->pcre_rule_len);
+		if (rc < 0) {
+			SW_REGEX_LOG(ERR, "cannot add rule %u of group %u: %s",
+				r->rule_id, r->group_id, rte_strerror(-rc));
+			rte_errno = -rc;
+			break;
+		}
+		priv->group_nb_rules[r->group_id]++;
+	}
+	return i;
+}
+
+/*
+ * Parse a line of the rule database text format:
+ * <rule id>,<group id>,/<pattern>/<flags>
+ */
+static int
+sw_regex_parse_line(struct sw_regex_priv *priv, char *line,
+		struct sw_regex_src_rule **rules, uint32_t *nb_rules)
+{
+	unsigned long rule_id, group_id;
+	char *p, *pattern, *last;
+	uint64_t flags;
+	uint32_t i;
+
+	errno = 0;
+	rule_id = strtoul(line, &p, 0);
+	if (errno != 0 || p == line || *p != ',' ||
+			rule_id > SW_REGEX_MAX_RULE_ID)
+		return -EINVAL;
+	line = p + 1;
+	group_id = strtoul(line, &p, 0);
+	if (errno != 0 || p == line || *p != ',' ||
+			group_id >= priv->nb_groups)
+		return -EINVAL;
+
+	pattern = p + 1;
+	last = strrchr(pattern, '/');
+	if (*pattern != '/' || last == pattern)
+		return -EINVAL;
+	pattern++;
+	if (last - pattern > UINT16_MAX)
+		return -EINVAL;
+
+	flags = 0;
+	for (p = last + 1; *p != '\0'; p++) {
+		for (i = 0; i != RTE_DIM(sw_regex_text_flags); i++)
+			if (*p == sw_regex_text_flags[i].c)
+				break;
+		if (i == RTE_DIM(sw_regex_text_flags))
+			return -EINVAL;
+		flags |= sw_regex_text_flags[i].flag;
+	}
+
+	return sw_regex_rule_append(rules, nb_rules, rule_id, group_id, flags,
+		pattern, last - pattern);
+}
+
+static int
+sw_regex_rule_db_import(struct rte_regexdev *dev, const char *rule_db,
+		uint32_t rule_db_len)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+	struct sw_regex_src_rule *rules, *old_rules;
+	uint32_t i, nb_rules, old_nb_rules;
+	char *text, *line, *sp;
+	size_t len;
+	int rc;
+
+	text = malloc(rule_db_len + 1);
+	if (text == NULL)
+		return -ENOMEM;
+	memcpy(text, rule_db, rule_db_len);
+	text[rule_db_len] = '\0';
+
+	rules = NULL;
+	nb_rules = 0;
+	rc = 0;
+	for (line = strtok_r(text, "\n", &sp); line != NULL;
+			line = strtok_r(NULL, "\n", &sp)) {
+		len = strlen(line);
+		if (len != 0 && line[len - 1] == '\r')
+			line[--len] = '\0';
+		if (len == 0 || line[0] == '#')
+			continue;
+		rc = sw_regex_parse_line(priv, line, &rules, &nb_rules);
+		if (rc == 0)
+			rc = sw_regex_rule_check(rules[nb_rules - 1].pattern,
+				rules[nb_rules - 1].len,
+				rules[nb_rules - 1].flags);
+		if (rc < 0) {
+			SW_REGEX_LOG(ERR, "invalid rule: %s", line);
+			break;
+		}
+	}
+	free(text);
+	if (rc < 0) {
+		sw_regex_rules_free(rules, nb_rules);
+		return rc;
+	}
+
+	/* the imported rules replace the database */
+	old_rules = priv->rules;
+	old_nb_rules = priv->nb_rules;
+	priv->rules = rules;
+	priv->nb_rules = nb_rules;
+	rc = sw_regex_rule_db_compile_activate(dev);
+	if (rc < 0) {
+		priv->rules = old_rules;
+		priv->nb_rules = old_nb_rules;
+		sw_regex_rules_free(rules, nb_rules);
+		return rc;
+	}
+	sw_regex_rules_free(old_rules, old_nb_rules);
+
+	memset(priv->group_nb_rules, 0,
+		priv->nb_groups * sizeof(priv->group_nb_rules[0]));
+	for (i = 0; i != nb_rules; i++)
+		priv->group_nb_rules[rules[i].group_id]++;
+	return 0;
+}
+
+static int
+sw_regex_rule_db_export(struct rte_regexdev *dev, char *rule_db)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+	const struct sw_regex_src_rule *r;
+	char flags[RTE_DIM(sw_regex_text_flags) + 1];
+	uint32_t i, j, k;
+	size_t size;
+	int n;
+
+	size = 0;
+	for (i = 0; i != priv->nb_rules; i++) {
+		r = &priv->rules[i];
+		for (j = 0, k = 0; j != RTE_DIM(sw_regex_text_flags); j++)
+			if (r->flags & sw_regex_text_flags[j].flag)
+				flags[k++] = sw_regex_text_flags[j].c;
+		flags[k] = '\0';
+		n = snprintf(rule_db == NULL ? NULL : rule_db + size,
+			rule_db == NULL ? 0 : SIZE_MAX, "%u,%u,/%.*s/%s\n",
+			r->rule_id, r->group_id, r->len, r->pattern, flags);
+		if (n < 0)
+			return -EINVAL;
+		size += n;
+	}
+	if (rule_db == NULL)
+		return size + 1;
+	rule_db[size] = '\0';
+	return 0;
+}
+
+/*
+ * Device operations.
+ */
+
+static int
+sw_regex_dev_info_get(struct rte_regexdev *dev, struct rte_regexdev_info *info)
+{
+	info->driver_name = RTE_STR(REGEXDEV_NAME_SW_PMD);
+	info->dev = dev->device;
+	info->max_matches = SW_REGEX_MAX_MATCHES;
+	info->max_queue_pairs = SW_REGEX_MAX_QPS;
+	info->max_payload_size = SW_REGEX_MAX_PAYLOAD;
+	info->max_segs = SW_REGEX_MAX_SEGS;
+	info->max_rules_per_group = SW_REGEX_MAX_RULES_PER_GROUP;
+	info->max_groups = SW_REGEX_MAX_GROUPS;
+	info->regexdev_capa = RTE_REGEXDEV_CAPA_RUNTIME_COMPILATION_F |
+		RTE_REGEXDEV_CAPA_SUPP_PCRE_START_ANCHOR_F;
+	info->rule_flags = SW_REGEX_RULE_FLAGS;
+	return 0;
+}
+
+static int
+sw_regex_dev_configure(struct rte_regexdev *dev,
+		const struct rte_regexdev_config *cfg)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+	uint32_t *group_nb_rules;
+	uint16_t q;
+
+	for (q = cfg->nb_queue_pairs; q < priv->nb_qps; q++)
+		sw_regex_qp_release(priv, q);
+	priv->nb_qps = cfg->nb_queue_pairs;
+	priv->nb_max_matches = cfg->nb_max_matches;
+	priv->nb_rules_per_group = cfg->nb_rules_per_group;
+
+	/* rules are kept as long as the groups do not change */
+	if (cfg->nb_groups != priv->nb_groups) {
+		group_nb_rules = rte_zmalloc(NULL,
+			cfg->nb_groups * sizeof(group_nb_rules[0]), 0);
+		if (group_nb_rules == NULL)
+			return -ENOMEM;
+		sw_regex_rules_clear(priv);
+		sw_regex_db_free(priv->db);
+		priv->db = NULL;
+		rte_free(priv->group_nb_rules);
+		priv->group_nb_rules = group_nb_rules;
+		priv->nb_groups = cfg->nb_groups;
+	}
+
+	if (cfg->rule_db != NULL)
+		return sw_regex_rule_db_import(dev, cfg->rule_db,
+			cfg->rule_db_len);
+	return 0;
+}
+
+static int
+sw_regex_dev_start(struct rte_regexdev *dev __rte_unused)
+{
+	return 0;
+}
+
+static int
+sw_regex_dev_stop(struct rte_regexdev *dev __rte_unused)
+{
+	return 0;
+}
+
+static int
+sw_regex_dev_close(struct rte_regexdev *dev)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+	uint16_t q;
+
+	for (q = 0; q != priv->nb_qps; q++)
+		sw_regex_qp_release(priv, q);
+	priv->nb_qps = 0;
+	sw_regex_rules_clear(priv);
+	sw_regex_db_free(priv->db);
+	priv->db = NULL;
+	rte_free(priv->group_nb_rules);
+	priv->group_nb_rules = NULL;
+	priv->nb_groups = 0;
+	return 0;
+}
+
+static int
+sw_regex_dev_dump(struct rte_regexdev *dev, FILE *f)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+	const struct sw_regex_group *g;
+	const struct sw_regex_qp *qp;
+	uint16_t i;
+
+	fprintf(f, "%s: %u rules, DFA limited to %u states\n",
+		dev->data->dev_name, priv->nb_rules, priv->dfa_max_states);
+	for (i = 0; priv->db != NULL && i != priv->db->nb_groups; i++) {
+		g = priv->db->groups[i];
+		if (g == NULL)
+			continue;
+		fprintf(f, "  group %u: %u rules, %u NFA states, "
+			"%u DFA states (%u expanded), %u byte classes, "
+			"prefilter %s\n",
+			i, g->nb_rules, g->nb_nfa, g->nb_dfa, g->nb_expanded,
+			g->nb_byte_cls, g->pf.enabled ? "on" : "off");
+	}
+	for (i = 0; i != priv->nb_qps; i++) {
+		qp = priv->qps[i];
+		if (qp == NULL)
+			continue;
+		fprintf(f, "  qp %u: %"PRIu64" ops, %"PRIu64" matches, "
+			"%"PRIu64" prefiltered scans, %"PRIu64" NFA bytes\n",
+			i, qp->nb_ops, qp->nb_matches, qp->nb_prefiltered,
+			qp->nb_nfa_bytes);
+	}
+	return 0;
+}
+
+/*
+ * Extended statistics, summed over the queue pairs.
+ */
+
+static const char * const sw_regex_xstats_names[] = {
+	"ops",
+	"matches",
+	"prefiltered_scans",
+	"nfa_bytes",
+};
+
+static uint64_t *
+sw_regex_xstat(struct sw_regex_qp *qp, uint16_t id)
+{
+	switch (id) {
+	case 0:
+		return &qp->nb_ops;
+	case 1:
+		return &qp->nb_matches;
+	case 2:
+		return &qp->nb_prefiltered;
+	default:
+		return &qp->nb_nfa_bytes;
+	}
+}
+
+static int
+sw_regex_xstats_names_get(struct rte_regexdev *dev __rte_unused,
+		struct rte_regexdev_xstats_map *xstats_map)
+{
+	uint16_t i;
+
+	for (i = 0; i != RTE_DIM(sw_regex_xstats_names); i++) {
+		xstats_map[i].id = i;
+		strlcpy(xstats_map[i].name, sw_regex_xstats_names[i],
+			sizeof(xstats_map[i].name));
+	}
+	return i;
+}
+
+static int
+sw_regex_xstats_get(struct rte_regexdev *dev, const uint16_t *ids,
+		uint64_t *values, uint16_t nb_values)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+	uint16_t i, q;
+
+	for (i = 0; i != nb_values; i++) {
+		if (ids[i] >= RTE_DIM(sw_regex_xstats_names))
+			return -EINVAL;
+		values[i] = 0;
+		for (q = 0; q != priv->nb_qps; q++)
+			if (priv->qps[q] != NULL)
+				values[i] += *sw_regex_xstat(priv->qps[q],
+					ids[i]);
+	}
+	return i;
+}
+
+static int
+sw_regex_xstats_by_name_get(struct rte_regexdev *dev, const char *name,
+		uint16_t *id, uint64_t *value)
+{
+	uint16_t i;
+
+	for (i = 0; i != RTE_DIM(sw_regex_xstats_names); i++) {
+		if (strcmp(name, sw_regex_xstats_names[i]) == 0) {
+			*id = i;
+			sw_regex_xstats_get(dev, id, value, 1);
+			return 0;
+		}
+	}
+	return -EINVAL;
+}
+
+static int
+sw_regex_xstats_reset(struct rte_regexdev *dev, const uint16_t *ids,
+		uint16_t nb_ids)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+	uint16_t i, q;
+
+	/* all the counters are reset if no identifier is given */
+	if (ids == NULL)
+		nb_ids = RTE_DIM(sw_regex_xstats_names);
+	for (i = 0; i != nb_ids; i++) {
+		if (ids != NULL && ids[i] >= RTE_DIM(sw_regex_xstats_names))
+			return -EINVAL;
+		for (q = 0; q != priv->nb_qps; q++)
+			if (priv->qps[q] != NULL)
+				*sw_regex_xstat(priv->qps[q],
+					ids == NULL ? i : ids[i]) = 0;
+	}
+	return 0;
+}
+
+static const struct rte_regexdev_ops sw_regex_ops = {
+	.dev_info_get = sw_regex_dev_info_get,
+	.dev_configure = sw_regex_dev_configure,
+	.dev_qp_setup = sw_regex_qp_setup,
+	.dev_start = sw_regex_dev_start,
+	.dev_stop = sw_regex_dev_stop,
+	.dev_close = sw_regex_dev_close,
+	.dev_rule_db_update = sw_regex_rule_db_update,
+	.dev_rule_db_compile_activate = sw_regex_rule_db_compile_activate,
+	.dev_db_import = sw_regex_rule_db_import,
+	.dev_db_export = sw_regex_rule_db_export,
+	.dev_dump = sw_regex_dev_dump,
+	.dev_xstats_names_get = sw_regex_xstats_names_get,
+	.dev_xstats_get = sw_regex_xstats_get,
+	.dev_xstats_by_name_get = sw_regex_xstats_by_name_get,
+	.dev_xstats_reset = sw_regex_xstats_reset,
+};
+
+/*
+ * Data path. Scans run at enqueue, the completed operations are queued
+ * in a ring until dequeue.
+ */
+
+static uint16_t
+sw_regex_enqueue_burst(struct rte_regexdev *dev, uint16_t qp_id,
+		struct rte_regex_ops **ops, uint16_t nb_ops)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+	struct sw_regex_qp *qp = priv->qps[qp_id];
+	uint16_t i, n;
+
+	n = RTE_MIN(nb_ops, rte_ring_free_count(qp->ring));
+	for (i = 0; i != n; i++)
+		sw_regex_scan(priv->db, qp, ops[i], priv->nb_max_matches);
+	qp->nb_ops += n;
+
+	return rte_ring_enqueue_burst(qp->ring, (void **)ops, n, NULL);
+}
+
+static uint16_t
+sw_regex_dequeue_burst(struct rte_regexdev *dev, uint16_t qp_id,
+		struct rte_regex_ops **ops, uint16_t nb_ops)
+{
+	struct sw_regex_priv *priv = dev->data->dev_private;
+
+	return rte_ring_dequeue_burst(priv->qps[qp_id]->ring, (void **)ops,
+		nb_ops, NULL);
+}
+
+/*
+ * Virtual device.
+ */
+
+static int
+sw_regex_parse_uint(const char *key __rte_unused, const char *value,
+		void *extra_args)
+{
+	unsigned long v;
+	char *end;
+
+	errno = 0;
+	v = strtoul(value, &end, 0);
+	if (*value == '\0' || *end != '\0' || errno != 0 || v == 0 ||
+			v > (1 << 20))
+		return -EINVAL;
+	*(uint32_t *)extra_args = v;
+	return 0;
+}
+
+static int
+sw_regex_parse_bool(const char *key __rte_unused, const char *value,
+		void *extra_args)
+{
+	if (strcmp(value, "0") == 0)
+		*(bool *)extra_args = false;
+	else if (strcmp(value, "1") == 0)
+		*(bool *)extra_args = true;
+	else
+		return -EINVAL;
+	return 0;
+}
+
+static int
+sw_regex_probe(struct rte_vdev_device *vdev)
+{
+	struct rte_kvargs *kvlist;
+	struct sw_regex_priv *priv;
+	struct rte_regexdev *dev;
+	uint32_t dfa_max_states;
+	bool prefilter_simd;
+	const char *name, *args;
+	int rc;
+
+	name = rte_vdev_device_name(vdev);
+	if (name == NULL)
+		return -EINVAL;
+
+	dfa_max_states = SW_REGEX_DFA_MAX_STATES;
+	prefilter_simd = true;
+	args = rte_vdev_device_args(vdev);
+	if (args != NULL && args[0] != '\0') {
+		kvlist = rte_kvargs_parse(args, sw_regex_valid_args);
+		if (kvlist == NULL) {
+			SW_REGEX_LOG(ERR, "invalid arguments: %s", args);
+			return -EINVAL;
+		}
+		rc = rte_kvargs_process(kvlist, SW_REGEX_DFA_MAX_STATES_ARG,
+			sw_regex_parse_uint, &dfa_max_states);
+		if (rc == 0)
+			rc = rte_kvargs_process(kvlist,
+				SW_REGEX_PREFILTER_SIMD_ARG,
+				sw_regex_parse_bool, &prefilter_simd);
+		rte_kvargs_free(kvlist);
+		if (rc < 0) {
+			SW_REGEX_LOG(ERR, "invalid arguments: %s", args);
+			return -EINVAL;
+		}
+	}
+
+	priv = rte_zmalloc_socket(name, sizeof(*priv), 0,
+		rte_socket_id());
+	if (priv == NULL)
+		return -ENOMEM;
+	priv->dfa_max_states = dfa_max_states;
+	priv->prefilter_simd = prefilter_simd;
+
+	dev = rte_regexdev_register(name);
+	if (dev == NULL) {
+		SW_REGEX_LOG(ERR, "cannot register %s", name);
+		rte_free(priv);
+		return -ENODEV;
+	}
+	dev->dev_ops = &sw_regex_ops;
+	dev->enqueue = sw_regex_enqueue_burst;
+	dev->dequeue = sw_regex_dequeue_burst;
+	dev->device = &vdev->device;
+	dev->data->dev_private = priv;
+	dev->state = RTE_REGEXDEV_READY;
+	return 0;
+}
+
+static int
+sw_regex_remove(struct rte_vdev_device *vdev)
+{
+	struct rte_regexdev *dev;
+	const char *name;
+
+	name = rte_vdev_device_name(vdev);
+	if (name == NULL)
+		return -EINVAL;
+	dev = rte_regexdev_get_device_by_name(name);
+	if (dev == NULL)
+		return -ENODEV;
+
+	sw_regex_dev_close(dev);
+	rte_free(dev->data->dev_private);
+	dev->data->dev_private = NULL;
+	rte_regexdev_unregister(dev);
+	return 0;
+}
+
+static struct rte_vdev_driver sw_regex_pmd_drv = {
+	.probe = sw_regex_probe,
+	.remove = sw_regex_remove,
+};
+
+RTE_PMD_REGISTER_VDEV(REGEXDEV_NAME_SW_PMD, sw_regex_pmd_drv);
+RTE_PMD_REGISTER_PARAM_STRING(REGEXDEV_NAME_SW_PMD,
+	SW_REGEX_DFA_MAX_STATES_ARG "=<int> "
+	SW_REGEX_PREFILTER_SIMD_ARG "=<0|1>");
+RTE_LOG_REGISTER_DEFAULT(sw_regex_logtype, NOTICE);
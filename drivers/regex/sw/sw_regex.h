@@ -0,0 +1,333 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#ifndef _SW_REGEX_H_
+#define _SW_REGEX_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_bitops.h>
+#include <rte_branch_prediction.h>
+#include <rte_log.h>
+#include <rte_regexdev.h>
+#include <rte_regexdev_core.h>
+
+#define REGEXDEV_NAME_SW_PMD		regex_sw
+/**< Software RegEx PMD device name */
+
+#define SW_REGEX_MAX_QPS		RTE_MAX_LCORE
+#define SW_REGEX_MAX_MATCHES		UINT8_MAX
+#define SW_REGEX_MAX_GROUPS		(1 << 12)
+/**< Limited by the width of rte_regexdev_match::group_id */
+#define SW_REGEX_MAX_RULE_ID		((1 << 20) - 1)
+/**< Limited by the width of rte_regexdev_match::rule_id */
+#define SW_REGEX_MAX_RULES_PER_GROUP	(1 << 16)
+#define SW_REGEX_MAX_PAYLOAD		UINT16_MAX
+/**< Limited by the width of match offsets */
+#define SW_REGEX_MAX_SEGS		256
+#define SW_REGEX_MAX_REPEAT		1000
+/**< Largest counted repetition {n,m} accepted in a rule */
+#define SW_REGEX_NFA_MAX_STATES		(1 << 18)
+/**< Largest number of NFA states of a group */
+#define SW_REGEX_DFA_MAX_STATES		4096
+/**< Default largest number of DFA states of a group */
+#define SW_REGEX_DFA_MAX_STATES_ARG	"dfa_max_states"
+#define SW_REGEX_PREFILTER_SIMD_ARG	"prefilter_simd"
+
+#define SW_REGEX_RULE_FLAGS (RTE_REGEX_PCRE_RULE_ALLOW_EMPTY_F | \
+	RTE_REGEX_PCRE_RULE_ANCHORED_F | \
+	RTE_REGEX_PCRE_RULE_CASELESS_F | \
+	RTE_REGEX_PCRE_RULE_DOTALL_F)
+/**< Rule flags supported by the compiler */
+
+extern int sw_regex_logtype;
+#define RTE_LOGTYPE_SW_REGEX sw_regex_logtype
+#define SW_REGEX_LOG(level, ...) \
+	RTE_LOG_LINE_PREFIX(level, SW_REGEX, "%s(): ", __func__, __VA_ARGS__)
+
+#define SW_REGEX_NONE			UINT32_MAX
+#define SW_REGEX_DFA_SPECIAL		(UINT32_C(1) << 31)
+/**< Transition to a state which is accepting, dead or not expanded */
+
+/** Types of NFA states */
+enum sw_regex_nfa_type {
+	SW_NFA_CLASS,	/**< Consume a byte of the class, go to out */
+	SW_NFA_SPLIT,	/**< Go to both out and out1 */
+	SW_NFA_EPS,	/**< Go to out */
+	SW_NFA_MATCH,	/**< Match of the rule out1 */
+};
+
+/** Thompson NFA state */
+struct sw_regex_nfa_state {
+	uint32_t type;
+	uint32_t out;
+	uint32_t out1;
+	/**< Second branch, char class or rule index depending on type */
+};
+
+/** Set of bytes */
+struct sw_regex_cls {
+	uint64_t bits[4];
+};
+
+static inline bool
+sw_regex_cls_test(const struct sw_regex_cls *cls, uint8_t c)
+{
+	return (cls->bits[c >> 6] >> (c & 63)) & 1;
+}
+
+/** Rule of a compiled group */
+struct sw_regex_rule {
+	uint32_t rule_id;
+	uint32_t rev_start;
+	/**< Start state of the reversed rule, to find match starts */
+	uint32_t rev_match;
+	/**< Match state of the reversed rule */
+	uint32_t rev_lo;
+	uint32_t rev_hi;
+	/**< Range of set words holding the states of the reversed rule */
+	bool anchored;
+};
+
+#define SW_REGEX_LIT_MAX_LEN		8
+/**< Longest literal factor taken from a rule */
+#define SW_REGEX_TEDDY_BUCKETS		8
+
+/**
+ * Literal prefilter of a group.
+ * Every rule of the group requires one of the literal factors,
+ * payloads not containing any of them are skipped.
+ */
+struct sw_regex_prefilter {
+	bool enabled;
+	uint64_t start;
+	/**< First position of each literal in the shift-and state */
+	uint64_t end;
+	/**< Last position of each literal in the shift-and state */
+	uint64_t mask[256];
+	/**< Positions accepting each byte */
+	alignas(16) uint8_t nib_lo[16];
+	/**< Buckets of literals starting with a byte of this low nibble */
+	alignas(16) uint8_t nib_hi[16];
+	/**< Buckets of literals starting with a byte of this high nibble */
+};
+
+/** Compiled automaton of a rule group */
+struct sw_regex_group {
+	uint16_t group_id;
+	uint32_t nb_rules;
+	struct sw_regex_rule *rules;
+	uint32_t nb_nfa;
+	struct sw_regex_nfa_state *nfa;
+	/**< Forward NFA of all rules, followed by the reversed rules */
+	uint32_t nb_cls;
+	struct sw_regex_cls *cls;
+	uint32_t set_words;
+	/**< Size in 64-bit words of a set of NFA states */
+	uint64_t *init_unanch;
+	/**< NFA states active at every position */
+	uint8_t byte_cls[256];
+	/**< Byte equivalence classes of the DFA alphabet */
+	uint32_t nb_byte_cls;
+	uint32_t nb_dfa;
+	/**< Number of DFA states */
+	uint32_t nb_expanded;
+	/**< States from nb_expanded have no transitions: NFA fallback */
+	uint32_t dead;
+	/**< State without NFA state, no match is possible from it */
+	uint32_t *trans;
+	/**< Transitions of expanded states, per byte class */
+	uint32_t *acc_ofs;
+	/**< Rules matched in state s are acc[acc_ofs[s]] to acc[acc_ofs[s+1]] */
+	uint32_t *acc;
+	uint64_t *sets;
+	/**< NFA state set of each DFA state */
+	uint32_t hash_mask;
+	uint32_t *hash;
+	/**< Open addressing table of DFA states by NFA state set */
+	struct sw_regex_prefilter pf;
+};
+
+/** Compiled rule database */
+struct sw_regex_db {
+	uint16_t nb_groups;
+	struct sw_regex_group **groups;
+	/**< Indexed by group identifier, NULL if the group has no rule */
+	uint32_t max_nfa;
+	/**< Largest number of NFA states of all groups */
+};
+
+/** Rule of the database, compiled on activation */
+struct sw_regex_src_rule {
+	uint32_t rule_id;
+	uint16_t group_id;
+	uint64_t flags;
+	char *pattern;
+	uint16_t len;
+};
+
+/** Segment of a scanned payload */
+struct sw_regex_seg {
+	const uint8_t *data;
+	uint32_t len;
+	uint32_t ofs;
+	/**< Offset of the segment in the payload */
+};
+
+/** Working memory of the compiler and the scanner */
+struct sw_regex_scratch {
+	uint32_t nb_nfa;
+	/**< Largest number of NFA states the sets can hold */
+	uint64_t *cur;
+	uint64_t *next;
+	/**< Sets of NFA states of the NFA fallback */
+	uint64_t *rcur;
+	uint64_t *rnext;
+	/**< Sets of NFA states of the reversed rules */
+	uint32_t *mark;
+	uint32_t gen;
+	/**< States are visited in the current step when mark is gen */
+	uint32_t *stack;
+	uint32_t nb_segs;
+	struct sw_regex_seg segs[SW_REGEX_MAX_SEGS];
+};
+
+struct __rte_cache_aligned sw_regex_qp {
+	struct rte_ring *ring;
+	/**< Processed operations waiting to be dequeued */
+	struct sw_regex_scratch *scratch;
+	int socket_id;
+	bool prefilter_simd;
+	/**< Skip blocks with vector instructions in the literal prefilter */
+	uint64_t nb_ops;
+	uint64_t nb_matches;
+	uint64_t nb_prefiltered;
+	/**< Group scans skipped by the literal prefilter */
+	uint64_t nb_nfa_bytes;
+	/**< Bytes scanned in NFA fallback mode */
+};
+
+struct sw_regex_priv {
+	uint32_t dfa_max_states;
+	bool prefilter_simd;
+	uint16_t nb_qps;
+	uint16_t nb_max_matches;
+	uint16_t nb_groups;
+	uint32_t nb_rules_per_group;
+	uint32_t nb_rules;
+	struct sw_regex_src_rule *rules;
+	/**< Rules added by update or import, compiled on activation */
+	uint32_t *group_nb_rules;
+	/**< Number of rules of each group */
+	struct sw_regex_db *db;
+	/**< Active rule database */
+	struct sw_regex_qp *qps[SW_REGEX_MAX_QPS];
+};
+
+/** Start a new step of NFA simulation, clearing the visited marks */
+static inline void
+sw_regex_next_gen(struct sw_regex_scratch *scr)
+{
+	if (unlikely(++scr->gen == 0)) {
+		memset(scr->mark, 0, scr->nb_nfa * sizeof(scr->mark[0]));
+		scr->gen = 1;
+	}
+}
+
+static inline void
+sw_regex_push(struct sw_regex_scratch *scr, uint32_t *n, uint32_t s)
+{
+	if (s != SW_REGEX_NONE && scr->mark[s] != scr->gen) {
+		scr->mark[s] = scr->gen;
+		scr->stack[(*n)++] = s;
+	}
+}
+
+/**
+ * Add to set the states reachable from s without consuming input.
+ * Only the states consuming input and the match states are kept in sets.
+ */
+static inline void
+sw_regex_closure(const struct sw_regex_nfa_state *nfa,
+		struct sw_regex_scratch *scr, uint64_t *set, uint32_t s)
+{
+	uint32_t n = 0;
+
+	sw_regex_push(scr, &n, s);
+	while (n != 0) {
+		s = scr->stack[--n];
+		switch (nfa[s].type) {
+		case SW_NFA_CLASS:
+		case SW_NFA_MATCH:
+			set[s >> 6] |= UINT64_C(1) << (s & 63);
+			break;
+		case SW_NFA_SPLIT:
+			sw_regex_push(scr, &n, nfa[s].out1);
+			/* fallthrough */
+		case SW_NFA_EPS:
+			sw_regex_push(scr, &n, nfa[s].out);
+			break;
+		}
+	}
+}
+
+/**
+ * Compute in next the states reached from cur by consuming c.
+ * Only the set words from lo to hi are considered.
+ * Return true if next is not empty.
+ */
+static inline bool
+sw_regex_step(const struct sw_regex_group *g, struct sw_regex_scratch *scr,
+		const uint64_t *cur, uint64_t *next, uint32_t lo, uint32_t hi,
+		uint8_t c)
+{
+	const struct sw_regex_nfa_state *ns;
+	uint64_t bits, any;
+	uint32_t p, w;
+
+	sw_regex_next_gen(scr);
+	memset(next + lo, 0, (hi - lo) * sizeof(next[0]));
+
+	for (w = lo; w != hi; w++) {
+		bits = cur[w];
+		while (bits != 0) {
+			p = w * 64 + rte_ctz64(bits);
+			bits &= bits - 1;
+			ns = &g->nfa[p];
+			if (ns->type == SW_NFA_CLASS &&
+					sw_regex_cls_test(&g->cls[ns->out1], c))
+				sw_regex_closure(g->nfa, scr, next, ns->out);
+		}
+	}
+
+	any = 0;
+	for (w = lo; w != hi; w++)
+		any |= next[w];
+	return any != 0;
+}
+
+static inline bool
+sw_regex_set_test(const uint64_t *set, uint32_t s)
+{
+	return (set[s >> 6] >> (s & 63)) & 1;
+}
+
+/* sw_regex_compile.c */
+int sw_regex_db_compile(const struct sw_regex_src_rule *rules,
+		uint32_t nb_rules, uint16_t nb_groups, uint32_t dfa_max_states,
+		struct sw_regex_db **db);
+void sw_regex_db_free(struct sw_regex_db *db);
+int sw_regex_rule_check(const char *pattern, uint16_t len, uint64_t flags);
+uint32_t sw_regex_dfa_lookup(const struct sw_regex_group *g,
+		const uint64_t *set);
+
+/* sw_regex_scan.c */
+struct sw_regex_scratch *sw_regex_scratch_alloc(uint32_t nb_nfa, int socket);
+void sw_regex_scan(const struct sw_regex_db *db, struct sw_regex_qp *qp,
+		struct rte_regex_ops *op, uint16_t max_matches);
+
+#endif /* _SW_REGEX_H_ */
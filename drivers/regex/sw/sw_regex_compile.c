@@ -0,0 +1,1303 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_malloc.h>
+
+#include "sw_regex.h"
+
+/*
+ * Rules are parsed into an abstract syntax tree, from which a Thompson NFA
+ * is built for each rule, and a reversed NFA used to find where matches
+ * start. The NFA of all rules of a group are then converted by subset
+ * construction into a DFA over byte equivalence classes. When the DFA
+ * grows over the configured number of states, the remaining states are
+ * kept as NFA state sets, from which the scanner simulates the NFA.
+ */
+
+#define AST_MAX_DEPTH		64
+/**< Deepest nesting of groups in a rule */
+#define AST_REPEAT_INF		UINT16_MAX
+#define LIT_MAX_CLS_BYTES	16
+/**< Largest byte class kept in a literal factor */
+#define DFA_MAX_SETS_SIZE	(64 << 20)
+/**< Largest memory for the NFA state sets of the DFA of a group */
+
+enum ast_type {
+	AST_EMPTY,
+	AST_CLASS,	/**< a is a class index */
+	AST_CAT,	/**< nb children from kids[a] */
+	AST_ALT,	/**< nb children from kids[a] */
+	AST_REPEAT,	/**< child a repeated from min to max times */
+};
+
+struct ast_node {
+	uint32_t type;
+	uint32_t a;
+	uint32_t nb;
+	uint16_t min;
+	uint16_t max;
+};
+
+/** Dynamic array of node indexes */
+struct ast_list {
+	uint32_t *v;
+	uint32_t n;
+	uint32_t sz;
+};
+
+/** Literal factor of a rule, as a sequence of byte classes */
+struct lit {
+	uint32_t len;
+	uint32_t cls[SW_REGEX_LIT_MAX_LEN];
+};
+
+struct compiler {
+	/* NFA of the group being compiled */
+	struct sw_regex_nfa_state *nfa;
+	uint32_t nb_nfa;
+	uint32_t sz_nfa;
+	struct sw_regex_cls *cls;
+	uint32_t nb_cls;
+	uint32_t sz_cls;
+	/* syntax tree of the rule being compiled */
+	struct ast_node *ast;
+	uint32_t nb_ast;
+	uint32_t sz_ast;
+	uint32_t *kids;
+	uint32_t nb_kids;
+	uint32_t sz_kids;
+	/* parser state */
+	const char *p;
+	const char *end;
+	uint64_t flags;
+	uint32_t depth;
+};
+
+static int
+grow(void **arr, uint32_t *sz, uint32_t need, size_t elt)
+{
+	uint32_t nsz;
+	void *p;
+
+	if (need <= *sz)
+		return 0;
+	nsz = RTE_MAX(need, RTE_MAX(*sz * 2, 16u));
+	p = realloc(*arr, (size_t)nsz * elt);
+	if (p == NULL)
+		return -ENOMEM;
+	*arr = p;
+	*sz = nsz;
+	return 0;
+}
+
+static int
+list_push(struct ast_list *l, uint32_t v)
+{
+	if (grow((void **)&l->v, &l->sz, l->n + 1, sizeof(l->v[0])) != 0)
+		return -ENOMEM;
+	l->v[l->n++] = v;
+	return 0;
+}
+
+/*
+ * Byte classes.
+ */
+
+static void
+cls_set(struct sw_regex_cls *cls, uint8_t c)
+{
+	cls->bits[c >> 6] |= UINT64_C(1) << (c & 63);
+}
+
+static void
+cls_range(struct sw_regex_cls *cls, uint8_t lo, uint8_t hi)
+{
+	uint32_t c;
+
+	for (c = lo; c <= hi; c++)
+		cls_set(cls, c);
+}
+
+static void
+cls_or(struct sw_regex_cls *cls, const struct sw_regex_cls *other)
+{
+	uint32_t i;
+
+	for (i = 0; i != RTE_DIM(cls->bits); i++)
+		cls->bits[i] |= other->bits[i];
+}
+
+static void
+cls_invert(struct sw_regex_cls *cls)
+{
+	uint32_t i;
+
+	for (i = 0; i != RTE_DIM(cls->bits); i++)
+		cls->bits[i] = ~cls->bits[i];
+}
+
+static uint32_t
+cls_count(const struct sw_regex_cls *cls)
+{
+	uint32_t i, n;
+
+	n = 0;
+	for (i = 0; i != RTE_DIM(cls->bits); i++)
+		n += rte_popcount64(cls->bits[i]);
+	return n;
+}
+
+/* add the other case of the ASCII letters of the class */
+static void
+cls_fold(struct sw_regex_cls *cls)
+{
+	uint32_t c;
+
+	for (c = 'a'; c <= 'z'; c++) {
+		if (sw_regex_cls_test(cls, c) ||
+				sw_regex_cls_test(cls, c - 'a' + 'A')) {
+			cls_set(cls, c);
+			cls_set(cls, c - 'a' + 'A');
+		}
+	}
+}
+
+static int
+cls_new(struct compiler *c, const struct sw_regex_cls *cls)
+{
+	if (grow((void **)&c->cls, &c->sz_cls, c->nb_cls + 1,
+			sizeof(c->cls[0])) != 0)
+		return -ENOMEM;
+	c->cls[c->nb_cls] = *cls;
+	return c->nb_cls++;
+}
+
+/*
+ * Parser.
+ */
+
+static int
+ast_new(struct compiler *c, uint32_t type, uint32_t a, uint32_t nb)
+{
+	struct ast_node *n;
+
+	if (grow((void **)&c->ast, &c->sz_ast, c->nb_ast + 1,
+			sizeof(c->ast[0])) != 0)
+		return -ENOMEM;
+	n = &c->ast[c->nb_ast];
+	n->type = type;
+	n->a = a;
+	n->nb = nb;
+	n->min = 0;
+	n->max = 0;
+	return c->nb_ast++;
+}
+
+/* make a node with the children of the list, or the only child */
+static int
+ast_new_list(struct compiler *c, uint32_t type, const struct ast_list *l)
+{
+	if (l->n == 0)
+		return ast_new(c, AST_EMPTY, 0, 0);
+	if (l->n == 1)
+		return l->v[0];
+	if (grow((void **)&c->kids, &c->sz_kids, c->nb_kids + l->n,
+			sizeof(c->kids[0])) != 0)
+		return -ENOMEM;
+	memcpy(c->kids + c->nb_kids, l->v, l->n * sizeof(l->v[0]));
+	c->nb_kids += l->n;
+	return ast_new(c, type, c->nb_kids - l->n, l->n);
+}
+
+static int
+hex_val(char ch)
+{
+	if (ch >= '0' && ch <= '9')
+		return ch - '0';
+	if (ch >= 'a' && ch <= 'f')
+		return ch - 'a' + 10;
+	if (ch >= 'A' && ch <= 'F')
+		return ch - 'A' + 10;
+	return -1;
+}
+
+#define ESC_CLASS	256
+
+/*
+ * Parse the escape sequence following a backslash.
+ * Return the escaped byte, or ESC_CLASS when the escape is a class
+ * of bytes, added to cls.
+ */
+static int
+parse_escape(struct compiler *c, struct sw_regex_cls *cls, bool in_class)
+{
+	struct sw_regex_cls tmp = { {0} };
+	bool neg = false;
+	int ch, v;
+
+	if (c->p == c->end)
+		return -EINVAL;
+	ch = (unsigned char)*c->p++;
+
+	switch (ch) {
+	case 'D':
+		neg = true;
+		/* fallthrough */
+	case 'd':
+		cls_range(&tmp, '0', '9');
+		break;
+	case 'W':
+		neg = true;
+		/* fallthrough */
+	case 'w':
+		cls_range(&tmp, '0', '9');
+		cls_range(&tmp, 'a', 'z');
+		cls_range(&tmp, 'A', 'Z');
+		cls_set(&tmp, '_');
+		break;
+	case 'S':
+		neg = true;
+		/* fallthrough */
+	case 's':
+		cls_range(&tmp, '\t', '\r');
+		cls_set(&tmp, ' ');
+		break;
+	case 'a':
+		return '\a';
+	case 'b':
+		/* word boundary out of classes */
+		return in_class ? '\b' : -ENOTSUP;
+	case 'e':
+		return 0x1b;
+	case 'f':
+		return '\f';
+	case 'n':
+		return '\n';
+	case 'r':
+		return '\r';
+	case 't':
+		return '\t';
+	case 'v':
+		return '\v';
+	case '0':
+		return 0;
+	case 'x':
+		if (c->p == c->end || hex_val(*c->p) < 0)
+			return -ENOTSUP;
+		v = hex_val(*c->p++);
+		if (c->p != c->end && hex_val(*c->p) >= 0)
+			v = v * 16 + hex_val(*c->p++);
+		return v;
+	default:
+		/* back references, assertions and other letter escapes */
+		if ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') ||
+				(ch >= '0' && ch <= '9'))
+			return -ENOTSUP;
+		return ch;
+	}
+
+	if (neg)
+		cls_invert(&tmp);
+	cls_or(cls, &tmp);
+	return ESC_CLASS;
+}
+
+/* parse a bracket expression, the opening bracket being consumed */
+static int
+parse_bracket(struct compiler *c, struct sw_regex_cls *cls)
+{
+	bool neg, first;
+	int lo, hi;
+
+	neg = false;
+	if (c->p != c->end && *c->p == '^') {
+		neg = true;
+		c->p++;
+	}
+
+	for (first = true; c->p != c->end && (*c->p != ']' || first);
+			first = false) {
+		if (*c->p == '[' && c->p + 1 != c->end &&
+				(c->p[1] == ':' || c->p[1] == '.' ||
+				 c->p[1] == '='))
+			return -ENOTSUP;
+
+		if (*c->p == '\\') {
+			c->p++;
+			lo = parse_escape(c, cls, true);
+			if (lo < 0)
+				return lo;
+			if (lo == ESC_CLASS)
+				continue;
+		} else
+			lo = (unsigned char)*c->p++;
+
+		if (c->p + 1 < c->end && c->p[0] == '-' && c->p[1] != ']') {
+			c->p++;
+			if (*c->p == '\\') {
+				c->p++;
+				hi = parse_escape(c, cls, true);
+				if (hi < 0)
+					return hi;
+				if (hi == ESC_CLASS)
+					return -EINVAL;
+			} else
+				hi = (unsigned char)*c->p++;
+			if (hi < lo)
+				return -EINVAL;
+			cls_range(cls, lo, hi);
+		} else
+			cls_set(cls, lo);
+	}
+	if (c->p == c->end)
+		return -EINVAL;
+	c->p++;
+
+	if (c->flags & RTE_REGEX_PCRE_RULE_CASELESS_F)
+		cls_fold(cls);
+	if (neg)
+		cls_invert(cls);
+	return 0;
+}
+
+static int parse_alt(struct compiler *c);
+
+static int
+parse_atom(struct compiler *c)
+{
+	struct sw_regex_cls cls = { {0} };
+	int ch, rc;
+
+	ch = (unsigned char)*c->p++;
+	switch (ch) {
+	case '(':
+		if (c->p != c->end && *c->p == '?') {
+			/* only non capturing groups */
+			if (c->p + 1 == c->end || c->p[1] != ':')
+				return -ENOTSUP;
+			c->p += 2;
+		}
+		if (++c->depth > AST_MAX_DEPTH)
+			return -ENOSPC;
+		rc = parse_alt(c);
+		if (rc < 0)
+			return rc;
+		if (c->p == c->end || *c->p != ')')
+			return -EINVAL;
+		c->p++;
+		c->depth--;
+		return rc;
+	case '[':
+		rc = parse_bracket(c, &cls);
+		if (rc < 0)
+			return rc;
+		break;
+	case '.':
+		cls_range(&cls, 0, UINT8_MAX);
+		if (!(c->flags & RTE_REGEX_PCRE_RULE_DOTALL_F))
+			cls.bits['\n' >> 6] &= ~(UINT64_C(1) << ('\n' & 63));
+		break;
+	case '\\':
+		rc = parse_escape(c, &cls, false);
+		if (rc < 0)
+			return rc;
+		if (rc != ESC_CLASS)
+			cls_set(&cls, rc);
+		if (c->flags & RTE_REGEX_PCRE_RULE_CASELESS_F)
+			cls_fold(&cls);
+		break;
+	case '^':
+	case '$':
+		/* anchors are only supported at the start of rules */
+		return -ENOTSUP;
+	case '*':
+	case '+':
+	case '?':
+		/* nothing to repeat */
+		return -EINVAL;
+	default:
+		cls_set(&cls, ch);
+		if (c->flags & RTE_REGEX_PCRE_RULE_CASELESS_F)
+			cls_fold(&cls);
+		break;
+	}
+
+	rc = cls_new(c, &cls);
+	if (rc < 0)
+		return rc;
+	return ast_new(c, AST_CLASS, rc, 0);
+}
+
+/* parse a decimal number of a counted repetition */
+static int
+parse_count(struct compiler *c)
+{
+	int v;
+
+	if (c->p == c->end || *c->p < '0' || *c->p > '9')
+		return -1;
+	for (v = 0; c->p != c->end && *c->p >= '0' && *c->p <= '9'; c->p++) {
+		v = v * 10 + (*c->p - '0');
+		if (v > SW_REGEX_MAX_REPEAT)
+			return -ENOSPC;
+	}
+	return v;
+}
+
+/*
+ * Parse a {n}, {n,} or {n,m} counted repetition.
+ * Return 1 when parsed, 0 if the brace is a literal, or a negative errno.
+ */
+static int
+parse_braces(struct compiler *c, uint16_t *min, uint16_t *max)
+{
+	const char *save = c->p;
+	int lo, hi;
+
+	c->p++;
+	lo = parse_count(c);
+	if (lo == -ENOSPC)
+		return lo;
+	if (lo < 0)
+		goto literal;
+	hi = lo;
+	if (c->p != c->end && *c->p == ',') {
+		c->p++;
+		hi = AST_REPEAT_INF;
+		if (c->p != c->end && *c->p != '}') {
+			hi = parse_count(c);
+			if (hi == -ENOSPC)
+				return hi;
+			if (hi < 0)
+				goto literal;
+		}
+	}
+	if (c->p == c->end || *c->p != '}')
+		goto literal;
+	c->p++;
+	if (hi < lo)
+		return -EINVAL;
+	*min = lo;
+	*max = hi;
+	return 1;
+
+literal:
+	c->p = save;
+	return 0;
+}
+
+static int
+parse_repeat(struct compiler *c)
+{
+	uint16_t min, max;
+	int n, r, rc;
+
+	n = parse_atom(c);
+	if (n < 0)
+		return n;
+
+	if (c->p == c->end)
+		return n;
+
+	switch (*c->p) {
+	case '*':
+		min = 0;
+		max = AST_REPEAT_INF;
+		c->p++;
+		break;
+	case '+':
+		min = 1;
+		max = AST_REPEAT_INF;
+		c->p++;
+		break;
+	case '?':
+		min = 0;
+		max = 1;
+		c->p++;
+		break;
+	case '{':
+		rc = parse_braces(c, &min, &max);
+		if (rc <= 0)
+			return rc < 0 ? rc : n;
+		break;
+	default:
+		return n;
+	}
+
+	/* lazy quantifiers match the same ends, possessive ones do not */
+	if (c->p != c->end && *c->p == '?')
+		c->p++;
+	else if (c->p != c->end && *c->p == '+')
+		return -ENOTSUP;
+	if (c->p != c->end && (*c->p == '*' || *c->p == '+' || *c->p == '?'))
+		return -EINVAL;
+
+	r = ast_new(c, AST_REPEAT, n, 0);
+	if (r < 0)
+		return r;
+	c->ast[r].min = min;
+	c->ast[r].max = max;
+	return r;
+}
+
+static int
+parse_cat(struct compiler *c)
+{
+	struct ast_list l = { NULL, 0, 0 };
+	int n;
+
+	n = 0;
+	while (c->p != c->end && *c->p != '|' && *c->p != ')') {
+		n = parse_repeat(c);
+		if (n < 0)
+			break;
+		n = list_push(&l, n);
+		if (n < 0)
+			break;
+	}
+	if (n >= 0)
+		n = ast_new_list(c, AST_CAT, &l);
+	free(l.v);
+	return n;
+}
+
+static int
+parse_alt(struct compiler *c)
+{
+	struct ast_list l = { NULL, 0, 0 };
+	int n;
+
+	n = parse_cat(c);
+	if (n >= 0)
+		n = list_push(&l, n);
+	while (n >= 0 && c->p != c->end && *c->p == '|') {
+		c->p++;
+		n = parse_cat(c);
+		if (n >= 0)
+			n = list_push(&l, n);
+	}
+	if (n >= 0)
+		n = ast_new_list(c, AST_ALT, &l);
+	free(l.v);
+	return n;
+}
+
+/*
+ * Parse a rule into the syntax tree of the compiler.
+ * Return the root node, or a negative errno.
+ */
+static int
+parse_rule(struct compiler *c, const char *pattern, uint16_t len,
+		uint64_t flags, bool *anchored)
+{
+	int n;
+
+	c->nb_ast = 0;
+	c->nb_kids = 0;
+	c->p = pattern;
+	c->end = pattern + len;
+	c->flags = flags;
+	c->depth = 0;
+
+	*anchored = (flags & RTE_REGEX_PCRE_RULE_ANCHORED_F) != 0;
+	if (c->p != c->end && *c->p == '^') {
+		*anchored = true;
+		c->p++;
+	}
+
+	n = parse_alt(c);
+	if (n >= 0 && c->p != c->end)
+		/* unbalanced parenthesis */
+		n = -EINVAL;
+	return n;
+}
+
+static bool
+ast_nullable(const struct compiler *c, uint32_t node)
+{
+	const struct ast_node *n = &c->ast[node];
+	uint32_t i;
+
+	switch (n->type) {
+	case AST_EMPTY:
+		return true;
+	case AST_CLASS:
+		return false;
+	case AST_CAT:
+		for (i = 0; i != n->nb; i++)
+			if (!ast_nullable(c, c->kids[n->a + i]))
+				return false;
+		return true;
+	case AST_ALT:
+		for (i = 0; i != n->nb; i++)
+			if (ast_nullable(c, c->kids[n->a + i]))
+				return true;
+		return false;
+	default:
+		return n->min == 0 || ast_nullable(c, n->a);
+	}
+}
+
+static bool
+lit_cls_ok(const struct compiler *c, const struct ast_node *n)
+{
+	return n->type == AST_CLASS &&
+		cls_count(&c->cls[n->a]) <= LIT_MAX_CLS_BYTES;
+}
+
+static void
+lit_take(struct lit *best, const struct lit *run)
+{
+	if (run->len > best->len)
+		*best = *run;
+}
+
+/* find the longest sequence of narrow byte classes required by node */
+static void
+ast_factor(const struct compiler *c, uint32_t node, struct lit *best)
+{
+	const struct ast_node *n = &c->ast[node];
+	const struct ast_node *k;
+	struct lit run;
+	uint32_t i;
+
+	switch (n->type) {
+	case AST_CLASS:
+		if (lit_cls_ok(c, n)) {
+			run.len = 1;
+			run.cls[0] = n->a;
+			lit_take(best, &run);
+		}
+		break;
+	case AST_CAT:
+		run.len = 0;
+		for (i = 0; i != n->nb; i++) {
+			k = &c->ast[c->kids[n->a + i]];
+			if (lit_cls_ok(c, k)) {
+				if (run.len != SW_REGEX_LIT_MAX_LEN)
+					run.cls[run.len++] = k->a;
+				continue;
+			}
+			lit_take(best, &run);
+			run.len = 0;
+			ast_factor(c, c->kids[n->a + i], best);
+		}
+		lit_take(best, &run);
+		break;
+	case AST_REPEAT:
+		if (n->min != 0)
+			ast_factor(c, n->a, best);
+		break;
+	default:
+		/* alternatives have no single required factor */
+		break;
+	}
+}
+
+/*
+ * NFA construction.
+ */
+
+static int
+nfa_new(struct compiler *c, uint32_t type, uint32_t out, uint32_t out1)
+{
+	struct sw_regex_nfa_state *s;
+
+	if (c->nb_nfa == SW_REGEX_NFA_MAX_STATES)
+		return -ENOSPC;
+	if (grow((void **)&c->nfa, &c->sz_nfa, c->nb_nfa + 1,
+			sizeof(c->nfa[0])) != 0)
+		return -ENOMEM;
+	s = &c->nfa[c->nb_nfa];
+	s->type = type;
+	s->out = out;
+	s->out1 = out1;
+	return c->nb_nfa++;
+}
+
+/*
+ * Build the NFA of node, continuing to state next, and return its start.
+ * The reversed NFA matches the reversed strings.
+ */
+static int
+nfa_build(struct compiler *c, uint32_t node, uint32_t next, bool rev)
+{
+	const struct ast_node n = c->ast[node];
+	int cur, s, b;
+	uint32_t i;
+
+	switch (n.type) {
+	case AST_EMPTY:
+		return next;
+	case AST_CLASS:
+		return nfa_new(c, SW_NFA_CLASS, next, n.a);
+	case AST_CAT:
+		cur = next;
+		for (i = 0; i != n.nb && cur >= 0; i++)
+			cur = nfa_build(c,
+				c->kids[n.a + (rev ? i : n.nb - 1 - i)],
+				cur, rev);
+		return cur;
+	case AST_ALT:
+		cur = nfa_build(c, c->kids[n.a], next, rev);
+		for (i = 1; i != n.nb && cur >= 0; i++) {
+			b = nfa_build(c, c->kids[n.a + i], next, rev);
+			if (b < 0)
+				return b;
+			cur = nfa_new(c, SW_NFA_SPLIT, cur, b);
+		}
+		return cur;
+	default:
+		break;
+	}
+
+	/* repetition: optional copies, then the required ones */
+	cur = next;
+	if (n.max == AST_REPEAT_INF) {
+		s = nfa_new(c, SW_NFA_SPLIT, SW_REGEX_NONE, next);
+		if (s < 0)
+			return s;
+		b = nfa_build(c, n.a, s, rev);
+		if (b < 0)
+			return b;
+		c->nfa[s].out = b;
+		cur = s;
+	} else {
+		for (i = n.min; i != n.max && cur >= 0; i++) {
+			b = nfa_build(c, n.a, cur, rev);
+			if (b < 0)
+				return b;
+			cur = nfa_new(c, SW_NFA_SPLIT, b, next);
+		}
+	}
+	for (i = 0; i != n.min && cur >= 0; i++)
+		cur = nfa_build(c, n.a, cur, rev);
+	return cur;
+}
+
+static void
+compiler_free(struct compiler *c)
+{
+	free(c->nfa);
+	free(c->cls);
+	free(c->ast);
+	free(c->kids);
+	memset(c, 0, sizeof(*c));
+}
+
+int
+sw_regex_rule_check(const char *pattern, uint16_t len, uint64_t flags)
+{
+	struct compiler c;
+	bool anchored;
+	int rc;
+
+	if (flags & ~SW_REGEX_RULE_FLAGS)
+		return -ENOTSUP;
+
+	memset(&c, 0, sizeof(c));
+	rc = parse_rule(&c, pattern, len, flags, &anchored);
+	if (rc >= 0 && !(flags & RTE_REGEX_PCRE_RULE_ALLOW_EMPTY_F) &&
+			ast_nullable(&c, rc))
+		rc = -EINVAL;
+	compiler_free(&c);
+	return rc < 0 ? rc : 0;
+}
+
+/*
+ * DFA construction.
+ */
+
+static uint32_t
+set_hash(const uint64_t *set, uint32_t words)
+{
+	uint64_t h;
+	uint32_t i;
+
+	h = words;
+	for (i = 0; i != words; i++)
+		h = (h ^ set[i]) * UINT64_C(0x9e3779b97f4a7c15);
+	return h ^ (h >> 32);
+}
+
+uint32_t
+sw_regex_dfa_lookup(const struct sw_regex_group *g, const uint64_t *set)
+{
+	size_t sz = g->set_words * sizeof(set[0]);
+	uint32_t h, s;
+
+	for (h = set_hash(set, g->set_words) & g->hash_mask;
+			(s = g->hash[h]) != SW_REGEX_NONE;
+			h = (h + 1) & g->hash_mask) {
+		if (memcmp(g->sets + (size_t)s * g->set_words, set, sz) == 0)
+			return s;
+	}
+	return SW_REGEX_NONE;
+}
+
+/* add a state of NFA set, the set being known not to be in the DFA */
+static int
+dfa_add(struct sw_regex_group *g, uint32_t *sz_sets, const uint64_t *set)
+{
+	size_t words = g->set_words;
+	uint32_t h;
+
+	if (grow((void **)&g->sets, sz_sets, g->nb_dfa + 1,
+			words * sizeof(set[0])) != 0)
+		return -ENOMEM;
+	memcpy(g->sets + g->nb_dfa * words, set, words * sizeof(set[0]));
+
+	for (h = set_hash(set, words) & g->hash_mask;
+			g->hash[h] != SW_REGEX_NONE;
+			h = (h + 1) & g->hash_mask)
+		;
+	g->hash[h] = g->nb_dfa;
+	return g->nb_dfa++;
+}
+
+/* split the bytes into classes which no NFA state distinguishes */
+static void
+dfa_byte_classes(struct sw_regex_group *g)
+{
+	int16_t map[256][2];
+	uint8_t nbc[256];
+	uint32_t b, i, n, in;
+
+	memset(g->byte_cls, 0, sizeof(g->byte_cls));
+	g->nb_byte_cls = 1;
+
+	for (i = 0; i != g->nb_cls && g->nb_byte_cls != 256; i++) {
+		memset(map, -1, sizeof(map));
+		n = 0;
+		for (b = 0; b != 256; b++) {
+			in = sw_regex_cls_test(&g->cls[i], b);
+			if (map[g->byte_cls[b]][in] < 0)
+				map[g->byte_cls[b]][in] = n++;
+			nbc[b] = map[g->byte_cls[b]][in];
+		}
+		memcpy(g->byte_cls, nbc, sizeof(nbc));
+		g->nb_byte_cls = n;
+	}
+}
+
+static int
+dfa_build(struct sw_regex_group *g, struct sw_regex_scratch *scr,
+		const uint64_t *init, uint32_t max_states)
+{
+	uint32_t b, k, s, t, w, nbc, sz_sets, sz_trans, sz_acc, nb_acc;
+	uint8_t rep[256];
+	uint64_t *next, *set;
+	uint64_t bits, m;
+	int rc;
+
+	dfa_byte_classes(g);
+	nbc = g->nb_byte_cls;
+	for (b = 256; b-- != 0; )
+		rep[g->byte_cls[b]] = b;
+
+	/* bound the memory of the sets and the premultiplied transitions */
+	max_states = RTE_MIN(max_states,
+		DFA_MAX_SETS_SIZE / (g->set_words * sizeof(uint64_t)));
+	max_states = RTE_MAX(max_states, 1u);
+
+	g->hash_mask = rte_align32pow2(max_states * 2) - 1;
+	g->hash = malloc((g->hash_mask + 1) * sizeof(g->hash[0]));
+	if (g->hash == NULL)
+		return -ENOMEM;
+	memset(g->hash, 0xff, (g->hash_mask + 1) * sizeof(g->hash[0]));
+
+	sz_sets = 0;
+	sz_trans = 0;
+	rc = dfa_add(g, &sz_sets, init);
+	if (rc < 0)
+		return rc;
+
+	next = scr->next;
+	for (s = 0; s != g->nb_dfa; s++) {
+		/* leave room for all the states this one can reach */
+		if (g->nb_dfa + nbc > max_states)
+			break;
+		if (grow((void **)&g->trans, &sz_trans, (s + 1) * nbc,
+				sizeof(g->trans[0])) != 0)
+			return -ENOMEM;
+		for (k = 0; k != nbc; k++) {
+			sw_regex_step(g, scr, g->sets + (size_t)s * g->set_words,
+				next, 0, g->set_words, rep[k]);
+			for (w = 0; w != g->set_words; w++)
+				next[w] |= g->init_unanch[w];
+			t = sw_regex_dfa_lookup(g, next);
+			if (t == SW_REGEX_NONE) {
+				rc = dfa_add(g, &sz_sets, next);
+				if (rc < 0)
+					return rc;
+				t = rc;
+			}
+			g->trans[s * nbc + k] = t;
+		}
+		g->nb_expanded = s + 1;
+	}
+
+	/* rules matched in each state, dead state */
+	g->acc_ofs = malloc((g->nb_dfa + 1) * sizeof(g->acc_ofs[0]));
+	if (g->acc_ofs == NULL)
+		return -ENOMEM;
+	sz_acc = 0;
+	nb_acc = 0;
+	g->dead = SW_REGEX_NONE;
+	for (s = 0; s != g->nb_dfa; s++) {
+		g->acc_ofs[s] = nb_acc;
+		set = g->sets + (size_t)s * g->set_words;
+		bits = 0;
+		for (w = 0; w != g->set_words; w++) {
+			bits |= set[w];
+			for (m = set[w]; m != 0; m &= m - 1) {
+				t = w * 64 + rte_ctz64(m);
+				if (g->nfa[t].type != SW_NFA_MATCH)
+					continue;
+				if (grow((void **)&g->acc, &sz_acc, nb_acc + 1,
+						sizeof(g->acc[0])) != 0)
+					return -ENOMEM;
+				g->acc[nb_acc++] = g->nfa[t].out1;
+			}
+		}
+		if (bits == 0)
+			g->dead = s;
+	}
+	g->acc_ofs[g->nb_dfa] = nb_acc;
+
+	/* premultiply targets, flag the ones needing attention */
+	for (k = 0; k != g->nb_expanded * nbc; k++) {
+		t = g->trans[k];
+		g->trans[k] = t * nbc;
+		if (t >= g->nb_expanded || t == g->dead ||
+				g->acc_ofs[t] != g->acc_ofs[t + 1])
+			g->trans[k] |= SW_REGEX_DFA_SPECIAL;
+	}
+	return 0;
+}
+
+/*
+ * Literal prefilter.
+ */
+
+static void
+prefilter_build(struct sw_regex_group *g, const struct lit *lits)
+{
+	struct sw_regex_prefilter *pf = &g->pf;
+	uint32_t b, i, j, len, max_len, ofs;
+	const struct sw_regex_cls *cls;
+
+	memset(pf, 0, sizeof(*pf));
+
+	/* every rule needs a literal, all of them fit in the state */
+	max_len = RTE_MIN(64 / g->nb_rules, (uint32_t)SW_REGEX_LIT_MAX_LEN);
+	if (max_len < 2)
+		return;
+	for (i = 0; i != g->nb_rules; i++)
+		if (lits[i].len < 2)
+			return;
+
+	ofs = 0;
+	for (i = 0; i != g->nb_rules; i++) {
+		len = RTE_MIN(lits[i].len, max_len);
+		pf->start |= UINT64_C(1) << ofs;
+		pf->end |= UINT64_C(1) << (ofs + len - 1);
+		for (j = 0; j != len; j++) {
+			cls = &g->cls[lits[i].cls[j]];
+			for (b = 0; b != 256; b++) {
+				if (!sw_regex_cls_test(cls, b))
+					continue;
+				pf->mask[b] |= UINT64_C(1) << (ofs + j);
+				if (j != 0)
+					continue;
+				pf->nib_lo[b & 0xf] |=
+					1 << (i % SW_REGEX_TEDDY_BUCKETS);
+				pf->nib_hi[b >> 4] |=
+					1 << (i % SW_REGEX_TEDDY_BUCKETS);
+			}
+		}
+		ofs += len;
+	}
+	pf->enabled = true;
+}
+
+/*
+ * Group and database compilation.
+ */
+
+static void
+group_free(struct sw_regex_group *g)
+{
+	if (g == NULL)
+		return;
+	rte_free(g->rules);
+	rte_free(g->nfa);
+	rte_free(g->cls);
+	rte_free(g->init_unanch);
+	rte_free(g->trans);
+	rte_free(g->acc_ofs);
+	rte_free(g->acc);
+	rte_free(g->sets);
+	rte_free(g->hash);
+	rte_free(g);
+}
+
+/* free a group whose arrays are still in compile time memory */
+static void
+group_free_tmp(struct sw_regex_group *g)
+{
+	if (g == NULL)
+		return;
+	free(g->rules);
+	free(g->nfa);
+	free(g->cls);
+	free(g->init_unanch);
+	free(g->trans);
+	free(g->acc_ofs);
+	free(g->acc);
+	free(g->sets);
+	free(g->hash);
+	rte_free(g);
+}
+
+/* move a compile time array to DPDK memory */
+static int
+move_to_rte(void *pp, size_t size)
+{
+	void **p = pp;
+	void *r;
+
+	if (*p == NULL)
+		return 0;
+	r = rte_malloc(NULL, RTE_MAX(size, (size_t)1), RTE_CACHE_LINE_SIZE);
+	if (r != NULL)
+		memcpy(r, *p, size);
+	free(*p);
+	*p = r;
+	return r == NULL ? -ENOMEM : 0;
+}
+
+/* move all arrays of a compiled group to DPDK memory */
+static int
+group_move_to_rte(struct sw_regex_group *g)
+{
+	int rc;
+
+	rc = move_to_rte(&g->rules, g->nb_rules * sizeof(g->rules[0]));
+	rc |= move_to_rte(&g->nfa, g->nb_nfa * sizeof(g->nfa[0]));
+	rc |= move_to_rte(&g->cls, g->nb_cls * sizeof(g->cls[0]));
+	rc |= move_to_rte(&g->init_unanch, g->set_words * sizeof(uint64_t));
+	rc |= move_to_rte(&g->trans, (size_t)g->nb_expanded *
+		g->nb_byte_cls * sizeof(g->trans[0]));
+	rc |= move_to_rte(&g->acc, g->acc_ofs[g->nb_dfa] * sizeof(g->acc[0]));
+	rc |= move_to_rte(&g->acc_ofs,
+		(g->nb_dfa + 1) * sizeof(g->acc_ofs[0]));
+	rc |= move_to_rte(&g->sets, (size_t)g->nb_dfa * g->set_words *
+		sizeof(uint64_t));
+	rc |= move_to_rte(&g->hash, (g->hash_mask + 1) * sizeof(g->hash[0]));
+	return rc;
+}
+
+static int
+group_compile(const struct sw_regex_src_rule *rules, uint32_t nb_rules,
+		uint16_t group_id, uint32_t dfa_max_states,
+		struct sw_regex_group **pg)
+{
+	const struct sw_regex_src_rule *sr;
+	struct sw_regex_scratch *scr;
+	struct sw_regex_group *g;
+	struct compiler c;
+	struct lit *lits;
+	uint32_t *starts;
+	uint64_t *init;
+	uint32_t i, j, w, nb_fwd;
+	bool anchored;
+	int rc, n;
+
+	memset(&c, 0, sizeof(c));
+	scr = NULL;
+	init = NULL;
+	lits = NULL;
+	starts = NULL;
+
+	g = rte_zmalloc(NULL, sizeof(*g), RTE_CACHE_LINE_SIZE);
+	if (g == NULL)
+		return -ENOMEM;
+	g->group_id = group_id;
+	lits = calloc(nb_rules, sizeof(lits[0]));
+	starts = calloc(nb_rules, sizeof(starts[0]));
+	g->rules = calloc(nb_rules, sizeof(g->rules[0]));
+	if (lits == NULL || starts == NULL || g->rules == NULL) {
+		rc = -ENOMEM;
+		goto out;
+	}
+
+	/* forward NFA of all rules */
+	for (i = 0, j = 0; i != nb_rules; i++) {
+		sr = &rules[i];
+		if (sr->group_id != group_id)
+			continue;
+		rc = parse_rule(&c, sr->pattern, sr->len, sr->flags,
+			&anchored);
+		if (rc >= 0 && !(sr->flags & RTE_REGEX_PCRE_RULE_ALLOW_EMPTY_F)
+				&& ast_nullable(&c, rc))
+			rc = -EINVAL;
+		if (rc < 0) {
+			SW_REGEX_LOG(ERR, "cannot compile rule %u of group %u",
+				sr->rule_id, group_id);
+			goto out;
+		}
+		n = rc;
+		ast_factor(&c, n, &lits[j]);
+		rc = nfa_new(&c, SW_NFA_MATCH, SW_REGEX_NONE, j);
+		if (rc >= 0)
+			rc = nfa_build(&c, n, rc, false);
+		if (rc < 0)
+			goto out;
+		starts[j] = rc;
+		g->rules[j].rule_id = sr->rule_id;
+		g->rules[j].anchored = anchored;
+		j++;
+	}
+	g->nb_rules = j;
+	nb_fwd = c.nb_nfa;
+
+	/* reversed NFA of each rule, contiguous for each rule */
+	for (i = 0, j = 0; i != nb_rules; i++) {
+		sr = &rules[i];
+		if (sr->group_id != group_id)
+			continue;
+		rc = parse_rule(&c, sr->pattern, sr->len, sr->flags,
+			&anchored);
+		if (rc < 0)
+			goto out;
+		n = rc;
+		rc = nfa_new(&c, SW_NFA_MATCH, SW_REGEX_NONE, j);
+		if (rc < 0)
+			goto out;
+		g->rules[j].rev_match = rc;
+		rc = nfa_build(&c, n, rc, true);
+		if (rc < 0)
+			goto out;
+		g->rules[j].rev_start = rc;
+		g->rules[j].rev_lo = g->rules[j].rev_match / 64;
+		g->rules[j].rev_hi = (c.nb_nfa + 63) / 64;
+		j++;
+	}
+
+	/* the NFA is complete, it now belongs to the group */
+	g->nfa = c.nfa;
+	g->nb_nfa = c.nb_nfa;
+	g->cls = c.cls;
+	g->nb_cls = c.nb_cls;
+	c.nfa = NULL;
+	c.cls = NULL;
+	g->set_words = (nb_fwd + 63) / 64;
+
+	scr = sw_regex_scratch_alloc(g->nb_nfa, SOCKET_ID_ANY);
+	g->init_unanch = calloc(g->set_words, sizeof(uint64_t));
+	init = calloc(g->set_words, sizeof(uint64_t));
+	if (scr == NULL || g->init_unanch == NULL || init == NULL) {
+		rc = -ENOMEM;
+		goto out;
+	}
+
+	/* states active at each position, and at the payload start */
+	sw_regex_next_gen(scr);
+	for (j = 0; j != g->nb_rules; j++)
+		if (!g->rules[j].anchored)
+			sw_regex_closure(g->nfa, scr, g->init_unanch,
+				starts[j]);
+	sw_regex_next_gen(scr);
+	for (j = 0; j != g->nb_rules; j++)
+		sw_regex_closure(g->nfa, scr, init, starts[j]);
+	for (w = 0; w != g->set_words; w++)
+		init[w] |= g->init_unanch[w];
+
+	rc = dfa_build(g, scr, init, dfa_max_states);
+	if (rc < 0)
+		goto out;
+	prefilter_build(g, lits);
+
+	SW_REGEX_LOG(DEBUG,
+		"group %u: %u rules, %u NFA states, %u/%u DFA states expanded, "
+		"%u byte classes, prefilter %s",
+		group_id, g->nb_rules, g->nb_nfa, g->nb_expanded, g->nb_dfa,
+		g->nb_byte_cls, g->pf.enabled ? "on" : "off");
+
+	rc = group_move_to_rte(g);
+	if (rc != 0) {
+		group_free(g);
+		rc = -ENOMEM;
+	} else
+		*pg = g;
+	g = NULL;
+out:
+	group_free_tmp(g);
+	rte_free(scr);
+	free(init);
+	free(starts);
+	free(lits);
+	compiler_free(&c);
+	return rc;
+}
+
+void
+sw_regex_db_free(struct sw_regex_db *db)
+{
+	uint32_t i;
+
+	if (db == NULL)
+		return;
+	for (i = 0; i != db->nb_groups; i++)
+		group_free(db->groups[i]);
+	rte_free(db->groups);
+	rte_free(db);
+}
+
+int
+sw_regex_db_compile(const struct sw_regex_src_rule *rules, uint32_t nb_rules,
+		uint16_t nb_groups, uint32_t dfa_max_states,
+		struct sw_regex_db **pdb)
+{
+	struct sw_regex_db *db;
+	uint32_t i;
+	int rc;
+
+	db = rte_zmalloc(NULL, sizeof(*db), 0);
+	if (db == NULL)
+		return -ENOMEM;
+	db->nb_groups = nb_groups;
+	db->groups = rte_zmalloc(NULL, nb_groups * sizeof(db->groups[0]), 0);
+	if (db->groups == NULL) {
+		rte_free(db);
+		return -ENOMEM;
+	}
+
+	for (i = 0; i != nb_rules; i++) {
+		if (rules[i].group_id >= nb_groups) {
+			rc = -EINVAL;
+			goto error;
+		}
+		if (db->groups[rules[i].group_id] != NULL)
+			continue;
+		rc = group_compile(rules, nb_rules, rules[i].group_id,
+			dfa_max_states, &db->groups[rules[i].group_id]);
+		if (rc < 0)
+			goto error;
+		db->max_nfa = RTE_MAX(db->max_nfa,
+			db->groups[rules[i].group_id]->nb_nfa);
+	}
+
+	*pdb = db;
+	return 0;
+error:
+	sw_regex_db_free(db);
+	return rc;
+}
@@ -0,0 +1,371 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#ifdef RTE_ARCH_X86
+#include <rte_vect.h>
+#endif
+
+#include "sw_regex.h"
+
+/** State of the scan of a payload by a group */
+struct scan_ctx {
+	const struct sw_regex_group *g;
+	struct sw_regex_scratch *scr;
+	struct rte_regex_ops *op;
+	uint16_t max_matches;
+	bool stop_on_match;
+	bool stop;
+	uint64_t nb_nfa_bytes;
+};
+
+struct sw_regex_scratch *
+sw_regex_scratch_alloc(uint32_t nb_nfa, int socket)
+{
+	struct sw_regex_scratch *scr;
+	uint32_t words;
+	uint8_t *p;
+
+	words = RTE_MAX((nb_nfa + 63) / 64, 1u);
+	nb_nfa = words * 64;
+
+	scr = rte_zmalloc_socket(NULL, sizeof(*scr) +
+		4 * words * sizeof(uint64_t) + 2 * nb_nfa * sizeof(uint32_t),
+		RTE_CACHE_LINE_SIZE, socket);
+	if (scr == NULL)
+		return NULL;
+
+	p = (uint8_t *)(scr + 1);
+	scr->cur = (uint64_t *)p;
+	scr->next = scr->cur + words;
+	scr->rcur = scr->next + words;
+	scr->rnext = scr->rcur + words;
+	scr->mark = (uint32_t *)(scr->rnext + words);
+	scr->stack = scr->mark + nb_nfa;
+	scr->nb_nfa = nb_nfa;
+	return scr;
+}
+
+/*
+ * Find where the match of a rule ending at end starts, running the
+ * reversed rule backward from end. The longest reversed match gives the
+ * leftmost start.
+ */
+static uint32_t
+match_start(struct scan_ctx *ctx, uint32_t rule, uint32_t end)
+{
+	const struct sw_regex_group *g = ctx->g;
+	const struct sw_regex_rule *r = &g->rules[rule];
+	struct sw_regex_scratch *scr = ctx->scr;
+	const struct sw_regex_seg *seg;
+	uint64_t *cur, *next, *tmp;
+	uint32_t k, pos, start;
+
+	if (r->anchored)
+		return 0;
+
+	cur = scr->rcur;
+	next = scr->rnext;
+	memset(cur + r->rev_lo, 0, (r->rev_hi - r->rev_lo) * sizeof(cur[0]));
+	sw_regex_next_gen(scr);
+	sw_regex_closure(g->nfa, scr, cur, r->rev_start);
+
+	start = end;
+	k = scr->nb_segs - 1;
+	for (pos = end; pos != 0; ) {
+		pos--;
+		while (scr->segs[k].ofs > pos)
+			k--;
+		seg = &scr->segs[k];
+		if (!sw_regex_step(g, scr, cur, next, r->rev_lo, r->rev_hi,
+				seg->data[pos - seg->ofs]))
+			break;
+		if (sw_regex_set_test(next, r->rev_match))
+			start = pos;
+		tmp = cur;
+		cur = next;
+		next = tmp;
+	}
+	return start;
+}
+
+static void
+match_add(struct scan_ctx *ctx, uint32_t rule, uint32_t end)
+{
+	struct rte_regex_ops *op = ctx->op;
+	struct rte_regexdev_match *m;
+	uint32_t start;
+
+	if (op->nb_actual_matches != UINT16_MAX)
+		op->nb_actual_matches++;
+	if (op->nb_matches == ctx->max_matches) {
+		op->rsp_flags |= RTE_REGEX_OPS_RSP_MAX_MATCH_F;
+	} else {
+		start = match_start(ctx, rule, end);
+		m = &op->matches[op->nb_matches++];
+		m->u64 = 0;
+		m->rule_id = ctx->g->rules[rule].rule_id;
+		m->group_id = ctx->g->group_id;
+		m->start_offset = start;
+		m->len = end - start;
+	}
+	if (ctx->stop_on_match)
+		ctx->stop = true;
+}
+
+/* report the rules matched by a DFA state */
+static void
+match_dfa(struct scan_ctx *ctx, uint32_t s, uint32_t end)
+{
+	const struct sw_regex_group *g = ctx->g;
+	uint32_t i;
+
+	for (i = g->acc_ofs[s]; i != g->acc_ofs[s + 1] && !ctx->stop; i++)
+		match_add(ctx, g->acc[i], end);
+}
+
+/* report the rules matched by a set of NFA states */
+static void
+match_nfa(struct scan_ctx *ctx, const uint64_t *set, uint32_t end)
+{
+	const struct sw_regex_group *g = ctx->g;
+	uint64_t bits;
+	uint32_t p, w;
+
+	for (w = 0; w != g->set_words; w++) {
+		for (bits = set[w]; bits != 0 && !ctx->stop; bits &= bits - 1) {
+			p = w * 64 + rte_ctz64(bits);
+			if (g->nfa[p].type == SW_NFA_MATCH)
+				match_add(ctx, g->nfa[p].out1, end);
+		}
+	}
+}
+
+/*
+ * Run the automaton of a group over the payload.
+ * The DFA is used as long as its states are expanded. From the other
+ * states, the NFA is simulated, until it reaches an expanded DFA state.
+ */
+static void
+scan_group(struct scan_ctx *ctx)
+{
+	const struct sw_regex_group *g = ctx->g;
+	struct sw_regex_scratch *scr = ctx->scr;
+	const uint32_t *trans = g->trans;
+	const uint8_t *bc = g->byte_cls;
+	const struct sw_regex_seg *seg;
+	const uint8_t *p;
+	uint64_t *cur, *next, *tmp;
+	uint32_t i, k, n, s, t, w, ps;
+	uint64_t any;
+	bool nfa;
+
+	cur = scr->cur;
+	next = scr->next;
+
+	ps = 0;
+	nfa = g->nb_expanded == 0;
+	if (nfa)
+		memcpy(cur, g->sets, g->set_words * sizeof(cur[0]));
+
+	for (k = 0; k != scr->nb_segs; k++) {
+		seg = &scr->segs[k];
+		p = seg->data;
+		n = seg->len;
+		i = 0;
+		while (i != n) {
+			if (!nfa) {
+				for (; i != n; i++) {
+					t = trans[ps + bc[p[i]]];
+					ps = t & ~SW_REGEX_DFA_SPECIAL;
+					if (unlikely(t & SW_REGEX_DFA_SPECIAL))
+						break;
+				}
+				if (i == n)
+					break;
+
+				i++;
+				s = ps / g->nb_byte_cls;
+				if (s == g->dead)
+					return;
+				match_dfa(ctx, s, seg->ofs + i);
+				if (ctx->stop)
+					return;
+				if (s >= g->nb_expanded) {
+					nfa = true;
+					memcpy(cur, g->sets +
+						(size_t)s * g->set_words,
+						g->set_words * sizeof(cur[0]));
+				}
+				continue;
+			}
+
+			ctx->nb_nfa_bytes++;
+			sw_regex_step(g, scr, cur, next, 0, g->set_words, p[i]);
+			any = 0;
+			for (w = 0; w != g->set_words; w++) {
+				next[w] |= g->init_unanch[w];
+				any |= next[w];
+			}
+			if (any == 0)
+				return;
+			i++;
+			match_nfa(ctx, next, seg->ofs + i);
+			if (ctx->stop)
+				return;
+
+			tmp = cur;
+			cur = next;
+			next = tmp;
+			s = sw_regex_dfa_lookup(g, cur);
+			if (s != SW_REGEX_NONE && s < g->nb_expanded) {
+				nfa = false;
+				ps = s * g->nb_byte_cls;
+			}
+		}
+	}
+}
+
+#ifdef RTE_ARCH_X86
+/*
+ * Check whether a literal may start in the 16 bytes of p: the buckets of
+ * the low and high nibbles of a byte intersect when the byte is the first
+ * of a literal, or with a false positive.
+ */
+static inline bool
+prefilter_block(const struct sw_regex_prefilter *pf, const uint8_t *p)
+{
+	const __m128i nib = _mm_set1_epi8(0x0f);
+	__m128i v, lo, hi;
+
+	v = _mm_loadu_si128((const __m128i *)p);
+	lo = _mm_shuffle_epi8(_mm_load_si128((const __m128i *)pf->nib_lo),
+		_mm_and_si128(v, nib));
+	hi = _mm_shuffle_epi8(_mm_load_si128((const __m128i *)pf->nib_hi),
+		_mm_and_si128(_mm_srli_epi16(v, 4), nib));
+	v = _mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128());
+	return _mm_movemask_epi8(v) != 0xffff;
+}
+#endif
+
+/*
+ * Search the literals of the prefilter in the payload, with a shift-and
+ * automaton carried across segments. On x86, unless simd is false,
+ * blocks where no literal starts are skipped while no literal
+ * is partially matched.
+ */
+static bool
+prefilter_match(const struct sw_regex_prefilter *pf,
+		const struct sw_regex_scratch *scr, bool simd)
+{
+	const uint8_t *p;
+	uint32_t i, k, n;
+	uint64_t d;
+#ifdef RTE_ARCH_X86
+	uint32_t e;
+#else
+	RTE_SET_USED(simd);
+#endif
+
+	d = 0;
+	for (k = 0; k != scr->nb_segs; k++) {
+		p = scr->segs[k].data;
+		n = scr->segs[k].len;
+		i = 0;
+#ifdef RTE_ARCH_X86
+		for (; simd && i + 16 <= n; ) {
+			if (d == 0 && !prefilter_block(pf, p + i)) {
+				i += 16;
+				continue;
+			}
+			for (e = i + 16; i != e; i++) {
+				d = ((d << 1) | pf->start) & pf->mask[p[i]];
+				if (d & pf->end)
+					return true;
+			}
+		}
+#endif
+		for (; i != n; i++) {
+			d = ((d << 1) | pf->start) & pf->mask[p[i]];
+			if (d & pf->end)
+				return true;
+		}
+	}
+	return false;
+}
+
+void
+sw_regex_scan(const struct sw_regex_db *db, struct sw_regex_qp *qp,
+		struct rte_regex_ops *op, uint16_t max_matches)
+{
+	struct sw_regex_scratch *scr = qp->scratch;
+	const struct sw_regex_group *g;
+	struct sw_regex_seg *seg;
+	struct scan_ctx ctx;
+	struct rte_mbuf *m;
+	uint16_t gid[4];
+	uint32_t k, len, ofs;
+
+	op->rsp_flags = 0;
+	op->nb_actual_matches = 0;
+	op->nb_matches = 0;
+
+	/* segments of the payload, within the limits of match offsets */
+	scr->nb_segs = 0;
+	ofs = 0;
+	for (m = op->mbuf; m != NULL; m = m->next) {
+		len = rte_pktmbuf_data_len(m);
+		if (len == 0)
+			continue;
+		if (scr->nb_segs == SW_REGEX_MAX_SEGS ||
+				ofs + len > SW_REGEX_MAX_PAYLOAD) {
+			op->rsp_flags |= RTE_REGEX_OPS_RSP_RESOURCE_LIMIT_REACHED_F;
+			if (scr->nb_segs == SW_REGEX_MAX_SEGS)
+				break;
+			len = SW_REGEX_MAX_PAYLOAD - ofs;
+		}
+		seg = &scr->segs[scr->nb_segs++];
+		seg->data = rte_pktmbuf_mtod(m, const uint8_t *);
+		seg->len = len;
+		seg->ofs = ofs;
+		ofs += len;
+		if (ofs == SW_REGEX_MAX_PAYLOAD)
+			break;
+	}
+	if (db == NULL || scr->nb_segs == 0)
+		return;
+
+	ctx.scr = scr;
+	ctx.op = op;
+	ctx.max_matches = max_matches;
+	ctx.stop_on_match = (op->req_flags & RTE_REGEX_OPS_REQ_STOP_ON_MATCH_F);
+	ctx.stop = false;
+	ctx.nb_nfa_bytes = 0;
+
+	gid[0] = op->group_id0;
+	gid[1] = op->group_id1;
+	gid[2] = op->group_id2;
+	gid[3] = op->group_id3;
+	for (k = 0; k != RTE_DIM(gid) && !ctx.stop; k++) {
+		if (!(op->req_flags & (RTE_REGEX_OPS_REQ_GROUP_ID0_VALID_F << k)))
+			continue;
+		if (gid[k] >= db->nb_groups || db->groups[gid[k]] == NULL)
+			continue;
+		g = db->groups[gid[k]];
+		if (g->pf.enabled && !prefilter_match(&g->pf, scr,
+				qp->prefilter_simd)) {
+			qp->nb_prefiltered++;
+			continue;
+		}
+		ctx.g = g;
+		scan_group(&ctx);
+	}
+
+	qp->nb_matches += op->nb_matches;
+	qp->nb_nfa_bytes += ctx.nb_nfa_bytes;
+}
@@ -481,6 +481,7 @@ parse_eth_dest(const char *optarg)
 
 #define MAX_JUMBO_PKT_LEN  9600
 #define MEMPOOL_CACHE_SIZE 256
+#define NB_FRAG_MBUF       8192
 
 static const char short_options[] = "p:" /* portmask */
 				    "P"	 /* promiscuous */
@@ -686,6 +687,42 @@ init_mem(uint16_t portid, uint32_t nb_mbuf)
 	return 0;
 }
 
+/* Pools of the fragments of the packets larger than the MTU of their Tx port */
+static void
+init_fragment(void)
+{
+	struct rte_node_ip4_fragment_cfg ip4_cfg;
+	struct rte_node_ip6_fragment_cfg ip6_cfg;
+	struct rte_mempool *direct, *indirect;
+	int socketid = 0;
+
+	if (numa_on)
+		socketid = rte_socket_id();
+
+	/* A fragment is a direct buffer with the headers and an indirect one with data */
+	direct = rte_pktmbuf_pool_create("frag_direct_pool", NB_FRAG_MBUF, MEMPOOL_CACHE_SIZE,
+					 0, RTE_MBUF_DEFAULT_BUF_SIZE, socketid);
+	indirect = rte_pktmbuf_pool_create("frag_indirect_pool", NB_FRAG_MBUF,
+					   MEMPOOL_CACHE_SIZE, 0, 0, socketid);
+	if (direct == NULL || indirect == NULL)
+		rte_exit(EXIT_FAILURE, "Cannot init fragment pools on socket %d\n", socketid);
+
+	/* No local address to send ICMP errors from, such packets are dropped */
+	memset(&ip4_cfg, 0, sizeof(ip4_cfg));
+	ip4_cfg.pool_direct = direct;
+	ip4_cfg.pool_indirect = indirect;
+	ip4_cfg.node_id = rte_node_from_name("ip4_fragment");
+
+	memset(&ip6_cfg, 0, sizeof(ip6_cfg));
+	ip6_cfg.pool_direct = direct;
+	ip6_cfg.pool_indirect = indirect;
+	ip6_cfg.node_id = rte_node_from_name("ip6_fragment");
+
+	if (rte_node_ip4_fragment_configure(&ip4_cfg, 1) < 0 ||
+	    rte_node_ip6_fragment_configure(&ip6_cfg, 1) < 0)
+		rte_exit(EXIT_FAILURE, "Cannot configure fragment nodes\n");
+}
+
 /* Check the link status of all ports in up to 9s, and print them finally */
 static void
 check_all_ports_link_status(uint32_t port_mask)
@@ -1258,6 +1295,9 @@ main(int argc, char **argv)
 	if (ret)
 		rte_exit(EXIT_FAILURE, "rte_node_eth_config: err=%d\n", ret);
 
+	/* Fragment nodes are configured before the graphs using them are created */
+	init_fragment();
+
 	/* Start ports */
 	RTE_ETH_FOREACH_DEV(portid)
 	{
@@ -53,6 +53,10 @@ rte_comp_get_feature_name(uint64_t flag)
 		return "LZ4_BLOCK_INDEPENDENCE";
 	case RTE_COMP_FF_LZ4_BLOCK_WITH_CHECKSUM:
 		return "LZ4_BLOCK_WITH_CHECKSUM";
+	case RTE_COMP_FF_ZSTD_DICTIONARY:
+		return "ZSTD_DICTIONARY";
+	case RTE_COMP_FF_LZ4_RAW_BLOCK:
+		return "LZ4_RAW_BLOCK";
 	default:
 		return NULL;
 	}
@@ -78,6 +78,10 @@ extern "C" {
 /**< LZ4 block independent is supported */
 #define RTE_COMP_FF_LZ4_BLOCK_WITH_CHECKSUM	(1ULL << 20)
 /**< LZ4 block with checksum is supported */
+#define RTE_COMP_FF_ZSTD_DICTIONARY		(1ULL << 21)
+/**< Zstandard dictionary is supported */
+#define RTE_COMP_FF_LZ4_RAW_BLOCK		(1ULL << 22)
+/**< LZ4 raw block format, without frame, is supported */
 
 /** Status of comp operation */
 enum rte_comp_op_status {
@@ -128,6 +132,10 @@ enum rte_comp_algorithm {
 	/**< LZ4 compression algorithm
 	 * https://github.com/lz4/lz4
 	 */
+	RTE_COMP_ALGO_ZSTD,
+	/**< Zstandard compression algorithm
+	 * https://tools.ietf.org/html/rfc8878
+	 */
 };
 
 /** Compression Hash Algorithms */
@@ -257,6 +265,16 @@ struct rte_comp_inflate_params {
  */
 #define RTE_COMP_LZ4_FLAG_DICT_ID (1 << 0)
 
+/**
+ * Raw block flag.
+ * If this flag is set, data is a single LZ4 block, without frame header,
+ * block size field or end mark, as produced by LZ4_compress_default().
+ * The frame flags must not be set together with this flag.
+ * This bit is reserved in the LZ4 frame descriptor,
+ * so it never appears in frame flags.
+ */
+#define RTE_COMP_LZ4_FLAG_RAW_BLOCK (1 << 1)
+
 /**
  * Content checksum flag
  * If this flag is set, a 32-bit content checksum
@@ -302,6 +320,29 @@ struct rte_comp_lz4_params {
 	 */
 };
 
+/**
+ * Content checksum flag.
+ * If this flag is set, a 32-bit xxHash64 based checksum of the
+ * uncompressed data is appended to each Zstandard frame,
+ * and verified on decompression.
+ */
+#define RTE_COMP_ZSTD_FLAG_CONTENT_CHECKSUM (1 << 0)
+
+/** Parameters specific to the Zstandard algorithm */
+struct rte_comp_zstd_params {
+	const uint8_t *dictionary;
+	/**< Pointer to memory containing the dictionary, or NULL.
+	 * Either a raw content dictionary or a dictionary trained by zstd.
+	 * The same dictionary must be used for compression and decompression.
+	 * The memory must remain valid until the private xform or stream
+	 * is freed.
+	 */
+	uint32_t dictionary_len;
+	/**< Length of the dictionary */
+	uint8_t flags;
+	/**< Compression Zstandard parameter flags */
+};
+
 /** Setup Data for compression */
 struct rte_comp_compress_xform {
 	enum rte_comp_algorithm algo;
@@ -311,6 +352,8 @@ struct rte_comp_compress_xform {
 		/**< Parameters specific to the deflate algorithm */
 		struct rte_comp_lz4_params lz4;
 		/**< Parameters specific to the LZ4 algorithm */
+		struct rte_comp_zstd_params zstd;
+		/**< Parameters specific to the Zstandard algorithm */
 	}; /**< Algorithm specific parameters */
 	int level;
 	/**< Compression level */
@@ -345,6 +388,8 @@ struct rte_comp_decompress_xform {
 		/**< Parameters specific to the deflate algorithm */
 		struct rte_comp_lz4_params lz4;
 		/**< Parameters specific to the LZ4 algorithm */
+		struct rte_comp_zstd_params zstd;
+		/**< Parameters specific to the Zstandard algorithm */
 	}; /**< Algorithm specific parameters */
 	enum rte_comp_hash_algorithm hash_algo;
 	/**< Hash algorithm to be used with decompress operation. Hash is always
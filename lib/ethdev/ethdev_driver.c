@@ -286,6 +286,7 @@ rte_eth_dev_release_port(struct rte_eth_dev *eth_dev)
 	eth_dev->rx_descriptor_status = NULL;
 	eth_dev->tx_descriptor_status = NULL;
 	eth_dev->dev_ops = NULL;
+	eth_dev_queue_poll_stats_free(eth_dev);
 
 	if (rte_eal_process_type() == RTE_PROC_PRIMARY) {
 		rte_free(eth_dev->data->rx_queues);
@@ -114,6 +114,13 @@ struct __rte_cache_aligned rte_eth_dev {
 
 	enum rte_eth_dev_state state; /**< Flag indicating the port state */
 	void *security_ctx; /**< Context for security ops */
+
+	/** Rx queues poll statistics, @see rte_eth_queue_poll_stats_enable() */
+	struct rte_eth_queue_poll_stats *rx_poll_stats;
+	/** Tx queues poll statistics, @see rte_eth_queue_poll_stats_enable() */
+	struct rte_eth_queue_poll_stats *tx_poll_stats;
+	uint16_t nb_rx_poll_stats; /**< Number of Rx queues with poll statistics */
+	uint16_t nb_tx_poll_stats; /**< Number of Tx queues with poll statistics */
 };
 
 struct rte_eth_dev_sriov;
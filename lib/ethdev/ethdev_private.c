@@ -4,6 +4,7 @@
 
 #include <eal_export.h>
 #include <rte_debug.h>
+#include <rte_malloc.h>
 
 #include "rte_ethdev.h"
 #include "rte_ethdev_trace_fp.h"
@@ -284,6 +285,14 @@ eth_dev_fp_ops_setup(struct rte_eth_fp_ops *fpo,
 
 	fpo->txq.data = dev->data->tx_queues;
 	fpo->txq.clbk = (void * __rte_atomic *)(uintptr_t)dev->pre_tx_burst_cbs;
+
+	/* Poll statistics are only exposed if they cover all queues. */
+	if (dev->rx_poll_stats != NULL &&
+			dev->nb_rx_poll_stats >= dev->data->nb_rx_queues)
+		fpo->rx_poll_stats = dev->rx_poll_stats;
+	if (dev->tx_poll_stats != NULL &&
+			dev->nb_tx_poll_stats >= dev->data->nb_tx_queues)
+		fpo->tx_poll_stats = dev->tx_poll_stats;
 }
 
 RTE_EXPORT_SYMBOL(rte_eth_call_rx_callbacks)
@@ -418,6 +427,17 @@ eth_dev_txq_release(struct rte_eth_dev *dev, uint16_t qid)
 	txq[qid] = NULL;
 }
 
+void
+eth_dev_queue_poll_stats_free(struct rte_eth_dev *dev)
+{
+	rte_free(dev->rx_poll_stats);
+	rte_free(dev->tx_poll_stats);
+	dev->rx_poll_stats = NULL;
+	dev->tx_poll_stats = NULL;
+	dev->nb_rx_poll_stats = 0;
+	dev->nb_tx_poll_stats = 0;
+}
+
 int
 eth_dev_rx_queue_config(struct rte_eth_dev *dev, uint16_t nb_queues)
 {
@@ -3379,6 +3379,136 @@ rte_eth_stats_reset(uint16_t port_id)
 	return 0;
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_queue_poll_stats_enable, 25.11)
+int
+rte_eth_queue_poll_stats_enable(uint16_t port_id)
+{
+#ifdef RTE_ETHDEV_QUEUE_POLL_STATS
+	struct rte_eth_queue_poll_stats *rxs, *txs;
+	struct rte_eth_dev *dev;
+	uint16_t nb_rxq, nb_txq;
+	int socket_id;
+
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(port_id, -ENODEV);
+	dev = &rte_eth_devices[port_id];
+
+	if (dev->data->dev_started != 0) {
+		RTE_ETHDEV_LOG_LINE(ERR,
+			"Cannot enable poll stats of started port %u", port_id);
+		return -EBUSY;
+	}
+
+	nb_rxq = dev->data->nb_rx_queues;
+	nb_txq = dev->data->nb_tx_queues;
+	if (nb_rxq == 0 && nb_txq == 0) {
+		RTE_ETHDEV_LOG_LINE(ERR,
+			"Cannot enable poll stats of unconfigured port %u", port_id);
+		return -EINVAL;
+	}
+
+	socket_id = dev->data->numa_node;
+	rxs = rte_zmalloc_socket("ethdev_rx_poll_stats",
+			sizeof(*rxs) * RTE_MAX(nb_rxq, 1), RTE_CACHE_LINE_SIZE,
+			socket_id);
+	txs = rte_zmalloc_socket("ethdev_tx_poll_stats",
+			sizeof(*txs) * RTE_MAX(nb_txq, 1), RTE_CACHE_LINE_SIZE,
+			socket_id);
+	if (rxs == NULL || txs == NULL) {
+		rte_free(rxs);
+		rte_free(txs);
+		return -ENOMEM;
+	}
+
+	/* Re-enabling re-sizes the counters after queue reconfiguration. */
+	eth_dev_queue_poll_stats_free(dev);
+	dev->rx_poll_stats = rxs;
+	dev->tx_poll_stats = txs;
+	dev->nb_rx_poll_stats = nb_rxq;
+	dev->nb_tx_poll_stats = nb_txq;
+
+	return 0;
+#else
+	RTE_SET_USED(port_id);
+	return -ENOTSUP;
+#endif
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_queue_poll_stats_disable, 25.11)
+int
+rte_eth_queue_poll_stats_disable(uint16_t port_id)
+{
+	struct rte_eth_dev *dev;
+
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(port_id, -ENODEV);
+	dev = &rte_eth_devices[port_id];
+
+	if (dev->data->dev_started != 0) {
+		RTE_ETHDEV_LOG_LINE(ERR,
+			"Cannot disable poll stats of started port %u", port_id);
+		return -EBUSY;
+	}
+
+	eth_dev_queue_poll_stats_free(dev);
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_queue_poll_stats_get, 25.11)
+int
+rte_eth_queue_poll_stats_get(uint16_t port_id, uint16_t queue_id,
+		bool is_rx, struct rte_eth_queue_poll_stats *stats)
+{
+	struct rte_eth_queue_poll_stats *qs;
+	struct rte_eth_dev *dev;
+	uint16_t nb_queues;
+
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(port_id, -ENODEV);
+	dev = &rte_eth_devices[port_id];
+
+	if (stats == NULL) {
+		RTE_ETHDEV_LOG_LINE(ERR,
+			"Cannot get ethdev port %u poll stats to NULL", port_id);
+		return -EINVAL;
+	}
+
+	qs = is_rx ? dev->rx_poll_stats : dev->tx_poll_stats;
+	nb_queues = is_rx ? dev->nb_rx_poll_stats : dev->nb_tx_poll_stats;
+	if (qs == NULL)
+		return -ENOENT;
+
+	if (queue_id >= nb_queues) {
+		RTE_ETHDEV_LOG_LINE(ERR, "Invalid %s queue_id=%u",
+			is_rx ? "Rx" : "Tx", queue_id);
+		return -EINVAL;
+	}
+
+	*stats = qs[queue_id];
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_queue_poll_stats_reset, 25.11)
+int
+rte_eth_queue_poll_stats_reset(uint16_t port_id)
+{
+	struct rte_eth_dev *dev;
+
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(port_id, -ENODEV);
+	dev = &rte_eth_devices[port_id];
+
+	if (dev->rx_poll_stats == NULL && dev->tx_poll_stats == NULL)
+		return -ENOENT;
+
+	if (dev->rx_poll_stats != NULL)
+		memset(dev->rx_poll_stats, 0,
+			sizeof(*dev->rx_poll_stats) * dev->nb_rx_poll_stats);
+	if (dev->tx_poll_stats != NULL)
+		memset(dev->tx_poll_stats, 0,
+			sizeof(*dev->tx_poll_stats) * dev->nb_tx_poll_stats);
+
+	return 0;
+}
+
 static inline int
 eth_dev_get_xstats_basic_count(struct rte_eth_dev *dev)
 {
@@ -166,6 +166,7 @@
 #include <rte_errno.h>
 #include <rte_common.h>
 #include <rte_config.h>
+#include <rte_cycles.h>
 #include <rte_power_intrinsics.h>
 
 #include "rte_ethdev_trace_fp.h"
@@ -6220,6 +6221,113 @@ int rte_eth_cman_config_set(uint16_t port_id, const struct rte_eth_cman_config *
 __rte_experimental
 int rte_eth_cman_config_get(uint16_t port_id, struct rte_eth_cman_config *config);
 
+/** Number of buckets in the queue poll burst size histogram. */
+#define RTE_ETH_QUEUE_POLL_HIST_SIZE 10
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this structure may change without prior notice.
+ *
+ * Per-queue poll efficiency counters, maintained by rte_eth_rx_burst()
+ * and rte_eth_tx_burst() when enabled with rte_eth_queue_poll_stats_enable().
+ *
+ * Bucket 0 of the burst histogram counts empty polls,
+ * bucket i (1 <= i < RTE_ETH_QUEUE_POLL_HIST_SIZE - 1) counts bursts
+ * of [2^(i-1), 2^i - 1] packets, and the last bucket counts all larger bursts.
+ */
+struct __rte_cache_aligned rte_eth_queue_poll_stats {
+	uint64_t polls; /**< Number of burst calls on the queue. */
+	uint64_t empty_polls; /**< Burst calls which returned no packet. */
+	uint64_t full_polls; /**< Burst calls which handled all requested packets. */
+	uint64_t pkts; /**< Packets received or sent by the driver. */
+	uint64_t partial_polls; /**< Tx bursts which did not send all packets. */
+	uint64_t unsent_pkts; /**< Packets left unsent by Tx bursts. */
+	uint64_t poll_cycles; /**< Sum of TSC cycles between consecutive polls. */
+	uint64_t last_poll_tsc; /**< TSC value at the last poll. */
+	/** Histogram of packets per burst. */
+	uint64_t burst_hist[RTE_ETH_QUEUE_POLL_HIST_SIZE];
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Enable per-queue poll statistics on all configured Rx and Tx queues of a port.
+ *
+ * The counters are only maintained if DPDK is built
+ * with RTE_ETHDEV_QUEUE_POLL_STATS defined.
+ * Each queue must be polled by a single lcore at a time.
+ * The port must be stopped, statistics are collected once it is started.
+ *
+ * @param port_id
+ *   The port identifier of the Ethernet device.
+ * @return
+ *   - (0) if successful.
+ *   - (-ENOTSUP) if the support was not built in.
+ *   - (-ENODEV) if *port_id* invalid.
+ *   - (-EBUSY) if the port is started.
+ *   - (-EINVAL) if the port is not configured.
+ *   - (-ENOMEM) if the counters cannot be allocated.
+ */
+__rte_experimental
+int rte_eth_queue_poll_stats_enable(uint16_t port_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Disable per-queue poll statistics of a port and release the counters.
+ *
+ * @param port_id
+ *   The port identifier of the Ethernet device.
+ * @return
+ *   - (0) if successful.
+ *   - (-ENODEV) if *port_id* invalid.
+ *   - (-EBUSY) if the port is started.
+ */
+__rte_experimental
+int rte_eth_queue_poll_stats_disable(uint16_t port_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Retrieve the poll statistics of an Rx or Tx queue.
+ *
+ * @param port_id
+ *   The port identifier of the Ethernet device.
+ * @param queue_id
+ *   The queue index.
+ * @param is_rx
+ *   True for an Rx queue, false for a Tx queue.
+ * @param stats
+ *   A pointer to a structure to be filled with the queue counters.
+ * @return
+ *   - (0) if successful.
+ *   - (-ENODEV) if *port_id* invalid.
+ *   - (-ENOENT) if poll statistics are not enabled on the port.
+ *   - (-EINVAL) if bad parameter.
+ */
+__rte_experimental
+int rte_eth_queue_poll_stats_get(uint16_t port_id, uint16_t queue_id,
+		bool is_rx, struct rte_eth_queue_poll_stats *stats);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Reset the poll statistics of all queues of a port.
+ *
+ * @param port_id
+ *   The port identifier of the Ethernet device.
+ * @return
+ *   - (0) if successful.
+ *   - (-ENODEV) if *port_id* invalid.
+ *   - (-ENOENT) if poll statistics are not enabled on the port.
+ */
+__rte_experimental
+int rte_eth_queue_poll_stats_reset(uint16_t port_id);
+
 #ifdef __cplusplus
 }
 #endif
@@ -6230,6 +6338,43 @@ int rte_eth_cman_config_get(uint16_t port_id, struct rte_eth_cman_config *config
 extern "C" {
 #endif
 
+#ifdef RTE_ETHDEV_QUEUE_POLL_STATS
+/**
+ * @internal
+ * Helper routine for rte_eth_rx_burst() and rte_eth_tx_burst().
+ * Updates the poll statistics of a queue.
+ *
+ * @param qs
+ *   Poll statistics of the queue.
+ * @param nb_done
+ *   The number of packets received or sent by the driver.
+ * @param nb_pkts
+ *   The number of packets requested.
+ */
+static inline void
+rte_eth_queue_poll_stats_update(struct rte_eth_queue_poll_stats *qs,
+		uint16_t nb_done, uint16_t nb_pkts)
+{
+	uint64_t tsc = rte_rdtsc();
+	uint32_t bucket;
+
+	if (likely(qs->last_poll_tsc != 0))
+		qs->poll_cycles += tsc - qs->last_poll_tsc;
+	qs->last_poll_tsc = tsc;
+
+	qs->polls++;
+	qs->pkts += nb_done;
+	if (nb_done == 0)
+		qs->empty_polls++;
+	else if (nb_done == nb_pkts)
+		qs->full_polls++;
+
+	bucket = RTE_MIN(rte_fls_u32(nb_done),
+			(uint32_t)(RTE_ETH_QUEUE_POLL_HIST_SIZE - 1));
+	qs->burst_hist[bucket]++;
+}
+#endif
+
 /**
  * @internal
  * Helper routine for rte_eth_rx_burst().
@@ -6380,6 +6525,12 @@ rte_eth_rx_burst(uint16_t port_id, uint16_t queue_id,
 
 	rte_mbuf_history_mark_bulk(rx_pkts, nb_rx, RTE_MBUF_HISTORY_OP_RX);
 
+#ifdef RTE_ETHDEV_QUEUE_POLL_STATS
+	if (unlikely(p->rx_poll_stats != NULL))
+		rte_eth_queue_poll_stats_update(&p->rx_poll_stats[queue_id],
+				nb_rx, nb_pkts);
+#endif
+
 #ifdef RTE_ETHDEV_RXTX_CALLBACKS
 	{
 		void *cb;
@@ -6741,6 +6892,18 @@ rte_eth_tx_burst(uint16_t port_id, uint16_t queue_id,
 		rte_mbuf_history_mark_bulk(tx_pkts + nb_pkts,
 				requested_pkts - nb_pkts, RTE_MBUF_HISTORY_OP_TX_BUSY);
 
+#ifdef RTE_ETHDEV_QUEUE_POLL_STATS
+	if (unlikely(p->tx_poll_stats != NULL)) {
+		struct rte_eth_queue_poll_stats *qs = &p->tx_poll_stats[queue_id];
+
+		rte_eth_queue_poll_stats_update(qs, nb_pkts, requested_pkts);
+		if (requested_pkts > nb_pkts) {
+			qs->partial_polls++;
+			qs->unsent_pkts += requested_pkts - nb_pkts;
+		}
+	}
+#endif
+
 	rte_ethdev_trace_tx_burst(port_id, queue_id, (void **)tx_pkts, nb_pkts);
 	return nb_pkts;
 }
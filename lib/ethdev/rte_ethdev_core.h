@@ -21,6 +21,7 @@ struct rte_eth_dev_callback;
 RTE_TAILQ_HEAD(rte_eth_dev_cb_list, rte_eth_dev_callback);
 
 struct rte_eth_dev;
+struct rte_eth_queue_poll_stats;
 
 /**
  * @internal Retrieve input packets from a receive queue of an Ethernet device.
@@ -101,7 +102,9 @@ struct __rte_cache_aligned rte_eth_fp_ops {
 	eth_rx_descriptor_status_t rx_descriptor_status;
 	/** Refill Rx descriptors with the recycling mbufs. */
 	eth_recycle_rx_descriptors_refill_t recycle_rx_descriptors_refill;
-	uintptr_t reserved1[2];
+	/** Rx queues poll statistics, NULL if disabled. */
+	struct rte_eth_queue_poll_stats *rx_poll_stats;
+	uintptr_t reserved1[1];
 	/**@}*/
 
 	/**@{*/
@@ -121,7 +124,8 @@ struct __rte_cache_aligned rte_eth_fp_ops {
 	eth_recycle_tx_mbufs_reuse_t recycle_tx_mbufs_reuse;
 	/** Get the number of used Tx descriptors. */
 	eth_tx_queue_count_t tx_queue_count;
-	uintptr_t reserved2[1];
+	/** Tx queues poll statistics, NULL if disabled. */
+	struct rte_eth_queue_poll_stats *tx_poll_stats;
 	/**@}*/
 
 };
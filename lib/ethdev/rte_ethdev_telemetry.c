@@ -685,6 +685,76 @@ eth_dev_add_dcb_info(uint16_t port_id, struct rte_tel_data *d)
 	return 0;
 }
 
+static int
+eth_dev_add_queue_poll_stats(const struct rte_eth_queue_poll_stats *qs,
+		bool is_rx, struct rte_tel_data *d)
+{
+	char name[RTE_TEL_MAX_STRING_LEN];
+	unsigned int i;
+
+	rte_tel_data_start_dict(d);
+	rte_tel_data_add_dict_uint(d, "polls", qs->polls);
+	rte_tel_data_add_dict_uint(d, "empty_polls", qs->empty_polls);
+	rte_tel_data_add_dict_uint(d, "full_polls", qs->full_polls);
+	rte_tel_data_add_dict_uint(d, "pkts", qs->pkts);
+	rte_tel_data_add_dict_uint(d, "avg_poll_cycles", qs->polls > 1 ?
+			qs->poll_cycles / (qs->polls - 1) : 0);
+	if (!is_rx) {
+		rte_tel_data_add_dict_uint(d, "partial_polls", qs->partial_polls);
+		rte_tel_data_add_dict_uint(d, "unsent_pkts", qs->unsent_pkts);
+	}
+
+	rte_tel_data_add_dict_uint(d, "burst_0", qs->burst_hist[0]);
+	for (i = 1; i < RTE_ETH_QUEUE_POLL_HIST_SIZE - 1; i++) {
+		snprintf(name, sizeof(name), "burst_%u_%u",
+				1u << (i - 1), (1u << i) - 1);
+		rte_tel_data_add_dict_uint(d, name, qs->burst_hist[i]);
+	}
+	snprintf(name, sizeof(name), "burst_%u_max", 1u << (i - 1));
+	rte_tel_data_add_dict_uint(d, name, qs->burst_hist[i]);
+
+	return 0;
+}
+
+static int
+eth_dev_handle_port_queue_stats(const char *cmd __rte_unused,
+		const char *params,
+		struct rte_tel_data *d)
+{
+	struct rte_eth_queue_poll_stats qs;
+	uint16_t port_id, queue_id;
+	struct rte_tel_data *rxd = NULL;
+	struct rte_tel_data *txd = NULL;
+	int rx_ret, tx_ret;
+
+	rx_ret = ethdev_parse_queue_params(params, true, &port_id, &queue_id);
+	if (rx_ret != 0)
+		return rx_ret;
+
+	rte_tel_data_start_dict(d);
+
+	rx_ret = rte_eth_queue_poll_stats_get(port_id, queue_id, true, &qs);
+	if (rx_ret == 0) {
+		rxd = rte_tel_data_alloc();
+		if (rxd == NULL)
+			return -ENOMEM;
+		eth_dev_add_queue_poll_stats(&qs, true, rxd);
+		rte_tel_data_add_dict_container(d, "rx", rxd, 0);
+	}
+
+	tx_ret = rte_eth_queue_poll_stats_get(port_id, queue_id, false, &qs);
+	if (tx_ret == 0) {
+		txd = rte_tel_data_alloc();
+		if (txd == NULL)
+			return -ENOMEM;
+		eth_dev_add_queue_poll_stats(&qs, false, txd);
+		rte_tel_data_add_dict_container(d, "tx", txd, 0);
+	}
+
+	/* Report an error only if neither direction has statistics. */
+	return (rx_ret != 0 && tx_ret != 0) ? rx_ret : 0;
+}
+
 static int
 eth_dev_handle_port_dcb(const char *cmd __rte_unused,
 		const char *params,
@@ -1556,6 +1626,9 @@ RTE_INIT(ethdev_init_telemetry)
 	rte_telemetry_register_cmd_arg("/ethdev/tx_queue",
 			eth_dev_telemetry_do, eth_dev_handle_port_txq,
 			"Returns Tx queue info for a port. Parameters: int port_id, int queue_id (Optional if only one queue)");
+	rte_telemetry_register_cmd_arg("/ethdev/queue_stats",
+			eth_dev_telemetry_do, eth_dev_handle_port_queue_stats,
+			"Returns Rx/Tx queue poll statistics for a port. Parameters: int port_id, int queue_id (Optional if only one queue)");
 	rte_telemetry_register_cmd_arg("/ethdev/dcb",
 			eth_dev_telemetry_do, eth_dev_handle_port_dcb,
 			"Returns DCB info for a port. Parameters: int port_id");
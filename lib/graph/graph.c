@@ -17,6 +17,7 @@
 
 #include "graph_private.h"
 #include "graph_pcap_private.h"
+#include "graph_prof_private.h"
 
 static struct graph_head graph_list = STAILQ_HEAD_INITIALIZER(graph_list);
 static rte_spinlock_t graph_lock = RTE_SPINLOCK_INITIALIZER;
@@ -296,7 +297,10 @@ graph_mem_fixup_node_ctx(struct rte_graph *graph)
 		if (node_db == NULL)
 			SET_ERR_JMP(ENOLINK, fail, "Node %s not found", name);
 
-		if (graph->pcap_enable) {
+		if (graph->prof_enable) {
+			node->process = graph_prof_dispatch;
+			node->original_process = node_db->process;
+		} else if (graph->pcap_enable) {
 			node->process = graph_pcap_dispatch;
 			node->original_process = node_db->process;
 		} else
@@ -314,7 +318,8 @@ graph_mem_fixup_secondary(struct rte_graph *graph)
 	if (graph == NULL || rte_eal_process_type() == RTE_PROC_PRIMARY)
 		return graph;
 
-	if (graph_pcap_file_open(graph->pcap_filename) || graph_pcap_mp_init())
+	if (graph_pcap_file_open(graph->pcap_filename) || graph_pcap_mp_init() ||
+	    graph_pcap_ring_init(graph->pcap_ring_size))
 		graph_pcap_exit(graph);
 
 	return graph_mem_fixup_node_ctx(graph);
@@ -473,6 +478,10 @@ rte_graph_create(const char *name, struct rte_graph_param *prm)
 	/* Initialize pcap config. */
 	graph_pcap_enable(prm->pcap_enable);
 
+	/* Initialize node profile config. */
+	if (graph_prof_config(graph, prm))
+		goto graph_cleanup;
+
 	/* Initialize graph object */
 	graph->socket = prm->socket_id;
 	graph->src_node_count = src_node_count;
@@ -483,6 +492,7 @@ rte_graph_create(const char *name, struct rte_graph_param *prm)
 	graph->num_pkt_to_capture = prm->num_pkt_to_capture;
 	if (prm->pcap_filename)
 		rte_strscpy(graph->pcap_filename, prm->pcap_filename, RTE_GRAPH_PCAP_FILE_SZ);
+	graph->pcap_ring_size = prm->pcap_ring_size;
 
 	/* Allocate the Graph fast path memory and populate the data */
 	if (graph_fp_mem_create(graph))
@@ -522,10 +532,19 @@ rte_graph_destroy(rte_graph_t id)
 	while (graph != NULL) {
 		tmp = STAILQ_NEXT(graph, next);
 		if (graph->id == id) {
+			/* The clones of the graph use its run-queue */
+			if (graph_ws_has_clones(graph)) {
+				rc = -EBUSY;
+				SET_ERR_JMP(EBUSY, done,
+					    "Graph %s has clones, destroy them first",
+					    graph->name);
+			}
 			/* Destroy the schedule work queue if has */
 			if (rte_graph_worker_model_get(graph->graph) ==
 			    RTE_GRAPH_MODEL_MCORE_DISPATCH)
 				graph_sched_wq_destroy(graph);
+			/* Destroy the deque of shared streams if has */
+			graph_ws_destroy(graph);
 
 			/* Call fini() of the all the nodes in the graph */
 			graph_node_fini(graph);
@@ -591,6 +610,11 @@ graph_clone(struct graph *parent_graph, const char *name, struct rte_graph_param
 	graph->lcore_id = parent_graph->lcore_id;
 	graph->socket = parent_graph->socket;
 	graph->id = graph_next_free_id();
+	graph->num_pkt_to_capture = parent_graph->num_pkt_to_capture;
+	graph->pcap_ring_size = parent_graph->pcap_ring_size;
+	graph->prof_enable = parent_graph->prof_enable;
+	graph->nb_pmu_events = parent_graph->nb_pmu_events;
+	memcpy(graph->pmu_events, parent_graph->pmu_events, sizeof(graph->pmu_events));
 
 	/* Allocate the Graph fast path memory and populate the data */
 	if (graph_fp_mem_create(graph))
@@ -608,9 +632,15 @@ graph_clone(struct graph *parent_graph, const char *name, struct rte_graph_param
 		graph->graph->dispatch.cb_priv = prm->dispatch.cb_priv;
 	}
 
+	/* Create the graph deque of shared streams */
+	if (rte_graph_worker_model_get(graph->graph) == RTE_GRAPH_MODEL_WORK_STEALING) {
+		if (graph_ws_create(graph, parent_graph, prm))
+			goto graph_mem_destroy;
+	}
+
 	/* Call init() of the all the nodes in the graph */
 	if (graph_node_init(graph))
-		goto graph_mem_destroy;
+		goto ws_destroy;
 
 	/* All good, Lets add the graph to the list */
 	graph_insert_ordered(graph);
@@ -618,6 +648,8 @@ graph_clone(struct graph *parent_graph, const char *name, struct rte_graph_param
 	graph_spinlock_unlock();
 	return graph->id;
 
+ws_destroy:
+	graph_ws_destroy(graph);
 graph_mem_destroy:
 	graph_fp_mem_destroy(graph);
 graph_cleanup:
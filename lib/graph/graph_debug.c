@@ -91,6 +91,11 @@ rte_graph_obj_dump(FILE *f, struct rte_graph *g, bool all)
 				n->dispatch.total_sched_objs);
 			fprintf(f, "       total_sched_fail=%" PRId64 "\n",
 				n->dispatch.total_sched_fail);
+		} else if (rte_graph_worker_model_get(g) == RTE_GRAPH_MODEL_WORK_STEALING) {
+			fprintf(f, "       total_shared_objs=%" PRId64 "\n",
+				n->ws.total_shared_objs);
+			fprintf(f, "       total_stolen_objs=%" PRId64 "\n",
+				n->ws.total_stolen_objs);
 		}
 		fprintf(f, "       total_calls=%" PRId64 "\n", n->total_calls);
 		for (i = 0; i < n->nb_edges; i++)
@@ -431,9 +431,9 @@ arc_max_index_get(const char *arc_name, uint16_t *max_indexes)
 static int
 feature_arc_reg_calc_size(struct rte_graph_feature_arc_register *reg, size_t *sz,
 			  uint16_t *feat_off, uint16_t *fdata_off, uint32_t *fsz,
-			  uint16_t *num_index)
+			  uint16_t *num_index, uint16_t *chain_sz)
 {
-	size_t ff_size = 0, fdata_size = 0;
+	size_t ff_size = 0, fdata_size = 0, chain_size = 0;
 
 	/* first feature array per index */
 	ff_size = RTE_ALIGN_CEIL(sizeof(rte_graph_feature_data_t) * reg->max_indexes,
@@ -452,8 +452,13 @@ feature_arc_reg_calc_size(struct rte_graph_feature_arc_register *reg, size_t *sz
 	 */
 	fdata_size = (*fsz) * (reg->max_features + NUM_EXTRA_FEATURE_DATA);
 
+	/* Specialized chain per index, start feature data and all features */
+	*chain_sz = RTE_ALIGN_CEIL(reg->max_features + 1,
+				   RTE_CACHE_LINE_SIZE / sizeof(struct rte_graph_feature_data));
+	chain_size = sizeof(struct rte_graph_feature_data) * (*chain_sz) * (*num_index);
+
 	if (sz)
-		*sz = fdata_size + ff_size + sizeof(struct rte_graph_feature_arc);
+		*sz = fdata_size + chain_size + ff_size + sizeof(struct rte_graph_feature_arc);
 	if (feat_off)
 		*feat_off = sizeof(struct rte_graph_feature_arc);
 	if (fdata_off)
@@ -484,6 +489,7 @@ feature_arc_data_reset(struct rte_graph_feature_arc *arc)
 	for (index = 0; index < arc->max_indexes; index++) {
 		f = graph_first_feature_data_ptr_get(arc, index);
 		*f = RTE_GRAPH_FEATURE_DATA_INVALID;
+		arc->generic_first_fdata_by_index[index] = RTE_GRAPH_FEATURE_DATA_INVALID;
 	}
 
 	for (iter = 0; iter < arc->max_features + NUM_EXTRA_FEATURE_DATA; iter++) {
@@ -498,6 +504,80 @@ feature_arc_data_reset(struct rte_graph_feature_arc *arc)
 	return 0;
 }
 
+/*
+ * Switch back the index from its specialized chain to the generic chain, before
+ * the features enabled on the index are changed. Packets already in the arc
+ * complete the specialized chain.
+ */
+static void
+specialized_chain_release(struct rte_graph_feature_arc *arc, uint32_t index)
+{
+	RTE_ATOMIC(rte_graph_feature_data_t) * first_fdata;
+
+	if (arc->generic_first_fdata_by_index[index] == RTE_GRAPH_FEATURE_DATA_INVALID)
+		return;
+
+	first_fdata = (RTE_ATOMIC(rte_graph_feature_data_t) *)
+		graph_first_feature_data_ptr_get(arc, index);
+	rte_atomic_store_explicit(first_fdata, arc->generic_first_fdata_by_index[index],
+				  rte_memory_order_release);
+	arc->generic_first_fdata_by_index[index] = RTE_GRAPH_FEATURE_DATA_INVALID;
+}
+
+/*
+ * Copy the generic chain of enabled features of the index into its specialized
+ * chain, and point the first feature data of the index to it.
+ * Only called once no packet uses the previous specialized chain of the index.
+ */
+static void
+specialized_chain_build(struct rte_graph_feature_arc *arc, uint32_t index)
+{
+	RTE_ATOMIC(rte_graph_feature_data_t) * first_fdata;
+	struct rte_graph_feature_data *gfd, *sfd;
+	rte_graph_feature_data_t fdata, chain;
+	uint16_t hop;
+
+	first_fdata = (RTE_ATOMIC(rte_graph_feature_data_t) *)
+		graph_first_feature_data_ptr_get(arc, index);
+	fdata = rte_atomic_load_explicit(first_fdata, rte_memory_order_relaxed);
+	if (fdata == RTE_GRAPH_FEATURE_DATA_INVALID)
+		return;
+
+	chain = arc->specialized_fdata_start + (index * arc->specialized_chain_size);
+	for (hop = 0; hop < arc->specialized_chain_size; hop++) {
+		gfd = rte_graph_feature_data_get(arc, fdata);
+		sfd = rte_graph_feature_data_get(arc, chain + hop);
+
+		rte_atomic_store_explicit(&sfd->next_edge, __rte_graph_feature_data_edge_get(gfd),
+					  rte_memory_order_relaxed);
+		rte_atomic_store_explicit(&sfd->app_cookie,
+					  __rte_graph_feature_data_app_cookie_get(gfd),
+					  rte_memory_order_relaxed);
+
+		fdata = __rte_graph_feature_data_next_feature_get(gfd);
+		rte_atomic_store_explicit(&sfd->next_feature_data,
+					  (fdata == RTE_GRAPH_FEATURE_DATA_INVALID) ?
+					  RTE_GRAPH_FEATURE_DATA_INVALID : chain + hop + 1,
+					  rte_memory_order_relaxed);
+		if (fdata == RTE_GRAPH_FEATURE_DATA_INVALID)
+			break;
+	}
+
+	/* Should not happen, keep the generic chain */
+	if (hop == arc->specialized_chain_size) {
+		graph_err("%s/index:%u: feature chain longer than %u", arc->feature_arc_name,
+			  index, arc->specialized_chain_size);
+		return;
+	}
+
+	arc->generic_first_fdata_by_index[index] =
+		rte_atomic_load_explicit(first_fdata, rte_memory_order_relaxed);
+	rte_atomic_store_explicit(first_fdata, chain, rte_memory_order_release);
+
+	feat_dbg("%s/index:%u: specialized chain of %u features", arc->feature_arc_name,
+		 index, hop);
+}
+
 /*
  * lookup feature name and get control path node_list as well as feature index
  * at which it is inserted
@@ -1202,7 +1282,7 @@ rte_graph_feature_arc_create(struct rte_graph_feature_arc_register *reg,
 	struct rte_graph_feature_arc *arc = NULL;
 	uint16_t first_feat_off, fdata_off;
 	const struct rte_memzone *mz = NULL;
-	uint16_t iter, arc_index, num_index;
+	uint16_t iter, arc_index, num_index, chain_sz;
 	uint32_t feat_sz = 0;
 	size_t sz;
 
@@ -1258,7 +1338,8 @@ rte_graph_feature_arc_create(struct rte_graph_feature_arc_register *reg,
 	}
 
 	/* Calculate size of feature arc */
-	feature_arc_reg_calc_size(reg, &sz, &first_feat_off, &fdata_off, &feat_sz, &num_index);
+	feature_arc_reg_calc_size(reg, &sz, &first_feat_off, &fdata_off, &feat_sz, &num_index,
+				  &chain_sz);
 
 	mz = rte_memzone_reserve(reg->arc_name, sz, SOCKET_ID_ANY, 0);
 
@@ -1282,10 +1363,18 @@ rte_graph_feature_arc_create(struct rte_graph_feature_arc_register *reg,
 
 	memset(arc->feature_bit_mask_by_index, 0, sizeof(uint64_t) * num_index);
 
+	arc->generic_first_fdata_by_index = rte_malloc(reg->arc_name,
+						       sizeof(rte_graph_feature_data_t) * num_index,
+						       0);
+	if (!arc->generic_first_fdata_by_index) {
+		graph_err("%s: rte_malloc failed for generic_first_fdata", reg->arc_name);
+		goto feat_bitmask_free;
+	}
+
 	/* override process function with start_node */
 	if (node_override_process_func(reg->start_node->id, reg->start_node_feature_process_fn)) {
 		graph_err("node_override_process_func failed for %s", reg->start_node->name);
-		goto feat_bitmask_free;
+		goto generic_fdata_free;
 	}
 	feat_dbg("arc-%s: node-%s process() overridden with %p",
 		  reg->arc_name, reg->start_node->name,
@@ -1307,6 +1396,9 @@ rte_graph_feature_arc_create(struct rte_graph_feature_arc_register *reg,
 	arc->fp_first_feature_offset = first_feat_off;
 	arc->fp_feature_data_offset = fdata_off;
 	arc->feature_size = feat_sz;
+	arc->specialized_fdata_start =
+		RTE_GRAPH_FEATURE_TO_FEATURE_DATA(arc, reg->max_features + NUM_EXTRA_FEATURE_DATA, 0);
+	arc->specialized_chain_size = chain_sz;
 	arc->mbuf_dyn_offset = dfm->arc_mbuf_dyn_offset;
 
 	feature_arc_data_reset(arc);
@@ -1327,6 +1419,9 @@ rte_graph_feature_arc_create(struct rte_graph_feature_arc_register *reg,
 
 arc_destroy:
 	rte_graph_feature_arc_destroy(arc_index);
+	return -1;
+generic_fdata_free:
+	rte_free(arc->generic_first_fdata_by_index);
 feat_bitmask_free:
 	rte_free(arc->feature_bit_mask_by_index);
 mz_free:
@@ -1634,6 +1729,9 @@ rte_graph_feature_enable(rte_graph_feature_arc_t _arc, uint32_t index,
 	if (nodeinfo_lkup_by_name(arc, feature_name, &finfo, &slot))
 		return -1;
 
+	/* Packets entering the arc take the generic chain while it is updated */
+	specialized_chain_release(arc, index);
+
 	gfd = rte_graph_feature_data_get(arc, fdata_reserve(arc, slot, index));
 
 	/* Set current app_cookie */
@@ -1667,8 +1765,11 @@ rte_graph_feature_enable(rte_graph_feature_arc_t _arc, uint32_t index,
 	/* Release extra fdata, if reserved before */
 	extra_fdata_release(arc, slot, index);
 
-	if (qsbr)
+	/* No packet uses the previous specialized chain after synchronization */
+	if (qsbr) {
 		rte_rcu_qsbr_synchronize(qsbr, RTE_QSBR_THRID_INVALID);
+		specialized_chain_build(arc, index);
+	}
 
 	if (finfo->notifier_cb)
 		finfo->notifier_cb(arc->feature_arc_name, finfo->feature_name,
@@ -1710,6 +1811,9 @@ rte_graph_feature_disable(rte_graph_feature_arc_t _arc, uint32_t index, const ch
 		return -1;
 	}
 
+	/* Packets entering the arc take the generic chain while it is updated */
+	specialized_chain_release(arc, index);
+
 	/* If feature is not last feature, unset in control plane bitmask */
 	last_end_feature = arc->num_added_features - 1;
 	if (slot != last_end_feature)
@@ -1757,8 +1861,11 @@ rte_graph_feature_disable(rte_graph_feature_arc_t _arc, uint32_t index, const ch
 					  rte_memory_order_relaxed);
 	}
 
-	if (qsbr)
+	/* No packet uses the previous specialized chain after synchronization */
+	if (qsbr) {
 		rte_rcu_qsbr_synchronize(qsbr, RTE_QSBR_THRID_INVALID);
+		specialized_chain_build(arc, index);
+	}
 
 	/* Call notifier cb with valid app_cookie */
 	if (finfo->notifier_cb)
@@ -1856,6 +1963,8 @@ rte_graph_feature_arc_destroy(rte_graph_feature_arc_t _arc)
 
 	rte_free(arc->feature_bit_mask_by_index);
 
+	rte_free(arc->generic_first_fdata_by_index);
+
 	rte_memzone_free(rte_memzone_lookup(arc->feature_arc_name));
 
 	return 0;
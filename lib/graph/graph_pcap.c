@@ -7,9 +7,15 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#ifdef RTE_LIB_BPF
+#include <rte_bpf.h>
+#endif
+#include <eal_export.h>
 #include <rte_ethdev.h>
 #include <rte_mbuf.h>
+#include <rte_pause.h>
 #include <rte_pcapng.h>
+#include <rte_ring.h>
 
 #include "rte_graph_worker.h"
 
@@ -19,11 +25,20 @@
 #define GRAPH_PCAP_NUM_PACKETS	1024
 #define GRAPH_PCAP_PKT_POOL	"graph_pcap_pkt_pool"
 #define GRAPH_PCAP_FILE_NAME	"dpdk_graph_pcap_capture_XXXXXX.pcapng"
+#define GRAPH_PCAP_RING		"graph_pcap_ring"
+#define GRAPH_PCAP_SNAP_POOL	"graph_pcap_snap_pool"
 
 /* For multi-process, packets are captured in separate files. */
 static rte_pcapng_t *pcapng_fd;
 static bool pcap_enable;
 struct rte_mempool *pkt_mp;
+/* Number of graphs sharing the capture file and pools */
+static unsigned int pcap_nb_graphs;
+static struct rte_ring *pcap_ring;
+static struct rte_mempool *snap_mp;
+/* Writer handshake: the ring is released once no writer uses it */
+static RTE_ATOMIC(bool) pcap_ring_ready;
+static RTE_ATOMIC(uint32_t) pcap_nb_writers;
 
 void
 graph_pcap_enable(bool val)
@@ -37,17 +52,50 @@ graph_pcap_is_enable(void)
 	return pcap_enable;
 }
 
+static void
+graph_pcap_ring_exit(void)
+{
+	struct rte_mbuf *mbuf;
+
+	/* Stop new writes and wait for the running ones to return */
+	rte_atomic_store_explicit(&pcap_ring_ready, false, rte_memory_order_seq_cst);
+	while (rte_atomic_load_explicit(&pcap_nb_writers, rte_memory_order_seq_cst) != 0)
+		rte_pause();
+
+	if (rte_eal_process_type() == RTE_PROC_PRIMARY && pcap_ring != NULL) {
+		/* Release the snapshots not written */
+		while (rte_ring_sc_dequeue(pcap_ring, (void **)&mbuf) == 0)
+			rte_pktmbuf_free(mbuf);
+		rte_ring_free(pcap_ring);
+		rte_mempool_free(snap_mp);
+	}
+
+	pcap_ring = NULL;
+	snap_mp = NULL;
+}
+
 void
 graph_pcap_exit(struct rte_graph *graph)
 {
+	if (graph->pcap_enable && pcap_nb_graphs != 0)
+		pcap_nb_graphs--;
+
+	/* Keep the capture file and pools of the other graphs */
+	if (pcap_nb_graphs != 0)
+		goto disable;
+
+	graph_pcap_ring_exit();
+
 	if (rte_eal_process_type() == RTE_PROC_PRIMARY)
 		rte_mempool_free(pkt_mp);
+	pkt_mp = NULL;
 
 	if (pcapng_fd) {
 		rte_pcapng_close(pcapng_fd);
 		pcapng_fd = NULL;
 	}
 
+disable:
 	/* Disable pcap. */
 	graph->pcap_enable = 0;
 	graph_pcap_enable(0);
@@ -158,6 +206,94 @@ graph_pcap_mp_init(void)
 	return 0;
 }
 
+int
+graph_pcap_ring_init(uint32_t size)
+{
+	unsigned int nb_snaps;
+
+	if (size == 0 || pcap_ring != NULL)
+		return 0;
+
+	pcap_ring = rte_ring_lookup(GRAPH_PCAP_RING);
+	if (pcap_ring == NULL)
+		pcap_ring = rte_ring_create(GRAPH_PCAP_RING, rte_align32pow2(size), SOCKET_ID_ANY,
+					    RING_F_SC_DEQ);
+	if (pcap_ring == NULL) {
+		graph_err("Cannot create ring for graph pcap capture.");
+		return -1;
+	}
+
+	snap_mp = rte_mempool_lookup(GRAPH_PCAP_SNAP_POOL);
+	if (snap_mp)
+		goto ready;
+
+	/* A snapshot per ring entry, some stay in the lcore caches */
+	nb_snaps = 2 * rte_ring_get_capacity(pcap_ring);
+	snap_mp = rte_pktmbuf_pool_create_by_ops(GRAPH_PCAP_SNAP_POOL, nb_snaps,
+			RTE_MIN((unsigned int)RTE_MEMPOOL_CACHE_MAX_SIZE, nb_snaps / 8), 0,
+			rte_pcapng_mbuf_size(RTE_MBUF_DEFAULT_BUF_SIZE), SOCKET_ID_ANY, "ring_mp_mc");
+	if (snap_mp == NULL) {
+		graph_err("Cannot create snapshot mempool for graph pcap capture.");
+		return -1;
+	}
+
+ready:
+	rte_atomic_store_explicit(&pcap_ring_ready, true, rte_memory_order_release);
+	return 0;
+}
+
+int
+graph_pcap_filter_set(struct node *node, const struct rte_bpf_prm *prm)
+{
+	struct rte_bpf *filter = NULL;
+
+	if (prm != NULL) {
+#ifdef RTE_LIB_BPF
+		if (prm->prog_arg.type != RTE_BPF_ARG_PTR_MBUF) {
+			graph_err("Invalid BPF program type: %u", prm->prog_arg.type);
+			return -EINVAL;
+		}
+
+		filter = rte_bpf_load(prm);
+		if (filter == NULL) {
+			graph_err("Cannot load BPF filter: %s", rte_strerror(rte_errno));
+			return -rte_errno;
+		}
+#else
+		return -ENOTSUP;
+#endif
+	}
+
+	graph_pcap_filter_free(node);
+	node->pcap_filter = filter;
+
+	return 0;
+}
+
+void
+graph_pcap_filter_free(struct node *node)
+{
+#ifdef RTE_LIB_BPF
+	rte_bpf_destroy(node->pcap_filter);
+#endif
+	node->pcap_filter = NULL;
+}
+
+void
+graph_pcap_node_populate(struct rte_node *node, const struct node *node_db)
+{
+#ifdef RTE_LIB_BPF
+	struct rte_bpf_jit jit = { 0 };
+
+	if (node_db->pcap_filter != NULL)
+		rte_bpf_get_jit(node_db->pcap_filter, &jit);
+	node->pcap.filter_jit = jit.func;
+#endif
+	node->pcap.filter = node_db->pcap_filter;
+	node->pcap.sample_rate = RTE_MAX(node_db->pcap_sample_rate, 1u);
+	node->pcap.sample_skip = 0;
+}
+
 int
 graph_pcap_init(struct graph *graph)
 {
@@ -169,6 +305,9 @@ graph_pcap_init(struct graph *graph)
 	if (graph_pcap_mp_init() < 0)
 		goto error;
 
+	if (graph_pcap_ring_init(graph->pcap_ring_size) < 0)
+		goto error;
+
 	/* User configured number of packets to capture. */
 	if (graph->num_pkt_to_capture)
 		graph_data->nb_pkt_to_capture = graph->num_pkt_to_capture;
@@ -177,7 +316,9 @@ graph_pcap_init(struct graph *graph)
 
 	/* All good. Now populate data for secondary process. */
 	rte_strscpy(graph_data->pcap_filename, graph->pcap_filename, RTE_GRAPH_PCAP_FILE_SZ);
+	graph_data->pcap_ring_size = graph->pcap_ring_size;
 	graph_data->pcap_enable = 1;
+	pcap_nb_graphs++;
 
 	return 0;
 
@@ -188,14 +329,61 @@ graph_pcap_init(struct graph *graph)
 	return -1;
 }
 
+/* Select the packets to capture with the filter and the sampling of the node */
+static __rte_always_inline uint16_t
+graph_pcap_select(struct rte_node *node, void **objs, uint16_t nb_objs,
+		  struct rte_mbuf **pkts)
+{
+	uint32_t rate = node->pcap.sample_rate;
+	uint32_t skip = node->pcap.sample_skip;
+#ifdef RTE_LIB_BPF
+	uint64_t rc[RTE_GRAPH_BURST_SIZE];
+#endif
+	uint16_t n = 0;
+	uint32_t i;
+
+	if (node->pcap.filter == NULL) {
+		for (i = skip; i < nb_objs; i += rate)
+			pkts[n++] = objs[i];
+		node->pcap.sample_skip = i - nb_objs;
+		return n;
+	}
+
+#ifdef RTE_LIB_BPF
+	if (node->pcap.filter_jit != NULL) {
+		for (i = 0; i < nb_objs; i++)
+			rc[i] = node->pcap.filter_jit(objs[i]);
+	} else {
+		rte_bpf_exec_burst(node->pcap.filter, objs, rc, nb_objs);
+	}
+
+	for (i = 0; i < nb_objs; i++) {
+		/* Same return value convention as the socket filters */
+		if (rc[i] == 0)
+			continue;
+		if (skip != 0) {
+			skip--;
+			continue;
+		}
+		pkts[n++] = objs[i];
+		skip = rate - 1;
+	}
+	node->pcap.sample_skip = skip;
+#endif
+
+	return n;
+}
+
 uint16_t
 graph_pcap_dispatch(struct rte_graph *graph,
 			      struct rte_node *node, void **objs,
 			      uint16_t nb_objs)
 {
 	struct rte_mbuf *mbuf_clones[RTE_GRAPH_BURST_SIZE];
+	struct rte_mbuf *pkts[RTE_GRAPH_BURST_SIZE];
 	char buffer[GRAPH_PCAP_BUF_SZ];
-	uint64_t i, num_packets;
+	uint64_t i, n, num_packets;
+	struct rte_mempool *mp;
 	struct rte_mbuf *mbuf;
 	ssize_t len;
 
@@ -203,17 +391,22 @@ graph_pcap_dispatch(struct rte_graph *graph,
 		goto done;
 
 	num_packets = graph->nb_pkt_to_capture - graph->nb_pkt_captured;
-	/* nb_objs will never be greater than RTE_GRAPH_BURST_SIZE */
-	if (num_packets > nb_objs)
-		num_packets = nb_objs;
+	/* Streams larger than a burst are only captured partially */
+	num_packets = RTE_MIN(num_packets,
+			      graph_pcap_select(node, objs, RTE_MIN(nb_objs, RTE_GRAPH_BURST_SIZE),
+						pkts));
+	if (num_packets == 0)
+		goto done;
 
 	snprintf(buffer, GRAPH_PCAP_BUF_SZ, "%s: %s", graph->name, node->name);
 
+	/* Snapshot before the next nodes modify or free the packets */
+	mp = graph->pcap_ring_size ? snap_mp : pkt_mp;
 	for (i = 0; i < num_packets; i++) {
 		struct rte_mbuf *mc;
-		mbuf = (struct rte_mbuf *)objs[i];
+		mbuf = pkts[i];
 
-		mc = rte_pcapng_copy(mbuf->port, 0, mbuf, pkt_mp, mbuf->pkt_len,
+		mc = rte_pcapng_copy(mbuf->port, 0, mbuf, mp, mbuf->pkt_len,
 				     0, buffer);
 		if (mc == NULL)
 			break;
@@ -221,6 +414,13 @@ graph_pcap_dispatch(struct rte_graph *graph,
 		mbuf_clones[i] = mc;
 	}
 
+	if (graph->pcap_ring_size) {
+		n = rte_ring_mp_enqueue_burst(pcap_ring, (void **)mbuf_clones, i, NULL);
+		rte_pktmbuf_free_bulk(&mbuf_clones[n], i - n);
+		graph->nb_pkt_captured += n;
+		goto done;
+	}
+
 	/* write it to capture file */
 	len = rte_pcapng_write_packets(pcapng_fd, mbuf_clones, i);
 	rte_pktmbuf_free_bulk(mbuf_clones, i);
@@ -232,3 +432,38 @@ graph_pcap_dispatch(struct rte_graph *graph,
 done:
 	return node->original_process(graph, node, objs, nb_objs);
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_graph_pcap_write, 25.11)
+int
+rte_graph_pcap_write(uint16_t nb_pkts)
+{
+	struct rte_mbuf *mbufs[RTE_GRAPH_BURST_SIZE];
+	int nb_written = 0;
+	unsigned int n;
+
+	/* Paired with the wait of graph_pcap_ring_exit() */
+	rte_atomic_fetch_add_explicit(&pcap_nb_writers, 1, rte_memory_order_seq_cst);
+	if (!rte_atomic_load_explicit(&pcap_ring_ready, rte_memory_order_seq_cst)) {
+		nb_written = -ENOENT;
+		goto exit;
+	}
+
+	while (nb_written < nb_pkts) {
+		n = rte_ring_sc_dequeue_burst(pcap_ring, (void **)mbufs,
+				RTE_MIN(nb_pkts - nb_written, RTE_GRAPH_BURST_SIZE), NULL);
+		if (n == 0)
+			break;
+
+		if (rte_pcapng_write_packets(pcapng_fd, mbufs, n) < 0) {
+			rte_pktmbuf_free_bulk(mbufs, n);
+			nb_written = -EIO;
+			goto exit;
+		}
+		rte_pktmbuf_free_bulk(mbufs, n);
+		nb_written += n;
+	}
+
+exit:
+	rte_atomic_fetch_sub_explicit(&pcap_nb_writers, 1, rte_memory_order_release);
+	return nb_written;
+}
@@ -62,6 +62,59 @@ int graph_pcap_mp_init(void);
  */
 int graph_pcap_file_open(const char *filename);
 
+/**
+ * @internal
+ *
+ * Initialise the deferred write of the captured packets.
+ *
+ * The function invoked to create the ring of the captured packets and the
+ * mempool of their copies, if they do not exist yet.
+ *
+ * @param size
+ *   Size of the ring, 0 if the packets are written in the graph walk.
+ *
+ * @return
+ *   0 on success and -1 on failure.
+ */
+int graph_pcap_ring_init(uint32_t size);
+
+/**
+ * @internal
+ *
+ * Load the BPF filter of the packets captured by a node.
+ *
+ * @param node
+ *   Pointer to the node, its previous filter is released.
+ * @param prm
+ *   BPF program parameters, NULL to capture all packets.
+ *
+ * @return
+ *   0 on success, negative errno otherwise.
+ */
+int graph_pcap_filter_set(struct node *node, const struct rte_bpf_prm *prm);
+
+/**
+ * @internal
+ *
+ * Release the BPF filter of the packets captured by a node.
+ *
+ * @param node
+ *   Pointer to the node.
+ */
+void graph_pcap_filter_free(struct node *node);
+
+/**
+ * @internal
+ *
+ * Populate the capture parameters of a node in the graph fast path memory.
+ *
+ * @param node
+ *   Pointer to the node object of the graph.
+ * @param node_db
+ *   Pointer to the node holding the capture parameters.
+ */
+void graph_pcap_node_populate(struct rte_node *node, const struct node *node_db);
+
 /**
  * @internal
  *
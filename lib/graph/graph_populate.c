@@ -4,12 +4,14 @@
 
 
 #include <rte_common.h>
+#include <rte_cycles.h>
 #include <rte_errno.h>
 #include <rte_malloc.h>
 #include <rte_memzone.h>
 
 #include "graph_private.h"
 #include "graph_pcap_private.h"
+#include "graph_prof_private.h"
 
 static size_t
 graph_fp_mem_calc_size(struct graph *graph)
@@ -48,6 +50,21 @@ graph_fp_mem_calc_size(struct graph *graph)
 		sz = RTE_ALIGN(sz, RTE_CACHE_LINE_SIZE);
 		sz += sizeof(uint64_t) * graph_node->node->xstats->nb_xstats;
 	}
+	sz = RTE_ALIGN(sz, RTE_CACHE_LINE_SIZE);
+	graph->prof_start = sz;
+	/* For 0..N node objects with profile */
+	if (graph->prof_enable)
+		sz += RTE_ALIGN(sizeof(struct rte_node_prof), RTE_CACHE_LINE_SIZE) *
+		      graph->node_count;
+	/* Held streams list when a node coalesces its streams */
+	graph->held_start = 0;
+	STAILQ_FOREACH(graph_node, &graph->node_list, next) {
+		if (graph_node->node->coalesce.min_objs != 0) {
+			graph->held_start = sz;
+			sz += sizeof(rte_graph_off_t) * graph->node_count;
+			break;
+		}
+	}
 
 	graph->mem_sz = sz;
 	return sz;
@@ -64,6 +81,9 @@ graph_header_popluate(struct graph *_graph)
 	graph->nb_nodes = _graph->node_count;
 	graph->cir_start = RTE_PTR_ADD(graph, _graph->cir_start);
 	graph->nodes_start = _graph->nodes_start;
+	graph->coalesce = _graph->held_start != 0;
+	graph->nb_held = 0;
+	graph->held = graph->coalesce ? RTE_PTR_ADD(graph, _graph->held_start) : NULL;
 	graph->socket = _graph->socket;
 	graph->id = _graph->id;
 	memcpy(graph->name, _graph->name, RTE_GRAPH_NAMESIZE);
@@ -74,6 +94,7 @@ static void
 graph_nodes_populate(struct graph *_graph)
 {
 	rte_graph_off_t xstat_off = _graph->xstats_start;
+	rte_graph_off_t prof_off = _graph->prof_start;
 	rte_graph_off_t off = _graph->nodes_start;
 	struct rte_graph *graph = _graph->graph;
 	struct graph_node *graph_node;
@@ -85,7 +106,13 @@ graph_nodes_populate(struct graph *_graph)
 		memset(node, 0, sizeof(*node));
 		node->fence = RTE_GRAPH_FENCE;
 		node->off = off;
-		if (graph_pcap_is_enable()) {
+		if (_graph->prof_enable) {
+			node->process = graph_prof_dispatch;
+			node->original_process = graph_node->node->process;
+			node->prof_off = prof_off - off;
+			memset(RTE_PTR_ADD(graph, prof_off), 0, sizeof(struct rte_node_prof));
+			prof_off += RTE_ALIGN(sizeof(struct rte_node_prof), RTE_CACHE_LINE_SIZE);
+		} else if (graph_pcap_is_enable()) {
 			node->process = graph_pcap_dispatch;
 			node->original_process = graph_node->node->process;
 		} else
@@ -105,6 +132,11 @@ graph_nodes_populate(struct graph *_graph)
 		node->id = graph_node->node->id;
 		node->parent_id = pid;
 		node->dispatch.lcore_id = graph_node->node->lcore_id;
+		node->coalesce.min_objs = graph_node->node->coalesce.min_objs;
+		node->coalesce.max_walks = graph_node->node->coalesce.max_walks;
+		node->coalesce.max_cycles = (uint64_t)((double)graph_node->node->coalesce.max_ns *
+						       rte_get_tsc_hz() / NS_PER_S);
+		graph_pcap_node_populate(node, graph_node->node);
 		nb_edges = graph_node->node->nb_edges;
 		node->nb_edges = nb_edges;
 		off += sizeof(struct rte_node);
@@ -204,6 +236,39 @@ graph_src_nodes_offset_populate(struct graph *_graph)
 	return -rte_errno;
 }
 
+static int
+graph_nodes_ws_populate(struct graph *_graph)
+{
+	struct graph_node *graph_node, *tmp;
+	struct rte_graph *graph = _graph->graph;
+	struct rte_node *node;
+	bool stealable;
+
+	STAILQ_FOREACH(graph_node, &_graph->node_list, next) {
+		if (graph_node->node->flags & (RTE_NODE_SOURCE_F | RTE_NODE_ORDERED_F))
+			continue;
+
+		/* Streams are stealable if no ordered node can be reached */
+		graph_mark_nodes_as_not_visited(_graph);
+		if (graph_bfs(_graph, graph_node))
+			return -rte_errno;
+
+		stealable = true;
+		STAILQ_FOREACH(tmp, &_graph->node_list, next)
+			if (tmp->visited && (tmp->node->flags & RTE_NODE_ORDERED_F))
+				stealable = false;
+
+		node = graph_node_name_to_ptr(graph, graph_node->node->name);
+		if (node == NULL)
+			SET_ERR_JMP(EINVAL, fail, "%s not found", graph_node->node->name);
+		node->ws.stealable = stealable;
+	}
+
+	return 0;
+fail:
+	return -rte_errno;
+}
+
 static int
 graph_fp_mem_populate(struct graph *graph)
 {
@@ -213,8 +278,10 @@ graph_fp_mem_populate(struct graph *graph)
 	if (graph_pcap_is_enable())
 		graph_pcap_init(graph);
 	graph_nodes_populate(graph);
-	rc = graph_node_nexts_populate(graph);
+	rc = graph_prof_init(graph);
+	rc |= graph_node_nexts_populate(graph);
 	rc |= graph_src_nodes_offset_populate(graph);
+	rc |= graph_nodes_ws_populate(graph);
 
 	return rc;
 }
@@ -256,7 +323,7 @@ graph_nodes_mem_destroy(struct rte_graph *graph)
 int
 graph_fp_mem_destroy(struct graph *graph)
 {
-	if (graph_pcap_is_enable())
+	if (graph->graph->pcap_enable)
 		graph_pcap_exit(graph->graph);
 
 	graph_nodes_mem_destroy(graph->graph);
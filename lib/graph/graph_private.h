@@ -58,6 +58,9 @@ struct node {
 	rte_node_t parent_id;	      /**< Parent node identifier. */
 	rte_edge_t nb_edges;	      /**< Number of edges from this node. */
 	struct rte_node_xstats *xstats;	      /**< Node specific xstats. */
+	struct rte_node_coalesce_param coalesce; /**< Stream coalescing policy. */
+	struct rte_bpf *pcap_filter;  /**< BPF filter of the captured packets. */
+	uint32_t pcap_sample_rate;    /**< Capture one packet out of the rate. */
 	char next_nodes[][RTE_NODE_NAMESIZE]; /**< Names of next nodes. */
 };
 
@@ -73,6 +76,32 @@ struct __rte_cache_aligned graph_mcore_dispatch_wq_node {
 	void *objs[RTE_GRAPH_BURST_SIZE];
 };
 
+/**
+ * @internal
+ *
+ * Structure that holds a stream shared by a graph.
+ * Used for work-stealing model.
+ */
+struct graph_ws_stream {
+	rte_graph_off_t node_off;
+	uint16_t nb_objs;
+	void *objs[RTE_GRAPH_WS_STREAM_SIZE];
+};
+
+/**
+ * @internal
+ *
+ * Bounded Chase-Lev deque of the streams shared by a graph: the owner graph
+ * pushes and pops at the bottom, the other graphs steal at the top.
+ * Used for work-stealing model.
+ */
+struct rte_graph_ws_deque {
+	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(int64_t) top;
+	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(int64_t) bottom;
+	uint32_t mask;
+	alignas(RTE_CACHE_LINE_SIZE) struct graph_ws_stream streams[];
+};
+
 /**
  * @internal
  *
@@ -125,6 +154,18 @@ struct graph {
 	/**< Number of packets to be captured per core. */
 	char pcap_filename[RTE_GRAPH_PCAP_FILE_SZ];
 	/**< pcap file name/path. */
+	uint32_t pcap_ring_size;
+	/**< Size of the ring of the captured packets waiting for the writer. */
+	bool prof_enable;
+	/**< Node profile enabled. */
+	uint8_t nb_pmu_events;
+	/**< Number of PMU events counted per node. */
+	char pmu_events[RTE_GRAPH_PMU_EVENTS_MAX][RTE_GRAPH_PMU_NAMESIZE];
+	/**< Names of the PMU events counted per node. */
+	rte_graph_off_t prof_start;
+	/**< Node profile memory start offset in graph reel. */
+	rte_graph_off_t held_start;
+	/**< Held streams list start offset in graph reel, 0 without coalescing. */
 	STAILQ_HEAD(gnode_list, graph_node) node_list;
 	/**< Nodes in a graph. */
 };
@@ -455,6 +496,52 @@ int graph_sched_wq_create(struct graph *_graph, struct graph *_parent_graph,
  */
 void graph_sched_wq_destroy(struct graph *_graph);
 
+/**
+ * @internal
+ *
+ * Create the graph deque of shared streams for work-stealing model,
+ * and add the graph to the run-queue of its parent graph.
+ *
+ * @param _graph
+ *   The graph object
+ * @param _parent_graph
+ *   The parent graph object which holds the run-queue head.
+ * @param prm
+ *   Graph parameter, includes model-specific parameters in this graph.
+ *
+ * @return
+ *   - 0: Success.
+ *   - <0: Graph deque related error.
+ */
+int graph_ws_create(struct graph *_graph, struct graph *_parent_graph,
+		    struct rte_graph_param *prm);
+
+/**
+ * @internal
+ *
+ * Destroy the graph deque of shared streams for work-stealing model,
+ * and remove the graph from its run-queue.
+ * The walks of all the graphs of the run-queue must be stopped.
+ *
+ * @param _graph
+ *   The graph object
+ */
+void graph_ws_destroy(struct graph *_graph);
+
+/**
+ * @internal
+ *
+ * Check if the run-queue held by a parent graph still has clones,
+ * for work-stealing model.
+ *
+ * @param _graph
+ *   The graph object
+ *
+ * @return
+ *   True if the graph holds a run-queue which is not empty.
+ */
+bool graph_ws_has_clones(struct graph *_graph);
+
 /**
  * @internal
  *
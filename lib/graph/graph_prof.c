@@ -0,0 +1,127 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#include <rte_bitops.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_errno.h>
+#ifdef RTE_LIB_PMU
+#include <rte_pmu.h>
+#endif
+
+#include "graph_pcap_private.h"
+#include "graph_prof_private.h"
+#include "graph_private.h"
+
+int
+graph_prof_config(struct graph *graph, const struct rte_graph_param *prm)
+{
+	uint8_t i;
+
+	graph->prof_enable = prm->prof_enable;
+	graph->nb_pmu_events = 0;
+	if (!prm->prof_enable || prm->nb_pmu_events == 0)
+		return 0;
+
+#ifndef RTE_LIB_PMU
+	SET_ERR_JMP(ENOTSUP, fail, "PMU library is not available");
+#endif
+	if (prm->nb_pmu_events > RTE_GRAPH_PMU_EVENTS_MAX || prm->pmu_events == NULL)
+		SET_ERR_JMP(EINVAL, fail, "Invalid PMU events");
+
+	for (i = 0; i < prm->nb_pmu_events; i++) {
+		if (prm->pmu_events[i] == NULL ||
+		    rte_strscpy(graph->pmu_events[i], prm->pmu_events[i],
+				RTE_GRAPH_PMU_NAMESIZE) < 0)
+			SET_ERR_JMP(EINVAL, fail, "Invalid PMU event %u", i);
+	}
+	graph->nb_pmu_events = prm->nb_pmu_events;
+
+	return 0;
+fail:
+	return -rte_errno;
+}
+
+int
+graph_prof_init(struct graph *graph)
+{
+	struct rte_graph *graph_data = graph->graph;
+
+	graph_data->prof_enable = graph->prof_enable;
+	graph_data->nb_pmu_events = 0;
+#ifdef RTE_LIB_PMU
+	if (graph->nb_pmu_events == 0)
+		return 0;
+
+	if (rte_pmu_init() < 0)
+		SET_ERR_JMP(ENOTSUP, fail, "Failed to initialize PMU library");
+
+	for (uint8_t i = 0; i < graph->nb_pmu_events; i++) {
+		int index = rte_pmu_add_event(graph->pmu_events[i]);
+
+		if (index < 0)
+			SET_ERR_JMP(-index, fail, "Failed to add PMU event %s",
+				    graph->pmu_events[i]);
+		graph_data->pmu_events[i] = index;
+	}
+	graph_data->nb_pmu_events = graph->nb_pmu_events;
+
+	return 0;
+fail:
+	return -rte_errno;
+#else
+	/* PMU events are rejected by graph_prof_config() */
+	return 0;
+#endif
+}
+
+static __rte_always_inline uint64_t
+graph_prof_pmu_read(unsigned int index)
+{
+#ifdef RTE_LIB_PMU
+	return rte_pmu_read(index);
+#else
+	RTE_SET_USED(index);
+	return 0;
+#endif
+}
+
+/* Bucket 0 for 0, bucket n for [2^(n-1), 2^n) */
+static __rte_always_inline unsigned int
+graph_prof_bucket(uint64_t val)
+{
+	if (val == 0)
+		return 0;
+
+	return RTE_MIN(64 - rte_clz64(val), RTE_GRAPH_HIST_BUCKETS - 1U);
+}
+
+uint16_t
+graph_prof_dispatch(struct rte_graph *graph, struct rte_node *node, void **objs,
+		    uint16_t nb_objs)
+{
+	struct rte_node_prof *prof = RTE_PTR_ADD(node, node->prof_off);
+	uint64_t pmu[RTE_GRAPH_PMU_EVENTS_MAX];
+	uint64_t start, cycles;
+	uint16_t rc;
+	uint8_t i;
+
+	for (i = 0; i < graph->nb_pmu_events; i++)
+		pmu[i] = graph_prof_pmu_read(graph->pmu_events[i]);
+	start = rte_rdtsc();
+
+	if (graph->pcap_enable)
+		rc = graph_pcap_dispatch(graph, node, objs, nb_objs);
+	else
+		rc = node->original_process(graph, node, objs, nb_objs);
+
+	cycles = rte_rdtsc() - start;
+	for (i = 0; i < graph->nb_pmu_events; i++)
+		prof->pmu[i] += graph_prof_pmu_read(graph->pmu_events[i]) - pmu[i];
+
+	prof->cycles_hist[graph_prof_bucket(cycles)]++;
+	prof->objs_hist[graph_prof_bucket(rc)]++;
+
+	return rc;
+}
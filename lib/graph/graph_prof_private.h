@@ -0,0 +1,62 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#ifndef _RTE_GRAPH_PROF_PRIVATE_H_
+#define _RTE_GRAPH_PROF_PRIVATE_H_
+
+#include <stdint.h>
+
+#include "graph_private.h"
+
+/**
+ * @internal
+ *
+ * Copy the node profile parameters to the graph object.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ * @param prm
+ *   Graph parameters.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+int graph_prof_config(struct graph *graph, const struct rte_graph_param *prm);
+
+/**
+ * @internal
+ *
+ * Register the PMU events of the graph to the PMU library and store their
+ * index in the graph fast path memory.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+int graph_prof_init(struct graph *graph);
+
+/**
+ * @internal
+ *
+ * Process function collecting the profile of a node when profile is enabled,
+ * it calls the original process function of the node.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ * @param node
+ *   Pointer to the node object.
+ * @param objs
+ *   Pointer to an array of objects to be processed.
+ * @param nb_objs
+ *   Number of objects in the array.
+ *
+ * @return
+ *   Number of objects processed.
+ */
+uint16_t graph_prof_dispatch(struct rte_graph *graph, struct rte_node *node, void **objs,
+			     uint16_t nb_objs);
+
+#endif /* _RTE_GRAPH_PROF_PRIVATE_H_ */
@@ -35,7 +35,7 @@ struct __rte_cache_aligned rte_graph_cluster_stats {
 	uint32_t cluster_node_size; /* Size of struct cluster_node */
 	rte_node_t max_nodes;
 	int socket_id;
-	bool dispatch;
+	uint8_t model;
 	void *cookie;
 
 	struct cluster_node clusters[];
@@ -75,16 +75,30 @@ print_banner_dispatch(FILE *f)
 }
 
 static inline void
-print_banner(FILE *f, bool dispatch)
+print_banner_ws(FILE *f)
 {
-	if (dispatch)
+	boarder_model_dispatch();
+	fprintf(f, "%-32s%-16s%-16s%-16s%-16s%-16s%-16s%-16s%-16s\n",
+		"|Node", "|calls",
+		"|objs", "|shared objs", "|stolen objs",
+		"|realloc_count", "|objs/call", "|objs/sec(10E6)",
+		"|cycles/call|");
+	boarder_model_dispatch();
+}
+
+static inline void
+print_banner(FILE *f, uint8_t model)
+{
+	if (model == RTE_GRAPH_MODEL_MCORE_DISPATCH)
 		print_banner_dispatch(f);
+	else if (model == RTE_GRAPH_MODEL_WORK_STEALING)
+		print_banner_ws(f);
 	else
 		print_banner_default(f);
 }
 
 static inline void
-print_node(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispatch)
+print_node(FILE *f, const struct rte_graph_cluster_node_stats *stat, uint8_t model)
 {
 	double objs_per_call, objs_per_sec, cycles_per_call, ts_per_hz;
 	const uint64_t prev_calls = stat->prev_calls;
@@ -104,7 +118,7 @@ print_node(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispat
 	objs_per_sec = ts_per_hz ? (objs - prev_objs) / ts_per_hz : 0;
 	objs_per_sec /= 1000000;
 
-	if (dispatch) {
+	if (model == RTE_GRAPH_MODEL_MCORE_DISPATCH) {
 		fprintf(f,
 			"|%-31s|%-15" PRIu64 "|%-15" PRIu64 "|%-15" PRIu64
 			"|%-15" PRIu64 "|%-15" PRIu64
@@ -112,6 +126,14 @@ print_node(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispat
 			stat->name, calls, objs, stat->dispatch.sched_objs,
 			stat->dispatch.sched_fail, stat->realloc_count, objs_per_call,
 			objs_per_sec, cycles_per_call);
+	} else if (model == RTE_GRAPH_MODEL_WORK_STEALING) {
+		fprintf(f,
+			"|%-31s|%-15" PRIu64 "|%-15" PRIu64 "|%-15" PRIu64
+			"|%-15" PRIu64 "|%-15" PRIu64
+			"|%-15.3f|%-15.6f|%-11.4f|\n",
+			stat->name, calls, objs, stat->ws.shared_objs,
+			stat->ws.stolen_objs, stat->realloc_count, objs_per_call,
+			objs_per_sec, cycles_per_call);
 	} else {
 		fprintf(f,
 			"|%-31s|%-15" PRIu64 "|%-15" PRIu64 "|%-15" PRIu64
@@ -122,11 +144,11 @@ print_node(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispat
 }
 
 static inline void
-print_xstat(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispatch)
+print_xstat(FILE *f, const struct rte_graph_cluster_node_stats *stat, uint8_t model)
 {
 	int i;
 
-	if (dispatch) {
+	if (model != RTE_GRAPH_MODEL_RTC) {
 		for (i = 0; i < stat->xstat_cntrs; i++)
 			fprintf(f,
 				"|\t%-24s|%15s|%-15" PRIu64 "|%15s|%15s|%15s|%15s|%15s|%11.4s|\n",
@@ -140,21 +162,74 @@ print_xstat(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispa
 	}
 }
 
+static inline void
+print_pmu(FILE *f, const struct rte_graph_cluster_node_stats *stat, uint8_t model)
+{
+	int i;
+
+	if (model != RTE_GRAPH_MODEL_RTC) {
+		for (i = 0; i < stat->pmu_cntrs; i++)
+			fprintf(f,
+				"|\t%-24s|%15s|%-15" PRIu64 "|%15s|%15s|%15s|%15s|%15s|%11.4s|\n",
+				stat->pmu_desc[i], "", stat->prof->pmu[i], "", "", "", "", "",
+				"");
+	} else {
+		for (i = 0; i < stat->pmu_cntrs; i++)
+			fprintf(f,
+				"|\t%-24s|%15s|%-15" PRIu64 "|%15s|%15.3s|%15.6s|%11.4s|\n",
+				stat->pmu_desc[i], "", stat->prof->pmu[i], "", "", "", "");
+	}
+}
+
+static inline void
+print_coalesce(FILE *f, const struct rte_graph_cluster_node_stats *stat, uint8_t model)
+{
+	const char *desc[] = {
+		"coalesce_held_walks", "coalesce_flushes", "coalesce_timeouts",
+		"coalesce_cycles/flush", "coalesce_fill_pct",
+	};
+	uint64_t val[RTE_DIM(desc)];
+	unsigned int i;
+
+	val[0] = stat->coalesce.held_walks;
+	val[1] = stat->coalesce.flushes;
+	val[2] = stat->coalesce.timeouts;
+	val[3] = stat->coalesce.flushes ? stat->coalesce.hold_cycles / stat->coalesce.flushes : 0;
+	/* Fill ratio of the streams processed, relative to the coalescing threshold */
+	val[4] = stat->calls ? stat->objs * 100 / (stat->calls * stat->coalesce.min_objs) : 0;
+
+	if (model != RTE_GRAPH_MODEL_RTC) {
+		for (i = 0; i < RTE_DIM(desc); i++)
+			fprintf(f,
+				"|\t%-24s|%15s|%-15" PRIu64 "|%15s|%15s|%15s|%15s|%15s|%11.4s|\n",
+				desc[i], "", val[i], "", "", "", "", "", "");
+	} else {
+		for (i = 0; i < RTE_DIM(desc); i++)
+			fprintf(f,
+				"|\t%-24s|%15s|%-15" PRIu64 "|%15s|%15.3s|%15.6s|%11.4s|\n",
+				desc[i], "", val[i], "", "", "", "");
+	}
+}
+
 static int
-graph_cluster_stats_cb(bool dispatch, bool is_first, bool is_last, void *cookie,
+graph_cluster_stats_cb(uint8_t model, bool is_first, bool is_last, void *cookie,
 		       const struct rte_graph_cluster_node_stats *stat)
 {
 	FILE *f = cookie;
 
 	if (unlikely(is_first))
-		print_banner(f, dispatch);
+		print_banner(f, model);
 	if (stat->objs) {
-		print_node(f, stat, dispatch);
+		print_node(f, stat, model);
 		if (stat->xstat_cntrs)
-			print_xstat(f, stat, dispatch);
+			print_xstat(f, stat, model);
+		if (stat->pmu_cntrs)
+			print_pmu(f, stat, model);
+		if (stat->coalesce.min_objs)
+			print_coalesce(f, stat, model);
 	}
 	if (unlikely(is_last)) {
-		if (dispatch)
+		if (model != RTE_GRAPH_MODEL_RTC)
 			boarder_model_dispatch();
 		else
 			boarder();
@@ -167,14 +242,23 @@ static int
 graph_cluster_stats_cb_rtc(bool is_first, bool is_last, void *cookie,
 			   const struct rte_graph_cluster_node_stats *stat)
 {
-	return graph_cluster_stats_cb(false, is_first, is_last, cookie, stat);
+	return graph_cluster_stats_cb(RTE_GRAPH_MODEL_RTC, is_first, is_last, cookie, stat);
 };
 
 static int
 graph_cluster_stats_cb_dispatch(bool is_first, bool is_last, void *cookie,
 				const struct rte_graph_cluster_node_stats *stat)
 {
-	return graph_cluster_stats_cb(true, is_first, is_last, cookie, stat);
+	return graph_cluster_stats_cb(RTE_GRAPH_MODEL_MCORE_DISPATCH, is_first, is_last,
+				      cookie, stat);
+};
+
+static int
+graph_cluster_stats_cb_ws(bool is_first, bool is_last, void *cookie,
+			  const struct rte_graph_cluster_node_stats *stat)
+{
+	return graph_cluster_stats_cb(RTE_GRAPH_MODEL_WORK_STEALING, is_first, is_last,
+				      cookie, stat);
 };
 
 static uint32_t
@@ -233,6 +317,8 @@ stats_mem_init(struct cluster *cluster,
 		const struct rte_graph *graph = cluster->graphs[0]->graph;
 		if (graph->model == RTE_GRAPH_MODEL_MCORE_DISPATCH)
 			fn = graph_cluster_stats_cb_dispatch;
+		else if (graph->model == RTE_GRAPH_MODEL_WORK_STEALING)
+			fn = graph_cluster_stats_cb_ws;
 		else
 			fn = graph_cluster_stats_cb_rtc;
 	}
@@ -255,10 +341,55 @@ stats_mem_init(struct cluster *cluster,
 	return stats;
 }
 
+static int
+stats_mem_prof_populate(struct rte_graph_cluster_stats *stats, struct graph *graph,
+			struct cluster_node *cluster)
+{
+	cluster->stat.prof = rte_zmalloc_socket(NULL, sizeof(struct rte_node_prof),
+						RTE_CACHE_LINE_SIZE, stats->socket_id);
+	if (cluster->stat.prof == NULL)
+		return -ENOMEM;
+
+	if (graph->nb_pmu_events == 0)
+		return 0;
+
+	cluster->stat.pmu_desc = rte_zmalloc_socket(NULL,
+		sizeof(graph->pmu_events[0]) * graph->nb_pmu_events,
+		RTE_CACHE_LINE_SIZE, stats->socket_id);
+	if (cluster->stat.pmu_desc == NULL) {
+		rte_free(cluster->stat.prof);
+		cluster->stat.prof = NULL;
+		return -ENOMEM;
+	}
+	memcpy(cluster->stat.pmu_desc, graph->pmu_events,
+	       sizeof(graph->pmu_events[0]) * graph->nb_pmu_events);
+	cluster->stat.pmu_cntrs = graph->nb_pmu_events;
+
+	return 0;
+}
+
+/* PMU counters are summed by slot, the graphs of a cluster must count the same events */
+static bool
+stats_pmu_events_match(const struct cluster_node *cluster, const struct graph *graph)
+{
+	uint8_t i;
+
+	if (cluster->stat.pmu_cntrs != graph->nb_pmu_events)
+		return false;
+
+	for (i = 0; i < graph->nb_pmu_events; i++)
+		if (strncmp(cluster->stat.pmu_desc[i], graph->pmu_events[i],
+			    RTE_GRAPH_PMU_NAMESIZE) != 0)
+			return false;
+
+	return true;
+}
+
 static int
 stats_mem_populate(struct rte_graph_cluster_stats *stats,
-		   struct rte_graph *graph, struct graph_node *graph_node)
+		   struct graph *_graph, struct graph_node *graph_node)
 {
+	struct rte_graph *graph = _graph->graph;
 	rte_node_t id = graph_node->node->id;
 	struct cluster_node *cluster;
 	struct rte_node *node;
@@ -278,7 +409,17 @@ stats_mem_populate(struct rte_graph_cluster_stats *stats,
 					"Failed to find node %s in graph %s",
 					graph_node->node->name, graph->name);
 
+			if (_graph->prof_enable && cluster->stat.prof != NULL &&
+			    !stats_pmu_events_match(cluster, _graph))
+				SET_ERR_JMP(EINVAL, err,
+					    "PMU events of graph %s differ from its cluster",
+					    graph->name);
+
 			cluster->nodes[cluster->nb_nodes++] = node;
+			if (_graph->prof_enable && cluster->stat.prof == NULL &&
+			    stats_mem_prof_populate(stats, _graph, cluster))
+				SET_ERR_JMP(ENOMEM, err, "Failed to allocate memory node %s graph %s",
+					    graph_node->node->name, graph->name);
 			return 0;
 		}
 		cluster = RTE_PTR_ADD(cluster, stats->cluster_node_size);
@@ -323,6 +464,15 @@ stats_mem_populate(struct rte_graph_cluster_stats *stats,
 		}
 	}
 
+	if (_graph->prof_enable && stats_mem_prof_populate(stats, _graph, cluster)) {
+		if (cluster->stat.xstat_cntrs) {
+			rte_free(cluster->stat.xstat_count);
+			rte_free(cluster->stat.xstat_desc);
+		}
+		SET_ERR_JMP(ENOMEM, err, "Failed to allocate memory node %s graph %s",
+			    graph_node->node->name, graph->name);
+	}
+
 	stats->max_nodes++;
 
 	return 0;
@@ -433,12 +583,11 @@ rte_graph_cluster_stats_create(const struct rte_graph_cluster_stats_param *prm)
 
 		graph = cluster.graphs[i];
 		STAILQ_FOREACH(graph_node, &graph->node_list, next) {
-			struct rte_graph *graph_fp = graph->graph;
-			if (stats_mem_populate(stats, graph_fp, graph_node))
+			if (stats_mem_populate(stats, graph, graph_node))
 				goto realloc_fail;
 		}
-		if (graph->graph->model == RTE_GRAPH_MODEL_MCORE_DISPATCH)
-			stats->dispatch = true;
+		if (graph->graph->model != RTE_GRAPH_MODEL_RTC)
+			stats->model = graph->graph->model;
 	}
 
 	rc = stats;
@@ -467,6 +616,8 @@ rte_graph_cluster_stats_destroy(struct rte_graph_cluster_stats *stat)
 			rte_free(cluster->stat.xstat_count);
 			rte_free(cluster->stat.xstat_desc);
 		}
+		rte_free(cluster->stat.prof);
+		rte_free(cluster->stat.pmu_desc);
 
 		cluster = RTE_PTR_ADD(cluster, stat->cluster_node_size);
 	}
@@ -474,11 +625,13 @@ rte_graph_cluster_stats_destroy(struct rte_graph_cluster_stats *stat)
 }
 
 static inline void
-cluster_node_arregate_stats(struct cluster_node *cluster, bool dispatch)
+cluster_node_arregate_stats(struct cluster_node *cluster, uint8_t model)
 {
 	uint64_t calls = 0, cycles = 0, objs = 0, realloc_count = 0;
 	struct rte_graph_cluster_node_stats *stat = &cluster->stat;
 	uint64_t sched_objs = 0, sched_fail = 0;
+	const struct rte_node_prof *prof;
+	uint64_t shared_objs = 0, stolen_objs = 0;
 	struct rte_node *node;
 	rte_node_t count;
 	uint64_t *xstat;
@@ -486,12 +639,18 @@ cluster_node_arregate_stats(struct cluster_node *cluster, bool dispatch)
 
 	if (stat->xstat_cntrs != 0)
 		memset(stat->xstat_count, 0, sizeof(uint64_t) * stat->xstat_cntrs);
+	if (stat->prof != NULL)
+		memset(stat->prof, 0, sizeof(*stat->prof));
+	memset(&stat->coalesce, 0, sizeof(stat->coalesce));
 	for (count = 0; count < cluster->nb_nodes; count++) {
 		node = cluster->nodes[count];
 
-		if (dispatch) {
+		if (model == RTE_GRAPH_MODEL_MCORE_DISPATCH) {
 			sched_objs += node->dispatch.total_sched_objs;
 			sched_fail += node->dispatch.total_sched_fail;
+		} else if (model == RTE_GRAPH_MODEL_WORK_STEALING) {
+			shared_objs += node->ws.total_shared_objs;
+			stolen_objs += node->ws.total_stolen_objs;
 		}
 
 		calls += node->total_calls;
@@ -499,6 +658,24 @@ cluster_node_arregate_stats(struct cluster_node *cluster, bool dispatch)
 		cycles += node->total_cycles;
 		realloc_count += node->realloc_count;
 
+		if (node->coalesce.min_objs != 0) {
+			stat->coalesce.min_objs = node->coalesce.min_objs;
+			stat->coalesce.held_walks += node->coalesce.total_held_walks;
+			stat->coalesce.hold_cycles += node->coalesce.total_hold_cycles;
+			stat->coalesce.flushes += node->coalesce.total_flushes;
+			stat->coalesce.timeouts += node->coalesce.total_timeouts;
+		}
+
+		if (stat->prof != NULL && node->prof_off != 0) {
+			prof = RTE_PTR_ADD(node, node->prof_off);
+			for (i = 0; i < RTE_GRAPH_HIST_BUCKETS; i++) {
+				stat->prof->cycles_hist[i] += prof->cycles_hist[i];
+				stat->prof->objs_hist[i] += prof->objs_hist[i];
+			}
+			for (i = 0; i < stat->pmu_cntrs; i++)
+				stat->prof->pmu[i] += prof->pmu[i];
+		}
+
 		if (node->xstat_off == 0)
 			continue;
 		xstat = RTE_PTR_ADD(node, node->xstat_off);
@@ -510,9 +687,12 @@ cluster_node_arregate_stats(struct cluster_node *cluster, bool dispatch)
 	stat->objs = objs;
 	stat->cycles = cycles;
 
-	if (dispatch) {
+	if (model == RTE_GRAPH_MODEL_MCORE_DISPATCH) {
 		stat->dispatch.sched_objs = sched_objs;
 		stat->dispatch.sched_fail = sched_fail;
+	} else if (model == RTE_GRAPH_MODEL_WORK_STEALING) {
+		stat->ws.shared_objs = shared_objs;
+		stat->ws.stolen_objs = stolen_objs;
 	}
 
 	stat->ts = rte_get_timer_cycles();
@@ -541,7 +721,7 @@ rte_graph_cluster_stats_get(struct rte_graph_cluster_stats *stat, bool skip_cb)
 	cluster = stat->clusters;
 
 	for (count = 0; count < stat->max_nodes; count++) {
-		cluster_node_arregate_stats(cluster, stat->dispatch);
+		cluster_node_arregate_stats(cluster, stat->model);
 		if (!skip_cb)
 			rc = stat->fn(!count, (count == stat->max_nodes - 1),
 				      stat->cookie, &cluster->stat);
@@ -576,6 +756,9 @@ rte_graph_cluster_stats_reset(struct rte_graph_cluster_stats *stat)
 		node->realloc_count = 0;
 		for (i = 0; i < node->xstat_cntrs; i++)
 			node->xstat_count[i] = 0;
+		if (node->prof != NULL)
+			memset(node->prof, 0, sizeof(*node->prof));
+		memset(&node->coalesce, 0, sizeof(node->coalesce));
 		cluster = RTE_PTR_ADD(cluster, stat->cluster_node_size);
 	}
 }
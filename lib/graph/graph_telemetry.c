@@ -0,0 +1,111 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <rte_string_fns.h>
+#include <rte_telemetry.h>
+
+#include "graph_private.h"
+
+static int
+graph_handle_list(const char *cmd __rte_unused, const char *params __rte_unused,
+		  struct rte_tel_data *d)
+{
+	struct graph_head *graph_head = graph_list_head_get();
+	struct graph *graph;
+
+	rte_tel_data_start_array(d, RTE_TEL_STRING_VAL);
+
+	graph_spinlock_lock();
+	STAILQ_FOREACH(graph, graph_head, next)
+		rte_tel_data_add_array_string(d, graph->name);
+	graph_spinlock_unlock();
+
+	return 0;
+}
+
+static int
+graph_tel_hist_add(struct rte_tel_data *d, const char *name, const uint64_t *hist)
+{
+	struct rte_tel_data *c;
+	unsigned int i;
+
+	c = rte_tel_data_alloc();
+	if (c == NULL)
+		return -ENOMEM;
+
+	rte_tel_data_start_array(c, RTE_TEL_UINT_VAL);
+	for (i = 0; i < RTE_GRAPH_HIST_BUCKETS; i++)
+		rte_tel_data_add_array_uint(c, hist[i]);
+
+	return rte_tel_data_add_dict_container(d, name, c, 0);
+}
+
+static int
+graph_handle_node_stats(const char *cmd __rte_unused, const char *params,
+			struct rte_tel_data *d)
+{
+	struct graph_head *graph_head = graph_list_head_get();
+	char *graph_name, *node_name, *args;
+	const struct rte_node_prof *prof;
+	struct rte_node *node = NULL;
+	struct graph *graph;
+	int rc = -EINVAL;
+	unsigned int i;
+
+	if (params == NULL || strlen(params) == 0)
+		return -EINVAL;
+
+	args = strdup(params);
+	if (args == NULL)
+		return -ENOMEM;
+
+	graph_name = strtok(args, ",");
+	node_name = strtok(NULL, ",");
+	if (graph_name == NULL || node_name == NULL)
+		goto free;
+
+	graph_spinlock_lock();
+	STAILQ_FOREACH(graph, graph_head, next) {
+		if (strncmp(graph->name, graph_name, RTE_GRAPH_NAMESIZE) == 0) {
+			node = graph_node_name_to_ptr(graph->graph, node_name);
+			break;
+		}
+	}
+	if (node == NULL)
+		goto unlock;
+
+	rte_tel_data_start_dict(d);
+	rte_tel_data_add_dict_uint(d, "calls", node->total_calls);
+	rte_tel_data_add_dict_uint(d, "objs", node->total_objs);
+	rte_tel_data_add_dict_uint(d, "cycles", node->total_cycles);
+	rte_tel_data_add_dict_uint(d, "realloc_count", node->realloc_count);
+
+	rc = 0;
+	if (node->prof_off == 0)
+		goto unlock;
+
+	prof = RTE_PTR_ADD(node, node->prof_off);
+	rc = graph_tel_hist_add(d, "cycles_hist", prof->cycles_hist);
+	if (rc == 0)
+		rc = graph_tel_hist_add(d, "objs_hist", prof->objs_hist);
+	for (i = 0; rc == 0 && i < graph->nb_pmu_events; i++)
+		rte_tel_data_add_dict_uint(d, graph->pmu_events[i], prof->pmu[i]);
+
+unlock:
+	graph_spinlock_unlock();
+free:
+	free(args);
+	return rc;
+}
+
+RTE_INIT(graph_init_telemetry)
+{
+	rte_telemetry_register_cmd("/graph/list", graph_handle_list,
+		"Returns list of graphs. Takes no parameters");
+	rte_telemetry_register_cmd("/graph/node_stats", graph_handle_node_stats,
+		"Returns the stats of a node of a graph. Parameters: graph_name,node_name");
+}
@@ -13,7 +13,7 @@
 #include <rte_errno.h>
 #include <rte_string_fns.h>
 
-#include "graph_private.h"
+#include "graph_pcap_private.h"
 
 static struct node_head node_list = STAILQ_HEAD_INITIALIZER(node_list);
 
@@ -517,6 +517,62 @@ node_override_process_func(rte_node_t id, rte_node_process_t process)
 	return -1;
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_coalesce_set, 25.11)
+int
+rte_node_coalesce_set(rte_node_t id, const struct rte_node_coalesce_param *prm)
+{
+	struct node *node;
+	int rc = -EINVAL;
+
+	if (node_from_id(id) == NULL || prm == NULL)
+		goto fail;
+
+	if (prm->min_objs != 0 && prm->max_walks == 0 && prm->max_ns == 0)
+		goto fail;
+
+	graph_spinlock_lock();
+	STAILQ_FOREACH(node, &node_list, next) {
+		if (id == node->id) {
+			if (!(node->flags & RTE_NODE_SOURCE_F)) {
+				node->coalesce = *prm;
+				rc = 0;
+			}
+			break;
+		}
+	}
+	graph_spinlock_unlock();
+fail:
+	return rc;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_pcap_set, 25.11)
+int
+rte_node_pcap_set(rte_node_t id, const struct rte_node_pcap_param *prm)
+{
+	struct node *node;
+	int rc = -EINVAL;
+
+	if (node_from_id(id) == NULL || prm == NULL)
+		goto fail;
+
+	graph_spinlock_lock();
+	STAILQ_FOREACH(node, &node_list, next) {
+		if (id == node->id) {
+			if (graph_is_node_active_in_graph(node)) {
+				rc = -EBUSY;
+				break;
+			}
+			rc = graph_pcap_filter_set(node, prm->filter);
+			if (rc == 0)
+				node->pcap_sample_rate = prm->sample_rate;
+			break;
+		}
+	}
+	graph_spinlock_unlock();
+fail:
+	return rc;
+}
+
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_free, 25.07)
 int
 rte_node_free(rte_node_t id)
@@ -532,6 +588,7 @@ rte_node_free(rte_node_t id)
 		if (id == node->id) {
 			if (!graph_is_node_active_in_graph(node)) {
 				STAILQ_REMOVE(&node_list, node, node, next);
+				graph_pcap_filter_free(node);
 				free(node);
 				rc = 0;
 			}
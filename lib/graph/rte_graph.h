@@ -32,6 +32,9 @@ extern "C" {
 #define RTE_NODE_NAMESIZE 64  /**< Max length of node name. */
 #define RTE_NODE_XSTAT_DESC_SIZE 64  /**< Max length of node xstat description. */
 #define RTE_GRAPH_PCAP_FILE_SZ 64 /**< Max length of pcap file name. */
+#define RTE_GRAPH_HIST_BUCKETS 32 /**< Number of buckets of node histograms. */
+#define RTE_GRAPH_PMU_EVENTS_MAX 4 /**< Max number of PMU events counted per node. */
+#define RTE_GRAPH_PMU_NAMESIZE 64 /**< Max length of PMU event name. */
 #define RTE_GRAPH_OFF_INVALID UINT32_MAX /**< Invalid graph offset. */
 #define RTE_NODE_ID_INVALID UINT32_MAX   /**< Invalid node id. */
 #define RTE_EDGE_ID_INVALID UINT16_MAX   /**< Invalid edge id. */
@@ -71,6 +74,7 @@ struct rte_node;  /**< Node object */
 struct rte_graph; /**< Graph object */
 struct rte_graph_cluster_stats;      /**< Stats for Cluster of graphs */
 struct rte_graph_cluster_node_stats; /**< Node stats within cluster of graphs */
+struct rte_bpf_prm; /**< BPF program parameters */
 
 /**
  * Node process function.
@@ -174,6 +178,18 @@ struct rte_graph_param {
 	bool pcap_enable; /**< Pcap enable. */
 	uint64_t num_pkt_to_capture; /**< Number of packets to capture. */
 	char *pcap_filename; /**< Filename in which packets to be captured.*/
+	uint32_t pcap_ring_size;
+	/**< Number of captured packets waiting for rte_graph_pcap_write(),
+	 * rounded up to a power of 2. 0 to write the packets to the capture
+	 * file in the graph walk.
+	 */
+
+	bool prof_enable; /**< Node histograms and PMU counters enable. */
+	uint8_t nb_pmu_events; /**< Number of PMU events counted per node. */
+	const char **pmu_events;
+	/**< Array of PMU event names, as listed by the PMU library.
+	 * The graphs of a stats cluster must count the same events in the same order.
+	 */
 
 	union {
 		struct {
@@ -185,6 +201,12 @@ struct rte_graph_param {
 			packets_enqueued_cb notify_cb;
 			uint64_t cb_priv;
 		} dispatch;
+		struct {
+			uint32_t dq_size;
+			/**< Number of streams the graph can share for work-stealing model.
+			 * Default is RTE_GRAPH_WS_DQ_SIZE if zero.
+			 */
+		} ws;
 	};
 };
 
@@ -209,6 +231,20 @@ struct rte_graph_cluster_stats_param {
 	/**< Array of graph patterns based on shell pattern. */
 };
 
+/**
+ * Node profile data structure, collected when
+ * struct rte_graph_param::prof_enable is set.
+ *
+ * The bucket 0 of a histogram counts the calls with a value of 0,
+ * the bucket n counts the calls with a value in [2^(n-1), 2^n),
+ * the last bucket also counts the calls with a larger value.
+ */
+struct rte_node_prof {
+	uint64_t cycles_hist[RTE_GRAPH_HIST_BUCKETS]; /**< Calls by cycles per call. */
+	uint64_t objs_hist[RTE_GRAPH_HIST_BUCKETS];   /**< Calls by objs per call. */
+	uint64_t pmu[RTE_GRAPH_PMU_EVENTS_MAX];       /**< Total count of each PMU event. */
+};
+
 /**
  * Node cluster stats data structure.
  *
@@ -232,6 +268,12 @@ struct __rte_cache_aligned rte_graph_cluster_node_stats {
 			uint64_t sched_fail;
 			/**< Previous number of failed schedule objs for dispatch model. */
 		} dispatch;
+		struct {
+			uint64_t shared_objs;
+			/**< Number of objs shared for stealing in work-stealing model. */
+			uint64_t stolen_objs;
+			/**< Number of objs stolen from other graphs in work-stealing model. */
+		} ws;
 	};
 
 	uint64_t realloc_count; /**< Realloc count. */
@@ -240,6 +282,18 @@ struct __rte_cache_aligned rte_graph_cluster_node_stats {
 	char (*xstat_desc)[RTE_NODE_XSTAT_DESC_SIZE]; /**< Names of the Node xstat counters. */
 	uint64_t *xstat_count;			      /**< Total stat count per each xstat. */
 
+	uint8_t pmu_cntrs;			   /**< Number of PMU counters. */
+	char (*pmu_desc)[RTE_GRAPH_PMU_NAMESIZE];  /**< Names of the PMU events. */
+	struct rte_node_prof *prof;		   /**< Profile, NULL if not enabled. */
+
+	struct {
+		uint16_t min_objs;    /**< Objects to process without holding, 0 if disabled. */
+		uint64_t held_walks;  /**< Number of walks streams were held. */
+		uint64_t hold_cycles; /**< Cycles held streams waited. */
+		uint64_t flushes;     /**< Number of held streams processed. */
+		uint64_t timeouts;    /**< Number of held streams processed under-filled. */
+	} coalesce; /**< Stream coalescing stats. */
+
 	rte_node_t id;	/**< Node identifier of stats. */
 	uint64_t hz;	/**< Cycles per seconds. */
 	char name[RTE_NODE_NAMESIZE];	/**< Name of the node. */
@@ -266,11 +320,16 @@ rte_graph_t rte_graph_create(const char *name, struct rte_graph_param *prm);
  *
  * Free Graph memory reel.
  *
+ * For work-stealing model, the walks of all the graphs cloned from the same
+ * parent must be stopped, as they may steal from the destroyed graph.
+ * The parent graph can only be destroyed after its clones.
+ *
  * @param id
  *   id of the graph to destroy.
  *
  * @return
  *   0 on success, error otherwise.
+ *   -EBUSY if the clones of a work-stealing graph are not destroyed.
  */
 int rte_graph_destroy(rte_graph_t id);
 
@@ -280,6 +339,8 @@ int rte_graph_destroy(rte_graph_t id);
  * Clone a graph from static graph (graph created from rte_graph_create()). And
  * all cloned graphs attached to the parent graph MUST be destroyed together
  * for fast schedule design limitation (stop ALL graph walk firstly).
+ * For work-stealing model, the other clones of the parent graph must not be
+ * walked while a graph is cloned or destroyed.
  *
  * @param id
  *   Static graph id to clone from.
@@ -330,6 +391,28 @@ char *rte_graph_id_to_name(rte_graph_t id);
  */
 int rte_graph_export(const char *name, FILE *f);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Write to the capture file the packets captured by the graphs created with a
+ * ``pcap_ring_size``.
+ *
+ * The graph walks only copy the captured packets, which are written by this
+ * function, meant to be called in a loop by a dedicated lcore. Only one lcore
+ * can call it at a time. The destruction of the last graph capturing packets
+ * waits for a running call to return, the next calls return -ENOENT.
+ *
+ * @param nb_pkts
+ *   Maximum number of packets to write.
+ *
+ * @return
+ *   Number of packets written on success, -ENOENT if no graph captures packets
+ *   for this function, -EIO if the capture file cannot be written.
+ */
+__rte_experimental
+int rte_graph_pcap_write(uint16_t nb_pkts);
+
 /**
  * Bind graph with specific lcore for mcore dispatch model.
  *
@@ -496,6 +579,8 @@ struct rte_node_register {
 	char name[RTE_NODE_NAMESIZE]; /**< Name of the node. */
 	uint64_t flags;		      /**< Node configuration flag. */
 #define RTE_NODE_SOURCE_F (1ULL << 0) /**< Node type is source. */
+#define RTE_NODE_ORDERED_F (1ULL << 1)
+/**< Node needs the objects of a flow in order. Used by work-stealing model. */
 	rte_node_process_t process; /**< Node process function. */
 	rte_node_init_t init;       /**< Node init function. */
 	rte_node_fini_t fini;       /**< Node fini function. */
@@ -688,6 +773,77 @@ rte_node_is_invalid(rte_node_t id)
 __rte_experimental
 int rte_node_free(rte_node_t id);
 
+/**
+ * Stream coalescing parameters of a node.
+ *
+ * A pending stream of the node with less than ``min_objs`` objects is held
+ * back to the next graph walks, until it reaches ``min_objs`` objects or it is
+ * held for ``max_walks`` walks or ``max_ns`` nanoseconds.
+ *
+ * @see rte_node_coalesce_set()
+ */
+struct rte_node_coalesce_param {
+	uint16_t min_objs;  /**< Number of objects processed without holding, 0 to disable. */
+	uint16_t max_walks; /**< Maximum number of walks a stream is held, 0 for no limit. */
+	uint64_t max_ns;    /**< Maximum time a stream is held, 0 for no limit. */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Set the stream coalescing policy of a node, applied to the graphs created
+ * afterwards. The streams are only held by the walk of the RTC and
+ * work-stealing models.
+ *
+ * @param id
+ *   Node id, not a source node.
+ * @param prm
+ *   Coalescing parameters, at least one of ``max_walks`` and ``max_ns`` must
+ *   bound the hold time when ``min_objs`` is not 0.
+ *
+ * @return
+ *   0 on success, -EINVAL on invalid parameters.
+ */
+__rte_experimental
+int rte_node_coalesce_set(rte_node_t id, const struct rte_node_coalesce_param *prm);
+
+/**
+ * Packet capture parameters of a node.
+ *
+ * @see rte_node_pcap_set()
+ */
+struct rte_node_pcap_param {
+	const struct rte_bpf_prm *filter;
+	/**< BPF program with a RTE_BPF_ARG_PTR_MBUF argument, the packets for
+	 * which it returns 0 are not captured. NULL to capture all the packets.
+	 */
+	uint32_t sample_rate;
+	/**< Capture one packet out of sample_rate passing the filter,
+	 * 0 or 1 to capture all of them.
+	 */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Set the packet capture parameters of a node, applied to the graphs created
+ * afterwards with pcap enabled. The parameters cannot be changed while the
+ * node is part of a graph.
+ *
+ * @param id
+ *   Node id.
+ * @param prm
+ *   Capture parameters.
+ *
+ * @return
+ *   0 on success, -EINVAL on invalid parameters, -EBUSY if the node is part of
+ *   a graph, -ENOTSUP if a filter is given and the BPF library is not available.
+ */
+__rte_experimental
+int rte_node_pcap_set(rte_node_t id, const struct rte_node_pcap_param *prm);
+
 /**
  * Test the validity of edge id.
  *
@@ -128,6 +128,19 @@ struct __rte_cache_aligned rte_graph_feature_arc {
 	/** Slow path bit mask per feature per index */
 	uint64_t *feature_bit_mask_by_index;
 
+	/**
+	 * Slow path first feature data of the generic chain per index, replaced
+	 * in fast path by the specialized chain of the index.
+	 * RTE_GRAPH_FEATURE_DATA_INVALID if the index uses the generic chain
+	 */
+	rte_graph_feature_data_t *generic_first_fdata_by_index;
+
+	/** First feature data of the specialized chains */
+	rte_graph_feature_data_t specialized_fdata_start;
+
+	/** Number of feature data of the specialized chain of an index */
+	uint16_t specialized_chain_size;
+
 	/** Cache aligned fast path variables */
 	alignas(RTE_CACHE_LINE_SIZE) RTE_MARKER fast_path_variables;
 
@@ -201,6 +214,22 @@ struct __rte_cache_aligned rte_graph_feature_arc {
 	 *	+----------------------------------------+ | feature_size
 	 *	|  struct rte_graph_feature_data[Index1] | |
 	 *	+----------------------------------------+ v
+	 *
+	 *	3. specialized chain of struct rte_graph_feature_data per index
+	 *	+----------------------------------------+ ^ <- Index0 (cache aligned)
+	 *	|  struct rte_graph_feature_data[Start]  | |
+	 *	+----------------------------------------+ | specialized_chain_size
+	 *	|  struct rte_graph_feature_data[Feat0]  | |
+	 *	+----------------------------------------+ |
+	 *	|         ...            ....            | |
+	 *	+----------------------------------------+ v <- Index1 (cache aligned)
+	 *	|         ...            ....            |
+	 *	+----------------------------------------+
+	 *
+	 *	The specialized chain of an index holds copies of the feature data
+	 *	of its enabled features in order, so that all the hops of a packet
+	 *	read the same cache lines. The first feature data of the index
+	 *	points to it while the enabled features are unchanged.
 	 */
 	RTE_MARKER8 fp_arc_data;
 };
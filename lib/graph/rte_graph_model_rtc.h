@@ -39,8 +39,12 @@ rte_graph_walk_rtc(struct rte_graph *graph)
 	 */
 	while (likely(head != graph->tail)) {
 		node = (struct rte_node *)RTE_PTR_ADD(graph, cir_start[(int32_t)head++]);
-		__rte_node_process(graph, node);
+		if (!(graph->coalesce && __rte_node_coalesce_hold(graph, node)))
+			__rte_node_process(graph, node);
 		head = likely((int32_t)head > 0) ? head & mask : head;
 	}
 	graph->tail = 0;
+
+	if (unlikely(graph->nb_held != 0))
+		__rte_graph_coalesce_restore(graph);
 }
@@ -0,0 +1,286 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#include <rte_malloc.h>
+
+#include "graph_private.h"
+#include <eal_export.h>
+#include "rte_graph_model_work_stealing.h"
+
+/* Maximum number of streams stolen by an idle graph in a walk */
+#define GRAPH_WS_STEAL_MAX 8
+
+int
+graph_ws_create(struct graph *_graph, struct graph *_parent_graph,
+		struct rte_graph_param *prm)
+{
+	struct rte_graph *parent_graph = _parent_graph->graph;
+	struct rte_graph *graph = _graph->graph;
+	uint32_t dq_size = RTE_GRAPH_WS_DQ_SIZE;
+	struct rte_graph_ws_deque *dq;
+
+	if (prm->ws.dq_size > 0)
+		dq_size = rte_align32pow2(prm->ws.dq_size);
+
+	dq = rte_zmalloc_socket(graph->name,
+				sizeof(*dq) + dq_size * sizeof(dq->streams[0]),
+				RTE_CACHE_LINE_SIZE, graph->socket);
+	if (dq == NULL)
+		SET_ERR_JMP(ENOMEM, fail, "Failed to allocate graph deque");
+	dq->mask = dq_size - 1;
+
+	graph->ws.dq = dq;
+	graph->ws.victim = NULL;
+	graph->ws.idle = false;
+
+	if (parent_graph->ws.rq == NULL) {
+		parent_graph->ws.rq = &parent_graph->ws.rq_head;
+		SLIST_INIT(parent_graph->ws.rq);
+		parent_graph->ws.nb_idle = &parent_graph->ws.idle_count;
+	}
+
+	graph->ws.rq = parent_graph->ws.rq;
+	graph->ws.nb_idle = parent_graph->ws.nb_idle;
+	SLIST_INSERT_HEAD(graph->ws.rq, graph, next);
+
+	return 0;
+
+fail:
+	return -rte_errno;
+}
+
+bool
+graph_ws_has_clones(struct graph *_graph)
+{
+	struct rte_graph *graph = _graph->graph;
+
+	return graph != NULL && graph->ws.rq == &graph->ws.rq_head &&
+		!SLIST_EMPTY(graph->ws.rq);
+}
+
+void
+graph_ws_destroy(struct graph *_graph)
+{
+	struct rte_graph *graph = _graph->graph;
+	struct rte_graph *other;
+
+	if (graph == NULL || graph->ws.dq == NULL)
+		return;
+
+	/* The run-queue and the victims are not protected against the walks
+	 * of the other graphs, which may be stealing from this one: all the
+	 * walks must be stopped.
+	 */
+	SLIST_REMOVE(graph->ws.rq, graph, rte_graph, next);
+	SLIST_FOREACH(other, graph->ws.rq, next)
+		if (other->ws.victim == graph)
+			other->ws.victim = NULL;
+
+	if (graph->ws.idle)
+		rte_atomic_fetch_sub_explicit(graph->ws.nb_idle, 1, rte_memory_order_relaxed);
+
+	rte_free(graph->ws.dq);
+	graph->ws.dq = NULL;
+}
+
+/* Push a stream at the bottom of the deque, only called by the owner graph */
+static __rte_always_inline bool
+ws_dq_push(struct rte_graph_ws_deque *dq, const struct rte_node *node, void **objs,
+	   uint16_t nb_objs)
+{
+	int64_t b = rte_atomic_load_explicit(&dq->bottom, rte_memory_order_relaxed);
+	int64_t t = rte_atomic_load_explicit(&dq->top, rte_memory_order_acquire);
+	struct graph_ws_stream *stream;
+
+	if (b - t > (int64_t)dq->mask)
+		return false;
+
+	stream = &dq->streams[b & dq->mask];
+	stream->node_off = node->off;
+	stream->nb_objs = nb_objs;
+	rte_memcpy(stream->objs, objs, nb_objs * sizeof(void *));
+
+	rte_atomic_thread_fence(rte_memory_order_release);
+	rte_atomic_store_explicit(&dq->bottom, b + 1, rte_memory_order_relaxed);
+
+	return true;
+}
+
+/* Pop the stream at the bottom of the deque, only called by the owner graph */
+static __rte_always_inline struct graph_ws_stream *
+ws_dq_pop(struct rte_graph_ws_deque *dq)
+{
+	int64_t b = rte_atomic_load_explicit(&dq->bottom, rte_memory_order_relaxed) - 1;
+	struct graph_ws_stream *stream = NULL;
+	int64_t t;
+
+	rte_atomic_store_explicit(&dq->bottom, b, rte_memory_order_relaxed);
+	rte_atomic_thread_fence(rte_memory_order_seq_cst);
+	t = rte_atomic_load_explicit(&dq->top, rte_memory_order_relaxed);
+
+	if (t > b) {
+		/* Empty */
+		rte_atomic_store_explicit(&dq->bottom, b + 1, rte_memory_order_relaxed);
+		return NULL;
+	}
+
+	stream = &dq->streams[b & dq->mask];
+	if (t == b) {
+		/* Last stream, race with the thieves */
+		if (!rte_atomic_compare_exchange_strong_explicit(&dq->top, &t, t + 1,
+				rte_memory_order_seq_cst, rte_memory_order_relaxed))
+			stream = NULL;
+		rte_atomic_store_explicit(&dq->bottom, b + 1, rte_memory_order_relaxed);
+	}
+
+	return stream;
+}
+
+/*
+ * Steal the stream at the top of the deque, called by the other graphs.
+ * The stream is copied before being claimed, as the owner can reuse its entry
+ * as soon as the top moves.
+ */
+static __rte_always_inline bool
+ws_dq_steal(struct rte_graph_ws_deque *dq, struct graph_ws_stream *stream)
+{
+	int64_t t = rte_atomic_load_explicit(&dq->top, rte_memory_order_acquire);
+	const struct graph_ws_stream *top;
+	int64_t b;
+
+	rte_atomic_thread_fence(rte_memory_order_seq_cst);
+	b = rte_atomic_load_explicit(&dq->bottom, rte_memory_order_acquire);
+	if (t >= b)
+		return false;
+
+	top = &dq->streams[t & dq->mask];
+	stream->node_off = top->node_off;
+	stream->nb_objs = RTE_MIN(top->nb_objs, RTE_GRAPH_WS_STREAM_SIZE);
+	rte_memcpy(stream->objs, top->objs, stream->nb_objs * sizeof(void *));
+
+	return rte_atomic_compare_exchange_strong_explicit(&dq->top, &t, t + 1,
+			rte_memory_order_seq_cst, rte_memory_order_relaxed);
+}
+
+/* Process the streams enqueued since the graph walk, without sharing them */
+static void
+ws_pending_walk(struct rte_graph *graph)
+{
+	const rte_graph_off_t *cir_start = graph->cir_start;
+	const uint32_t mask = graph->cir_mask;
+	struct rte_node *node;
+	uint32_t head = 0;
+
+	while (head != graph->tail) {
+		node = (struct rte_node *)RTE_PTR_ADD(graph, cir_start[head++]);
+		__rte_node_process(graph, node);
+		head &= mask;
+	}
+
+	graph->tail = 0;
+}
+
+static struct rte_node *
+ws_stream_process(struct rte_graph *graph, const struct graph_ws_stream *stream)
+{
+	struct rte_node *node = RTE_PTR_ADD(graph, stream->node_off);
+	uint16_t idx = node->idx;
+
+	RTE_ASSERT(node->fence == RTE_GRAPH_FENCE);
+	if (unlikely(node->size - idx < stream->nb_objs))
+		__rte_node_stream_alloc_size(graph, node, node->size + stream->nb_objs);
+
+	rte_memcpy(&node->objs[idx], stream->objs, stream->nb_objs * sizeof(void *));
+	node->idx = idx + stream->nb_objs;
+
+	__rte_node_process(graph, node);
+	ws_pending_walk(graph);
+
+	return node;
+}
+
+static void
+ws_steal(struct rte_graph *graph)
+{
+	struct rte_graph *victim = graph->ws.victim;
+	struct graph_ws_stream stream;
+	struct rte_graph *first;
+	struct rte_node *node;
+	unsigned int n = 0;
+
+	/* Start from the last victim, likely still the busiest graph */
+	if (victim == NULL)
+		victim = SLIST_FIRST(graph->ws.rq);
+	first = victim;
+
+	do {
+		if (victim != graph && victim->ws.dq != NULL) {
+			while (n < GRAPH_WS_STEAL_MAX && ws_dq_steal(victim->ws.dq, &stream)) {
+				node = ws_stream_process(graph, &stream);
+				node->ws.total_stolen_objs += stream.nb_objs;
+				n++;
+			}
+			if (n != 0) {
+				graph->ws.victim = victim;
+				return;
+			}
+		}
+
+		victim = SLIST_NEXT(victim, next);
+		if (victim == NULL)
+			victim = SLIST_FIRST(graph->ws.rq);
+	} while (victim != first);
+}
+
+RTE_EXPORT_SYMBOL(__rte_graph_ws_stream_share)
+void __rte_noinline
+__rte_graph_ws_stream_share(struct rte_graph *graph, struct rte_node *node)
+{
+	struct rte_graph_ws_deque *dq = graph->ws.dq;
+	uint16_t off = RTE_GRAPH_WS_STREAM_SIZE;
+	uint16_t nb_objs;
+
+	/* Keep the first objects to process them right away */
+	while (off < node->idx) {
+		nb_objs = RTE_MIN(node->idx - off, RTE_GRAPH_WS_STREAM_SIZE);
+		if (!ws_dq_push(dq, node, &node->objs[off], nb_objs))
+			break;
+		off += nb_objs;
+	}
+
+	if (off < node->idx)
+		memmove(&node->objs[RTE_GRAPH_WS_STREAM_SIZE], &node->objs[off],
+			(node->idx - off) * sizeof(void *));
+
+	nb_objs = off - RTE_GRAPH_WS_STREAM_SIZE;
+	node->ws.total_shared_objs += nb_objs;
+	node->idx -= nb_objs;
+}
+
+RTE_EXPORT_SYMBOL(__rte_graph_ws_process)
+void
+__rte_graph_ws_process(struct rte_graph *graph, bool busy)
+{
+	struct graph_ws_stream *stream;
+
+	/* Complete the shared streams not stolen, most recent first */
+	while ((stream = ws_dq_pop(graph->ws.dq)) != NULL) {
+		ws_stream_process(graph, stream);
+		busy = true;
+	}
+
+	/* A graph without work of its own keeps offering to steal */
+	if (!busy)
+		ws_steal(graph);
+
+	if (busy == graph->ws.idle) {
+		graph->ws.idle = !busy;
+		if (!busy)
+			rte_atomic_fetch_add_explicit(graph->ws.nb_idle, 1,
+						      rte_memory_order_relaxed);
+		else
+			rte_atomic_fetch_sub_explicit(graph->ws.nb_idle, 1,
+						      rte_memory_order_relaxed);
+	}
+}
@@ -0,0 +1,120 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#ifndef _RTE_GRAPH_MODEL_WORK_STEALING_H_
+#define _RTE_GRAPH_MODEL_WORK_STEALING_H_
+
+/**
+ * @file rte_graph_model_work_stealing.h
+ *
+ * These APIs allow the graphs cloned from the same graph to steal the pending
+ * streams of each other, and are only used for work-stealing model.
+ *
+ * A graph shares the objects of its pending streams beyond the first
+ * RTE_GRAPH_WS_STREAM_SIZE ones, while another graph of the same parent is idle.
+ * The idle graphs steal the shared streams and process them with their own
+ * copy of the nodes, the owner graph processes the streams left after its walk.
+ * A node which needs the objects of a flow in order is registered with
+ * RTE_NODE_ORDERED_F: its streams, and the streams of the nodes from which
+ * it can be reached, are never shared.
+ */
+
+#include <rte_stdatomic.h>
+
+#include "rte_graph_worker_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RTE_GRAPH_WS_STREAM_SIZE 64
+/**< Maximum number of objects of a shared stream. */
+#define RTE_GRAPH_WS_DQ_SIZE 64
+/**< Default number of streams a graph can share. */
+
+/**
+ * @internal
+ *
+ * Share the objects of the node stream beyond the first RTE_GRAPH_WS_STREAM_SIZE
+ * ones with the other graphs for work-stealing model.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ * @param node
+ *   Pointer to the node object with the pending stream.
+ *
+ * @note
+ * This implementation is used by work-stealing model only and user application
+ * should not call it directly.
+ */
+void __rte_noinline __rte_graph_ws_stream_share(struct rte_graph *graph, struct rte_node *node);
+
+/**
+ * @internal
+ *
+ * Process the streams shared by the graph and not stolen, or steal streams from
+ * the other graphs when the graph is idle, for work-stealing model.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ * @param busy
+ *   True if the graph walk processed pending streams.
+ *
+ * @note
+ * This implementation is used by work-stealing model only and user application
+ * should not call it directly.
+ */
+void __rte_graph_ws_process(struct rte_graph *graph, bool busy);
+
+/**
+ * Perform graph walk on the circular buffer and invoke the process function
+ * of the nodes and collect the stats.
+ *
+ * @param graph
+ *   Graph pointer returned from rte_graph_lookup function.
+ *
+ * @see rte_graph_lookup()
+ */
+static inline void
+rte_graph_walk_work_stealing(struct rte_graph *graph)
+{
+	const rte_graph_off_t *cir_start = graph->cir_start;
+	const rte_node_t mask = graph->cir_mask;
+	uint32_t head = graph->head;
+	struct rte_node *node;
+	bool busy;
+
+	while (likely(head != graph->tail)) {
+		node = (struct rte_node *)RTE_PTR_ADD(graph, cir_start[(int32_t)head++]);
+
+		if (graph->coalesce && __rte_node_coalesce_hold(graph, node))
+			goto next;
+
+		/* Share the large streams while other graphs are idle */
+		if (node->idx > RTE_GRAPH_WS_STREAM_SIZE && node->ws.stealable &&
+		    graph->ws.dq != NULL &&
+		    rte_atomic_load_explicit(graph->ws.nb_idle, rte_memory_order_relaxed) >
+		    (uint32_t)graph->ws.idle)
+			__rte_graph_ws_stream_share(graph, node);
+
+		__rte_node_process(graph, node);
+next:
+		head = likely((int32_t)head > 0) ? head & mask : head;
+	}
+
+	busy = graph->tail != 0;
+	graph->tail = 0;
+
+	if (graph->ws.dq != NULL)
+		__rte_graph_ws_process(graph, busy);
+
+	if (unlikely(graph->nb_held != 0))
+		__rte_graph_coalesce_restore(graph);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_GRAPH_MODEL_WORK_STEALING_H_ */
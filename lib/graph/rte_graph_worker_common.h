@@ -21,6 +21,7 @@
 #include <rte_prefetch.h>
 #include <rte_memcpy.h>
 #include <rte_memory.h>
+#include <rte_stdatomic.h>
 
 #include "rte_graph.h"
 
@@ -33,6 +34,8 @@ extern "C" {
 #define RTE_GRAPH_MODEL_RTC 0 /**< Run-To-Completion model. It is the default model. */
 #define RTE_GRAPH_MODEL_MCORE_DISPATCH 1
 /**< Dispatch model to support cross-core dispatching within core affinity. */
+#define RTE_GRAPH_MODEL_WORK_STEALING 2
+/**< Work-stealing model to share pending streams with idle cores. */
 #define RTE_GRAPH_MODEL_DEFAULT RTE_GRAPH_MODEL_RTC /**< Default graph model. */
 
 /**
@@ -42,6 +45,20 @@ extern "C" {
  */
 SLIST_HEAD(rte_graph_rq_head, rte_graph);
 
+/**
+ * @internal
+ *
+ * Deque of the streams shared by a graph in work-stealing model.
+ */
+struct rte_graph_ws_deque;
+
+/**
+ * @internal
+ *
+ * BPF filter of the packets captured by a node.
+ */
+struct rte_bpf;
+
 /**
  * @internal
  *
@@ -56,8 +73,10 @@ struct __rte_cache_aligned rte_graph {
 	rte_graph_off_t *cir_start;  /**< Pointer to circular buffer. */
 	rte_graph_off_t nodes_start; /**< Offset at which node memory starts. */
 	uint8_t model;		     /**< graph model */
-	uint8_t reserved1;	     /**< Reserved for future use. */
+	uint8_t coalesce;	     /**< Nodes of the graph hold their streams. */
 	uint16_t reserved2;	     /**< Reserved for future use. */
+	rte_node_t nb_held;	     /**< Number of held streams. */
+	rte_graph_off_t *held;	     /**< Held streams of the current walk. */
 	union {
 		/* Fast schedule area for mcore dispatch model */
 		struct {
@@ -72,6 +91,18 @@ struct __rte_cache_aligned rte_graph {
 			uint64_t cb_priv;       /**< Opaque parameter for notify_cb. */
 		} dispatch; /** Only used by dispatch model */
 	};
+	/* Fast schedule area for work-stealing model, NULL dq for other models */
+	struct {
+		alignas(RTE_CACHE_LINE_SIZE) struct rte_graph_rq_head *rq;
+			/* The run-queue of the graphs stealing from each other */
+		struct rte_graph_rq_head rq_head; /* The head for run-queue list */
+
+		struct rte_graph_ws_deque *dq; /**< The deque of shared streams. */
+		struct rte_graph *victim; /**< The graph of the last stolen stream. */
+		RTE_ATOMIC(uint32_t) *nb_idle; /**< Number of idle graphs in run-queue. */
+		RTE_ATOMIC(uint32_t) idle_count; /**< Storage of nb_idle in parent graph. */
+		bool idle; /**< Graph is counted in nb_idle. */
+	} ws; /** Only used by work-stealing model */
 	SLIST_ENTRY(rte_graph) next;   /* The next for rte_graph list */
 	/* End of Fast path area.*/
 	rte_graph_t id;	/**< Graph identifier. */
@@ -83,6 +114,12 @@ struct __rte_cache_aligned rte_graph {
 	/** Number of packets to capture per core. */
 	uint64_t nb_pkt_to_capture;
 	char pcap_filename[RTE_GRAPH_PCAP_FILE_SZ];  /**< Pcap filename. */
+	/** Size of the ring of the captured packets, 0 to write them in the walk. */
+	uint32_t pcap_ring_size;
+	bool prof_enable;	/**< Node profile enabled. */
+	uint8_t nb_pmu_events;	/**< Number of PMU events counted per node. */
+	/** Index of the PMU events in the PMU library. */
+	uint8_t pmu_events[RTE_GRAPH_PMU_EVENTS_MAX];
 	uint64_t fence;			/**< Fence. */
 };
 
@@ -105,6 +142,13 @@ struct __rte_cache_aligned rte_node {
 
 	/** Original process function when pcap is enabled. */
 	rte_node_process_t original_process;
+	/** Packet capture, only used when pcap is enabled. */
+	struct {
+		const struct rte_bpf *filter; /**< BPF filter, NULL to capture all packets. */
+		uint64_t (*filter_jit)(void *); /**< JIT of the filter, NULL if not available. */
+		uint32_t sample_rate; /**< Capture one packet out of sample_rate. */
+		uint32_t sample_skip; /**< Packets to skip before the next capture. */
+	} pcap;
 
 	/** Fast schedule area for mcore dispatch model. */
 	union {
@@ -115,10 +159,29 @@ struct __rte_cache_aligned rte_node {
 			struct rte_graph *graph;  /**< Graph corresponding to lcore_id. */
 		} dispatch;
 	};
+	/** Fast schedule area for work-stealing model. */
+	struct {
+		uint64_t total_shared_objs; /**< Number of objects shared for stealing. */
+		uint64_t total_stolen_objs; /**< Number of objects stolen from other graphs. */
+		bool stealable; /**< Streams can be stolen, no ordered node follows. */
+	} ws;
 
 	/** Fast path area cache line 1. */
 	alignas(RTE_CACHE_LINE_MIN_SIZE)
 	rte_graph_off_t xstat_off; /**< Offset to xstat counters. */
+	rte_graph_off_t prof_off; /**< Offset to profile, 0 if not enabled. */
+	/** Stream coalescing, only used when min_objs is not 0. */
+	struct {
+		uint16_t min_objs;  /**< Number of objects processed without holding. */
+		uint16_t max_walks; /**< Maximum number of walks a stream is held. */
+		uint16_t walks;	    /**< Number of walks the stream is held. */
+		uint64_t max_cycles; /**< Maximum cycles a stream is held. */
+		uint64_t start;	    /**< Timestamp of the first hold of the stream. */
+		uint64_t total_held_walks; /**< Number of walks streams were held. */
+		uint64_t total_hold_cycles; /**< Cycles held streams waited. */
+		uint64_t total_flushes; /**< Number of held streams processed. */
+		uint64_t total_timeouts; /**< Number of held streams processed under-filled. */
+	} coalesce;
 
 	/** Fast path area cache line 2. */
 	__extension__ struct __rte_cache_aligned {
@@ -184,6 +247,88 @@ void __rte_node_stream_alloc_size(struct rte_graph *graph,
 
 /* Fast path helper functions */
 
+/**
+ * @internal
+ *
+ * Hold back the under-filled stream of a node with a coalescing policy to the
+ * next graph walk, or account for the end of its hold.
+ *
+ * @param graph
+ *   Pointer Graph object.
+ * @param node
+ *   Pointer to node object with a pending stream.
+ *
+ * @return
+ *   True if the stream is held and must not be processed.
+ */
+static __rte_always_inline bool
+__rte_node_coalesce_hold(struct rte_graph *graph, struct rte_node *node)
+{
+	uint16_t walks = node->coalesce.walks;
+	bool timeout = false;
+	uint64_t now;
+
+	if (likely(node->coalesce.min_objs == 0))
+		return false;
+
+	if (node->idx >= node->coalesce.min_objs && walks == 0)
+		return false;
+
+	now = rte_rdtsc();
+	if (node->idx < node->coalesce.min_objs) {
+		if (walks == 0)
+			node->coalesce.start = now;
+		else if ((node->coalesce.max_walks != 0 && walks >= node->coalesce.max_walks) ||
+			 (node->coalesce.max_cycles != 0 &&
+			  now - node->coalesce.start >= node->coalesce.max_cycles))
+			timeout = true;
+
+		if (!timeout) {
+			node->coalesce.walks = walks + 1;
+			node->coalesce.total_held_walks++;
+			graph->held[graph->nb_held++] = node->off;
+			return true;
+		}
+		node->coalesce.total_timeouts++;
+	}
+
+	node->coalesce.total_hold_cycles += now - node->coalesce.start;
+	node->coalesce.total_flushes++;
+	node->coalesce.walks = 0;
+
+	return false;
+}
+
+/**
+ * @internal
+ *
+ * Put the streams held in the graph walk back in the graph reel, to be
+ * processed first by the next walk. Called once the reel is empty.
+ * A held stream may have been processed since, by a graph of work-stealing
+ * model processing a stolen stream of the same node.
+ *
+ * @param graph
+ *   Pointer Graph object.
+ */
+static __rte_always_inline void
+__rte_graph_coalesce_restore(struct rte_graph *graph)
+{
+	uint32_t tail = graph->tail;
+	struct rte_node *node;
+	rte_node_t i;
+
+	for (i = 0; i < graph->nb_held; i++) {
+		node = RTE_PTR_ADD(graph, graph->held[i]);
+		if (unlikely(node->idx == 0)) {
+			node->coalesce.walks = 0;
+			continue;
+		}
+		graph->cir_start[tail++] = graph->held[i];
+	}
+	graph->tail = tail;
+	graph->nb_held = 0;
+}
+
 /**
  * @internal
  *
@@ -265,7 +265,8 @@ inb_get_sqn(const struct rte_ipsec_sa *sa, const struct replay_sqn *rsn,
 	 */
 	sqn = rte_be_to_cpu_32(esph->seq);
 	if (IS_ESN(sa))
-		sqn = reconstruct_esn(rsn->sqn, sqn, sa->replay.win_sz);
+		sqn = reconstruct_esn(rsn_last_sqn(sa, rsn), sqn,
+			sa->replay.win_sz);
 	*sqc = rte_cpu_to_be_64(sqn);
 
 	/* check IPsec window */
@@ -357,6 +358,16 @@ inb_pkt_prepare(const struct rte_ipsec_sa *sa, const struct replay_sqn *rsn,
 	return rc;
 }
 
+/*
+ * Prefetch the end of inbound packet before crypto preparation:
+ * ICV is read there, high-order bits of ESN and AAD are written after it.
+ */
+static inline void
+inb_pkt_prefetch(const struct rte_ipsec_sa *sa, struct rte_mbuf *mb)
+{
+	mbuf_prefetch_tail(mb, sa->icv_len, sa->sqh_len + sa->aad_len, true);
+}
+
 /*
  * setup/update packets and crypto ops for ESP inbound case.
  */
@@ -374,11 +385,23 @@ esp_inb_pkt_prepare(const struct rte_ipsec_session *ss, struct rte_mbuf *mb[],
 
 	sa = ss->sa;
 	cs = ss->crypto.ses;
+
+	for (i = 0; i != RTE_MIN(num, IPSEC_PREFETCH_HDR_AHEAD); i++)
+		mbuf_prefetch_hdr(mb[i]);
+
+	for (i = 0; i != RTE_MIN(num, IPSEC_PREFETCH_AHEAD); i++)
+		inb_pkt_prefetch(sa, mb[i]);
+
 	rsn = rsn_acquire(sa);
 
 	k = 0;
 	for (i = 0; i != num; i++) {
 
+		if (i + IPSEC_PREFETCH_HDR_AHEAD < num)
+			mbuf_prefetch_hdr(mb[i + IPSEC_PREFETCH_HDR_AHEAD]);
+		if (i + IPSEC_PREFETCH_AHEAD < num)
+			inb_pkt_prefetch(sa, mb[i + IPSEC_PREFETCH_AHEAD]);
+
 		hl = mb[i]->l2_len + mb[i]->l3_len;
 		rc = inb_pkt_prepare(sa, rsn, mb[i], hl, &icv);
 		if (rc >= 0) {
@@ -400,6 +423,16 @@ esp_inb_pkt_prepare(const struct rte_ipsec_session *ss, struct rte_mbuf *mb[],
 	return k;
 }
 
+/*
+ * Prefetch the end of inbound packet before processing it:
+ * ICV, ESP tail and the last pad bytes.
+ */
+static inline void
+process_prefetch(struct rte_mbuf *mb, uint32_t tlen)
+{
+	mbuf_prefetch_tail(mb, tlen + IPSEC_MAX_IV_SIZE, 0, false);
+}
+
 /*
  * Start with processing inbound packet.
  * This is common part for both tunnel and transport mode.
@@ -424,6 +457,29 @@ process_step1(struct rte_mbuf *mb, uint32_t tlen, struct rte_mbuf **ml,
 	espt[0] = pt[0];
 }
 
+/*
+ * Compare pad bytes with their expected values, 8 bytes at a time.
+ * Padding is a few bytes long for most packets,
+ * too short to amortize a call to memcmp().
+ */
+static inline uint64_t
+cmp_pad_bytes(const uint8_t *pd, const uint8_t *ref, uint32_t len)
+{
+	uint32_t i;
+	uint64_t d, v, w;
+
+	d = 0;
+	for (i = 0; i + sizeof(v) <= len; i += sizeof(v)) {
+		memcpy(&v, pd + i, sizeof(v));
+		memcpy(&w, ref + i, sizeof(w));
+		d |= v ^ w;
+	}
+	for (; i != len; i++)
+		d |= pd[i] ^ ref[i];
+
+	return d;
+}
+
 /*
  * Helper function to check pad bytes values.
  * Note that pad bytes can be spread across multiple segments.
@@ -438,7 +494,7 @@ check_pad_bytes(struct rte_mbuf *mb, uint32_t ofs, uint32_t len)
 		k = mb->data_len - ofs;
 		k = RTE_MIN(k, len - n);
 		pd = rte_pktmbuf_mtod_offset(mb, const uint8_t *, ofs);
-		if (memcmp(pd, esp_pad_bytes + n, k) != 0)
+		if (cmp_pad_bytes(pd, esp_pad_bytes + n, k) != 0)
 			break;
 		ofs = 0;
 	}
@@ -591,10 +647,22 @@ tun_process(struct rte_ipsec_sa *sa, struct rte_mbuf *mb[],
 
 	/*
 	 * to minimize stalls due to load latency,
-	 * read mbufs metadata and esp tail first.
+	 * read mbufs metadata and esp tail first,
+	 * prefetching the tails of the next packets.
 	 */
-	for (i = 0; i != num; i++)
+	for (i = 0; i != RTE_MIN(num, IPSEC_PREFETCH_HDR_AHEAD); i++)
+		mbuf_prefetch_hdr(mb[i]);
+
+	for (i = 0; i != RTE_MIN(num, IPSEC_PREFETCH_AHEAD); i++)
+		process_prefetch(mb[i], tlen);
+
+	for (i = 0; i != num; i++) {
+		if (i + IPSEC_PREFETCH_HDR_AHEAD < num)
+			mbuf_prefetch_hdr(mb[i + IPSEC_PREFETCH_HDR_AHEAD]);
+		if (i + IPSEC_PREFETCH_AHEAD < num)
+			process_prefetch(mb[i + IPSEC_PREFETCH_AHEAD], tlen);
 		process_step1(mb[i], tlen, &ml[i], &espt[i], &hl[i], &to[i]);
+	}
 
 	k = 0;
 	bytes = 0;
@@ -653,10 +721,22 @@ trs_process(struct rte_ipsec_sa *sa, struct rte_mbuf *mb[],
 
 	/*
 	 * to minimize stalls due to load latency,
-	 * read mbufs metadata and esp tail first.
+	 * read mbufs metadata and esp tail first,
+	 * prefetching the tails of the next packets.
 	 */
-	for (i = 0; i != num; i++)
+	for (i = 0; i != RTE_MIN(num, IPSEC_PREFETCH_HDR_AHEAD); i++)
+		mbuf_prefetch_hdr(mb[i]);
+
+	for (i = 0; i != RTE_MIN(num, IPSEC_PREFETCH_AHEAD); i++)
+		process_prefetch(mb[i], tlen);
+
+	for (i = 0; i != num; i++) {
+		if (i + IPSEC_PREFETCH_HDR_AHEAD < num)
+			mbuf_prefetch_hdr(mb[i + IPSEC_PREFETCH_HDR_AHEAD]);
+		if (i + IPSEC_PREFETCH_AHEAD < num)
+			process_prefetch(mb[i + IPSEC_PREFETCH_AHEAD], tlen);
 		process_step1(mb[i], tlen, &ml[i], &espt[i], &hl[i], &to[i]);
+	}
 
 	k = 0;
 	bytes = 0;
@@ -770,12 +850,23 @@ cpu_inb_pkt_prepare(const struct rte_ipsec_session *ss,
 
 	sa = ss->sa;
 
+	for (i = 0; i != RTE_MIN(num, IPSEC_PREFETCH_HDR_AHEAD); i++)
+		mbuf_prefetch_hdr(mb[i]);
+
+	for (i = 0; i != RTE_MIN(num, IPSEC_PREFETCH_AHEAD); i++)
+		inb_pkt_prefetch(sa, mb[i]);
+
 	/* grab rsn lock */
 	rsn = rsn_acquire(sa);
 
 	/* do preparation for all packets */
 	for (i = 0, k = 0; i != num; i++) {
 
+		if (i + IPSEC_PREFETCH_HDR_AHEAD < num)
+			mbuf_prefetch_hdr(mb[i + IPSEC_PREFETCH_HDR_AHEAD]);
+		if (i + IPSEC_PREFETCH_AHEAD < num)
+			inb_pkt_prefetch(sa, mb[i + IPSEC_PREFETCH_AHEAD]);
+
 		/* calculate ESP header offset */
 		l4ofs[k] = mb[i]->l2_len + mb[i]->l3_len;
 
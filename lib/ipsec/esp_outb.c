@@ -285,6 +285,20 @@ outb_pkt_xprepare(const struct rte_ipsec_sa *sa, rte_be64_t sqc,
 	}
 }
 
+/*
+ * Prefetch outbound packet areas written by preparation: the headroom
+ * where ESP and tunnel headers are prepended, and the tailroom where
+ * padding, ESP tail, ICV and AAD are appended.
+ */
+static inline void
+outb_pkt_prefetch(const struct rte_ipsec_sa *sa, struct rte_mbuf *mb)
+{
+	mbuf_prefetch_head(mb, sa->hdr_len + sa->iv_len +
+		sizeof(struct rte_esp_hdr));
+	mbuf_prefetch_tail(mb, 0, sa->pad_align + sizeof(struct rte_esp_tail) +
+		sa->icv_len + sa->sqh_len + sa->aad_len, true);
+}
+
 /*
  * setup/update packets and crypto ops for ESP outbound tunnel case.
  */
@@ -304,9 +318,20 @@ esp_outb_tun_prepare_helper(const struct rte_ipsec_session *ss, struct rte_mbuf
 	sa = ss->sa;
 	cs = ss->crypto.ses;
 
+	for (i = 0; i != RTE_MIN(n, IPSEC_PREFETCH_HDR_AHEAD); i++)
+		mbuf_prefetch_hdr(mb[i]);
+
+	for (i = 0; i != RTE_MIN(n, IPSEC_PREFETCH_AHEAD); i++)
+		outb_pkt_prefetch(sa, mb[i]);
+
 	k = 0;
 	for (i = 0; i != n; i++) {
 
+		if (i + IPSEC_PREFETCH_HDR_AHEAD < n)
+			mbuf_prefetch_hdr(mb[i + IPSEC_PREFETCH_HDR_AHEAD]);
+		if (i + IPSEC_PREFETCH_AHEAD < n)
+			outb_pkt_prefetch(sa, mb[i + IPSEC_PREFETCH_AHEAD]);
+
 		sqc = rte_cpu_to_be_64(sqn + i);
 		gen_iv(iv, sqc);
 
@@ -478,9 +503,20 @@ esp_outb_trs_prepare(const struct rte_ipsec_session *ss, struct rte_mbuf *mb[],
 	if (n != num)
 		rte_errno = EOVERFLOW;
 
+	for (i = 0; i != RTE_MIN(n, IPSEC_PREFETCH_HDR_AHEAD); i++)
+		mbuf_prefetch_hdr(mb[i]);
+
+	for (i = 0; i != RTE_MIN(n, IPSEC_PREFETCH_AHEAD); i++)
+		outb_pkt_prefetch(sa, mb[i]);
+
 	k = 0;
 	for (i = 0; i != n; i++) {
 
+		if (i + IPSEC_PREFETCH_HDR_AHEAD < n)
+			mbuf_prefetch_hdr(mb[i + IPSEC_PREFETCH_HDR_AHEAD]);
+		if (i + IPSEC_PREFETCH_AHEAD < n)
+			outb_pkt_prefetch(sa, mb[i + IPSEC_PREFETCH_AHEAD]);
+
 		l2 = mb[i]->l2_len;
 		l3 = mb[i]->l3_len;
 
@@ -568,8 +604,19 @@ cpu_outb_pkt_prepare_helper(const struct rte_ipsec_session *ss,
 
 	sa = ss->sa;
 
+	for (i = 0; i != RTE_MIN(n, IPSEC_PREFETCH_HDR_AHEAD); i++)
+		mbuf_prefetch_hdr(mb[i]);
+
+	for (i = 0; i != RTE_MIN(n, IPSEC_PREFETCH_AHEAD); i++)
+		outb_pkt_prefetch(sa, mb[i]);
+
 	for (i = 0, k = 0; i != n; i++) {
 
+		if (i + IPSEC_PREFETCH_HDR_AHEAD < n)
+			mbuf_prefetch_hdr(mb[i + IPSEC_PREFETCH_HDR_AHEAD]);
+		if (i + IPSEC_PREFETCH_AHEAD < n)
+			outb_pkt_prefetch(sa, mb[i + IPSEC_PREFETCH_AHEAD]);
+
 		l2 = mb[i]->l2_len;
 		l3 = mb[i]->l3_len;
 
@@ -16,6 +16,13 @@
 #define IS_ESN(sa)	((sa)->sqn_mask == UINT64_MAX)
 
 #define	SQN_ATOMIC(sa)	((sa)->type & RTE_IPSEC_SATP_SQN_ATOM)
+#define	SQN_SHARD(sa)	((sa)->type & RTE_IPSEC_SATP_SQN_SHARD_ENABLE)
+
+/* sharded replay window: 32 bits bitmap and 32 bits bucket tag per slot */
+#define SHARD_BUCKET_BITS		5
+#define SHARD_BUCKET_SIZE		(1 << SHARD_BUCKET_BITS)
+#define SHARD_BIT_LOC_MASK		(SHARD_BUCKET_SIZE - 1)
+#define SHARD_TAG_SHIFT			32
 
 /*
  * gets SQN.hi32 bits, SQN supposed to be in network byte order.
@@ -80,6 +87,120 @@ reconstruct_esn(uint64_t t, uint32_t sqn, uint32_t w)
 	return (uint64_t)th << 32 | sqn;
 }
 
+/**
+ * Sharded replay window, for inbound SA updated by several threads at once.
+ *
+ * The window is split into slots of 32 sequence numbers, each slot being
+ * a 64 bits word holding the bitmap of its sequence numbers and the low
+ * 32 bits of the bucket (sqn >> SHARD_BUCKET_BITS) it currently stands for.
+ * A slot is moved to a later bucket and set in a single compare and swap,
+ * so threads updating different sequence ranges do not wait on each other,
+ * and no sequence number is accepted twice: once its slot is taken by a later
+ * bucket, a sequence number is out of the window and the mismatched tag
+ * rejects it. The highest sequence number accepted only grows, by
+ * compare and swap too.
+ */
+
+/**
+ * Get the highest sequence number accepted on the SA.
+ */
+static inline uint64_t
+rsn_last_sqn(const struct rte_ipsec_sa *sa, const struct replay_sqn *rsn)
+{
+	if (SQN_SHARD(sa))
+		return rte_atomic_load_explicit(&sa->shard.inb->sqn,
+			rte_memory_order_relaxed);
+	return rsn->sqn;
+}
+
+/**
+ * Perform the replay checking on a sharded replay window.
+ */
+static inline int32_t
+shard_inb_check_sqn(const struct replay_shard *rsh,
+	const struct rte_ipsec_sa *sa, uint64_t sqn)
+{
+	uint32_t bucket;
+	uint64_t last, v;
+
+	last = rte_atomic_load_explicit(&rsh->sqn, rte_memory_order_relaxed);
+
+	/* seq is larger than lastseq */
+	if (sqn > last)
+		return 0;
+
+	/* seq is outside window */
+	if (sqn == 0 || sqn + sa->replay.win_sz < last)
+		return -EINVAL;
+
+	bucket = sqn >> SHARD_BUCKET_BITS;
+	v = rte_atomic_load_explicit(
+		&rsh->window[bucket & sa->replay.bucket_index_mask],
+		rte_memory_order_relaxed);
+
+	/* slot already taken by a later bucket */
+	if ((int32_t)((uint32_t)(v >> SHARD_TAG_SHIFT) - bucket) > 0)
+		return -EINVAL;
+
+	/* already seen packet */
+	if ((uint32_t)(v >> SHARD_TAG_SHIFT) == bucket &&
+			(v & ((uint64_t)1 << (sqn & SHARD_BIT_LOC_MASK))))
+		return -EINVAL;
+
+	return 0;
+}
+
+/**
+ * Perform the sequence number and replay window update on a sharded
+ * replay window.
+ */
+static inline int32_t
+shard_inb_update_sqn(struct replay_shard *rsh, const struct rte_ipsec_sa *sa,
+	uint64_t sqn)
+{
+	uint32_t bit, bucket, tag;
+	uint64_t last, v, nv;
+	RTE_ATOMIC(uint64_t) *slot;
+
+	last = rte_atomic_load_explicit(&rsh->sqn, rte_memory_order_relaxed);
+
+	/* handle ESN */
+	if (IS_ESN(sa))
+		sqn = reconstruct_esn(last, sqn, sa->replay.win_sz);
+
+	/* seq is outside window*/
+	if (sqn == 0 || sqn + sa->replay.win_sz < last)
+		return -EINVAL;
+
+	bucket = sqn >> SHARD_BUCKET_BITS;
+	bit = (uint32_t)1 << (sqn & SHARD_BIT_LOC_MASK);
+	slot = &rsh->window[bucket & sa->replay.bucket_index_mask];
+
+	v = rte_atomic_load_explicit(slot, rte_memory_order_relaxed);
+	do {
+		tag = v >> SHARD_TAG_SHIFT;
+		if (tag == bucket) {
+			/* already seen packet */
+			if (v & bit)
+				return -EINVAL;
+			nv = v | bit;
+		} else if ((int32_t)(tag - bucket) > 0) {
+			/* slot already taken by a later bucket */
+			return -EINVAL;
+		} else
+			nv = (uint64_t)bucket << SHARD_TAG_SHIFT | bit;
+	} while (rte_atomic_compare_exchange_weak_explicit(slot, &v, nv,
+			rte_memory_order_relaxed, rte_memory_order_relaxed) == 0);
+
+	/* move the window forward */
+	while (sqn > last && rte_atomic_compare_exchange_weak_explicit(
+			&rsh->sqn, &last, sqn, rte_memory_order_relaxed,
+			rte_memory_order_relaxed) == 0)
+		;
+
+	return 0;
+}
+
 /**
  * Perform the replay checking.
  *
@@ -99,6 +220,9 @@ esn_inb_check_sqn(const struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
 	if (sa->replay.win_sz == 0)
 		return 0;
 
+	if (SQN_SHARD(sa))
+		return shard_inb_check_sqn(sa->shard.inb, sa, sqn);
+
 	/* seq is larger than lastseq */
 	if (sqn > rsn->sqn)
 		return 0;
@@ -118,6 +242,39 @@ esn_inb_check_sqn(const struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
 	return 0;
 }
 
+/**
+ * For outbound SA with sharded SQN, reserve *n* consecutive sequence
+ * numbers from the block of the calling lcore, taking a new block from
+ * the SA counter when the current one cannot hold them.
+ * Returns the first reserved sequence number.
+ */
+static inline uint64_t
+sqn_blk_reserve(struct rte_ipsec_sa *sa, uint64_t n)
+{
+	uint32_t lc;
+	uint64_t k, s;
+	struct sqn_blk *blk;
+
+	lc = rte_lcore_id();
+
+	/* non-EAL thread, no block of its own */
+	if (lc >= RTE_MAX_LCORE)
+		return rte_atomic_fetch_add_explicit(&sa->sqn.outb, n,
+			rte_memory_order_relaxed);
+
+	blk = &sa->shard.outb[lc];
+	if (blk->end - blk->next < n) {
+		k = RTE_MAX(n, (uint64_t)sa->shard.blk_sz);
+		blk->next = rte_atomic_fetch_add_explicit(&sa->sqn.outb, k,
+			rte_memory_order_relaxed);
+		blk->end = blk->next + k;
+	}
+
+	s = blk->next;
+	blk->next = s + n;
+	return s;
+}
+
 /**
  * For outbound SA perform the sequence number update.
  */
@@ -127,7 +284,9 @@ esn_outb_update_sqn(struct rte_ipsec_sa *sa, uint32_t *num)
 	uint64_t n, s, sqn;
 
 	n = *num;
-	if (SQN_ATOMIC(sa))
+	if (SQN_SHARD(sa))
+		sqn = sqn_blk_reserve(sa, n) + n;
+	else if (SQN_ATOMIC(sa))
 		sqn = rte_atomic_fetch_add_explicit(&sa->sqn.outb, n, rte_memory_order_relaxed) + n;
 	else {
 		sqn = sa->sqn.outb + n;
@@ -152,6 +311,9 @@ esn_inb_update_sqn(struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
 {
 	uint32_t bit, bucket, last_bucket, new_bucket, diff, i;
 
+	if (SQN_SHARD(sa))
+		return shard_inb_update_sqn(sa->shard.inb, sa, sqn);
+
 	/* handle ESN */
 	if (IS_ESN(sa))
 		sqn = reconstruct_esn(rsn->sqn, sqn, sa->replay.win_sz);
@@ -201,6 +363,8 @@ esn_inb_update_sqn(struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
  * and mark newly updated RSN as readers one.
  * That approach is intended to minimize contention and cache sharing
  * between writer and readers.
+ * SA with sharded replay window have no RSN copies, all the accessors
+ * below return NULL for them.
  */
 
 /**
@@ -235,7 +399,7 @@ rsn_acquire(struct rte_ipsec_sa *sa)
 	n = sa->sqn.inb.rdidx;
 	rsn = sa->sqn.inb.rsn[n];
 
-	if (!SQN_ATOMIC(sa))
+	if (!SQN_ATOMIC(sa) || SQN_SHARD(sa))
 		return rsn;
 
 	/* check there are no writers */
@@ -255,7 +419,7 @@ rsn_acquire(struct rte_ipsec_sa *sa)
 static inline void
 rsn_release(struct rte_ipsec_sa *sa, struct replay_sqn *rsn)
 {
-	if (SQN_ATOMIC(sa))
+	if (SQN_ATOMIC(sa) && !SQN_SHARD(sa))
 		rte_rwlock_read_unlock(&rsn->rwl);
 }
 
@@ -268,6 +432,9 @@ rsn_update_start(struct rte_ipsec_sa *sa)
 	uint32_t k, n;
 	struct replay_sqn *rsn;
 
+	if (SQN_SHARD(sa))
+		return NULL;
+
 	n = sa->sqn.inb.wridx;
 
 	/* no active writers */
@@ -294,7 +461,7 @@ rsn_update_finish(struct rte_ipsec_sa *sa, struct replay_sqn *rsn)
 {
 	uint32_t n;
 
-	if (!SQN_ATOMIC(sa))
+	if (!SQN_ATOMIC(sa) || SQN_SHARD(sa))
 		return;
 
 	n = sa->sqn.inb.wridx;
@@ -176,7 +176,15 @@ handle_telemetry_cmd_ipsec_sa_details(const char *cmd __rte_unused,
 		if ((sa->type & RTE_IPSEC_SATP_DIR_MASK) ==
 			RTE_IPSEC_SATP_DIR_IB)
 
-			if (sa->sqn.inb.rsn[sa->sqn.inb.rdidx])
+			if ((sa->type & RTE_IPSEC_SATP_SQN_SHARD_MASK) ==
+					RTE_IPSEC_SATP_SQN_SHARD_ENABLE &&
+					sa->shard.inb != NULL)
+				rte_tel_data_add_dict_uint(data,
+							   "sequence-number",
+							   rte_atomic_load_explicit(
+								&sa->shard.inb->sqn,
+								rte_memory_order_relaxed));
+			else if (sa->sqn.inb.rsn[sa->sqn.inb.rdidx])
 				rte_tel_data_add_dict_uint(data,
 							   "sequence-number",
 							   sa->sqn.inb.rsn[sa->sqn.inb.rdidx]->sqn);
@@ -11,6 +11,71 @@
  * by ipsec library.
  */
 
+/*
+ * Number of packets ahead in the burst for which packet data is prefetched,
+ * so the cache misses on packet headers and trailers overlap with the
+ * processing of the previous packets.
+ */
+#define IPSEC_PREFETCH_AHEAD	8U
+
+/*
+ * Number of packets ahead in the burst for which mbuf headers are prefetched.
+ * Packet data prefetch needs data_off, data_len and the segment chain,
+ * so mbuf headers are fetched one stage earlier, to avoid stalling
+ * on them when prefetching packet data.
+ */
+#define IPSEC_PREFETCH_HDR_AHEAD	(2 * IPSEC_PREFETCH_AHEAD)
+
+/*
+ * Prefetch both cache lines of mbuf header:
+ * data offset and length are in the first one, segment chain in the second.
+ */
+static inline void
+mbuf_prefetch_hdr(struct rte_mbuf *mb)
+{
+	rte_mbuf_prefetch_part1(mb);
+	rte_mbuf_prefetch_part2(mb);
+}
+
+/*
+ * Prefetch packet data around the end of the packet: the *len* last bytes
+ * and the *room* bytes of tailroom after them, where ESP trailer, ICV and AAD
+ * are read or written. For multi-segment packets, the last segment is found
+ * by walking the segment chain here, ahead of packet processing.
+ */
+static inline void
+mbuf_prefetch_tail(struct rte_mbuf *mb, uint32_t len, uint32_t room,
+	bool write)
+{
+	struct rte_mbuf *ml;
+	const char *pe;
+
+	ml = rte_pktmbuf_lastseg(mb);
+	pe = rte_pktmbuf_mtod_offset(ml, const char *, ml->data_len);
+	len = RTE_MIN(len, (uint32_t)ml->data_len);
+
+	if (write) {
+		rte_prefetch0_write(pe - len);
+		rte_prefetch0_write(pe + room - 1);
+	} else {
+		rte_prefetch0(pe - len);
+		rte_prefetch0(pe + room - 1);
+	}
+}
+
+/*
+ * Prefetch for write the *len* bytes of headroom before packet data,
+ * where outbound ESP and tunnel headers are prepended.
+ */
+static inline void
+mbuf_prefetch_head(struct rte_mbuf *mb, uint32_t len)
+{
+	const char *ph;
+
+	ph = rte_pktmbuf_mtod(mb, const char *);
+	rte_prefetch0_write(ph - RTE_MIN(len, (uint32_t)rte_pktmbuf_headroom(mb)));
+}
+
 /*
  * Move bad (unprocessed) mbufs beyond the good (processed) ones.
  * bad_idx[] contains the indexes of bad mbufs inside the mb[].
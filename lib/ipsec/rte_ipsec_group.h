@@ -84,7 +84,7 @@ rte_ipsec_pkt_crypto_group(const struct rte_crypto_op *cop[],
 {
 	uint32_t i, j, k, n;
 	void *ns, *ps;
-	struct rte_mbuf *m, *dr[num];
+	struct rte_mbuf *m;
 
 	j = 0;
 	k = 0;
@@ -102,7 +102,7 @@ rte_ipsec_pkt_crypto_group(const struct rte_crypto_op *cop[],
 
 		/* no valid session found */
 		if (ns == NULL) {
-			dr[k++] = m;
+			k++;
 			continue;
 		}
 
@@ -137,8 +137,10 @@ rte_ipsec_pkt_crypto_group(const struct rte_crypto_op *cop[],
 
 	/* copy mbufs with unknown session beyond recognised ones */
 	if (k != 0 && k != num) {
-		for (i = 0; i != k; i++)
-			mb[j + i] = dr[i];
+		for (i = 0; i != num; i++) {
+			if (cop[i]->sym[0].session == NULL)
+				mb[j++] = cop[i]->sym[0].m_src;
+		}
 	}
 
 	return n;
@@ -46,8 +46,20 @@ struct rte_ipsec_sa_prm {
 			uint8_t proto;  /**< next header protocol */
 		} trs; /**< transport mode related parameters */
 	};
+	/**
+	 * Number of outbound sequence numbers reserved at once by each lcore
+	 * with RTE_IPSEC_SAFLAG_SQN_SHARD, power of 2,
+	 * 0 for RTE_IPSEC_SQN_BLK_SIZE_DEFAULT.
+	 */
+	uint32_t sqn_blk_sz;
 };
 
+/**
+ * Default number of outbound sequence numbers reserved at once by an lcore,
+ * small enough for a few lcores to fit in a 64 or 128 packets replay window.
+ */
+#define RTE_IPSEC_SQN_BLK_SIZE_DEFAULT	32
+
 /**
  * Indicates that SA will(/will not) need an 'atomic' access
  * to sequence number and replay window.
@@ -69,6 +81,22 @@ struct rte_ipsec_sa_prm {
  */
 #define	RTE_IPSEC_SAFLAG_SQN_ATOM	(1ULL << 0)
 
+/**
+ * Indicates that SA sequence number and replay window are sharded,
+ * for an SA processed by many threads at once. Implies RTE_IPSEC_SAFLAG_SQN_ATOM.
+ * For outbound SA, each lcore reserves blocks of sqn_blk_sz sequence
+ * numbers, so the shared counter is updated once per block instead of once
+ * per burst. The sequence numbers of the packets sent by different lcores
+ * are then interleaved by up to the number of lcores times sqn_blk_sz,
+ * which has to fit in the replay window of the peer.
+ * Sequence numbers left in a block when it cannot hold a whole burst
+ * are skipped, never reused.
+ * For inbound SA, the replay window is split by sequence number ranges,
+ * each updated without lock, so rte_ipsec_pkt_process() can be called
+ * for the SA by several threads at once.
+ */
+#define	RTE_IPSEC_SAFLAG_SQN_SHARD	(1ULL << 1)
+
 /**
  * SA type is an 64-bit value that contain the following information:
  * - IP version (IPv4/IPv6)
@@ -77,6 +105,7 @@ struct rte_ipsec_sa_prm {
  * - mode (TRANSPORT/TUNNEL)
  * - for TUNNEL outer IP version (IPv4/IPv6)
  * - are SA SQN operations 'atomic'
+ * - are SA SQN and replay window sharded
  * - ESN enabled/disabled
  * - NAT-T UDP encapsulated (TUNNEL mode only)
  * ...
@@ -91,7 +120,8 @@ enum {
 	RTE_SATP_LOG2_ESN,
 	RTE_SATP_LOG2_ECN,
 	RTE_SATP_LOG2_DSCP,
-	RTE_SATP_LOG2_NATT
+	RTE_SATP_LOG2_NATT,
+	RTE_SATP_LOG2_SQN_SHARD
 };
 
 #define RTE_IPSEC_SATP_IPV_MASK		(1ULL << RTE_SATP_LOG2_IPV)
@@ -131,6 +161,10 @@ enum {
 #define RTE_IPSEC_SATP_NATT_DISABLE	(0ULL << RTE_SATP_LOG2_NATT)
 #define RTE_IPSEC_SATP_NATT_ENABLE	(1ULL << RTE_SATP_LOG2_NATT)
 
+#define RTE_IPSEC_SATP_SQN_SHARD_MASK		(1ULL << RTE_SATP_LOG2_SQN_SHARD)
+#define RTE_IPSEC_SATP_SQN_SHARD_DISABLE	(0ULL << RTE_SATP_LOG2_SQN_SHARD)
+#define RTE_IPSEC_SATP_SQN_SHARD_ENABLE		(1ULL << RTE_SATP_LOG2_SQN_SHARD)
+
 
 /**
  * get type of given SA
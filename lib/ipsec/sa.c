@@ -122,6 +122,39 @@ replay_num_bucket(uint32_t wsz)
 	return nb;
 }
 
+/*
+ * for given size, calculate required number of slots
+ * of the sharded replay window.
+ */
+static uint32_t
+shard_num_bucket(uint32_t wsz)
+{
+	uint32_t nb;
+
+	/* one extra slot for the partially filled bucket at the window top */
+	nb = rte_align32pow2(RTE_ALIGN_MUL_CEIL(wsz, SHARD_BUCKET_SIZE) /
+		SHARD_BUCKET_SIZE + 1);
+	nb = RTE_MAX(nb, (uint32_t)WINDOW_BUCKET_MIN);
+
+	return nb;
+}
+
+/**
+ * Calculate required size for the sharded sequence number information:
+ * replay window slots for inbound SA, per lcore blocks for outbound SA.
+ */
+static size_t
+shard_size(uint64_t type, uint32_t nb_bucket)
+{
+	struct replay_shard *rsh;
+
+	if ((type & RTE_IPSEC_SATP_DIR_MASK) == RTE_IPSEC_SATP_DIR_OB)
+		return RTE_MAX_LCORE * sizeof(struct sqn_blk);
+
+	return RTE_ALIGN_CEIL(sizeof(*rsh) +
+		nb_bucket * sizeof(rsh->window[0]), RTE_CACHE_LINE_SIZE);
+}
+
 static int32_t
 ipsec_sa_size(uint64_t type, uint32_t *wnd_sz, uint32_t *nb_bucket)
 {
@@ -141,7 +174,9 @@ ipsec_sa_size(uint64_t type, uint32_t *wnd_sz, uint32_t *nb_bucket)
 			RTE_IPSEC_SATP_ESN_DISABLE) ?
 			wsz : RTE_MAX(wsz, (uint32_t)WINDOW_BUCKET_SIZE);
 		if (wsz != 0)
-			n = replay_num_bucket(wsz);
+			n = (type & RTE_IPSEC_SATP_SQN_SHARD_MASK) ==
+				RTE_IPSEC_SATP_SQN_SHARD_ENABLE ?
+				shard_num_bucket(wsz) : replay_num_bucket(wsz);
 	}
 
 	if (n > WINDOW_BUCKET_MAX)
@@ -150,9 +185,15 @@ ipsec_sa_size(uint64_t type, uint32_t *wnd_sz, uint32_t *nb_bucket)
 	*wnd_sz = wsz;
 	*nb_bucket = n;
 
-	sz = rsn_size(n);
-	if ((type & RTE_IPSEC_SATP_SQN_MASK) == RTE_IPSEC_SATP_SQN_ATOM)
-		sz *= REPLAY_SQN_NUM;
+	if ((type & RTE_IPSEC_SATP_SQN_SHARD_MASK) ==
+			RTE_IPSEC_SATP_SQN_SHARD_ENABLE)
+		sz = shard_size(type, n);
+	else {
+		sz = rsn_size(n);
+		if ((type & RTE_IPSEC_SATP_SQN_MASK) ==
+				RTE_IPSEC_SATP_SQN_ATOM)
+			sz *= REPLAY_SQN_NUM;
+	}
 
 	sz += sizeof(struct rte_ipsec_sa);
 	return sz;
@@ -241,11 +282,19 @@ fill_sa_type(const struct rte_ipsec_sa_prm *prm, uint64_t *type)
 		tp |= RTE_IPSEC_SATP_DSCP_ENABLE;
 
 	/* interpret flags */
-	if (prm->flags & RTE_IPSEC_SAFLAG_SQN_ATOM)
+	if (prm->flags & (RTE_IPSEC_SAFLAG_SQN_ATOM | RTE_IPSEC_SAFLAG_SQN_SHARD))
 		tp |= RTE_IPSEC_SATP_SQN_ATOM;
 	else
 		tp |= RTE_IPSEC_SATP_SQN_RAW;
 
+	if (prm->flags & RTE_IPSEC_SAFLAG_SQN_SHARD) {
+		if (prm->sqn_blk_sz != 0 &&
+				!rte_is_power_of_2(prm->sqn_blk_sz))
+			return -EINVAL;
+		tp |= RTE_IPSEC_SATP_SQN_SHARD_ENABLE;
+	} else
+		tp |= RTE_IPSEC_SATP_SQN_SHARD_DISABLE;
+
 	*type = tp;
 	return 0;
 }
@@ -519,6 +568,15 @@ fill_sa_replay(struct rte_ipsec_sa *sa, uint32_t wnd_sz, uint32_t nb_bucket,
 	sa->replay.win_sz = wnd_sz;
 	sa->replay.nb_bucket = nb_bucket;
 	sa->replay.bucket_index_mask = nb_bucket - 1;
+
+	/* sharded window is all zeroes, slot tags included */
+	if ((sa->type & RTE_IPSEC_SATP_SQN_SHARD_MASK) ==
+			RTE_IPSEC_SATP_SQN_SHARD_ENABLE) {
+		sa->shard.inb = (struct replay_shard *)(sa + 1);
+		sa->shard.inb->sqn = sqn;
+		return;
+	}
+
 	sa->sqn.inb.rsn[0] = (struct replay_sqn *)(sa + 1);
 	sa->sqn.inb.rsn[0]->sqn = sqn;
 	if ((sa->type & RTE_IPSEC_SATP_SQN_MASK) == RTE_IPSEC_SATP_SQN_ATOM) {
@@ -609,6 +667,15 @@ rte_ipsec_sa_init(struct rte_ipsec_sa *sa, const struct rte_ipsec_sa_prm *prm,
 	if (nb != 0)
 		fill_sa_replay(sa, wsz, nb, prm->ipsec_xform.esn.value);
 
+	/* per lcore blocks of outbound sequence numbers */
+	if ((type & (RTE_IPSEC_SATP_DIR_MASK | RTE_IPSEC_SATP_SQN_SHARD_MASK))
+			== (RTE_IPSEC_SATP_DIR_OB |
+			RTE_IPSEC_SATP_SQN_SHARD_ENABLE)) {
+		sa->shard.outb = (struct sqn_blk *)(sa + 1);
+		sa->shard.blk_sz = prm->sqn_blk_sz != 0 ?
+			prm->sqn_blk_sz : RTE_IPSEC_SQN_BLK_SIZE_DEFAULT;
+	}
+
 	return sz;
 }
 
@@ -62,6 +62,18 @@ struct replay_sqn {
 	uint64_t window[];
 };
 
+/* sharded replay window, see ipsec_sqn.h */
+struct replay_shard {
+	RTE_ATOMIC(uint64_t) sqn;
+	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(uint64_t) window[];
+};
+
+/* block of outbound sequence numbers reserved by an lcore */
+struct __rte_cache_aligned sqn_blk {
+	uint64_t next;
+	uint64_t end;
+};
+
 /*IPSEC SA supported algorithms */
 enum sa_algo_type	{
 	ALGO_TYPE_NULL = 0,
@@ -131,6 +143,14 @@ struct __rte_cache_aligned rte_ipsec_sa {
 			struct replay_sqn *rsn[REPLAY_SQN_NUM];
 		} inb;
 	} sqn;
+	/* sharded sqn and replay window, RTE_IPSEC_SATP_SQN_SHARD_ENABLE */
+	struct {
+		union {
+			struct sqn_blk *outb; /* per lcore blocks */
+			struct replay_shard *inb;
+		};
+		uint32_t blk_sz;
+	} shard;
 	/* Statistics */
 	struct {
 		uint64_t count;
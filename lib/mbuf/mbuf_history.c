@@ -2,10 +2,15 @@
  * Copyright(c) 2024 NVIDIA Corporation & Affiliates
  */
 
+#include <string.h>
+
 #include <rte_errno.h>
 #include <eal_export.h>
 #include <rte_bitops.h>
+#include <rte_cycles.h>
 #include <rte_mempool.h>
+#include <rte_string_fns.h>
+#include <rte_telemetry.h>
 
 #include "rte_mbuf_history.h"
 #include "rte_mbuf_dyn.h"
@@ -16,10 +21,48 @@
 RTE_EXPORT_SYMBOL(rte_mbuf_history_field_offset);
 int rte_mbuf_history_field_offset = -1;
 
+static const char * const mbuf_history_stage_names[] = {
+	[RTE_MBUF_HISTORY_STAGE_FREE] = "free",
+	[RTE_MBUF_HISTORY_STAGE_DRIVER] = "driver",
+	[RTE_MBUF_HISTORY_STAGE_APP] = "app",
+	[RTE_MBUF_HISTORY_STAGE_QUEUE] = "queue",
+};
+
 #ifdef RTE_MBUF_HISTORY_DEBUG
 
 #define HISTORY_LAST_MASK (RTE_BIT64(RTE_MBUF_HISTORY_BITS) - 1)
 
+/* Dynamic field definition for the TSC timestamp used for ages */
+static const struct rte_mbuf_dynfield mbuf_dynfield_history_ts = {
+	.name = RTE_MBUF_DYNFIELD_HISTORY_TIMESTAMP_NAME,
+	.size = sizeof(uint64_t),
+	.align = alignof(uint64_t),
+};
+
+/* Context structure for the stage counting walk */
+struct mbuf_history_stage_ctx {
+	struct rte_mbuf_history_stats *stats;
+	int ts_offset;
+};
+
+static const char * const mbuf_history_op_names[RTE_MBUF_HISTORY_OP_MAX] = {
+	[RTE_MBUF_HISTORY_OP_NEVER] = "never",
+	[RTE_MBUF_HISTORY_OP_LIB_FREE] = "lib_free",
+	[RTE_MBUF_HISTORY_OP_PMD_FREE] = "pmd_free",
+	[RTE_MBUF_HISTORY_OP_APP_FREE] = "app_free",
+	[RTE_MBUF_HISTORY_OP_LIB_ALLOC] = "lib_alloc",
+	[RTE_MBUF_HISTORY_OP_PMD_ALLOC] = "pmd_alloc",
+	[RTE_MBUF_HISTORY_OP_APP_ALLOC] = "app_alloc",
+	[RTE_MBUF_HISTORY_OP_RX] = "rx",
+	[RTE_MBUF_HISTORY_OP_TX] = "tx",
+	[RTE_MBUF_HISTORY_OP_TX_PREP] = "tx_prep",
+	[RTE_MBUF_HISTORY_OP_TX_BUSY] = "tx_busy",
+	[RTE_MBUF_HISTORY_OP_ENQUEUE] = "enqueue",
+	[RTE_MBUF_HISTORY_OP_DEQUEUE] = "dequeue",
+	[RTE_MBUF_HISTORY_OP_USR2] = "usr2",
+	[RTE_MBUF_HISTORY_OP_USR1] = "usr1",
+};
+
 /* Dynamic field definition for mbuf history */
 static const struct rte_mbuf_dynfield mbuf_dynfield_history = {
 	.name = RTE_MBUF_DYNFIELD_HISTORY_NAME,
@@ -135,8 +178,188 @@ mbuf_history_get_stats_walking(struct rte_mempool *mp, void *arg)
 	mbuf_history_get_stats(mp, arg);
 }
 
+static void
+mbuf_history_count_stage(struct rte_mempool *mp __rte_unused,
+		void *opaque, void *obj, unsigned int obj_idx __rte_unused)
+{
+	struct mbuf_history_stage_ctx *ctx = opaque;
+	struct rte_mbuf_history_stats *stats = ctx->stats;
+	struct rte_mbuf *m = obj;
+	enum rte_mbuf_history_stage stage;
+	enum rte_mbuf_history_op last_op;
+	uint64_t now, ts, age;
+
+	last_op = mbuf_history_get(m) & HISTORY_LAST_MASK;
+	stage = rte_mbuf_history_op_stage(last_op);
+
+	stats->total++;
+	stats->op[last_op]++;
+	stats->stage[stage]++;
+
+	if (ctx->ts_offset < 0 || stage == RTE_MBUF_HISTORY_STAGE_FREE)
+		return;
+
+	ts = *RTE_MBUF_DYNFIELD(m, ctx->ts_offset, uint64_t *);
+	now = rte_get_tsc_cycles();
+	if (ts == 0 || ts > now)
+		return;
+
+	age = now - ts;
+	stats->stage_aged[stage]++;
+	stats->stage_age_sum[stage] += age;
+	if (age > stats->stage_age_max[stage])
+		stats->stage_age_max[stage] = age;
+}
+
+struct mbuf_history_tel_arg {
+	const char *pool_name;
+	struct rte_tel_data *d;
+	int ret;
+};
+
+static void
+mbuf_history_tel_cb(struct rte_mempool *mp, void *arg)
+{
+	struct mbuf_history_tel_arg *tel = arg;
+	struct rte_mbuf_history_stats stats;
+	char name[RTE_TEL_MAX_STRING_LEN];
+	unsigned int i;
+	int ts_offset;
+
+	if (strncmp(mp->name, tel->pool_name, RTE_MEMPOOL_NAMESIZE) != 0)
+		return;
+
+	ts_offset = rte_mbuf_dynfield_lookup(RTE_MBUF_DYNFIELD_HISTORY_TIMESTAMP_NAME, NULL);
+
+	tel->ret = rte_mbuf_history_stats_get(mp, &stats);
+	if (tel->ret != 0)
+		return;
+
+	rte_tel_data_add_dict_uint(tel->d, "total", stats.total);
+	for (i = 0; i < RTE_MBUF_HISTORY_STAGE_MAX; i++) {
+		rte_tel_data_add_dict_uint(tel->d,
+				mbuf_history_stage_names[i], stats.stage[i]);
+		if (ts_offset < 0 || i == RTE_MBUF_HISTORY_STAGE_FREE)
+			continue;
+		snprintf(name, sizeof(name), "%s_age_avg",
+				mbuf_history_stage_names[i]);
+		rte_tel_data_add_dict_uint(tel->d, name, stats.stage_aged[i] != 0 ?
+				stats.stage_age_sum[i] / stats.stage_aged[i] : 0);
+		snprintf(name, sizeof(name), "%s_age_max",
+				mbuf_history_stage_names[i]);
+		rte_tel_data_add_dict_uint(tel->d, name, stats.stage_age_max[i]);
+	}
+	for (i = 0; i < RTE_MBUF_HISTORY_OP_MAX; i++) {
+		if (mbuf_history_op_names[i] == NULL)
+			continue;
+		snprintf(name, sizeof(name), "last_%s", mbuf_history_op_names[i]);
+		rte_tel_data_add_dict_uint(tel->d, name, stats.op[i]);
+	}
+}
+
+static int
+mbuf_history_handle_stats(const char *cmd __rte_unused, const char *params,
+		struct rte_tel_data *d)
+{
+	struct mbuf_history_tel_arg arg;
+	char name[RTE_MEMPOOL_NAMESIZE];
+
+	if (params == NULL || strlen(params) == 0)
+		return -EINVAL;
+
+	rte_strlcpy(name, params, sizeof(name));
+
+	rte_tel_data_start_dict(d);
+	arg.pool_name = name;
+	arg.d = d;
+	arg.ret = -ENOENT;
+	rte_mempool_walk(mbuf_history_tel_cb, &arg);
+
+	return arg.ret;
+}
+
+RTE_INIT(mbuf_history_init_telemetry)
+{
+	rte_telemetry_register_cmd("/mbuf/history", mbuf_history_handle_stats,
+		"Returns summary of mbuf history for a mempool. Parameters: pool_name");
+}
+
 #endif /* RTE_MBUF_HISTORY_DEBUG */
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mbuf_history_op_stage, 25.11)
+enum rte_mbuf_history_stage
+rte_mbuf_history_op_stage(enum rte_mbuf_history_op op)
+{
+	switch (op) {
+	case RTE_MBUF_HISTORY_OP_NEVER:
+	case RTE_MBUF_HISTORY_OP_LIB_FREE:
+	case RTE_MBUF_HISTORY_OP_PMD_FREE:
+	case RTE_MBUF_HISTORY_OP_APP_FREE:
+		return RTE_MBUF_HISTORY_STAGE_FREE;
+	case RTE_MBUF_HISTORY_OP_PMD_ALLOC:
+	case RTE_MBUF_HISTORY_OP_TX:
+		return RTE_MBUF_HISTORY_STAGE_DRIVER;
+	case RTE_MBUF_HISTORY_OP_ENQUEUE:
+		return RTE_MBUF_HISTORY_STAGE_QUEUE;
+	default:
+		return RTE_MBUF_HISTORY_STAGE_APP;
+	}
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mbuf_history_stage_name, 25.11)
+const char *
+rte_mbuf_history_stage_name(enum rte_mbuf_history_stage stage)
+{
+	if ((unsigned int)stage >= RTE_DIM(mbuf_history_stage_names))
+		return NULL;
+	return mbuf_history_stage_names[stage];
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mbuf_history_timestamp_register, 25.11)
+int
+rte_mbuf_history_timestamp_register(void)
+{
+#ifndef RTE_MBUF_HISTORY_DEBUG
+	return -ENOTSUP;
+#else
+	int offset;
+
+	offset = rte_mbuf_dynfield_register(&mbuf_dynfield_history_ts);
+	if (offset < 0)
+		return -rte_errno;
+	return offset;
+#endif
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mbuf_history_stats_get, 25.11)
+int
+rte_mbuf_history_stats_get(struct rte_mempool *mp,
+		struct rte_mbuf_history_stats *stats)
+{
+#ifndef RTE_MBUF_HISTORY_DEBUG
+	RTE_SET_USED(mp);
+	RTE_SET_USED(stats);
+	return -ENOTSUP;
+#else
+	struct mbuf_history_stage_ctx ctx;
+
+	if (mp == NULL || stats == NULL)
+		return -EINVAL;
+	if (mp->elt_size < sizeof(struct rte_mbuf))
+		return -EINVAL;
+	if (rte_mbuf_history_field_offset < 0)
+		return -ENOTSUP;
+
+	memset(stats, 0, sizeof(*stats));
+	ctx.stats = stats;
+	/* The offset of the primary process is found by name in a secondary */
+	ctx.ts_offset = rte_mbuf_dynfield_lookup(RTE_MBUF_DYNFIELD_HISTORY_TIMESTAMP_NAME, NULL);
+	rte_mempool_obj_iter(mp, mbuf_history_count_stage, &ctx);
+
+	return 0;
+#endif
+}
+
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mbuf_history_dump, 25.11)
 void rte_mbuf_history_dump(FILE *f, const struct rte_mbuf *m)
 {
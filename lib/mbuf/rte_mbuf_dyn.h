@@ -248,6 +248,13 @@ void rte_mbuf_dyn_dump(FILE *out);
  */
 #define RTE_MBUF_DYNFIELD_HISTORY_NAME "rte_mbuf_dynfield_history"
 
+/**
+ * The mbuf history timestamp dynamic field holds the TSC cycles
+ * at which the mbuf entered its current lifecycle stage.
+ * It is written by the application, and read to report the mbuf ages.
+ */
+#define RTE_MBUF_DYNFIELD_HISTORY_TIMESTAMP_NAME "rte_mbuf_dynfield_history_timestamp"
+
 /**
  * Type for mbuf history dynamic field.
  *
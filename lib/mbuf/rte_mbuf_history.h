@@ -71,6 +71,34 @@ enum rte_mbuf_history_op {
 	RTE_MBUF_HISTORY_OP_MAX       = 16, /**< Maximum number of operation types */
 };
 
+/**
+ * Lifecycle stages of mbufs, derived from their last history operation.
+ */
+enum rte_mbuf_history_stage {
+	RTE_MBUF_HISTORY_STAGE_FREE   = 0, /**< In the mempool */
+	RTE_MBUF_HISTORY_STAGE_DRIVER = 1, /**< Owned by a PMD (Rx ring or Tx in flight) */
+	RTE_MBUF_HISTORY_STAGE_APP    = 2, /**< Owned by the application */
+	RTE_MBUF_HISTORY_STAGE_QUEUE  = 3, /**< Parked in a software queue */
+	RTE_MBUF_HISTORY_STAGE_MAX    = 4, /**< Maximum number of stages */
+};
+
+/**
+ * Summary of mbuf history for a mempool.
+ */
+struct rte_mbuf_history_stats {
+	uint64_t total; /**< Number of mbufs walked */
+	/** Number of mbufs per last operation */
+	uint64_t op[RTE_MBUF_HISTORY_OP_MAX];
+	/** Number of mbufs per lifecycle stage */
+	uint64_t stage[RTE_MBUF_HISTORY_STAGE_MAX];
+	/** Number of mbufs per stage with a valid timestamp */
+	uint64_t stage_aged[RTE_MBUF_HISTORY_STAGE_MAX];
+	/** Sum of timestamp ages (TSC cycles) per stage */
+	uint64_t stage_age_sum[RTE_MBUF_HISTORY_STAGE_MAX];
+	/** Maximum timestamp age (TSC cycles) per stage */
+	uint64_t stage_age_max[RTE_MBUF_HISTORY_STAGE_MAX];
+};
+
 /**
  * Global offset for the history dynamic field (set during initialization).
  */
@@ -200,6 +228,79 @@ void rte_mbuf_history_dump_mempool(FILE *f, struct rte_mempool *mp);
 __rte_experimental
 void rte_mbuf_history_dump_all(FILE *f);
 
+/**
+ * Get the lifecycle stage corresponding to a history operation.
+ *
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * @param op
+ *   The last operation recorded in an mbuf history.
+ * @return
+ *   The lifecycle stage of the mbuf.
+ */
+__rte_experimental
+enum rte_mbuf_history_stage rte_mbuf_history_op_stage(enum rte_mbuf_history_op op);
+
+/**
+ * Get the name of a lifecycle stage.
+ *
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * @param stage
+ *   The lifecycle stage.
+ * @return
+ *   The stage name, or NULL if invalid.
+ */
+__rte_experimental
+const char *rte_mbuf_history_stage_name(enum rte_mbuf_history_stage stage);
+
+/**
+ * Register the dynamic field used to compute the time spent in a stage.
+ *
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * The field RTE_MBUF_DYNFIELD_HISTORY_TIMESTAMP_NAME is a 64-bit value
+ * written by the application with rte_get_tsc_cycles()
+ * when the mbuf enters a new stage.
+ * It is looked up by name by rte_mbuf_history_stats_get() to report mbuf ages,
+ * including in a secondary process.
+ *
+ * @return
+ *   Offset of the timestamp dynamic field on success,
+ *   -ENOTSUP if mbuf history is not enabled, or another negative errno value.
+ */
+__rte_experimental
+int rte_mbuf_history_timestamp_register(void);
+
+/**
+ * Summarize mbuf history of a mempool.
+ *
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Walk all objects of the mempool and count them per last operation
+ * and per lifecycle stage.
+ * If the timestamp field was registered with rte_mbuf_history_timestamp_register(),
+ * the age of mbufs which are not free is accumulated per stage.
+ * The walk is not atomic with respect to the datapath,
+ * the result is a sample of the mempool state.
+ *
+ * @param mp
+ *   Pointer to the mempool.
+ * @param stats
+ *   Pointer to the structure to fill.
+ * @return
+ *   0 on success, or a negative errno value:
+ *   - -ENOTSUP if mbuf history is not enabled.
+ *   - -EINVAL if a parameter is invalid.
+ */
+__rte_experimental
+int rte_mbuf_history_stats_get(struct rte_mempool *mp,
+		struct rte_mbuf_history_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,310 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include <stdint.h>
+
+#include <rte_common.h>
+#include <rte_vect.h>
+
+#include "mldev_utils_scalar.h"
+
+/* Description:
+ * This file implements AVX2 versions of Machine Learning utility functions used to convert data
+ * types from higher precision to lower precision and vice-versa. The kernels convert whole
+ * vectors and leave the remaining elements to the scalar loops, with identical results.
+ */
+
+/* the conversions between float32 and float16 need F16C, present on all AVX2 CPUs */
+#ifndef __F16C__
+#define __use_f16c __attribute__((target("f16c")))
+#else
+#define __use_f16c
+#endif
+
+/* Round to nearest integer, with halfway cases away from zero, as round() */
+static __rte_always_inline __m256
+round_half_away_avx2(__m256 x)
+{
+	const __m256 sign = _mm256_set1_ps(-0.0f);
+	__m256 t, frac, one;
+
+	t = _mm256_round_ps(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+	frac = _mm256_andnot_ps(sign, _mm256_sub_ps(x, t));
+	one = _mm256_or_ps(_mm256_and_ps(x, sign), _mm256_set1_ps(1.0f));
+	return _mm256_add_ps(t, _mm256_and_ps(_mm256_cmp_ps(frac, _mm256_set1_ps(0.5f),
+							      _CMP_GE_OQ), one));
+}
+
+/* Quantize and saturate in float, NaN giving the lower bound */
+static __rte_always_inline __m256i
+quantize_avx2(const float *input, __m256 scale, __m256 zero_point, __m256 lo, __m256 hi)
+{
+	__m256 x;
+
+	x = round_half_away_avx2(_mm256_div_ps(_mm256_loadu_ps(input), scale));
+	x = _mm256_min_ps(_mm256_max_ps(_mm256_add_ps(x, zero_point), lo), hi);
+	return _mm256_cvtps_epi32(x);
+}
+
+static __rte_always_inline __m256
+dequantize_avx2(__m256i x, __m256i zero_point, __m256 scale)
+{
+	return _mm256_mul_ps(scale, _mm256_cvtepi32_ps(_mm256_sub_epi32(x, zero_point)));
+}
+
+static uint64_t
+float32_to_int8_avx2(const float *input, int8_t *output, uint64_t nb_elements, float scale,
+		     int8_t zero_point)
+{
+	const __m256i perm = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+	const __m256 vscale = _mm256_set1_ps(scale);
+	const __m256 vzp = _mm256_set1_ps(zero_point);
+	const __m256 lo = _mm256_set1_ps(INT8_MIN);
+	const __m256 hi = _mm256_set1_ps(INT8_MAX);
+	__m256i q0, q1, q2, q3, p;
+	uint64_t i;
+
+	for (i = 0; i + 32 <= nb_elements; i += 32) {
+		q0 = quantize_avx2(input + i, vscale, vzp, lo, hi);
+		q1 = quantize_avx2(input + i + 8, vscale, vzp, lo, hi);
+		q2 = quantize_avx2(input + i + 16, vscale, vzp, lo, hi);
+		q3 = quantize_avx2(input + i + 24, vscale, vzp, lo, hi);
+		p = _mm256_packs_epi16(_mm256_packs_epi32(q0, q1), _mm256_packs_epi32(q2, q3));
+		_mm256_storeu_si256((__m256i *)(output + i), _mm256_permutevar8x32_epi32(p, perm));
+	}
+
+	return i;
+}
+
+static uint64_t
+int8_to_float32_avx2(const int8_t *input, float *output, uint64_t nb_elements, float scale,
+		     int8_t zero_point)
+{
+	const __m256 vscale = _mm256_set1_ps(scale);
+	const __m256i vzp = _mm256_set1_epi32(zero_point);
+	__m256i x;
+	uint64_t i;
+
+	for (i = 0; i + 8 <= nb_elements; i += 8) {
+		x = _mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i *)(input + i)));
+		_mm256_storeu_ps(output + i, dequantize_avx2(x, vzp, vscale));
+	}
+
+	return i;
+}
+
+static uint64_t
+float32_to_uint8_avx2(const float *input, uint8_t *output, uint64_t nb_elements, float scale,
+		      uint8_t zero_point)
+{
+	const __m256i perm = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+	const __m256 vscale = _mm256_set1_ps(scale);
+	const __m256 vzp = _mm256_set1_ps(zero_point);
+	const __m256 lo = _mm256_setzero_ps();
+	const __m256 hi = _mm256_set1_ps(UINT8_MAX);
+	__m256i q0, q1, q2, q3, p;
+	uint64_t i;
+
+	for (i = 0; i + 32 <= nb_elements; i += 32) {
+		q0 = quantize_avx2(input + i, vscale, vzp, lo, hi);
+		q1 = quantize_avx2(input + i + 8, vscale, vzp, lo, hi);
+		q2 = quantize_avx2(input + i + 16, vscale, vzp, lo, hi);
+		q3 = quantize_avx2(input + i + 24, vscale, vzp, lo, hi);
+		p = _mm256_packus_epi16(_mm256_packs_epi32(q0, q1), _mm256_packs_epi32(q2, q3));
+		_mm256_storeu_si256((__m256i *)(output + i), _mm256_permutevar8x32_epi32(p, perm));
+	}
+
+	return i;
+}
+
+static uint64_t
+uint8_to_float32_avx2(const uint8_t *input, float *output, uint64_t nb_elements, float scale,
+		      uint8_t zero_point)
+{
+	const __m256 vscale = _mm256_set1_ps(scale);
+	const __m256i vzp = _mm256_set1_epi32(zero_point);
+	__m256i x;
+	uint64_t i;
+
+	for (i = 0; i + 8 <= nb_elements; i += 8) {
+		x = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(input + i)));
+		_mm256_storeu_ps(output + i, dequantize_avx2(x, vzp, vscale));
+	}
+
+	return i;
+}
+
+static uint64_t
+float32_to_int16_avx2(const float *input, int16_t *output, uint64_t nb_elements, float scale,
+		      int16_t zero_point)
+{
+	const __m256 vscale = _mm256_set1_ps(scale);
+	const __m256 vzp = _mm256_set1_ps(zero_point);
+	const __m256 lo = _mm256_set1_ps(INT16_MIN);
+	const __m256 hi = _mm256_set1_ps(INT16_MAX);
+	__m256i q0, q1, p;
+	uint64_t i;
+
+	for (i = 0; i + 16 <= nb_elements; i += 16) {
+		q0 = quantize_avx2(input + i, vscale, vzp, lo, hi);
+		q1 = quantize_avx2(input + i + 8, vscale, vzp, lo, hi);
+		p = _mm256_packs_epi32(q0, q1);
+		_mm256_storeu_si256((__m256i *)(output + i),
+				    _mm256_permute4x64_epi64(p, _MM_SHUFFLE(3, 1, 2, 0)));
+	}
+
+	return i;
+}
+
+static uint64_t
+int16_to_float32_avx2(const int16_t *input, float *output, uint64_t nb_elements, float scale,
+		      int16_t zero_point)
+{
+	const __m256 vscale = _mm256_set1_ps(scale);
+	const __m256i vzp = _mm256_set1_epi32(zero_point);
+	__m256i x;
+	uint64_t i;
+
+	for (i = 0; i + 8 <= nb_elements; i += 8) {
+		x = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(input + i)));
+		_mm256_storeu_ps(output + i, dequantize_avx2(x, vzp, vscale));
+	}
+
+	return i;
+}
+
+static uint64_t
+float32_to_uint16_avx2(const float *input, uint16_t *output, uint64_t nb_elements, float scale,
+		       uint16_t zero_point)
+{
+	const __m256 vscale = _mm256_set1_ps(scale);
+	const __m256 vzp = _mm256_set1_ps(zero_point);
+	const __m256 lo = _mm256_setzero_ps();
+	const __m256 hi = _mm256_set1_ps(UINT16_MAX);
+	__m256i q0, q1, p;
+	uint64_t i;
+
+	for (i = 0; i + 16 <= nb_elements; i += 16) {
+		q0 = quantize_avx2(input + i, vscale, vzp, lo, hi);
+		q1 = quantize_avx2(input + i + 8, vscale, vzp, lo, hi);
+		p = _mm256_packus_epi32(q0, q1);
+		_mm256_storeu_si256((__m256i *)(output + i),
+				    _mm256_permute4x64_epi64(p, _MM_SHUFFLE(3, 1, 2, 0)));
+	}
+
+	return i;
+}
+
+static uint64_t
+uint16_to_float32_avx2(const uint16_t *input, float *output, uint64_t nb_elements, float scale,
+		       uint16_t zero_point)
+{
+	const __m256 vscale = _mm256_set1_ps(scale);
+	const __m256i vzp = _mm256_set1_epi32(zero_point);
+	__m256i x;
+	uint64_t i;
+
+	for (i = 0; i + 8 <= nb_elements; i += 8) {
+		x = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(input + i)));
+		_mm256_storeu_ps(output + i, dequantize_avx2(x, vzp, vscale));
+	}
+
+	return i;
+}
+
+__use_f16c
+static uint64_t
+float32_to_float16_avx2(const float *input, uint16_t *output, uint64_t nb_elements)
+{
+	uint64_t i;
+
+	for (i = 0; i + 8 <= nb_elements; i += 8)
+		_mm_storeu_si128((__m128i *)(output + i),
+				 _mm256_cvtps_ph(_mm256_loadu_ps(input + i),
+						 _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+
+	return i;
+}
+
+__use_f16c
+static uint64_t
+float16_to_float32_avx2(const uint16_t *input, float *output, uint64_t nb_elements)
+{
+	uint64_t i;
+
+	for (i = 0; i + 8 <= nb_elements; i += 8)
+		_mm256_storeu_ps(output + i,
+				 _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(input + i))));
+
+	return i;
+}
+
+/* Round to nearest even on the integer representation, quieting NaNs as the scalar code */
+static __rte_always_inline __m256i
+float32_to_bfloat16_avx2_x8(const float *input)
+{
+	const __m256i abs_mask = _mm256_set1_epi32(0x7fffffff);
+	const __m256i inf = _mm256_set1_epi32(0x7f800000);
+	__m256i u, r, nan, qnan;
+
+	u = _mm256_loadu_si256((const __m256i *)input);
+	r = _mm256_add_epi32(_mm256_set1_epi32(0x7fff),
+			     _mm256_and_si256(_mm256_srli_epi32(u, 16), _mm256_set1_epi32(1)));
+	r = _mm256_srli_epi32(_mm256_add_epi32(u, r), 16);
+	nan = _mm256_cmpgt_epi32(_mm256_and_si256(u, abs_mask), inf);
+	qnan = _mm256_or_si256(_mm256_srli_epi32(u, 16), _mm256_set1_epi32(0x40));
+	return _mm256_blendv_epi8(r, qnan, nan);
+}
+
+static uint64_t
+float32_to_bfloat16_avx2(const float *input, uint16_t *output, uint64_t nb_elements)
+{
+	__m256i p;
+	uint64_t i;
+
+	for (i = 0; i + 16 <= nb_elements; i += 16) {
+		p = _mm256_packus_epi32(float32_to_bfloat16_avx2_x8(input + i),
+					float32_to_bfloat16_avx2_x8(input + i + 8));
+		_mm256_storeu_si256((__m256i *)(output + i),
+				    _mm256_permute4x64_epi64(p, _MM_SHUFFLE(3, 1, 2, 0)));
+	}
+
+	return i;
+}
+
+static uint64_t
+bfloat16_to_float32_avx2(const uint16_t *input, float *output, uint64_t nb_elements)
+{
+	const __m256i abs_mask = _mm256_set1_epi32(0x7fffffff);
+	const __m256i inf = _mm256_set1_epi32(0x7f800000);
+	const __m256i quiet = _mm256_set1_epi32(0x400000);
+	__m256i u, nan;
+	uint64_t i;
+
+	for (i = 0; i + 8 <= nb_elements; i += 8) {
+		u = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(input + i)));
+		u = _mm256_slli_epi32(u, 16);
+		nan = _mm256_cmpgt_epi32(_mm256_and_si256(u, abs_mask), inf);
+		u = _mm256_or_si256(u, _mm256_and_si256(nan, quiet));
+		_mm256_storeu_si256((__m256i *)(output + i), u);
+	}
+
+	return i;
+}
+
+const struct mldev_utils_vec mldev_utils_vec_avx2 = {
+	.name = "avx2",
+	.float32_to_int8 = float32_to_int8_avx2,
+	.int8_to_float32 = int8_to_float32_avx2,
+	.float32_to_uint8 = float32_to_uint8_avx2,
+	.uint8_to_float32 = uint8_to_float32_avx2,
+	.float32_to_int16 = float32_to_int16_avx2,
+	.int16_to_float32 = int16_to_float32_avx2,
+	.float32_to_uint16 = float32_to_uint16_avx2,
+	.uint16_to_float32 = uint16_to_float32_avx2,
+	.float32_to_float16 = float32_to_float16_avx2,
+	.float16_to_float32 = float16_to_float32_avx2,
+	.float32_to_bfloat16 = float32_to_bfloat16_avx2,
+	.bfloat16_to_float32 = bfloat16_to_float32_avx2,
+};
@@ -0,0 +1,319 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 Intel Corporation
+ */
+
+#include <stdint.h>
+
+#include <rte_common.h>
+#include <rte_vect.h>
+
+#include "mldev_utils_scalar.h"
+
+/* Description:
+ * This file implements AVX512 versions of Machine Learning utility functions used to convert
+ * data types from higher precision to lower precision and vice-versa. The last elements are
+ * converted with masked loads and stores, with results identical to the scalar loops.
+ *
+ * The AVX512-BF16 conversion instruction flushes denormals, unlike the scalar code,
+ * so bfloat16 is rounded on the integer representation. The float16 conversions of AVX512F
+ * are exact and do not need AVX512-FP16.
+ */
+
+#define ML_VEC_LEN 16
+
+static __rte_always_inline __mmask16
+tail_mask(uint64_t i, uint64_t nb_elements)
+{
+	if (nb_elements - i >= ML_VEC_LEN)
+		return 0xffff;
+	return (__mmask16)((1U << (nb_elements - i)) - 1);
+}
+
+/* Round to nearest integer, with halfway cases away from zero, as round() */
+static __rte_always_inline __m512
+round_half_away_avx512(__m512 x)
+{
+	const __m512i sign = _mm512_set1_epi32(INT32_MIN);
+	__m512 t, frac;
+	__m512i one;
+	__mmask16 m;
+
+	t = _mm512_roundscale_ps(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+	frac = _mm512_abs_ps(_mm512_sub_ps(x, t));
+	m = _mm512_cmp_ps_mask(frac, _mm512_set1_ps(0.5f), _CMP_GE_OQ);
+	one = _mm512_or_si512(_mm512_and_si512(_mm512_castps_si512(x), sign),
+			      _mm512_castps_si512(_mm512_set1_ps(1.0f)));
+	return _mm512_mask_add_ps(t, m, t, _mm512_castsi512_ps(one));
+}
+
+/* Quantize and saturate in float, NaN giving the lower bound */
+static __rte_always_inline __m512i
+quantize_avx512(__m512 x, __m512 scale, __m512 zero_point, __m512 lo, __m512 hi)
+{
+	x = round_half_away_avx512(_mm512_div_ps(x, scale));
+	x = _mm512_min_ps(_mm512_max_ps(_mm512_add_ps(x, zero_point), lo), hi);
+	return _mm512_cvtps_epi32(x);
+}
+
+static __rte_always_inline __m512
+dequantize_avx512(__m512i x, __m512i zero_point, __m512 scale)
+{
+	return _mm512_mul_ps(scale, _mm512_cvtepi32_ps(_mm512_sub_epi32(x, zero_point)));
+}
+
+static uint64_t
+float32_to_int8_avx512(const float *input, int8_t *output, uint64_t nb_elements, float scale,
+		       int8_t zero_point)
+{
+	const __m512 vscale = _mm512_set1_ps(scale);
+	const __m512 vzp = _mm512_set1_ps(zero_point);
+	const __m512 lo = _mm512_set1_ps(INT8_MIN);
+	const __m512 hi = _mm512_set1_ps(INT8_MAX);
+	__mmask16 mask;
+	__m512i q;
+	uint64_t i;
+
+	for (i = 0; i < nb_elements; i += ML_VEC_LEN) {
+		mask = tail_mask(i, nb_elements);
+		q = quantize_avx512(_mm512_maskz_loadu_ps(mask, input + i), vscale, vzp, lo, hi);
+		_mm512_mask_cvtsepi32_storeu_epi8(output + i, mask, q);
+	}
+
+	return nb_elements;
+}
+
+static uint64_t
+int8_to_float32_avx512(const int8_t *input, float *output, uint64_t nb_elements, float scale,
+		       int8_t zero_point)
+{
+	const __m512 vscale = _mm512_set1_ps(scale);
+	const __m512i vzp = _mm512_set1_epi32(zero_point);
+	__mmask16 mask;
+	__m512i x;
+	uint64_t i;
+
+	for (i = 0; i < nb_elements; i += ML_VEC_LEN) {
+		mask = tail_mask(i, nb_elements);
+		x = _mm512_cvtepi8_epi32(_mm_maskz_loadu_epi8(mask, input + i));
+		_mm512_mask_storeu_ps(output + i, mask, dequantize_avx512(x, vzp, vscale));
+	}
+
+	return nb_elements;
+}
+
+static uint64_t
+float32_to_uint8_avx512(const float *input, uint8_t *output, uint64_t nb_elements, float scale,
+			uint8_t zero_point)
+{
+	const __m512 vscale = _mm512_set1_ps(scale);
+	const __m512 vzp = _mm512_set1_ps(zero_point);
+	const __m512 lo = _mm512_setzero_ps();
+	const __m512 hi = _mm512_set1_ps(UINT8_MAX);
+	__mmask16 mask;
+	__m512i q;
+	uint64_t i;
+
+	for (i = 0; i < nb_elements; i += ML_VEC_LEN) {
+		mask = tail_mask(i, nb_elements);
+		q = quantize_avx512(_mm512_maskz_loadu_ps(mask, input + i), vscale, vzp, lo, hi);
+		_mm512_mask_cvtusepi32_storeu_epi8(output + i, mask, q);
+	}
+
+	return nb_elements;
+}
+
+static uint64_t
+uint8_to_float32_avx512(const uint8_t *input, float *output, uint64_t nb_elements, float scale,
+			uint8_t zero_point)
+{
+	const __m512 vscale = _mm512_set1_ps(scale);
+	const __m512i vzp = _mm512_set1_epi32(zero_point);
+	__mmask16 mask;
+	__m512i x;
+	uint64_t i;
+
+	for (i = 0; i < nb_elements; i += ML_VEC_LEN) {
+		mask = tail_mask(i, nb_elements);
+		x = _mm512_cvtepu8_epi32(_mm_maskz_loadu_epi8(mask, input + i));
+		_mm512_mask_storeu_ps(output + i, mask, dequantize_avx512(x, vzp, vscale));
+	}
+
+	return nb_elements;
+}
+
+static uint64_t
+float32_to_int16_avx512(const float *input, int16_t *output, uint64_t nb_elements, float scale,
+			int16_t zero_point)
+{
+	const __m512 vscale = _mm512_set1_ps(scale);
+	const __m512 vzp = _mm512_set1_ps(zero_point);
+	const __m512 lo = _mm512_set1_ps(INT16_MIN);
+	const __m512 hi = _mm512_set1_ps(INT16_MAX);
+	__mmask16 mask;
+	__m512i q;
+	uint64_t i;
+
+	for (i = 0; i < nb_elements; i += ML_VEC_LEN) {
+		mask = tail_mask(i, nb_elements);
+		q = quantize_avx512(_mm512_maskz_loadu_ps(mask, input + i), vscale, vzp, lo, hi);
+		_mm512_mask_cvtsepi32_storeu_epi16(output + i, mask, q);
+	}
+
+	return nb_elements;
+}
+
+static uint64_t
+int16_to_float32_avx512(const int16_t *input, float *output, uint64_t nb_elements, float scale,
+			int16_t zero_point)
+{
+	const __m512 vscale = _mm512_set1_ps(scale);
+	const __m512i vzp = _mm512_set1_epi32(zero_point);
+	__mmask16 mask;
+	__m512i x;
+	uint64_t i;
+
+	for (i = 0; i < nb_elements; i += ML_VEC_LEN) {
+		mask = tail_mask(i, nb_elements);
+		x = _mm512_cvtepi16_epi32(_mm256_maskz_loadu_epi16(mask, input + i));
+		_mm512_mask_storeu_ps(output + i, mask, dequantize_avx512(x, vzp, vscale));
+	}
+
+	return nb_elements;
+}
+
+static uint64_t
+float32_to_uint16_avx512(const float *input, uint16_t *output, uint64_t nb_elements, float scale,
+			 uint16_t zero_point)
+{
+	const __m512 vscale = _mm512_set1_ps(scale);
+	const __m512 vzp = _mm512_set1_ps(zero_point);
+	const __m512 lo = _mm512_setzero_ps();
+	const __m512 hi = _mm512_set1_ps(UINT16_MAX);
+	__mmask16 mask;
+	__m512i q;
+	uint64_t i;
+
+	for (i = 0; i < nb_elements; i += ML_VEC_LEN) {
+		mask = tail_mask(i, nb_elements);
+		q = quantize_avx512(_mm512_maskz_loadu_ps(mask, input + i), vscale, vzp, lo, hi);
+		_mm512_mask_cvtusepi32_storeu_epi16(output + i, mask, q);
+	}
+
+	return nb_elements;
+}
+
+static uint64_t
+uint16_to_float32_avx512(const uint16_t *input, float *output, uint64_t nb_elements, float scale,
+			 uint16_t zero_point)
+{
+	const __m512 vscale = _mm512_set1_ps(scale);
+	const __m512i vzp = _mm512_set1_epi32(zero_point);
+	__mmask16 mask;
+	__m512i x;
+	uint64_t i;
+
+	for (i = 0; i < nb_elements; i += ML_VEC_LEN) {
+		mask = tail_mask(i, nb_elements);
+		x = _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(mask, input + i));
+		_mm512_mask_storeu_ps(output + i, mask, dequantize_avx512(x, vzp, vscale));
+	}
+
+	return nb_elements;
+}
+
+static uint64_t
+float32_to_float16_avx512(const float *input, uint16_t *output, uint64_t nb_elements)
+{
+	__mmask16 mask;
+	__m256i h;
+	uint64_t i;
+
+	for (i = 0; i < nb_elements; i += ML_VEC_LEN) {
+		mask = tail_mask(i, nb_elements);
+		h = _mm512_cvtps_ph(_mm512_maskz_loadu_ps(mask, input + i),
+				    _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		_mm256_mask_storeu_epi16(output + i, mask, h);
+	}
+
+	return nb_elements;
+}
+
+static uint64_t
+float16_to_float32_avx512(const uint16_t *input, float *output, uint64_t nb_elements)
+{
+	__mmask16 mask;
+	uint64_t i;
+
+	for (i = 0; i < nb_elements; i += ML_VEC_LEN) {
+		mask = tail_mask(i, nb_elements);
+		_mm512_mask_storeu_ps(output + i, mask,
+				      _mm512_cvtph_ps(_mm256_maskz_loadu_epi16(mask, input + i)));
+	}
+
+	return nb_elements;
+}
+
+/* Round to nearest even on the integer representation, quieting NaNs as the scalar code */
+static uint64_t
+float32_to_bfloat16_avx512(const float *input, uint16_t *output, uint64_t nb_elements)
+{
+	const __m512i abs_mask = _mm512_set1_epi32(INT32_MAX);
+	const __m512i inf = _mm512_set1_epi32(0x7f800000);
+	const __m512i quiet = _mm512_set1_epi32(0x40);
+	const __m512i bias = _mm512_set1_epi32(0x7fff);
+	const __m512i one = _mm512_set1_epi32(1);
+	__mmask16 mask, nan;
+	__m512i u, h, r;
+	uint64_t i;
+
+	for (i = 0; i < nb_elements; i += ML_VEC_LEN) {
+		mask = tail_mask(i, nb_elements);
+		u = _mm512_maskz_loadu_epi32(mask, input + i);
+		h = _mm512_srli_epi32(u, 16);
+		r = _mm512_add_epi32(bias, _mm512_and_si512(h, one));
+		r = _mm512_srli_epi32(_mm512_add_epi32(u, r), 16);
+		nan = _mm512_cmpgt_epi32_mask(_mm512_and_si512(u, abs_mask), inf);
+		r = _mm512_mask_or_epi32(r, nan, h, quiet);
+		_mm512_mask_cvtepi32_storeu_epi16(output + i, mask, r);
+	}
+
+	return nb_elements;
+}
+
+static uint64_t
+bfloat16_to_float32_avx512(const uint16_t *input, float *output, uint64_t nb_elements)
+{
+	const __m512i abs_mask = _mm512_set1_epi32(INT32_MAX);
+	const __m512i inf = _mm512_set1_epi32(0x7f800000);
+	const __m512i quiet = _mm512_set1_epi32(0x400000);
+	__mmask16 mask, nan;
+	__m512i u;
+	uint64_t i;
+
+	for (i = 0; i < nb_elements; i += ML_VEC_LEN) {
+		mask = tail_mask(i, nb_elements);
+		u = _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(mask, input + i));
+		u = _mm512_slli_epi32(u, 16);
+		nan = _mm512_cmpgt_epi32_mask(_mm512_and_si512(u, abs_mask), inf);
+		u = _mm512_mask_or_epi32(u, nan, u, quiet);
+		_mm512_mask_storeu_epi32(output + i, mask, u);
+	}
+
+	return nb_elements;
+}
+
+const struct mldev_utils_vec mldev_utils_vec_avx512 = {
+	.name = "avx512",
+	.float32_to_int8 = float32_to_int8_avx512,
+	.int8_to_float32 = int8_to_float32_avx512,
+	.float32_to_uint8 = float32_to_uint8_avx512,
+	.uint8_to_float32 = uint8_to_float32_avx512,
+	.float32_to_int16 = float32_to_int16_avx512,
+	.int16_to_float32 = int16_to_float32_avx512,
+	.float32_to_uint16 = float32_to_uint16_avx512,
+	.uint16_to_float32 = uint16_to_float32_avx512,
+	.float32_to_float16 = float32_to_float16_avx512,
+	.float16_to_float32 = float16_to_float32_avx512,
+	.float32_to_bfloat16 = float32_to_bfloat16_avx512,
+	.bfloat16_to_float32 = bfloat16_to_float32_avx512,
+};
@@ -5,12 +5,48 @@
 #include "mldev_utils_scalar.h"
 
 #include <eal_export.h>
+#ifdef RTE_ARCH_X86
+#include <rte_cpuflags.h>
+#include <rte_vect.h>
+#endif
 
 /* Description:
  * This file implements scalar versions of Machine Learning utility functions used to convert data
  * types from higher precision to lower precision and vice-versa, except bfloat16.
+ * On x86, the bulk of the elements is converted by AVX2 or AVX512 kernels when available.
  */
 
+#ifdef RTE_ARCH_X86
+static const struct mldev_utils_vec *vec_avx2;
+static const struct mldev_utils_vec *vec_avx512;
+
+RTE_INIT(mldev_utils_vec_init)
+{
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2) &&
+	    rte_cpu_get_flag_enabled(RTE_CPUFLAG_F16C))
+		vec_avx2 = &mldev_utils_vec_avx2;
+#ifdef CC_AVX512_SUPPORT
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) &&
+	    rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512BW) &&
+	    rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512VL))
+		vec_avx512 = &mldev_utils_vec_avx512;
+#endif
+}
+
+/* The max SIMD bitwidth may be changed after the constructors, check it on each call. */
+const struct mldev_utils_vec *
+mldev_utils_vec_get(void)
+{
+	uint16_t max_simd_bitwidth = rte_vect_get_max_simd_bitwidth();
+
+	if (vec_avx512 != NULL && max_simd_bitwidth >= RTE_VECT_SIMD_512)
+		return vec_avx512;
+	if (vec_avx2 != NULL && max_simd_bitwidth >= RTE_VECT_SIMD_256)
+		return vec_avx2;
+	return NULL;
+}
+#endif
+
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ml_io_float32_to_int8, 22.11)
 int
 rte_ml_io_float32_to_int8(const void *input, void *output, uint64_t nb_elements, float scale,
@@ -18,16 +54,19 @@ rte_ml_io_float32_to_int8(const void *input, void *output, uint64_t nb_elements,
 {
 	const float *input_buffer;
 	int8_t *output_buffer;
+	const struct mldev_utils_vec *vec;
 	uint64_t i;
 	int i32;
 
 	if ((scale == 0) || (nb_elements == 0) || (input == NULL) || (output == NULL))
 		return -EINVAL;
 
-	input_buffer = (const float *)input;
-	output_buffer = (int8_t *)output;
+	vec = mldev_utils_vec_get();
+	i = vec != NULL ? vec->float32_to_int8(input, output, nb_elements, scale, zero_point) : 0;
+	input_buffer = (const float *)input + i;
+	output_buffer = (int8_t *)output + i;
 
-	for (i = 0; i < nb_elements; i++) {
+	for (; i < nb_elements; i++) {
 		i32 = (int32_t)(round(*input_buffer / scale) + zero_point);
 
 		if (i32 < INT8_MIN)
@@ -52,15 +91,18 @@ rte_ml_io_int8_to_float32(const void *input, void *output, uint64_t nb_elements,
 {
 	const int8_t *input_buffer;
 	float *output_buffer;
+	const struct mldev_utils_vec *vec;
 	uint64_t i;
 
 	if ((scale == 0) || (nb_elements == 0) || (input == NULL) || (output == NULL))
 		return -EINVAL;
 
-	input_buffer = (const int8_t *)input;
-	output_buffer = (float *)output;
+	vec = mldev_utils_vec_get();
+	i = vec != NULL ? vec->int8_to_float32(input, output, nb_elements, scale, zero_point) : 0;
+	input_buffer = (const int8_t *)input + i;
+	output_buffer = (float *)output + i;
 
-	for (i = 0; i < nb_elements; i++) {
+	for (; i < nb_elements; i++) {
 		*output_buffer = scale * (float)(*input_buffer - zero_point);
 
 		input_buffer++;
@@ -78,15 +120,18 @@ rte_ml_io_float32_to_uint8(const void *input, void *output, uint64_t nb_elements
 	const float *input_buffer;
 	uint8_t *output_buffer;
 	int32_t i32;
+	const struct mldev_utils_vec *vec;
 	uint64_t i;
 
 	if ((scale == 0) || (nb_elements == 0) || (input == NULL) || (output == NULL))
 		return -EINVAL;
 
-	input_buffer = (const float *)input;
-	output_buffer = (uint8_t *)output;
+	vec = mldev_utils_vec_get();
+	i = vec != NULL ? vec->float32_to_uint8(input, output, nb_elements, scale, zero_point) : 0;
+	input_buffer = (const float *)input + i;
+	output_buffer = (uint8_t *)output + i;
 
-	for (i = 0; i < nb_elements; i++) {
+	for (; i < nb_elements; i++) {
 		i32 = (int32_t)(round(*input_buffer / scale) + zero_point);
 
 		if (i32 < 0)
@@ -111,15 +156,18 @@ rte_ml_io_uint8_to_float32(const void *input, void *output, uint64_t nb_elements
 {
 	const uint8_t *input_buffer;
 	float *output_buffer;
+	const struct mldev_utils_vec *vec;
 	uint64_t i;
 
 	if ((scale == 0) || (nb_elements == 0) || (input == NULL) || (output == NULL))
 		return -EINVAL;
 
-	input_buffer = (const uint8_t *)input;
-	output_buffer = (float *)output;
+	vec = mldev_utils_vec_get();
+	i = vec != NULL ? vec->uint8_to_float32(input, output, nb_elements, scale, zero_point) : 0;
+	input_buffer = (const uint8_t *)input + i;
+	output_buffer = (float *)output + i;
 
-	for (i = 0; i < nb_elements; i++) {
+	for (; i < nb_elements; i++) {
 		*output_buffer = scale * (float)(*input_buffer - zero_point);
 
 		input_buffer++;
@@ -137,15 +185,18 @@ rte_ml_io_float32_to_int16(const void *input, void *output, uint64_t nb_elements
 	const float *input_buffer;
 	int16_t *output_buffer;
 	int32_t i32;
+	const struct mldev_utils_vec *vec;
 	uint64_t i;
 
 	if ((scale == 0) || (nb_elements == 0) || (input == NULL) || (output == NULL))
 		return -EINVAL;
 
-	input_buffer = (const float *)input;
-	output_buffer = (int16_t *)output;
+	vec = mldev_utils_vec_get();
+	i = vec != NULL ? vec->float32_to_int16(input, output, nb_elements, scale, zero_point) : 0;
+	input_buffer = (const float *)input + i;
+	output_buffer = (int16_t *)output + i;
 
-	for (i = 0; i < nb_elements; i++) {
+	for (; i < nb_elements; i++) {
 		i32 = (int32_t)(round(*input_buffer / scale) + zero_point);
 
 		if (i32 < INT16_MIN)
@@ -170,15 +221,18 @@ rte_ml_io_int16_to_float32(const void *input, void *output, uint64_t nb_elements
 {
 	const int16_t *input_buffer;
 	float *output_buffer;
+	const struct mldev_utils_vec *vec;
 	uint64_t i;
 
 	if ((scale == 0) || (nb_elements == 0) || (input == NULL) || (output == NULL))
 		return -EINVAL;
 
-	input_buffer = (const int16_t *)input;
-	output_buffer = (float *)output;
+	vec = mldev_utils_vec_get();
+	i = vec != NULL ? vec->int16_to_float32(input, output, nb_elements, scale, zero_point) : 0;
+	input_buffer = (const int16_t *)input + i;
+	output_buffer = (float *)output + i;
 
-	for (i = 0; i < nb_elements; i++) {
+	for (; i < nb_elements; i++) {
 		*output_buffer = scale * (float)(*input_buffer - zero_point);
 
 		input_buffer++;
@@ -196,15 +250,18 @@ rte_ml_io_float32_to_uint16(const void *input, void *output, uint64_t nb_element
 	const float *input_buffer;
 	uint16_t *output_buffer;
 	int32_t i32;
+	const struct mldev_utils_vec *vec;
 	uint64_t i;
 
 	if ((scale == 0) || (nb_elements == 0) || (input == NULL) || (output == NULL))
 		return -EINVAL;
 
-	input_buffer = (const float *)input;
-	output_buffer = (uint16_t *)output;
+	vec = mldev_utils_vec_get();
+	i = vec != NULL ? vec->float32_to_uint16(input, output, nb_elements, scale, zero_point) : 0;
+	input_buffer = (const float *)input + i;
+	output_buffer = (uint16_t *)output + i;
 
-	for (i = 0; i < nb_elements; i++) {
+	for (; i < nb_elements; i++) {
 		i32 = (int32_t)(round(*input_buffer / scale) + zero_point);
 
 		if (i32 < 0)
@@ -229,15 +286,18 @@ rte_ml_io_uint16_to_float32(const void *input, void *output, uint64_t nb_element
 {
 	const uint16_t *input_buffer;
 	float *output_buffer;
+	const struct mldev_utils_vec *vec;
 	uint64_t i;
 
 	if ((scale == 0) || (nb_elements == 0) || (input == NULL) || (output == NULL))
 		return -EINVAL;
 
-	input_buffer = (const uint16_t *)input;
-	output_buffer = (float *)output;
+	vec = mldev_utils_vec_get();
+	i = vec != NULL ? vec->uint16_to_float32(input, output, nb_elements, scale, zero_point) : 0;
+	input_buffer = (const uint16_t *)input + i;
+	output_buffer = (float *)output + i;
 
-	for (i = 0; i < nb_elements; i++) {
+	for (; i < nb_elements; i++) {
 		*output_buffer = scale * (float)(*input_buffer - zero_point);
 
 		input_buffer++;
@@ -587,15 +647,18 @@ rte_ml_io_float32_to_float16(const void *input, void *output, uint64_t nb_elemen
 {
 	const float *input_buffer;
 	uint16_t *output_buffer;
+	const struct mldev_utils_vec *vec;
 	uint64_t i;
 
 	if ((nb_elements == 0) || (input == NULL) || (output == NULL))
 		return -EINVAL;
 
-	input_buffer = (const float *)input;
-	output_buffer = (uint16_t *)output;
+	vec = mldev_utils_vec_get();
+	i = vec != NULL ? vec->float32_to_float16(input, output, nb_elements) : 0;
+	input_buffer = (const float *)input + i;
+	output_buffer = (uint16_t *)output + i;
 
-	for (i = 0; i < nb_elements; i++) {
+	for (; i < nb_elements; i++) {
 		*output_buffer = __float32_to_float16_scalar_rtn(*input_buffer);
 
 		input_buffer = input_buffer + 1;
@@ -672,15 +735,18 @@ rte_ml_io_float16_to_float32(const void *input, void *output, uint64_t nb_elemen
 {
 	const uint16_t *input_buffer;
 	float *output_buffer;
+	const struct mldev_utils_vec *vec;
 	uint64_t i;
 
 	if ((nb_elements == 0) || (input == NULL) || (output == NULL))
 		return -EINVAL;
 
-	input_buffer = (const uint16_t *)input;
-	output_buffer = (float *)output;
+	vec = mldev_utils_vec_get();
+	i = vec != NULL ? vec->float16_to_float32(input, output, nb_elements) : 0;
+	input_buffer = (const uint16_t *)input + i;
+	output_buffer = (float *)output + i;
 
-	for (i = 0; i < nb_elements; i++) {
+	for (; i < nb_elements; i++) {
 		*output_buffer = __float16_to_float32_scalar_rtx(*input_buffer);
 
 		input_buffer = input_buffer + 1;
@@ -78,3 +78,48 @@ union float32 {
 	float f;
 	uint32_t u;
 };
+
+/* Vector kernels, converting the first elements of a buffer and returning their number.
+ * The scalar loops convert the remaining elements, the results are identical.
+ */
+struct mldev_utils_vec {
+	const char *name;
+	uint64_t (*float32_to_int8)(const float *input, int8_t *output, uint64_t nb_elements,
+				    float scale, int8_t zero_point);
+	uint64_t (*int8_to_float32)(const int8_t *input, float *output, uint64_t nb_elements,
+				    float scale, int8_t zero_point);
+	uint64_t (*float32_to_uint8)(const float *input, uint8_t *output, uint64_t nb_elements,
+				     float scale, uint8_t zero_point);
+	uint64_t (*uint8_to_float32)(const uint8_t *input, float *output, uint64_t nb_elements,
+				     float scale, uint8_t zero_point);
+	uint64_t (*float32_to_int16)(const float *input, int16_t *output, uint64_t nb_elements,
+				     float scale, int16_t zero_point);
+	uint64_t (*int16_to_float32)(const int16_t *input, float *output, uint64_t nb_elements,
+				     float scale, int16_t zero_point);
+	uint64_t (*float32_to_uint16)(const float *input, uint16_t *output, uint64_t nb_elements,
+				      float scale, uint16_t zero_point);
+	uint64_t (*uint16_to_float32)(const uint16_t *input, float *output, uint64_t nb_elements,
+				      float scale, uint16_t zero_point);
+	uint64_t (*float32_to_float16)(const float *input, uint16_t *output, uint64_t nb_elements);
+	uint64_t (*float16_to_float32)(const uint16_t *input, float *output, uint64_t nb_elements);
+	uint64_t (*float32_to_bfloat16)(const float *input, uint16_t *output,
+					uint64_t nb_elements);
+	uint64_t (*bfloat16_to_float32)(const uint16_t *input, float *output,
+					uint64_t nb_elements);
+};
+
+#ifdef RTE_ARCH_X86
+extern const struct mldev_utils_vec mldev_utils_vec_avx2;
+#ifdef CC_AVX512_SUPPORT
+extern const struct mldev_utils_vec mldev_utils_vec_avx512;
+#endif
+
+/* Get the widest vector kernels allowed by the CPU and the max SIMD bitwidth, or NULL. */
+const struct mldev_utils_vec *mldev_utils_vec_get(void);
+#else
+static inline const struct mldev_utils_vec *
+mldev_utils_vec_get(void)
+{
+	return NULL;
+}
+#endif
@@ -99,15 +99,18 @@ rte_ml_io_float32_to_bfloat16(const void *input, void *output, uint64_t nb_eleme
 {
 	const float *input_buffer;
 	uint16_t *output_buffer;
+	const struct mldev_utils_vec *vec;
 	uint64_t i;
 
 	if ((nb_elements == 0) || (input == NULL) || (output == NULL))
 		return -EINVAL;
 
-	input_buffer = (const float *)input;
-	output_buffer = (uint16_t *)output;
+	vec = mldev_utils_vec_get();
+	i = vec != NULL ? vec->float32_to_bfloat16(input, output, nb_elements) : 0;
+	input_buffer = (const float *)input + i;
+	output_buffer = (uint16_t *)output + i;
 
-	for (i = 0; i < nb_elements; i++) {
+	for (; i < nb_elements; i++) {
 		*output_buffer = __float32_to_bfloat16_scalar_rtn(*input_buffer);
 
 		input_buffer = input_buffer + 1;
@@ -182,15 +185,18 @@ rte_ml_io_bfloat16_to_float32(const void *input, void *output, uint64_t nb_eleme
 {
 	const uint16_t *input_buffer;
 	float *output_buffer;
+	const struct mldev_utils_vec *vec;
 	uint64_t i;
 
 	if ((nb_elements == 0) || (input == NULL) || (output == NULL))
 		return -EINVAL;
 
-	input_buffer = (const uint16_t *)input;
-	output_buffer = (float *)output;
+	vec = mldev_utils_vec_get();
+	i = vec != NULL ? vec->bfloat16_to_float32(input, output, nb_elements) : 0;
+	input_buffer = (const uint16_t *)input + i;
+	output_buffer = (float *)output + i;
 
-	for (i = 0; i < nb_elements; i++) {
+	for (; i < nb_elements; i++) {
 		*output_buffer = __bfloat16_to_float32_scalar_rtx(*input_buffer);
 
 		input_buffer = input_buffer + 1;
@@ -0,0 +1,483 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#include <stdlib.h>
+
+#include <eal_export.h>
+#include <rte_acl.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_ip.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_rcu_qsbr.h>
+#include <rte_stdatomic.h>
+
+#include "rte_node_acl_api.h"
+
+#include "acl_priv.h"
+#include "node_private.h"
+
+/* 5-tuple of an IPv4 packet, in network order, as read by rte_acl_classify() */
+struct acl_ip4_tuple {
+	uint8_t proto;
+	uint8_t rsvd[3];
+	rte_be32_t src_addr;
+	rte_be32_t dst_addr;
+	rte_be16_t src_port;
+	rte_be16_t dst_port;
+};
+
+/* 5-tuple of an IPv6 packet, in network order, as read by rte_acl_classify() */
+struct acl_ip6_tuple {
+	uint8_t proto;
+	uint8_t rsvd[3];
+	struct rte_ipv6_addr src_addr;
+	struct rte_ipv6_addr dst_addr;
+	rte_be16_t src_port;
+	rte_be16_t dst_port;
+};
+
+/* Rules of an ACL node, replaced as a whole on update */
+struct acl_rules {
+	struct rte_acl_ctx *ctx;
+	/* ACL context, NULL without rules */
+	rte_edge_t default_next;
+	/* Next edge of the packets matching no rule */
+	rte_edge_t next[];
+	/* Next edge of each rule */
+};
+
+/* ACL node global data struct */
+struct acl_node_main {
+	RTE_ATOMIC(struct acl_rules *) rules;
+	/* Rules used by the graph workers */
+	uint32_t gen;
+	/* Generation of the ACL context names */
+};
+
+static struct acl_node_main ip4_acl_main;
+static struct acl_node_main ip6_acl_main;
+
+#define ACL_NODE_LAST_NEXT(ctx) \
+	(((struct acl_node_ctx *)ctx)->next_index)
+
+#define ACL_FIELD_DEF(_type, _tuple, _member, _off, _size, _field, _input) \
+	[_field] = { \
+		.type = RTE_ACL_FIELD_TYPE_##_type, \
+		.size = (_size), \
+		.field_index = (_field), \
+		.input_index = (_input), \
+		.offset = offsetof(struct _tuple, _member) + (_off), \
+	}
+
+static const struct rte_acl_field_def ip4_acl_field_defs[RTE_NODE_ACL_IP4_FIELD_NUM] = {
+	ACL_FIELD_DEF(BITMASK, acl_ip4_tuple, proto, 0, sizeof(uint8_t),
+		      RTE_NODE_ACL_IP4_FIELD_PROTO, 0),
+	ACL_FIELD_DEF(MASK, acl_ip4_tuple, src_addr, 0, sizeof(uint32_t),
+		      RTE_NODE_ACL_IP4_FIELD_SRC, 1),
+	ACL_FIELD_DEF(MASK, acl_ip4_tuple, dst_addr, 0, sizeof(uint32_t),
+		      RTE_NODE_ACL_IP4_FIELD_DST, 2),
+	ACL_FIELD_DEF(RANGE, acl_ip4_tuple, src_port, 0, sizeof(uint16_t),
+		      RTE_NODE_ACL_IP4_FIELD_SRC_PORT, 3),
+	ACL_FIELD_DEF(RANGE, acl_ip4_tuple, dst_port, 0, sizeof(uint16_t),
+		      RTE_NODE_ACL_IP4_FIELD_DST_PORT, 3),
+};
+
+static const struct rte_acl_field_def ip6_acl_field_defs[RTE_NODE_ACL_IP6_FIELD_NUM] = {
+	ACL_FIELD_DEF(BITMASK, acl_ip6_tuple, proto, 0, sizeof(uint8_t),
+		      RTE_NODE_ACL_IP6_FIELD_PROTO, 0),
+	ACL_FIELD_DEF(MASK, acl_ip6_tuple, src_addr, 0, sizeof(uint32_t),
+		      RTE_NODE_ACL_IP6_FIELD_SRC0, 1),
+	ACL_FIELD_DEF(MASK, acl_ip6_tuple, src_addr, 4, sizeof(uint32_t),
+		      RTE_NODE_ACL_IP6_FIELD_SRC1, 2),
+	ACL_FIELD_DEF(MASK, acl_ip6_tuple, src_addr, 8, sizeof(uint32_t),
+		      RTE_NODE_ACL_IP6_FIELD_SRC2, 3),
+	ACL_FIELD_DEF(MASK, acl_ip6_tuple, src_addr, 12, sizeof(uint32_t),
+		      RTE_NODE_ACL_IP6_FIELD_SRC3, 4),
+	ACL_FIELD_DEF(MASK, acl_ip6_tuple, dst_addr, 0, sizeof(uint32_t),
+		      RTE_NODE_ACL_IP6_FIELD_DST0, 5),
+	ACL_FIELD_DEF(MASK, acl_ip6_tuple, dst_addr, 4, sizeof(uint32_t),
+		      RTE_NODE_ACL_IP6_FIELD_DST1, 6),
+	ACL_FIELD_DEF(MASK, acl_ip6_tuple, dst_addr, 8, sizeof(uint32_t),
+		      RTE_NODE_ACL_IP6_FIELD_DST2, 7),
+	ACL_FIELD_DEF(MASK, acl_ip6_tuple, dst_addr, 12, sizeof(uint32_t),
+		      RTE_NODE_ACL_IP6_FIELD_DST3, 8),
+	ACL_FIELD_DEF(RANGE, acl_ip6_tuple, src_port, 0, sizeof(uint16_t),
+		      RTE_NODE_ACL_IP6_FIELD_SRC_PORT, 9),
+	ACL_FIELD_DEF(RANGE, acl_ip6_tuple, dst_port, 0, sizeof(uint16_t),
+		      RTE_NODE_ACL_IP6_FIELD_DST_PORT, 9),
+};
+
+static __rte_always_inline bool
+acl_proto_has_ports(uint8_t proto)
+{
+	return proto == IPPROTO_TCP || proto == IPPROTO_UDP || proto == IPPROTO_SCTP;
+}
+
+static __rte_always_inline void
+acl_ip4_tuple_get(struct rte_mbuf *mbuf, struct acl_ip4_tuple *t)
+{
+	const struct rte_ipv4_hdr *ip;
+	const rte_be16_t *ports;
+
+	ip = rte_pktmbuf_mtod_offset(mbuf, const struct rte_ipv4_hdr *,
+				     sizeof(struct rte_ether_hdr));
+	t->proto = ip->next_proto_id;
+	t->src_addr = ip->src_addr;
+	t->dst_addr = ip->dst_addr;
+	t->src_port = 0;
+	t->dst_port = 0;
+
+	/* Only the first fragment has the ports */
+	if (acl_proto_has_ports(t->proto) &&
+	    (ip->fragment_offset & rte_cpu_to_be_16(RTE_IPV4_HDR_OFFSET_MASK)) == 0) {
+		ports = RTE_PTR_ADD(ip, rte_ipv4_hdr_len(ip));
+		t->src_port = ports[0];
+		t->dst_port = ports[1];
+	}
+}
+
+static __rte_always_inline void
+acl_ip6_tuple_get(struct rte_mbuf *mbuf, struct acl_ip6_tuple *t)
+{
+	const struct rte_ipv6_hdr *ip;
+	const rte_be16_t *ports;
+
+	ip = rte_pktmbuf_mtod_offset(mbuf, const struct rte_ipv6_hdr *,
+				     sizeof(struct rte_ether_hdr));
+	t->proto = ip->proto;
+	t->src_addr = ip->src_addr;
+	t->dst_addr = ip->dst_addr;
+	t->src_port = 0;
+	t->dst_port = 0;
+
+	/* Extension headers are not skipped */
+	if (acl_proto_has_ports(t->proto)) {
+		ports = RTE_PTR_ADD(ip, sizeof(struct rte_ipv6_hdr));
+		t->src_port = ports[0];
+		t->dst_port = ports[1];
+	}
+}
+
+static __rte_always_inline uint16_t
+acl_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+		 uint16_t nb_objs, struct acl_node_main *nm, const bool ip6)
+{
+	union {
+		struct acl_ip4_tuple ip4[RTE_GRAPH_BURST_SIZE];
+		struct acl_ip6_tuple ip6[RTE_GRAPH_BURST_SIZE];
+	} tuples;
+	const uint8_t *data[RTE_GRAPH_BURST_SIZE];
+	uint32_t res[RTE_GRAPH_BURST_SIZE];
+	uint16_t held = 0, last_spec = 0;
+	const struct acl_rules *rules;
+	uint16_t next_index, next;
+	void **to_next, **from;
+	uint16_t i, n, off;
+
+	rules = rte_atomic_load_explicit(&nm->rules, rte_memory_order_acquire);
+	if (unlikely(rules == NULL)) {
+		rte_node_next_stream_move(graph, node, RTE_NODE_ACL_NEXT_PKT_DROP);
+		return nb_objs;
+	}
+	if (unlikely(rules->ctx == NULL)) {
+		rte_node_next_stream_move(graph, node, rules->default_next);
+		return nb_objs;
+	}
+
+	/* Speculative next as last next */
+	next_index = ACL_NODE_LAST_NEXT(node->ctx);
+	next = next_index;
+	from = objs;
+	to_next = rte_node_next_stream_get(graph, node, next_index, nb_objs);
+
+	for (off = 0; off < nb_objs; off += n) {
+		n = RTE_MIN(nb_objs - off, RTE_GRAPH_BURST_SIZE);
+
+		/* Extract the tuples of the burst, then classify them at once */
+		for (i = 0; i < n; i++) {
+			if (likely(i + 4 < n))
+				rte_prefetch0(rte_pktmbuf_mtod_offset((struct rte_mbuf *)objs[off + i + 4],
+						void *, sizeof(struct rte_ether_hdr)));
+			if (ip6) {
+				acl_ip6_tuple_get(objs[off + i], &tuples.ip6[i]);
+				data[i] = (const uint8_t *)&tuples.ip6[i];
+			} else {
+				acl_ip4_tuple_get(objs[off + i], &tuples.ip4[i]);
+				data[i] = (const uint8_t *)&tuples.ip4[i];
+			}
+		}
+
+		rte_acl_classify(rules->ctx, data, res, n, 1);
+
+		for (i = 0; i < n; i++) {
+			/* Result is the index of the matched rule plus one */
+			next = res[i] != 0 ? rules->next[res[i] - 1] : rules->default_next;
+			NODE_INCREMENT_XSTAT_ID(node, res[i], res[i] <= RTE_NODE_ACL_RULES_XSTATS_MAX,
+						1);
+
+			if (unlikely(next_index ^ next)) {
+				/* Copy things successfully speculated till now */
+				rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+				from += last_spec;
+				to_next += last_spec;
+				held += last_spec;
+				last_spec = 0;
+
+				rte_node_enqueue_x1(graph, node, next, from[0]);
+				from += 1;
+			} else {
+				last_spec += 1;
+			}
+		}
+	}
+
+	/* !!! Home run !!! */
+	if (likely(last_spec == nb_objs)) {
+		rte_node_next_stream_move(graph, node, next_index);
+		return nb_objs;
+	}
+
+	held += last_spec;
+	rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+	rte_node_next_stream_put(graph, node, next_index, held);
+	/* Speculate the next of the last packet for the next stream */
+	ACL_NODE_LAST_NEXT(node->ctx) = next;
+
+	return nb_objs;
+}
+
+static uint16_t
+ip4_acl_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+		     uint16_t nb_objs)
+{
+	return acl_node_process(graph, node, objs, nb_objs, &ip4_acl_main, false);
+}
+
+static uint16_t
+ip6_acl_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+		     uint16_t nb_objs)
+{
+	return acl_node_process(graph, node, objs, nb_objs, &ip6_acl_main, true);
+}
+
+static void
+acl_rules_free(struct acl_rules *rules)
+{
+	if (rules == NULL)
+		return;
+
+	rte_acl_free(rules->ctx);
+	rte_free(rules);
+}
+
+static struct acl_rules *
+acl_rules_create(const char *name, const struct rte_node_acl_conf *conf, rte_node_t node_id,
+		 const void *rules, uint32_t nb_rules, uint32_t rule_size,
+		 const struct rte_acl_field_def *defs, uint32_t nb_fields)
+{
+	rte_edge_t nb_edges = rte_node_edge_count(node_id);
+	struct rte_acl_config cfg = {0};
+	struct rte_acl_param prm = {0};
+	struct rte_acl_rule *rule;
+	struct acl_rules *new;
+	uint8_t *tmp = NULL;
+	uint32_t i;
+	int rc;
+
+	new = rte_zmalloc_socket(name, sizeof(*new) + nb_rules * sizeof(new->next[0]),
+				 RTE_CACHE_LINE_SIZE, conf->socket_id);
+	if (new == NULL) {
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+	new->default_next = conf->default_next;
+	if (nb_rules == 0)
+		return new;
+
+	tmp = malloc((size_t)nb_rules * rule_size);
+	if (tmp == NULL) {
+		rc = -ENOMEM;
+		goto fail;
+	}
+	memcpy(tmp, rules, (size_t)nb_rules * rule_size);
+
+	/* Rule userdata is its next edge, replace it by its index plus one */
+	for (i = 0; i < nb_rules; i++) {
+		rule = (struct rte_acl_rule *)(tmp + (size_t)i * rule_size);
+		if (rule->data.userdata >= nb_edges) {
+			node_err("acl", "Invalid next edge %u of rule %u",
+				 rule->data.userdata, i);
+			rc = -EINVAL;
+			goto fail;
+		}
+		new->next[i] = rule->data.userdata;
+		rule->data.userdata = i + 1;
+		rule->data.category_mask = 1;
+	}
+
+	prm.name = name;
+	prm.socket_id = conf->socket_id;
+	prm.rule_size = rule_size;
+	prm.max_rule_num = nb_rules;
+	new->ctx = rte_acl_create(&prm);
+	if (new->ctx == NULL) {
+		rc = -rte_errno;
+		goto fail;
+	}
+
+	rc = rte_acl_add_rules(new->ctx, (struct rte_acl_rule *)tmp, nb_rules);
+	if (rc < 0)
+		goto fail;
+
+	cfg.num_categories = 1;
+	cfg.num_fields = nb_fields;
+	memcpy(cfg.defs, defs, nb_fields * sizeof(defs[0]));
+	rc = rte_acl_build(new->ctx, &cfg);
+	if (rc < 0) {
+		node_err("acl", "Failed to build ACL context %s", name);
+		goto fail;
+	}
+
+	/* Classify with the best algorithm allowed on this CPU */
+	rte_acl_set_ctx_classify(new->ctx, RTE_ACL_CLASSIFY_DEFAULT);
+
+	free(tmp);
+	return new;
+
+fail:
+	free(tmp);
+	acl_rules_free(new);
+	rte_errno = -rc;
+	return NULL;
+}
+
+static int
+acl_rules_set(struct acl_node_main *nm, const char *node_name,
+	      const struct rte_node_acl_conf *conf, const void *rules, uint32_t nb_rules,
+	      uint32_t rule_size, const struct rte_acl_field_def *defs, uint32_t nb_fields)
+{
+	rte_node_t node_id = rte_node_from_name(node_name);
+	char name[RTE_ACL_NAMESIZE];
+	struct acl_rules *new, *old;
+
+	if (conf == NULL || (rules == NULL && nb_rules != 0))
+		return -EINVAL;
+
+	if (node_id == RTE_NODE_ID_INVALID || conf->default_next >= rte_node_edge_count(node_id))
+		return -EINVAL;
+
+	/* Without QSBR, the rules in use cannot be freed safely */
+	if (conf->qsbr == NULL &&
+	    rte_atomic_load_explicit(&nm->rules, rte_memory_order_relaxed) != NULL)
+		return -EINVAL;
+
+	/* ACL context names are unique, the previous one is still in use */
+	snprintf(name, sizeof(name), "%s_%u", node_name, nm->gen++);
+	new = acl_rules_create(name, conf, node_id, rules, nb_rules, rule_size, defs, nb_fields);
+	if (new == NULL)
+		return -rte_errno;
+
+	old = rte_atomic_exchange_explicit(&nm->rules, new, rte_memory_order_release);
+	if (old == NULL)
+		return 0;
+
+	/* Wait for the graph workers to be done with the previous rules */
+	rte_rcu_qsbr_synchronize(conf->qsbr, RTE_QSBR_THRID_INVALID);
+	acl_rules_free(old);
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ip4_acl_rules_set, 25.11)
+int
+rte_node_ip4_acl_rules_set(const struct rte_node_acl_conf *conf,
+			   const struct rte_node_acl_ip4_rule *rules, uint32_t nb_rules)
+{
+	return acl_rules_set(&ip4_acl_main, "ip4_acl", conf, rules, nb_rules,
+			     sizeof(struct rte_node_acl_ip4_rule), ip4_acl_field_defs,
+			     RTE_DIM(ip4_acl_field_defs));
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ip6_acl_rules_set, 25.11)
+int
+rte_node_ip6_acl_rules_set(const struct rte_node_acl_conf *conf,
+			   const struct rte_node_acl_ip6_rule *rules, uint32_t nb_rules)
+{
+	return acl_rules_set(&ip6_acl_main, "ip6_acl", conf, rules, nb_rules,
+			     sizeof(struct rte_node_acl_ip6_rule), ip6_acl_field_defs,
+			     RTE_DIM(ip6_acl_field_defs));
+}
+
+static int
+acl_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	RTE_SET_USED(graph);
+	RTE_BUILD_BUG_ON(sizeof(struct acl_node_ctx) > RTE_NODE_CTX_SZ);
+
+	/* By default, set cached next node to pkt_drop */
+	ACL_NODE_LAST_NEXT(node->ctx) = RTE_NODE_ACL_NEXT_PKT_DROP;
+
+	return 0;
+}
+
+#define ACL_RULE_XSTAT(n) [(n) + 1] = "rule" RTE_STR(n) "_hits"
+
+static struct rte_node_xstats acl_xstats = {
+	.nb_xstats = RTE_NODE_ACL_RULES_XSTATS_MAX + 1,
+	.xstat_desc = {
+		[0] = "no_match",
+		ACL_RULE_XSTAT(0), ACL_RULE_XSTAT(1), ACL_RULE_XSTAT(2), ACL_RULE_XSTAT(3),
+		ACL_RULE_XSTAT(4), ACL_RULE_XSTAT(5), ACL_RULE_XSTAT(6), ACL_RULE_XSTAT(7),
+		ACL_RULE_XSTAT(8), ACL_RULE_XSTAT(9), ACL_RULE_XSTAT(10), ACL_RULE_XSTAT(11),
+		ACL_RULE_XSTAT(12), ACL_RULE_XSTAT(13), ACL_RULE_XSTAT(14), ACL_RULE_XSTAT(15),
+		ACL_RULE_XSTAT(16), ACL_RULE_XSTAT(17), ACL_RULE_XSTAT(18), ACL_RULE_XSTAT(19),
+		ACL_RULE_XSTAT(20), ACL_RULE_XSTAT(21), ACL_RULE_XSTAT(22), ACL_RULE_XSTAT(23),
+		ACL_RULE_XSTAT(24), ACL_RULE_XSTAT(25), ACL_RULE_XSTAT(26), ACL_RULE_XSTAT(27),
+		ACL_RULE_XSTAT(28), ACL_RULE_XSTAT(29), ACL_RULE_XSTAT(30), ACL_RULE_XSTAT(31),
+	},
+};
+
+static struct rte_node_register ip4_acl_node = {
+	.process = ip4_acl_node_process,
+	.name = "ip4_acl",
+
+	.init = acl_node_init,
+	.xstats = &acl_xstats,
+
+	.nb_edges = RTE_NODE_ACL_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_ACL_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+static struct rte_node_register ip6_acl_node = {
+	.process = ip6_acl_node_process,
+	.name = "ip6_acl",
+
+	.init = acl_node_init,
+	.xstats = &acl_xstats,
+
+	.nb_edges = RTE_NODE_ACL_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_ACL_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+struct rte_node_register *
+ip4_acl_node_get(void)
+{
+	return &ip4_acl_node;
+}
+
+struct rte_node_register *
+ip6_acl_node_get(void)
+{
+	return &ip6_acl_node;
+}
+
+RTE_NODE_REGISTER(ip4_acl_node);
+RTE_NODE_REGISTER(ip6_acl_node);
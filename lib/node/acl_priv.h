@@ -0,0 +1,40 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#ifndef __INCLUDE_ACL_PRIV_H__
+#define __INCLUDE_ACL_PRIV_H__
+
+#include <rte_common.h>
+
+/**
+ * @internal
+ *
+ * ACL node context structure.
+ */
+struct acl_node_ctx {
+	uint16_t next_index;
+	/**< Cached next index. */
+};
+
+/**
+ * @internal
+ *
+ * Get the IPv4 ACL node.
+ *
+ * @return
+ *   Pointer to the IPv4 ACL node.
+ */
+struct rte_node_register *ip4_acl_node_get(void);
+
+/**
+ * @internal
+ *
+ * Get the IPv6 ACL node.
+ *
+ * @return
+ *   Pointer to the IPv6 ACL node.
+ */
+struct rte_node_register *ip6_acl_node_get(void);
+
+#endif /* __INCLUDE_ACL_PRIV_H__ */
@@ -0,0 +1,593 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#include <eal_export.h>
+#include <rte_cryptodev.h>
+#include <rte_cycles.h>
+#include <rte_debug.h>
+#include <rte_esp.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_ip.h>
+#include <rte_ipsec.h>
+#include <rte_ipsec_group.h>
+#include <rte_ipsec_sad.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+
+#include "rte_node_ipsec_api.h"
+
+#include "node_private.h"
+
+/* Number of packets looked up and prepared at once */
+#define ESP_BURST_SIZE 64
+
+#define ESP_XSTAT_NO_SA 0
+#define ESP_XSTAT_ERROR 1
+
+/* Polls of the cryptodev for the in-flight operations of a destroyed graph */
+#define ESP_DRAIN_RETRIES 1000
+#define ESP_DRAIN_DELAY_US 10
+
+/* Cryptodev queue pair of a graph, only used by the lcore walking the graph */
+struct esp_qp {
+	alignas(RTE_CACHE_LINE_SIZE) uint64_t nb_enq;
+	/**< Crypto operations enqueued by the ESP nodes of the graph. */
+	uint64_t nb_deq;
+	/**< Crypto operations dequeued by the ESP nodes of the graph. */
+	rte_graph_t graph_id;
+	/**< Graph using the queue pair. */
+	uint16_t id;
+	/**< Queue pair identifier. */
+	uint16_t refcnt;
+	/**< ESP nodes of the graph using the queue pair, 0 if the queue pair is free. */
+};
+
+/* ESP global data struct */
+struct esp_node_main {
+	struct rte_node_ipsec_cfg cfg;
+	struct esp_qp *qps;
+	/**< Queue pairs of the cryptodev, NULL without lookaside sessions. */
+	uint16_t nb_qps;
+	/**< Number of queue pairs of the cryptodev. */
+	rte_edge_t inbound_next;
+	/**< Edge of the inbound next node from esp_inbound. */
+	rte_edge_t outbound_next;
+	/**< Edge of the outbound next node from esp_outbound. */
+	rte_edge_t completion_inbound_next;
+	/**< Edge of the inbound next node from esp_completion. */
+	rte_edge_t completion_outbound_next;
+	/**< Edge of the outbound next node from esp_completion. */
+	bool configured;
+};
+
+struct esp_node_ctx {
+	struct esp_qp *qp;
+	/**< Cryptodev queue pair of the graph, NULL if the lookaside sessions
+	 * cannot be used by the graph.
+	 */
+	int mbuf_priv1_off;
+	/**< Dynamic offset to mbuf priv1. */
+};
+
+static struct esp_node_main esp_main;
+static struct rte_node_register esp_inbound_node;
+static struct rte_node_register esp_outbound_node;
+static struct rte_node_register esp_completion_node;
+
+/*
+ * Strip the Ethernet header and set the lengths used by the IPsec library,
+ * return the IP version of the packet, 0 if it is neither IPv4 nor IPv6.
+ */
+static __rte_always_inline uint8_t
+esp_pkt_l3_prepare(struct rte_mbuf *mbuf)
+{
+	uint8_t *l3 = rte_pktmbuf_mtod_offset(mbuf, uint8_t *, sizeof(struct rte_ether_hdr));
+	uint8_t version = *l3 >> 4;
+
+	if (version == 4)
+		mbuf->l3_len = rte_ipv4_hdr_len((struct rte_ipv4_hdr *)l3);
+	else if (version == 6)
+		mbuf->l3_len = sizeof(struct rte_ipv6_hdr);
+	else
+		return 0;
+
+	rte_pktmbuf_adj(mbuf, sizeof(struct rte_ether_hdr));
+	mbuf->l2_len = 0;
+
+	return version;
+}
+
+static __rte_always_inline void
+esp_pkts_drop(struct rte_graph *graph, struct rte_node *node, struct rte_mbuf **mb,
+	      uint16_t nb_pkts, uint16_t xstat)
+{
+	if (nb_pkts == 0)
+		return;
+
+	rte_node_enqueue(graph, node, RTE_NODE_ESP_NEXT_PKT_DROP, (void **)mb, nb_pkts);
+	NODE_INCREMENT_XSTAT_ID(node, xstat, true, nb_pkts);
+}
+
+/* Restore the room of the Ethernet header of the packets and send them */
+static __rte_always_inline void
+esp_pkts_send(struct rte_graph *graph, struct rte_node *node, rte_edge_t next,
+	      struct rte_mbuf **mb, uint16_t nb_pkts)
+{
+	uint16_t i, n = 0;
+
+	for (i = 0; i < nb_pkts; i++) {
+		if (unlikely(rte_pktmbuf_prepend(mb[i], sizeof(struct rte_ether_hdr)) == NULL)) {
+			esp_pkts_drop(graph, node, &mb[i], 1, ESP_XSTAT_ERROR);
+			continue;
+		}
+		mb[n++] = mb[i];
+	}
+
+	if (n != 0)
+		rte_node_enqueue(graph, node, next, (void **)mb, n);
+}
+
+/* Process the packets of an IPsec session */
+static __rte_always_inline void
+esp_session_process(struct rte_graph *graph, struct rte_node *node,
+		    const struct rte_ipsec_session *ss, struct rte_mbuf **mb, uint16_t nb_pkts,
+		    rte_edge_t next)
+{
+	struct esp_node_ctx *ctx = (struct esp_node_ctx *)node->ctx;
+	struct rte_crypto_op *cops[ESP_BURST_SIZE];
+	uint16_t k, n;
+
+	switch (ss->type) {
+	case RTE_SECURITY_ACTION_TYPE_NONE:
+	case RTE_SECURITY_ACTION_TYPE_LOOKASIDE_PROTOCOL:
+		/* Completed by the esp_completion node on a later walk */
+		if (unlikely(ctx->qp == NULL ||
+			     rte_crypto_op_bulk_alloc(esp_main.cfg.cop_pool,
+						      RTE_CRYPTO_OP_TYPE_SYMMETRIC,
+						      cops, nb_pkts) == 0)) {
+			esp_pkts_drop(graph, node, mb, nb_pkts, ESP_XSTAT_ERROR);
+			return;
+		}
+
+		/* Packets failing the preparation are moved after the prepared ones */
+		k = rte_ipsec_pkt_crypto_prepare(ss, mb, cops, nb_pkts);
+		n = rte_cryptodev_enqueue_burst(esp_main.cfg.dev_id, ctx->qp->id, cops, k);
+		ctx->qp->nb_enq += n;
+		if (unlikely(n != nb_pkts)) {
+			rte_mempool_put_bulk(esp_main.cfg.cop_pool, (void **)&cops[n], nb_pkts - n);
+			esp_pkts_drop(graph, node, &mb[n], nb_pkts - n, ESP_XSTAT_ERROR);
+		}
+		return;
+	case RTE_SECURITY_ACTION_TYPE_CPU_CRYPTO:
+		k = rte_ipsec_pkt_cpu_prepare(ss, mb, nb_pkts);
+		break;
+	default:
+		/* Inline sessions, the device does the crypto */
+		k = nb_pkts;
+		break;
+	}
+
+	k = rte_ipsec_pkt_process(ss, mb, k);
+	esp_pkts_drop(graph, node, &mb[k], nb_pkts - k, ESP_XSTAT_ERROR);
+	esp_pkts_send(graph, node, next, mb, k);
+}
+
+/* Process the packets in runs of the same IPsec session, dropping the ones without */
+static __rte_always_inline void
+esp_sessions_process(struct rte_graph *graph, struct rte_node *node,
+		     struct rte_ipsec_session **ss, struct rte_mbuf **mb, uint16_t nb_pkts,
+		     rte_edge_t next)
+{
+	uint16_t i, from = 0;
+
+	for (i = 1; i <= nb_pkts; i++) {
+		if (i != nb_pkts && ss[i] == ss[from])
+			continue;
+
+		if (unlikely(ss[from] == NULL))
+			esp_pkts_drop(graph, node, &mb[from], i - from, ESP_XSTAT_NO_SA);
+		else
+			esp_session_process(graph, node, ss[from], &mb[from], i - from, next);
+		from = i;
+	}
+}
+
+static __rte_always_inline void
+esp_sad_lookup(const struct rte_ipsec_sad *sad, const union rte_ipsec_sad_key **keys,
+	       struct rte_ipsec_session **ss, uint16_t n)
+{
+	if (sad == NULL || rte_ipsec_sad_lookup(sad, keys, (void **)ss, n) < 0)
+		memset(ss, 0, n * sizeof(ss[0]));
+}
+
+static uint16_t
+esp_inbound_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+			 uint16_t nb_objs)
+{
+	const union rte_ipsec_sad_key *keys4[ESP_BURST_SIZE];
+	const union rte_ipsec_sad_key *keys6[ESP_BURST_SIZE];
+	union rte_ipsec_sad_key keys[ESP_BURST_SIZE];
+	struct rte_ipsec_session *ss[ESP_BURST_SIZE];
+	struct rte_mbuf *mb4[ESP_BURST_SIZE];
+	struct rte_mbuf *mb6[ESP_BURST_SIZE];
+	struct rte_mbuf *mb[ESP_BURST_SIZE];
+	uint16_t i, j, n, n4, n6, nb_drop;
+	struct rte_ipv6_hdr *ip6;
+	struct rte_ipv4_hdr *ip4;
+	struct rte_esp_hdr *esp;
+	struct rte_mbuf *mbuf;
+	uint8_t version;
+
+	for (i = 0; i < nb_objs; i += n) {
+		n = RTE_MIN(nb_objs - i, ESP_BURST_SIZE);
+		n4 = 0;
+		n6 = 0;
+		nb_drop = 0;
+
+		/* Build the SAD keys of each IP version */
+		for (j = 0; j < n; j++) {
+			mbuf = (struct rte_mbuf *)objs[i + j];
+			if (likely(j + 1 < n))
+				rte_prefetch0(rte_pktmbuf_mtod((struct rte_mbuf *)objs[i + j + 1],
+							       void *));
+
+			version = esp_pkt_l3_prepare(mbuf);
+			if (version == 4) {
+				ip4 = rte_pktmbuf_mtod(mbuf, struct rte_ipv4_hdr *);
+				if (unlikely(ip4->next_proto_id != IPPROTO_ESP)) {
+					mb[nb_drop++] = mbuf;
+					continue;
+				}
+				esp = RTE_PTR_ADD(ip4, mbuf->l3_len);
+				keys[j].v4.spi = esp->spi;
+				keys[j].v4.dip = ip4->dst_addr;
+				keys[j].v4.sip = ip4->src_addr;
+				keys4[n4] = &keys[j];
+				mb4[n4++] = mbuf;
+			} else if (version == 6) {
+				ip6 = rte_pktmbuf_mtod(mbuf, struct rte_ipv6_hdr *);
+				if (unlikely(ip6->proto != IPPROTO_ESP)) {
+					mb[nb_drop++] = mbuf;
+					continue;
+				}
+				esp = RTE_PTR_ADD(ip6, mbuf->l3_len);
+				keys[j].v6.spi = esp->spi;
+				keys[j].v6.dip = ip6->dst_addr;
+				keys[j].v6.sip = ip6->src_addr;
+				keys6[n6] = &keys[j];
+				mb6[n6++] = mbuf;
+			} else {
+				mb[nb_drop++] = mbuf;
+			}
+		}
+		esp_pkts_drop(graph, node, mb, nb_drop, ESP_XSTAT_NO_SA);
+
+		if (n4 != 0) {
+			esp_sad_lookup(esp_main.cfg.sad_ip4, keys4, ss, n4);
+			esp_sessions_process(graph, node, ss, mb4, n4, esp_main.inbound_next);
+		}
+
+		if (n6 != 0) {
+			esp_sad_lookup(esp_main.cfg.sad_ip6, keys6, ss, n6);
+			esp_sessions_process(graph, node, ss, mb6, n6, esp_main.inbound_next);
+		}
+	}
+
+	return nb_objs;
+}
+
+static uint16_t
+esp_outbound_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+			  uint16_t nb_objs)
+{
+	struct esp_node_ctx *ctx = (struct esp_node_ctx *)node->ctx;
+	struct rte_ipsec_session *ss[ESP_BURST_SIZE];
+	const int dyn = ctx->mbuf_priv1_off;
+	struct rte_mbuf *mbuf;
+	uint16_t i, j, n;
+
+	for (i = 0; i < nb_objs; i += n) {
+		n = RTE_MIN(nb_objs - i, ESP_BURST_SIZE);
+
+		for (j = 0; j < n; j++) {
+			mbuf = (struct rte_mbuf *)objs[i + j];
+			if (likely(j + 1 < n))
+				rte_prefetch0(rte_pktmbuf_mtod((struct rte_mbuf *)objs[i + j + 1],
+							       void *));
+
+			ss[j] = node_mbuf_priv1(mbuf, dyn)->ipsec_ss;
+			/* Packets which are not IP are dropped as without session */
+			if (unlikely(esp_pkt_l3_prepare(mbuf) == 0))
+				ss[j] = NULL;
+		}
+
+		esp_sessions_process(graph, node, ss, (struct rte_mbuf **)&objs[i], n,
+				     esp_main.outbound_next);
+	}
+
+	return nb_objs;
+}
+
+static uint16_t
+esp_completion_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+			    uint16_t nb_objs)
+{
+	struct esp_node_ctx *ctx = (struct esp_node_ctx *)node->ctx;
+	struct rte_crypto_op *cops[RTE_GRAPH_BURST_SIZE];
+	struct rte_ipsec_group grp[RTE_GRAPH_BURST_SIZE];
+	struct rte_mbuf *mb[RTE_GRAPH_BURST_SIZE];
+	const struct rte_ipsec_session *ss;
+	uint16_t i, k, n, nb_grp, nb_done = 0;
+	rte_edge_t next;
+
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	if (ctx->qp == NULL)
+		return 0;
+
+	n = rte_cryptodev_dequeue_burst(esp_main.cfg.dev_id, ctx->qp->id, cops,
+					RTE_GRAPH_BURST_SIZE);
+	if (n == 0)
+		return 0;
+	ctx->qp->nb_deq += n;
+
+	nb_grp = rte_ipsec_pkt_crypto_group((const struct rte_crypto_op **)(uintptr_t)cops,
+					    mb, grp, n);
+	if (unlikely(nb_grp == 0)) {
+		for (i = 0; i < n; i++)
+			mb[i] = cops[i]->sym->m_src;
+	}
+	rte_mempool_put_bulk(esp_main.cfg.cop_pool, (void **)cops, n);
+
+	for (i = 0; i < nb_grp; i++) {
+		ss = grp[i].id.ptr;
+		if ((rte_ipsec_sa_type(ss->sa) & RTE_IPSEC_SATP_DIR_MASK) == RTE_IPSEC_SATP_DIR_IB)
+			next = esp_main.completion_inbound_next;
+		else
+			next = esp_main.completion_outbound_next;
+
+		k = rte_ipsec_pkt_process(ss, grp[i].m, grp[i].cnt);
+		esp_pkts_drop(graph, node, &grp[i].m[k], grp[i].cnt - k, ESP_XSTAT_ERROR);
+		esp_pkts_send(graph, node, next, grp[i].m, k);
+		nb_done += grp[i].cnt;
+	}
+
+	/* Packets without session */
+	esp_pkts_drop(graph, node, &mb[nb_done], n - nb_done, ESP_XSTAT_NO_SA);
+
+	return n;
+}
+
+/* Get the queue pair of a graph, shared by its ESP nodes */
+static struct esp_qp *
+esp_qp_get(rte_graph_t graph_id)
+{
+	struct esp_qp *qp, *free_qp = NULL;
+	uint16_t i;
+
+	for (i = 0; i < esp_main.nb_qps; i++) {
+		qp = &esp_main.qps[i];
+		if (qp->refcnt != 0 && qp->graph_id == graph_id) {
+			qp->refcnt++;
+			return qp;
+		}
+		if (qp->refcnt == 0 && free_qp == NULL)
+			free_qp = qp;
+	}
+
+	if (free_qp != NULL) {
+		free_qp->graph_id = graph_id;
+		free_qp->refcnt = 1;
+		free_qp->nb_enq = 0;
+		free_qp->nb_deq = 0;
+	}
+
+	return free_qp;
+}
+
+/* Free the packets of the crypto operations still in the queue pair */
+static void
+esp_qp_drain(struct esp_qp *qp)
+{
+	struct rte_crypto_op *cops[RTE_GRAPH_BURST_SIZE];
+	unsigned int retries = 0;
+	uint16_t i, n;
+
+	while (qp->nb_enq != qp->nb_deq && retries < ESP_DRAIN_RETRIES) {
+		n = rte_cryptodev_dequeue_burst(esp_main.cfg.dev_id, qp->id, cops, RTE_DIM(cops));
+		if (n == 0) {
+			rte_delay_us(ESP_DRAIN_DELAY_US);
+			retries++;
+			continue;
+		}
+
+		for (i = 0; i < n; i++)
+			rte_pktmbuf_free(cops[i]->sym->m_src);
+		rte_mempool_put_bulk(esp_main.cfg.cop_pool, (void **)cops, n);
+		qp->nb_deq += n;
+	}
+
+	if (qp->nb_enq != qp->nb_deq)
+		node_err("esp", "%" PRIu64 " crypto operations lost on queue pair %u",
+			 qp->nb_enq - qp->nb_deq, qp->id);
+}
+
+static int
+esp_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	struct esp_node_ctx *ctx = (struct esp_node_ctx *)node->ctx;
+	int dyn;
+
+	RTE_BUILD_BUG_ON(sizeof(struct esp_node_ctx) > RTE_NODE_CTX_SZ);
+
+	dyn = rte_node_mbuf_dynfield_register();
+	if (dyn < 0) {
+		node_err("esp", "Failed to register mbuf dynfield");
+		return -rte_errno;
+	}
+	ctx->mbuf_priv1_off = dyn;
+
+	ctx->qp = NULL;
+	if (!esp_main.configured || esp_main.qps == NULL)
+		return 0;
+
+	/* The ESP nodes of a graph may run on several lcores with mcore-dispatch */
+	if (graph->model == RTE_GRAPH_MODEL_MCORE_DISPATCH) {
+		node_err("esp", "Lookaside sessions not supported by mcore-dispatch graph %s",
+			 graph->name);
+		return -ENOTSUP;
+	}
+
+	ctx->qp = esp_qp_get(graph->id);
+	if (ctx->qp == NULL) {
+		node_err("esp", "No free queue pair on cryptodev %u for graph %s",
+			 esp_main.cfg.dev_id, graph->name);
+		return -ENOSPC;
+	}
+
+	return 0;
+}
+
+static void
+esp_node_fini(const struct rte_graph *graph, struct rte_node *node)
+{
+	struct esp_node_ctx *ctx = (struct esp_node_ctx *)node->ctx;
+
+	RTE_SET_USED(graph);
+
+	if (ctx->qp == NULL)
+		return;
+
+	/* The last ESP node of the graph releases the queue pair */
+	if (--ctx->qp->refcnt == 0)
+		esp_qp_drain(ctx->qp);
+	ctx->qp = NULL;
+}
+
+static struct rte_node_xstats esp_xstats = {
+	.nb_xstats = 2,
+	.xstat_desc = {
+		[ESP_XSTAT_NO_SA] = "esp_no_sa",
+		[ESP_XSTAT_ERROR] = "esp_error",
+	},
+};
+
+static struct rte_node_register esp_inbound_node = {
+	.process = esp_inbound_node_process,
+	.name = "esp_inbound",
+
+	.init = esp_node_init,
+	.fini = esp_node_fini,
+	.xstats = &esp_xstats,
+
+	.nb_edges = RTE_NODE_ESP_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_ESP_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(esp_inbound_node);
+
+static struct rte_node_register esp_outbound_node = {
+	.process = esp_outbound_node_process,
+	.name = "esp_outbound",
+
+	.init = esp_node_init,
+	.fini = esp_node_fini,
+	.xstats = &esp_xstats,
+
+	.nb_edges = RTE_NODE_ESP_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_ESP_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(esp_outbound_node);
+
+static struct rte_node_register esp_completion_node = {
+	.process = esp_completion_node_process,
+	.flags = RTE_NODE_SOURCE_F,
+	.name = "esp_completion",
+
+	.init = esp_node_init,
+	.fini = esp_node_fini,
+	.xstats = &esp_xstats,
+
+	.nb_edges = RTE_NODE_ESP_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_ESP_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(esp_completion_node);
+
+static int
+esp_node_edge_add(rte_node_t id, const char *next_node, rte_edge_t *edge)
+{
+	const char *next_nodes[1] = { next_node };
+
+	if (rte_node_edge_update(id, RTE_EDGE_ID_INVALID, next_nodes, 1) == 0)
+		return -EINVAL;
+
+	/* Assuming edge id is the last one alloc'ed */
+	*edge = rte_node_edge_count(id) - 1;
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ipsec_configure, 25.11)
+int
+rte_node_ipsec_configure(const struct rte_node_ipsec_cfg *cfg)
+{
+	uint16_t i, nb_qps;
+	int rc;
+
+	if (cfg == NULL || cfg->inbound_next_node == NULL || cfg->outbound_next_node == NULL)
+		return -EINVAL;
+
+	if (cfg->cop_pool != NULL && !rte_cryptodev_is_valid_dev(cfg->dev_id))
+		return -EINVAL;
+
+	for (i = 0; i < esp_main.nb_qps; i++)
+		if (esp_main.qps[i].refcnt != 0)
+			return -EBUSY;
+
+	rc = esp_node_edge_add(esp_inbound_node.id, cfg->inbound_next_node,
+			       &esp_main.inbound_next);
+	if (rc == 0)
+		rc = esp_node_edge_add(esp_outbound_node.id, cfg->outbound_next_node,
+				       &esp_main.outbound_next);
+	if (rc == 0)
+		rc = esp_node_edge_add(esp_completion_node.id, cfg->inbound_next_node,
+				       &esp_main.completion_inbound_next);
+	if (rc == 0)
+		rc = esp_node_edge_add(esp_completion_node.id, cfg->outbound_next_node,
+				       &esp_main.completion_outbound_next);
+	if (rc < 0)
+		return rc;
+
+	rte_free(esp_main.qps);
+	esp_main.qps = NULL;
+	esp_main.nb_qps = 0;
+	if (cfg->cop_pool != NULL) {
+		nb_qps = rte_cryptodev_queue_pair_count(cfg->dev_id);
+		if (nb_qps == 0)
+			return -EINVAL;
+		esp_main.qps = rte_zmalloc("esp_qps", nb_qps * sizeof(esp_main.qps[0]),
+					   RTE_CACHE_LINE_SIZE);
+		if (esp_main.qps == NULL)
+			return -ENOMEM;
+		for (i = 0; i < nb_qps; i++)
+			esp_main.qps[i].id = i;
+		esp_main.nb_qps = nb_qps;
+	}
+
+	esp_main.cfg = *cfg;
+	esp_main.configured = true;
+
+	return 0;
+}
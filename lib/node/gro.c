@@ -0,0 +1,282 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#include <eal_export.h>
+#include <rte_cycles.h>
+#include <rte_debug.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_gro.h>
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
+
+#include "rte_node_gro_api.h"
+
+#include "node_private.h"
+
+/* GRO global data struct */
+struct gro_node_main {
+	struct rte_gro_param param;
+	uint64_t timeout_cycles;
+	rte_edge_t next;
+	/**< Edge of the next node, both nodes have the same edges. */
+	bool configured;
+};
+
+struct gro_node_ctx {
+	void *gro;
+	/**< GRO context of the graph, NULL if the node is not configured. */
+};
+
+struct gro_flush_node_ctx {
+	struct rte_node *gro_node;
+	/**< gro node of the graph. */
+};
+
+static struct gro_node_main gro_main;
+static struct rte_node_register gro_node;
+static struct rte_node_register gro_flush_node;
+
+/* Set the header lengths looked up by GRO from the packet type */
+static __rte_always_inline void
+gro_pkt_hdr_lens_set(struct rte_mbuf *mbuf)
+{
+	const uint32_t ptype = mbuf->packet_type;
+	uint16_t l2_len = sizeof(struct rte_ether_hdr);
+	struct rte_tcp_hdr *tcp;
+	void *l3;
+
+	if (ptype & RTE_PTYPE_TUNNEL_MASK)
+		return;
+
+	if ((ptype & RTE_PTYPE_L2_MASK) == RTE_PTYPE_L2_ETHER_VLAN)
+		l2_len += sizeof(struct rte_vlan_hdr);
+	else if ((ptype & RTE_PTYPE_L2_MASK) == RTE_PTYPE_L2_ETHER_QINQ)
+		l2_len += 2 * sizeof(struct rte_vlan_hdr);
+	mbuf->l2_len = l2_len;
+
+	l3 = rte_pktmbuf_mtod_offset(mbuf, void *, l2_len);
+	if (RTE_ETH_IS_IPV4_HDR(ptype))
+		mbuf->l3_len = rte_ipv4_hdr_len(l3);
+	else if (RTE_ETH_IS_IPV6_HDR(ptype))
+		mbuf->l3_len = sizeof(struct rte_ipv6_hdr);
+	else
+		return;
+
+	if ((ptype & RTE_PTYPE_L4_MASK) == RTE_PTYPE_L4_TCP) {
+		tcp = RTE_PTR_ADD(l3, mbuf->l3_len);
+		mbuf->l4_len = (tcp->data_off & 0xf0) >> 2;
+	} else if ((ptype & RTE_PTYPE_L4_MASK) == RTE_PTYPE_L4_UDP) {
+		mbuf->l4_len = sizeof(struct rte_udp_hdr);
+	}
+}
+
+static uint16_t
+gro_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+		 uint16_t nb_objs)
+{
+	struct gro_node_ctx *ctx = (struct gro_node_ctx *)node->ctx;
+	uint16_t i, n;
+
+	if (unlikely(ctx->gro == NULL)) {
+		rte_node_next_stream_move(graph, node, RTE_NODE_GRO_NEXT_PKT_DROP);
+		return nb_objs;
+	}
+
+	for (i = 0; i < nb_objs; i++) {
+		if (likely(i + 1 < nb_objs))
+			rte_prefetch0(rte_pktmbuf_mtod((struct rte_mbuf *)objs[i + 1], void *));
+		gro_pkt_hdr_lens_set((struct rte_mbuf *)objs[i]);
+	}
+
+	/* The packets not merged are left at the start of the stream */
+	n = rte_gro_reassemble((struct rte_mbuf **)objs, nb_objs, ctx->gro);
+	n += rte_gro_timeout_flush(ctx->gro, gro_main.timeout_cycles, gro_main.param.gro_types,
+				   (struct rte_mbuf **)&objs[n], node->size - n);
+	NODE_INCREMENT_XSTAT_ID(node, 0, n < nb_objs, nb_objs - n);
+
+	if (n != 0) {
+		node->idx = n;
+		rte_node_next_stream_move(graph, node, gro_main.next);
+	}
+
+	return nb_objs;
+}
+
+static int
+gro_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	struct gro_node_ctx *ctx = (struct gro_node_ctx *)node->ctx;
+	struct rte_gro_param param = gro_main.param;
+
+	RTE_BUILD_BUG_ON(sizeof(struct gro_node_ctx) > RTE_NODE_CTX_SZ);
+
+	ctx->gro = NULL;
+	if (!gro_main.configured)
+		return 0;
+
+	param.socket_id = graph->socket;
+	ctx->gro = rte_gro_ctx_create(&param);
+	if (ctx->gro == NULL) {
+		node_err("gro", "Failed to create GRO context of graph %s", graph->name);
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+static void
+gro_node_fini(const struct rte_graph *graph, struct rte_node *node)
+{
+	struct gro_node_ctx *ctx = (struct gro_node_ctx *)node->ctx;
+	struct rte_mbuf *pkts[RTE_GRAPH_BURST_SIZE];
+	uint16_t n;
+
+	RTE_SET_USED(graph);
+
+	if (ctx->gro == NULL)
+		return;
+
+	/* The graph is not walked anymore, free the packets still held */
+	do {
+		n = rte_gro_timeout_flush(ctx->gro, 0, gro_main.param.gro_types, pkts,
+					  RTE_DIM(pkts));
+		rte_pktmbuf_free_bulk(pkts, n);
+	} while (n != 0);
+
+	rte_gro_ctx_destroy(ctx->gro);
+	ctx->gro = NULL;
+}
+
+static struct rte_node_xstats gro_xstats = {
+	.nb_xstats = 1,
+	.xstat_desc = {
+		[0] = "gro_held_pkts",
+	},
+};
+
+static struct rte_node_register gro_node = {
+	.process = gro_node_process,
+	.name = "gro",
+	/* The flows must stay in the GRO context of a single graph */
+	.flags = RTE_NODE_ORDERED_F,
+
+	.init = gro_node_init,
+	.fini = gro_node_fini,
+	.xstats = &gro_xstats,
+
+	.nb_edges = RTE_NODE_GRO_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_GRO_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(gro_node);
+
+static uint16_t
+gro_flush_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+		       uint16_t nb_objs)
+{
+	struct gro_flush_node_ctx *ctx = (struct gro_flush_node_ctx *)node->ctx;
+	struct gro_node_ctx *gro_ctx;
+	uint16_t n;
+
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	if (unlikely(ctx->gro_node == NULL))
+		return 0;
+
+	/* Under mcore-dispatch, only the lcore running the gro node may flush its context */
+	if (rte_graph_worker_model_no_check_get(graph) == RTE_GRAPH_MODEL_MCORE_DISPATCH &&
+	    ctx->gro_node->dispatch.lcore_id != RTE_MAX_LCORE &&
+	    ctx->gro_node->dispatch.lcore_id != graph->dispatch.lcore_id)
+		return 0;
+
+	gro_ctx = (struct gro_node_ctx *)ctx->gro_node->ctx;
+	if (gro_ctx->gro == NULL || rte_gro_get_pkt_count(gro_ctx->gro) == 0)
+		return 0;
+
+	objs = rte_node_next_stream_get(graph, node, gro_main.next, RTE_GRAPH_BURST_SIZE);
+	n = rte_gro_timeout_flush(gro_ctx->gro, gro_main.timeout_cycles,
+				  gro_main.param.gro_types, (struct rte_mbuf **)objs,
+				  RTE_GRAPH_BURST_SIZE);
+	rte_node_next_stream_put(graph, node, gro_main.next, n);
+
+	return n;
+}
+
+static int
+gro_flush_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	struct gro_flush_node_ctx *ctx = (struct gro_flush_node_ctx *)node->ctx;
+	struct rte_node *n;
+	rte_graph_off_t off;
+	rte_node_t count;
+
+	RTE_BUILD_BUG_ON(sizeof(struct gro_flush_node_ctx) > RTE_NODE_CTX_SZ);
+
+	ctx->gro_node = NULL;
+	if (!gro_main.configured)
+		return 0;
+
+	rte_graph_foreach_node(count, off, graph, n) {
+		if (n->id == gro_node.id) {
+			ctx->gro_node = n;
+			return 0;
+		}
+	}
+
+	node_err("gro_flush", "No gro node in graph %s", graph->name);
+	return -EINVAL;
+}
+
+static struct rte_node_register gro_flush_node = {
+	.process = gro_flush_node_process,
+	.flags = RTE_NODE_SOURCE_F,
+	.name = "gro_flush",
+
+	.init = gro_flush_node_init,
+
+	.nb_edges = RTE_NODE_GRO_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_GRO_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(gro_flush_node);
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_gro_configure, 25.11)
+int
+rte_node_gro_configure(const struct rte_node_gro_cfg *cfg)
+{
+	const char *next_nodes[1];
+	rte_edge_t edge;
+
+	if (cfg == NULL || cfg->next_node == NULL || cfg->param.gro_types == 0)
+		return -EINVAL;
+
+	next_nodes[0] = cfg->next_node;
+	if (rte_node_edge_update(gro_node.id, RTE_EDGE_ID_INVALID, next_nodes, 1) == 0 ||
+	    rte_node_edge_update(gro_flush_node.id, RTE_EDGE_ID_INVALID, next_nodes, 1) == 0)
+		return -EINVAL;
+
+	/* Assuming edge id is the last one alloc'ed */
+	edge = rte_node_edge_count(gro_node.id) - 1;
+	if (rte_node_edge_count(gro_flush_node.id) - 1 != edge) {
+		node_err("gro", "Next node %s has different edges in gro and gro_flush",
+			 cfg->next_node);
+		return -EINVAL;
+	}
+
+	gro_main.param = cfg->param;
+	gro_main.timeout_cycles = (rte_get_tsc_hz() * cfg->timeout_us) / US_PER_S;
+	gro_main.next = edge;
+	gro_main.configured = true;
+
+	return 0;
+}
@@ -0,0 +1,144 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#include <eal_export.h>
+#include <rte_debug.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_gso.h>
+#include <rte_mbuf.h>
+
+#include "rte_node_gso_api.h"
+
+#include "node_private.h"
+
+/* Maximum number of segments of a packet */
+#define GSO_SEGS_MAX 128
+
+/* GSO global data struct */
+struct gso_node_main {
+	struct rte_gso_ctx ctx;
+	rte_edge_t next;
+	bool configured;
+};
+
+static struct gso_node_main gso_main;
+static struct rte_node_register gso_node;
+
+static __rte_always_inline int
+gso_pkt(struct rte_mbuf *mbuf, struct rte_gso_ctx *ctx, struct rte_mbuf **segs)
+{
+	uint16_t hdr_len;
+	int n;
+
+	if (mbuf->tso_segsz != 0) {
+		hdr_len = mbuf->l2_len + mbuf->l3_len + mbuf->l4_len;
+		if (mbuf->ol_flags & RTE_MBUF_F_TX_TUNNEL_MASK)
+			hdr_len += mbuf->outer_l2_len + mbuf->outer_l3_len;
+		ctx->gso_size = hdr_len + mbuf->tso_segsz;
+	} else {
+		ctx->gso_size = gso_main.ctx.gso_size;
+	}
+
+	n = rte_gso_segment(mbuf, ctx, segs, GSO_SEGS_MAX);
+	/* Segments reference the data of the packet */
+	if (n > 0)
+		rte_pktmbuf_free(mbuf);
+
+	return n;
+}
+
+static uint16_t
+gso_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+		 uint16_t nb_objs)
+{
+	struct rte_mbuf *segs[GSO_SEGS_MAX];
+	const rte_edge_t next = gso_main.next;
+	uint16_t i, from = 0, nb_drop = 0;
+	struct rte_gso_ctx ctx;
+	struct rte_mbuf *mbuf;
+	int n;
+
+	if (unlikely(!gso_main.configured)) {
+		rte_node_next_stream_move(graph, node, RTE_NODE_GSO_NEXT_PKT_DROP);
+		return nb_objs;
+	}
+
+	ctx = gso_main.ctx;
+	for (i = 0; i < nb_objs; i++) {
+		mbuf = (struct rte_mbuf *)objs[i];
+		if (likely(!(mbuf->ol_flags & (RTE_MBUF_F_TX_TCP_SEG | RTE_MBUF_F_TX_UDP_SEG))))
+			continue;
+
+		/* Send the run of packets before this one as is */
+		if (i != from)
+			rte_node_enqueue(graph, node, next, &objs[from], i - from);
+		from = i + 1;
+
+		n = gso_pkt(mbuf, &ctx, segs);
+		if (unlikely(n < 0)) {
+			rte_node_enqueue_x1(graph, node, RTE_NODE_GSO_NEXT_PKT_DROP, mbuf);
+			nb_drop++;
+		} else if (n == 0) {
+			rte_node_enqueue_x1(graph, node, next, mbuf);
+		} else {
+			rte_node_enqueue(graph, node, next, (void **)segs, n);
+		}
+	}
+	NODE_INCREMENT_XSTAT_ID(node, 0, nb_drop, nb_drop);
+
+	/* Home run, no packet was segmented */
+	if (likely(from == 0)) {
+		rte_node_next_stream_move(graph, node, next);
+		return nb_objs;
+	}
+
+	if (from != nb_objs)
+		rte_node_enqueue(graph, node, next, &objs[from], nb_objs - from);
+
+	return nb_objs;
+}
+
+static struct rte_node_xstats gso_xstats = {
+	.nb_xstats = 1,
+	.xstat_desc = {
+		[0] = "gso_error",
+	},
+};
+
+static struct rte_node_register gso_node = {
+	.process = gso_node_process,
+	.name = "gso",
+
+	.xstats = &gso_xstats,
+
+	.nb_edges = RTE_NODE_GSO_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_GSO_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(gso_node);
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_gso_configure, 25.11)
+int
+rte_node_gso_configure(const struct rte_node_gso_cfg *cfg)
+{
+	const char *next_nodes[1];
+
+	if (cfg == NULL || cfg->next_node == NULL || cfg->ctx.direct_pool == NULL ||
+	    cfg->ctx.indirect_pool == NULL || cfg->ctx.gso_types == 0)
+		return -EINVAL;
+
+	next_nodes[0] = cfg->next_node;
+	if (rte_node_edge_update(gso_node.id, RTE_EDGE_ID_INVALID, next_nodes, 1) == 0)
+		return -EINVAL;
+
+	gso_main.ctx = cfg->ctx;
+	/* Assuming edge id is the last one alloc'ed */
+	gso_main.next = rte_node_edge_count(gso_node.id) - 1;
+	gso_main.configured = true;
+
+	return 0;
+}
@@ -0,0 +1,294 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <eal_export.h>
+#include <rte_debug.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_icmp.h>
+#include <rte_ip.h>
+#include <rte_ip_frag.h>
+#include <rte_mbuf.h>
+
+#include "rte_node_ip4_api.h"
+
+#include "ip4_fragment_priv.h"
+#include "ip4_rewrite_priv.h"
+#include "node_private.h"
+
+struct ip4_fragment_elem {
+	struct ip4_fragment_elem *next;
+	struct rte_node_ip4_fragment_cfg cfg;
+};
+
+/* IP4 fragment global data struct */
+struct ip4_fragment_node_main {
+	struct ip4_fragment_elem *head;
+};
+
+typedef struct ip4_fragment_ctx ip4_fragment_ctx_t;
+typedef struct ip4_fragment_elem ip4_fragment_elem_t;
+
+static struct ip4_fragment_node_main ip4_fragment_main;
+
+/* TTL of the ICMP errors */
+#define IP4_FRAGMENT_ICMP_TTL 64
+
+/* Bytes of the payload of the packet quoted in the ICMP errors (RFC 792) */
+#define IP4_FRAGMENT_ICMP_QUOTE 8
+
+static __rte_always_inline bool
+ip4_fragment_icmp_type_is_error(uint8_t type)
+{
+	return type == RTE_ICMP_TYPE_DEST_UNREACHABLE || type == RTE_ICMP_TYPE_REDIRECT ||
+	       type == RTE_ICMP_TYPE_TTL_EXCEEDED || type == RTE_ICMP_TYPE_PARAM_PROBLEM;
+}
+
+/* Build the ICMP "fragmentation needed" error of a packet with the DF flag */
+static struct rte_mbuf *
+ip4_fragment_icmp_error(const struct rte_mbuf *mbuf, const struct rte_node_ip4_fragment_cfg *cfg,
+			uint16_t mtu)
+{
+	const uint32_t l2_len = sizeof(struct rte_ether_hdr);
+	const struct rte_ipv4_hdr *orig;
+	struct rte_icmp_hdr *icmp;
+	struct rte_ipv4_hdr *ip;
+	uint32_t src, ihl, len;
+	struct rte_mbuf *err;
+	const void *data;
+	uint8_t type;
+
+	orig = rte_pktmbuf_mtod_offset(mbuf, const struct rte_ipv4_hdr *, l2_len);
+	src = rte_be_to_cpu_32(orig->src_addr);
+	if (cfg->icmp_src == 0 || src == RTE_IPV4_ANY || src == UINT32_MAX ||
+	    RTE_IS_IPV4_MCAST(src))
+		return NULL;
+
+	/* No error for the non first fragments, nor about another ICMP error (RFC 1812) */
+	if (orig->fragment_offset & rte_cpu_to_be_16(RTE_IPV4_HDR_OFFSET_MASK))
+		return NULL;
+	ihl = rte_ipv4_hdr_len(orig);
+	if (orig->next_proto_id == IPPROTO_ICMP) {
+		data = rte_pktmbuf_read(mbuf, l2_len + ihl, sizeof(type), &type);
+		if (data == NULL || ip4_fragment_icmp_type_is_error(*(const uint8_t *)data))
+			return NULL;
+	}
+
+	len = RTE_MIN(rte_pktmbuf_pkt_len(mbuf) - l2_len, ihl + IP4_FRAGMENT_ICMP_QUOTE);
+	err = rte_pktmbuf_alloc(cfg->pool_direct);
+	if (err == NULL)
+		return NULL;
+	ip = (struct rte_ipv4_hdr *)rte_pktmbuf_append(err, l2_len + sizeof(*ip) +
+						       sizeof(*icmp) + len);
+	if (ip == NULL) {
+		rte_pktmbuf_free(err);
+		return NULL;
+	}
+
+	/* The Ethernet header is a placeholder, ip4_rewrite fills it */
+	ip = RTE_PTR_ADD(ip, l2_len);
+	icmp = (struct rte_icmp_hdr *)(ip + 1);
+	data = rte_pktmbuf_read(mbuf, l2_len, len, icmp + 1);
+	if (data != icmp + 1)
+		memcpy(icmp + 1, data, len);
+
+	icmp->icmp_type = RTE_ICMP_TYPE_DEST_UNREACHABLE;
+	icmp->icmp_code = RTE_ICMP_CODE_UNREACH_FRAG;
+	icmp->icmp_ident = 0;
+	icmp->icmp_seq_nb = rte_cpu_to_be_16(mtu);
+	icmp->icmp_cksum = 0;
+	icmp->icmp_cksum = ~rte_raw_cksum(icmp, sizeof(*icmp) + len);
+
+	ip->version_ihl = RTE_IPV4_VHL_DEF;
+	ip->type_of_service = 0;
+	ip->total_length = rte_cpu_to_be_16(sizeof(*ip) + sizeof(*icmp) + len);
+	ip->packet_id = 0;
+	ip->fragment_offset = 0;
+	ip->time_to_live = IP4_FRAGMENT_ICMP_TTL;
+	ip->next_proto_id = IPPROTO_ICMP;
+	ip->src_addr = rte_cpu_to_be_32(cfg->icmp_src);
+	ip->dst_addr = orig->src_addr;
+	ip->hdr_checksum = 0;
+	ip->hdr_checksum = rte_ipv4_cksum(ip);
+
+	return err;
+}
+
+static __rte_always_inline int32_t
+ip4_fragment_pkt(struct rte_mbuf *mbuf, struct rte_mbuf **frags, uint16_t nb_frags,
+		 const struct rte_node_ip4_fragment_cfg *cfg, const int dyn)
+{
+	uint16_t nh = node_mbuf_priv1(mbuf, dyn)->nh;
+	struct rte_ipv4_hdr *ip;
+	struct rte_mbuf *frag;
+	int32_t i, n;
+
+	if (unlikely(cfg == NULL))
+		return -ENOTSUP;
+
+	ip = rte_pktmbuf_mtod_offset(mbuf, struct rte_ipv4_hdr *, sizeof(struct rte_ether_hdr));
+	if (ip->fragment_offset & rte_cpu_to_be_16(RTE_IPV4_HDR_DF_FLAG))
+		return -EMSGSIZE;
+
+	/* Fragment the L3 packet, the Ethernet header is rewritten later */
+	rte_pktmbuf_adj(mbuf, sizeof(struct rte_ether_hdr));
+	n = rte_ipv4_fragment_packet(mbuf, frags, nb_frags, ip4_rewrite_nh_mtu_get(nh),
+				     cfg->pool_direct, cfg->pool_indirect);
+	if (unlikely(n < 0))
+		return n;
+
+	for (i = 0; i < n; i++) {
+		frag = frags[i];
+		ip = rte_pktmbuf_mtod(frag, struct rte_ipv4_hdr *);
+
+		/* ip4_rewrite decrements the TTL of the fragments once more */
+		ip->time_to_live++;
+		ip->hdr_checksum = rte_ipv4_cksum(ip);
+		rte_pktmbuf_prepend(frag, sizeof(struct rte_ether_hdr));
+
+		node_mbuf_priv1(frag, dyn)->nh = nh;
+		node_mbuf_priv1(frag, dyn)->ttl = ip->time_to_live;
+		node_mbuf_priv1(frag, dyn)->cksum = ip->hdr_checksum;
+	}
+
+	/* Fragments reference the data of the packet */
+	rte_pktmbuf_free(mbuf);
+
+	return n;
+}
+
+static uint16_t
+ip4_fragment_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+			  uint16_t nb_objs)
+{
+	ip4_fragment_ctx_t *ctx = (ip4_fragment_ctx_t *)node->ctx;
+	struct rte_mbuf *frags[RTE_LIBRTE_IP_FRAG_MAX_FRAG];
+	const int dyn = ctx->mbuf_priv1_off;
+	uint16_t i, nb_drop = 0, nb_df = 0;
+	struct rte_mbuf *mbuf, *err;
+	int32_t n;
+
+	for (i = 0; i < nb_objs; i++) {
+		mbuf = (struct rte_mbuf *)objs[i];
+		if (likely(i + 1 < nb_objs))
+			rte_prefetch0(objs[i + 1]);
+
+		n = ip4_fragment_pkt(mbuf, frags, RTE_DIM(frags), ctx->cfg, dyn);
+		if (unlikely(n == -EMSGSIZE)) {
+			/* DF is set, report the MTU of the next hop to the source */
+			err = ip4_fragment_icmp_error(mbuf, ctx->cfg,
+					ip4_rewrite_nh_mtu_get(node_mbuf_priv1(mbuf, dyn)->nh));
+			if (err != NULL)
+				rte_node_enqueue_x1(graph, node, RTE_NODE_IP4_FRAGMENT_NEXT_LOOKUP,
+						    err);
+			rte_node_enqueue_x1(graph, node, RTE_NODE_IP4_FRAGMENT_NEXT_PKT_DROP, mbuf);
+			nb_df++;
+			continue;
+		}
+		if (unlikely(n < 0)) {
+			rte_node_enqueue_x1(graph, node, RTE_NODE_IP4_FRAGMENT_NEXT_PKT_DROP, mbuf);
+			nb_drop++;
+			continue;
+		}
+
+		rte_node_enqueue(graph, node, RTE_NODE_IP4_FRAGMENT_NEXT_REWRITE, (void **)frags, n);
+	}
+	NODE_INCREMENT_XSTAT_ID(node, 0, nb_drop, nb_drop);
+	NODE_INCREMENT_XSTAT_ID(node, 1, nb_df, nb_df);
+
+	return nb_objs;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ip4_fragment_configure, 25.11)
+int
+rte_node_ip4_fragment_configure(struct rte_node_ip4_fragment_cfg *cfg, uint16_t cnt)
+{
+	ip4_fragment_elem_t *elem;
+	int i;
+
+	for (i = 0; i < cnt; i++) {
+		if (cfg[i].pool_direct == NULL || cfg[i].pool_indirect == NULL)
+			return -EINVAL;
+
+		elem = malloc(sizeof(ip4_fragment_elem_t));
+		if (elem == NULL)
+			return -ENOMEM;
+		elem->cfg = cfg[i];
+		elem->next = ip4_fragment_main.head;
+		ip4_fragment_main.head = elem;
+	}
+
+	return 0;
+}
+
+bool
+ip4_fragment_node_configured(void)
+{
+	return ip4_fragment_main.head != NULL;
+}
+
+static int
+ip4_fragment_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	ip4_fragment_ctx_t *ctx = (ip4_fragment_ctx_t *)node->ctx;
+	ip4_fragment_elem_t *elem = ip4_fragment_main.head;
+	int dyn;
+
+	RTE_SET_USED(graph);
+	RTE_BUILD_BUG_ON(sizeof(ip4_fragment_ctx_t) > RTE_NODE_CTX_SZ);
+
+	dyn = rte_node_mbuf_dynfield_register();
+	if (dyn < 0) {
+		node_err("ip4_fragment", "Failed to register mbuf dynfield");
+		return -rte_errno;
+	}
+	ctx->mbuf_priv1_off = dyn;
+
+	ctx->cfg = NULL;
+	while (elem) {
+		if (elem->cfg.node_id == node->id) {
+			/* Update node specific context */
+			ctx->cfg = &elem->cfg;
+			break;
+		}
+		elem = elem->next;
+	}
+
+	return 0;
+}
+
+static struct rte_node_xstats ip4_fragment_xstats = {
+	.nb_xstats = 2,
+	.xstat_desc = {
+		[0] = "ip4_fragment_error",
+		[1] = "ip4_frag_needed",
+	},
+};
+
+static struct rte_node_register ip4_fragment_node = {
+	.process = ip4_fragment_node_process,
+	.name = "ip4_fragment",
+
+	.init = ip4_fragment_node_init,
+	.xstats = &ip4_fragment_xstats,
+
+	.nb_edges = RTE_NODE_IP4_FRAGMENT_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_IP4_FRAGMENT_NEXT_REWRITE] = "ip4_rewrite",
+		[RTE_NODE_IP4_FRAGMENT_NEXT_LOOKUP] = "ip4_lookup",
+		[RTE_NODE_IP4_FRAGMENT_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+struct rte_node_register *
+ip4_fragment_node_get(void)
+{
+	return &ip4_fragment_node;
+}
+
+RTE_NODE_REGISTER(ip4_fragment_node);
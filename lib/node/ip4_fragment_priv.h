@@ -0,0 +1,42 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#ifndef __INCLUDE_IP4_FRAGMENT_PRIV_H__
+#define __INCLUDE_IP4_FRAGMENT_PRIV_H__
+
+#include <stdbool.h>
+
+/**
+ * @internal
+ *
+ * Ip4_fragment context structure.
+ */
+struct ip4_fragment_ctx {
+	const struct rte_node_ip4_fragment_cfg *cfg;
+	/**< Pools of the fragments, NULL if the node is not configured. */
+	int mbuf_priv1_off;
+	/**< Dynamic offset to mbuf priv1. */
+};
+
+/**
+ * @internal
+ *
+ * Check whether any ip4_fragment node is configured.
+ *
+ * @return
+ *   True if rte_node_ip4_fragment_configure() added a configuration.
+ */
+bool ip4_fragment_node_configured(void);
+
+/**
+ * @internal
+ *
+ * Get the IP4 fragment node
+ *
+ * @return
+ *   Pointer to the IP4 fragment node.
+ */
+struct rte_node_register *ip4_fragment_node_get(void);
+
+#endif /* __INCLUDE_IP4_FRAGMENT_PRIV_H__ */
@@ -13,6 +13,7 @@
 
 #include "rte_node_ip4_api.h"
 
+#include "ip4_fragment_priv.h"
 #include "ip4_rewrite_priv.h"
 #include "node_private.h"
 #include "interface_tx_feature_priv.h"
@@ -32,6 +33,8 @@ struct ip4_rewrite_node_ctx {
 	uint16_t last_tx_if;
 	/* Cached feature arc handle */
 	rte_graph_feature_arc_t output_feature_arc;
+	/* Oversized packets go to ip4_fragment */
+	uint8_t fragment;
 };
 
 static struct ip4_rewrite_node_main *ip4_rewrite_nm;
@@ -52,6 +55,27 @@ static int port_to_next_index_diff = -1;
 #define IP4_REWRITE_NODE_LAST_TX_IF(ctx) \
 	(((struct ip4_rewrite_node_ctx *)ctx)->last_tx_if)
 
+#define IP4_REWRITE_NODE_FRAGMENT(ctx) \
+	(((struct ip4_rewrite_node_ctx *)ctx)->fragment)
+
+/* Edge of the packets larger than the MTU of their next hop */
+#define IP4_REWRITE_NEXT_FRAGMENT 1
+
+static __rte_always_inline uint16_t
+ip4_rewrite_next_get(const struct rte_mbuf *mbuf, const struct ip4_rewrite_nh_header *nh,
+		      const bool frag)
+{
+	/* Ethernet header is rewritten in place, it is not part of the MTU.
+	 * The segmentation offloads split the packet at Tx.
+	 */
+	if (unlikely(rte_pktmbuf_pkt_len(mbuf) >
+		     (uint32_t)nh->mtu + sizeof(struct rte_ether_hdr)) && frag &&
+	    (mbuf->ol_flags & (RTE_MBUF_F_TX_TCP_SEG | RTE_MBUF_F_TX_UDP_SEG)) == 0)
+		return IP4_REWRITE_NEXT_FRAGMENT;
+
+	return nh->tx_node;
+}
+
 static __rte_always_inline void
 check_output_feature_arc_x1(struct rte_graph_feature_arc *arc, uint16_t *tx_if,
 			    struct rte_mbuf *mbuf0, uint16_t *next0,
@@ -190,6 +214,7 @@ __ip4_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 	rte_graph_feature_data_t feature_data = RTE_GRAPH_FEATURE_DATA_INVALID;
 	struct rte_mbuf *mbuf0, *mbuf1, *mbuf2, *mbuf3, **pkts;
 	struct ip4_rewrite_nh_header *nh = ip4_rewrite_nm->nh;
+	const bool frag = IP4_REWRITE_NODE_FRAGMENT(node->ctx);
 	uint16_t next0, next1, next2, next3, next_index;
 	struct rte_ipv4_hdr *ip0, *ip1, *ip2, *ip3;
 	uint16_t n_left_from, held = 0, last_spec = 0;
@@ -271,7 +296,7 @@ __ip4_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 		rte_memcpy(d0, nh[priv01.u16[0]].rewrite_data,
 			   nh[priv01.u16[0]].rewrite_len);
 
-		next0 = nh[priv01.u16[0]].tx_node;
+		next0 = ip4_rewrite_next_get(mbuf0, &nh[priv01.u16[0]], frag);
 		ip0 = (struct rte_ipv4_hdr *)((uint8_t *)d0 +
 					      sizeof(struct rte_ether_hdr));
 		ip0->time_to_live = priv01.u16[1] - 1;
@@ -282,7 +307,7 @@ __ip4_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 		rte_memcpy(d1, nh[priv01.u16[4]].rewrite_data,
 			   nh[priv01.u16[4]].rewrite_len);
 
-		next1 = nh[priv01.u16[4]].tx_node;
+		next1 = ip4_rewrite_next_get(mbuf1, &nh[priv01.u16[4]], frag);
 		ip1 = (struct rte_ipv4_hdr *)((uint8_t *)d1 +
 					      sizeof(struct rte_ether_hdr));
 		ip1->time_to_live = priv01.u16[5] - 1;
@@ -292,7 +317,7 @@ __ip4_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 		d2 = rte_pktmbuf_mtod(mbuf2, void *);
 		rte_memcpy(d2, nh[priv23.u16[0]].rewrite_data,
 			   nh[priv23.u16[0]].rewrite_len);
-		next2 = nh[priv23.u16[0]].tx_node;
+		next2 = ip4_rewrite_next_get(mbuf2, &nh[priv23.u16[0]], frag);
 		ip2 = (struct rte_ipv4_hdr *)((uint8_t *)d2 +
 					      sizeof(struct rte_ether_hdr));
 		ip2->time_to_live = priv23.u16[1] - 1;
@@ -303,7 +328,7 @@ __ip4_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 		rte_memcpy(d3, nh[priv23.u16[4]].rewrite_data,
 			   nh[priv23.u16[4]].rewrite_len);
 
-		next3 = nh[priv23.u16[4]].tx_node;
+		next3 = ip4_rewrite_next_get(mbuf3, &nh[priv23.u16[4]], frag);
 		ip3 = (struct rte_ipv4_hdr *)((uint8_t *)d3 +
 					      sizeof(struct rte_ether_hdr));
 		ip3->time_to_live = priv23.u16[5] - 1;
@@ -403,7 +428,8 @@ __ip4_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 		rte_memcpy(d0, nh[node_mbuf_priv1(mbuf0, dyn)->nh].rewrite_data,
 			   nh[node_mbuf_priv1(mbuf0, dyn)->nh].rewrite_len);
 
-		next0 = nh[node_mbuf_priv1(mbuf0, dyn)->nh].tx_node;
+		next0 = ip4_rewrite_next_get(mbuf0, &nh[node_mbuf_priv1(mbuf0, dyn)->nh],
+					     frag);
 		ip0 = (struct rte_ipv4_hdr *)((uint8_t *)d0 +
 					      sizeof(struct rte_ether_hdr));
 		chksum = node_mbuf_priv1(mbuf0, dyn)->cksum +
@@ -522,6 +548,7 @@ ip4_rewrite_node_init(const struct rte_graph *graph, struct rte_node *node)
 		init_once = true;
 	}
 	IP4_REWRITE_NODE_PRIV1_OFF(node->ctx) = dyn;
+	IP4_REWRITE_NODE_FRAGMENT(node->ctx) = ip4_fragment_node_configured();
 	node_dbg("ip4_rewrite", "Initialized ip4_rewrite node initialized");
 
 	return 0;
@@ -548,6 +575,12 @@ ip4_rewrite_set_next(uint16_t port_id, uint16_t next_index)
 	return 0;
 }
 
+uint16_t
+ip4_rewrite_nh_mtu_get(uint16_t next_hop)
+{
+	return ip4_rewrite_nm->nh[next_hop].mtu;
+}
+
 RTE_EXPORT_SYMBOL(rte_node_ip4_rewrite_add)
 int
 rte_node_ip4_rewrite_add(uint16_t next_hop, uint8_t *rewrite_data,
@@ -579,6 +612,8 @@ rte_node_ip4_rewrite_add(uint16_t next_hop, uint8_t *rewrite_data,
 	memcpy(nh->rewrite_data, rewrite_data, rewrite_len);
 	nh->tx_node = ip4_rewrite_nm->next_index[dst_port];
 	nh->rewrite_len = rewrite_len;
+	if (rte_eth_dev_get_mtu(dst_port, &nh->mtu) < 0)
+		nh->mtu = UINT16_MAX;
 	nh->enabled = true;
 
 	return 0;
@@ -588,9 +623,10 @@ static struct rte_node_register ip4_rewrite_node = {
 	.process = ip4_rewrite_node_process,
 	.name = "ip4_rewrite",
 	/* Default edge i.e '0' is pkt drop */
-	.nb_edges = 1,
+	.nb_edges = 2,
 	.next_nodes = {
 		[0] = "pkt_drop",
+		[IP4_REWRITE_NEXT_FRAGMENT] = "ip4_fragment",
 	},
 	.init = ip4_rewrite_node_init,
 };
@@ -0,0 +1,286 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <eal_export.h>
+#include <rte_debug.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_icmp.h>
+#include <rte_ip6.h>
+#include <rte_ip_frag.h>
+#include <rte_mbuf.h>
+
+#include "rte_node_ip6_api.h"
+
+#include "ip6_fragment_priv.h"
+#include "ip6_rewrite_priv.h"
+#include "node_private.h"
+
+struct ip6_fragment_elem {
+	struct ip6_fragment_elem *next;
+	struct rte_node_ip6_fragment_cfg cfg;
+};
+
+/* IP6 fragment global data struct */
+struct ip6_fragment_node_main {
+	struct ip6_fragment_elem *head;
+};
+
+typedef struct ip6_fragment_ctx ip6_fragment_ctx_t;
+typedef struct ip6_fragment_elem ip6_fragment_elem_t;
+
+static struct ip6_fragment_node_main ip6_fragment_main;
+
+/* Version, traffic class and flow label of the ICMPv6 errors */
+#define IP6_FRAGMENT_VTC_FLOW 0x60000000
+
+/* Hop limit of the ICMPv6 errors */
+#define IP6_FRAGMENT_ICMP6_HOP_LIMIT 64
+
+/* ICMPv6 Packet Too Big message type (RFC 4443) */
+#define IP6_FRAGMENT_ICMP6_PKT_TOO_BIG 2
+
+/* ICMPv6 types below are the error messages */
+#define IP6_FRAGMENT_ICMP6_INFO_MIN 128
+
+/* Build the ICMPv6 Packet Too Big error of a forwarded packet */
+static struct rte_mbuf *
+ip6_fragment_icmp_error(const struct rte_mbuf *mbuf, const struct rte_node_ip6_fragment_cfg *cfg,
+			uint16_t mtu)
+{
+	const uint32_t l2_len = sizeof(struct rte_ether_hdr);
+	const struct rte_ipv6_hdr *orig;
+	struct rte_icmp_hdr *icmp;
+	struct rte_ipv6_hdr *ip;
+	struct rte_mbuf *err;
+	const void *data;
+	uint32_t len;
+	uint8_t type;
+
+	orig = rte_pktmbuf_mtod_offset(mbuf, const struct rte_ipv6_hdr *, l2_len);
+	if (rte_ipv6_addr_is_unspec(&cfg->icmp_src) || rte_ipv6_addr_is_unspec(&orig->src_addr) ||
+	    rte_ipv6_addr_is_mcast(&orig->src_addr))
+		return NULL;
+
+	/* No error about another ICMPv6 error (RFC 4443) */
+	if (orig->proto == IPPROTO_ICMPV6) {
+		data = rte_pktmbuf_read(mbuf, l2_len + sizeof(*orig), sizeof(type), &type);
+		if (data == NULL || *(const uint8_t *)data < IP6_FRAGMENT_ICMP6_INFO_MIN)
+			return NULL;
+	}
+
+	err = rte_pktmbuf_alloc(cfg->pool_direct);
+	if (err == NULL)
+		return NULL;
+
+	/* Quote as much of the packet as the minimum IPv6 MTU allows */
+	len = RTE_MIN(rte_pktmbuf_pkt_len(mbuf) - l2_len,
+		      RTE_IPV6_MIN_MTU - sizeof(*ip) - sizeof(*icmp));
+	len = RTE_MIN(len, rte_pktmbuf_tailroom(err) - l2_len - sizeof(*ip) - sizeof(*icmp));
+	ip = (struct rte_ipv6_hdr *)rte_pktmbuf_append(err, l2_len + sizeof(*ip) +
+						       sizeof(*icmp) + len);
+	if (ip == NULL) {
+		rte_pktmbuf_free(err);
+		return NULL;
+	}
+
+	/* The Ethernet header is a placeholder, ip6_rewrite fills it */
+	ip = RTE_PTR_ADD(ip, l2_len);
+	icmp = (struct rte_icmp_hdr *)(ip + 1);
+	data = rte_pktmbuf_read(mbuf, l2_len, len, icmp + 1);
+	if (data != icmp + 1)
+		memcpy(icmp + 1, data, len);
+
+	ip->vtc_flow = rte_cpu_to_be_32(IP6_FRAGMENT_VTC_FLOW);
+	ip->payload_len = rte_cpu_to_be_16(sizeof(*icmp) + len);
+	ip->proto = IPPROTO_ICMPV6;
+	ip->hop_limits = IP6_FRAGMENT_ICMP6_HOP_LIMIT;
+	ip->src_addr = cfg->icmp_src;
+	ip->dst_addr = orig->src_addr;
+
+	/* The 32 bits MTU field follows the type, code and checksum */
+	icmp->icmp_type = IP6_FRAGMENT_ICMP6_PKT_TOO_BIG;
+	icmp->icmp_code = 0;
+	icmp->icmp_ident = 0;
+	icmp->icmp_seq_nb = rte_cpu_to_be_16(mtu);
+	icmp->icmp_cksum = 0;
+	icmp->icmp_cksum = rte_ipv6_udptcp_cksum(ip, icmp);
+
+	return err;
+}
+
+static __rte_always_inline int32_t
+ip6_fragment_pkt(struct rte_mbuf *mbuf, struct rte_mbuf **frags, uint16_t nb_frags,
+		 const struct rte_node_ip6_fragment_cfg *cfg, const int dyn)
+{
+	uint16_t nh = node_mbuf_priv1(mbuf, dyn)->nh;
+	struct rte_ipv6_hdr *ip;
+	struct rte_mbuf *frag;
+	int32_t i, n;
+
+	if (unlikely(cfg == NULL))
+		return -ENOTSUP;
+
+	/* Only the source of a packet fragments it (RFC 8200) */
+	if (mbuf->port != RTE_MBUF_PORT_INVALID)
+		return -EMSGSIZE;
+
+	/* Fragment the L3 packet, the Ethernet header is rewritten later */
+	rte_pktmbuf_adj(mbuf, sizeof(struct rte_ether_hdr));
+	n = rte_ipv6_fragment_packet(mbuf, frags, nb_frags, ip6_rewrite_nh_mtu_get(nh),
+				     cfg->pool_direct, cfg->pool_indirect);
+	if (unlikely(n < 0))
+		return n;
+
+	for (i = 0; i < n; i++) {
+		frag = frags[i];
+		ip = rte_pktmbuf_mtod(frag, struct rte_ipv6_hdr *);
+
+		rte_pktmbuf_prepend(frag, sizeof(struct rte_ether_hdr));
+
+		/* ip6_rewrite decrements the hop limit of the fragments once more */
+		node_mbuf_priv1(frag, dyn)->nh = nh;
+		node_mbuf_priv1(frag, dyn)->ttl = ip->hop_limits + 1;
+	}
+
+	/* Fragments reference the data of the packet */
+	rte_pktmbuf_free(mbuf);
+
+	return n;
+}
+
+static uint16_t
+ip6_fragment_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+			  uint16_t nb_objs)
+{
+	ip6_fragment_ctx_t *ctx = (ip6_fragment_ctx_t *)node->ctx;
+	struct rte_mbuf *frags[RTE_LIBRTE_IP_FRAG_MAX_FRAG];
+	const int dyn = ctx->mbuf_priv1_off;
+	uint16_t i, nb_drop = 0, nb_too_big = 0;
+	struct rte_mbuf *mbuf, *err;
+	int32_t n;
+
+	for (i = 0; i < nb_objs; i++) {
+		mbuf = (struct rte_mbuf *)objs[i];
+		if (likely(i + 1 < nb_objs))
+			rte_prefetch0(objs[i + 1]);
+
+		n = ip6_fragment_pkt(mbuf, frags, RTE_DIM(frags), ctx->cfg, dyn);
+		if (unlikely(n == -EMSGSIZE)) {
+			/* Forwarded packet, report the MTU of the next hop to the source */
+			err = ip6_fragment_icmp_error(mbuf, ctx->cfg,
+					ip6_rewrite_nh_mtu_get(node_mbuf_priv1(mbuf, dyn)->nh));
+			if (err != NULL)
+				rte_node_enqueue_x1(graph, node, RTE_NODE_IP6_FRAGMENT_NEXT_LOOKUP,
+						    err);
+			rte_node_enqueue_x1(graph, node, RTE_NODE_IP6_FRAGMENT_NEXT_PKT_DROP, mbuf);
+			nb_too_big++;
+			continue;
+		}
+		if (unlikely(n < 0)) {
+			rte_node_enqueue_x1(graph, node, RTE_NODE_IP6_FRAGMENT_NEXT_PKT_DROP, mbuf);
+			nb_drop++;
+			continue;
+		}
+
+		rte_node_enqueue(graph, node, RTE_NODE_IP6_FRAGMENT_NEXT_REWRITE, (void **)frags, n);
+	}
+	NODE_INCREMENT_XSTAT_ID(node, 0, nb_drop, nb_drop);
+	NODE_INCREMENT_XSTAT_ID(node, 1, nb_too_big, nb_too_big);
+
+	return nb_objs;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ip6_fragment_configure, 25.11)
+int
+rte_node_ip6_fragment_configure(struct rte_node_ip6_fragment_cfg *cfg, uint16_t cnt)
+{
+	ip6_fragment_elem_t *elem;
+	int i;
+
+	for (i = 0; i < cnt; i++) {
+		if (cfg[i].pool_direct == NULL || cfg[i].pool_indirect == NULL)
+			return -EINVAL;
+
+		elem = malloc(sizeof(ip6_fragment_elem_t));
+		if (elem == NULL)
+			return -ENOMEM;
+		elem->cfg = cfg[i];
+		elem->next = ip6_fragment_main.head;
+		ip6_fragment_main.head = elem;
+	}
+
+	return 0;
+}
+
+bool
+ip6_fragment_node_configured(void)
+{
+	return ip6_fragment_main.head != NULL;
+}
+
+static int
+ip6_fragment_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	ip6_fragment_ctx_t *ctx = (ip6_fragment_ctx_t *)node->ctx;
+	ip6_fragment_elem_t *elem = ip6_fragment_main.head;
+	int dyn;
+
+	RTE_SET_USED(graph);
+	RTE_BUILD_BUG_ON(sizeof(ip6_fragment_ctx_t) > RTE_NODE_CTX_SZ);
+
+	dyn = rte_node_mbuf_dynfield_register();
+	if (dyn < 0) {
+		node_err("ip6_fragment", "Failed to register mbuf dynfield");
+		return -rte_errno;
+	}
+	ctx->mbuf_priv1_off = dyn;
+
+	ctx->cfg = NULL;
+	while (elem) {
+		if (elem->cfg.node_id == node->id) {
+			/* Update node specific context */
+			ctx->cfg = &elem->cfg;
+			break;
+		}
+		elem = elem->next;
+	}
+
+	return 0;
+}
+
+static struct rte_node_xstats ip6_fragment_xstats = {
+	.nb_xstats = 2,
+	.xstat_desc = {
+		[0] = "ip6_fragment_error",
+		[1] = "ip6_pkt_too_big",
+	},
+};
+
+static struct rte_node_register ip6_fragment_node = {
+	.process = ip6_fragment_node_process,
+	.name = "ip6_fragment",
+
+	.init = ip6_fragment_node_init,
+	.xstats = &ip6_fragment_xstats,
+
+	.nb_edges = RTE_NODE_IP6_FRAGMENT_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_IP6_FRAGMENT_NEXT_REWRITE] = "ip6_rewrite",
+		[RTE_NODE_IP6_FRAGMENT_NEXT_LOOKUP] = "ip6_lookup",
+		[RTE_NODE_IP6_FRAGMENT_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+struct rte_node_register *
+ip6_fragment_node_get(void)
+{
+	return &ip6_fragment_node;
+}
+
+RTE_NODE_REGISTER(ip6_fragment_node);
@@ -0,0 +1,28 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#ifndef __INCLUDE_IP6_REASSEMBLY_PRIV_H__
+#define __INCLUDE_IP6_REASSEMBLY_PRIV_H__
+
+/**
+ * @internal
+ *
+ * Ip6_reassembly context structure.
+ */
+struct ip6_reassembly_ctx {
+	struct rte_ip_frag_tbl *tbl;
+	struct rte_ip_frag_death_row *dr;
+};
+
+/**
+ * @internal
+ *
+ * Get the IP6 reassembly node
+ *
+ * @return
+ *   Pointer to the IP6 reassembly node.
+ */
+struct rte_node_register *ip6_reassembly_node_get(void);
+
+#endif /* __INCLUDE_IP6_REASSEMBLY_PRIV_H__ */
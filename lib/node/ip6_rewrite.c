@@ -13,6 +13,7 @@
 
 #include "rte_node_ip6_api.h"
 
+#include "ip6_fragment_priv.h"
 #include "ip6_rewrite_priv.h"
 #include "node_private.h"
 
@@ -21,6 +22,8 @@ struct ip6_rewrite_node_ctx {
 	int mbuf_priv1_off;
 	/* Cached next index */
 	uint16_t next_index;
+	/* Oversized packets go to ip6_fragment */
+	uint8_t fragment;
 };
 
 static struct ip6_rewrite_node_main *ip6_rewrite_nm;
@@ -31,6 +34,27 @@ static struct ip6_rewrite_node_main *ip6_rewrite_nm;
 #define IP6_REWRITE_NODE_PRIV1_OFF(ctx) \
 	(((struct ip6_rewrite_node_ctx *)ctx)->mbuf_priv1_off)
 
+#define IP6_REWRITE_NODE_FRAGMENT(ctx) \
+	(((struct ip6_rewrite_node_ctx *)ctx)->fragment)
+
+/* Edge of the packets larger than the MTU of their next hop */
+#define IP6_REWRITE_NEXT_FRAGMENT 1
+
+static __rte_always_inline uint16_t
+ip6_rewrite_next_get(const struct rte_mbuf *mbuf, const struct ip6_rewrite_nh_header *nh,
+		      const bool frag)
+{
+	/* Ethernet header is rewritten in place, it is not part of the MTU.
+	 * The segmentation offloads split the packet at Tx.
+	 */
+	if (unlikely(rte_pktmbuf_pkt_len(mbuf) >
+		     (uint32_t)nh->mtu + sizeof(struct rte_ether_hdr)) && frag &&
+	    (mbuf->ol_flags & (RTE_MBUF_F_TX_TCP_SEG | RTE_MBUF_F_TX_UDP_SEG)) == 0)
+		return IP6_REWRITE_NEXT_FRAGMENT;
+
+	return nh->tx_node;
+}
+
 static uint16_t
 ip6_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 			 void **objs, uint16_t nb_objs)
@@ -38,6 +62,7 @@ ip6_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 	struct rte_mbuf *mbuf0, *mbuf1, *mbuf2, *mbuf3, **pkts;
 	struct ip6_rewrite_nh_header *nh = ip6_rewrite_nm->nh;
 	const int dyn = IP6_REWRITE_NODE_PRIV1_OFF(node->ctx);
+	const bool frag = IP6_REWRITE_NODE_FRAGMENT(node->ctx);
 	uint16_t next0, next1, next2, next3, next_index;
 	uint16_t n_left_from, held = 0, last_spec = 0;
 	struct rte_ipv6_hdr *ip0, *ip1, *ip2, *ip3;
@@ -89,7 +114,7 @@ ip6_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 		rte_memcpy(d0, nh[priv01.u16[0]].rewrite_data,
 			   nh[priv01.u16[0]].rewrite_len);
 
-		next0 = nh[priv01.u16[0]].tx_node;
+		next0 = ip6_rewrite_next_get(mbuf0, &nh[priv01.u16[0]], frag);
 		ip0 = (struct rte_ipv6_hdr *)((uint8_t *)d0 +
 					      sizeof(struct rte_ether_hdr));
 		ip0->hop_limits = priv01.u16[1] - 1;
@@ -99,7 +124,7 @@ ip6_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 		rte_memcpy(d1, nh[priv01.u16[4]].rewrite_data,
 			   nh[priv01.u16[4]].rewrite_len);
 
-		next1 = nh[priv01.u16[4]].tx_node;
+		next1 = ip6_rewrite_next_get(mbuf1, &nh[priv01.u16[4]], frag);
 		ip1 = (struct rte_ipv6_hdr *)((uint8_t *)d1 +
 					      sizeof(struct rte_ether_hdr));
 		ip1->hop_limits = priv01.u16[5] - 1;
@@ -108,7 +133,7 @@ ip6_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 		d2 = rte_pktmbuf_mtod(mbuf2, void *);
 		rte_memcpy(d2, nh[priv23.u16[0]].rewrite_data,
 			   nh[priv23.u16[0]].rewrite_len);
-		next2 = nh[priv23.u16[0]].tx_node;
+		next2 = ip6_rewrite_next_get(mbuf2, &nh[priv23.u16[0]], frag);
 		ip2 = (struct rte_ipv6_hdr *)((uint8_t *)d2 +
 					      sizeof(struct rte_ether_hdr));
 		ip2->hop_limits = priv23.u16[1] - 1;
@@ -118,7 +143,7 @@ ip6_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 		rte_memcpy(d3, nh[priv23.u16[4]].rewrite_data,
 			   nh[priv23.u16[4]].rewrite_len);
 
-		next3 = nh[priv23.u16[4]].tx_node;
+		next3 = ip6_rewrite_next_get(mbuf3, &nh[priv23.u16[4]], frag);
 		ip3 = (struct rte_ipv6_hdr *)((uint8_t *)d3 +
 					      sizeof(struct rte_ether_hdr));
 		ip3->hop_limits = priv23.u16[5] - 1;
@@ -205,7 +230,8 @@ ip6_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 		rte_memcpy(d0, nh[node_mbuf_priv1(mbuf0, dyn)->nh].rewrite_data,
 			   nh[node_mbuf_priv1(mbuf0, dyn)->nh].rewrite_len);
 
-		next0 = nh[node_mbuf_priv1(mbuf0, dyn)->nh].tx_node;
+		next0 = ip6_rewrite_next_get(mbuf0, &nh[node_mbuf_priv1(mbuf0, dyn)->nh],
+					     frag);
 		ip0 = (struct rte_ipv6_hdr *)((uint8_t *)d0 +
 					      sizeof(struct rte_ether_hdr));
 		ip0->hop_limits = node_mbuf_priv1(mbuf0, dyn)->ttl - 1;
@@ -252,6 +278,7 @@ ip6_rewrite_node_init(const struct rte_graph *graph, struct rte_node *node)
 	if (dyn < 0)
 		return -rte_errno;
 	IP6_REWRITE_NODE_PRIV1_OFF(node->ctx) = dyn;
+	IP6_REWRITE_NODE_FRAGMENT(node->ctx) = ip6_fragment_node_configured();
 
 	node_dbg("ip6_rewrite", "Initialized ip6_rewrite node");
 
@@ -273,6 +300,12 @@ ip6_rewrite_set_next(uint16_t port_id, uint16_t next_index)
 	return 0;
 }
 
+uint16_t
+ip6_rewrite_nh_mtu_get(uint16_t next_hop)
+{
+	return ip6_rewrite_nm->nh[next_hop].mtu;
+}
+
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ip6_rewrite_add, 23.07)
 int
 rte_node_ip6_rewrite_add(uint16_t next_hop, uint8_t *rewrite_data,
@@ -304,6 +337,8 @@ rte_node_ip6_rewrite_add(uint16_t next_hop, uint8_t *rewrite_data,
 	memcpy(nh->rewrite_data, rewrite_data, rewrite_len);
 	nh->tx_node = ip6_rewrite_nm->next_index[dst_port];
 	nh->rewrite_len = rewrite_len;
+	if (rte_eth_dev_get_mtu(dst_port, &nh->mtu) < 0)
+		nh->mtu = UINT16_MAX;
 	nh->enabled = true;
 
 	return 0;
@@ -313,9 +348,10 @@ static struct rte_node_register ip6_rewrite_node = {
 	.process = ip6_rewrite_node_process,
 	.name = "ip6_rewrite",
 	/* Default edge i.e '0' is pkt drop */
-	.nb_edges = 1,
+	.nb_edges = 2,
 	.next_nodes = {
 		[0] = "pkt_drop",
+		[IP6_REWRITE_NEXT_FRAGMENT] = "ip6_fragment",
 	},
 	.init = ip6_rewrite_node_init,
 };
@@ -19,7 +19,7 @@ struct ip6_rewrite_nh_header {
 	uint16_t rewrite_len; /**< Header rewrite length. */
 	uint16_t tx_node;     /**< Tx node next index identifier. */
 	uint16_t enabled;     /**< NH enable flag */
-	uint16_t rsvd;
+	uint16_t mtu;         /**< MTU of the Tx port. */
 	union {
 		struct {
 			struct rte_ether_addr dst;
@@ -66,4 +66,17 @@ struct rte_node_register *ip6_rewrite_node_get(void);
  */
 int ip6_rewrite_set_next(uint16_t port_id, uint16_t next_index);
 
+/**
+ * @internal
+ *
+ * Get the MTU of a given next hop.
+ *
+ * @param next_hop
+ *   Next hop identifier.
+ *
+ * @return
+ *   MTU of the Tx port of the next hop.
+ */
+uint16_t ip6_rewrite_nh_mtu_get(uint16_t next_hop);
+
 #endif /* __INCLUDE_IP6_REWRITE_PRIV_H__ */
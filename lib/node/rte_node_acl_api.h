@@ -0,0 +1,173 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#ifndef __INCLUDE_RTE_NODE_ACL_API_H__
+#define __INCLUDE_RTE_NODE_ACL_API_H__
+
+/**
+ * @file rte_node_acl_api.h
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * This API allows to do control path functions of the ACL nodes
+ * ip4_acl and ip6_acl.
+ *
+ * The ACL nodes classify the packets of a node stream on the 5-tuple of their
+ * IP header with a single rte_acl_classify() call, using the best algorithm
+ * available. A packet is sent to the next edge of the highest priority rule
+ * it matches, or to the default next edge if it matches no rule.
+ * The edges of the nodes other than pkt_drop are added by the application
+ * with rte_node_edge_update().
+ */
+#include <rte_acl.h>
+#include <rte_common.h>
+#include <rte_compat.h>
+#include <rte_graph.h>
+#include <rte_rcu_qsbr.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * ACL nodes next nodes.
+ */
+enum rte_node_acl_next {
+	RTE_NODE_ACL_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+};
+
+/** Number of rules with a hit counter in the node xstats. */
+#define RTE_NODE_ACL_RULES_XSTATS_MAX 32
+
+/**
+ * Fields of the IPv4 ACL rules.
+ * The addresses are masks, the ports are ranges.
+ */
+enum rte_node_acl_ip4_field {
+	RTE_NODE_ACL_IP4_FIELD_PROTO,
+	/**< Protocol, a bitmask. */
+	RTE_NODE_ACL_IP4_FIELD_SRC,
+	/**< Source address. */
+	RTE_NODE_ACL_IP4_FIELD_DST,
+	/**< Destination address. */
+	RTE_NODE_ACL_IP4_FIELD_SRC_PORT,
+	/**< Source port of TCP, UDP and SCTP. */
+	RTE_NODE_ACL_IP4_FIELD_DST_PORT,
+	/**< Destination port of TCP, UDP and SCTP. */
+	RTE_NODE_ACL_IP4_FIELD_NUM,
+	/**< Number of fields. */
+};
+
+/**
+ * Fields of the IPv6 ACL rules.
+ * The addresses are split in four 32-bit masks, the ports are ranges.
+ */
+enum rte_node_acl_ip6_field {
+	RTE_NODE_ACL_IP6_FIELD_PROTO,
+	/**< Next header of the IPv6 header, a bitmask. */
+	RTE_NODE_ACL_IP6_FIELD_SRC0,
+	/**< Source address, bits 0-31. */
+	RTE_NODE_ACL_IP6_FIELD_SRC1,
+	/**< Source address, bits 32-63. */
+	RTE_NODE_ACL_IP6_FIELD_SRC2,
+	/**< Source address, bits 64-95. */
+	RTE_NODE_ACL_IP6_FIELD_SRC3,
+	/**< Source address, bits 96-127. */
+	RTE_NODE_ACL_IP6_FIELD_DST0,
+	/**< Destination address, bits 0-31. */
+	RTE_NODE_ACL_IP6_FIELD_DST1,
+	/**< Destination address, bits 32-63. */
+	RTE_NODE_ACL_IP6_FIELD_DST2,
+	/**< Destination address, bits 64-95. */
+	RTE_NODE_ACL_IP6_FIELD_DST3,
+	/**< Destination address, bits 96-127. */
+	RTE_NODE_ACL_IP6_FIELD_SRC_PORT,
+	/**< Source port of TCP, UDP and SCTP. */
+	RTE_NODE_ACL_IP6_FIELD_DST_PORT,
+	/**< Destination port of TCP, UDP and SCTP. */
+	RTE_NODE_ACL_IP6_FIELD_NUM,
+	/**< Number of fields. */
+};
+
+/**
+ * IPv4 ACL rule, the userdata of the rule is the next edge of its packets.
+ */
+RTE_ACL_RULE_DEF(rte_node_acl_ip4_rule, RTE_NODE_ACL_IP4_FIELD_NUM);
+
+/**
+ * IPv6 ACL rule, the userdata of the rule is the next edge of its packets.
+ */
+RTE_ACL_RULE_DEF(rte_node_acl_ip6_rule, RTE_NODE_ACL_IP6_FIELD_NUM);
+
+/**
+ * ACL rules configuration structure.
+ * @see rte_node_ip4_acl_rules_set
+ * @see rte_node_ip6_acl_rules_set
+ */
+struct rte_node_acl_conf {
+	int socket_id;
+	/**< Socket to allocate the ACL context from. */
+	rte_edge_t default_next;
+	/**< Next edge of the packets matching no rule. */
+	struct rte_rcu_qsbr *qsbr;
+	/**< RCU QSBR variable of the graph workers, the rules being replaced
+	 * are freed once all of them report a quiescent state. It may be NULL
+	 * only for the first rules set, the rules cannot be replaced without it.
+	 */
+};
+
+/**
+ * Set the rules of the ip4_acl node.
+ *
+ * A new ACL context is built and replaces the one used by the node without
+ * stopping the graph walks, the previous context is freed once the graph
+ * workers registered to conf->qsbr report a quiescent state.
+ *
+ * @param conf
+ *   Pointer to the configuration structure.
+ * @param rules
+ *   Array of rules, the userdata of each rule is the next edge of the packets
+ *   it matches. Only the category 0 is used.
+ * @param nb_rules
+ *   Number of rules.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ *   -EINVAL if the rules are replaced without QSBR variable.
+ */
+__rte_experimental
+int rte_node_ip4_acl_rules_set(const struct rte_node_acl_conf *conf,
+			       const struct rte_node_acl_ip4_rule *rules, uint32_t nb_rules);
+
+/**
+ * Set the rules of the ip6_acl node.
+ *
+ * A new ACL context is built and replaces the one used by the node without
+ * stopping the graph walks, the previous context is freed once the graph
+ * workers registered to conf->qsbr report a quiescent state.
+ *
+ * @param conf
+ *   Pointer to the configuration structure.
+ * @param rules
+ *   Array of rules, the userdata of each rule is the next edge of the packets
+ *   it matches. Only the category 0 is used.
+ * @param nb_rules
+ *   Number of rules.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ *   -EINVAL if the rules are replaced without QSBR variable.
+ */
+__rte_experimental
+int rte_node_ip6_acl_rules_set(const struct rte_node_acl_conf *conf,
+			       const struct rte_node_acl_ip6_rule *rules, uint32_t nb_rules);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_RTE_NODE_ACL_API_H__ */
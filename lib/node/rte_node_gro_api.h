@@ -0,0 +1,81 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#ifndef __INCLUDE_RTE_NODE_GRO_API_H__
+#define __INCLUDE_RTE_NODE_GRO_API_H__
+
+/**
+ * @file rte_node_gro_api.h
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * This API allows to do control path functions of the GRO nodes
+ * gro and gro_flush.
+ *
+ * The gro node merges the packets of a node stream into the GRO context of its
+ * graph, which is kept across the graph walks, and sends the packets it could
+ * not merge along with the merged packets older than the timeout to its next
+ * node. The gro_flush source node sends the merged packets older than the
+ * timeout to the same next node when no packet reaches the gro node.
+ * The gro_flush node is optional. With the mcore-dispatch model, it only
+ * flushes the GRO context of its graph when the gro node runs on the lcore of
+ * the graph, so both nodes should have the same lcore affinity.
+ * The packets still held are freed when the graph is destroyed.
+ *
+ * The packet type of the packets must be set, the gro node sets the L2, L3
+ * and L4 lengths of the non-tunnel packets.
+ */
+#include <rte_common.h>
+#include <rte_compat.h>
+#include <rte_gro.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * GRO nodes next nodes.
+ */
+enum rte_node_gro_next {
+	RTE_NODE_GRO_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+};
+
+/**
+ * GRO nodes configuration structure.
+ * @see rte_node_gro_configure
+ */
+struct rte_node_gro_cfg {
+	struct rte_gro_param param;
+	/**< GRO types and table sizes of the GRO contexts, the socket of the
+	 * context of a graph is the socket of the graph.
+	 */
+	uint32_t timeout_us;
+	/**< Time a packet is held in the GRO context before being sent. */
+	const char *next_node;
+	/**< Name of the node the packets are sent to. */
+};
+
+/**
+ * Configure the gro and gro_flush nodes.
+ *
+ * Add the next node as an edge of both nodes. Must be called before the
+ * creation of the graphs using them.
+ *
+ * @param cfg
+ *   Pointer to the configuration structure.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_gro_configure(const struct rte_node_gro_cfg *cfg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_RTE_NODE_GRO_API_H__ */
@@ -0,0 +1,71 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#ifndef __INCLUDE_RTE_NODE_GSO_API_H__
+#define __INCLUDE_RTE_NODE_GSO_API_H__
+
+/**
+ * @file rte_node_gso_api.h
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * This API allows to do control path functions of the gso node.
+ *
+ * The gso node segments the packets requesting TCP or UDP segmentation offload
+ * with RTE_MBUF_F_TX_TCP_SEG or RTE_MBUF_F_TX_UDP_SEG, in segments carrying
+ * tso_segsz bytes of payload, and sends them to its next node along with
+ * the other packets. The L2, L3 and L4 lengths of the packets must be set,
+ * as for a device segmentation offload.
+ */
+#include <rte_common.h>
+#include <rte_compat.h>
+#include <rte_gso.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * GSO node next nodes.
+ */
+enum rte_node_gso_next {
+	RTE_NODE_GSO_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+};
+
+/**
+ * GSO node configuration structure.
+ * @see rte_node_gso_configure
+ */
+struct rte_node_gso_cfg {
+	struct rte_gso_ctx ctx;
+	/**< GSO context, its segment size is used for the packets with no
+	 * tso_segsz.
+	 */
+	const char *next_node;
+	/**< Name of the node the packets are sent to. */
+};
+
+/**
+ * Configure the gso node.
+ *
+ * Add the next node as an edge of the node. Must be called before the
+ * creation of the graphs using it.
+ *
+ * @param cfg
+ *   Pointer to the configuration structure.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_gso_configure(const struct rte_node_gso_cfg *cfg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_RTE_NODE_GSO_API_H__ */
@@ -72,6 +72,35 @@ struct rte_node_ip4_reassembly_cfg {
 	/**< Node identifier to configure. */
 };
 
+/**
+ * IP4 fragment next nodes.
+ */
+enum rte_node_ip4_fragment_next {
+	RTE_NODE_IP4_FRAGMENT_NEXT_REWRITE,
+	/**< Rewrite node. */
+	RTE_NODE_IP4_FRAGMENT_NEXT_LOOKUP,
+	/**< Lookup node, for the ICMP errors. */
+	RTE_NODE_IP4_FRAGMENT_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+};
+
+/**
+ * Fragmentation configure structure.
+ * @see rte_node_ip4_fragment_configure
+ */
+struct rte_node_ip4_fragment_cfg {
+	struct rte_mempool *pool_direct;
+	/**< Pool of the direct buffers of the fragments. */
+	struct rte_mempool *pool_indirect;
+	/**< Pool of the indirect buffers of the fragments. */
+	rte_node_t node_id;
+	/**< Node identifier to configure. */
+	uint32_t icmp_src;
+	/**< Source address of the ICMP errors, in host order.
+	 * When 0, no ICMP error is sent for the packets that cannot be fragmented.
+	 */
+};
+
 /**
  * Add ipv4 route to lookup table.
  *
@@ -122,6 +151,33 @@ int rte_node_ip4_rewrite_add(uint16_t next_hop, uint8_t *rewrite_data,
 __rte_experimental
 int rte_node_ip4_reassembly_configure(struct rte_node_ip4_reassembly_cfg *cfg, uint16_t cnt);
 
+/**
+ * Add fragmentation node configuration data.
+ *
+ * Once configured, the packets larger than the MTU of the port of their next
+ * hop are sent by the ip4_rewrite node to the ip4_fragment node, which gives
+ * the fragments back to ip4_rewrite. The packets requesting TCP or UDP
+ * segmentation offload are not fragmented.
+ *
+ * A packet with the Don't Fragment flag is dropped, and an ICMP destination
+ * unreachable error (fragmentation needed) is sent back to its source through
+ * ip4_lookup if cfg->icmp_src is set.
+ *
+ * Without configuration data, ip4_rewrite sends every packet to its Tx node
+ * regardless of its size. The configuration must be done before the graph
+ * creation.
+ *
+ * @param cfg
+ *   Pointer to the configuration structure.
+ * @param cnt
+ *   Number of configuration structures passed.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ip4_fragment_configure(struct rte_node_ip4_fragment_cfg *cfg, uint16_t cnt);
+
 /**
  * Create ipv4 FIB.
  *
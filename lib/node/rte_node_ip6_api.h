@@ -18,6 +18,7 @@
 #include <rte_common.h>
 #include <rte_compat.h>
 #include <rte_fib6.h>
+#include <rte_graph.h>
 #include <rte_ip6.h>
 
 #ifdef __cplusplus
@@ -34,6 +35,56 @@ enum rte_node_ip6_lookup_next {
 	/**< Packet drop node. */
 };
 
+/**
+ * IP6 reassembly next nodes.
+ */
+enum rte_node_ip6_reassembly_next {
+	RTE_NODE_IP6_REASSEMBLY_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+};
+
+/**
+ * Reassembly configure structure.
+ * @see rte_node_ip6_reassembly_configure
+ */
+struct rte_node_ip6_reassembly_cfg {
+	struct rte_ip_frag_tbl *tbl;
+	/**< Reassembly fragmentation table. */
+	struct rte_ip_frag_death_row *dr;
+	/**< Reassembly deathrow table. */
+	rte_node_t node_id;
+	/**< Node identifier to configure. */
+};
+
+/**
+ * IP6 fragment next nodes.
+ */
+enum rte_node_ip6_fragment_next {
+	RTE_NODE_IP6_FRAGMENT_NEXT_REWRITE,
+	/**< Rewrite node. */
+	RTE_NODE_IP6_FRAGMENT_NEXT_LOOKUP,
+	/**< Lookup node, for the ICMPv6 errors. */
+	RTE_NODE_IP6_FRAGMENT_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+};
+
+/**
+ * Fragmentation configure structure.
+ * @see rte_node_ip6_fragment_configure
+ */
+struct rte_node_ip6_fragment_cfg {
+	struct rte_mempool *pool_direct;
+	/**< Pool of the direct buffers of the fragments. */
+	struct rte_mempool *pool_indirect;
+	/**< Pool of the indirect buffers of the fragments. */
+	rte_node_t node_id;
+	/**< Node identifier to configure. */
+	struct rte_ipv6_addr icmp_src;
+	/**< Source address of the ICMPv6 errors.
+	 * When unspecified, no ICMPv6 error is sent for the packets that cannot be fragmented.
+	 */
+};
+
 /**
  * Add IPv6 route to lookup table.
  *
@@ -72,6 +123,48 @@ __rte_experimental
 int rte_node_ip6_rewrite_add(uint16_t next_hop, uint8_t *rewrite_data,
 			     uint8_t rewrite_len, uint16_t dst_port);
 
+/**
+ * Add reassembly node configuration data.
+ *
+ * @param cfg
+ *   Pointer to the configuration structure.
+ * @param cnt
+ *   Number of configuration structures passed.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ip6_reassembly_configure(struct rte_node_ip6_reassembly_cfg *cfg, uint16_t cnt);
+
+/**
+ * Add fragmentation node configuration data.
+ *
+ * Once configured, the packets larger than the MTU of the port of their next
+ * hop are sent by the ip6_rewrite node to the ip6_fragment node. The packets
+ * requesting TCP or UDP segmentation offload are not fragmented.
+ *
+ * As routers do not fragment IPv6 packets (RFC 8200), only the locally
+ * originated packets, i.e. those with an invalid mbuf port, are fragmented
+ * and given back to ip6_rewrite. The forwarded packets are dropped, and an
+ * ICMPv6 Packet Too Big error is sent back to their source through ip6_lookup
+ * if cfg->icmp_src is set.
+ *
+ * Without configuration data, ip6_rewrite sends every packet to its Tx node
+ * regardless of its size. The configuration must be done before the graph
+ * creation.
+ *
+ * @param cfg
+ *   Pointer to the configuration structure.
+ * @param cnt
+ *   Number of configuration structures passed.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ip6_fragment_configure(struct rte_node_ip6_fragment_cfg *cfg, uint16_t cnt);
+
 /**
  * Create ipv6 FIB.
  *
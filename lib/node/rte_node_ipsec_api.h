@@ -0,0 +1,96 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2025 Intel Corporation
+ */
+
+#ifndef __INCLUDE_RTE_NODE_IPSEC_API_H__
+#define __INCLUDE_RTE_NODE_IPSEC_API_H__
+
+/**
+ * @file rte_node_ipsec_api.h
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * This API allows to do control path functions of the IPsec ESP nodes
+ * esp_inbound, esp_outbound and esp_completion.
+ *
+ * The esp_inbound node looks up the IPsec session of the ESP packets in the SAD,
+ * the esp_outbound node takes the IPsec session of the packets from the
+ * ipsec_ss field of the node mbuf dynamic field, set by the previous node.
+ * Both nodes receive and send the packets with an Ethernet header, as the ip4
+ * and ip6 nodes do.
+ *
+ * The packets of the lookaside sessions are enqueued to the cryptodev queue
+ * pair of the graph, and completed by the esp_completion source node of the
+ * graph on a later walk. A graph takes a free queue pair when it is created,
+ * and releases it when it is destroyed, freeing the packets of its in-flight
+ * crypto operations. The lookaside sessions are not supported by the graphs
+ * of the mcore-dispatch model, whose nodes may run on different lcores.
+ * The packets of the CPU crypto and inline sessions are processed synchronously.
+ */
+#include <rte_common.h>
+#include <rte_compat.h>
+#include <rte_ipsec.h>
+#include <rte_ipsec_sad.h>
+#include <rte_mempool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * ESP nodes next nodes.
+ */
+enum rte_node_esp_next {
+	RTE_NODE_ESP_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+};
+
+/**
+ * ESP nodes configuration structure.
+ * @see rte_node_ipsec_configure
+ */
+struct rte_node_ipsec_cfg {
+	uint8_t dev_id;
+	/**< Cryptodev of the lookaside sessions, configured with a queue pair
+	 * per graph.
+	 */
+	struct rte_mempool *cop_pool;
+	/**< Pool of the symmetric crypto operations of the lookaside sessions,
+	 * with the private size required by the IPsec library. NULL if no
+	 * lookaside session is used. When set, the creation of the graphs of
+	 * the mcore-dispatch model with ESP nodes fails with -ENOTSUP.
+	 */
+	struct rte_ipsec_sad *sad_ip4;
+	/**< SAD of the IPv4 inbound sessions, NULL if none. The keys are in
+	 * network byte order and the value of a key is its IPsec session.
+	 */
+	struct rte_ipsec_sad *sad_ip6;
+	/**< SAD of the IPv6 inbound sessions, NULL if none. */
+	const char *inbound_next_node;
+	/**< Name of the node the decrypted packets are sent to. */
+	const char *outbound_next_node;
+	/**< Name of the node the encrypted packets are sent to. */
+};
+
+/**
+ * Configure the ESP nodes.
+ *
+ * Add the next nodes as edges of the ESP nodes. Must be called before the
+ * creation of the graphs using them, after the cryptodev configuration.
+ *
+ * @param cfg
+ *   Pointer to the configuration structure.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ipsec_configure(const struct rte_node_ipsec_cfg *cfg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_RTE_NODE_IPSEC_API_H__ */
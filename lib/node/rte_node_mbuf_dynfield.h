@@ -56,6 +56,8 @@ typedef struct rte_node_mbuf_overload_fields {
 			};
 			uint64_t u;
 		};
+		/* Following field used by SA lookup -> esp_outbound nodes */
+		struct rte_ipsec_session *ipsec_ss;
 		uint8_t data[RTE_NODE_MBUF_OVERLOADABLE_FIELDS_SIZE];
 	};
 } rte_node_mbuf_overload_fields_t;